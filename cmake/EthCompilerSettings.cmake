@@ -218,6 +218,12 @@ if(COVERAGE)
 	add_compile_options(-g --coverage)
 endif()
 
+# Counters of events in hot code of the compiler, reported by the profiler (see libsolutil/Profiler.h).
+option(PERF_COUNTERS "Build with performance counters" ON)
+if(NOT PERF_COUNTERS)
+	add_definitions(-DSOL_PERF_COUNTERS_DISABLED)
+endif()
+
 # SMT Solvers integration
 option(USE_Z3 "Allow compiling with Z3 SMT solver integration" ON)
 if(UNIX AND NOT APPLE)
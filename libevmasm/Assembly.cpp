@@ -28,14 +28,21 @@
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ColdCodeMover.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
 #include <json/json.h>
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <range/v3/algorithm/any_of.hpp>
 
 using namespace std;
@@ -45,10 +52,15 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 
 AssemblyItem const& Assembly::append(AssemblyItem const& _i)
+{
+	return append(AssemblyItem(_i));
+}
+
+AssemblyItem const& Assembly::append(AssemblyItem&& _i)
 {
 	assertThrow(m_deposit >= 0, AssemblyException, "Stack underflow.");
 	m_deposit += static_cast<int>(_i.deposit());
-	m_items.emplace_back(_i);
+	m_items.emplace_back(move(_i));
 	if (!m_items.back().location().isValid() && m_currentSourceLocation.isValid())
 		m_items.back().setLocation(m_currentSourceLocation);
 	m_items.back().m_modifierDepth = m_currentModifierDepth;
@@ -57,14 +69,22 @@ AssemblyItem const& Assembly::append(AssemblyItem const& _i)
 
 unsigned Assembly::bytesRequired(unsigned subTagSize) const
 {
-	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	// Only the items referring to tags or data grow with the tag size, so the size of the code is
+	// determined once and the smallest sufficient tag size is found without revisiting the items.
+	size_t sizeAtSubTagSize = 1;
+	for (auto const& i: m_data)
+		sizeAtSubTagSize += i.second.size();
+	size_t tagSizeDependentItems = 0;
+	for (AssemblyItem const& i: m_items)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
+		sizeAtSubTagSize += i.bytesRequired(subTagSize);
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+			++tagSizeDependentItems;
+	}
 
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize);
+	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	{
+		size_t ret = sizeAtSubTagSize + tagSizeDependentItems * (tagSize - subTagSize);
 		if (util::bytesRequired(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -73,6 +93,23 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
+/// Maximum number of items the common subexpression eliminator analyses with the same
+/// knowledge in the extended mode, to bound the size of its state.
+size_t constexpr c_extendedCSEItemBudget = 1024;
+
+/// @returns true if the code following the breaking item @a _breakingItem of a CSE block,
+/// starting at @a _next, can only be reached from the end of that block and if the knowledge
+/// about the block stays valid for it. This is the case for all operations that continue
+/// on the next item and for JUMPI, unless the next item is a tag that might be jumped to.
+bool continuesExtendedBlock(AssemblyItem const& _breakingItem, AssemblyItem const& _next)
+{
+	if (_breakingItem.type() != Operation || _next.type() == Tag)
+		return false;
+	return
+		!SemanticInformation::altersControlFlow(_breakingItem) ||
+		_breakingItem == Instruction::JUMPI;
+}
+
 string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
 {
 	if (!_location.hasText() || _sourceCodes.empty())
@@ -405,6 +442,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	Profiler::Phase phase("EVM assembly optimiser");
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -415,54 +453,86 @@ map<u256, u256> Assembly::optimiseInternal(
 )
 {
 	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	OptimiserSettings settings = _settings;
+	// Disable creation mode for sub-assemblies.
+	settings.isCreation = false;
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	auto optimiseSubs = [&](vector<size_t> const& _subIds, OptimiserSettings const& _subSettings) {
+		for (size_t subId: _subIds)
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(
+				_subSettings,
+				JumpdestRemover::referencedTags(m_items, subId)
+			);
+	};
+	vector<vector<size_t>> groups = independentSubGroups();
+	if (_settings.parallelism > 1 && groups.size() > 1)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		// Groups are optimised concurrently, so do not spawn further threads for their subs.
+		OptimiserSettings groupSettings = settings;
+		groupSettings.parallelism = 1;
+		ThreadPool pool(min(_settings.parallelism, groups.size()));
+		pool.forEach(groups, [&](vector<size_t> const& _group) { optimiseSubs(_group, groupSettings); });
 	}
+	else
+		for (auto const& group: groups)
+			optimiseSubs(group, settings);
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		// Apply the replacements (can be empty).
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
 		count = 0;
+		// Tags referenced by the current items, if they are known from the inliner.
+		optional<set<size_t>> referencedTags;
 
 		if (_settings.runInliner)
-			Inliner{
+		{
+			Profiler::Phase phase("inliner");
+			Inliner inliner{
 				m_items,
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				_settings.isCreation,
 				_settings.evmVersion
-			}.optimise();
+			};
+			inliner.optimise();
+			referencedTags = inliner.referencedTags();
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
+			Profiler::Phase phase("jumpdest remover");
 			JumpdestRemover jumpdestOpt{m_items};
-			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
+			bool removed = referencedTags ?
+				jumpdestOpt.optimise(_tagsReferencedFromOutside, move(*referencedTags)) :
+				jumpdestOpt.optimise(_tagsReferencedFromOutside);
+			if (removed)
 				count++;
 		}
 
 		if (_settings.runPeephole)
 		{
+			Profiler::Phase phase("peephole optimiser");
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
+				count++;
+		}
+
+		if (_settings.runColdCodeMover)
+		{
+			Profiler::Phase phase("cold code mover");
+			ColdCodeMover mover{m_items, _tagsReferencedFromOutside, [&]() { return newTag(); }};
+			if (mover.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			Profiler::Phase phase("block deduplicator");
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -488,6 +558,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runCSE)
 		{
+			Profiler::Phase phase("common subexpression eliminator");
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
@@ -498,17 +569,30 @@ map<u256, u256> Assembly::optimiseInternal(
 			});
 
 			auto iter = m_items.begin();
+			// In the extended mode, the eliminator keeps its knowledge for the next chunk if that
+			// can only be entered from the end of the current one.
+			optional<CommonSubexpressionEliminator> eliminator;
+			size_t itemsSinceReset = 0;
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				if (!eliminator)
+				{
+					eliminator.emplace(KnownState{});
+					itemsSinceReset = 0;
+				}
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+				iter = eliminator->feedItems(iter, m_items.end(), usesMSize);
+				itemsSinceReset += static_cast<size_t>(iter - orig);
+				bool const keepKnowledge =
+					_settings.runExtendedCSE &&
+					iter != m_items.end() &&
+					continuesExtendedBlock(*prev(iter), *iter) &&
+					itemsSinceReset < c_extendedCSEItemBudget;
 				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
 				try
 				{
-					optimisedChunk = eliminator.getOptimizedItems();
+					optimisedChunk = eliminator->getOptimizedItems();
 					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
 				}
 				catch (StackTooDeepException const&)
@@ -529,6 +613,8 @@ map<u256, u256> Assembly::optimiseInternal(
 				}
 				else
 					copy(orig, iter, back_inserter(optimisedItems));
+				if (!keepKnowledge)
+					eliminator.reset();
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -539,17 +625,55 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		Profiler::Phase phase("constant optimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	return tagReplacements;
 }
 
-LinkerObject const& Assembly::assemble() const
+vector<vector<size_t>> Assembly::independentSubGroups() const
+{
+	// Collects an assembly and all (indirect) sub-assemblies of it.
+	function<void(Assembly const&, set<Assembly const*>&)> collect = [&](Assembly const& _assembly, set<Assembly const*>& _assemblies) {
+		if (_assemblies.insert(&_assembly).second)
+			for (auto const& sub: _assembly.m_subs)
+				collect(*sub, _assemblies);
+	};
+
+	vector<vector<size_t>> groups;
+	vector<set<Assembly const*>> groupAssemblies;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		set<Assembly const*> assemblies;
+		collect(*m_subs[subId], assemblies);
+
+		vector<size_t> group;
+		for (size_t i = 0; i < groups.size();)
+			if (ranges::any_of(assemblies, [&](Assembly const* _assembly) { return groupAssemblies[i].count(_assembly); }))
+			{
+				group += groups[i];
+				assemblies += groupAssemblies[i];
+				groups.erase(groups.begin() + static_cast<ptrdiff_t>(i));
+				groupAssemblies.erase(groupAssemblies.begin() + static_cast<ptrdiff_t>(i));
+			}
+			else
+				++i;
+		group.push_back(subId);
+		sort(group.begin(), group.end());
+		groups.emplace_back(move(group));
+		groupAssemblies.emplace_back(move(assemblies));
+	}
+	return groups;
+}
+
+LinkerObject const& Assembly::assemble(size_t _parallelism) const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
 	// Return the already assembled object, if present.
@@ -558,13 +682,29 @@ LinkerObject const& Assembly::assemble() const
 	// Otherwise ensure the object is actually clear.
 	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	// Assemble all sub-assemblies ahead of time. Assembling caches the result in the assembly
+	// object, so only groups that do not share any assemblies can be processed concurrently.
+	vector<vector<size_t>> groups = _parallelism > 1 && m_subs.size() > 1 ?
+		independentSubGroups() :
+		vector<vector<size_t>>{};
+	if (groups.size() > 1)
+	{
+		ThreadPool pool(min(_parallelism, groups.size()));
+		pool.forEach(groups, [&](vector<size_t> const& _group) {
+			for (size_t subId: _group)
+				m_subs[subId]->assemble();
+		});
+	}
+
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
+	size_t subsSize = 0;
 	map<u256, pair<string, vector<size_t>>> immutableReferencesBySub;
 	for (auto const& sub: m_subs)
 	{
 		auto const& linkerObject = sub->assemble();
+		subsSize += linkerObject.bytecode.size();
 		if (!linkerObject.immutableReferences.empty())
 		{
 			assertThrow(
@@ -599,16 +739,16 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = bytesRequired(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	/// Code locations where tags have to be inserted, in increasing order.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
 	unsigned bytesPerTag = util::bytesRequired(bytesRequiredForCode);
 	uint8_t tagPush = static_cast<uint8_t>(pushInstruction(bytesPerTag));
 
-	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + static_cast<unsigned>(m_auxiliaryData.size());
-	for (auto const& sub: m_subs)
-		bytesRequiredIncludingData += static_cast<unsigned>(sub->assemble().bytecode.size());
+	unsigned bytesRequiredIncludingData =
+		bytesRequiredForCode + 1 + static_cast<unsigned>(m_auxiliaryData.size()) + static_cast<unsigned>(subsSize);
 
 	unsigned bytesPerDataRef = util::bytesRequired(bytesRequiredIncludingData);
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
@@ -628,19 +768,15 @@ LinkerObject const& Assembly::assemble() const
 		case PushString:
 		{
 			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
-			unsigned ii = 0;
-			for (auto j: m_strings.at(h256(i.data())))
-				if (++ii > 32)
-					break;
-				else
-					ret.bytecode.push_back(uint8_t(j));
-			while (ii++ < 32)
-				ret.bytecode.push_back(0);
+			string const& str = m_strings.at(h256(i.data()));
+			size_t const length = min<size_t>(str.size(), 32);
+			ret.bytecode.insert(ret.bytecode.end(), str.begin(), str.begin() + static_cast<ptrdiff_t>(length));
+			ret.bytecode.resize(ret.bytecode.size() + 32 - length);
 			break;
 		}
 		case Push:
 		{
-			unsigned b = max<unsigned>(1, util::bytesRequired(i.data()));
+			unsigned b = static_cast<unsigned>(i.pushSize());
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
 			bytesRef byr(&ret.bytecode.back() + 1 - b, b);
@@ -650,7 +786,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
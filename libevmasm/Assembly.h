@@ -49,6 +49,8 @@ public:
 
 	AssemblyItem newTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(Tag, m_usedTags++); }
 	AssemblyItem newPushTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(PushTag, m_usedTags++); }
+	/// @returns the number of tags created so far, i.e. the id of the next new tag.
+	unsigned usedTags() const { return m_usedTags; }
 	/// Returns a tag identified by the given name. Creates it if it does not yet exist.
 	AssemblyItem namedTag(std::string const& _name, size_t _params, size_t _returns, std::optional<uint64_t> _sourceID);
 	AssemblyItem newData(bytes const& _data) { util::h256 h(util::keccak256(util::asString(_data))); m_data[h] = _data; return AssemblyItem(PushData, h); }
@@ -63,6 +65,7 @@ public:
 	AssemblyItem newImmutableAssignment(std::string const& _identifier);
 
 	AssemblyItem const& append(AssemblyItem const& _i);
+	AssemblyItem const& append(AssemblyItem&& _i);
 	AssemblyItem const& append(bytes const& _data) { return append(newData(_data)); }
 
 	template <class T> Assembly& operator<<(T const& _d) { append(_d); return *this; }
@@ -99,6 +102,12 @@ public:
 
 	/// Returns the mutable assembly items. Use with care!
 	AssemblyItems& items() { return m_items; }
+	/// Allocates storage for @a _count further items at once.
+	void reserveItems(size_t _count)
+	{
+		if (m_items.size() + _count > m_items.capacity())
+			m_items.reserve(std::max(m_items.size() + _count, 2 * m_items.capacity()));
+	}
 
 	int deposit() const { return m_deposit; }
 	void adjustDeposit(int _adjustment) { m_deposit += _adjustment; assertThrow(m_deposit >= 0, InvalidDeposit, ""); }
@@ -110,7 +119,9 @@ public:
 	langutil::SourceLocation const& currentSourceLocation() const { return m_currentSourceLocation; }
 
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
-	LinkerObject const& assemble() const;
+	/// Sub-assemblies that do not share any (indirect) sub-assemblies are assembled on up to
+	/// @a _parallelism threads. The result does not depend on this setting.
+	LinkerObject const& assemble(size_t _parallelism = 1) const;
 
 	struct OptimiserSettings
 	{
@@ -120,11 +131,19 @@ public:
 		bool runPeephole = false;
 		bool runDeduplicate = false;
 		bool runCSE = false;
+		/// Keeps the knowledge of the common subexpression eliminator across conditional jumps
+		/// and other block boundaries that are only followed by code without tags.
+		bool runExtendedCSE = false;
+		/// Moves code that always reverts behind conditional jumps to the end of the assembly.
+		bool runColdCodeMover = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Number of threads that can be used to optimise sub-assemblies concurrently.
+		/// The result does not depend on this setting.
+		size_t parallelism = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -164,6 +183,9 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns the indices of the sub-assemblies grouped such that subs of different groups
+	/// do not share any (indirect) sub-assemblies and can thus be optimised and assembled independently.
+	std::vector<std::vector<size_t>> independentSubGroups() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -25,6 +25,7 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
 
 using namespace std;
@@ -73,7 +74,7 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength) const
 	case PushString:
 		return 1 + 32;
 	case Push:
-		return 1 + max<size_t>(1, util::bytesRequired(data()));
+		return 1 + m_pushSize;
 	case PushSubSize:
 	case PushProgramSize:
 		return 1 + 4;		// worst case: a 16MB program
@@ -334,46 +335,82 @@ std::string AssemblyItem::computeSourceMapping(
 	AssemblyItems const& _items,
 	map<string, unsigned> const& _sourceIndicesMap
 )
+{
+	return renderSourceMapping(computeSourceMappingEntries(_items, _sourceIndicesMap));
+}
+
+SourceMapping AssemblyItem::computeSourceMappingEntries(
+	AssemblyItems const& _items,
+	map<string, unsigned> const& _sourceIndicesMap
+)
+{
+	SourceMapping entries;
+	entries.reserve(_items.size());
+
+	// Consecutive items usually stem from the same source, so the index is only looked up on changes.
+	CharStream const* prevSource = nullptr;
+	int sourceIndex = -1;
+	for (auto const& item: _items)
+	{
+		SourceLocation const& location = item.location();
+		if (location.source.get() != prevSource)
+		{
+			prevSource = location.source.get();
+			sourceIndex = -1;
+			if (prevSource)
+				if (auto it = _sourceIndicesMap.find(prevSource->name()); it != _sourceIndicesMap.end())
+					sourceIndex = static_cast<int>(it->second);
+		}
+
+		SourceMappingEntry& entry = entries.emplace_back();
+		entry.start = location.start;
+		entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		entry.sourceIndex = sourceIndex;
+		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
+			entry.jump = 'i';
+		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
+			entry.jump = 'o';
+		entry.modifierDepth = static_cast<int>(item.m_modifierDepth);
+	}
+	return entries;
+}
+
+std::string AssemblyItem::renderSourceMapping(SourceMapping const& _sourceMapping)
 {
 	string ret;
+	// Most entries only consist of the separator or a few short numbers.
+	ret.reserve(_sourceMapping.size() * 4);
+	auto appendNumber = [&](int _value) {
+		char buffer[16];
+		auto [end, error] = to_chars(begin(buffer), std::end(buffer), _value);
+		assertThrow(error == errc{}, util::Exception, "");
+		ret.append(buffer, end);
+	};
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
-	for (auto const& item: _items)
+	for (SourceMappingEntry const& entry: _sourceMapping)
 	{
-		if (!ret.empty())
-			ret += ";";
-
-		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && _sourceIndicesMap.count(location.source->name()) ?
-			static_cast<int>(_sourceIndicesMap.at(location.source->name())) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-		int modifierDepth = static_cast<int>(item.m_modifierDepth);
+		if (&entry != &_sourceMapping.front())
+			ret += ';';
 
 		unsigned components = 5;
-		if (modifierDepth == prevModifierDepth)
+		if (entry.modifierDepth == prevModifierDepth)
 		{
 			components--;
-			if (jump == prevJump)
+			if (entry.jump == prevJump)
 			{
 				components--;
-				if (sourceIndex == prevSourceIndex)
+				if (entry.sourceIndex == prevSourceIndex)
 				{
 					components--;
-					if (length == prevLength)
+					if (entry.length == prevLength)
 					{
 						components--;
-						if (location.start == prevStart)
+						if (entry.start == prevStart)
 							components--;
 					}
 				}
@@ -382,39 +419,39 @@ std::string AssemblyItem::computeSourceMapping(
 
 		if (components-- > 0)
 		{
-			if (location.start != prevStart)
-				ret += to_string(location.start);
+			if (entry.start != prevStart)
+				appendNumber(entry.start);
 			if (components-- > 0)
 			{
 				ret += ':';
-				if (length != prevLength)
-					ret += to_string(length);
+				if (entry.length != prevLength)
+					appendNumber(entry.length);
 				if (components-- > 0)
 				{
 					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+					if (entry.sourceIndex != prevSourceIndex)
+						appendNumber(entry.sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
+						if (entry.jump != prevJump)
+							ret += entry.jump;
 						if (components-- > 0)
 						{
 							ret += ':';
-							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
+							if (entry.modifierDepth != prevModifierDepth)
+								appendNumber(entry.modifierDepth);
 						}
 					}
 				}
 			}
 		}
 
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-		prevModifierDepth = modifierDepth;
+		prevStart = entry.start;
+		prevLength = entry.length;
+		prevSourceIndex = entry.sourceIndex;
+		prevJump = entry.jump;
+		prevModifierDepth = entry.modifierDepth;
 	}
 	return ret;
 }
@@ -27,6 +27,8 @@
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
+#include <libsolutil/CommonData.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -56,6 +58,19 @@ class Assembly;
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 
+/// The fields of a single assembly item in a source mapping, -1 meaning unknown.
+struct SourceMappingEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	/// One of 'i' (into function), 'o' (out of function) and '-' (ordinary jump or no jump).
+	char jump = '-';
+	int modifierDepth = 0;
+};
+/// Source mapping of a list of assembly items with one entry per item.
+using SourceMapping = std::vector<SourceMappingEntry>;
+
 class AssemblyItem
 {
 public:
@@ -75,12 +90,12 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(std::move(_data));
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}}
+		m_verbatimBytecode{std::make_shared<std::tuple<size_t, size_t, bytes> const>(_arguments, _returnVariables, std::move(_verbatimData))}
 	{}
 
 	AssemblyItem(AssemblyItem const&) = default;
@@ -100,8 +115,16 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return m_data; }
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		m_data = _data;
+		if (m_type == Push)
+			m_pushSize = static_cast<uint8_t>(std::max<unsigned>(1, util::bytesRequired(m_data)));
+	}
+	/// @returns the number of bytes of the value pushed by a Push item, which is at least one.
+	size_t pushSize() const { assertThrow(m_type == Push, util::Exception, ""); return m_pushSize; }
 
 	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
 
@@ -141,10 +164,19 @@ public:
 	}
 	bool operator!=(Instruction _instr) const { return !operator==(_instr); }
 
+	/// @returns the compressed source mapping string of @a _items.
 	static std::string computeSourceMapping(
 		AssemblyItems const& _items,
 		std::map<std::string, unsigned> const& _sourceIndicesMap
 	);
+	/// @returns the source mapping of @a _items, which can be rendered later using @a renderSourceMapping.
+	static SourceMapping computeSourceMappingEntries(
+		AssemblyItems const& _items,
+		std::map<std::string, unsigned> const& _sourceIndicesMap
+	);
+	/// @returns @a _sourceMapping in the compressed format, where fields and entries that are
+	/// equal to the ones of the previous entry are left out.
+	static std::string renderSourceMapping(SourceMapping const& _sourceMapping);
 
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
@@ -175,10 +207,14 @@ public:
 private:
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	/// Only valid if m_type == Push. Cached, since the sizes of items are needed by many optimiser steps.
+	uint8_t m_pushSize = 1;
+	/// Only valid if m_type != Operation. Stored inline, so that copying items, which the
+	/// optimiser does a lot, does not need to allocate or update reference counts.
+	u256 m_data;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// return variables and verbatim bytecode. Shared between copies, since it is rarely used.
+	std::shared_ptr<std::tuple<size_t, size_t, bytes> const> m_verbatimBytecode;
 	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
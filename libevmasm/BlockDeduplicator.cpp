@@ -27,8 +27,12 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -77,18 +81,42 @@ bool BlockDeduplicator::deduplicate()
 		return std::lexicographical_compare(first, end, second, end);
 	};
 
+	// Hash of the first items of the block starting at @a _i, as seen by the comparator.
+	// Only blocks of the same hash can be equal and have to be compared.
+	auto blockHash = [&](size_t _i)
+	{
+		AssemblyItem pushOwnTag = m_items.at(_i).pushTag();
+		BlockIterator it{m_items.begin() + BlockIterator::difference_type(_i), m_items.end(), &pushOwnTag, &pushSelf};
+		BlockIterator end{m_items.end(), m_items.end()};
+		++it;
+
+		size_t hash = 0;
+		for (size_t count = 0; it != end && count < 32; ++it, ++count)
+		{
+			AssemblyItem const& item = *it;
+			boost::hash_combine(hash, static_cast<unsigned>(item.type()));
+			if (item.type() == Operation)
+				boost::hash_combine(hash, static_cast<unsigned>(item.instruction()));
+			else if (item.type() == VerbatimBytecode)
+				boost::hash_combine(hash, item.verbatimData().size());
+			else
+				boost::hash_combine(hash, static_cast<uint64_t>(item.data() & u256(numeric_limits<uint64_t>::max())));
+		}
+		return hash;
+	};
+
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		unordered_map<size_t, set<size_t, function<bool(size_t, size_t)>>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			auto& bucket = blocksSeen.try_emplace(blockHash(i), comparator).first->second;
+			auto it = bucket.find(i);
+			if (it == bucket.end())
+				bucket.insert(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file ColdCodeMover.cpp
+ * Moves code that always reverts out of the fall-through path of conditional jumps.
+ */
+
+#include <libevmasm/ColdCodeMover.h>
+
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns true if execution can continue with the item after @a _item.
+bool fallsThrough(AssemblyItem const& _item)
+{
+	return
+		_item.type() != Operation ||
+		(_item.instruction() != Instruction::JUMP && !SemanticInformation::terminatesControlFlow(_item.instruction()));
+}
+
+}
+
+ColdCodeMover::ColdCodeMover(
+	AssemblyItems& _items,
+	set<size_t> const& _tagsReferencedFromOutside,
+	function<AssemblyItem()> _newTag
+):
+	m_items(_items),
+	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
+	m_newTag(move(_newTag))
+{
+}
+
+bool ColdCodeMover::optimise()
+{
+	m_tagPositions.clear();
+	m_pushTagCounts.clear();
+	m_revertingTags.clear();
+	for (size_t position = 0; position < m_items.size(); ++position)
+		if (m_items[position].type() == Tag)
+			m_tagPositions[static_cast<size_t>(m_items[position].data())] = position;
+		else if (optional<size_t> tag = pushedTag(m_items[position]))
+			m_pushTagCounts[*tag]++;
+
+	AssemblyItems hotItems;
+	AssemblyItems coldItems;
+	for (size_t position = 0; position < m_items.size();)
+	{
+		// Look for ``ISZERO PUSH tag_ok JUMPI <code that reverts> tag_ok:``.
+		optional<size_t> okTag;
+		if (
+			position + 2 < m_items.size() &&
+			m_items[position] == Instruction::ISZERO &&
+			m_items[position + 2] == Instruction::JUMPI
+		)
+			okTag = pushedTag(m_items[position + 1]);
+		size_t const begin = position + 3;
+		size_t const* end = okTag ? util::valueOrNullptr(m_tagPositions, *okTag) : nullptr;
+		optional<size_t> exit = end && *end > begin ? revertingExit(begin, false) : nullopt;
+		if (!exit || *exit >= *end)
+		{
+			hotItems.push_back(m_items[position]);
+			++position;
+			continue;
+		}
+
+		// Code after the exit is only reachable via tags that are jumped to from elsewhere.
+		map<size_t, size_t> pushesInRange;
+		for (size_t i = begin; i < *end; ++i)
+			if (optional<size_t> tag = pushedTag(m_items[i]))
+				pushesInRange[*tag]++;
+		bool reachableAfterExit = false;
+		for (size_t i = *exit + 1; i < *end; ++i)
+			if (m_items[i].type() == Tag)
+			{
+				size_t tag = static_cast<size_t>(m_items[i].data());
+				if (m_tagsReferencedFromOutside.count(tag) || m_pushTagCounts[tag] > pushesInRange[tag])
+					reachableAfterExit = true;
+			}
+
+		AssemblyItem coldTag = m_newTag();
+		coldTag.setLocation(m_items[begin].location());
+		AssemblyItem pushColdTag = m_items[position + 1];
+		pushColdTag.setData(coldTag.data());
+		hotItems.push_back(move(pushColdTag));
+		hotItems.push_back(m_items[position + 2]);
+
+		coldItems.push_back(move(coldTag));
+		coldItems.insert(coldItems.end(), m_items.begin() + static_cast<ptrdiff_t>(begin), m_items.begin() + static_cast<ptrdiff_t>(*end));
+		if (reachableAfterExit && fallsThrough(coldItems.back()))
+		{
+			coldItems.push_back(m_items[position + 1]);
+			coldItems.emplace_back(Instruction::JUMP, m_items[position + 2].location());
+		}
+		position = *end;
+	}
+
+	if (coldItems.empty())
+		return false;
+
+	// The cold code must not be reached by running past the end of the original code.
+	if (!hotItems.empty() && fallsThrough(hotItems.back()))
+		hotItems.emplace_back(Instruction::STOP);
+	hotItems += move(coldItems);
+	m_items = move(hotItems);
+	return true;
+}
+
+optional<size_t> ColdCodeMover::revertingExit(size_t _begin, bool _crossTags)
+{
+	for (size_t position = _begin; position < m_items.size(); ++position)
+	{
+		AssemblyItem const& item = m_items[position];
+		if (item.type() == Tag)
+		{
+			if (!_crossTags)
+				return nullopt;
+		}
+		else if (item.type() == VerbatimBytecode)
+			return nullopt;
+		else if (SemanticInformation::altersControlFlow(item))
+		{
+			if (SemanticInformation::reverts(item.instruction()))
+				return position;
+			if (item == Instruction::JUMP && position > _begin)
+				if (optional<size_t> tag = pushedTag(m_items[position - 1]); tag && revertingTag(*tag))
+					return position;
+			return nullopt;
+		}
+	}
+	return nullopt;
+}
+
+bool ColdCodeMover::revertingTag(size_t _tag)
+{
+	if (bool const* reverting = util::valueOrNullptr(m_revertingTags, _tag))
+		return *reverting;
+	// Assume that the tag does not revert while it is analysed, so that loops do not count.
+	m_revertingTags[_tag] = false;
+	bool reverting = false;
+	if (size_t const* position = util::valueOrNullptr(m_tagPositions, _tag))
+		reverting = revertingExit(*position + 1, true).has_value();
+	m_revertingTags[_tag] = reverting;
+	return reverting;
+}
+
+optional<size_t> ColdCodeMover::pushedTag(AssemblyItem const& _item)
+{
+	if (_item.type() != PushTag)
+		return nullopt;
+	auto [subId, tag] = _item.splitForeignPushTag();
+	if (subId != numeric_limits<size_t>::max())
+		return nullopt;
+	return tag;
+}
@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file ColdCodeMover.h
+ * Moves code that always reverts out of the fall-through path of conditional jumps.
+ */
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Moves code that is only executed if a conditional jump is not taken and that always reverts
+ * to the end of the assembly and inverts the jump, so that the code that does not revert is
+ * reached by falling through.
+ *
+ * Checks like ``require(x)``, panics and ``if iszero(x) { revert(...) }`` are generated as
+ *
+ *   x ISZERO PUSH tag_ok JUMPI <reverting code> tag_ok: ...
+ *
+ * so every successful execution pays for the ``ISZERO`` and for the ``JUMPDEST`` at ``tag_ok``.
+ * They are transformed into
+ *
+ *   x PUSH tag_revert JUMPI ...
+ *   ...
+ *   tag_revert: <reverting code>
+ *
+ * ``tag_ok`` is kept and can be removed by the JumpdestRemover if it is not referenced otherwise.
+ *
+ * The code after the jump is considered to revert if its straight-line part ends in ``REVERT``
+ * or ``INVALID`` or in a jump to a tag whose straight-line code does so (e.g. a Yul function
+ * that reverts with a panic or an error), i.e. the assembly-level equivalent of the
+ * ``ControlFlowSideEffects`` of a Yul function call. Jumps without an ``ISZERO`` in front
+ * are not transformed, since the inverted condition would cost more than it saves.
+ */
+class ColdCodeMover
+{
+public:
+	ColdCodeMover(
+		AssemblyItems& _items,
+		std::set<size_t> const& _tagsReferencedFromOutside,
+		std::function<AssemblyItem()> _newTag
+	);
+
+	/// @returns true if the items were changed.
+	bool optimise();
+
+private:
+	/// @returns the position of the item that ends the straight-line code starting at @a _begin
+	/// if that code always reverts, nullopt otherwise. Fails on tags unless @a _crossTags is set.
+	std::optional<size_t> revertingExit(size_t _begin, bool _crossTags);
+	/// @returns true if the code at tag @a _tag always reverts.
+	bool revertingTag(size_t _tag);
+	/// @returns the tag of the current assembly pushed by @a _item, if any.
+	static std::optional<size_t> pushedTag(AssemblyItem const& _item);
+
+	AssemblyItems& m_items;
+	std::set<size_t> const& m_tagsReferencedFromOutside;
+	std::function<AssemblyItem()> m_newTag;
+	/// Positions of the tags in the items.
+	std::map<size_t, size_t> m_tagPositions;
+	/// Number of times each tag is pushed by the items.
+	std::map<size_t, size_t> m_pushTagCounts;
+	/// Tags already known to revert or not, also used to break cycles.
+	std::map<size_t, bool> m_revertingTags;
+};
+
+}
@@ -54,8 +54,8 @@ vector<AssemblyItem> CommonSubexpressionEliminator::getOptimizedItems()
 	map<int, Id> initialStackContents;
 	map<int, Id> targetStackContents;
 	int minHeight = m_state.stackHeight() + 1;
-	if (!m_state.stackElements().empty())
-		minHeight = min(minHeight, m_state.stackElements().begin()->first);
+	if (optional<int> lowestHeight = m_state.lowestStackElementHeight())
+		minHeight = min(minHeight, *lowestHeight);
 	for (int height = minHeight; height <= m_initialState.stackHeight(); ++height)
 		initialStackContents[height] = m_initialState.stackElement(height, SourceLocation());
 	for (int height = minHeight; height <= m_state.stackHeight(); ++height)
@@ -24,6 +24,10 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/LRUCache.h>
+
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -187,6 +191,40 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+namespace
+{
+
+using RepresentationKey = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+
+/// Representations found by ComputeMethod. They only depend on the value and the parameters,
+/// so they are shared by all assemblies of the process, including those optimised concurrently.
+util::LRUCache<RepresentationKey, AssemblyItems>& computedRepresentations()
+{
+	static util::LRUCache<RepresentationKey, AssemblyItems> cache(4096);
+	return cache;
+}
+
+}
+
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	RepresentationKey key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	if (optional<AssemblyItems> routine = computedRepresentations().find(key))
+	{
+		m_routine = move(*routine);
+		return;
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+	computedRepresentations().insert(key, m_routine);
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -27,7 +27,10 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
+#include <limits>
 #include <tuple>
 
 using namespace std;
@@ -35,23 +38,35 @@ using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 
-bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression const& _other) const
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
 {
 	assertThrow(!!item && !!_other.item, OptimizerException, "");
-	auto type = item->type();
-	auto otherType = _other.item->type();
-	if (type != otherType)
-		return type < otherType;
-	else if (type == Operation)
-	{
-		auto instr = item->instruction();
-		auto otherInstr = _other.item->instruction();
-		return std::tie(instr, arguments, sequenceNumber) <
-			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
-	}
+	if (
+		hash != _other.hash ||
+		item->type() != _other.item->type() ||
+		arguments != _other.arguments ||
+		sequenceNumber != _other.sequenceNumber
+	)
+		return false;
+	else if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+void ExpressionClasses::computeHash(Expression& _expression)
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t hash = 0;
+	boost::hash_combine(hash, static_cast<unsigned>(_expression.item->type()));
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(hash, static_cast<unsigned>(_expression.item->instruction()));
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+		boost::hash_combine(hash, static_cast<uint64_t>(_expression.item->data() & u256(numeric_limits<uint64_t>::max())));
+	for (Id argument: _expression.arguments)
+		boost::hash_combine(hash, argument);
+	boost::hash_combine(hash, _expression.sequenceNumber);
+	_expression.hash = hash;
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -69,6 +84,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	computeHash(exp);
 
 	if (SemanticInformation::isDeterministic(_item))
 	{
@@ -106,6 +122,7 @@ void ExpressionClasses::forceEqual(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	computeHash(exp);
 
 	if (_copyItem)
 		exp.item = storeItem(_item);
@@ -118,6 +135,7 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	Expression exp;
 	exp.id = static_cast<Id>(m_representatives.size());
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
+	computeHash(exp);
 	m_representatives.push_back(exp);
 	m_expressions.insert(exp);
 	return exp.id;
@@ -149,7 +167,7 @@ bool ExpressionClasses::knownNonZero(Id _c)
 
 u256 const* ExpressionClasses::knownConstant(Id _c)
 {
-	map<unsigned, Expression const*> matchGroups;
+	array<Expression const*, 8> matchGroups{};
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
@@ -182,7 +200,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the state of the current match, so they cannot be shared between threads.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
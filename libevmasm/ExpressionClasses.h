@@ -31,6 +31,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
@@ -60,8 +61,11 @@ public:
 		Ids arguments;
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
+		/// Hash of the item, the arguments and the sequence number, computed when the expression
+		/// is looked up or stored.
+		size_t hash = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
-		bool operator<(Expression const& _other) const;
+		bool operator==(Expression const& _other) const;
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -110,6 +114,14 @@ public:
 	std::string fullDAGToString(Id _id) const;
 
 private:
+	struct ExpressionHash
+	{
+		size_t operator()(Expression const& _expression) const { return _expression.hash; }
+	};
+
+	/// Sets the hash of @a _expression from its item, arguments and sequence number.
+	static void computeHash(Expression& _expression);
+
 	/// Tries to simplify the given expression.
 	/// @returns its class if it possible or Id(-1) otherwise.
 	Id tryToSimplify(Expression const& _expr);
@@ -122,7 +134,7 @@ private:
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -20,6 +20,9 @@
 
 #include <libevmasm/KnownState.h>
 
+#include <array>
+#include <optional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -255,22 +258,28 @@ GasMeter::GasConsumption GasMeter::memoryGas(int _stackPosOffset, int _stackPosS
 
 unsigned GasMeter::runGas(Instruction _instruction)
 {
-	if (_instruction == Instruction::JUMPDEST)
-		return 1;
+	// The constant gas costs of all opcodes, indexed by opcode. Opcodes without a constant cost are nullopt.
+	static array<optional<unsigned>, 256> const runGasCosts = [] {
+		array<optional<unsigned>, 256> costs;
+		for (size_t opcode = 0; opcode < costs.size(); ++opcode)
+			switch (instructionInfo(Instruction(opcode)).gasPriceTier)
+			{
+			case Tier::Zero:    costs[opcode] = GasCosts::tier0Gas; break;
+			case Tier::Base:    costs[opcode] = GasCosts::tier1Gas; break;
+			case Tier::VeryLow: costs[opcode] = GasCosts::tier2Gas; break;
+			case Tier::Low:     costs[opcode] = GasCosts::tier3Gas; break;
+			case Tier::Mid:     costs[opcode] = GasCosts::tier4Gas; break;
+			case Tier::High:    costs[opcode] = GasCosts::tier5Gas; break;
+			case Tier::Ext:     costs[opcode] = GasCosts::tier6Gas; break;
+			default: break;
+			}
+		costs[static_cast<uint8_t>(Instruction::JUMPDEST)] = 1;
+		return costs;
+	}();
 
-	switch (instructionInfo(_instruction).gasPriceTier)
-	{
-	case Tier::Zero:    return GasCosts::tier0Gas;
-	case Tier::Base:    return GasCosts::tier1Gas;
-	case Tier::VeryLow: return GasCosts::tier2Gas;
-	case Tier::Low:     return GasCosts::tier3Gas;
-	case Tier::Mid:     return GasCosts::tier4Gas;
-	case Tier::High:    return GasCosts::tier5Gas;
-	case Tier::Ext:     return GasCosts::tier6Gas;
-	default: break;
-	}
-	assertThrow(false, OptimizerException, "Invalid gas tier for instruction " + instructionInfo(_instruction).name);
-	return 0;
+	optional<unsigned> const& gas = runGasCosts[static_cast<uint8_t>(_instruction)];
+	assertThrow(gas, OptimizerException, "Invalid gas tier for instruction " + instructionInfo(_instruction).name);
+	return *gas;
 }
 
 u256 GasMeter::dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
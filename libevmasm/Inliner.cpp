@@ -76,6 +76,62 @@ optional<size_t> getLocalTag(AssemblyItem const& _item)
 		return nullopt;
 	return tag;
 }
+/// @returns the items of a call site of a function that is not inlined.
+AssemblyItems const& uninlinedCallSitePattern()
+{
+	static AssemblyItems const pattern = {
+		AssemblyItem{PushTag},
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+		AssemblyItem{Tag}
+	};
+	return pattern;
+}
+/// @returns the items of a function that is not inlined, apart from its body.
+AssemblyItems const& uninlinedFunctionPattern()
+{
+	static AssemblyItems const pattern = {
+		AssemblyItem{Tag},
+		// Actual function body. Handled separately.
+		AssemblyItem{Instruction::JUMP}
+	};
+	return pattern;
+}
+}
+
+Inliner::Inliner(
+	AssemblyItems& _items,
+	set<size_t> const& _tagsReferencedFromOutside,
+	size_t _runs,
+	bool _isCreation,
+	langutil::EVMVersion _evmVersion
+):
+	m_items(_items),
+	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
+	m_runs(_runs),
+	m_isCreation(_isCreation),
+	m_evmVersion(_evmVersion),
+	// Both the call site and jump site pattern is executed for each call.
+	m_uninlinedCallExecutionCost(
+		bigint(executionCost(uninlinedCallSitePattern(), _evmVersion)) +
+		executionCost(uninlinedFunctionPattern(), _evmVersion)
+	)
+{
+}
+
+set<size_t> Inliner::referencedTags() const
+{
+	set<size_t> tags;
+	for (auto const& [tag, count]: m_pushTagCounts)
+		if (count > 0)
+			tags.insert(tag);
+	return tags;
+}
+
+uint64_t Inliner::pushTagCount(size_t _tag) const
+{
+	uint64_t const* count = util::valueOrNullptr(m_pushTagCounts, _tag);
+	return count ? *count : 0;
 }
 
 bool Inliner::isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const
@@ -99,17 +155,17 @@ bool Inliner::isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _i
 	return true;
 }
 
-map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyItems const& _items) const
+map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyItems const& _items)
 {
 	std::map<size_t, ranges::span<AssemblyItem const>> inlinableBlockItems;
-	std::map<size_t, uint64_t> numPushTags;
+	m_pushTagCounts.clear();
 	std::optional<size_t> lastTag;
 	for (auto&& [index, item]: _items | ranges::views::enumerate)
 	{
 		// The number of PushTags approximates the number of calls to a block.
 		if (item.type() == PushTag)
 			if (optional<size_t> tag = getLocalTag(item))
-				++numPushTags[*tag];
+				++m_pushTagCounts[*tag];
 
 		// We can only inline blocks with straight control flow that end in a jump.
 		// Using breaksCSEAnalysisBlock will hopefully allow the return jump to be optimized after inlining.
@@ -129,55 +185,39 @@ map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyI
 		}
 	}
 
-	// Store the number of PushTags alongside the assembly items and discard tags that are never pushed.
+	// Store the sizes alongside the assembly items and discard tags that are never pushed.
 	map<size_t, InlinableBlock> result;
 	for (auto&& [tag, items]: inlinableBlockItems)
-		if (uint64_t const* numPushes = util::valueOrNullptr(numPushTags, tag))
-			result.emplace(tag, InlinableBlock{items, *numPushes});
+		if (m_pushTagCounts.count(tag))
+		{
+			uint64_t bodySize = codeSize(ranges::views::drop_last(items, 1));
+			result.emplace(tag, InlinableBlock{items, bodySize, bodySize + items.back().bytesRequired(2)});
+		}
 	return result;
 }
 
-bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const
+bool Inliner::shouldInlineFullFunctionBody(size_t _tag, uint64_t _functionBodySize, uint64_t _pushTagCount) const
 {
-	// Accumulate size of the inline candidate block in bytes (without the return jump).
-	uint64_t functionBodySize = codeSize(ranges::views::drop_last(_block, 1));
-
 	// Use the number of push tags as approximation of the average number of calls to the function per run.
 	uint64_t numberOfCalls = _pushTagCount;
 	// Also use the number of push tags as approximation of the number of call sites to the function.
 	uint64_t numberOfCallSites = _pushTagCount;
 
-	static AssemblyItems const uninlinedCallSitePattern = {
-		AssemblyItem{PushTag},
-		AssemblyItem{PushTag},
-		AssemblyItem{Instruction::JUMP},
-		AssemblyItem{Tag}
-	};
-	static AssemblyItems const uninlinedFunctionPattern = {
-		AssemblyItem{Tag},
-		// Actual function body of size functionBodySize. Handled separately below.
-		AssemblyItem{Instruction::JUMP}
-	};
-
-	// Both the call site and jump site pattern is executed for each call.
 	// Since the function body has to be executed equally often both with and without inlining,
 	// it can be ignored.
-	bigint uninlinedExecutionCost = numberOfCalls * (
-		executionCost(uninlinedCallSitePattern, m_evmVersion) +
-		executionCost(uninlinedFunctionPattern, m_evmVersion)
-	);
+	bigint uninlinedExecutionCost = numberOfCalls * m_uninlinedCallExecutionCost;
 	// Each call site deposits the call site pattern, whereas the jump site pattern and the function itself are deposited once.
 	bigint uninlinedDepositCost = GasMeter::dataGas(
-		numberOfCallSites * codeSize(uninlinedCallSitePattern) +
-		codeSize(uninlinedFunctionPattern) +
-		functionBodySize,
+		numberOfCallSites * codeSize(uninlinedCallSitePattern()) +
+		codeSize(uninlinedFunctionPattern()) +
+		_functionBodySize,
 		m_isCreation,
 		m_evmVersion
 	);
 	// When inlining the execution cost beyond the actual function execution is zero,
 	// but for each call site a copy of the function is deposited.
 	bigint inlinedDepositCost = GasMeter::dataGas(
-		numberOfCallSites * functionBodySize,
+		numberOfCallSites * _functionBodySize,
 		m_isCreation,
 		m_evmVersion
 	);
@@ -186,7 +226,7 @@ bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyIte
 	// the heuristics is optimistic.
 	if (m_tagsReferencedFromOutside.count(_tag))
 		inlinedDepositCost += GasMeter::dataGas(
-			codeSize(uninlinedFunctionPattern) + functionBodySize,
+			codeSize(uninlinedFunctionPattern()) + _functionBodySize,
 			m_isCreation,
 			m_evmVersion
 		);
@@ -208,7 +248,7 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 		_jump.getJumpType() == AssemblyItem::JumpType::IntoFunction &&
 		blockExit == Instruction::JUMP &&
 		blockExit.getJumpType() == AssemblyItem::JumpType::OutOfFunction &&
-		shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount)
+		shouldInlineFullFunctionBody(_tag, _block.bodySize, pushTagCount(_tag))
 	)
 	{
 		blockExit.setJumpType(AssemblyItem::JumpType::Ordinary);
@@ -226,7 +266,7 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 			AssemblyItem{Instruction::JUMP},
 		};
 		if (
-			GasMeter::dataGas(codeSize(_block.items), m_isCreation, m_evmVersion) <=
+			GasMeter::dataGas(_block.size, m_isCreation, m_evmVersion) <=
 			GasMeter::dataGas(codeSize(jumpPattern), m_isCreation, m_evmVersion)
 		)
 			return blockExit;
@@ -244,6 +284,7 @@ void Inliner::optimise()
 		return;
 
 	AssemblyItems newItems;
+	newItems.reserve(m_items.size());
 	for (auto it = m_items.begin(); it != m_items.end(); ++it)
 	{
 		AssemblyItem const& item = *it;
@@ -260,13 +301,12 @@ void Inliner::optimise()
 							newItems.emplace_back(move(*exitItem));
 
 							// We are removing one push tag to the block we inline.
-							--inlinableBlock->pushTagCount;
+							--m_pushTagCounts[*tag];
 							// We might increase the number of push tags to other blocks.
 							for (AssemblyItem const& inlinedItem: inlinableBlock->items)
 								if (inlinedItem.type() == PushTag)
 									if (optional<size_t> duplicatedTag = getLocalTag(inlinedItem))
-										if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
-											++block->pushTagCount;
+										++m_pushTagCounts[*duplicatedTag];
 
 							// Skip the original jump to the inlined tag and continue.
 							++it;
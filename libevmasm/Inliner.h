@@ -42,42 +42,48 @@ public:
 		size_t _runs,
 		bool _isCreation,
 		langutil::EVMVersion _evmVersion
-	):
-	m_items(_items),
-	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
-	m_runs(_runs),
-	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
-	{
-	}
+	);
 	virtual ~Inliner() = default;
 
 	void optimise();
 
+	/// @returns the tags of the current subassembly that are pushed by the items after the last
+	/// call to @a optimise. Can be used instead of scanning the items again, e.g. by the JumpdestRemover.
+	std::set<size_t> referencedTags() const;
+
 private:
 	struct InlinableBlock
 	{
 		ranges::span<AssemblyItem const> items;
-		uint64_t pushTagCount = 0;
+		/// Size in bytes of the items without the exit item.
+		uint64_t bodySize = 0;
+		/// Size in bytes of all items.
+		uint64_t size = 0;
 	};
 
 	/// @returns the exit item for the block to be inlined, if a particular jump to it should be inlined, otherwise nullopt.
 	std::optional<AssemblyItem> shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const;
-	/// @returns true, if the full function at tag @a _tag with body @a _block that is referenced @a _pushTagCount times
-	/// should be inlined, false otherwise. @a _block should start at the first instruction after the function entry tag
-	/// up to and including the return jump.
-	bool shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const;
+	/// @returns true, if the full function at tag @a _tag with a body of @a _functionBodySize bytes (without the return jump)
+	/// that is referenced @a _pushTagCount times should be inlined, false otherwise.
+	bool shouldInlineFullFunctionBody(size_t _tag, uint64_t _functionBodySize, uint64_t _pushTagCount) const;
 	/// @returns true, if the @a _items at @a _tag are a potential candidate for inlining.
 	bool isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const;
-	/// @returns a map from tags that can potentially be inlined to the inlinable item range behind that tag and the
-	/// number of times the tag in question was referenced.
-	std::map<size_t, InlinableBlock> determineInlinableBlocks(AssemblyItems const& _items) const;
+	/// @returns a map from tags that can potentially be inlined and are referenced to the inlinable item range
+	/// behind that tag. Also counts the references to all tags in @a m_pushTagCounts.
+	std::map<size_t, InlinableBlock> determineInlinableBlocks(AssemblyItems const& _items);
+	/// @returns the number of times @a _tag is pushed by the current items.
+	uint64_t pushTagCount(size_t _tag) const;
 
 	AssemblyItems& m_items;
 	std::set<size_t> const& m_tagsReferencedFromOutside;
 	size_t const m_runs = 200;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// Execution cost of a call to a function and its return jump if it is not inlined.
+	bigint m_uninlinedCallExecutionCost;
+	/// Number of PushTags of each tag of the current subassembly. The number of PushTags approximates
+	/// the number of calls to a block and is updated while inlining.
+	std::map<size_t, uint64_t> m_pushTagCounts;
 };
 
 }
@@ -23,7 +23,9 @@
 #include <libevmasm/Instruction.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <array>
 #include <functional>
 
 using namespace std;
@@ -177,150 +179,169 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "SELFDESTRUCT", Instruction::SELFDESTRUCT }
 };
 
-static std::map<Instruction, InstructionInfo> const c_instructionInfo =
+namespace
+{
+
+/// Information on an instruction that can be initialised at compile time.
+struct StaticInstructionInfo
+{
+	Instruction instruction;
+	char const* name;
+	int additional;
+	int args;
+	int ret;
+	bool sideEffects;
+	Tier gasPriceTier;
+};
+
+}
+
+/// The information on all valid instructions. Constant-initialised, so that it does not need
+/// to be constructed on startup.
+static constexpr StaticInstructionInfo c_instructionInfo[] =
 { //												Add, Args, Ret, SideEffects, GasPriceTier
-	{ Instruction::STOP,		{ "STOP",			0, 0, 0, true,  Tier::Zero } },
-	{ Instruction::ADD,			{ "ADD",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SUB,			{ "SUB",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::MUL,			{ "MUL",			0, 2, 1, false, Tier::Low } },
-	{ Instruction::DIV,			{ "DIV",			0, 2, 1, false, Tier::Low } },
-	{ Instruction::SDIV,		{ "SDIV",			0, 2, 1, false, Tier::Low } },
-	{ Instruction::MOD,			{ "MOD",			0, 2, 1, false, Tier::Low } },
-	{ Instruction::SMOD,		{ "SMOD",			0, 2, 1, false, Tier::Low } },
-	{ Instruction::EXP,			{ "EXP",			0, 2, 1, false, Tier::Special } },
-	{ Instruction::NOT,			{ "NOT",			0, 1, 1, false, Tier::VeryLow } },
-	{ Instruction::LT,			{ "LT",				0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::GT,			{ "GT",				0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SLT,			{ "SLT",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SGT,			{ "SGT",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::EQ,			{ "EQ",				0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::ISZERO,		{ "ISZERO",			0, 1, 1, false, Tier::VeryLow } },
-	{ Instruction::AND,			{ "AND",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::OR,			{ "OR",				0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::XOR,			{ "XOR",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::BYTE,		{ "BYTE",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SHL,		{ "SHL",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SHR,		{ "SHR",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::SAR,		{ "SAR",			0, 2, 1, false, Tier::VeryLow } },
-	{ Instruction::ADDMOD,		{ "ADDMOD",			0, 3, 1, false, Tier::Mid } },
-	{ Instruction::MULMOD,		{ "MULMOD",			0, 3, 1, false, Tier::Mid } },
-	{ Instruction::SIGNEXTEND,	{ "SIGNEXTEND",		0, 2, 1, false, Tier::Low } },
-	{ Instruction::KECCAK256,	{ "KECCAK256",			0, 2, 1, true, Tier::Special } },
-	{ Instruction::ADDRESS,		{ "ADDRESS",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::BALANCE,		{ "BALANCE",		0, 1, 1, false, Tier::Balance } },
-	{ Instruction::ORIGIN,		{ "ORIGIN",			0, 0, 1, false, Tier::Base } },
-	{ Instruction::CALLER,		{ "CALLER",			0, 0, 1, false, Tier::Base } },
-	{ Instruction::CALLVALUE,	{ "CALLVALUE",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::CALLDATALOAD,{ "CALLDATALOAD",	0, 1, 1, false, Tier::VeryLow } },
-	{ Instruction::CALLDATASIZE,{ "CALLDATASIZE",	0, 0, 1, false, Tier::Base } },
-	{ Instruction::CALLDATACOPY,{ "CALLDATACOPY",	0, 3, 0, true, Tier::VeryLow } },
-	{ Instruction::CODESIZE,	{ "CODESIZE",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::CODECOPY,	{ "CODECOPY",		0, 3, 0, true, Tier::VeryLow } },
-	{ Instruction::GASPRICE,	{ "GASPRICE",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::EXTCODESIZE,	{ "EXTCODESIZE",	0, 1, 1, false, Tier::ExtCode } },
-	{ Instruction::EXTCODECOPY,	{ "EXTCODECOPY",	0, 4, 0, true, Tier::ExtCode } },
-	{ Instruction::RETURNDATASIZE,	{"RETURNDATASIZE",	0, 0, 1, false, Tier::Base } },
-	{ Instruction::RETURNDATACOPY,	{"RETURNDATACOPY",	0, 3, 0, true, Tier::VeryLow } },
-	{ Instruction::EXTCODEHASH,	{ "EXTCODEHASH",	0, 1, 1, false, Tier::Balance } },
-	{ Instruction::BLOCKHASH,	{ "BLOCKHASH",		0, 1, 1, false, Tier::Ext } },
-	{ Instruction::COINBASE,	{ "COINBASE",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::TIMESTAMP,	{ "TIMESTAMP",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::NUMBER,		{ "NUMBER",			0, 0, 1, false, Tier::Base } },
-	{ Instruction::DIFFICULTY,	{ "DIFFICULTY",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::GASLIMIT,	{ "GASLIMIT",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::CHAINID,		{ "CHAINID",		0, 0, 1, false, Tier::Base } },
-	{ Instruction::SELFBALANCE,	{ "SELFBALANCE",	0, 0, 1, false, Tier::Low } },
-	{ Instruction::POP,			{ "POP",			0, 1, 0, false, Tier::Base } },
-	{ Instruction::MLOAD,		{ "MLOAD",			0, 1, 1, true, Tier::VeryLow } },
-	{ Instruction::MSTORE,		{ "MSTORE",			0, 2, 0, true, Tier::VeryLow } },
-	{ Instruction::MSTORE8,		{ "MSTORE8",		0, 2, 0, true, Tier::VeryLow } },
-	{ Instruction::SLOAD,		{ "SLOAD",			0, 1, 1, false, Tier::Special } },
-	{ Instruction::SSTORE,		{ "SSTORE",			0, 2, 0, true, Tier::Special } },
-	{ Instruction::JUMP,		{ "JUMP",			0, 1, 0, true, Tier::Mid } },
-	{ Instruction::JUMPI,		{ "JUMPI",			0, 2, 0, true, Tier::High } },
-	{ Instruction::PC,			{ "PC",				0, 0, 1, false, Tier::Base } },
-	{ Instruction::MSIZE,		{ "MSIZE",			0, 0, 1, false, Tier::Base } },
-	{ Instruction::GAS,			{ "GAS",			0, 0, 1, false, Tier::Base } },
-	{ Instruction::JUMPDEST,	{ "JUMPDEST",		0, 0, 0, true, Tier::Special } },
-	{ Instruction::PUSH1,		{ "PUSH1",			1, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH2,		{ "PUSH2",			2, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH3,		{ "PUSH3",			3, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH4,		{ "PUSH4",			4, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH5,		{ "PUSH5",			5, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH6,		{ "PUSH6",			6, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH7,		{ "PUSH7",			7, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH8,		{ "PUSH8",			8, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH9,		{ "PUSH9",			9, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH10,		{ "PUSH10",			10, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH11,		{ "PUSH11",			11, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH12,		{ "PUSH12",			12, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH13,		{ "PUSH13",			13, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH14,		{ "PUSH14",			14, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH15,		{ "PUSH15",			15, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH16,		{ "PUSH16",			16, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH17,		{ "PUSH17",			17, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH18,		{ "PUSH18",			18, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH19,		{ "PUSH19",			19, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH20,		{ "PUSH20",			20, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH21,		{ "PUSH21",			21, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH22,		{ "PUSH22",			22, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH23,		{ "PUSH23",			23, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH24,		{ "PUSH24",			24, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH25,		{ "PUSH25",			25, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH26,		{ "PUSH26",			26, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH27,		{ "PUSH27",			27, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH28,		{ "PUSH28",			28, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH29,		{ "PUSH29",			29, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH30,		{ "PUSH30",			30, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH31,		{ "PUSH31",			31, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::PUSH32,		{ "PUSH32",			32, 0, 1, false, Tier::VeryLow } },
-	{ Instruction::DUP1,		{ "DUP1",			0, 1, 2, false, Tier::VeryLow } },
-	{ Instruction::DUP2,		{ "DUP2",			0, 2, 3, false, Tier::VeryLow } },
-	{ Instruction::DUP3,		{ "DUP3",			0, 3, 4, false, Tier::VeryLow } },
-	{ Instruction::DUP4,		{ "DUP4",			0, 4, 5, false, Tier::VeryLow } },
-	{ Instruction::DUP5,		{ "DUP5",			0, 5, 6, false, Tier::VeryLow } },
-	{ Instruction::DUP6,		{ "DUP6",			0, 6, 7, false, Tier::VeryLow } },
-	{ Instruction::DUP7,		{ "DUP7",			0, 7, 8, false, Tier::VeryLow } },
-	{ Instruction::DUP8,		{ "DUP8",			0, 8, 9, false, Tier::VeryLow } },
-	{ Instruction::DUP9,		{ "DUP9",			0, 9, 10, false, Tier::VeryLow } },
-	{ Instruction::DUP10,		{ "DUP10",			0, 10, 11, false, Tier::VeryLow } },
-	{ Instruction::DUP11,		{ "DUP11",			0, 11, 12, false, Tier::VeryLow } },
-	{ Instruction::DUP12,		{ "DUP12",			0, 12, 13, false, Tier::VeryLow } },
-	{ Instruction::DUP13,		{ "DUP13",			0, 13, 14, false, Tier::VeryLow } },
-	{ Instruction::DUP14,		{ "DUP14",			0, 14, 15, false, Tier::VeryLow } },
-	{ Instruction::DUP15,		{ "DUP15",			0, 15, 16, false, Tier::VeryLow } },
-	{ Instruction::DUP16,		{ "DUP16",			0, 16, 17, false, Tier::VeryLow } },
-	{ Instruction::SWAP1,		{ "SWAP1",			0, 2, 2, false, Tier::VeryLow } },
-	{ Instruction::SWAP2,		{ "SWAP2",			0, 3, 3, false, Tier::VeryLow } },
-	{ Instruction::SWAP3,		{ "SWAP3",			0, 4, 4, false, Tier::VeryLow } },
-	{ Instruction::SWAP4,		{ "SWAP4",			0, 5, 5, false, Tier::VeryLow } },
-	{ Instruction::SWAP5,		{ "SWAP5",			0, 6, 6, false, Tier::VeryLow } },
-	{ Instruction::SWAP6,		{ "SWAP6",			0, 7, 7, false, Tier::VeryLow } },
-	{ Instruction::SWAP7,		{ "SWAP7",			0, 8, 8, false, Tier::VeryLow } },
-	{ Instruction::SWAP8,		{ "SWAP8",			0, 9, 9, false, Tier::VeryLow } },
-	{ Instruction::SWAP9,		{ "SWAP9",			0, 10, 10, false, Tier::VeryLow } },
-	{ Instruction::SWAP10,		{ "SWAP10",			0, 11, 11, false, Tier::VeryLow } },
-	{ Instruction::SWAP11,		{ "SWAP11",			0, 12, 12, false, Tier::VeryLow } },
-	{ Instruction::SWAP12,		{ "SWAP12",			0, 13, 13, false, Tier::VeryLow } },
-	{ Instruction::SWAP13,		{ "SWAP13",			0, 14, 14, false, Tier::VeryLow } },
-	{ Instruction::SWAP14,		{ "SWAP14",			0, 15, 15, false, Tier::VeryLow } },
-	{ Instruction::SWAP15,		{ "SWAP15",			0, 16, 16, false, Tier::VeryLow } },
-	{ Instruction::SWAP16,		{ "SWAP16",			0, 17, 17, false, Tier::VeryLow } },
-	{ Instruction::LOG0,		{ "LOG0",			0, 2, 0, true, Tier::Special } },
-	{ Instruction::LOG1,		{ "LOG1",			0, 3, 0, true, Tier::Special } },
-	{ Instruction::LOG2,		{ "LOG2",			0, 4, 0, true, Tier::Special } },
-	{ Instruction::LOG3,		{ "LOG3",			0, 5, 0, true, Tier::Special } },
-	{ Instruction::LOG4,		{ "LOG4",			0, 6, 0, true, Tier::Special } },
-	{ Instruction::CREATE,		{ "CREATE",			0, 3, 1, true, Tier::Special } },
-	{ Instruction::CALL,		{ "CALL",			0, 7, 1, true, Tier::Special } },
-	{ Instruction::CALLCODE,	{ "CALLCODE",		0, 7, 1, true, Tier::Special } },
-	{ Instruction::RETURN,		{ "RETURN",			0, 2, 0, true, Tier::Zero } },
-	{ Instruction::DELEGATECALL,	{ "DELEGATECALL",	0, 6, 1, true, Tier::Special } },
-	{ Instruction::STATICCALL,	{ "STATICCALL",		0, 6, 1, true, Tier::Special } },
-	{ Instruction::CREATE2,		{ "CREATE2",		0, 4, 1, true, Tier::Special } },
-	{ Instruction::REVERT,		{ "REVERT",		0, 2, 0, true, Tier::Zero } },
-	{ Instruction::INVALID,		{ "INVALID",		0, 0, 0, true, Tier::Zero } },
-	{ Instruction::SELFDESTRUCT,	{ "SELFDESTRUCT",		0, 1, 0, true, Tier::Special } }
+	{ Instruction::STOP,		"STOP",			0, 0, 0, true,  Tier::Zero },
+	{ Instruction::ADD,			"ADD",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SUB,			"SUB",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::MUL,			"MUL",			0, 2, 1, false, Tier::Low },
+	{ Instruction::DIV,			"DIV",			0, 2, 1, false, Tier::Low },
+	{ Instruction::SDIV,		"SDIV",			0, 2, 1, false, Tier::Low },
+	{ Instruction::MOD,			"MOD",			0, 2, 1, false, Tier::Low },
+	{ Instruction::SMOD,		"SMOD",			0, 2, 1, false, Tier::Low },
+	{ Instruction::EXP,			"EXP",			0, 2, 1, false, Tier::Special },
+	{ Instruction::NOT,			"NOT",			0, 1, 1, false, Tier::VeryLow },
+	{ Instruction::LT,			"LT",				0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::GT,			"GT",				0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SLT,			"SLT",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SGT,			"SGT",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::EQ,			"EQ",				0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::ISZERO,		"ISZERO",			0, 1, 1, false, Tier::VeryLow },
+	{ Instruction::AND,			"AND",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::OR,			"OR",				0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::XOR,			"XOR",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::BYTE,		"BYTE",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SHL,		"SHL",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SHR,		"SHR",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::SAR,		"SAR",			0, 2, 1, false, Tier::VeryLow },
+	{ Instruction::ADDMOD,		"ADDMOD",			0, 3, 1, false, Tier::Mid },
+	{ Instruction::MULMOD,		"MULMOD",			0, 3, 1, false, Tier::Mid },
+	{ Instruction::SIGNEXTEND,	"SIGNEXTEND",		0, 2, 1, false, Tier::Low },
+	{ Instruction::KECCAK256,	"KECCAK256",			0, 2, 1, true, Tier::Special },
+	{ Instruction::ADDRESS,		"ADDRESS",		0, 0, 1, false, Tier::Base },
+	{ Instruction::BALANCE,		"BALANCE",		0, 1, 1, false, Tier::Balance },
+	{ Instruction::ORIGIN,		"ORIGIN",			0, 0, 1, false, Tier::Base },
+	{ Instruction::CALLER,		"CALLER",			0, 0, 1, false, Tier::Base },
+	{ Instruction::CALLVALUE,	"CALLVALUE",		0, 0, 1, false, Tier::Base },
+	{ Instruction::CALLDATALOAD,"CALLDATALOAD",	0, 1, 1, false, Tier::VeryLow },
+	{ Instruction::CALLDATASIZE,"CALLDATASIZE",	0, 0, 1, false, Tier::Base },
+	{ Instruction::CALLDATACOPY,"CALLDATACOPY",	0, 3, 0, true, Tier::VeryLow },
+	{ Instruction::CODESIZE,	"CODESIZE",		0, 0, 1, false, Tier::Base },
+	{ Instruction::CODECOPY,	"CODECOPY",		0, 3, 0, true, Tier::VeryLow },
+	{ Instruction::GASPRICE,	"GASPRICE",		0, 0, 1, false, Tier::Base },
+	{ Instruction::EXTCODESIZE,	"EXTCODESIZE",	0, 1, 1, false, Tier::ExtCode },
+	{ Instruction::EXTCODECOPY,	"EXTCODECOPY",	0, 4, 0, true, Tier::ExtCode },
+	{ Instruction::RETURNDATASIZE,	"RETURNDATASIZE",	0, 0, 1, false, Tier::Base },
+	{ Instruction::RETURNDATACOPY,	"RETURNDATACOPY",	0, 3, 0, true, Tier::VeryLow },
+	{ Instruction::EXTCODEHASH,	"EXTCODEHASH",	0, 1, 1, false, Tier::Balance },
+	{ Instruction::BLOCKHASH,	"BLOCKHASH",		0, 1, 1, false, Tier::Ext },
+	{ Instruction::COINBASE,	"COINBASE",		0, 0, 1, false, Tier::Base },
+	{ Instruction::TIMESTAMP,	"TIMESTAMP",		0, 0, 1, false, Tier::Base },
+	{ Instruction::NUMBER,		"NUMBER",			0, 0, 1, false, Tier::Base },
+	{ Instruction::DIFFICULTY,	"DIFFICULTY",		0, 0, 1, false, Tier::Base },
+	{ Instruction::GASLIMIT,	"GASLIMIT",		0, 0, 1, false, Tier::Base },
+	{ Instruction::CHAINID,		"CHAINID",		0, 0, 1, false, Tier::Base },
+	{ Instruction::SELFBALANCE,	"SELFBALANCE",	0, 0, 1, false, Tier::Low },
+	{ Instruction::POP,			"POP",			0, 1, 0, false, Tier::Base },
+	{ Instruction::MLOAD,		"MLOAD",			0, 1, 1, true, Tier::VeryLow },
+	{ Instruction::MSTORE,		"MSTORE",			0, 2, 0, true, Tier::VeryLow },
+	{ Instruction::MSTORE8,		"MSTORE8",		0, 2, 0, true, Tier::VeryLow },
+	{ Instruction::SLOAD,		"SLOAD",			0, 1, 1, false, Tier::Special },
+	{ Instruction::SSTORE,		"SSTORE",			0, 2, 0, true, Tier::Special },
+	{ Instruction::JUMP,		"JUMP",			0, 1, 0, true, Tier::Mid },
+	{ Instruction::JUMPI,		"JUMPI",			0, 2, 0, true, Tier::High },
+	{ Instruction::PC,			"PC",				0, 0, 1, false, Tier::Base },
+	{ Instruction::MSIZE,		"MSIZE",			0, 0, 1, false, Tier::Base },
+	{ Instruction::GAS,			"GAS",			0, 0, 1, false, Tier::Base },
+	{ Instruction::JUMPDEST,	"JUMPDEST",		0, 0, 0, true, Tier::Special },
+	{ Instruction::PUSH1,		"PUSH1",			1, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH2,		"PUSH2",			2, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH3,		"PUSH3",			3, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH4,		"PUSH4",			4, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH5,		"PUSH5",			5, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH6,		"PUSH6",			6, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH7,		"PUSH7",			7, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH8,		"PUSH8",			8, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH9,		"PUSH9",			9, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH10,		"PUSH10",			10, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH11,		"PUSH11",			11, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH12,		"PUSH12",			12, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH13,		"PUSH13",			13, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH14,		"PUSH14",			14, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH15,		"PUSH15",			15, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH16,		"PUSH16",			16, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH17,		"PUSH17",			17, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH18,		"PUSH18",			18, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH19,		"PUSH19",			19, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH20,		"PUSH20",			20, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH21,		"PUSH21",			21, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH22,		"PUSH22",			22, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH23,		"PUSH23",			23, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH24,		"PUSH24",			24, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH25,		"PUSH25",			25, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH26,		"PUSH26",			26, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH27,		"PUSH27",			27, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH28,		"PUSH28",			28, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH29,		"PUSH29",			29, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH30,		"PUSH30",			30, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH31,		"PUSH31",			31, 0, 1, false, Tier::VeryLow },
+	{ Instruction::PUSH32,		"PUSH32",			32, 0, 1, false, Tier::VeryLow },
+	{ Instruction::DUP1,		"DUP1",			0, 1, 2, false, Tier::VeryLow },
+	{ Instruction::DUP2,		"DUP2",			0, 2, 3, false, Tier::VeryLow },
+	{ Instruction::DUP3,		"DUP3",			0, 3, 4, false, Tier::VeryLow },
+	{ Instruction::DUP4,		"DUP4",			0, 4, 5, false, Tier::VeryLow },
+	{ Instruction::DUP5,		"DUP5",			0, 5, 6, false, Tier::VeryLow },
+	{ Instruction::DUP6,		"DUP6",			0, 6, 7, false, Tier::VeryLow },
+	{ Instruction::DUP7,		"DUP7",			0, 7, 8, false, Tier::VeryLow },
+	{ Instruction::DUP8,		"DUP8",			0, 8, 9, false, Tier::VeryLow },
+	{ Instruction::DUP9,		"DUP9",			0, 9, 10, false, Tier::VeryLow },
+	{ Instruction::DUP10,		"DUP10",			0, 10, 11, false, Tier::VeryLow },
+	{ Instruction::DUP11,		"DUP11",			0, 11, 12, false, Tier::VeryLow },
+	{ Instruction::DUP12,		"DUP12",			0, 12, 13, false, Tier::VeryLow },
+	{ Instruction::DUP13,		"DUP13",			0, 13, 14, false, Tier::VeryLow },
+	{ Instruction::DUP14,		"DUP14",			0, 14, 15, false, Tier::VeryLow },
+	{ Instruction::DUP15,		"DUP15",			0, 15, 16, false, Tier::VeryLow },
+	{ Instruction::DUP16,		"DUP16",			0, 16, 17, false, Tier::VeryLow },
+	{ Instruction::SWAP1,		"SWAP1",			0, 2, 2, false, Tier::VeryLow },
+	{ Instruction::SWAP2,		"SWAP2",			0, 3, 3, false, Tier::VeryLow },
+	{ Instruction::SWAP3,		"SWAP3",			0, 4, 4, false, Tier::VeryLow },
+	{ Instruction::SWAP4,		"SWAP4",			0, 5, 5, false, Tier::VeryLow },
+	{ Instruction::SWAP5,		"SWAP5",			0, 6, 6, false, Tier::VeryLow },
+	{ Instruction::SWAP6,		"SWAP6",			0, 7, 7, false, Tier::VeryLow },
+	{ Instruction::SWAP7,		"SWAP7",			0, 8, 8, false, Tier::VeryLow },
+	{ Instruction::SWAP8,		"SWAP8",			0, 9, 9, false, Tier::VeryLow },
+	{ Instruction::SWAP9,		"SWAP9",			0, 10, 10, false, Tier::VeryLow },
+	{ Instruction::SWAP10,		"SWAP10",			0, 11, 11, false, Tier::VeryLow },
+	{ Instruction::SWAP11,		"SWAP11",			0, 12, 12, false, Tier::VeryLow },
+	{ Instruction::SWAP12,		"SWAP12",			0, 13, 13, false, Tier::VeryLow },
+	{ Instruction::SWAP13,		"SWAP13",			0, 14, 14, false, Tier::VeryLow },
+	{ Instruction::SWAP14,		"SWAP14",			0, 15, 15, false, Tier::VeryLow },
+	{ Instruction::SWAP15,		"SWAP15",			0, 16, 16, false, Tier::VeryLow },
+	{ Instruction::SWAP16,		"SWAP16",			0, 17, 17, false, Tier::VeryLow },
+	{ Instruction::LOG0,		"LOG0",			0, 2, 0, true, Tier::Special },
+	{ Instruction::LOG1,		"LOG1",			0, 3, 0, true, Tier::Special },
+	{ Instruction::LOG2,		"LOG2",			0, 4, 0, true, Tier::Special },
+	{ Instruction::LOG3,		"LOG3",			0, 5, 0, true, Tier::Special },
+	{ Instruction::LOG4,		"LOG4",			0, 6, 0, true, Tier::Special },
+	{ Instruction::CREATE,		"CREATE",			0, 3, 1, true, Tier::Special },
+	{ Instruction::CALL,		"CALL",			0, 7, 1, true, Tier::Special },
+	{ Instruction::CALLCODE,	"CALLCODE",		0, 7, 1, true, Tier::Special },
+	{ Instruction::RETURN,		"RETURN",			0, 2, 0, true, Tier::Zero },
+	{ Instruction::DELEGATECALL,	"DELEGATECALL",	0, 6, 1, true, Tier::Special },
+	{ Instruction::STATICCALL,	"STATICCALL",		0, 6, 1, true, Tier::Special },
+	{ Instruction::CREATE2,		"CREATE2",		0, 4, 1, true, Tier::Special },
+	{ Instruction::REVERT,		"REVERT",		0, 2, 0, true, Tier::Zero },
+	{ Instruction::INVALID,		"INVALID",		0, 0, 0, true, Tier::Zero },
+	{ Instruction::SELFDESTRUCT,	"SELFDESTRUCT",		0, 1, 0, true, Tier::Special }
 };
 
 void solidity::evmasm::eachInstruction(
@@ -352,37 +373,70 @@ void solidity::evmasm::eachInstruction(
 	}
 }
 
+namespace
+{
+
+/// @returns @a _value in upper case hex digits without leading zeros.
+string upperHexWithoutLeadingZeros(u256 const& _value)
+{
+	string hex = toHex(toCompactBigEndian(_value, 1), HexPrefix::DontAdd, HexCase::Upper);
+	if (hex.size() > 1 && hex[0] == '0')
+		hex.erase(0, 1);
+	return hex;
+}
+
+}
+
 string solidity::evmasm::disassemble(bytes const& _mem, string const& _delimiter)
 {
-	stringstream ret;
+	string ret;
 	eachInstruction(_mem, [&](Instruction _instr, u256 const& _data) {
 		if (!isValidInstruction(_instr))
-			ret << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << _delimiter;
+			ret += "0x" + upperHexWithoutLeadingZeros(static_cast<uint8_t>(_instr)) + _delimiter;
 		else
 		{
-			InstructionInfo info = instructionInfo(_instr);
-			ret << info.name;
+			InstructionInfo const& info = instructionInfo(_instr);
+			ret += info.name;
 			if (info.additional)
-				ret << " 0x" << std::uppercase << std::hex << _data;
-			ret << _delimiter;
+				ret += " 0x" + upperHexWithoutLeadingZeros(_data);
+			ret += _delimiter;
 		}
 	});
-	return ret.str();
+	return ret;
 }
 
-InstructionInfo solidity::evmasm::instructionInfo(Instruction _inst)
+namespace
 {
-	try
-	{
-		return c_instructionInfo.at(_inst);
-	}
-	catch (...)
-	{
-		return InstructionInfo({"<INVALID_INSTRUCTION: " + toString((unsigned)_inst) + ">", 0, 0, 0, false, Tier::Invalid});
-	}
+
+/// The information on all 256 possible opcodes, indexed by opcode.
+array<InstructionInfo, 256> const& instructionInfoTable()
+{
+	static array<InstructionInfo, 256> const table = [] {
+		array<InstructionInfo, 256> result;
+		for (size_t opcode = 0; opcode < result.size(); ++opcode)
+			result[opcode] = {"<INVALID_INSTRUCTION: " + toString(opcode) + ">", 0, 0, 0, false, Tier::Invalid};
+		for (StaticInstructionInfo const& info: c_instructionInfo)
+			result[static_cast<uint8_t>(info.instruction)] = {
+				info.name,
+				info.additional,
+				info.args,
+				info.ret,
+				info.sideEffects,
+				info.gasPriceTier
+			};
+		return result;
+	}();
+	return table;
+}
+
+}
+
+InstructionInfo const& solidity::evmasm::instructionInfo(Instruction _inst)
+{
+	return instructionInfoTable()[static_cast<uint8_t>(_inst)];
 }
 
 bool solidity::evmasm::isValidInstruction(Instruction _inst)
 {
-	return !!c_instructionInfo.count(_inst);
+	return instructionInfo(_inst).gasPriceTier != Tier::Invalid;
 }
@@ -291,7 +291,8 @@ struct InstructionInfo
 };
 
 /// Information on all the instructions.
-InstructionInfo instructionInfo(Instruction _inst);
+/// Values of @a _inst that are not valid instructions yield an info with tier Tier::Invalid.
+InstructionInfo const& instructionInfo(Instruction _inst);
 
 /// check whether instructions exists.
 bool isValidInstruction(Instruction _inst);
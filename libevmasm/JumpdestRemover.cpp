@@ -31,7 +31,12 @@ using namespace solidity::evmasm;
 
 bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside)
 {
-	set<size_t> references{referencedTags(m_items, numeric_limits<size_t>::max())};
+	return optimise(_tagsReferencedFromOutside, referencedTags(m_items, numeric_limits<size_t>::max()));
+}
+
+bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside, set<size_t> _referencedTags)
+{
+	set<size_t> references{move(_referencedTags)};
 	references.insert(_tagsReferencedFromOutside.begin(), _tagsReferencedFromOutside.end());
 
 	size_t initialSize = m_items.size();
@@ -36,6 +36,9 @@ public:
 	explicit JumpdestRemover(AssemblyItems& _items): m_items(_items) {}
 
 	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside);
+	/// Same as above, but uses the already known tags @a _referencedTags that are referenced
+	/// from the items instead of determining them.
+	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside, std::set<size_t> _referencedTags);
 
 	/// @returns a set of all tags from the given sub-assembly that are referenced
 	/// from the given list of items.
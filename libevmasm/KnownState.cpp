@@ -26,6 +26,7 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <functional>
 
 using namespace std;
@@ -60,13 +61,13 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, eqClass);
 
 	_out << "Stack:" << endl;
-	for (auto const& it: m_stackElements)
+	for (auto const& [height, id]: stackElements())
 	{
-		_out << "  " << dec << it.first << ": ";
-		streamExpressionClass(_out, it.second);
+		_out << "  " << dec << height << ": ";
+		streamExpressionClass(_out, id);
 	}
 	_out << "Storage:" << endl;
-	for (auto const& it: m_storageContent)
+	for (auto const& it: *m_storageContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -74,7 +75,7 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Memory:" << endl;
-	for (auto const& it: m_memoryContent)
+	for (auto const& it: *m_memoryContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -107,10 +108,7 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 		resetKnownKeccak256Hashes();
 		resetStorage();
 		// Consume all arguments and place unknown return values on the stack.
-		m_stackElements.erase(
-			m_stackElements.upper_bound(m_stackHeight - static_cast<int>(_item.arguments())),
-			m_stackElements.end()
-		);
+		removeStackElementsAbove(m_stackHeight - static_cast<int>(_item.arguments()));
 		m_stackHeight += static_cast<int>(_item.deposit());
 		for (size_t i = 0; i < _item.returnValues(); ++i)
 			setStackElement(
@@ -130,7 +128,7 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 	else
 	{
 		Instruction instruction = _item.instruction();
-		InstructionInfo info = instructionInfo(instruction);
+		InstructionInfo const& info = instructionInfo(instruction);
 		if (SemanticInformation::isDupInstruction(_item))
 			setStackElement(
 				m_stackHeight + 1,
@@ -200,10 +198,7 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					);
 			}
 		}
-		m_stackElements.erase(
-			m_stackElements.upper_bound(m_stackHeight + static_cast<int>(_item.deposit())),
-			m_stackElements.end()
-		);
+		removeStackElementsAbove(m_stackHeight + static_cast<int>(_item.deposit()));
 		m_stackHeight += static_cast<int>(_item.deposit());
 	}
 	return op;
@@ -211,48 +206,59 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 
 /// Helper function for KnownState::reduceToCommonKnowledge, removes everything from
 /// _this which is not in or not equal to the value in _other.
-template <class Mapping> void intersect(Mapping& _this, Mapping const& _other)
+template <class Mapping> void intersect(util::CopyOnWrite<Mapping>& _this, util::CopyOnWrite<Mapping> const& _other)
 {
-	for (auto it = _this.begin(); it != _this.end();)
-		if (_other.count(it->first) && _other.at(it->first) == it->second)
-			++it;
+	if (_this.sharesValueWith(_other))
+		return;
+	auto notInOther = [&](auto const& _entry) {
+		auto it = _other->find(_entry.first);
+		return it == _other->end() || it->second != _entry.second;
+	};
+	// Only copies the mapping if something has to be removed.
+	if (none_of(_this->begin(), _this->end(), notInOther))
+		return;
+	Mapping& mapping = _this.write();
+	for (auto it = mapping.begin(); it != mapping.end();)
+		if (notInOther(*it))
+			it = mapping.erase(it);
 		else
-			it = _this.erase(it);
+			++it;
 }
 
 void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers)
 {
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (_other.m_stackElements.count(it->first - stackDiff))
+	bool const sameStack =
+		m_stackElements.sharesValueWith(_other.m_stackElements) &&
+		stackDiff == 0 &&
+		m_stackElementsOffset == _other.m_stackElementsOffset;
+	for (size_t i = 0; !sameStack && i < m_stackElements->size(); ++i)
+	{
+		Id element = (*m_stackElements)[i];
+		if (element == c_unknownStackElement)
+			continue;
+		Id const* other = _other.knownStackElement(m_stackElementsOffset + static_cast<int>(i) - stackDiff);
+		if (!other)
+			m_stackElements.write()[i] = c_unknownStackElement;
+		else if (element != *other)
 		{
-			Id other = _other.m_stackElements.at(it->first - stackDiff);
-			if (it->second == other)
-				++it;
-			else
+			set<u256> theseTags = tagsInExpression(element);
+			set<u256> otherTags = tagsInExpression(*other);
+			if (!theseTags.empty() && !otherTags.empty())
 			{
-				set<u256> theseTags = tagsInExpression(it->second);
-				set<u256> otherTags = tagsInExpression(other);
-				if (!theseTags.empty() && !otherTags.empty())
-				{
-					theseTags.insert(otherTags.begin(), otherTags.end());
-					it->second = tagUnion(theseTags);
-					++it;
-				}
-				else
-					it = m_stackElements.erase(it);
+				theseTags.insert(otherTags.begin(), otherTags.end());
+				Id unionId = tagUnion(theseTags);
+				m_stackElements.write()[i] = unionId;
 			}
+			else
+				m_stackElements.write()[i] = c_unknownStackElement;
 		}
-		else
-			it = m_stackElements.erase(it);
+	}
 
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
-		map<int, Id> shiftedStack;
-		for (auto const& stackElement: m_stackElements)
-			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
-		m_stackElements = move(shiftedStack);
+		m_stackElementsOffset -= stackDiff;
 		m_stackHeight = _other.m_stackHeight;
 	}
 
@@ -267,21 +273,61 @@ bool KnownState::operator==(KnownState const& _other) const
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	auto thisIt = m_stackElements.cbegin();
-	auto otherIt = _other.m_stackElements.cbegin();
-	for (; thisIt != m_stackElements.cend() && otherIt != _other.m_stackElements.cend(); ++thisIt, ++otherIt)
-		if (thisIt->first - stackDiff != otherIt->first || thisIt->second != otherIt->second)
+	if (
+		m_stackElements.sharesValueWith(_other.m_stackElements) &&
+		stackDiff == 0 &&
+		m_stackElementsOffset == _other.m_stackElementsOffset
+	)
+		return true;
+	vector<Id> const& theseElements = *m_stackElements;
+	vector<Id> const& otherElements = *_other.m_stackElements;
+	// Compares the known elements in the order of their stack heights.
+	auto skipUnknown = [](vector<Id> const& _elements, size_t _index) {
+		while (_index < _elements.size() && _elements[_index] == c_unknownStackElement)
+			++_index;
+		return _index;
+	};
+	size_t thisIndex = skipUnknown(theseElements, 0);
+	size_t otherIndex = skipUnknown(otherElements, 0);
+	for (
+		;
+		thisIndex < theseElements.size() && otherIndex < otherElements.size();
+		thisIndex = skipUnknown(theseElements, thisIndex + 1),
+		otherIndex = skipUnknown(otherElements, otherIndex + 1)
+	)
+		if (
+			m_stackElementsOffset + static_cast<int>(thisIndex) - stackDiff !=
+				_other.m_stackElementsOffset + static_cast<int>(otherIndex) ||
+			theseElements[thisIndex] != otherElements[otherIndex]
+		)
 			return false;
-	return (thisIt == m_stackElements.cend() && otherIt == _other.m_stackElements.cend());
+	return thisIndex == theseElements.size() && otherIndex == otherElements.size();
 }
 
 ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation const& _location)
 {
-	if (m_stackElements.count(_stackHeight))
-		return m_stackElements.at(_stackHeight);
+	if (Id const* element = knownStackElement(_stackHeight))
+		return *element;
 	// Stack element not found (not assigned yet), create new unknown equivalence class.
-	return m_stackElements[_stackHeight] =
-			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
+	Id id = m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
+	return stackElementEntry(_stackHeight) = id;
+}
+
+map<int, ExpressionClasses::Id> KnownState::stackElements() const
+{
+	map<int, Id> elements;
+	for (size_t i = 0; i < m_stackElements->size(); ++i)
+		if ((*m_stackElements)[i] != c_unknownStackElement)
+			elements[m_stackElementsOffset + static_cast<int>(i)] = (*m_stackElements)[i];
+	return elements;
+}
+
+optional<int> KnownState::lowestStackElementHeight() const
+{
+	for (size_t i = 0; i < m_stackElements->size(); ++i)
+		if ((*m_stackElements)[i] != c_unknownStackElement)
+			return m_stackElementsOffset + static_cast<int>(i);
+	return nullopt;
 }
 
 KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation const& _location)
@@ -291,16 +337,54 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 
 void KnownState::clearTagUnions()
 {
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
-			it = m_stackElements.erase(it);
-		else
-			++it;
+	if (m_tagUnions->empty())
+		return;
+	for (size_t i = 0; i < m_stackElements->size(); ++i)
+		if (m_tagUnions->left.count((*m_stackElements)[i]))
+			m_stackElements.write()[i] = c_unknownStackElement;
+}
+
+KnownState::Id const* KnownState::knownStackElement(int _stackHeight) const
+{
+	if (_stackHeight < m_stackElementsOffset)
+		return nullptr;
+	size_t index = static_cast<size_t>(_stackHeight - m_stackElementsOffset);
+	if (index >= m_stackElements->size() || (*m_stackElements)[index] == c_unknownStackElement)
+		return nullptr;
+	return &(*m_stackElements)[index];
+}
+
+KnownState::Id& KnownState::stackElementEntry(int _stackHeight)
+{
+	vector<Id>& elements = m_stackElements.write();
+	if (elements.empty())
+		m_stackElementsOffset = _stackHeight;
+	else if (_stackHeight < m_stackElementsOffset)
+	{
+		elements.insert(
+			elements.begin(),
+			static_cast<size_t>(m_stackElementsOffset - _stackHeight),
+			c_unknownStackElement
+		);
+		m_stackElementsOffset = _stackHeight;
+	}
+	size_t index = static_cast<size_t>(_stackHeight - m_stackElementsOffset);
+	if (index >= elements.size())
+		elements.resize(index + 1, c_unknownStackElement);
+	return elements[index];
+}
+
+void KnownState::removeStackElementsAbove(int _stackHeight)
+{
+	if (_stackHeight < m_stackElementsOffset)
+		m_stackElements.clear();
+	else if (static_cast<size_t>(_stackHeight - m_stackElementsOffset) < m_stackElements->size())
+		m_stackElements.write().resize(static_cast<size_t>(_stackHeight - m_stackElementsOffset) + 1);
 }
 
 void KnownState::setStackElement(int _stackHeight, Id _class)
 {
-	m_stackElements[_stackHeight] = _class;
+	stackElementEntry(_stackHeight) = _class;
 }
 
 void KnownState::swapStackElements(
@@ -314,7 +398,8 @@ void KnownState::swapStackElements(
 	stackElement(_stackHeightA, _location);
 	stackElement(_stackHeightB, _location);
 
-	swap(m_stackElements[_stackHeightA], m_stackElements[_stackHeightB]);
+	// Both entries exist now, so looking up one does not invalidate the other.
+	swap(stackElementEntry(_stackHeightA), stackElementEntry(_stackHeightB));
 }
 
 KnownState::StoreOperation KnownState::storeInStorage(
@@ -322,23 +407,23 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	Id _value,
 	SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
+	if (m_storageContent->count(_slot) && m_storageContent->at(_slot) == _value)
 		// do not execute the storage if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_storageContent) storageContents;
+	map<Id, Id> storageContents;
 	// Copy over all values (i.e. retain knowledge about them) where we know that this store
 	// operation will not destroy the knowledge. Specifically, we copy storage locations we know
 	// are different from _slot or locations where we know that the stored value is equal to _value.
-	for (auto const& storageItem: m_storageContent)
+	for (auto const& storageItem: *m_storageContent)
 		if (m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) || storageItem.second == _value)
 			storageContents.insert(storageItem);
-	m_storageContent = move(storageContents);
 
 	AssemblyItem item(Instruction::SSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Storage, _slot, m_sequenceNumber, id};
-	m_storageContent[_slot] = _value;
+	storageContents[_slot] = _value;
+	m_storageContent = util::CopyOnWrite<map<Id, Id>>(move(storageContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 
@@ -347,30 +432,31 @@ KnownState::StoreOperation KnownState::storeInStorage(
 
 ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot))
-		return m_storageContent.at(_slot);
+	if (m_storageContent->count(_slot))
+		return m_storageContent->at(_slot);
 
 	AssemblyItem item(Instruction::SLOAD, _location);
-	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	Id id = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_storageContent.write()[_slot] = id;
 }
 
 KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
+	if (m_memoryContent->count(_slot) && m_memoryContent->at(_slot) == _value)
 		// do not execute the store if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_memoryContent) memoryContents;
+	map<Id, Id> memoryContents;
 	// copy over values at points where we know that they are different from _slot by at least 32
-	for (auto const& memoryItem: m_memoryContent)
+	for (auto const& memoryItem: *m_memoryContent)
 		if (m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
 			memoryContents.insert(memoryItem);
-	m_memoryContent = move(memoryContents);
 
 	AssemblyItem item(Instruction::MSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Memory, _slot, m_sequenceNumber, id};
-	m_memoryContent[_slot] = _value;
+	memoryContents[_slot] = _value;
+	m_memoryContent = util::CopyOnWrite<map<Id, Id>>(move(memoryContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 	return operation;
@@ -378,11 +464,12 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 
 ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot))
-		return m_memoryContent.at(_slot);
+	if (m_memoryContent->count(_slot))
+		return m_memoryContent->at(_slot);
 
 	AssemblyItem item(Instruction::MLOAD, _location);
-	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	Id id = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_memoryContent.write()[_slot] = id;
 }
 
 KnownState::Id KnownState::applyKeccak256(
@@ -407,8 +494,8 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count({arguments, length}))
-		return m_knownKeccak256Hashes.at({arguments, length});
+	if (m_knownKeccak256Hashes->count({arguments, length}))
+		return m_knownKeccak256Hashes->at({arguments, length});
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -421,13 +508,13 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[{arguments, length}] = v;
+	return m_knownKeccak256Hashes.write()[{move(arguments), length}] = v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
-	if (m_tagUnions.left.count(_expressionId))
-		return m_tagUnions.left.at(_expressionId);
+	if (m_tagUnions->left.count(_expressionId))
+		return m_tagUnions->left.at(_expressionId);
 	// Might be a tag, then return the set of itself.
 	ExpressionClasses::Expression expr = m_expressionClasses->representative(_expressionId);
 	if (expr.item && expr.item->type() == PushTag)
@@ -438,12 +525,12 @@ set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 
 KnownState::Id KnownState::tagUnion(set<u256> _tags)
 {
-	if (m_tagUnions.right.count(_tags))
-		return m_tagUnions.right.at(_tags);
+	if (m_tagUnions->right.count(_tags))
+		return m_tagUnions->right.at(_tags);
 	else
 	{
 		Id id = m_expressionClasses->newClass(SourceLocation());
-		m_tagUnions.right.insert(make_pair(_tags, id));
+		m_tagUnions.write().right.insert(make_pair(_tags, id));
 		return id;
 	}
 }
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <optional>
 #include <set>
 #include <tuple>
 #include <memory>
@@ -54,6 +55,7 @@
 #endif // defined(__clang__)
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/CopyOnWrite.h>
 #include <libsolutil/Exceptions.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
@@ -76,6 +78,9 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * The knowledge is shared between copies of a state until it is modified, so that copying a
+ * state for every successor of a block is cheap.
  */
 class KnownState
 {
@@ -113,7 +118,7 @@ public:
 	/// Resets known Keccak-256 hashes
 	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.clear(); }
 	/// Resets any knowledge about the current stack.
-	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
+	void resetStack() { m_stackElements.clear(); m_stackElementsOffset = 0; m_stackHeight = 0; }
 	/// Resets any knowledge.
 	void reset() { resetStorage(); resetMemory(); resetKnownKeccak256Hashes(); resetStack(); }
 
@@ -125,7 +130,8 @@ public:
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
-	/// @returns a shared pointer to a copy of this state.
+	/// @returns a shared pointer to a copy of this state, which shares the knowledge with
+	/// this state until one of them is modified.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -145,12 +151,26 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	/// @returns the known stack elements by stack height.
+	std::map<int, Id> stackElements() const;
+	/// @returns the stack height of the lowest known stack element, if there is any.
+	std::optional<int> lowestStackElementHeight() const;
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
+	/// Marks stack elements that are not known in @a m_stackElements.
+	static Id constexpr c_unknownStackElement = Id(-1);
+
+	/// @returns a pointer to the class of the given stack element or nullptr if it is not known.
+	Id const* knownStackElement(int _stackHeight) const;
+	/// @returns a reference to the entry of the given stack element, extending the stored range
+	/// of the stack if needed.
+	Id& stackElementEntry(int _stackHeight);
+	/// Forgets all stack elements above @a _stackHeight.
+	void removeStackElementsAbove(int _stackHeight);
+
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
 	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
@@ -176,23 +196,25 @@ private:
 
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
-	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	/// Current stack layout, the equivalence classes of the stack elements starting at stack height
+	/// @a m_stackElementsOffset. Elements that are not known are c_unknownStackElement.
+	util::CopyOnWrite<std::vector<Id>> m_stackElements;
+	int m_stackElementsOffset = 0;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	util::CopyOnWrite<std::map<std::pair<std::vector<Id>, unsigned>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	util::CopyOnWrite<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
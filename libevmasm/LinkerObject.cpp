@@ -23,6 +23,11 @@
 #include <libevmasm/LinkerObject.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
 
 using namespace std;
 using namespace solidity;
@@ -47,16 +52,73 @@ void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 	linkReferences.swap(remainingRefs);
 }
 
+vector<LinkerObject::HexLinkingResult> LinkerObject::linkHex(
+	vector<string*> const& _hexObjects,
+	map<string, h160> const& _libraryAddresses,
+	size_t _parallelism
+)
+{
+	// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
+	// This leaves 36 characters for the library identifier. The identifier used to
+	// be just the cropped or '_'-padded library name, but this changed to
+	// the cropped hex representation of the hash of the library name.
+	size_t const placeholderSize = 40;
+	map<string, string> replacements;
+	for (auto const& [name, address]: _libraryAddresses)
+	{
+		string hexAddress = util::toHex(address.asBytes());
+		replacements["__" + libraryPlaceholder(name) + "__"] = hexAddress;
+
+		string replacement = "__";
+		for (size_t i = 0; i < placeholderSize - 4; ++i)
+			replacement.push_back(i < name.size() ? name[i] : '_');
+		replacement += "__";
+		replacements[replacement] = hexAddress;
+	}
+
+	vector<HexLinkingResult> results(_hexObjects.size());
+	vector<size_t> indices(_hexObjects.size());
+	iota(indices.begin(), indices.end(), 0);
+	ThreadPool(_parallelism).forEach(indices, [&](size_t _index) {
+		string& hex = *_hexObjects[_index];
+		HexLinkingResult& result = results[_index];
+		for (size_t pos = hex.find('_'); pos != string::npos; pos = hex.find('_', pos))
+		{
+			if (
+				hex.size() - pos < placeholderSize ||
+				hex[pos + 1] != '_' ||
+				hex[pos + placeholderSize - 2] != '_' ||
+				hex[pos + placeholderSize - 1] != '_'
+			)
+			{
+				result.invalidReference = pos;
+				return;
+			}
+
+			string placeholder = hex.substr(pos, placeholderSize);
+			if (auto it = replacements.find(placeholder); it != replacements.end())
+				hex.replace(pos, placeholderSize, it->second);
+			else
+				result.unresolvedReferences.emplace_back(pos, move(placeholder));
+			pos += placeholderSize;
+		}
+	});
+	return results;
+}
+
 string LinkerObject::toHex() const
 {
 	string hex = solidity::util::toHex(bytecode);
+	// Libraries are usually referenced several times, but the placeholder is only computed once.
+	map<string, string> placeholders;
 	for (auto const& ref: linkReferences)
 	{
 		size_t pos = ref.first * 2;
-		string hash = libraryPlaceholder(ref.second);
+		auto placeholder = placeholders.find(ref.second);
+		if (placeholder == placeholders.end())
+			placeholder = placeholders.emplace(ref.second, libraryPlaceholder(ref.second)).first;
 		hex[pos] = hex[pos + 1] = hex[pos + 38] = hex[pos + 39] = '_';
-		for (size_t i = 0; i < 36; ++i)
-			hex[pos + 2 + i] = hash.at(i);
+		copy_n(placeholder->second.begin(), 36, hex.begin() + static_cast<ptrdiff_t>(pos + 2));
 	}
 	return hex;
 }
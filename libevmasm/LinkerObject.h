@@ -25,6 +25,11 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace solidity::evmasm
 {
 
@@ -62,6 +67,27 @@ struct LinkerObject
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
 	void link(std::map<std::string, util::h160> const& _libraryAddresses);
 
+	/// Outcome of linking a hex encoded object with @a linkHex.
+	struct HexLinkingResult
+	{
+		/// Position of a malformed placeholder, at which linking of the object stopped.
+		std::optional<size_t> invalidReference;
+		/// Positions and placeholders of libraries whose address was not given.
+		std::vector<std::pair<size_t, std::string>> unresolvedReferences;
+	};
+
+	/// Links hex encoded objects (as created by @a toHex) against the same libraries by replacing
+	/// the placeholders in place. Besides the placeholders created by @a libraryPlaceholder, the
+	/// cropped or '_'-padded library names used by older compilers are recognised.
+	/// The placeholders are computed once for all objects and up to @a _parallelism objects
+	/// are processed concurrently.
+	/// @returns the outcome for each of the objects.
+	static std::vector<HexLinkingResult> linkHex(
+		std::vector<std::string*> const& _hexObjects,
+		std::map<std::string, util::h160> const& _libraryAddresses,
+		size_t _parallelism = 1
+	);
+
 	/// @returns a hex representation of the bytecode of the given object, replacing unlinked
 	/// addresses by placeholders. This output is lowercase.
 	std::string toHex() const;
@@ -25,6 +25,9 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+#include <optional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -34,11 +37,40 @@ using namespace solidity::evmasm;
 namespace
 {
 
+/// Maximal number of items a rule of the table below looks at.
+size_t constexpr c_maxWindowSize = 5;
+using Window = array<AssemblyItem const*, c_maxWindowSize>;
+
+/// Input of the optimiser. Items that have been rewritten are put back in front of the
+/// remaining items of the assembly, so that rules can match their replacement.
 struct OptimiserState
 {
 	AssemblyItems const& items;
 	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
+	/// Items to be processed before items[i], the next one at the back.
+	AssemblyItems pending = {};
+
+	/// @returns the item at @a _offset from the current position or nullptr if there is none.
+	AssemblyItem const* at(size_t _offset) const
+	{
+		if (_offset < pending.size())
+			return &pending[pending.size() - 1 - _offset];
+		_offset -= pending.size();
+		return i + _offset < items.size() ? &items[i + _offset] : nullptr;
+	}
+	bool atEnd() const { return pending.empty() && i == items.size(); }
+	void consume(size_t _count)
+	{
+		size_t fromPending = std::min(_count, pending.size());
+		pending.erase(pending.end() - static_cast<ptrdiff_t>(fromPending), pending.end());
+		i += _count - fromPending;
+	}
+	/// Puts @a _items in front of the remaining items.
+	void putBack(AssemblyItems _items)
+	{
+		for (auto it = _items.rbegin(); it != _items.rend(); ++it)
+			pending.emplace_back(std::move(*it));
+	}
 };
 
 template <class Method, size_t Arguments>
@@ -46,62 +78,64 @@ struct ApplyRule
 {
 };
 template <class Method>
+struct ApplyRule<Method, 5>
+{
+	static bool applyRule(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		return Method::applySimple(*_in[0], *_in[1], *_in[2], *_in[3], *_in[4], _out);
+	}
+};
+template <class Method>
 struct ApplyRule<Method, 4>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		return Method::applySimple(_in[0], _in[1], _in[2], _in[3], _out);
+		return Method::applySimple(*_in[0], *_in[1], *_in[2], *_in[3], _out);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 3>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		return Method::applySimple(_in[0], _in[1], _in[2], _out);
+		return Method::applySimple(*_in[0], *_in[1], *_in[2], _out);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 2>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		return Method::applySimple(_in[0], _in[1], _out);
+		return Method::applySimple(*_in[0], *_in[1], _out);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 1>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		return Method::applySimple(_in[0], _out);
+		return Method::applySimple(*_in[0], _out);
 	}
 };
 
-template <class Method, size_t WindowSize>
-struct SimplePeepholeOptimizerMethod
+/// Entry of the rule table: A rule that looks at @a windowSize consecutive items and, if it
+/// matches, writes their replacement to the output and returns true.
+/// A rule has to reduce the number of items other than POP or, if it keeps it, the number of
+/// pushes, which guarantees that the optimiser terminates.
+struct PeepholeRule
 {
-	static bool apply(OptimiserState& _state)
-	{
-		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out)
-		)
-		{
-			_state.i += WindowSize;
-			return true;
-		}
-		else
-			return false;
-	}
+	size_t windowSize;
+	bool (*apply)(Window const& _in, std::back_insert_iterator<AssemblyItems> _out);
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
+template <class Method, size_t WindowSize>
+struct SimplePeepholeOptimizerMethod
 {
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
+	static_assert(WindowSize <= c_maxWindowSize, "");
+
+	static constexpr PeepholeRule rule()
 	{
-		*_out = _item;
-		return true;
+		return {WindowSize, &ApplyRule<Method, WindowSize>::applyRule};
 	}
 };
 
@@ -335,31 +369,31 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 };
 
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
+/// It looks at an arbitrary number of items and is thus not part of the rule table.
 struct UnreachableCode
 {
-	static bool apply(OptimiserState& _state)
+	static bool apply(OptimiserState& _state, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
-		auto end = _state.items.end();
-		if (it == end)
+		AssemblyItem const* item = _state.at(0);
+		if (!item)
 			return false;
 		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
+			*item != Instruction::JUMP &&
+			*item != Instruction::RETURN &&
+			*item != Instruction::STOP &&
+			*item != Instruction::INVALID &&
+			*item != Instruction::SELFDESTRUCT &&
+			*item != Instruction::REVERT
 		)
 			return false;
 
-		ptrdiff_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
+		size_t i = 1;
+		while (_state.at(i) && _state.at(i)->type() != Tag)
 			i++;
 		if (i > 1)
 		{
-			*_state.out = it[0];
-			_state.i += static_cast<size_t>(i);
+			*_out = *item;
+			_state.consume(i);
 			return true;
 		}
 		else
@@ -367,16 +401,59 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// Removes a swap followed by pops of all items it touched.
+template <unsigned N>
+bool swapAndPops(Window const& _in, std::back_insert_iterator<AssemblyItems> _out)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	static_assert(N + 2 <= c_maxWindowSize, "");
+	if (*_in[0] != swapInstruction(N))
+		return false;
+	for (size_t j = 1; j <= N + 1; j++)
+		if (*_in[j] != Instruction::POP)
+			return false;
+	for (size_t j = 1; j <= N + 1; j++)
+		*_out = *_in[j];
+	return true;
 }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+/// The rules, in the order in which they are tried at each position.
+PeepholeRule const c_rules[] = {
+	PushPop::rule(),
+	OpPop::rule(),
+	DoublePush::rule(),
+	DoubleSwap::rule(),
+	CommutativeSwap::rule(),
+	SwapComparison::rule(),
+	DupSwap::rule(),
+	IsZeroIsZeroJumpI::rule(),
+	JumpToNext::rule(),
+	TagConjunctions::rule(),
+	TruthyAnd::rule(),
+	{3, &swapAndPops<1>},
+	{4, &swapAndPops<2>},
+	{5, &swapAndPops<3>},
+};
+
+/// Tries the rules at the current position.
+/// @returns the replacement of the matched items if one applied.
+optional<AssemblyItems> applyRules(OptimiserState& _state)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	Window window{};
+	size_t available = 0;
+	for (; available < c_maxWindowSize; ++available)
+		if (!(window[available] = _state.at(available)))
+			break;
+
+	AssemblyItems replacement;
+	for (PeepholeRule const& rule: c_rules)
+		if (rule.windowSize <= available && rule.apply(window, back_inserter(replacement)))
+		{
+			_state.consume(rule.windowSize);
+			return replacement;
+		}
+	if (UnreachableCode::apply(_state, back_inserter(replacement)))
+		return replacement;
+	return nullopt;
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -388,14 +465,32 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+	// Single pass over the items: After a rewrite, the replacement and the items before it
+	// that a rule could match together with it are processed again. Since every rewrite
+	// removes an item other than POP or a push (see PeepholeRule), this takes time linear
+	// in the number of items. The bound below only guards against rules that violate this
+	// and would otherwise keep rewriting each other's replacements forever.
+	size_t const maxRewrites = 64000 + 2 * m_items.size();
+	size_t rewrites = 0;
+	m_optimisedItems.clear();
+	OptimiserState state{m_items, 0};
+	while (!state.atEnd())
+		if (optional<AssemblyItems> replacement = applyRules(state))
+		{
+			assertThrow(++rewrites < maxRewrites, OptimizerException, "Peephole optimizer seems to be stuck.");
+			state.putBack(move(*replacement));
+			for (size_t j = 1; j < c_maxWindowSize && !m_optimisedItems.empty(); ++j)
+			{
+				state.pending.emplace_back(move(m_optimisedItems.back()));
+				m_optimisedItems.pop_back();
+			}
+		}
+		else
+		{
+			m_optimisedItems.emplace_back(*state.at(0));
+			state.consume(1);
+		}
+
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
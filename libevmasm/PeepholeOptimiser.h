@@ -44,6 +44,8 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Applies all rules in a single pass over the items, also to the result of earlier rewrites.
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
@@ -28,9 +28,12 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/RuleList.h>
 #include <libsolutil/Assertions.h>
+#include <libsolutil/Profiler.h>
 
-#include <utility>
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <utility>
 
 using namespace std;
 using namespace solidity;
@@ -45,11 +48,28 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	uint8_t const instruction = uint8_t(_expr.item->instruction());
+	vector<unsigned> argumentKeys;
+	for (ExpressionClasses::Id argument: _expr.arguments)
+		argumentKeys.push_back(Pattern::itemKey(_classes.representative(argument).item));
+
+	for (size_t i = 0; i < m_rules[instruction].size(); ++i)
 	{
+		vector<optional<unsigned>> const& requiredKeys = m_argumentKeys[instruction][i];
+		bool candidate = true;
+		for (size_t j = 0; candidate && j < min(requiredKeys.size(), argumentKeys.size()); ++j)
+			candidate = !requiredKeys[j] || *requiredKeys[j] == argumentKeys[j];
+		if (!candidate)
+			continue;
+
+		auto const& rule = m_rules[instruction][i];
+		SOL_PERF_COUNTER("evmasm.Rules.findFirstMatch.attempts", 1);
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
+			{
+				SOL_PERF_COUNTER("evmasm.Rules.findFirstMatch.matches", 1);
 				return &rule;
+			}
 
 		resetMatchGroups();
 	}
@@ -69,7 +89,12 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	uint8_t const instruction = uint8_t(_rule.pattern.instruction());
+	m_rules[instruction].push_back(_rule);
+	vector<optional<unsigned>> argumentKeys;
+	for (Pattern const& argument: _rule.pattern.arguments())
+		argumentKeys.push_back(argument.baseItemKey());
+	m_argumentKeys[instruction].emplace_back(move(argumentKeys));
 }
 
 Rules::Rules()
@@ -103,8 +128,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, array<Expression const*, 8>& _matchGroups)
 {
+	assertThrow(0 < _group && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -115,7 +141,7 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
+		if (!(*m_matchGroups)[m_matchGroup])
 			(*m_matchGroups)[m_matchGroup] = &_expr;
 		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
 			return false;
@@ -170,6 +196,21 @@ string Pattern::toString() const
 	return s.str();
 }
 
+optional<unsigned> Pattern::baseItemKey() const
+{
+	if (m_type == UndefinedItem)
+		return nullopt;
+	return (unsigned(m_type) << 8) | (m_type == Operation ? unsigned(m_instruction) : 0u);
+}
+
+unsigned Pattern::itemKey(AssemblyItem const* _item)
+{
+	// Only matched by patterns without base item key.
+	if (!_item)
+		return numeric_limits<unsigned>::max();
+	return (unsigned(_item->type()) << 8) | (_item->type() == Operation ? unsigned(_item->instruction()) : 0u);
+}
+
 bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
 {
 	if (m_type == UndefinedItem)
@@ -29,7 +29,9 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <array>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace solidity::langutil
@@ -71,12 +73,16 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	/// Matched expressions indexed by the match group, which is between one and seven.
+	std::array<Expression const*, 8> m_matchGroups{};
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	/// For each rule in @a m_rules, the base item keys of the arguments of its pattern,
+	/// which allow to discard most rules without matching them.
+	std::vector<std::vector<std::optional<unsigned>>> m_argumentKeys[256];
 };
 
 /**
@@ -107,10 +113,16 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, std::array<Expression const*, 8>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
+	/// @returns a key such that this pattern can only match expressions whose item has the
+	/// same key (see @a itemKey), or nullopt if it matches expressions of any item.
+	std::optional<unsigned> baseItemKey() const;
+	/// @returns the key of @a _item, which might be null.
+	static unsigned itemKey(AssemblyItem const* _item);
+
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
@@ -139,7 +151,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	std::array<Expression const*, 8>* m_matchGroups = nullptr;
 };
 
 /**
@@ -53,6 +53,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -104,17 +107,28 @@ string CharStream::lineAtPosition(int _position) const
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_t searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	shared_ptr<vector<size_t> const> starts = lineStarts();
+	// The first line starts at 0, so the line containing the position is always found.
+	auto lineStart = prev(upper_bound(starts->begin(), starts->end(), searchPosition));
+	return tuple<int, int>(
+		static_cast<int>(lineStart - starts->begin()),
+		static_cast<int>(searchPosition - *lineStart)
+	);
+}
+
+shared_ptr<vector<size_t> const> CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> starts = atomic_load(&m_lineStarts);
+	if (!starts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		vector<size_t> positions{0};
+		for (size_t i = 0; i < m_source.size(); ++i)
+			if (m_source[i] == '\n')
+				positions.push_back(i + 1);
+		// Threads racing to build the index build identical ones, so any of them can be kept.
+		starts = make_shared<vector<size_t> const>(move(positions));
+		atomic_store(&m_lineStarts, starts);
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return starts;
 }
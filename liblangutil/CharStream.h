@@ -53,9 +53,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -95,6 +97,8 @@ public:
 	/// Functions that help pretty-printing parse errors
 	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const;
+	/// The positions where lines start are determined the first time this is called,
+	/// so that later calls only need a binary search.
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
@@ -113,9 +117,14 @@ public:
 	}
 
 private:
+	/// @returns the positions where the lines of the source start, in ascending order.
+	std::shared_ptr<std::vector<size_t> const> lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Index built by lineStarts(), which can be called from several threads.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
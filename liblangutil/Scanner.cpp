@@ -56,6 +56,7 @@
 
 #include <boost/algorithm/string/classification.hpp>
 
+#include <algorithm>
 #include <optional>
 #include <string_view>
 #include <tuple>
@@ -259,11 +260,17 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// The current character is not necessarily the one in the source
+	// (see skipMultiLineComment), so only look at the source after it.
+	if (!isWhiteSpace(m_char) || isSourcePastEndOfInput())
+		return false;
+
+	string const& source = m_source->source();
+	size_t position = sourcePos() + 1;
+	while (position < source.size() && isWhiteSpace(source[position]))
+		++position;
+	m_char = m_source->setPosition(position);
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -294,25 +301,34 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 		pair<string_view, int>{"\xE2\x80\xAC", -1} // U+202C (PDF - Pop Directional Formatting
 	};
 
-	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
+	size_t const endPosition = _stream.position();
+	// Sequences starting before the end position are also matched if they extend beyond it.
+	string_view const source = _stream.source();
+	string_view const region = source.substr(0, endPosition);
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All of the sequences start with the same byte, which is rare in source code,
+	// so only look at the positions of that byte.
+	for (
+		size_t currentPos = region.find('\xE2', _startPosition);
+		currentPos != string_view::npos;
+		currentPos = region.find('\xE2', currentPos + 1)
+	)
 	{
-		_stream.setPosition(currentPos);
-
 		for (auto const& [sequence, depthChange]: directionalSequences)
-			if (_stream.prefixMatch(sequence))
+			// Same as CharStream::prefixMatch, which does not match a sequence at the very end.
+			if (currentPos + sequence.size() < source.size() && source.substr(currentPos, sequence.size()) == sequence)
 				directionOverrideDepth += depthChange;
 
 		if (directionOverrideDepth < 0)
+		{
+			// Report the error at the position of the underflow.
+			_stream.setPosition(currentPos);
 			return ScannerError::DirectionalOverrideUnderflow;
+		}
 	}
 
-	_stream.setPosition(endPosition);
-
 	return directionOverrideDepth > 0 ? ScannerError::DirectionalOverrideMismatch : ScannerError::NoError;
 }
 
@@ -323,9 +339,17 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source->position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	string const& source = m_source->source();
+	while (!isUnicodeLinebreak() && !isSourcePastEndOfInput())
+	{
+		// Skip to the next character that can start a line break: the ASCII ones or the first byte
+		// of NEL, LS or PS.
+		auto const next = find_if(source.begin() + static_cast<ptrdiff_t>(sourcePos()) + 1, source.end(), [](char _c) {
+			uint8_t const c = static_cast<uint8_t>(_c);
+			return (0x0a <= c && c <= 0x0d) || c == 0xc2 || c == 0xe2;
+		});
+		m_char = m_source->setPosition(static_cast<size_t>(next - source.begin()));
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -403,26 +427,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source->position();
-	while (!isSourcePastEndOfInput())
+	size_t const endPosition = m_source->source().find("*/", startPosition);
+	if (endPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		m_char = m_source->setPosition(m_source->source().size());
+		// Unterminated multi-line comment.
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// If we have reached the end of the multi-line comment, we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_char = m_source->setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -1022,10 +1044,17 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Scan the rest of the identifier characters and add all of them at once.
+	string const& source = m_source->source();
+	size_t const startPosition = sourcePos();
+	size_t endPosition = startPosition + 1;
+	while (
+		endPosition < source.size() &&
+		(isIdentifierPart(source[endPosition]) || (source[endPosition] == '.' && m_kind == ScannerKind::Yul))
+	)
+		++endPosition;
+	m_tokens[NextNext].literal.append(source, startPosition, endPosition - startPosition);
+	m_char = m_source->setPosition(endPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -59,6 +59,9 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Limits the time of the following queries, see SolverInterface::setQueryTimeLimit.
+	virtual void setQueryTimeLimit(std::optional<unsigned> /*_milliseconds*/) {}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
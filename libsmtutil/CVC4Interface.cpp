@@ -19,7 +19,9 @@
 #include <libsmtutil/CVC4Interface.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/StringUtils.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -27,9 +29,10 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::smtutil;
 
-CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
+CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout, shared_ptr<QueryCache const> _queryCache):
 	SolverInterface(_queryTimeout),
-	m_solver(&m_context)
+	m_solver(&m_context),
+	m_queryCache(move(_queryCache))
 {
 	reset();
 }
@@ -37,6 +40,10 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_cvc4Exprs.clear();
+	m_declarations.clear();
+	m_assertions.clear();
+	m_assertionScopes.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -48,24 +55,36 @@ void CVC4Interface::reset()
 void CVC4Interface::push()
 {
 	m_solver.push();
+	m_assertionScopes.push_back(m_assertions.size());
 }
 
 void CVC4Interface::pop()
 {
 	m_solver.pop();
+	smtAssert(!m_assertionScopes.empty(), "");
+	m_assertions.resize(m_assertionScopes.back());
+	m_assertionScopes.pop_back();
 }
 
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	// Every declaration creates a fresh variable, which invalidates the memoised conversions.
+	if (m_variables.count(_name))
+		m_cvc4Exprs.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
+	if (m_queryCache)
+		m_declarations.emplace_back(_name + " " + toString(m_variables[_name].getType()));
 }
 
 void CVC4Interface::addAssertion(Expression const& _expr)
 {
 	try
 	{
-		m_solver.assertFormula(toCVC4Expr(_expr));
+		CVC4::Expr formula = toCVC4Expr(_expr);
+		m_solver.assertFormula(formula);
+		if (m_queryCache)
+			m_assertions.emplace_back(toString(formula));
 	}
 	catch (CVC4::TypeCheckingException const& _e)
 	{
@@ -87,6 +106,20 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	optional<string> query;
+	string identity;
+	if (m_queryCache)
+	{
+		query = joinHumanReadable(m_declarations, "\n") + "\n" + joinHumanReadable(m_assertions, "\n");
+		for (Expression const& e: _expressionsToEvaluate)
+			*query += "\nget-value " + toString(toCVC4Expr(e));
+		identity =
+			"cvc4 " + CVC4::Configuration::getVersionString() + " " +
+			(m_queryTimeout ? "timeout " + to_string(*m_queryTimeout) : "rlimit " + to_string(resourceLimit));
+		if (auto cached = m_queryCache->lookup(identity, *query))
+			return *cached;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -118,15 +151,42 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 		values.clear();
 	}
 
+	if (query)
+		m_queryCache->store(identity, *query, result, values);
+
 	return make_pair(result, values);
 }
 
+void CVC4Interface::setQueryTimeLimit(optional<unsigned> _milliseconds)
+{
+	// A time limit of 0 means no limit.
+	unsigned timeout = m_queryTimeout.value_or(0);
+	if (_milliseconds)
+	{
+		unsigned limit = max(*_milliseconds, 1u);
+		timeout = timeout > 0 ? min(timeout, limit) : limit;
+	}
+	m_solver.setTimeLimit(timeout);
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments.empty())
+	{
+		if (m_variables.count(_expr.name))
+			return m_variables.at(_expr.name);
+		return toCVC4ExprUncached(_expr);
+	}
+	if (auto const* cvc4Expr = m_cvc4Exprs.find(_expr))
+		return *cvc4Expr;
+	CVC4::Expr cvc4Expr = toCVC4ExprUncached(_expr);
+	m_cvc4Exprs.insert(_expr, cvc4Expr);
+	return cvc4Expr;
+}
 
+CVC4::Expr CVC4Interface::toCVC4ExprUncached(Expression const& _expr)
+{
 	vector<CVC4::Expr> arguments;
 	for (auto const& arg: _expr.arguments)
 		arguments.push_back(toCVC4Expr(arg));
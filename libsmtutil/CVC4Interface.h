@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 
 #if defined(__GLIBC__)
@@ -43,7 +44,10 @@ public:
 	CVC4Interface(CVC4Interface const&) = delete;
 	CVC4Interface& operator=(CVC4Interface const&) = delete;
 
-	CVC4Interface(std::optional<unsigned> _queryTimeout = {});
+	CVC4Interface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache const> _queryCache = {}
+	);
 
 	void reset() override;
 
@@ -54,15 +58,28 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_solver.interrupt(); }
+	void setQueryTimeLimit(std::optional<unsigned> _milliseconds) override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	CVC4::Expr toCVC4ExprUncached(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// The CVC4 terms of compound expressions converted since the last reset.
+	ExpressionMemo<CVC4::Expr> m_cvc4Exprs;
+
+	std::shared_ptr<QueryCache const> m_queryCache;
+	/// The declarations and assertions in the text format of CVC4, only recorded
+	/// if there is a query cache, since CVC4 does not print its assertions.
+	std::vector<std::string> m_declarations;
+	std::vector<std::string> m_assertions;
+	/// The size of m_assertions at every push.
+	std::vector<size_t> m_assertionScopes;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
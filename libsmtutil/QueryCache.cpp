@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+QueryCache::QueryCache(string _directory):
+	m_directory(move(_directory))
+{
+	boost::system::error_code error;
+	boost::filesystem::create_directories(m_directory, error);
+}
+
+optional<pair<CheckResult, vector<string>>> QueryCache::lookup(string const& _solver, string const& _query) const
+{
+	ifstream file(path(_solver, _query), ios::binary);
+	if (!file)
+		return nullopt;
+
+	// The file consists of the result followed by the number of values and every value
+	// prefixed by its length, since values can span several lines.
+	string result;
+	size_t count = 0;
+	if (!(file >> result >> count) || (result != "sat" && result != "unsat"))
+		return nullopt;
+
+	vector<string> values;
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t length = 0;
+		if (!(file >> length) || file.get() != ' ')
+			return nullopt;
+		string value(length, '\0');
+		if (!file.read(value.data(), static_cast<streamsize>(length)))
+			return nullopt;
+		values.emplace_back(move(value));
+	}
+
+	return {{result == "sat" ? CheckResult::SATISFIABLE : CheckResult::UNSATISFIABLE, move(values)}};
+}
+
+void QueryCache::store(
+	string const& _solver,
+	string const& _query,
+	CheckResult _result,
+	vector<string> const& _values
+) const
+{
+	if (_result != CheckResult::SATISFIABLE && _result != CheckResult::UNSATISFIABLE)
+		return;
+
+	ostringstream data;
+	data << (_result == CheckResult::SATISFIABLE ? "sat" : "unsat") << " " << _values.size() << "\n";
+	for (string const& value: _values)
+		data << value.size() << " " << value << "\n";
+
+	// Write to a temporary file first, so that concurrent readers never see partial results.
+	string target = path(_solver, _query);
+	boost::filesystem::path temporary = target + boost::filesystem::unique_path(".%%%%-%%%%-%%%%").string();
+	{
+		ofstream file(temporary.string(), ios::binary);
+		if (!(file << data.str()))
+			return;
+	}
+	boost::system::error_code error;
+	boost::filesystem::rename(temporary, target, error);
+	if (error)
+		boost::filesystem::remove(temporary, error);
+}
+
+string QueryCache::path(string const& _solver, string const& _query) const
+{
+	return (boost::filesystem::path(m_directory) / keccak256(_solver + "\n" + _query).hex()).string();
+}
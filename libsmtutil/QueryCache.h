@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Persistent cache of SMT query results on disk, which allows repeated runs of the
+ * SMTChecker to only solve the queries that changed.
+ * Every result is stored in a file of the cache directory that is named after the keccak256
+ * hash of the identity of the solver (including its version and resource limits) and the
+ * query in the solver's own text format.
+ * Only results that do not depend on the time available to the solver should be stored.
+ * Since there is no shared state besides the directory, a cache can be used concurrently.
+ */
+class QueryCache
+{
+public:
+	explicit QueryCache(std::string _directory);
+
+	/// @returns the result and values stored for @a _query of the solver @a _solver, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> lookup(
+		std::string const& _solver,
+		std::string const& _query
+	) const;
+
+	/// Stores @a _result and @a _values for @a _query of the solver @a _solver.
+	/// Failures to write the cache are ignored.
+	void store(
+		std::string const& _solver,
+		std::string const& _query,
+		CheckResult _result,
+		std::vector<std::string> const& _values
+	) const;
+
+private:
+	std::string path(std::string const& _solver, std::string const& _query) const;
+
+	std::string m_directory;
+};
+
+}
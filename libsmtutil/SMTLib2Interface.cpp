@@ -18,6 +18,7 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -57,6 +58,7 @@ void SMTLib2Interface::reset()
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
 	m_userSorts.clear();
+	m_sexprs.clear();
 	write("(set-option :produce-models true)");
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
@@ -116,10 +118,7 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = querySolver(checkInput(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -138,11 +137,59 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+void SMTLib2Interface::prefetch(vector<pair<Expression, vector<Expression>>> const& _queries)
+{
+	if (!m_smtCallback)
+		return;
+
+	vector<string> inputs;
+	for (auto const& [condition, expressionsToEvaluate]: _queries)
+	{
+		// Sorts declared by the query are declared again by the actual check,
+		// which has to produce the same input.
+		auto userSorts = m_userSorts;
+		push();
+		addAssertion(condition);
+		string input = checkInput(expressionsToEvaluate);
+		pop();
+		m_userSorts = move(userSorts);
+		if (!m_queryResponses.count(keccak256(input)) && !contains(inputs, input))
+			inputs.emplace_back(move(input));
+	}
+	if (inputs.size() < 2)
+		return;
+
+	Json::Value batch(Json::arrayValue);
+	for (string const& input: inputs)
+		batch.append(input);
+	auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQueryBatch), jsonCompactPrint(batch));
+	// Callbacks that do not support batches are asked for every query separately.
+	Json::Value responses;
+	if (
+		!result.success ||
+		!jsonParseStrict(result.responseOrErrorMessage, responses) ||
+		!responses.isArray() ||
+		responses.size() != inputs.size()
+	)
+		return;
+	for (Json::ArrayIndex i = 0; i < responses.size(); ++i)
+		if (responses[i].isString())
+			m_queryResponses[keccak256(inputs[i])] = responses[i].asString();
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
 	if (_expr.arguments.empty())
 		return _expr.name;
+	if (auto const* sexpr = m_sexprs.find(_expr))
+		return *sexpr;
+	string sexpr = toSExprUncached(_expr);
+	m_sexprs.insert(_expr, sexpr);
+	return sexpr;
+}
 
+string SMTLib2Interface::toSExprUncached(Expression const& _expr)
+{
 	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
@@ -267,6 +314,11 @@ void SMTLib2Interface::write(string _data)
 	m_accumulatedOutput.back() += move(_data) + "\n";
 }
 
+string SMTLib2Interface::checkInput(vector<Expression> const& _expressionsToEvaluate)
+{
+	return boost::algorithm::join(m_accumulatedOutput, "\n") + checkSatAndGetValuesCommand(_expressionsToEvaluate);
+}
+
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
 {
 	string command;
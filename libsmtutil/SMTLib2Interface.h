@@ -59,6 +59,14 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns true if queries that have no given response are sent to the SMT callback.
+	bool hasCallback() const { return bool(m_smtCallback); }
+	/// Sends the queries that check() would send after asserting the first element
+	/// of each of @a _queries in a new scope to the SMT callback in one batch.
+	/// The responses are used by the later checks of the same queries, which
+	/// then do not need a round-trip to the callback each.
+	void prefetch(std::vector<std::pair<Expression, std::vector<Expression>>> const& _queries);
+
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
 	std::string toSmtLibSort(Sort const& _sort);
@@ -73,6 +81,10 @@ private:
 
 	void write(std::string _data);
 
+	std::string toSExprUncached(Expression const& _expr);
+
+	/// @returns the input of the solver for a check of the current assertions.
+	std::string checkInput(std::vector<Expression> const& _expressionsToEvaluate);
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
@@ -88,6 +100,9 @@ private:
 	/// otherwise solvers cannot parse the queries.
 	std::vector<std::pair<std::string, std::string>> m_userSorts;
 
+	/// The s-expressions of compound expressions, which are shared by many queries.
+	ExpressionMemo<std::string> m_sexprs;
+
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
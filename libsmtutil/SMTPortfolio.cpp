@@ -26,6 +26,12 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,18 +42,21 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers,
+	[[maybe_unused]] shared_ptr<QueryCache const> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers)
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
-		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout, _queryCache));
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
-		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout, _queryCache));
 #endif
 }
 
@@ -55,6 +64,7 @@ void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
 }
 
 void SMTPortfolio::push()
@@ -74,6 +84,7 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
@@ -111,35 +122,136 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * When racing, the solvers that are interrupted because another solver answered first
+ * return UNKNOWN, so conflicts are only detected among the solvers that finished.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	if (m_raceSolvers && m_solvers.size() > 1)
+		return race(_assumptions, _expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
-		{
-			if (!solverAnswered(lastResult))
+		combineResults(lastResult, finalValues, checkSolver(i, _assumptions, _expressionsToEvaluate));
+		if (lastResult == CheckResult::CONFLICTING)
+			break;
+	}
+	return make_pair(lastResult, finalValues);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkSolver(
+	size_t _solver,
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	if (_assumptions.empty())
+		return m_solvers[_solver]->check(_expressionsToEvaluate);
+	return m_solvers[_solver]->checkAssuming(_assumptions, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::race(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	vector<exception_ptr> errors(m_solvers.size());
+	vector<bool> finished(m_solvers.size(), false);
+	size_t running = m_solvers.size();
+	bool answered = false;
+	mutex resultsMutex;
+	condition_variable finishedSolver;
+
+	vector<thread> threads;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		threads.emplace_back([&, i]() {
+			pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+			exception_ptr error;
+			try
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				result = checkSolver(i, _assumptions, _expressionsToEvaluate);
 			}
-			else if (lastResult != result)
+			catch (...)
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				error = current_exception();
 			}
+			lock_guard<mutex> lock(resultsMutex);
+			answered = answered || solverAnswered(result.first);
+			results[i] = move(result);
+			errors[i] = move(error);
+			finished[i] = true;
+			--running;
+			finishedSolver.notify_all();
+		});
+
+	{
+		unique_lock<mutex> lock(resultsMutex);
+		finishedSolver.wait(lock, [&]() { return running == 0 || answered; });
+		// A solver that is interrupted before it started its check does not notice,
+		// so the remaining solvers are interrupted until all of them stopped.
+		while (running > 0)
+		{
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (!finished[i])
+					m_solvers[i]->interrupt();
+			finishedSolver.wait_for(lock, chrono::milliseconds(10), [&]() { return running == 0; });
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
 	}
+	for (auto& solverThread: threads)
+		solverThread.join();
+
+	for (auto const& error: errors)
+		if (error)
+			rethrow_exception(error);
+
+	CheckResult lastResult = CheckResult::ERROR;
+	vector<string> finalValues;
+	for (auto& result: results)
+		combineResults(lastResult, finalValues, move(result));
 	return make_pair(lastResult, finalValues);
 }
 
+void SMTPortfolio::combineResults(
+	CheckResult& _result,
+	vector<string>& _values,
+	pair<CheckResult, vector<string>> _solverResult
+)
+{
+	auto&& [result, values] = _solverResult;
+	if (_result == CheckResult::CONFLICTING)
+		return;
+	if (solverAnswered(result))
+	{
+		if (!solverAnswered(_result))
+		{
+			_result = result;
+			_values = std::move(values);
+		}
+		else if (_result != result)
+			_result = CheckResult::CONFLICTING;
+	}
+	else if (result == CheckResult::UNKNOWN && _result == CheckResult::ERROR)
+		_result = result;
+}
+
+void SMTPortfolio::setQueryTimeLimit(optional<unsigned> _milliseconds)
+{
+	for (auto const& solver: m_solvers)
+		solver->setQueryTimeLimit(_milliseconds);
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -149,6 +261,20 @@ vector<string> SMTPortfolio::unhandledQueries()
 	return m_solvers.front()->unhandledQueries();
 }
 
+bool SMTPortfolio::batchesQueries() const
+{
+	smtAssert(!m_solvers.empty(), "");
+	auto const* smtlib2 = dynamic_cast<SMTLib2Interface const*>(m_solvers.front().get());
+	smtAssert(smtlib2, "");
+	return m_solvers.size() == 1 && smtlib2->hasCallback();
+}
+
+void SMTPortfolio::prefetch(vector<pair<Expression, vector<Expression>>> const& _queries)
+{
+	if (batchesQueries())
+		dynamic_cast<SMTLib2Interface&>(*m_solvers.front()).prefetch(_queries);
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
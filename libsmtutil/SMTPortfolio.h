@@ -19,6 +19,7 @@
 #pragma once
 
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
@@ -34,6 +35,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * If racing is enabled, the solvers are queried concurrently and the ones
+ * that are still running when the first solver answers are interrupted.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +49,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false,
+		std::shared_ptr<QueryCache const> _queryCache = {}
 	);
 
 	void reset() override;
@@ -59,15 +64,53 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+
+	void setQueryTimeLimit(std::optional<unsigned> _milliseconds) override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// @returns true if the only solver is the SMT-LIB2 interface and it
+	/// queries through the SMT callback, which then answers batches of queries.
+	bool batchesQueries() const;
+	/// Sends the queries of checking each of @a _queries' conditions in a new scope to the
+	/// SMT callback in one batch, see SMTLib2Interface::prefetch.
+	void prefetch(std::vector<std::pair<Expression, std::vector<Expression>>> const& _queries);
+
+	/// @returns the variables declared since the last reset, in the order of their declaration.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 private:
 	static bool solverAnswered(CheckResult result);
+	/// Combines the result of a solver with the results of the solvers queried
+	/// before it, see check().
+	static void combineResults(
+		CheckResult& _result,
+		std::vector<std::string>& _values,
+		std::pair<CheckResult, std::vector<std::string>> _solverResult
+	);
+
+	/// Queries all solvers concurrently until one of them answers and interrupts the others.
+	std::pair<CheckResult, std::vector<std::string>> race(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
+	/// Queries solver @a _solver, under @a _assumptions if there are any.
+	std::pair<CheckResult, std::vector<std::string>> checkSolver(
+		size_t _solver,
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
 
 	std::vector<Expression> m_assertions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+
+	bool m_raceSolvers = false;
 };
 
 }
@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// Sort comparison that also takes the parameters of integer and bit-vector sorts into account,
+/// which the virtual comparison of Sort does not see.
+bool sameSort(SortPointer const& _a, SortPointer const& _b)
+{
+	if (_a == _b)
+		return true;
+	if (!_a || !_b || _a->kind != _b->kind)
+		return false;
+	if (_a->kind == Kind::Int)
+		return dynamic_cast<IntSort const&>(*_a).isSigned == dynamic_cast<IntSort const&>(*_b).isSigned;
+	if (_a->kind == Kind::BitVector)
+		return dynamic_cast<BitVectorSort const&>(*_a).size == dynamic_cast<BitVectorSort const&>(*_b).size;
+	return *_a == *_b;
+}
+
+size_t hashArguments(vector<Expression> const& _arguments)
+{
+	size_t hash = _arguments.size();
+	for (Expression const& argument: _arguments)
+	{
+		boost::hash_combine(hash, argument.name);
+		boost::hash_combine(hash, argument.arguments.id());
+		boost::hash_combine(hash, argument.sort ? static_cast<int>(argument.sort->kind) : -1);
+	}
+	return hash;
+}
+
+bool sameArguments(vector<Expression> const& _a, vector<Expression> const& _b)
+{
+	if (_a.size() != _b.size())
+		return false;
+	for (size_t i = 0; i < _a.size(); ++i)
+		if (!_a[i].sameTerm(_b[i]))
+			return false;
+	return true;
+}
+
+/// The table of all live argument lists, indexed by their hash.
+/// Entries are removed by the deleter of the list.
+struct ArgumentTable
+{
+	mutex lock;
+	unordered_multimap<size_t, pair<vector<Expression> const*, weak_ptr<vector<Expression> const>>> entries;
+};
+
+ArgumentTable& argumentTable()
+{
+	// Never destroyed, since expressions with static storage duration may outlive it otherwise.
+	static ArgumentTable* table = new ArgumentTable();
+	return *table;
+}
+
+}
+
+ExpressionArguments::ExpressionArguments(vector<Expression> _arguments)
+{
+	if (_arguments.empty())
+		return;
+
+	size_t hash = hashArguments(_arguments);
+	ArgumentTable& table = argumentTable();
+
+	// Candidates are released only after the table is unlocked,
+	// since releasing the last reference removes an entry.
+	vector<shared_ptr<vector<Expression> const>> candidates;
+	lock_guard<mutex> guard(table.lock);
+	auto [begin, end] = table.entries.equal_range(hash);
+	for (auto it = begin; it != end; ++it)
+		if (auto candidate = it->second.second.lock())
+		{
+			candidates.emplace_back(candidate);
+			if (sameArguments(*candidate, _arguments))
+			{
+				m_arguments = move(candidate);
+				return;
+			}
+		}
+
+	auto* arguments = new vector<Expression>(move(_arguments));
+	m_arguments = shared_ptr<vector<Expression> const>(arguments, [hash](vector<Expression> const* _list) {
+		{
+			ArgumentTable& table = argumentTable();
+			lock_guard<mutex> guard(table.lock);
+			auto [begin, end] = table.entries.equal_range(hash);
+			for (auto it = begin; it != end; ++it)
+				if (it->second.first == _list)
+				{
+					table.entries.erase(it);
+					break;
+				}
+		}
+		// Deleting the list releases its arguments, which may remove further entries.
+		delete _list;
+	});
+	table.entries.emplace(hash, make_pair(arguments, weak_ptr<vector<Expression> const>(m_arguments)));
+}
+
+size_t Expression::termSize() const
+{
+	set<void const*> visited;
+	vector<Expression const*> toVisit{this};
+	while (!toVisit.empty())
+	{
+		Expression const* expr = toVisit.back();
+		toVisit.pop_back();
+		if (!expr->arguments.empty() && visited.insert(expr->arguments.id()).second)
+			for (Expression const& argument: expr->arguments)
+				toVisit.push_back(&argument);
+	}
+	return visited.size();
+}
+
+bool Expression::sameTerm(Expression const& _other) const
+{
+	return name == _other.name && arguments.id() == _other.arguments.id() && sameSort(sort, _other.sort);
+}
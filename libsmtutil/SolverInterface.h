@@ -53,6 +53,38 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+class Expression;
+
+/// The immutable argument list of an expression.
+/// Argument lists are hash-consed: structurally equal lists are the same node, which
+/// is shared by all expressions that refer to it. Copying an expression therefore does
+/// not copy its subterms, and the solver interfaces can memoise conversions per node.
+class ExpressionArguments
+{
+public:
+	ExpressionArguments() = default;
+	ExpressionArguments(std::vector<Expression> _arguments);
+
+	operator std::vector<Expression> const&() const { return get(); }
+	std::vector<Expression> const& get() const;
+
+	bool empty() const { return !m_arguments; }
+	size_t size() const;
+	Expression const& operator[](size_t _index) const;
+	Expression const& at(size_t _index) const;
+	Expression const& front() const;
+	Expression const& back() const;
+	std::vector<Expression>::const_iterator begin() const;
+	std::vector<Expression>::const_iterator end() const;
+
+	/// @returns an identifier of the argument list that is equal for
+	/// structurally equal lists, or nullptr for the empty list.
+	void const* id() const { return m_arguments.get(); }
+
+private:
+	std::shared_ptr<std::vector<Expression> const> m_arguments;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -365,8 +397,15 @@ public:
 		return Expression(name, std::move(_arguments), fSort->codomain);
 	}
 
+	/// @returns true if this and @a _other are the same term, which for hash-consed
+	/// arguments only needs to compare the top node.
+	bool sameTerm(Expression const& _other) const;
+	/// @returns the number of distinct compound subterms of the expression,
+	/// which estimates how hard it is to solve.
+	size_t termSize() const;
+
 	std::string name;
-	std::vector<Expression> arguments;
+	ExpressionArguments arguments;
 	SortPointer sort;
 
 private:
@@ -382,6 +421,44 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
 };
 
+inline std::vector<Expression> const& ExpressionArguments::get() const
+{
+	static std::vector<Expression> const noArguments;
+	return m_arguments ? *m_arguments : noArguments;
+}
+inline size_t ExpressionArguments::size() const { return get().size(); }
+inline Expression const& ExpressionArguments::operator[](size_t _index) const { return get()[_index]; }
+inline Expression const& ExpressionArguments::at(size_t _index) const { return get().at(_index); }
+inline Expression const& ExpressionArguments::front() const { return get().front(); }
+inline Expression const& ExpressionArguments::back() const { return get().back(); }
+inline std::vector<Expression>::const_iterator ExpressionArguments::begin() const { return get().begin(); }
+inline std::vector<Expression>::const_iterator ExpressionArguments::end() const { return get().end(); }
+
+/// Memoised results of converting compound expressions, keyed by their top node.
+/// Keeps the converted expressions alive, so that their nodes are not reused.
+template <class T>
+class ExpressionMemo
+{
+public:
+	T const* find(Expression const& _expr) const
+	{
+		auto it = m_entries.find({_expr.arguments.id(), _expr.name});
+		if (it != m_entries.end())
+			for (auto const& [expr, value]: it->second)
+				if (expr.sameTerm(_expr))
+					return &value;
+		return nullptr;
+	}
+	void insert(Expression const& _expr, T _value)
+	{
+		m_entries[{_expr.arguments.id(), _expr.name}].emplace_back(_expr, std::move(_value));
+	}
+	void clear() { m_entries.clear(); }
+
+private:
+	std::map<std::pair<void const*, std::string>, std::vector<std::pair<Expression, T>>> m_entries;
+};
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -411,6 +488,29 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Checks for satisfiability under the additional assumptions @a _assumptions, which
+	/// are not kept afterwards. Solvers that support this natively keep what they learned
+	/// from the query, by default the assumptions are asserted in a new scope.
+	virtual std::pair<CheckResult, std::vector<std::string>>
+	checkAssuming(std::vector<Expression> const& _assumptions, std::vector<Expression> const& _expressionsToEvaluate)
+	{
+		push();
+		for (auto const& assumption: _assumptions)
+			addAssertion(assumption);
+		auto result = check(_expressionsToEvaluate);
+		pop();
+		return result;
+	}
+
+	/// Asks a running call to check() to stop as soon as possible and to answer UNKNOWN.
+	/// Can be called from another thread. Does nothing by default.
+	virtual void interrupt() {}
+
+	/// Limits the time of the following queries to @a _milliseconds in addition to the
+	/// timeout or resource limit given at construction, or removes that limit if it is
+	/// not given. Does nothing by default.
+	virtual void setQueryTimeLimit(std::optional<unsigned> /*_milliseconds*/) {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
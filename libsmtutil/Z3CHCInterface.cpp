@@ -27,11 +27,16 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
+Z3CHCInterface::Z3CHCInterface(
+	optional<unsigned> _queryTimeout,
+	shared_ptr<QueryCache const> _queryCache,
+	shared_ptr<Z3Context> _context
+):
 	CHCSolverInterface(_queryTimeout),
-	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
+	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout, nullptr, move(_context))),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_queryCache(move(_queryCache))
 {
 	Z3_get_version(
 		&get<0>(m_version),
@@ -60,10 +65,12 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_history.push_back({m_z3Interface->declarations().size(), _expr, nullopt});
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	m_history.push_back({m_z3Interface->declarations().size(), _expr, _name});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -79,6 +86,17 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 
 pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
+	optional<string> query;
+	string identity = "spacer " + m_z3Interface->identity();
+	if (m_queryCache)
+	{
+		z3::expr_vector queries(*m_context);
+		queries.push_back(m_z3Interface->toZ3Expr(_expr));
+		query = m_solver.to_string(queries);
+		if (m_queryCache->lookup(identity, *query))
+			return {CheckResult::UNSATISFIABLE, {}};
+	}
+
 	CheckResult result;
 	try
 	{
@@ -90,7 +108,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 			result = CheckResult::SATISFIABLE;
 			// z3 version 4.8.8 modified Spacer to also return
 			// proofs containing nonlinear clauses.
-			if (m_version >= tuple(4, 8, 8, 0))
+			if (m_counterexamples && m_version >= tuple(4, 8, 8, 0))
 			{
 				auto proof = m_solver.get_answer();
 				return {result, cexGraph(proof)};
@@ -100,6 +118,8 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 		case z3::check_result::unsat:
 		{
 			result = CheckResult::UNSATISFIABLE;
+			if (query)
+				m_queryCache->store(identity, *query, result, {});
 			// TODO retrieve invariants.
 			break;
 		}
@@ -128,6 +148,22 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 	return {result, {}};
 }
 
+void Z3CHCInterface::replay(Z3CHCInterface const& _other, size_t _begin, size_t _end)
+{
+	smtAssert(_begin <= _end && _end <= _other.m_history.size(), "");
+	auto const& declarations = _other.m_z3Interface->declarations();
+	for (size_t i = _begin; i < _end; ++i)
+	{
+		HistoryEntry const& entry = _other.m_history[i];
+		for (size_t j = m_z3Interface->declarations().size(); j < entry.declarations; ++j)
+			declareVariable(declarations[j].first, declarations[j].second);
+		if (entry.ruleName)
+			addRule(entry.expression, *entry.ruleName);
+		else
+			registerRelation(entry.expression);
+	}
+}
+
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 {
 	// Spacer options.
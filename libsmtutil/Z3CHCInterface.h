@@ -25,6 +25,7 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -34,7 +35,14 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	/// Only unsatisfiable queries are stored in @a _queryCache, since the counterexamples
+	/// of satisfiable queries are not cached.
+	/// Uses @a _context if given, and a new context otherwise.
+	Z3CHCInterface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache const> _queryCache = {},
+		std::shared_ptr<Z3Context> _context = {}
+	);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -45,10 +53,25 @@ public:
 
 	std::pair<CheckResult, CexGraph> query(Expression const& _expr) override;
 
+	/// Forwards the limit to Z3Interface, whose context is shared.
+	void setQueryTimeLimit(std::optional<unsigned> _milliseconds) override { m_z3Interface->setQueryTimeLimit(_milliseconds); }
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// Enables or disables extracting the counterexample graph of satisfiable queries.
+	void enableCounterexamples(bool _enable) { m_counterexamples = _enable; }
+	bool counterexamples() const { return m_counterexamples; }
+
+	/// @returns the number of relations and rules added so far.
+	size_t historySize() const { return m_history.size(); }
+	/// Adds the relations and rules of @a _other with index in [_begin, _end) to this interface,
+	/// together with the variables @a _other declared before them, in their original order.
+	/// Allows to query the rules of @a _other concurrently in another Z3 context, provided
+	/// nothing but replay() declares variables in this interface.
+	void replay(Z3CHCInterface const& _other, size_t _begin, size_t _end);
+
 private:
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
@@ -67,6 +90,19 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	/// A relation or rule (if it has a name) and the number of variables declared before it.
+	struct HistoryEntry
+	{
+		size_t declarations;
+		Expression expression;
+		std::optional<std::string> ruleName;
+	};
+	std::vector<HistoryEntry> m_history;
+
+	std::shared_ptr<QueryCache const> m_queryCache;
+
+	bool m_counterexamples = true;
 };
 
 }
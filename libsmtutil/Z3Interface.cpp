@@ -29,6 +29,42 @@ using namespace std;
 using namespace solidity::smtutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns a string that identifies the structure of @a _sort.
+string sortKey(Sort const& _sort)
+{
+	switch (_sort.kind)
+	{
+	case Kind::Bool:
+		return "B";
+	case Kind::Int:
+		return "I";
+	case Kind::BitVector:
+		return "V" + to_string(dynamic_cast<BitVectorSort const&>(_sort).size);
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		return "A(" + sortKey(*arraySort.domain) + "," + sortKey(*arraySort.range) + ")";
+	}
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		string key = "T(" + tupleSort.name;
+		for (size_t i = 0; i < tupleSort.members.size(); ++i)
+			key += "," + tupleSort.members.at(i) + ":" + sortKey(*tupleSort.components.at(i));
+		return key + ")";
+	}
+	default:
+		break;
+	}
+	smtAssert(false, "");
+	return {};
+}
+
+}
+
 bool Z3Interface::available()
 {
 #ifdef HAVE_Z3_DLOPEN
@@ -38,9 +74,16 @@ bool Z3Interface::available()
 #endif
 }
 
-Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
+Z3Interface::Z3Interface(
+	std::optional<unsigned> _queryTimeout,
+	std::shared_ptr<QueryCache const> _queryCache,
+	std::shared_ptr<Z3Context> _context
+):
 	SolverInterface(_queryTimeout),
-	m_solver(m_context)
+	m_sharedContext(_context ? move(_context) : make_shared<Z3Context>()),
+	m_context(m_sharedContext->context),
+	m_solver(m_context),
+	m_queryCache(move(_queryCache))
 {
 	// These need to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
@@ -55,6 +98,8 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_declarations.clear();
+	m_z3Exprs.clear();
 	m_solver.reset();
 }
 
@@ -74,9 +119,16 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+	{
+		z3::expr constant = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		// Redeclaring with another sort invalidates the memoised conversions that refer to the name.
+		if (!z3::eq(m_constants.at(_name), constant))
+			m_z3Exprs.clear();
+		m_constants.at(_name) = constant;
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
@@ -84,7 +136,12 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
-		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	{
+		z3::func_decl function = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		if (!z3::eq(m_functions.at(_name), function))
+			m_z3Exprs.clear();
+		m_functions.at(_name) = function;
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -94,13 +151,68 @@ void Z3Interface::addAssertion(Expression const& _expr)
 	m_solver.add(toZ3Expr(_expr));
 }
 
+void Z3Interface::setQueryTimeLimit(optional<unsigned> _milliseconds)
+{
+	// A timeout of 0 means no limit.
+	optional<unsigned> timeout;
+	if (m_queryTimeout && *m_queryTimeout > 0)
+		timeout = m_queryTimeout;
+	if (_milliseconds)
+	{
+		unsigned limit = max(*_milliseconds, 1u);
+		timeout = timeout ? min(*timeout, limit) : limit;
+	}
+
+	if (timeout)
+		m_context.set("timeout", int(*timeout));
+	else if (m_queryTimeout)
+		m_context.set("timeout", 0);
+	else
+		m_context.set("timeout", to_string(numeric_limits<unsigned>::max()).c_str());
+}
+
+string Z3Interface::identity() const
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	string limit = m_queryTimeout ? "timeout " + to_string(*m_queryTimeout) : "rlimit " + to_string(resourceLimit);
+	return "z3 " + to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision) + " " + limit;
+}
+
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> Z3Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	z3::expr_vector assumptions(m_context);
+	for (Expression const& assumption: _assumptions)
+		assumptions.push_back(toZ3Expr(assumption));
+
+	optional<string> query;
+	if (m_queryCache)
+	{
+		query = m_solver.to_smt2();
+		if (!assumptions.empty())
+			*query += "\n(check-sat-assuming " + util::toString(assumptions) + ")";
+		for (Expression const& e: _expressionsToEvaluate)
+			*query += "\n(get-value (" + toZ3Expr(e).to_string() + "))";
+		if (auto cached = m_queryCache->lookup(identity(), *query))
+			return *cached;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		switch (m_solver.check(assumptions))
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -136,13 +248,29 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 		values.clear();
 	}
 
+	if (query)
+		m_queryCache->store(identity(), *query, result, values);
+
 	return make_pair(result, values);
 }
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments.empty())
+	{
+		if (m_constants.count(_expr.name))
+			return m_constants.at(_expr.name);
+		return toZ3ExprUncached(_expr);
+	}
+	if (auto const* z3Expr = m_z3Exprs.find(_expr))
+		return *z3Expr;
+	z3::expr z3Expr = toZ3ExprUncached(_expr);
+	m_z3Exprs.insert(_expr, z3Expr);
+	return z3Expr;
+}
+
+z3::expr Z3Interface::toZ3ExprUncached(Expression const& _expr)
+{
 	z3::expr_vector arguments(m_context);
 	for (auto const& arg: _expr.arguments)
 		arguments.push_back(toZ3Expr(arg));
@@ -350,6 +478,19 @@ Expression Z3Interface::fromZ3Expr(z3::expr const& _expr)
 }
 
 z3::sort Z3Interface::z3Sort(Sort const& _sort)
+{
+	if (_sort.kind != Kind::Array && _sort.kind != Kind::Tuple)
+		return z3SortUncached(_sort);
+
+	string key = sortKey(_sort);
+	if (auto it = m_sharedContext->sorts.find(key); it != m_sharedContext->sorts.end())
+		return it->second;
+	z3::sort sort = z3SortUncached(_sort);
+	m_sharedContext->sorts.emplace(move(key), sort);
+	return sort;
+}
+
+z3::sort Z3Interface::z3SortUncached(Sort const& _sort)
 {
 	switch (_sort.kind)
 	{
@@ -18,12 +18,29 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <map>
+#include <memory>
+
 namespace solidity::smtutil
 {
 
+/**
+ * A Z3 context together with the compound sorts declared in it.
+ * Can be shared by the solver interfaces that are used one after the other,
+ * so that the sorts, in particular the large tuple sorts of the blockchain state,
+ * are declared only once. Not thread-safe.
+ */
+struct Z3Context
+{
+	z3::context context;
+	/// The Z3 sorts of tuple and array sorts, keyed by their structure.
+	std::map<std::string, z3::sort> sorts;
+};
+
 class Z3Interface: public SolverInterface
 {
 public:
@@ -31,7 +48,11 @@ public:
 	Z3Interface(Z3Interface const&) = delete;
 	Z3Interface& operator=(Z3Interface const&) = delete;
 
-	Z3Interface(std::optional<unsigned> _queryTimeout = {});
+	Z3Interface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache const> _queryCache = {},
+		std::shared_ptr<Z3Context> _context = {}
+	);
 
 	static bool available();
 
@@ -44,15 +65,27 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+	void interrupt() override { m_context.interrupt(); }
+	void setQueryTimeLimit(std::optional<unsigned> _milliseconds) override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
 	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	/// @returns the variables declared since the last reset, in the order of their declaration.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the name and version of Z3 together with the limits of its queries,
+	/// which is the part of the key of cached queries that does not depend on the query.
+	std::string identity() const;
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -60,16 +93,26 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	z3::expr toZ3ExprUncached(Expression const& _expr);
+
 	z3::sort z3Sort(Sort const& _sort);
+	z3::sort z3SortUncached(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
 	std::vector<smtutil::SortPointer> fromZ3Sort(z3::sort_vector const& _sorts);
 
-	z3::context m_context;
+	/// Kept alive by every interface using the context, since the Z3 terms refer to it.
+	std::shared_ptr<Z3Context> m_sharedContext;
+	z3::context& m_context;
 	z3::solver m_solver;
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+	/// The Z3 terms of compound expressions converted since the last reset.
+	ExpressionMemo<z3::expr> m_z3Exprs;
+
+	std::shared_ptr<QueryCache const> m_queryCache;
 };
 
 }
@@ -24,11 +24,20 @@
 #include <libsolc/libsolc.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
+#include <libevmasm/LinkerObject.h>
 #include <libyul/YulString.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/JSON.h>
 
+#include <array>
 #include <cstdlib>
 #include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <vector>
 
 #include "license.h"
 
@@ -42,9 +51,57 @@ using solidity::frontend::StandardCompiler;
 namespace
 {
 
+/// Number of distinct Yul identifiers kept between the compilations of a compiler created by
+/// solidity_create() before they are cleared.
+size_t constexpr c_yulStringRepositoryLimit = 1000000;
+
+}
+
+/// Compiler created by solidity_create().
+struct SolidityCompiler
+{
+	explicit SolidityCompiler(ReadCallback::Callback _readCallback):
+		compiler(move(_readCallback))
+	{
+		compiler.setYulStringRepositoryLimit(c_yulStringRepositoryLimit);
+		compiler.setIncrementalAnalysis(true);
+	}
+
+	StandardCompiler compiler;
+};
+
+namespace
+{
+
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+/// Protects solidityAllocations, so that several threads can compile at the same time.
+static mutex solidityAllocationsMutex;
+
+/// Serializes all compilations. The types and Yul identifiers are shared by all of them
+/// and only one CompilerStack can exist at a time.
+static mutex compilationMutex;
+/// The compiler that kept the analysed sources of its last compilation, if any.
+/// Guarded by compilationMutex.
+static SolidityCompiler* compilerKeepingSources = nullptr;
+
+/// Makes the compiler that kept its analysed sources drop them, so that another compilation can
+/// run or the Yul identifiers can be cleared. Has to be called with compilationMutex locked.
+void dropKeptSources()
+{
+	if (!compilerKeepingSources)
+		return;
+	compilerKeepingSources->compiler.setIncrementalAnalysis(false);
+	compilerKeepingSources->compiler.setIncrementalAnalysis(true);
+	compilerKeepingSources = nullptr;
+}
+
+string* addAllocation(string _data)
+{
+	lock_guard<mutex> lock(solidityAllocationsMutex);
+	return &solidityAllocations.emplace_back(move(_data));
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -53,6 +110,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -106,12 +164,187 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 	return readCallback;
 }
 
+/// Stream buffer that passes the data written to it to a CStyleWriteCallback in chunks.
+class WriteCallbackBuffer: public streambuf
+{
+public:
+	WriteCallbackBuffer(CStyleWriteCallback _writeCallback, void* _writeContext):
+		m_writeCallback(_writeCallback),
+		m_writeContext(_writeContext)
+	{
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+	}
+
+protected:
+	int_type overflow(int_type _character) override
+	{
+		sync();
+		if (!traits_type::eq_int_type(_character, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(_character);
+			pbump(1);
+		}
+		return traits_type::not_eof(_character);
+	}
+
+	int sync() override
+	{
+		if (pptr() > pbase())
+			m_writeCallback(m_writeContext, pbase(), static_cast<size_t>(pptr() - pbase()));
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+		return 0;
+	}
+
+private:
+	CStyleWriteCallback m_writeCallback;
+	void* m_writeContext;
+	array<char, 64 * 1024> m_buffer;
+};
+
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
+	lock_guard<mutex> lock(compilationMutex);
+	dropKeptSources();
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
 	return compiler.compile(move(_input));
 }
 
+void compile(string const& _input, CStyleReadFileCallback _readCallback, void* _readContext, ostream& _output)
+{
+	lock_guard<mutex> lock(compilationMutex);
+	dropKeptSources();
+	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.compile(_input, _output);
+}
+
+string compileWith(SolidityCompiler& _compiler, string _input)
+{
+	lock_guard<mutex> lock(compilationMutex);
+	if (compilerKeepingSources != &_compiler)
+		dropKeptSources();
+	string output = _compiler.compiler.compile(move(_input));
+	compilerKeepingSources = &_compiler;
+	return output;
+}
+
+void compileWith(SolidityCompiler& _compiler, string const& _input, ostream& _output)
+{
+	lock_guard<mutex> lock(compilationMutex);
+	if (compilerKeepingSources != &_compiler)
+		dropKeptSources();
+	_compiler.compiler.compile(_input, _output);
+	compilerKeepingSources = &_compiler;
+}
+
+Json::Value linkerError(string const& _type, string const& _message)
+{
+	Json::Value error{Json::objectValue};
+	error["component"] = "general";
+	error["formattedMessage"] = _type + ": " + _message;
+	error["message"] = _message;
+	error["severity"] = "error";
+	error["type"] = _type;
+	return error;
+}
+
+Json::Value linkerErrorOutput(string const& _type, string const& _message)
+{
+	Json::Value output{Json::objectValue};
+	output["errors"] = Json::arrayValue;
+	output["errors"].append(linkerError(_type, _message));
+	return output;
+}
+
+Json::Value linkJson(Json::Value const& _input)
+{
+	if (!_input.isObject())
+		return linkerErrorOutput("JSONError", "Input is not a JSON object.");
+	if (!_input["bytecodes"].isObject())
+		return linkerErrorOutput("JSONError", "\"bytecodes\" must be an object.");
+	if (_input.isMember("libraries") && !_input["libraries"].isObject())
+		return linkerErrorOutput("JSONError", "\"libraries\" must be an object.");
+	if (_input.isMember("parallelism") && (!_input["parallelism"].isUInt() || _input["parallelism"].asUInt() == 0))
+		return linkerErrorOutput("JSONError", "\"parallelism\" must be a positive integer.");
+
+	map<string, h160> libraries;
+	for (string const& name: _input["libraries"].getMemberNames())
+	{
+		Json::Value const& address = _input["libraries"][name];
+		if (
+			!address.isString() ||
+			address.asString().substr(0, 2) != "0x" ||
+			address.asString().size() != 42 ||
+			!isValidHex(address.asString())
+		)
+			return linkerErrorOutput("JSONError", "Invalid address for library \"" + name + "\".");
+		libraries[name] = h160(address.asString());
+	}
+
+	vector<string> names = _input["bytecodes"].getMemberNames();
+	vector<string> bytecodes;
+	for (string const& name: names)
+	{
+		if (!_input["bytecodes"][name].isString())
+			return linkerErrorOutput("JSONError", "The bytecode of \"" + name + "\" must be a string.");
+		bytecodes.emplace_back(_input["bytecodes"][name].asString());
+	}
+
+	vector<string*> objects;
+	for (string& bytecode: bytecodes)
+		objects.push_back(&bytecode);
+	vector<evmasm::LinkerObject::HexLinkingResult> results = evmasm::LinkerObject::linkHex(
+		objects,
+		libraries,
+		_input.isMember("parallelism") ? _input["parallelism"].asUInt() : 1
+	);
+
+	Json::Value output{Json::objectValue};
+	output["bytecodes"] = Json::objectValue;
+	for (size_t i = 0; i < names.size(); ++i)
+	{
+		if (results[i].invalidReference)
+		{
+			if (!output.isMember("errors"))
+				output["errors"] = Json::arrayValue;
+			output["errors"].append(linkerError(
+				"LinkerError",
+				"Invalid link reference in \"" + names[i] + "\" at position " + to_string(*results[i].invalidReference) + "."
+			));
+			continue;
+		}
+		output["bytecodes"][names[i]] = bytecodes[i];
+		if (!results[i].unresolvedReferences.empty())
+		{
+			if (!output.isMember("unresolvedReferences"))
+				output["unresolvedReferences"] = Json::objectValue;
+			Json::Value& unresolved = output["unresolvedReferences"][names[i]];
+			unresolved = Json::objectValue;
+			for (auto const& [position, placeholder]: results[i].unresolvedReferences)
+				unresolved[to_string(position)] = placeholder;
+		}
+	}
+	return output;
+}
+
+string link(string const& _input)
+{
+	Json::Value output;
+	try
+	{
+		Json::Value input;
+		string errors;
+		if (!jsonParseStrict(_input, input, &errors))
+			output = linkerErrorOutput("JSONError", errors);
+		else
+			output = linkJson(input);
+	}
+	catch (...)
+	{
+		output = linkerErrorOutput("InternalCompilerError", "Internal exception in the linker.");
+	}
+	return jsonCompactPrint(output);
+}
+
 }
 
 extern "C"
@@ -129,14 +362,71 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return addAllocation(compile(_input, _readCallback, _readContext))->data();
+}
+
+extern void solidity_compile_streaming(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleWriteCallback _writeCallback,
+	void* _writeContext
+) noexcept
+{
+	WriteCallbackBuffer buffer(_writeCallback, _writeContext);
+	ostream output(&buffer);
+	compile(_input, _readCallback, _readContext, output);
+	output.flush();
+}
+
+extern SolidityCompiler* solidity_create(CStyleReadFileCallback _readCallback, void* _readContext) noexcept
+{
+	try
+	{
+		return new SolidityCompiler(wrapReadCallback(_readCallback, _readContext));
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern char* solidity_compile_with(SolidityCompiler* _compiler, char const* _input) noexcept
+{
+	return addAllocation(compileWith(*_compiler, _input))->data();
+}
+
+extern void solidity_compile_with_streaming(
+	SolidityCompiler* _compiler,
+	char const* _input,
+	CStyleWriteCallback _writeCallback,
+	void* _writeContext
+) noexcept
+{
+	WriteCallbackBuffer buffer(_writeCallback, _writeContext);
+	ostream output(&buffer);
+	compileWith(*_compiler, _input, output);
+	output.flush();
+}
+
+extern void solidity_destroy(SolidityCompiler* _compiler) noexcept
+{
+	lock_guard<mutex> lock(compilationMutex);
+	if (compilerKeepingSources == _compiler)
+		compilerKeepingSources = nullptr;
+	delete _compiler;
+}
+
+extern char* solidity_link(char const* _input) noexcept
+{
+	return addAllocation(link(_input))->data();
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return addAllocation(string(_size, '\0'))->data();
 	}
 	catch (...)
 	{
@@ -154,7 +444,11 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
+	lock_guard<mutex> lock(compilationMutex);
+	// The kept sources contain Yul identifiers.
+	dropKeptSources();
 	yul::YulStringRepository::reset();
+	lock_guard<mutex> allocationsLock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 }
@@ -52,6 +52,16 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback used to pass the output of a compilation in chunks.
+///
+/// @param _context The writeContext passed to the compilation function. Can be NULL.
+/// @param _data The next chunk of the output. Only valid during the call. Not zero-terminated.
+/// @param _length The length of the chunk in bytes.
+typedef void (*CStyleWriteCallback)(void* _context, char const* _data, size_t _length);
+
+/// Compiler that keeps its state between compilations, created by solidity_create().
+typedef struct SolidityCompiler SolidityCompiler;
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,10 +100,71 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Compiles like solidity_compile(), but passes the "Standard Output JSON" to @p _writeCallback
+/// in chunks while it is generated instead of returning it. The output of each source and contract
+/// is generated right before it is written, so the complete output is never held in memory.
+///
+/// @param _writeCallback The callback receiving the output. Must not be NULL.
+/// @param _writeContext An optional context pointer passed to _writeCallback. Can be NULL.
+void solidity_compile_streaming(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleWriteCallback _writeCallback,
+	void* _writeContext
+) SOLC_NOEXCEPT;
+
+/// Creates a compiler that keeps the analysed sources and the Yul identifiers and dialects
+/// between calls to solidity_compile_with(), so that only the sources that changed, and the
+/// sources importing them, are analysed again.
+///
+/// Different compilers can be used from different threads at the same time, but their
+/// compilations are performed one after another, because the types and Yul identifiers are
+/// shared by all compilations of the process. Only the compiler used last keeps its analysed
+/// sources, so alternating between compilers leads to full compilations.
+///
+/// @param _readCallback The optional callback pointer used by all compilations. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns the compiler, which must be released by solidity_destroy(), or NULL if it could not be created.
+SolidityCompiler* solidity_create(CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
+
+/// Takes a "Standard Input JSON" and returns a "Standard Output JSON" like solidity_compile(),
+/// but using the compiler @p _compiler created by solidity_create(). The same compiler must not be used
+/// by several threads at the same time.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compile_with(SolidityCompiler* _compiler, char const* _input) SOLC_NOEXCEPT;
+
+/// Compiles like solidity_compile_with(), but passes the output to @p _writeCallback in chunks,
+/// like solidity_compile_streaming().
+void solidity_compile_with_streaming(
+	SolidityCompiler* _compiler,
+	char const* _input,
+	CStyleWriteCallback _writeCallback,
+	void* _writeContext
+) SOLC_NOEXCEPT;
+
+/// Releases the compiler @p _compiler created by solidity_create(). Results returned by it stay valid.
+void solidity_destroy(SolidityCompiler* _compiler) SOLC_NOEXCEPT;
+
+/// Links bytecode against library addresses. Takes a JSON object of the form
+/// {"bytecodes": {<name>: <hex bytecode>, ...}, "libraries": {<library name>: "0x<address>", ...}, "parallelism": <n>}
+/// where "libraries" and "parallelism" are optional, and returns a JSON object containing the linked
+/// "bytecodes", the "unresolvedReferences" (position to placeholder) per bytecode and "errors", if any.
+/// Bytecodes with malformed placeholders are reported as errors and omitted from the output.
+/// Up to "parallelism" bytecodes are linked concurrently.
+///
+/// @param _input The input JSON to process.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_link(char const* _input) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
-/// is invalid after calling this!
+/// is invalid after calling this! The compilers created by solidity_create() stay valid, but
+/// analyse all sources again in their next compilation.
 void solidity_reset() SOLC_NOEXCEPT;
 
 #ifdef __cplusplus
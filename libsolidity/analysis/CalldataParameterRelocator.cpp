@@ -0,0 +1,204 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/analysis/CalldataParameterRelocator.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Maximal number of stack slots the parameters, return parameters and local variables of a
+/// function may occupy together after keeping parameters in calldata, each of which takes an
+/// additional slot. This leaves room for the temporary values of expressions, so that functions
+/// close to the limit of the reachable stack are compiled as before.
+size_t constexpr c_maxStackSlots = 12;
+
+size_t stackSlots(vector<ASTPointer<VariableDeclaration>> const& _variables)
+{
+	size_t slots = 0;
+	for (ASTPointer<VariableDeclaration> const& variable: _variables)
+		slots += variable->annotation().type->sizeOnStack();
+	return slots;
+}
+
+size_t stackSlots(vector<VariableDeclaration const*> const& _variables)
+{
+	size_t slots = 0;
+	for (VariableDeclaration const* variable: _variables)
+		slots += variable->annotation().type->sizeOnStack();
+	return slots;
+}
+
+bool relocatableType(Type const& _type)
+{
+	auto const* arrayType = dynamic_cast<ArrayType const*>(&_type);
+	if (!arrayType || arrayType->location() != DataLocation::Memory || !arrayType->isDynamicallySized())
+		return false;
+	if (arrayType->isByteArray())
+		return true;
+	// Elements of calldata arrays are only validated when they are accessed,
+	// so the types of the elements must not need any validation.
+	Type const* baseType = arrayType->baseType();
+	if (auto const* integerType = dynamic_cast<IntegerType const*>(baseType))
+		return integerType->numBits() == 256;
+	if (auto const* fixedBytesType = dynamic_cast<FixedBytesType const*>(baseType))
+		return fixedBytesType->numBytes() == 32;
+	return false;
+}
+
+}
+
+Type const* RelocatedParameters::type(VariableDeclaration const& _variable) const
+{
+	if (Type const* const* relocatedType = util::valueOrNullptr(m_types, &_variable))
+		return *relocatedType;
+	return _variable.annotation().type;
+}
+
+Type const* RelocatedParameters::type(Expression const& _expression) const
+{
+	if (auto const* identifier = dynamic_cast<Identifier const*>(&_expression))
+		if (auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration))
+			if (Type const* const* relocatedType = util::valueOrNullptr(m_types, variable))
+				return *relocatedType;
+	return _expression.annotation().type;
+}
+
+TypePointers RelocatedParameters::parameterTypes(FunctionDefinition const& _function) const
+{
+	TypePointers types;
+	for (ASTPointer<VariableDeclaration> const& parameter: _function.parameters())
+		types.push_back(type(*parameter));
+	return types;
+}
+
+void CalldataParameterRelocator::relocate(SourceUnit const& _sourceUnit, RelocatedParameters& _relocatedParameters)
+{
+	for (ASTPointer<ASTNode> const& node: _sourceUnit.nodes())
+		if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+		{
+			if (contract->isLibrary())
+				continue;
+			for (FunctionDefinition const* function: contract->definedFunctions())
+				if (function->visibility() == Visibility::External && function->isImplemented())
+					CalldataParameterRelocator(*function, _relocatedParameters).run();
+		}
+}
+
+void CalldataParameterRelocator::run()
+{
+	for (ASTPointer<VariableDeclaration> const& parameter: m_function.parameters())
+		if (relocatableType(*parameter->annotation().type))
+			m_candidates.insert(parameter.get());
+	if (m_candidates.empty())
+		return;
+
+	for (ASTPointer<ModifierInvocation> const& modifier: m_function.modifiers())
+		modifier->accept(*this);
+	m_function.body().accept(*this);
+
+	// The return address, the variables of the function and of its modifiers are on the stack
+	// together. All local variables are counted, even if they are not in scope at the same time.
+	size_t slots =
+		1 +
+		stackSlots(m_function.parameters()) +
+		stackSlots(m_function.returnParameters()) +
+		stackSlots(m_function.localVariables());
+	for (ASTPointer<ModifierInvocation> const& invocation: m_function.modifiers())
+		if (auto const* modifier = dynamic_cast<ModifierDefinition const*>(
+			invocation->name().annotation().referencedDeclaration
+		))
+			slots += stackSlots(modifier->parameters()) + stackSlots(modifier->localVariables());
+
+	// Parameters are visited in their order to make the result independent of their addresses.
+	for (ASTPointer<VariableDeclaration> const& parameter: m_function.parameters())
+		if (m_candidates.count(parameter.get()))
+		{
+			Type const* calldataType = TypeProvider::withLocation(
+				dynamic_cast<ArrayType const*>(parameter->annotation().type),
+				DataLocation::CallData,
+				true
+			);
+			slots += calldataType->sizeOnStack() - parameter->annotation().type->sizeOnStack();
+			if (slots > c_maxStackSlots)
+				return;
+			m_relocatedParameters.add(*parameter, calldataType);
+		}
+}
+
+bool CalldataParameterRelocator::visitNode(ASTNode const& _node)
+{
+	if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+	{
+		auto const* parameter = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+		if (
+			m_candidates.count(parameter) &&
+			(m_parents.empty() || !readOnlyUse(*identifier, *m_parents.back()))
+		)
+			m_candidates.erase(parameter);
+	}
+	else if (auto const* inlineAssembly = dynamic_cast<InlineAssembly const*>(&_node))
+		for (auto const& reference: inlineAssembly->annotation().externalReferences)
+			m_candidates.erase(dynamic_cast<VariableDeclaration const*>(reference.second.declaration));
+
+	m_parents.push_back(&_node);
+	return true;
+}
+
+void CalldataParameterRelocator::endVisitNode(ASTNode const&)
+{
+	m_parents.pop_back();
+}
+
+bool CalldataParameterRelocator::readOnlyUse(Identifier const& _identifier, ASTNode const& _parent)
+{
+	if (_identifier.annotation().willBeWrittenTo)
+		return false;
+
+	if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_parent))
+		return memberAccess->memberName() == "length";
+	else if (auto const* indexAccess = dynamic_cast<IndexAccess const*>(&_parent))
+		return
+			&indexAccess->baseExpression() == &_identifier &&
+			indexAccess->indexExpression() &&
+			!indexAccess->annotation().willBeWrittenTo;
+	else if (auto const* functionCall = dynamic_cast<FunctionCall const*>(&_parent))
+	{
+		if (*functionCall->annotation().kind != FunctionCallKind::FunctionCall)
+			return false;
+		auto const* functionType = dynamic_cast<FunctionType const*>(functionCall->expression().annotation().type);
+		if (
+			!functionType ||
+			(functionType->kind() != FunctionType::Kind::KECCAK256 && functionType->kind() != FunctionType::Kind::ABIDecode)
+		)
+			return false;
+		return
+			!functionCall->arguments().empty() &&
+			functionCall->arguments().front().get() == &_identifier &&
+			_identifier.annotation().type->isImplicitlyConvertibleTo(*TypeProvider::bytesMemory());
+	}
+	return false;
+}
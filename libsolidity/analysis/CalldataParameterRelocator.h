@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/Types.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Memory parameters of external functions that the code generators keep in calldata,
+ * mapped to their calldata types.
+ *
+ * The annotations of the AST keep the declared types, so the code generators have to
+ * take the types of these parameters and of the identifiers referring to them from here.
+ */
+class RelocatedParameters
+{
+public:
+	void add(VariableDeclaration const& _parameter, Type const* _type) { m_types[&_parameter] = _type; }
+
+	/// @returns the type of @a _variable used by the code generators.
+	Type const* type(VariableDeclaration const& _variable) const;
+	/// @returns the type of @a _expression used by the code generators, which differs from
+	/// its annotated type for identifiers referring to a relocated parameter.
+	Type const* type(Expression const& _expression) const;
+	/// @returns the types of the parameters of @a _function used by the code generators.
+	TypePointers parameterTypes(FunctionDefinition const& _function) const;
+
+private:
+	std::map<VariableDeclaration const*, Type const*> m_types;
+};
+
+/**
+ * Determines the read-only memory parameters of external functions that can stay in calldata,
+ * so that the code generators do not copy them from calldata to memory when decoding them.
+ *
+ * This applies to dynamically sized ``bytes``, ``string`` and arrays with elements that
+ * occupy a full word and thus do not need validation, if the parameter is only used to
+ * read its length or its elements, or as the argument of ``keccak256`` or ``abi.decode``.
+ * Only the generated code changes, neither the signature nor the interface of the function.
+ * Since a calldata array takes one more stack slot than a memory array, parameters are only
+ * relocated as long as the variables of the function stay well below the stack limit.
+ */
+class CalldataParameterRelocator: private ASTConstVisitor
+{
+public:
+	/// Adds the parameters of the functions in @a _sourceUnit that can stay in calldata to
+	/// @a _relocatedParameters.
+	static void relocate(SourceUnit const& _sourceUnit, RelocatedParameters& _relocatedParameters);
+
+private:
+	CalldataParameterRelocator(FunctionDefinition const& _function, RelocatedParameters& _relocatedParameters):
+		m_function(_function),
+		m_relocatedParameters(_relocatedParameters)
+	{}
+
+	void run();
+
+	bool visitNode(ASTNode const& _node) override;
+	void endVisitNode(ASTNode const& _node) override;
+
+	/// @returns true if @a _identifier is used in @a _parent in a way that is valid for calldata.
+	static bool readOnlyUse(Identifier const& _identifier, ASTNode const& _parent);
+
+	FunctionDefinition const& m_function;
+	RelocatedParameters& m_relocatedParameters;
+	/// Parameters that are candidates for the relocation.
+	std::set<VariableDeclaration const*> m_candidates;
+	std::vector<ASTNode const*> m_parents;
+};
+
+}
@@ -52,6 +52,9 @@ bool fitsPrecisionExp(bigint const& _base, bigint const& _exp)
 		return true;
 	if (mostSignificantBaseBit > bitsMax) // _base >= 2 ^ 4096
 		return false;
+	// Avoids multiplying huge exponents below.
+	if (_exp > bitsMax)
+		return false;
 
 	bigint bitsNeeded = _exp * (mostSignificantBaseBit + 1);
 
@@ -87,9 +90,10 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			return nullopt;
 		else
 			return _left.numerator() & _right.numerator();
-	case Token::Add: return _left + _right;
-	case Token::Sub: return _left - _right;
-	case Token::Mul: return _left * _right;
+	// For integers, this avoids normalising the result by the greatest common divisor.
+	case Token::Add: return fractional ? _left + _right : rational(_left.numerator() + _right.numerator());
+	case Token::Sub: return fractional ? _left - _right : rational(_left.numerator() - _right.numerator());
+	case Token::Mul: return fractional ? _left * _right : rational(_left.numerator() * _right.numerator());
 	case Token::Div:
 		if (_right == rational(0))
 			return nullopt;
@@ -138,6 +142,10 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 					return 1;
 				else if (_base == -1)
 					return 1 - 2 * static_cast<int>(_exponent & 1);
+				else if (_base > 0 && boost::multiprecision::lsb(_base) == boost::multiprecision::msb(_base))
+					// Powers of two, like 2**255, are a single shift.
+					// The precision check above guarantees that the shift does not overflow.
+					return bigint(1) << (boost::multiprecision::msb(_base) * _exponent);
 				else
 					return boost::multiprecision::pow(_base, _exponent);
 			};
@@ -356,6 +364,13 @@ void ConstantEvaluator::endVisit(BinaryOperation const& _operation)
 		return;
 	}
 
+	// Arithmetic between rational number types already computes the value as part of the type.
+	if (auto const* rationalResult = dynamic_cast<RationalNumberType const*>(resultType))
+	{
+		m_values[&_operation] = TypedRational{rationalResult, rationalResult->value()};
+		return;
+	}
+
 	left = convertType(left, *resultType);
 	right = convertType(right, *resultType);
 	if (!left || !right)
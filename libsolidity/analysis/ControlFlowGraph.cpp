@@ -54,6 +54,13 @@ FunctionFlow const& CFG::functionFlow(FunctionDefinition const& _function, Contr
 	return *m_functionControlFlow.at({_contract, &_function});
 }
 
+void CFG::annotateFunctions(shared_ptr<CFG const> const& _cfg)
+{
+	for (auto const& [functionContract, flow]: _cfg->m_functionControlFlow)
+		functionContract.function->annotation().controlFlow[functionContract.contract] =
+			shared_ptr<FunctionFlow const>(_cfg, flow.get());
+}
+
 CFGNode* CFG::NodeContainer::newNode()
 {
 	m_nodes.emplace_back(std::make_unique<CFGNode>());
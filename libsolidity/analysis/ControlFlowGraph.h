@@ -164,6 +164,10 @@ public:
 		return m_functionControlFlow;
 	}
 
+	/// Stores the function flows of @a _cfg in the annotations of their functions, so that later
+	/// analysis steps can reuse them. This keeps @a _cfg alive as long as the annotations refer to it.
+	static void annotateFunctions(std::shared_ptr<CFG const> const& _cfg);
+
 	class NodeContainer
 	{
 	public:
@@ -27,6 +27,9 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <map>
+#include <unordered_map>
+
 namespace solidity::frontend
 {
 
@@ -47,6 +50,11 @@ public:
 		if (_enclosingContainer)
 			_enclosingContainer->m_innerContainers.emplace_back(this);
 	}
+	/// Removes the container from its enclosing container, which can outlive it if
+	/// the analysis of a source unit is discarded.
+	~DeclarationContainer();
+	DeclarationContainer(DeclarationContainer const&) = delete;
+	DeclarationContainer& operator=(DeclarationContainer const&) = delete;
 	/// Registers the declaration in the scope unless its name is already declared or the name is empty.
 	/// @param _name the name to register, if nullptr the intrinsic name of @a _declaration is used.
 	/// @param _location alternative location, used to point at homonymous declarations.
@@ -72,7 +80,8 @@ public:
 	) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations by name, ordered by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -93,10 +102,10 @@ public:
 
 private:
 	ASTNode const* m_enclosingNode = nullptr;
-	DeclarationContainer const* m_enclosingContainer = nullptr;
-	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	DeclarationContainer* m_enclosingContainer = nullptr;
+	std::vector<DeclarationContainer*> m_innerContainers;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
 };
@@ -37,6 +37,9 @@ class DocStringTagParser: private ASTConstVisitor
 public:
 	explicit DocStringTagParser(langutil::ErrorReporter& _errorReporter): m_errorReporter(_errorReporter) {}
 	bool parseDocStrings(SourceUnit const& _sourceUnit);
+	/// @returns the visitor that parses the doc strings for @a parseDocStrings, to run it together
+	/// with other visitors in a single walk of the AST (see FusedASTVisitor).
+	ASTConstVisitor& visitor() { return *this; }
 	/// Validate the parsed doc strings, requires parseDocStrings() and the
 	/// DeclarationTypeChecker to have run.
 	bool validateDocStringsUsingTypes(SourceUnit const& _sourceUnit);
@@ -116,6 +116,14 @@ void GlobalContext::setCurrentContract(ContractDefinition const& _contract)
 	m_currentContract = &_contract;
 }
 
+void GlobalContext::removeContract(ContractDefinition const& _contract)
+{
+	if (m_currentContract == &_contract)
+		m_currentContract = nullptr;
+	m_thisPointer.erase(&_contract);
+	m_superPointer.erase(&_contract);
+}
+
 vector<Declaration const*> GlobalContext::declarations() const
 {
 	vector<Declaration const*> declarations;
@@ -50,6 +50,8 @@ public:
 	GlobalContext();
 	void setCurrentContract(ContractDefinition const& _contract);
 	void resetCurrentContract() { m_currentContract = nullptr; }
+	/// Removes the "this" and "super" declarations of a contract that is about to be destroyed.
+	void removeContract(ContractDefinition const& _contract);
 	MagicVariableDeclaration const* currentThis() const;
 	MagicVariableDeclaration const* currentSuper() const;
 
@@ -138,6 +138,25 @@ bool NameAndTypeResolver::resolveNamesAndTypes(SourceUnit& _source)
 	return true;
 }
 
+void NameAndTypeResolver::removeSourceUnit(SourceUnit const& _sourceUnit)
+{
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			m_scopes.erase(&_node);
+			if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+				m_globalContext.removeContract(*contract);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	_sourceUnit.accept(visitor);
+
+	// The global scope could still refer to "this" and "super" of a removed contract.
+	m_globalContext.resetCurrentContract();
+	m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentThis(), true, true);
+	m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentSuper(), true, true);
+}
+
 bool NameAndTypeResolver::updateDeclaration(Declaration const& _declaration)
 {
 	try
@@ -454,7 +473,7 @@ string NameAndTypeResolver::similarNameSuggestions(ASTString const& _name) const
 }
 
 DeclarationRegistrationHelper::DeclarationRegistrationHelper(
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ASTNode& _astRoot,
 	ErrorReporter& _errorReporter,
 	GlobalContext& _globalContext,
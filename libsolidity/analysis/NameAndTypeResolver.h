@@ -33,6 +33,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::langutil
 {
@@ -71,6 +72,10 @@ public:
 	/// Resolves all names and types referenced from the given Source Node.
 	/// @returns false in case of error.
 	bool resolveNamesAndTypes(SourceUnit& _source);
+	/// Removes the scopes of all nodes in the given source unit and the global declarations
+	/// created for its contracts. Has to be called before a source unit whose declarations
+	/// were registered is destroyed while the resolver is kept.
+	void removeSourceUnit(SourceUnit const& _sourceUnit);
 	/// Updates the given global declaration (used for "this"). Not to be used with declarations
 	/// that create their own scope.
 	/// @returns false in case of error.
@@ -122,7 +127,7 @@ private:
 	/// where nullptr denotes the global scope. Note that structs are not scope since they do
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 
 	langutil::EVMVersion m_evmVersion;
 	DeclarationContainer* m_currentScope = nullptr;
@@ -142,7 +147,7 @@ public:
 	/// @param _currentScope should be nullptr if we start at SourceUnit, but can be different
 	/// to inject new declarations into an existing scope, used by snippets.
 	DeclarationRegistrationHelper(
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		ASTNode& _astRoot,
 		langutil::ErrorReporter& _errorReporter,
 		GlobalContext& _globalContext,
@@ -179,7 +184,7 @@ private:
 	/// @returns the canonical name of the current scope.
 	std::string currentCanonicalName() const;
 
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 	ASTNode const* m_currentScope = nullptr;
 	VariableScope* m_currentFunction = nullptr;
 	ContractDefinition const* m_currentContract = nullptr;
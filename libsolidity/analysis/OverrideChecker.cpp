@@ -884,52 +884,58 @@ void OverrideChecker::checkOverrideList(OverrideProxy _item, OverrideProxyBySign
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedFunctions(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedFunctions.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
+	if (auto it = m_inheritedFunctions.find(&_contract); it != m_inheritedFunctions.end())
+		return it->second;
 
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
-			for (FunctionDefinition const* fun: base->definedFunctions())
-				if (!fun->isConstructor())
-					functionsInBase.emplace(OverrideProxy{fun});
-			for (VariableDeclaration const* var: base->stateVariables())
-				if (var->isPublic())
-					functionsInBase.emplace(OverrideProxy{var});
-
-			for (OverrideProxy const& func: inheritedFunctions(*base))
-				functionsInBase.insert(func);
-
-			result += functionsInBase;
-		}
-
-		m_inheritedFunctions[&_contract] = result;
-	}
+	OverrideProxyBySignatureMultiSet result;
+	for (auto const* base: resolveDirectBaseContracts(_contract))
+		result += visibleFunctions(*base);
 
-	return m_inheritedFunctions[&_contract];
+	return m_inheritedFunctions[&_contract] = move(result);
 }
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedModifiers(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedModifiers.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
+	if (auto it = m_inheritedModifiers.find(&_contract); it != m_inheritedModifiers.end())
+		return it->second;
 
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
-			for (ModifierDefinition const* mod: base->functionModifiers())
-				modifiersInBase.emplace(OverrideProxy{mod});
+	OverrideProxyBySignatureMultiSet result;
+	for (auto const* base: resolveDirectBaseContracts(_contract))
+		result += visibleModifiers(*base);
 
-			for (OverrideProxy const& mod: inheritedModifiers(*base))
-				modifiersInBase.insert(mod);
+	return m_inheritedModifiers[&_contract] = move(result);
+}
 
-			result += modifiersInBase;
-		}
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::visibleFunctions(ContractDefinition const& _contract) const
+{
+	if (auto it = m_visibleFunctions.find(&_contract); it != m_visibleFunctions.end())
+		return it->second;
 
-		m_inheritedModifiers[&_contract] = result;
-	}
+	OverrideProxyBySignatureSet result;
+	for (FunctionDefinition const* fun: _contract.definedFunctions())
+		if (!fun->isConstructor())
+			result.emplace(OverrideProxy{fun});
+	for (VariableDeclaration const* var: _contract.stateVariables())
+		if (var->isPublic())
+			result.emplace(OverrideProxy{var});
+
+	for (OverrideProxy const& func: inheritedFunctions(_contract))
+		result.insert(func);
+
+	return m_visibleFunctions[&_contract] = move(result);
+}
+
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::visibleModifiers(ContractDefinition const& _contract) const
+{
+	if (auto it = m_visibleModifiers.find(&_contract); it != m_visibleModifiers.end())
+		return it->second;
+
+	OverrideProxyBySignatureSet result;
+	for (ModifierDefinition const* mod: _contract.functionModifiers())
+		result.emplace(OverrideProxy{mod});
+
+	for (OverrideProxy const& mod: inheritedModifiers(_contract))
+		result.insert(mod);
 
-	return m_inheritedModifiers[&_contract];
+	return m_visibleModifiers[&_contract] = move(result);
 }
@@ -134,6 +134,7 @@ class OverrideChecker
 {
 public:
 	using OverrideProxyBySignatureMultiSet = std::multiset<OverrideProxy, OverrideProxy::CompareBySignature>;
+	using OverrideProxyBySignatureSet = std::set<OverrideProxy, OverrideProxy::CompareBySignature>;
 
 	/// @param _errorReporter provides the error logging functionality.
 	explicit OverrideChecker(langutil::ErrorReporter& _errorReporter):
@@ -189,11 +190,22 @@ private:
 
 	void checkOverrideList(OverrideProxy _item, OverrideProxyBySignatureMultiSet const& _inherited);
 
+	/// @returns the functions (including public state variables) defined in @a _contract together
+	/// with the inherited functions it does not override, i.e. one function per signature.
+	OverrideProxyBySignatureSet const& visibleFunctions(ContractDefinition const& _contract) const;
+	/// @returns the modifiers defined in @a _contract together with the inherited modifiers it
+	/// does not override, i.e. one modifier per name.
+	OverrideProxyBySignatureSet const& visibleModifiers(ContractDefinition const& _contract) const;
+
 	langutil::ErrorReporter& m_errorReporter;
 
 	/// Cache for inheritedFunctions().
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Cache for visibleFunctions() and visibleModifiers(), which are shared by all contracts
+	/// deriving from the same base.
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_visibleFunctions;
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_visibleModifiers;
 };
 
 }
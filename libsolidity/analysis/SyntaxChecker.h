@@ -51,6 +51,9 @@ public:
 	{}
 
 	bool checkSyntax(ASTNode const& _astRoot);
+	/// @returns the visitor that performs the checks of @a checkSyntax, to run it together with
+	/// other visitors in a single walk of the AST (see FusedASTVisitor).
+	ASTConstVisitor& visitor() { return *this; }
 
 private:
 
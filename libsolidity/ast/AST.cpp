@@ -238,7 +238,8 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		set<string> signaturesSeen;
-		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		vector<string> signatures;
+		vector<FunctionTypePointer> interfaceFunctions;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
@@ -260,12 +261,19 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					util::FixedHash<4> hash(util::keccak256(functionSignature));
-					interfaceFunctionList.emplace_back(hash, fun);
+					signatures.emplace_back(move(functionSignature));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
 
+		vector<bytesConstRef> hashInputs;
+		for (string const& signature: signatures)
+			hashInputs.emplace_back(signature);
+		vector<util::h256> hashes = util::keccak256Batch(hashInputs);
+		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		for (size_t i = 0; i < interfaceFunctions.size(); ++i)
+			interfaceFunctionList.emplace_back(util::FixedHash<4>(hashes[i]), interfaceFunctions[i]);
 		return interfaceFunctionList;
 	});
 }
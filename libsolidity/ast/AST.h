@@ -120,15 +120,21 @@ public:
 	bool operator!=(ASTNode const& _other) const { return !operator==(_other); }
 	///@}
 
+	friend class Parser;
+
 protected:
-	size_t const m_id = 0;
+	/// Not const because the parser moves the IDs of source units parsed concurrently.
+	size_t m_id = 0;
 
+	/// Creates the annotation on first use. Every node class uses a single annotation type for
+	/// all its calls, the one of the override of annotation() for its most derived class, so
+	/// the annotation always has type @a T and the cast does not need to be checked.
 	template <class T>
 	T& initAnnotation() const
 	{
 		if (!m_annotation)
 			m_annotation = std::make_unique<T>();
-		return dynamic_cast<T&>(*m_annotation);
+		return static_cast<T&>(*m_annotation);
 	}
 
 private:
@@ -50,6 +50,7 @@ class ArrayType;
 using namespace util;
 
 struct CallGraph;
+struct FunctionFlow;
 
 struct ASTAnnotation
 {
@@ -179,6 +180,10 @@ struct CallableDeclarationAnnotation: DeclarationAnnotation
 
 struct FunctionDefinitionAnnotation: CallableDeclarationAnnotation, StructurallyDocumentedAnnotation
 {
+	/// Control flow of the function by the most derived contract it was built for (nullptr for free
+	/// functions), after pruning the calls to functions that always revert. Only set if the control
+	/// flow analysis ran. Each flow shares the ownership of the whole control flow graph.
+	std::map<ContractDefinition const*, std::shared_ptr<FunctionFlow const>> controlFlow;
 };
 
 struct EventDefinitionAnnotation: CallableDeclarationAnnotation, StructurallyDocumentedAnnotation
@@ -0,0 +1,375 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/ast/ASTBinary.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+enum class Tag: uint8_t
+{
+	Null,
+	False,
+	True,
+	UnsignedInteger,
+	NegativeInteger,
+	Real,
+	String,
+	SourceLocation,
+	Array,
+	Object
+};
+
+/// Nesting limit of arrays and objects, which is far above the depth of any AST
+/// that can be parsed, but prevents malformed input from exhausting the stack.
+size_t constexpr maxDepth = 10000;
+
+/// @returns the start, length and source index of @a _value if it is a source location
+/// of the form "start:length:sourceIndex" that is reproduced exactly when it is printed again.
+optional<tuple<uint64_t, uint64_t, int64_t>> parseSourceLocation(string const& _value)
+{
+	if (_value.size() > 3 * 20 || count(_value.begin(), _value.end(), ':') != 2)
+		return nullopt;
+
+	size_t const firstColon = _value.find(':');
+	size_t const secondColon = _value.find(':', firstColon + 1);
+	string const start = _value.substr(0, firstColon);
+	string const length = _value.substr(firstColon + 1, secondColon - firstColon - 1);
+	string const sourceIndex = _value.substr(secondColon + 1);
+
+	auto isNumber = [](string const& _number) {
+		return
+			!_number.empty() &&
+			_number.size() <= 18 &&
+			all_of(_number.begin(), _number.end(), [](char _c) { return '0' <= _c && _c <= '9'; });
+	};
+	if (
+		!isNumber(start) ||
+		!isNumber(length) ||
+		!(isNumber(sourceIndex) || sourceIndex == "-1")
+	)
+		return nullopt;
+
+	tuple<uint64_t, uint64_t, int64_t> location{stoull(start), stoull(length), stoll(sourceIndex)};
+	// Only accept the canonical representation, e.g. no leading zeros.
+	if (
+		to_string(get<0>(location)) + ":" + to_string(get<1>(location)) + ":" + to_string(get<2>(location)) !=
+		_value
+	)
+		return nullopt;
+	return location;
+}
+
+void appendVarint(string& _output, uint64_t _value)
+{
+	while (_value >= 0x80)
+	{
+		_output.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+		_value >>= 7;
+	}
+	_output.push_back(static_cast<char>(_value));
+}
+
+void appendTag(string& _output, Tag _tag)
+{
+	_output.push_back(static_cast<char>(_tag));
+}
+
+class Encoder
+{
+public:
+	explicit Encoder(Json::Value const& _ast)
+	{
+		collectStrings(_ast);
+	}
+
+	string run(Json::Value const& _ast)
+	{
+		m_output = ASTBinary::magic;
+		appendVarint(m_output, m_strings.size());
+		for (string const* value: m_strings)
+		{
+			appendVarint(m_output, value->size());
+			m_output += *value;
+		}
+		encode(_ast);
+		return move(m_output);
+	}
+
+private:
+	void collectStrings(Json::Value const& _value)
+	{
+		if (_value.isString())
+		{
+			string const value = _value.asString();
+			if (!parseSourceLocation(value))
+				addString(value);
+		}
+		else if (_value.isArray())
+			for (Json::Value const& element: _value)
+				collectStrings(element);
+		else if (_value.isObject())
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				addString(it.name());
+				collectStrings(*it);
+			}
+	}
+
+	void addString(string const& _value)
+	{
+		auto [it, inserted] = m_stringIndices.try_emplace(_value, m_strings.size());
+		if (inserted)
+			m_strings.emplace_back(&it->first);
+	}
+
+	void encode(Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			appendTag(m_output, Tag::Null);
+			break;
+		case Json::booleanValue:
+			appendTag(m_output, _value.asBool() ? Tag::True : Tag::False);
+			break;
+		case Json::intValue:
+		case Json::uintValue:
+			if (_value.isUInt64())
+			{
+				appendTag(m_output, Tag::UnsignedInteger);
+				appendVarint(m_output, _value.asUInt64());
+			}
+			else
+			{
+				appendTag(m_output, Tag::NegativeInteger);
+				appendVarint(m_output, static_cast<uint64_t>(-(_value.asInt64() + 1)));
+			}
+			break;
+		case Json::realValue:
+		{
+			appendTag(m_output, Tag::Real);
+			double const value = _value.asDouble();
+			uint64_t bits = 0;
+			static_assert(sizeof(bits) == sizeof(value));
+			memcpy(&bits, &value, sizeof(bits));
+			for (size_t i = 0; i < 8; ++i)
+				m_output.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+			break;
+		}
+		case Json::stringValue:
+		{
+			string const value = _value.asString();
+			if (auto location = parseSourceLocation(value))
+			{
+				appendTag(m_output, Tag::SourceLocation);
+				appendVarint(m_output, get<0>(*location));
+				appendVarint(m_output, get<1>(*location));
+				appendVarint(m_output, static_cast<uint64_t>(get<2>(*location) + 1));
+			}
+			else
+			{
+				appendTag(m_output, Tag::String);
+				appendVarint(m_output, m_stringIndices.at(value));
+			}
+			break;
+		}
+		case Json::arrayValue:
+			appendTag(m_output, Tag::Array);
+			appendVarint(m_output, _value.size());
+			for (Json::Value const& element: _value)
+				encode(element);
+			break;
+		case Json::objectValue:
+			appendTag(m_output, Tag::Object);
+			appendVarint(m_output, _value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				appendVarint(m_output, m_stringIndices.at(it.name()));
+				encode(*it);
+			}
+			break;
+		}
+	}
+
+	map<string, size_t> m_stringIndices;
+	vector<string const*> m_strings;
+	string m_output;
+};
+
+class Decoder
+{
+public:
+	explicit Decoder(string const& _data): m_data(_data) {}
+
+	Json::Value run()
+	{
+		astAssert(ASTBinary::isEncoded(m_data), "Binary AST does not start with the expected prefix.");
+		m_position = ASTBinary::magic.size();
+
+		size_t const stringCount = readSize();
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t const size = readSize();
+			astAssert(size <= m_data.size() - m_position, "Binary AST ends within a string.");
+			m_strings.emplace_back(m_data.substr(m_position, size));
+			m_position += size;
+		}
+
+		Json::Value result = decode(0);
+		astAssert(m_position == m_data.size(), "Binary AST has trailing data.");
+		return result;
+	}
+
+private:
+	uint8_t readByte()
+	{
+		astAssert(m_position < m_data.size(), "Binary AST ends unexpectedly.");
+		return static_cast<uint8_t>(m_data[m_position++]);
+	}
+
+	uint64_t readVarint()
+	{
+		uint64_t result = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			uint8_t const byte = readByte();
+			astAssert(shift < 63 || (shift == 63 && byte <= 1), "Binary AST contains a varint that is too large.");
+			result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return result;
+		}
+	}
+
+	/// Reads a size, which cannot be larger than the number of remaining bytes,
+	/// since every element takes at least one byte.
+	size_t readSize()
+	{
+		uint64_t const size = readVarint();
+		astAssert(size <= m_data.size() - m_position, "Binary AST contains an invalid size.");
+		return static_cast<size_t>(size);
+	}
+
+	string const& readString()
+	{
+		uint64_t const index = readVarint();
+		astAssert(index < m_strings.size(), "Binary AST refers to an invalid string.");
+		return m_strings[static_cast<size_t>(index)];
+	}
+
+	Json::Value decode(size_t _depth)
+	{
+		astAssert(_depth < maxDepth, "Binary AST is nested too deeply.");
+		switch (static_cast<Tag>(readByte()))
+		{
+		case Tag::Null:
+			return Json::nullValue;
+		case Tag::False:
+			return false;
+		case Tag::True:
+			return true;
+		case Tag::UnsignedInteger:
+			return Json::UInt64(readVarint());
+		case Tag::NegativeInteger:
+		{
+			uint64_t const value = readVarint();
+			astAssert(value <= uint64_t(numeric_limits<int64_t>::max()), "Binary AST contains an invalid integer.");
+			return Json::Int64(-static_cast<int64_t>(value) - 1);
+		}
+		case Tag::Real:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < 8; ++i)
+				bits |= static_cast<uint64_t>(readByte()) << (8 * i);
+			double value = 0;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+		case Tag::String:
+			return readString();
+		case Tag::SourceLocation:
+		{
+			uint64_t const start = readVarint();
+			uint64_t const length = readVarint();
+			uint64_t const sourceIndex = readVarint();
+			astAssert(sourceIndex <= uint64_t(numeric_limits<int64_t>::max()), "Binary AST contains an invalid source index.");
+			return to_string(start) + ":" + to_string(length) + ":" + to_string(static_cast<int64_t>(sourceIndex) - 1);
+		}
+		case Tag::Array:
+		{
+			Json::Value result{Json::arrayValue};
+			size_t const size = readSize();
+			for (size_t i = 0; i < size; ++i)
+				result.append(decode(_depth + 1));
+			return result;
+		}
+		case Tag::Object:
+		{
+			Json::Value result{Json::objectValue};
+			size_t const size = readSize();
+			for (size_t i = 0; i < size; ++i)
+			{
+				string const& name = readString();
+				result[name] = decode(_depth + 1);
+			}
+			return result;
+		}
+		}
+		astAssert(false, "Binary AST contains an invalid tag.");
+		return {};
+	}
+
+	string const& m_data;
+	size_t m_position = 0;
+	vector<string> m_strings;
+};
+
+}
+
+string const ASTBinary::magic{"\0SOLAST\x01", 8};
+
+string ASTBinary::encode(Json::Value const& _ast)
+{
+	return Encoder{_ast}.run(_ast);
+}
+
+Json::Value ASTBinary::decode(string const& _data)
+{
+	return Decoder{_data}.run();
+}
+
+bool ASTBinary::isEncoded(string const& _data)
+{
+	return boost::starts_with(_data, magic);
+}
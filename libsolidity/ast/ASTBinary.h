@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format for the JSON representation of the AST.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Converts the JSON AST produced by the ASTJsonConverter into a compact binary format and back,
+ * without printing or parsing JSON text.
+ *
+ * The encoding starts with the prefix @a magic, followed by a table of all distinct strings
+ * (member names and string values) and the encoded value, which refers to the strings by their
+ * index in the table. Integers, string indices and sizes are unsigned LEB128 varints and source
+ * locations of the form "start:length:sourceIndex" are stored as three varints.
+ * See docs/using-the-compiler.rst for the full description.
+ */
+class ASTBinary
+{
+public:
+	/// Prefix of every encoded AST. It cannot occur at the start of a JSON text.
+	static std::string const magic;
+
+	/// @returns the binary encoding of the JSON value @a _ast.
+	static std::string encode(Json::Value const& _ast);
+	/// @returns the JSON value encoded in @a _data.
+	/// Throws InvalidAstError if @a _data is not a valid encoding.
+	static Json::Value decode(std::string const& _data);
+	/// @returns true if @a _data starts with the prefix of the binary encoding.
+	static bool isEncoded(std::string const& _data);
+};
+
+}
@@ -50,7 +50,7 @@ namespace
 {
 
 template<typename V, template<typename> typename C>
-void addIfSet(std::vector<pair<string, Json::Value>>& _attributes, string const& _name, C<V> const& _value)
+void addIfSet(solidity::frontend::ASTJsonConverter::Attributes& _attributes, char const* _name, C<V> const& _value)
 {
 	if constexpr (std::is_same_v<C<V>, solidity::util::SetOnce<V>>)
 	{
@@ -78,34 +78,40 @@ ASTJsonConverter::ASTJsonConverter(CompilerStack::State _stackState, map<string,
 }
 
 
+ASTJsonConverter::Attributes ASTJsonConverter::attributesFrom(initializer_list<Attribute> _attributes)
+{
+	Attributes attributes;
+	attributes.reserve(_attributes.size());
+	for (Attribute const& attribute: _attributes)
+		attributes.emplace_back(attribute.name, std::move(attribute.value));
+	return attributes;
+}
+
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeName,
-	initializer_list<pair<string, Json::Value>>&& _attributes
+	initializer_list<Attribute>&& _attributes
 )
 {
-	ASTJsonConverter::setJsonNode(
-		_node,
-		_nodeName,
-		std::vector<pair<string, Json::Value>>(std::move(_attributes))
-	);
+	ASTJsonConverter::setJsonNode(_node, _nodeName, attributesFrom(_attributes));
 }
 
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeType,
-	std::vector<pair<string, Json::Value>>&& _attributes
+	Attributes&& _attributes
 )
 {
+	// The member names are string literals, so they do not have to be copied into every node.
 	m_currentValue = Json::objectValue;
-	m_currentValue["id"] = nodeId(_node);
-	m_currentValue["src"] = sourceLocationToString(_node.location());
+	m_currentValue[Json::StaticString("id")] = nodeId(_node);
+	m_currentValue[Json::StaticString("src")] = sourceLocationToString(_node.location());
 	if (auto const* documented = dynamic_cast<Documented const*>(&_node))
 		if (documented->documentation())
-			m_currentValue["documentation"] = *documented->documentation();
-	m_currentValue["nodeType"] = _nodeType;
-	for (auto& e: _attributes)
-		m_currentValue[e.first] = std::move(e.second);
+			m_currentValue[Json::StaticString("documentation")] = *documented->documentation();
+	m_currentValue[Json::StaticString("nodeType")] = _nodeType;
+	for (auto& [name, value]: _attributes)
+		m_currentValue[Json::StaticString(name)] = std::move(value);
 }
 
 optional<size_t> ASTJsonConverter::sourceIndexFromLocation(SourceLocation const& _location) const
@@ -133,8 +139,8 @@ string ASTJsonConverter::namePathToString(std::vector<ASTString> const& _namePat
 Json::Value ASTJsonConverter::typePointerToJson(Type const* _tp, bool _short)
 {
 	Json::Value typeDescriptions(Json::objectValue);
-	typeDescriptions["typeString"] = _tp ? Json::Value(_tp->toString(_short)) : Json::nullValue;
-	typeDescriptions["typeIdentifier"] = _tp ? Json::Value(_tp->identifier()) : Json::nullValue;
+	typeDescriptions[Json::StaticString("typeString")] = _tp ? Json::Value(_tp->toString(_short)) : Json::nullValue;
+	typeDescriptions[Json::StaticString("typeIdentifier")] = _tp ? Json::Value(_tp->identifier()) : Json::nullValue;
 	return typeDescriptions;
 
 }
@@ -152,14 +158,14 @@ Json::Value ASTJsonConverter::typePointerToJson(std::optional<FuncCallArguments>
 }
 
 void ASTJsonConverter::appendExpressionAttributes(
-	std::vector<pair<string, Json::Value>>& _attributes,
+	Attributes& _attributes,
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<pair<string, Json::Value>> exprAttributes = {
+	Attributes exprAttributes = attributesFrom({
 		make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
 		make_pair("argumentTypes", typePointerToJson(_annotation.arguments))
-	};
+	});
 
 	addIfSet(exprAttributes, "isLValue", _annotation.isLValue);
 	addIfSet(exprAttributes, "isPure", _annotation.isPure);
@@ -168,7 +174,7 @@ void ASTJsonConverter::appendExpressionAttributes(
 	if (m_stackState > CompilerStack::State::ParsedAndImported)
 		exprAttributes.emplace_back("lValueRequested", _annotation.willBeWrittenTo);
 
-	_attributes += exprAttributes;
+	_attributes += std::move(exprAttributes);
 }
 
 Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifier const* ,InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const
@@ -191,16 +197,22 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	// Null members are only removed once from the outermost node instead of from every subtree.
+	++m_nestingDepth;
+	ScopeGuard decrementDepth{[&]() { --m_nestingDepth; }};
 	_node.accept(*this);
-	return util::removeNullMembers(std::move(m_currentValue));
+	if (m_nestingDepth == 1)
+		return util::removeNullMembers(std::move(m_currentValue));
+	else
+		return std::move(m_currentValue);
 }
 
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
 		make_pair("nodes", toJson(_node.nodes()))
-	};
+	});
 
 	if (_node.annotation().exportedSymbols.set())
 	{
@@ -235,11 +247,11 @@ bool ASTJsonConverter::visit(PragmaDirective const& _node)
 
 bool ASTJsonConverter::visit(ImportDirective const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("file", _node.path()),
 		make_pair("sourceUnit", idOrNull(_node.annotation().sourceUnit)),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	addIfSet(attributes, "absolutePath", _node.annotation().absolutePath);
 
@@ -263,7 +275,7 @@ bool ASTJsonConverter::visit(ImportDirective const& _node)
 
 bool ASTJsonConverter::visit(ContractDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -274,7 +286,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
 		make_pair("nodes", toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	if (_node.annotation().unimplementedDeclarations.has_value())
 		attributes.emplace_back("fullyImplemented", _node.annotation().unimplementedDeclarations->empty());
@@ -314,13 +326,13 @@ bool ASTJsonConverter::visit(UsingForDirective const& _node)
 
 bool ASTJsonConverter::visit(StructDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("members", toJson(_node.members())),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
 
@@ -331,11 +343,11 @@ bool ASTJsonConverter::visit(StructDefinition const& _node)
 
 bool ASTJsonConverter::visit(EnumDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("members", toJson(_node.members()))
-	};
+	});
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
 
@@ -371,7 +383,7 @@ bool ASTJsonConverter::visit(OverrideSpecifier const& _node)
 
 bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -385,7 +397,7 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue),
 		make_pair("implemented", _node.isImplemented()),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	optional<Visibility> visibility;
 	if (_node.isConstructor())
@@ -409,7 +421,7 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("typeName", toJson(_node.typeName())),
@@ -422,7 +434,7 @@ bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 		make_pair("value", _node.value() ? toJson(*_node.value()) : Json::nullValue),
 		make_pair("scope", idOrNull(_node.scope())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
-	};
+	});
 	if (_node.isStateVariable() && _node.isPublic())
 		attributes.emplace_back("functionSelector", _node.externalIdentifierHex());
 	if (_node.isStateVariable() && _node.documentation())
@@ -437,7 +449,7 @@ bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 
 bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -446,7 +458,7 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 		make_pair("virtual", _node.markedVirtual()),
 		make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json::nullValue),
 		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue)
-	};
+	});
 	if (!_node.annotation().baseFunctions.empty())
 		attributes.emplace_back(make_pair("baseModifiers", getContainerIds(_node.annotation().baseFunctions, true)));
 	setJsonNode(_node, "ModifierDefinition", std::move(attributes));
@@ -455,10 +467,10 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 
 bool ASTJsonConverter::visit(ModifierInvocation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes{
+	Attributes attributes = attributesFrom({
 		make_pair("modifierName", toJson(_node.name())),
 		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
-	};
+	});
 	if (Declaration const* declaration = _node.name().annotation().referencedDeclaration)
 	{
 		if (dynamic_cast<ModifierDefinition const*>(declaration))
@@ -496,10 +508,10 @@ bool ASTJsonConverter::visit(ErrorDefinition const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("name", _node.typeName().toString()),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
-	};
+	});
 
 	if (_node.stateMutability())
 		attributes.emplace_back(make_pair("stateMutability", stateMutabilityToString(*_node.stateMutability())));
@@ -708,11 +720,11 @@ bool ASTJsonConverter::visit(ExpressionStatement const& _node)
 
 bool ASTJsonConverter::visit(Conditional const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("condition", toJson(_node.condition())),
 		make_pair("trueExpression", toJson(_node.trueExpression())),
 		make_pair("falseExpression", toJson(_node.falseExpression()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
 	return false;
@@ -720,11 +732,11 @@ bool ASTJsonConverter::visit(Conditional const& _node)
 
 bool ASTJsonConverter::visit(Assignment const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
 		make_pair("leftHandSide", toJson(_node.leftHandSide())),
 		make_pair("rightHandSide", toJson(_node.rightHandSide()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Assignment", std::move(attributes));
 	return false;
@@ -732,10 +744,10 @@ bool ASTJsonConverter::visit(Assignment const& _node)
 
 bool ASTJsonConverter::visit(TupleExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("isInlineArray", Json::Value(_node.isInlineArray())),
 		make_pair("components", toJson(_node.components())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
 	return false;
@@ -743,11 +755,11 @@ bool ASTJsonConverter::visit(TupleExpression const& _node)
 
 bool ASTJsonConverter::visit(UnaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("prefix", _node.isPrefixOperation()),
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
 		make_pair("subExpression", toJson(_node.subExpression()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "UnaryOperation", std::move(attributes));
 	return false;
@@ -755,12 +767,12 @@ bool ASTJsonConverter::visit(UnaryOperation const& _node)
 
 bool ASTJsonConverter::visit(BinaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
 		make_pair("leftExpression", toJson(_node.leftExpression())),
 		make_pair("rightExpression", toJson(_node.rightExpression())),
 		make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "BinaryOperation", std::move(attributes));
 	return false;
@@ -771,12 +783,12 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 	Json::Value names(Json::arrayValue);
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("names", std::move(names)),
 		make_pair("arguments", toJson(_node.arguments())),
 		make_pair("tryCall", _node.annotation().tryCall)
-	};
+	});
 
 	if (_node.annotation().kind.set())
 	{
@@ -795,11 +807,11 @@ bool ASTJsonConverter::visit(FunctionCallOptions const& _node)
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
 
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("names", std::move(names)),
 		make_pair("options", toJson(_node.options())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 
 	setJsonNode(_node, "FunctionCallOptions", std::move(attributes));
@@ -808,9 +820,9 @@ bool ASTJsonConverter::visit(FunctionCallOptions const& _node)
 
 bool ASTJsonConverter::visit(NewExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("typeName", toJson(_node.typeName()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
 	return false;
@@ -818,11 +830,11 @@ bool ASTJsonConverter::visit(NewExpression const& _node)
 
 bool ASTJsonConverter::visit(MemberAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("memberName", _node.memberName()),
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "MemberAccess", std::move(attributes));
 	return false;
@@ -830,10 +842,10 @@ bool ASTJsonConverter::visit(MemberAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("baseExpression", toJson(_node.baseExpression())),
 		make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
 	return false;
@@ -841,11 +853,11 @@ bool ASTJsonConverter::visit(IndexAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexRangeAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("baseExpression", toJson(_node.baseExpression())),
 		make_pair("startExpression", toJsonOrNull(_node.startExpression())),
 		make_pair("endExpression", toJsonOrNull(_node.endExpression())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexRangeAccess", std::move(attributes));
 	return false;
@@ -868,9 +880,9 @@ bool ASTJsonConverter::visit(Identifier const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("typeName", toJson(_node.type()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "ElementaryTypeNameExpression", std::move(attributes));
 	return false;
@@ -882,7 +894,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 	if (!util::validateUTF8(_node.value()))
 		value = Json::nullValue;
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("kind", literalTokenKind(_node.token())),
 		make_pair("value", value),
 		make_pair("hexValue", util::toHex(util::asBytes(_node.value()))),
@@ -892,7 +904,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 			Json::nullValue :
 			Json::Value{TokenTraits::toString(subdenomination)}
 		)
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Literal", std::move(attributes));
 	return false;
@@ -901,9 +913,9 @@ bool ASTJsonConverter::visit(Literal const& _node)
 bool ASTJsonConverter::visit(StructuredDocumentation const& _node)
 {
 	Json::Value text{*_node.text()};
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = attributesFrom({
 		make_pair("text", text)
-	};
+	});
 	setJsonNode(_node, "StructuredDocumentation", std::move(attributes));
 	return false;
 }
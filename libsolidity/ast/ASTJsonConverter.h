@@ -50,6 +50,9 @@ namespace solidity::frontend
 class ASTJsonConverter: public ASTConstVisitor
 {
 public:
+	/// Names and values of the members of a node. The names are string literals.
+	using Attributes = std::vector<std::pair<char const*, Json::Value>>;
+
 	/// Create a converter to JSON for the given abstract syntax tree.
 	/// @a _stackState state of the compiler stack to avoid outputting incomplete data
 	/// @a _sourceIndices is used to abbreviate source names in source locations.
@@ -129,15 +132,30 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Element of an initializer list of attributes. The value is mutable, so that it can be
+	/// moved out of the list instead of copying the whole subtree.
+	struct Attribute
+	{
+		template <typename Value>
+		Attribute(std::pair<char const*, Value>&& _attribute):
+			name(_attribute.first),
+			value(std::move(_attribute.second))
+		{}
+
+		char const* name;
+		mutable Json::Value value;
+	};
+	static Attributes attributesFrom(std::initializer_list<Attribute> _attributes);
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+		std::initializer_list<Attribute>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::vector<std::pair<std::string, Json::Value>>&& _attributes
+		Attributes&& _attributes
 	);
 	/// Maps source location to an index, if source is valid and a mapping does exist, otherwise returns std::nullopt.
 	std::optional<size_t> sourceIndexFromLocation(langutil::SourceLocation const& _location) const;
@@ -184,7 +202,7 @@ private:
 	static Json::Value typePointerToJson(Type const* _tp, bool _short = false);
 	static Json::Value typePointerToJson(std::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
-		std::vector<std::pair<std::string, Json::Value>> &_attributes,
+		Attributes& _attributes,
 		ExpressionAnnotation const& _annotation
 	);
 	static void appendMove(Json::Value& _array, Json::Value&& _value)
@@ -196,6 +214,7 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	size_t m_nestingDepth = 0; ///< Number of nested calls to toJson for single nodes.
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
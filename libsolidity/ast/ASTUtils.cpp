@@ -62,4 +62,29 @@ VariableDeclaration const* rootConstVariableDeclaration(VariableDeclaration cons
 	return rootDecl;
 }
 
+FunctionCall const* packedEncodingCall(Expression const& _expression)
+{
+	auto const* functionCall = dynamic_cast<FunctionCall const*>(&_expression);
+	if (!functionCall || *functionCall->annotation().kind != FunctionCallKind::FunctionCall)
+		return nullptr;
+	auto const* functionType = dynamic_cast<FunctionType const*>(functionCall->expression().annotation().type);
+	if (
+		functionType &&
+		(functionType->kind() == FunctionType::Kind::ABIEncodePacked || functionType->kind() == FunctionType::Kind::BytesConcat)
+	)
+		return functionCall;
+	return nullptr;
+}
+
+std::optional<std::string> constantPackedEncoding(FunctionCall const& _call)
+{
+	std::string result;
+	for (ASTPointer<Expression const> const& argument: _call.arguments())
+		if (auto const* literalType = dynamic_cast<StringLiteralType const*>(argument->annotation().type))
+			result += literalType->value();
+		else
+			return std::nullopt;
+	return result;
+}
+
 }
@@ -18,12 +18,16 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 namespace solidity::frontend
 {
 
 class VariableDeclaration;
 class Declaration;
 class Expression;
+class FunctionCall;
 
 /// Find the topmost referenced constant variable declaration when the given variable
 /// declaration value is an identifier. Works only for constant variable declarations.
@@ -33,4 +37,12 @@ VariableDeclaration const* rootConstVariableDeclaration(VariableDeclaration cons
 /// Returns true if the constant variable declaration is recursive.
 bool isConstantVariableRecursive(VariableDeclaration const& _varDecl);
 
+/// @returns the call if @a _expression is a call to ``abi.encodePacked`` or ``bytes.concat``,
+/// i.e. to a function that concatenates the packed encodings of its arguments.
+/// Returns nullptr otherwise.
+FunctionCall const* packedEncodingCall(Expression const& _expression);
+
+/// @returns the result of the packed encoding call @a _call if all its arguments are string literals.
+std::optional<std::string> constantPackedEncoding(FunctionCall const& _call);
+
 }
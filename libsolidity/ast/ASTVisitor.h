@@ -325,4 +325,113 @@ private:
 	std::function<void(ASTNode const&)> m_onEndVisit;
 };
 
+/**
+ * Visitor that forwards all nodes to several visitors, so that they run in a single walk of the AST.
+ * Each visitor receives the same calls as if it visited the AST alone: If its visit function
+ * returns false, it does not receive the calls for the children of the node, but the other
+ * visitors still do. The visitors are called in the given order for each node.
+ */
+class FusedASTVisitor: public ASTConstVisitor
+{
+public:
+	explicit FusedASTVisitor(std::vector<ASTConstVisitor*> _visitors):
+		m_visitors(std::move(_visitors)),
+		m_skippedAtDepth(m_visitors.size(), 0)
+	{}
+
+#define SOLIDITY_FUSED_VISIT(NodeType) \
+	bool visit(NodeType const& _node) override { return forwardVisit(_node); } \
+	void endVisit(NodeType const& _node) override { forwardEndVisit(_node); }
+	SOLIDITY_FUSED_VISIT(SourceUnit)
+	SOLIDITY_FUSED_VISIT(PragmaDirective)
+	SOLIDITY_FUSED_VISIT(ImportDirective)
+	SOLIDITY_FUSED_VISIT(ContractDefinition)
+	SOLIDITY_FUSED_VISIT(IdentifierPath)
+	SOLIDITY_FUSED_VISIT(InheritanceSpecifier)
+	SOLIDITY_FUSED_VISIT(StructDefinition)
+	SOLIDITY_FUSED_VISIT(UsingForDirective)
+	SOLIDITY_FUSED_VISIT(EnumDefinition)
+	SOLIDITY_FUSED_VISIT(EnumValue)
+	SOLIDITY_FUSED_VISIT(ParameterList)
+	SOLIDITY_FUSED_VISIT(OverrideSpecifier)
+	SOLIDITY_FUSED_VISIT(FunctionDefinition)
+	SOLIDITY_FUSED_VISIT(VariableDeclaration)
+	SOLIDITY_FUSED_VISIT(ModifierDefinition)
+	SOLIDITY_FUSED_VISIT(ModifierInvocation)
+	SOLIDITY_FUSED_VISIT(EventDefinition)
+	SOLIDITY_FUSED_VISIT(ErrorDefinition)
+	SOLIDITY_FUSED_VISIT(ElementaryTypeName)
+	SOLIDITY_FUSED_VISIT(UserDefinedTypeName)
+	SOLIDITY_FUSED_VISIT(FunctionTypeName)
+	SOLIDITY_FUSED_VISIT(Mapping)
+	SOLIDITY_FUSED_VISIT(ArrayTypeName)
+	SOLIDITY_FUSED_VISIT(Block)
+	SOLIDITY_FUSED_VISIT(PlaceholderStatement)
+	SOLIDITY_FUSED_VISIT(IfStatement)
+	SOLIDITY_FUSED_VISIT(TryCatchClause)
+	SOLIDITY_FUSED_VISIT(TryStatement)
+	SOLIDITY_FUSED_VISIT(WhileStatement)
+	SOLIDITY_FUSED_VISIT(ForStatement)
+	SOLIDITY_FUSED_VISIT(Continue)
+	SOLIDITY_FUSED_VISIT(InlineAssembly)
+	SOLIDITY_FUSED_VISIT(Break)
+	SOLIDITY_FUSED_VISIT(Return)
+	SOLIDITY_FUSED_VISIT(Throw)
+	SOLIDITY_FUSED_VISIT(EmitStatement)
+	SOLIDITY_FUSED_VISIT(RevertStatement)
+	SOLIDITY_FUSED_VISIT(VariableDeclarationStatement)
+	SOLIDITY_FUSED_VISIT(ExpressionStatement)
+	SOLIDITY_FUSED_VISIT(Conditional)
+	SOLIDITY_FUSED_VISIT(Assignment)
+	SOLIDITY_FUSED_VISIT(TupleExpression)
+	SOLIDITY_FUSED_VISIT(UnaryOperation)
+	SOLIDITY_FUSED_VISIT(BinaryOperation)
+	SOLIDITY_FUSED_VISIT(FunctionCall)
+	SOLIDITY_FUSED_VISIT(FunctionCallOptions)
+	SOLIDITY_FUSED_VISIT(NewExpression)
+	SOLIDITY_FUSED_VISIT(MemberAccess)
+	SOLIDITY_FUSED_VISIT(IndexAccess)
+	SOLIDITY_FUSED_VISIT(IndexRangeAccess)
+	SOLIDITY_FUSED_VISIT(Identifier)
+	SOLIDITY_FUSED_VISIT(ElementaryTypeNameExpression)
+	SOLIDITY_FUSED_VISIT(Literal)
+	SOLIDITY_FUSED_VISIT(StructuredDocumentation)
+#undef SOLIDITY_FUSED_VISIT
+
+private:
+	template <class Node>
+	bool forwardVisit(Node const& _node)
+	{
+		++m_depth;
+		bool visitChildren = false;
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (m_skippedAtDepth[i] == 0)
+			{
+				if (m_visitors[i]->visit(_node))
+					visitChildren = true;
+				else
+					m_skippedAtDepth[i] = m_depth;
+			}
+		return visitChildren;
+	}
+
+	template <class Node>
+	void forwardEndVisit(Node const& _node)
+	{
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (m_skippedAtDepth[i] == 0 || m_skippedAtDepth[i] == m_depth)
+			{
+				m_skippedAtDepth[i] = 0;
+				m_visitors[i]->endVisit(_node);
+			}
+		--m_depth;
+	}
+
+	std::vector<ASTConstVisitor*> m_visitors;
+	/// Depth of the node whose children are not visited by the visitor of the same index,
+	/// zero if the visitor receives all nodes.
+	std::vector<size_t> m_skippedAtDepth;
+	size_t m_depth = 0;
+};
+
 }
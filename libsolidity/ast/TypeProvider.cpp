@@ -175,6 +175,16 @@ inline void clearCaches(Container& container)
 }
 
 void TypeProvider::reset()
+{
+	clearMemberCaches();
+
+	instance().m_generalTypes.clear();
+	instance().m_stringLiteralTypes.clear();
+	instance().m_ufixedMxN.clear();
+	instance().m_fixedMxN.clear();
+}
+
+void TypeProvider::clearMemberCaches()
 {
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
@@ -190,11 +200,28 @@ void TypeProvider::reset()
 	clearCaches(instance().m_uintM);
 	clearCaches(instance().m_bytesM);
 	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	clearCaches(instance().m_generalTypes);
+	for (auto const& type: instance().m_stringLiteralTypes)
+		clearCache(type.second);
+	for (auto const& type: instance().m_ufixedMxN)
+		clearCache(type.second);
+	for (auto const& type: instance().m_fixedMxN)
+		clearCache(type.second);
+
+	instance().m_declarationFunctionTypes.clear();
+	instance().m_functionTypes.clear();
+	instance().m_functionTypesFromStrings.clear();
+	instance().m_tupleTypes.clear();
+	instance().m_typesWithLocation.clear();
+	instance().m_arrayTypes.clear();
+	instance().m_arraySliceTypes.clear();
+	instance().m_mappingTypes.clear();
+	instance().m_rationalNumberTypes.clear();
+	instance().m_literalRationalNumberTypes.clear();
+	instance().m_contractTypes.clear();
+	instance().m_structTypes.clear();
+	instance().m_typeTypes.clear();
+	instance().m_metaTypes.clear();
 }
 
 template <typename T, typename... Args>
@@ -204,6 +231,19 @@ inline T const* TypeProvider::createAndGet(Args&& ... _args)
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename Key, typename... Args>
+inline T const* TypeProvider::createAndGetUnique(
+	map<Key, T const*>& _types,
+	typename map<Key, T const*>::key_type _key,
+	Args&& ... _args
+)
+{
+	auto [it, inserted] = _types.try_emplace(move(_key), nullptr);
+	if (inserted)
+		it->second = createAndGet<T>(std::forward<Args>(_args)...);
+	return it->second;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -360,6 +400,13 @@ Type const* TypeProvider::forLiteral(Literal const& _literal)
 RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 {
 	solAssert(_literal.token() == Token::Number, "");
+	auto [it, inserted] = instance().m_literalRationalNumberTypes.emplace(
+		make_pair(_literal.value(), static_cast<Token>(_literal.subDenomination())),
+		nullptr
+	);
+	if (!inserted)
+		return it->second;
+
 	std::tuple<bool, rational> validLiteral = RationalNumberType::isValidLiteral(_literal);
 	if (std::get<0>(validLiteral))
 	{
@@ -371,9 +418,9 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 				compatibleBytesType = fixedBytes(static_cast<unsigned>(digitCount / 2));
 		}
 
-		return rationalNumber(std::get<1>(validLiteral), compatibleBytesType);
+		it->second = rationalNumber(std::get<1>(validLiteral), compatibleBytesType);
 	}
-	return nullptr;
+	return it->second;
 }
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
@@ -404,7 +451,7 @@ TupleType const* TypeProvider::tuple(vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetUnique(instance().m_tupleTypes, members, members);
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,33 +459,54 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	auto [it, inserted] = instance().m_typesWithLocation.try_emplace(make_tuple(_type, _location, _isPointer), nullptr);
+	if (inserted)
+	{
+		instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
+		it->second = static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	}
+	return it->second;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
 {
-	return createAndGet<FunctionType>(_function, _kind);
+	return createAndGetUnique(instance().m_declarationFunctionTypes, make_pair(&_function, _kind), _function, _kind);
 }
 
 FunctionType const* TypeProvider::function(VariableDeclaration const& _varDecl)
 {
-	return createAndGet<FunctionType>(_varDecl);
+	return createAndGetUnique(
+		instance().m_declarationFunctionTypes,
+		make_pair(&_varDecl, FunctionType::Kind::Declaration),
+		_varDecl
+	);
 }
 
 FunctionType const* TypeProvider::function(EventDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return createAndGetUnique(
+		instance().m_declarationFunctionTypes,
+		make_pair(&_def, FunctionType::Kind::Declaration),
+		_def
+	);
 }
 
 FunctionType const* TypeProvider::function(ErrorDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return createAndGetUnique(
+		instance().m_declarationFunctionTypes,
+		make_pair(&_def, FunctionType::Kind::Declaration),
+		_def
+	);
 }
 
 FunctionType const* TypeProvider::function(FunctionTypeName const& _typeName)
 {
-	return createAndGet<FunctionType>(_typeName);
+	return createAndGetUnique(
+		instance().m_declarationFunctionTypes,
+		make_pair(&_typeName, FunctionType::Kind::Declaration),
+		_typeName
+	);
 }
 
 FunctionType const* TypeProvider::function(
@@ -449,7 +517,9 @@ FunctionType const* TypeProvider::function(
 	StateMutability _stateMutability
 )
 {
-	return createAndGet<FunctionType>(
+	return createAndGetUnique(
+		instance().m_functionTypesFromStrings,
+		make_tuple(_parameterTypes, _returnParameterTypes, _kind, _arbitraryParameters, _stateMutability),
 		_parameterTypes, _returnParameterTypes,
 		_kind, _arbitraryParameters, _stateMutability
 	);
@@ -470,11 +540,26 @@ FunctionType const* TypeProvider::function(
 	bool _saltSet
 )
 {
-	return createAndGet<FunctionType>(
+	return createAndGetUnique(
+		instance().m_functionTypes,
+		make_tuple(
+			_parameterTypes,
+			_returnParameterTypes,
+			_parameterNames,
+			_returnParameterNames,
+			_kind,
+			_arbitraryParameters,
+			_stateMutability,
+			_declaration,
+			_gasSet,
+			_valueSet,
+			_bound,
+			_saltSet
+		),
 		_parameterTypes,
 		_returnParameterTypes,
-		_parameterNames,
-		_returnParameterNames,
+		move(_parameterNames),
+		move(_returnParameterNames),
 		_kind,
 		_arbitraryParameters,
 		_stateMutability,
@@ -488,7 +573,12 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	return createAndGetUnique(
+		instance().m_rationalNumberTypes,
+		make_pair(_value, _compatibleBytesType),
+		_value,
+		_compatibleBytesType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -507,27 +597,43 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetUnique(
+		instance().m_arrayTypes,
+		make_tuple(_location, _isString, static_cast<Type const*>(nullptr), optional<u256>{}),
+		_location,
+		_isString
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetUnique(
+		instance().m_arrayTypes,
+		make_tuple(_location, false, _baseType, optional<u256>{}),
+		_location,
+		_baseType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetUnique(
+		instance().m_arrayTypes,
+		make_tuple(_location, false, _baseType, optional<u256>{_length}),
+		_location,
+		_baseType,
+		_length
+	);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createAndGetUnique(instance().m_arraySliceTypes, &_arrayType, _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createAndGetUnique(instance().m_contractTypes, make_pair(&_contractDef, _isSuper), _contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
@@ -542,12 +648,12 @@ ModuleType const* TypeProvider::module(SourceUnit const& _source)
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createAndGetUnique(instance().m_typeTypes, _actualType, _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createAndGetUnique(instance().m_structTypes, make_pair(&_struct, _location), _struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
@@ -570,10 +676,10 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return createAndGetUnique(instance().m_metaTypes, _type, _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGetUnique(instance().m_mappingTypes, make_pair(_keyType, _valueType), _keyType, _valueType);
 }
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
 
 namespace solidity::frontend
@@ -52,6 +53,15 @@ public:
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// Clears the member caches of all types provided so far, which are keyed by AST nodes,
+	/// and forgets which arguments the types were created from, since these can be AST nodes as well.
+	/// Has to be called after AST nodes were destroyed without resetting the provider.
+	static void clearMemberCaches();
+
+	/// @returns the number of types created since the last reset that are not
+	/// elementary types or string literal types.
+	static size_t generalTypeCount() { return instance().m_generalTypes.size(); }
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -212,6 +222,15 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
+	/// Creates a type from @a _args, unless a type was already created for the same @a _key.
+	/// In that case, the existing type is returned, so that each type exists only once.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* createAndGetUnique(
+		std::map<Key, T const*>& _types,
+		typename std::map<Key, T const*>::key_type _key,
+		Args&& ... _args
+	);
+
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
 
@@ -234,6 +253,29 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// The types in m_generalTypes, keyed by the arguments of the factory functions they were created by.
+	using FunctionTypeKey = std::tuple<
+		TypePointers, TypePointers, strings, strings, FunctionType::Kind, bool, StateMutability,
+		Declaration const*, bool, bool, bool, bool
+	>;
+	using FunctionTypeFromStringsKey = std::tuple<strings, strings, FunctionType::Kind, bool, StateMutability>;
+	std::map<std::pair<ASTNode const*, FunctionType::Kind>, FunctionType const*> m_declarationFunctionTypes{};
+	std::map<FunctionTypeKey, FunctionType const*> m_functionTypes{};
+	std::map<FunctionTypeFromStringsKey, FunctionType const*> m_functionTypesFromStrings{};
+	std::map<std::vector<Type const*>, TupleType const*> m_tupleTypes{};
+	std::map<std::tuple<ReferenceType const*, DataLocation, bool>, ReferenceType const*> m_typesWithLocation{};
+	std::map<std::tuple<DataLocation, bool, Type const*, std::optional<u256>>, ArrayType const*> m_arrayTypes{};
+	std::map<ArrayType const*, ArraySliceType const*> m_arraySliceTypes{};
+	std::map<std::pair<Type const*, Type const*>, MappingType const*> m_mappingTypes{};
+	std::map<std::pair<rational, Type const*>, RationalNumberType const*> m_rationalNumberTypes{};
+	/// Types of number literals by their spelling and sub-denomination, null for invalid literals.
+	/// Saves parsing the same literal, which can involve large powers of ten, over and over again.
+	std::map<std::pair<std::string, Token>, RationalNumberType const*> m_literalRationalNumberTypes{};
+	std::map<std::pair<ContractDefinition const*, bool>, ContractType const*> m_contractTypes{};
+	std::map<std::pair<StructDefinition const*, DataLocation>, StructType const*> m_structTypes{};
+	std::map<Type const*, TypeType const*> m_typeTypes{};
+	std::map<Type const*, MagicType const*> m_metaTypes{};
 };
 
 }
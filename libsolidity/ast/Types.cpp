@@ -125,8 +125,11 @@ MemberList::Member::Member(Declaration const* _declaration, Type const* _type, s
 void Type::clearCache() const
 {
 	m_members.clear();
+	m_memberLists.clear();
 	m_stackItems.reset();
 	m_stackSize.reset();
+	m_richIdentifier.reset();
+	m_identifier.reset();
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -174,6 +177,8 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	m_storageOffsets = {};
+	m_memberIndicesByName = {};
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
@@ -191,6 +196,18 @@ u256 const& MemberList::storageSize() const
 	return storageOffsets().storageSize();
 }
 
+vector<size_t> const* MemberList::memberIndices(string const& _name) const
+{
+	auto const& indices = m_memberIndicesByName.init([&]{
+		map<string_view, vector<size_t>> indicesByName;
+		for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
+			indicesByName[member.name].push_back(index);
+		return indicesByName;
+	});
+	auto it = indices.find(_name);
+	return it == indices.end() ? nullptr : &it->second;
+}
+
 StorageOffsets const& MemberList::storageOffsets() const {
 	return m_storageOffsets.init([&]{
 		TypePointers memberTypes;
@@ -261,15 +278,19 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::identifier() const
 {
+	if (m_identifier)
+		return *m_identifier;
+
 	string ret = escapeIdentifier(richIdentifier());
 	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
 	solAssert(
 		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
 		"Identifier contains invalid characters."
 	);
-	return ret;
+	m_identifier = move(ret);
+	return *m_identifier;
 }
 
 Type const* Type::commonType(Type const* _a, Type const* _b)
@@ -286,19 +307,30 @@ Type const* Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
-	if (!m_members[_currentScope])
+	MemberList const*& memberList = m_members[_currentScope];
+	if (!memberList)
 	{
 		solAssert(
 			_currentScope == nullptr ||
 			dynamic_cast<SourceUnit const*>(_currentScope) ||
 			dynamic_cast<ContractDefinition const*>(_currentScope),
 		"");
-		MemberList::MemberMap members = nativeMembers(_currentScope);
+		vector<UsingForDirective const*> directives;
 		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = make_unique<MemberList>(move(members));
+			directives = usingForDirectives(*_currentScope);
+		unique_ptr<MemberList>& sharedList = m_memberLists[{
+			nativeMembersDependOnScope() ? _currentScope : nullptr,
+			directives
+		}];
+		if (!sharedList)
+		{
+			MemberList::MemberMap members = nativeMembers(_currentScope);
+			members += boundFunctions(*this, directives);
+			sharedList = make_unique<MemberList>(move(members));
+		}
+		memberList = sharedList.get();
 	}
-	return *m_members[_currentScope];
+	return *memberList;
 }
 
 Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -328,7 +360,7 @@ Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) c
 	return encodingType;
 }
 
-MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _scope)
+vector<UsingForDirective const*> Type::usingForDirectives(ASTNode const& _scope)
 {
 	vector<UsingForDirective const*> usingForDirectives;
 	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_scope))
@@ -339,7 +371,11 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 			ASTNode::filteredNodes<UsingForDirective>(contract->sourceUnit().nodes());
 	else
 		solAssert(false, "");
+	return usingForDirectives;
+}
 
+MemberList::MemberMap Type::boundFunctions(Type const& _type, vector<UsingForDirective const*> const& _usingForDirectives)
+{
 	// Normalise data location of type.
 	DataLocation typeLocation = DataLocation::Storage;
 	if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
@@ -348,7 +384,7 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 	set<Declaration const*> seenFunctions;
 	MemberList::MemberMap members;
 
-	for (UsingForDirective const* ufd: usingForDirectives)
+	for (UsingForDirective const* ufd: _usingForDirectives)
 	{
 		// Convert both types to pointers for comparison to see if the `using for`
 		// directive applies.
@@ -389,7 +425,7 @@ AddressType::AddressType(StateMutability _stateMutability):
 	solAssert(m_stateMutability == StateMutability::Payable || m_stateMutability == StateMutability::NonPayable, "");
 }
 
-string AddressType::richIdentifier() const
+string AddressType::makeRichIdentifier() const
 {
 	if (m_stateMutability == StateMutability::Payable)
 		return "t_address_payable";
@@ -511,7 +547,7 @@ IntegerType::IntegerType(unsigned _bits, IntegerType::Modifier _modifier):
 	);
 }
 
-string IntegerType::richIdentifier() const
+string IntegerType::makeRichIdentifier() const
 {
 	return "t_" + string(isSigned() ? "" : "u") + "int" + to_string(numBits());
 }
@@ -678,7 +714,7 @@ FixedPointType::FixedPointType(unsigned _totalBits, unsigned _fractionalDigits,
 	);
 }
 
-string FixedPointType::richIdentifier() const
+string FixedPointType::makeRichIdentifier() const
 {
 	return "t_" + string(isSigned() ? "" : "u") + "fixed" + to_string(m_totalBits) + "x" + to_string(m_fractionalDigits);
 }
@@ -1034,19 +1070,32 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 			return nullptr;
 		return thisMobile->binaryOperatorResult(_operator, otherMobile);
 	}
-	else if (optional<rational> value = ConstantEvaluator::evaluateBinaryOperator(_operator, m_value, other.m_value))
+
+	auto cached = m_binaryOperatorResults.find({_operator, &other});
+	if (cached != m_binaryOperatorResults.end())
+		return cached->second;
+
+	TypeResult result = nullptr;
+	if (optional<rational> value = ConstantEvaluator::evaluateBinaryOperator(_operator, m_value, other.m_value))
 	{
 		// verify that numerator and denominator fit into 4096 bit after every operation
 		if (value->numerator() != 0 && max(boost::multiprecision::msb(abs(value->numerator())), boost::multiprecision::msb(abs(value->denominator()))) > 4096)
-			return TypeResult::err("Precision of rational constants is limited to 4096 bits.");
-
-		return TypeResult{TypeProvider::rationalNumber(*value)};
+			result = TypeResult::err("Precision of rational constants is limited to 4096 bits.");
+		else
+			result = TypeResult{TypeProvider::rationalNumber(*value)};
 	}
-	else
-		return nullptr;
+	m_binaryOperatorResults.emplace(make_pair(_operator, &other), result);
+	return result;
+}
+
+void RationalNumberType::clearCache() const
+{
+	Type::clearCache();
+
+	m_binaryOperatorResults.clear();
 }
 
-string RationalNumberType::richIdentifier() const
+string RationalNumberType::makeRichIdentifier() const
 {
 	// rational seemingly will put the sign always on the numerator,
 	// but let just make it deterministic here.
@@ -1214,7 +1263,7 @@ BoolResult StringLiteralType::isImplicitlyConvertibleTo(Type const& _convertTo)
 		return false;
 }
 
-string StringLiteralType::richIdentifier() const
+string StringLiteralType::makeRichIdentifier() const
 {
 	// Since we have to return a valid identifier and the string itself may contain
 	// anything, we hash it.
@@ -1319,7 +1368,7 @@ MemberList::MemberMap FixedBytesType::nativeMembers(ASTNode const*) const
 	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::uint(8)}};
 }
 
-string FixedBytesType::richIdentifier() const
+string FixedBytesType::makeRichIdentifier() const
 {
 	return "t_bytes" + to_string(m_bytes);
 }
@@ -1581,7 +1630,7 @@ BoolResult ArrayType::isExplicitlyConvertibleTo(Type const& _convertTo) const
 	return true;
 }
 
-string ArrayType::richIdentifier() const
+string ArrayType::makeRichIdentifier() const
 {
 	string id;
 	if (isString())
@@ -1936,7 +1985,7 @@ BoolResult ArraySliceType::isExplicitlyConvertibleTo(Type const& _convertTo) con
 		m_arrayType.isExplicitlyConvertibleTo(_convertTo);
 }
 
-string ArraySliceType::richIdentifier() const
+string ArraySliceType::makeRichIdentifier() const
 {
 	return m_arrayType.richIdentifier() + "_slice";
 }
@@ -1971,7 +2020,7 @@ std::vector<std::tuple<std::string, Type const*>> ArraySliceType::makeStackItems
 	return {{"offset", TypeProvider::uint256()}, {"length", TypeProvider::uint256()}};
 }
 
-string ContractType::richIdentifier() const
+string ContractType::makeRichIdentifier() const
 {
 	return (m_super ? "t_super" : "t_contract") + parenthesizeUserIdentifier(m_contract.name()) + to_string(m_contract.id());
 }
@@ -2085,7 +2134,7 @@ BoolResult StructType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 	return this->m_struct == convertTo.m_struct;
 }
 
-string StructType::richIdentifier() const
+string StructType::makeRichIdentifier() const
 {
 	return "t_struct" + parenthesizeUserIdentifier(m_struct.name()) + to_string(m_struct.id()) + identifierLocationSuffix();
 }
@@ -2478,7 +2527,7 @@ TypeResult EnumType::unaryOperatorResult(Token _operator) const
 	return _operator == Token::Delete ? TypeProvider::emptyTuple() : nullptr;
 }
 
-string EnumType::richIdentifier() const
+string EnumType::makeRichIdentifier() const
 {
 	return "t_enum" + parenthesizeUserIdentifier(m_enum.name()) + to_string(m_enum.id());
 }
@@ -2553,7 +2602,7 @@ BoolResult TupleType::isImplicitlyConvertibleTo(Type const& _other) const
 		return false;
 }
 
-string TupleType::richIdentifier() const
+string TupleType::makeRichIdentifier() const
 {
 	return "t_tuple" + identifierList(components());
 }
@@ -2859,7 +2908,7 @@ TypePointers const& FunctionType::parameterTypesIncludingSelf() const
 	return m_parameterTypes;
 }
 
-string FunctionType::richIdentifier() const
+string FunctionType::makeRichIdentifier() const
 {
 	string id = "t_function_";
 	switch (m_kind)
@@ -3402,8 +3451,11 @@ bool FunctionType::isBareCall() const
 	}
 }
 
-string FunctionType::externalSignature() const
+string const& FunctionType::externalSignature() const
 {
+	if (m_externalSignature)
+		return *m_externalSignature;
+
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
 	solAssert(!m_declaration->name().empty(), "Fallback function has no signature.");
 	switch (kind())
@@ -3437,7 +3489,15 @@ string FunctionType::externalSignature() const
 			typeName += " storage";
 		return typeName;
 	});
-	return m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	m_externalSignature = m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	return *m_externalSignature;
+}
+
+void FunctionType::clearCache() const
+{
+	Type::clearCache();
+
+	m_externalSignature.reset();
 }
 
 u256 FunctionType::externalIdentifier() const
@@ -3605,7 +3665,7 @@ Type const* MappingType::encodingType() const
 	return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 }
 
-string MappingType::richIdentifier() const
+string MappingType::makeRichIdentifier() const
 {
 	return "t_mapping" + identifierList(m_keyType, m_valueType);
 }
@@ -3651,7 +3711,7 @@ TypeResult MappingType::interfaceType(bool _inLibrary) const
 	return this;
 }
 
-string TypeType::richIdentifier() const
+string TypeType::makeRichIdentifier() const
 {
 	return "t_type" + identifierList(actualType());
 }
@@ -3794,7 +3854,7 @@ u256 ModifierType::storageSize() const
 	solAssert(false, "Storage size of non-storable type type requested.");
 }
 
-string ModifierType::richIdentifier() const
+string ModifierType::makeRichIdentifier() const
 {
 	return "t_modifier" + identifierList(m_parameterTypes);
 }
@@ -3827,7 +3887,7 @@ string ModifierType::toString(bool _short) const
 	return name + ")";
 }
 
-string ModuleType::richIdentifier() const
+string ModuleType::makeRichIdentifier() const
 {
 	return "t_module_" + to_string(m_sourceUnit.id());
 }
@@ -3853,7 +3913,7 @@ string ModuleType::toString(bool) const
 	return string("module \"") + *m_sourceUnit.annotation().path + string("\"");
 }
 
-string MagicType::richIdentifier() const
+string MagicType::makeRichIdentifier() const
 {
 	switch (m_kind)
 	{
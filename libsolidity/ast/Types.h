@@ -40,6 +40,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace solidity::frontend
@@ -123,21 +124,18 @@ public:
 	void combine(MemberList const& _other);
 	Type const* memberType(std::string const& _name) const
 	{
-		Type const* type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
+		std::vector<size_t> const* indices = memberIndices(_name);
+		if (!indices)
+			return nullptr;
+		solAssert(indices->size() == 1, "Requested member type by non-unique name.");
+		return m_memberTypes[indices->front()].type;
 	}
 	MemberMap membersByName(std::string const& _name) const
 	{
 		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
+		if (std::vector<size_t> const* indices = memberIndices(_name))
+			for (size_t index: *indices)
+				members.push_back(m_memberTypes[index]);
 		return members;
 	}
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
@@ -151,9 +149,15 @@ public:
 
 private:
 	StorageOffsets const& storageOffsets() const;
+	/// @returns the indices of the members called @a _name in m_memberTypes, in order,
+	/// or nullptr if there is no such member.
+	std::vector<size_t> const* memberIndices(std::string const& _name) const;
 
 	MemberMap m_memberTypes;
 	util::LazyInit<StorageOffsets> m_storageOffsets;
+	/// Indices of the members by name, so that member access does not have to compare the
+	/// name of every member. The keys refer to the names in m_memberTypes.
+	util::LazyInit<std::map<std::string_view, std::vector<size_t>>> m_memberIndicesByName;
 };
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
@@ -187,12 +191,17 @@ public:
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Can contain characters which are invalid in identifiers.
-	virtual std::string richIdentifier() const = 0;
+	std::string const& richIdentifier() const
+	{
+		if (!m_richIdentifier)
+			m_richIdentifier = makeRichIdentifier();
+		return *m_richIdentifier;
+	}
 	/// @returns a valid solidity identifier such that two types should compare equal if and
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	std::string const& identifier() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -372,16 +381,23 @@ public:
 	virtual void clearCache() const;
 
 private:
-	/// @returns a member list containing all members added to this type by `using for` directives.
-	static MemberList::MemberMap boundFunctions(Type const& _type, ASTNode const& _scope);
+	/// @returns the `using for` directives that are in effect in @a _scope.
+	static std::vector<UsingForDirective const*> usingForDirectives(ASTNode const& _scope);
+	/// @returns a member list containing all members added to this type by the `using for` directives.
+	static MemberList::MemberMap boundFunctions(Type const& _type, std::vector<UsingForDirective const*> const& _usingForDirectives);
 
 protected:
+	/// Generates the identifier returned by ``richIdentifier()``.
+	virtual std::string makeRichIdentifier() const = 0;
 	/// @returns the members native to this type depending on the given context. This function
 	/// is used (in conjunction with boundFunctions to fill m_members below.
 	virtual MemberList::MemberMap nativeMembers(ASTNode const* /*_currentScope*/) const
 	{
 		return MemberList::MemberMap();
 	}
+	/// @returns true if the result of nativeMembers depends on the scope. Otherwise all scopes
+	/// with the same `using for` directives share the same member list.
+	virtual bool nativeMembersDependOnScope() const { return false; }
 	/// Generates the stack items to be returned by ``stackItems()``. Defaults
 	/// to exactly one unnamed and untyped stack item referring to a single stack slot.
 	virtual std::vector<std::tuple<std::string, Type const*>> makeStackItems() const
@@ -391,9 +407,17 @@ protected:
 
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
+	mutable std::map<ASTNode const*, MemberList const*> m_members;
+	/// The member lists referenced by m_members, keyed by the `using for` directives in effect
+	/// and by the scope if the native members depend on it.
+	mutable std::map<
+		std::pair<ASTNode const*, std::vector<UsingForDirective const*>>,
+		std::unique_ptr<MemberList>
+	> m_memberLists;
 	mutable std::optional<std::vector<std::tuple<std::string, Type const*>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+	mutable std::optional<std::string> m_richIdentifier;
+	mutable std::optional<std::string> m_identifier;
 };
 
 /**
@@ -406,7 +430,6 @@ public:
 
 	Category category() const override { return Category::Address; }
 
-	std::string richIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -432,6 +455,8 @@ public:
 
 	StateMutability stateMutability(void) const { return m_stateMutability; }
 
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	StateMutability m_stateMutability;
 };
@@ -451,7 +476,6 @@ public:
 
 	Category category() const override { return Category::Integer; }
 
-	std::string richIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -479,6 +503,8 @@ public:
 	bigint minValue() const;
 	bigint maxValue() const;
 
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	unsigned const m_bits;
 	Modifier const m_modifier;
@@ -498,7 +524,6 @@ public:
 	explicit FixedPointType(unsigned _totalBits, unsigned _fractionalDigits, Modifier _modifier = Modifier::Unsigned);
 	Category category() const override { return Category::FixedPoint; }
 
-	std::string richIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -532,6 +557,8 @@ public:
 	/// @returns the smallest integer type that can hold this type with fractional parts shifted to integers.
 	IntegerType const* asIntegerType() const;
 
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	unsigned m_totalBits;
 	unsigned m_fractionalDigits;
@@ -557,7 +584,6 @@ public:
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
 
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 
 	bool canBeStored() const override { return false; }
@@ -590,6 +616,10 @@ public:
 	/// @returns true if the literal is a valid integer.
 	static std::tuple<bool, rational> isValidLiteral(Literal const& _literal);
 
+	void clearCache() const override;
+
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	rational m_value;
 
@@ -597,6 +627,10 @@ private:
 	/// Empty for all rationals that are not directly parsed from hex literals.
 	Type const* m_compatibleBytesType;
 
+	/// Results of arithmetic with other rational number types, which are requested repeatedly
+	/// for the same constants and can involve large powers.
+	mutable std::map<std::pair<Token, RationalNumberType const*>, TypeResult> m_binaryOperatorResults;
+
 	/// @returns true if the literal is a valid rational number.
 	static std::tuple<bool, rational> parseRational(std::string const& _value);
 
@@ -622,7 +656,6 @@ public:
 		return nullptr;
 	}
 
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 
 	bool canBeStored() const override { return false; }
@@ -633,6 +666,7 @@ public:
 	std::string const& value() const { return m_value; }
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override { return {}; }
 private:
 	std::string m_value;
@@ -650,7 +684,6 @@ public:
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
@@ -668,6 +701,8 @@ public:
 
 	unsigned numBytes() const { return m_bytes; }
 
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	unsigned m_bytes;
 };
@@ -679,7 +714,6 @@ class BoolType: public Type
 {
 public:
 	Category category() const override { return Category::Bool; }
-	std::string richIdentifier() const override { return "t_bool"; }
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
 
@@ -693,6 +727,9 @@ public:
 	u256 literalValue(Literal const* _literal) const override;
 	Type const* encodingType() const override { return this; }
 	TypeResult interfaceType(bool) const override { return this; }
+
+protected:
+	std::string makeRichIdentifier() const override { return "t_bool"; }
 };
 
 /**
@@ -815,7 +852,6 @@ public:
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
 	unsigned calldataEncodedTailSize() const override;
@@ -857,6 +893,7 @@ public:
 	void clearCache() const override;
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 	std::vector<Type const*> decomposition() const override { return {m_baseType}; }
 
@@ -883,7 +920,6 @@ public:
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override { solAssert(false, ""); }
 	unsigned calldataEncodedTailSize() const override { return 32; }
@@ -900,6 +936,7 @@ public:
 	std::unique_ptr<ReferenceType> copyForLocation(DataLocation, bool) const override { solAssert(false, ""); }
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 	std::vector<Type const*> decomposition() const override { return {m_arrayType.baseType()}; }
 
@@ -922,7 +959,6 @@ public:
 	/// Contracts can only be explicitly converted to address types and base contracts.
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool _padded ) const override
 	{
@@ -965,6 +1001,7 @@ public:
 	/// @returns a list of all immutable variables (including inherited) of the contract.
 	std::vector<VariableDeclaration const*> immutableVariables() const;
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 private:
 	ContractDefinition const& m_contract;
@@ -985,7 +1022,6 @@ public:
 
 	Category category() const override { return Category::Struct; }
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
 	unsigned calldataEncodedTailSize() const override;
@@ -1027,6 +1063,7 @@ public:
 	void clearCache() const override;
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 	std::vector<Type const*> decomposition() const override;
 
@@ -1047,7 +1084,6 @@ public:
 
 	Category category() const override { return Category::Enum; }
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool _padded) const override
 	{
@@ -1072,6 +1108,8 @@ public:
 	unsigned int memberValue(ASTString const& _member) const;
 	size_t numberOfMembers() const;
 
+protected:
+	std::string makeRichIdentifier() const override;
 private:
 	EnumDefinition const& m_enum;
 };
@@ -1088,7 +1126,6 @@ public:
 	Category category() const override { return Category::Tuple; }
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	std::string toString(bool) const override;
@@ -1100,6 +1137,7 @@ public:
 	std::vector<Type const*> const& components() const { return m_components; }
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 	std::vector<Type const*> decomposition() const override
 	{
@@ -1255,7 +1293,6 @@ public:
 	/// @returns the "self" parameter type for a bound function
 	Type const* selfType() const;
 
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
@@ -1272,6 +1309,7 @@ public:
 	bool nameable() const override;
 	bool hasSimpleZeroValueInMemory() const override { return false; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return true; }
 	Type const* encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 	Type const* mobileType() const override;
@@ -1304,7 +1342,7 @@ public:
 	Kind const& kind() const { return m_kind; }
 	StateMutability stateMutability() const { return m_stateMutability; }
 	/// @returns the external signature of this function type given the function name
-	std::string externalSignature() const;
+	std::string const& externalSignature() const;
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	/// @returns the external identifier of this function (the hash of the signature) as a hex string.
@@ -1367,7 +1405,10 @@ public:
 	/// @param _inLibrary if true, uses DelegateCall as location.
 	FunctionTypePointer asExternallyCallableFunction(bool _inLibrary) const;
 
+	void clearCache() const override;
+
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 private:
 	static TypePointers parseElementaryTypeVector(strings const& _types);
@@ -1387,6 +1428,7 @@ private:
 	bool const m_bound = false;
 	Declaration const* m_declaration = nullptr;
 	bool m_saltSet = false; ///< true iff the salt value to be used is on the stack
+	mutable std::optional<std::string> m_externalSignature;
 };
 
 /**
@@ -1401,7 +1443,6 @@ public:
 
 	Category category() const override { return Category::Mapping; }
 
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	std::string toString(bool _short) const override;
 	std::string canonicalName() const override;
@@ -1418,6 +1459,7 @@ public:
 	Type const* valueType() const { return m_valueType; }
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<Type const*> decomposition() const override { return {m_valueType}; }
 
 private:
@@ -1439,16 +1481,17 @@ public:
 	Type const* actualType() const { return m_actualType; }
 
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	u256 storageSize() const override;
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool _short) const override { return "type(" + m_actualType->toString(_short) + ")"; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return true; }
 
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 private:
 	Type const* m_actualType;
@@ -1469,10 +1512,10 @@ public:
 	bool canBeStored() const override { return false; }
 	u256 storageSize() const override;
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	std::string toString(bool _short) const override;
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override { return {}; }
 private:
 	TypePointers m_parameterTypes;
@@ -1491,7 +1534,6 @@ public:
 	Category category() const override { return Category::Module; }
 
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
@@ -1500,6 +1542,7 @@ public:
 	std::string toString(bool _short) const override;
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override { return {}; }
 private:
 	SourceUnit const& m_sourceUnit;
@@ -1530,7 +1573,6 @@ public:
 		return nullptr;
 	}
 
-	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
@@ -1543,6 +1585,7 @@ public:
 	Type const* typeArgument() const;
 
 protected:
+	std::string makeRichIdentifier() const override;
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override { return {}; }
 private:
 	Kind m_kind;
@@ -1559,7 +1602,6 @@ class InaccessibleDynamicType: public Type
 public:
 	Category category() const override { return Category::InaccessibleDynamic; }
 
-	std::string richIdentifier() const override { return "t_inaccessible"; }
 	BoolResult isImplicitlyConvertibleTo(Type const&) const override { return false; }
 	BoolResult isExplicitlyConvertibleTo(Type const&) const override { return false; }
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
@@ -1569,6 +1611,9 @@ public:
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool) const override { return "inaccessible dynamic type"; }
 	Type const* decodingType() const override;
+
+protected:
+	std::string makeRichIdentifier() const override { return "t_inaccessible"; }
 };
 
 }
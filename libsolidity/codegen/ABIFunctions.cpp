@@ -231,6 +231,26 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 				valueReturnParams.emplace_back("value" + to_string(stackPos));
 				stackPos++;
 			}
+			if (decodingTypes[i]->isValueType() && sizeOnStack == 1)
+			{
+				// Value types are read directly at their fixed offset, the size of the head
+				// has already been checked above.
+				Whiskers valueTempl(
+					"<value> := <load>(add(headStart, <pos>))\n"
+					"<?validate><validator>(<value>)\n</validate>"
+				);
+				valueTempl("value", valueNamesLocal.front());
+				valueTempl("load", _fromMemory ? "mload" : "calldataload");
+				valueTempl("pos", to_string(headPos));
+				// Validation should use the type and not decodingType, because e.g.
+				// the decoding type of an enum is a plain int.
+				bool validate = !YulUtilFunctions::cleanupIsIdentity(*_types[i]);
+				valueTempl("validate", validate);
+				valueTempl("validator", validate ? m_utils.validatorFunction(*_types[i], true) : "");
+				decodeElements += valueTempl.render();
+				headPos += decodingTypes[i]->calldataHeadSize();
+				continue;
+			}
 			Whiskers elementTempl(R"(
 				{
 					<?dynamic>
@@ -349,12 +369,13 @@ string ABIFunctions::abiEncodingFunction(
 	solAssert(_from.sizeOnStack() == 1, "");
 	solAssert(to.isValueType(), "");
 	solAssert(to.calldataEncodedSize() == 32, "");
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 	return createFunction(functionName, [&]() {
 		solAssert(!to.isDynamicallyEncoded(), "");
 
@@ -395,12 +416,13 @@ string ABIFunctions::abiEncodeAndReturnUpdatedPosFunction(
 	ABIFunctions::EncodingOptions const& _options
 )
 {
-	string functionName =
-		"abi_encodeUpdatedPos_" +
-		_givenType.identifier() +
-		"_to_" +
-		_targetType.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encodeUpdatedPos_",
+		_givenType.identifier(),
+		"_to_",
+		_targetType.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 	return createFunction(functionName, [&]() {
 		string values = suffixedVariableNameList("value", 0, numVariablesForType(_givenType, _options));
 		string encoder = abiEncodingFunction(_givenType, _targetType, _options);
@@ -461,12 +483,13 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 		""
 	);
 
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 	return createFunction(functionName, [&]() {
 		bool needsPadding = _options.padded && fromArrayType.isByteArray();
 		if (fromArrayType.isDynamicallySized())
@@ -527,12 +550,13 @@ string ABIFunctions::abiEncodingFunctionSimpleArray(
 	EncodingOptions const& _options
 )
 {
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
 	solAssert(_from.length() == _to.length(), "");
@@ -637,12 +661,13 @@ string ABIFunctions::abiEncodingFunctionMemoryByteArray(
 	EncodingOptions const& _options
 )
 {
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
 	solAssert(_from.length() == _to.length(), "");
@@ -674,12 +699,13 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 	EncodingOptions const& _options
 )
 {
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
 	solAssert(_from.length() == _to.length(), "");
@@ -825,12 +851,13 @@ string ABIFunctions::abiEncodingFunctionStruct(
 	EncodingOptions const& _options
 )
 {
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 
 	solAssert(&_from.structDefinition() == &_to.structDefinition(), "");
 
@@ -973,12 +1000,13 @@ string ABIFunctions::abiEncodingFunctionStringLiteral(
 {
 	solAssert(_from.category() == Type::Category::StringLiteral, "");
 
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 	return createFunction(functionName, [&]() {
 		auto const& strType = dynamic_cast<StringLiteralType const&>(_from);
 		string const& value = strType.value();
@@ -1035,12 +1063,13 @@ string ABIFunctions::abiEncodingFunctionFunctionType(
 		"Invalid function type conversion requested"
 	);
 
-	string functionName =
-		"abi_encode_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier() +
-		_options.toFunctionNameSuffix();
+	string functionName = util::concatenate({
+		"abi_encode_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier(),
+		_options.toFunctionNameSuffix()
+	});
 
 	if (_options.encodeFunctionFromStack)
 		return createFunction(functionName, [&]() {
@@ -1112,10 +1141,11 @@ string ABIFunctions::abiDecodingFunctionValueType(Type const& _type, bool _fromM
 	solAssert(!decodingType->isDynamicallyEncoded(), "");
 	solAssert(decodingType->calldataEncodedSize() == 32, "");
 
-	string functionName =
-		"abi_decode_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "");
+	string functionName = util::concatenate({
+		"abi_decode_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : "")
+	});
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(offset, end) -> value {
@@ -1137,10 +1167,11 @@ string ABIFunctions::abiDecodingFunctionArray(ArrayType const& _type, bool _from
 {
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 
-	string functionName =
-		"abi_decode_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "");
+	string functionName = util::concatenate({
+		"abi_decode_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : "")
+	});
 
 	return createFunction(functionName, [&]() {
 		string load = _fromMemory ? "mload" : "calldataload";
@@ -1171,10 +1202,11 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 	if (_type.isByteArray())
 		return abiDecodingFunctionByteArrayAvailableLength(_type, _fromMemory);
 
-	string functionName =
-		"abi_decode_available_length_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "");
+	string functionName = util::concatenate({
+		"abi_decode_available_length_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : "")
+	});
 
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
@@ -1277,10 +1309,11 @@ string ABIFunctions::abiDecodingFunctionByteArrayAvailableLength(ArrayType const
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	solAssert(_type.isByteArray(), "");
 
-	string functionName =
-		"abi_decode_available_length_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "");
+	string functionName = util::concatenate({
+		"abi_decode_available_length_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : "")
+	});
 
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
@@ -1328,10 +1361,11 @@ string ABIFunctions::abiDecodingFunctionCalldataStruct(StructType const& _type)
 string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fromMemory)
 {
 	solAssert(!_type.dataStoredIn(DataLocation::CallData), "");
-	string functionName =
-		"abi_decode_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "");
+	string functionName = util::concatenate({
+		"abi_decode_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : "")
+	});
 
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
@@ -1394,11 +1428,12 @@ string ABIFunctions::abiDecodingFunctionFunctionType(FunctionType const& _type,
 {
 	solAssert(_type.kind() == FunctionType::Kind::External, "");
 
-	string functionName =
-		"abi_decode_" +
-		_type.identifier() +
-		(_fromMemory ? "_fromMemory" : "") +
-		(_forUseOnStack ? "_onStack" : "");
+	string functionName = util::concatenate({
+		"abi_decode_",
+		_type.identifier(),
+		(_fromMemory ? "_fromMemory" : ""),
+		(_forUseOnStack ? "_onStack" : "")
+	});
 
 	return createFunction(functionName, [&]() {
 		if (_forUseOnStack)
@@ -1535,7 +1570,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 
 string ABIFunctions::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	return m_functionCollector.createFunction(_name, _creator);
+	return m_functionCollector.createCachedFunction(_name, m_evmVersion, m_revertStrings, _creator);
 }
 
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
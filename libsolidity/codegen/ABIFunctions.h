@@ -261,7 +261,7 @@ private:
 
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
-	/// cases.
+	/// cases. The function is shared with other contracts through the cache of the collector.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
 	/// @returns the size of the static part of the encoding of the given types.
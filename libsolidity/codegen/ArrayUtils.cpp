@@ -82,7 +82,7 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 	Type const* targetType = &_targetType;
 	Type const* sourceType = &_sourceType;
 	m_context.callLowLevelFunction(
-		"$copyArrayToStorage_" + sourceType->identifier() + "_to_" + targetType->identifier(),
+		{"$copyArrayToStorage", {sourceType, targetType}},
 		3,
 		1,
 		[=](CompilerContext& _context)
@@ -436,122 +436,140 @@ void ArrayUtils::copyArrayToMemory(ArrayType const& _sourceType, bool _padToWord
 	else
 	{
 		solAssert(_sourceType.location() == DataLocation::Storage, "");
-		unsigned storageBytes = _sourceType.baseType()->storageBytes();
-		u256 storageSize = _sourceType.baseType()->storageSize();
-		solAssert(storageSize > 1 || (storageSize == 1 && storageBytes > 0), "");
+		Type const* sourceType = &_sourceType;
+		m_context.callLowLevelFunction(
+			{_padToWordBoundaries ? "$copyArrayToMemoryPadded" : "$copyArrayToMemory", {sourceType}},
+			2,
+			1,
+			[sourceType, _padToWordBoundaries](CompilerContext& _context)
+			{
+				ArrayUtils(_context).copyStorageArrayToMemory(
+					dynamic_cast<ArrayType const&>(*sourceType),
+					_padToWordBoundaries
+				);
+			}
+		);
+	}
+}
 
-		retrieveLength(_sourceType);
+void ArrayUtils::copyStorageArrayToMemory(ArrayType const& _sourceType, bool _padToWordBoundaries) const
+{
+	CompilerUtils utils(m_context);
+	unsigned storageBytes = _sourceType.baseType()->storageBytes();
+	u256 storageSize = _sourceType.baseType()->storageSize();
+	solAssert(storageSize > 1 || (storageSize == 1 && storageBytes > 0), "");
+
+	retrieveLength(_sourceType);
+	// stack here: memory_offset storage_offset length
+	// jump to end if length is zero
+	m_context << Instruction::DUP1 << Instruction::ISZERO;
+	evmasm::AssemblyItem loopEnd = m_context.appendConditionalJump();
+	// Special case for tightly-stored byte arrays
+	if (_sourceType.isByteArray())
+	{
 		// stack here: memory_offset storage_offset length
-		// jump to end if length is zero
-		m_context << Instruction::DUP1 << Instruction::ISZERO;
-		evmasm::AssemblyItem loopEnd = m_context.appendConditionalJump();
-		// Special case for tightly-stored byte arrays
-		if (_sourceType.isByteArray())
-		{
-			// stack here: memory_offset storage_offset length
-			m_context << Instruction::DUP1 << u256(31) << Instruction::LT;
-			evmasm::AssemblyItem longByteArray = m_context.appendConditionalJump();
-			// store the short byte array (discard lower-order byte)
-			m_context << u256(0x100) << Instruction::DUP1;
-			m_context << Instruction::DUP4 << Instruction::SLOAD;
-			m_context << Instruction::DIV << Instruction::MUL;
-			m_context << Instruction::DUP4 << Instruction::MSTORE;
-			// stack here: memory_offset storage_offset length
-			// add 32 or length to memory offset
-			m_context << Instruction::SWAP2;
-			if (_padToWordBoundaries)
-				m_context << u256(32);
-			else
-				m_context << Instruction::DUP3;
-			m_context << Instruction::ADD;
-			m_context << Instruction::SWAP2;
-			m_context.appendJumpTo(loopEnd);
-			m_context << longByteArray;
-		}
+		m_context << Instruction::DUP1 << u256(31) << Instruction::LT;
+		evmasm::AssemblyItem longByteArray = m_context.appendConditionalJump();
+		// store the short byte array (discard lower-order byte)
+		m_context << u256(0x100) << Instruction::DUP1;
+		m_context << Instruction::DUP4 << Instruction::SLOAD;
+		m_context << Instruction::DIV << Instruction::MUL;
+		m_context << Instruction::DUP4 << Instruction::MSTORE;
+		// stack here: memory_offset storage_offset length
+		// add 32 or length to memory offset
+		m_context << Instruction::SWAP2;
+		if (_padToWordBoundaries)
+			m_context << u256(32);
 		else
-			// convert length to memory size
-			m_context << _sourceType.baseType()->memoryHeadSize() << Instruction::MUL;
+			m_context << Instruction::DUP3;
+		m_context << Instruction::ADD;
+		m_context << Instruction::SWAP2;
+		m_context.appendJumpTo(loopEnd);
+		m_context << longByteArray;
+	}
+	else
+		// convert length to memory size
+		m_context << _sourceType.baseType()->memoryHeadSize() << Instruction::MUL;
 
-		m_context << Instruction::DUP3 << Instruction::ADD << Instruction::SWAP2;
-		if (_sourceType.isDynamicallySized())
-		{
-			// actual array data is stored at KECCAK256(storage_offset)
-			m_context << Instruction::SWAP1;
-			utils.computeHashStatic();
-			m_context << Instruction::SWAP1;
-		}
+	m_context << Instruction::DUP3 << Instruction::ADD << Instruction::SWAP2;
+	if (_sourceType.isDynamicallySized())
+	{
+		// actual array data is stored at KECCAK256(storage_offset)
+		m_context << Instruction::SWAP1;
+		utils.computeHashStatic();
+		m_context << Instruction::SWAP1;
+	}
 
-		// stack here: memory_end_offset storage_data_offset memory_offset
-		bool haveByteOffset = !_sourceType.isByteArray() && storageBytes <= 16;
-		if (haveByteOffset)
-			m_context << u256(0) << Instruction::SWAP1;
+	// stack here: memory_end_offset storage_data_offset memory_offset
+	bool haveByteOffset = !_sourceType.isByteArray() && storageBytes <= 16;
+	if (haveByteOffset)
+		m_context << u256(0) << Instruction::SWAP1;
+	// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
+	evmasm::AssemblyItem loopStart = m_context.newTag();
+	m_context << loopStart;
+	// load and store
+	if (_sourceType.isByteArray())
+	{
+		// Packed both in storage and memory.
+		m_context << Instruction::DUP2 << Instruction::SLOAD;
+		m_context << Instruction::DUP2 << Instruction::MSTORE;
+		// increment storage_data_offset by 1
+		m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
+		// increment memory offset by 32
+		m_context << Instruction::SWAP1 << u256(32) << Instruction::ADD;
+	}
+	else
+	{
 		// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
-		evmasm::AssemblyItem loopStart = m_context.newTag();
-		m_context << loopStart;
-		// load and store
-		if (_sourceType.isByteArray())
-		{
-			// Packed both in storage and memory.
-			m_context << Instruction::DUP2 << Instruction::SLOAD;
-			m_context << Instruction::DUP2 << Instruction::MSTORE;
-			// increment storage_data_offset by 1
-			m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
-			// increment memory offset by 32
-			m_context << Instruction::SWAP1 << u256(32) << Instruction::ADD;
-		}
+		if (haveByteOffset)
+			m_context << Instruction::DUP3 << Instruction::DUP3;
 		else
-		{
-			// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
-			if (haveByteOffset)
-				m_context << Instruction::DUP3 << Instruction::DUP3;
-			else
-				m_context << Instruction::DUP2 << u256(0);
-			StorageItem(m_context, *_sourceType.baseType()).retrieveValue(SourceLocation(), true);
-			if (auto baseArray = dynamic_cast<ArrayType const*>(_sourceType.baseType()))
-				copyArrayToMemory(*baseArray, _padToWordBoundaries);
-			else
-				utils.storeInMemoryDynamic(*_sourceType.baseType());
-			// increment storage_data_offset and byte offset
-			if (haveByteOffset)
-				incrementByteOffset(storageBytes, 2, 3);
-			else
-			{
-				m_context << Instruction::SWAP1;
-				m_context << storageSize << Instruction::ADD;
-				m_context << Instruction::SWAP1;
-			}
-		}
-		// check for loop condition
-		m_context << Instruction::DUP1 << dupInstruction(haveByteOffset ? 5 : 4);
-		m_context << Instruction::GT;
-		m_context.appendConditionalJumpTo(loopStart);
-		// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
+			m_context << Instruction::DUP2 << u256(0);
+		StorageItem(m_context, *_sourceType.baseType()).retrieveValue(SourceLocation(), true);
+		if (auto baseArray = dynamic_cast<ArrayType const*>(_sourceType.baseType()))
+			copyArrayToMemory(*baseArray, _padToWordBoundaries);
+		else
+			utils.storeInMemoryDynamic(*_sourceType.baseType());
+		// increment storage_data_offset and byte offset
 		if (haveByteOffset)
-			m_context << Instruction::SWAP1 << Instruction::POP;
-		if (!_sourceType.isByteArray())
-		{
-			solAssert(_sourceType.calldataStride() % 32 == 0, "");
-			solAssert(_sourceType.memoryStride() % 32 == 0, "");
-		}
-		if (_padToWordBoundaries && _sourceType.isByteArray())
+			incrementByteOffset(storageBytes, 2, 3);
+		else
 		{
-			// memory_end_offset - start is the actual length (we want to compute the ceil of).
-			// memory_offset - start is its next multiple of 32, but it might be off by 32.
-			// so we compute: memory_end_offset += (memory_offset - memory_end_offest) & 31
-			m_context << Instruction::DUP3 << Instruction::SWAP1 << Instruction::SUB;
-			m_context << u256(31) << Instruction::AND;
-			m_context << Instruction::DUP3 << Instruction::ADD;
-			m_context << Instruction::SWAP2;
+			m_context << Instruction::SWAP1;
+			m_context << storageSize << Instruction::ADD;
+			m_context << Instruction::SWAP1;
 		}
-		m_context << loopEnd << Instruction::POP << Instruction::POP;
 	}
+	// check for loop condition
+	m_context << Instruction::DUP1 << dupInstruction(haveByteOffset ? 5 : 4);
+	m_context << Instruction::GT;
+	m_context.appendConditionalJumpTo(loopStart);
+	// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
+	if (haveByteOffset)
+		m_context << Instruction::SWAP1 << Instruction::POP;
+	if (!_sourceType.isByteArray())
+	{
+		solAssert(_sourceType.calldataStride() % 32 == 0, "");
+		solAssert(_sourceType.memoryStride() % 32 == 0, "");
+	}
+	if (_padToWordBoundaries && _sourceType.isByteArray())
+	{
+		// memory_end_offset - start is the actual length (we want to compute the ceil of).
+		// memory_offset - start is its next multiple of 32, but it might be off by 32.
+		// so we compute: memory_end_offset += (memory_offset - memory_end_offest) & 31
+		m_context << Instruction::DUP3 << Instruction::SWAP1 << Instruction::SUB;
+		m_context << u256(31) << Instruction::AND;
+		m_context << Instruction::DUP3 << Instruction::ADD;
+		m_context << Instruction::SWAP2;
+	}
+	m_context << loopEnd << Instruction::POP << Instruction::POP;
 }
 
 void ArrayUtils::clearArray(ArrayType const& _typeIn) const
 {
 	Type const* type = &_typeIn;
 	m_context.callLowLevelFunction(
-		"$clearArray_" + _typeIn.identifier(),
+		{"$clearArray", {type}},
 		2,
 		0,
 		[type](CompilerContext& _context)
@@ -656,7 +674,7 @@ void ArrayUtils::resizeDynamicArray(ArrayType const& _typeIn) const
 {
 	Type const* type = &_typeIn;
 	m_context.callLowLevelFunction(
-		"$resizeDynamicArray_" + _typeIn.identifier(),
+		{"$resizeDynamicArray", {type}},
 		2,
 		0,
 		[type](CompilerContext& _context)
@@ -938,7 +956,7 @@ void ArrayUtils::clearStorageLoop(Type const* _type) const
 {
 	solAssert(_type->storageBytes() >= 32, "");
 	m_context.callLowLevelFunction(
-		"$clearStorageLoop_" + _type->identifier(),
+		{"$clearStorageLoop", {_type}},
 		2,
 		1,
 		[_type](CompilerContext& _context)
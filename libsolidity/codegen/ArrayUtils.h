@@ -108,6 +108,10 @@ public:
 	void accessCallDataArrayElement(ArrayType const& _arrayType, bool _doBoundsCheck = true) const;
 
 private:
+	/// Copies the data part of an array in storage to memory, see copyArrayToMemory.
+	/// Stack pre: memory_offset storage_offset
+	/// Stack post: memory_offest + length(padded)
+	void copyStorageArrayToMemory(ArrayType const& _sourceType, bool _padToWordBoundaries) const;
 	/// Adds the given number of bytes to a storage byte offset counter and also increments
 	/// the storage offset if adding this number again would increase the counter over 32.
 	/// @param byteOffsetPosition the stack offset of the storage byte offset
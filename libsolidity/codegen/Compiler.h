@@ -37,10 +37,41 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _parallelism number of threads the optimiser can use for sub-assemblies.
+	/// @param _functionCache cache of utility functions shared with the compilation of other contracts.
+	/// @param _yulUtilityCodeCache cache of processed utility code shared with the compilation of other contracts.
+	/// @param _functionCodeCache cache of the code of functions shared with the compilation of other contracts.
+	/// @param _relocatedParameters parameters of external functions that are kept in calldata.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		size_t _parallelism = 1,
+		std::shared_ptr<MultiUseYulFunctionCache> const& _functionCache = nullptr,
+		std::shared_ptr<YulUtilityCodeCache> const& _yulUtilityCodeCache = nullptr,
+		std::shared_ptr<FunctionCodeCache> const& _functionCodeCache = nullptr,
+		std::shared_ptr<RelocatedParameters const> const& _relocatedParameters = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_parallelism(_parallelism),
+		m_runtimeContext(
+			_evmVersion,
+			_revertStrings,
+			nullptr,
+			_functionCache,
+			_yulUtilityCodeCache,
+			_functionCodeCache,
+			_relocatedParameters
+		),
+		m_context(
+			_evmVersion,
+			_revertStrings,
+			&m_runtimeContext,
+			_functionCache,
+			_yulUtilityCodeCache,
+			_functionCodeCache,
+			_relocatedParameters
+		)
 	{ }
 
 	/// Compiles a contract.
@@ -68,6 +99,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_parallelism;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
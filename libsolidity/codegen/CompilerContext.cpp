@@ -61,6 +61,53 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+shared_ptr<YulUtilityCodeCache::Entry const> YulUtilityCodeCache::find(string const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	return it == m_entries.end() ? nullptr : it->second;
+}
+
+void YulUtilityCodeCache::insert(string _key, shared_ptr<Entry const> _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(move(_key), move(_entry));
+}
+
+bool LowLevelFunctionKey::operator<(LowLevelFunctionKey const& _other) const
+{
+	if (routine != _other.routine)
+		return routine < _other.routine;
+	return lexicographical_compare(
+		types.begin(),
+		types.end(),
+		_other.types.begin(),
+		_other.types.end(),
+		[](Type const* _a, Type const* _b) { return _a != _b && _a->identifier() < _b->identifier(); }
+	);
+}
+
+string LowLevelFunctionKey::name() const
+{
+	string result = routine;
+	for (Type const* type: types)
+		result += "_" + type->identifier();
+	return result;
+}
+
+shared_ptr<FunctionCodeCache::Entry const> FunctionCodeCache::find(Key const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	return it == m_entries.end() ? nullptr : it->second;
+}
+
+void FunctionCodeCache::insert(Key const& _key, shared_ptr<Entry const> _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(_key, move(_entry));
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -115,12 +162,91 @@ size_t CompilerContext::reservedMemory()
 
 void CompilerContext::startFunction(Declaration const& _function)
 {
+	recordRequest({FunctionCodeCache::Request::Kind::StartFunction, m_asm->usedTags(), 0, &_function, {}, 0, 0, {}, {}});
 	m_functionCompilationQueue.startFunction(_function);
 	*this << functionEntryLabel(_function);
 }
 
+void CompilerContext::appendFunction(Declaration const& _function, function<void()> const& _generator)
+{
+	if (!isCacheable(_function))
+	{
+		_generator();
+		return;
+	}
+
+	FunctionCodeCache::Key const key{&_function, m_useABICoderV2, m_arithmetic};
+	if (shared_ptr<FunctionCodeCache::Entry const> entry = m_functionCodeCache->find(key))
+	{
+		appendCachedFunction(*entry);
+		return;
+	}
+
+	size_t const firstItem = m_asm->items().size();
+	unsigned const firstTag = m_asm->usedTags();
+	m_recordedRequests.emplace();
+	m_yulFunctionCollector.startRecording();
+	try
+	{
+		_generator();
+	}
+	catch (...)
+	{
+		m_recordedRequests.reset();
+		m_yulFunctionCollector.stopRecording();
+		throw;
+	}
+
+	auto entry = make_shared<FunctionCodeCache::Entry>();
+	entry->requests = move(*m_recordedRequests);
+	m_recordedRequests.reset();
+	entry->yulFunctions = m_yulFunctionCollector.stopRecording();
+	entry->items.assign(m_asm->items().begin() + static_cast<ptrdiff_t>(firstItem), m_asm->items().end());
+	entry->stackHeight = m_asm->deposit();
+	entry->modifierDepth = m_asm->m_currentModifierDepth;
+	entry->arithmetic = m_arithmetic;
+
+	set<size_t> requestTags;
+	for (FunctionCodeCache::Request const& request: entry->requests)
+		if (request.kind != FunctionCodeCache::Request::Kind::StartFunction)
+			requestTags.insert(request.tag);
+	for (size_t tag = firstTag; tag < m_asm->usedTags(); ++tag)
+		if (!requestTags.count(tag))
+			entry->localTags.push_back(tag);
+
+	for (evmasm::AssemblyItem const& item: entry->items)
+		switch (item.type())
+		{
+		case PushTag:
+		case Tag:
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			// Tags that were neither created nor requested while compiling the function could
+			// stand for anything.
+			if (subId != numeric_limits<size_t>::max() || (tag < firstTag && !requestTags.count(tag)))
+				return;
+			break;
+		}
+		case PushData:
+			entry->data[h256(item.data())] = m_asm->data(h256(item.data()));
+			break;
+		case PushString:
+		case PushSub:
+		case PushSubSize:
+		case PushLibraryAddress:
+		case PushImmutable:
+		case AssignImmutable:
+			// The code refers to other parts of the assembly.
+			return;
+		default:
+			break;
+		}
+
+	m_functionCodeCache->insert(key, move(entry));
+}
+
 void CompilerContext::callLowLevelFunction(
-	string const& _name,
+	LowLevelFunctionKey const& _key,
 	unsigned _inArgs,
 	unsigned _outArgs,
 	function<void(CompilerContext&)> const& _generator
@@ -129,7 +255,7 @@ void CompilerContext::callLowLevelFunction(
 	evmasm::AssemblyItem retTag = pushNewTag();
 	CompilerUtils(*this).moveIntoStack(_inArgs);
 
-	*this << lowLevelFunctionTag(_name, _inArgs, _outArgs, _generator);
+	*this << lowLevelFunctionTag(_key, _inArgs, _outArgs, _generator);
 
 	appendJump(evmasm::AssemblyItem::JumpType::IntoFunction);
 	adjustStackOffset(static_cast<int>(_outArgs) - 1 - static_cast<int>(_inArgs));
@@ -145,47 +271,69 @@ void CompilerContext::callYulFunction(
 	m_externallyUsedYulFunctions.insert(_name);
 	auto const retTag = pushNewTag();
 	CompilerUtils(*this).moveIntoStack(_inArgs);
-	appendJumpTo(namedTag(_name, _inArgs, _outArgs, {}), evmasm::AssemblyItem::JumpType::IntoFunction);
+	unsigned const usedTags = m_asm->usedTags();
+	evmasm::AssemblyItem const functionTag = namedTag(_name, _inArgs, _outArgs, {});
+	recordRequest({
+		FunctionCodeCache::Request::Kind::YulFunction,
+		usedTags,
+		static_cast<size_t>(functionTag.data()),
+		nullptr,
+		_name,
+		_inArgs,
+		_outArgs,
+		{},
+		{}
+	});
+	appendJumpTo(functionTag, evmasm::AssemblyItem::JumpType::IntoFunction);
 	adjustStackOffset(static_cast<int>(_outArgs) - 1 - static_cast<int>(_inArgs));
 	*this << retTag.tag();
 }
 
 evmasm::AssemblyItem CompilerContext::lowLevelFunctionTag(
-	string const& _name,
+	LowLevelFunctionKey const& _key,
 	unsigned _inArgs,
 	unsigned _outArgs,
 	function<void(CompilerContext&)> const& _generator
 )
 {
-	auto it = m_lowLevelFunctions.find(_name);
+	unsigned const usedTags = m_asm->usedTags();
+	auto it = m_lowLevelFunctions.find(_key);
 	if (it == m_lowLevelFunctions.end())
 	{
-		evmasm::AssemblyItem tag = newTag().pushTag();
-		m_lowLevelFunctions.insert(make_pair(_name, tag));
-		m_lowLevelFunctionGenerationQueue.push(make_tuple(_name, _inArgs, _outArgs, _generator));
-		return tag;
+		it = m_lowLevelFunctions.insert(make_pair(_key, newTag().pushTag())).first;
+		m_lowLevelFunctionGenerationQueue.push(make_tuple(_key, _inArgs, _outArgs, _generator));
 	}
-	else
-		return it->second;
+	recordRequest({
+		FunctionCodeCache::Request::Kind::LowLevelFunction,
+		usedTags,
+		static_cast<size_t>(it->second.data()),
+		nullptr,
+		{},
+		_inArgs,
+		_outArgs,
+		_generator,
+		_key
+	});
+	return it->second;
 }
 
 void CompilerContext::appendMissingLowLevelFunctions()
 {
 	while (!m_lowLevelFunctionGenerationQueue.empty())
 	{
-		string name;
+		LowLevelFunctionKey key;
 		unsigned inArgs;
 		unsigned outArgs;
 		function<void(CompilerContext&)> generator;
-		tie(name, inArgs, outArgs, generator) = m_lowLevelFunctionGenerationQueue.front();
+		tie(key, inArgs, outArgs, generator) = m_lowLevelFunctionGenerationQueue.front();
 		m_lowLevelFunctionGenerationQueue.pop();
 
 		setStackOffset(static_cast<int>(inArgs) + 1);
-		*this << m_lowLevelFunctions.at(name).tag();
+		*this << m_lowLevelFunctions.at(key).tag();
 		generator(*this);
 		CompilerUtils(*this).moveToStackTop(outArgs);
 		appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
-		solAssert(stackHeight() == outArgs, "Invalid stack height in low-level function " + name + ".");
+		solAssert(stackHeight() == outArgs, "Invalid stack height in low-level function " + key.name() + ".");
 	}
 }
 
@@ -215,7 +363,7 @@ void CompilerContext::addVariable(
 )
 {
 	solAssert(m_asm->deposit() >= 0 && unsigned(m_asm->deposit()) >= _offsetToCurrent, "");
-	unsigned sizeOnStack = _declaration.annotation().type->sizeOnStack();
+	unsigned sizeOnStack = m_relocatedParameters->type(_declaration)->sizeOnStack();
 	// Variables should not have stack size other than [1, 2],
 	// but that might change when new types are introduced.
 	solAssert(sizeOnStack == 1 || sizeOnStack == 2, "");
@@ -270,7 +418,20 @@ bool CompilerContext::isLocalVariable(Declaration const* _declaration) const
 
 evmasm::AssemblyItem CompilerContext::functionEntryLabel(Declaration const& _declaration)
 {
-	return m_functionCompilationQueue.entryLabel(_declaration, *this);
+	unsigned const usedTags = m_asm->usedTags();
+	evmasm::AssemblyItem label = m_functionCompilationQueue.entryLabel(_declaration, *this);
+	recordRequest({
+		FunctionCodeCache::Request::Kind::EntryLabel,
+		usedTags,
+		static_cast<size_t>(label.data()),
+		&_declaration,
+		{},
+		0,
+		0,
+		{},
+		{}
+	});
+	return label;
 }
 
 evmasm::AssemblyItem CompilerContext::functionEntryLabelIfExists(Declaration const& _declaration) const
@@ -432,6 +593,43 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	// System-level code does not depend on the current source location and is identical for many
+	// contracts, so the result of parsing, analysing and optimising it is cached.
+	string cacheKey;
+	if (_system && m_yulUtilityCodeCache && _localVariables.empty())
+	{
+		cacheKey =
+			m_evmVersion.name() + "\n" +
+			(runtimeContext() ? "creation" : "runtime") + "\n" +
+			_sourceName + "\n" +
+			joinHumanReadable(_externallyUsedFunctions) + "\n";
+		if (_optimiserSettings.runYulOptimiser)
+			cacheKey +=
+				"optimize:" +
+				_optimiserSettings.yulOptimiserSteps + ":" +
+				(_optimiserSettings.optimizeStackAllocation ? "stack:" : "") +
+				to_string(_optimiserSettings.expectedExecutionsPerDeployment) + "\n";
+		cacheKey += _assembly;
+
+		if (shared_ptr<YulUtilityCodeCache::Entry const> entry = m_yulUtilityCodeCache->find(cacheKey))
+		{
+			solAssert(m_generatedYulUtilityCode.empty(), "");
+			m_generatedYulUtilityCode = entry->generatedCode;
+			yul::AsmAnalysisInfo analysisInfo = *entry->analysisInfo;
+			yul::CodeGenerator::assemble(
+				*entry->code,
+				analysisInfo,
+				*m_asm,
+				m_evmVersion,
+				identifierAccess,
+				_system,
+				_optimiserSettings.optimizeStackAllocation
+			);
+			updateSourceLocation();
+			return;
+		}
+	}
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
@@ -513,6 +711,10 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	if (!cacheKey.empty())
+		m_yulUtilityCodeCache->insert(move(cacheKey), make_shared<YulUtilityCodeCache::Entry const>(
+			YulUtilityCodeCache::Entry{parserResult, make_shared<yul::AsmAnalysisInfo const>(analysisInfo), m_generatedYulUtilityCode}
+		));
 	yul::CodeGenerator::assemble(
 		*parserResult,
 		analysisInfo,
@@ -566,16 +768,88 @@ void CompilerContext::updateSourceLocation()
 	m_asm->setSourceLocation(m_visitedNodes.empty() ? SourceLocation() : m_visitedNodes.top()->location());
 }
 
+bool CompilerContext::isCacheable(Declaration const& _function) const
+{
+	// Code in the creation context can refer to the runtime code.
+	if (!m_functionCodeCache || m_runtimeContext || m_recordedRequests)
+		return false;
+	// The code of functions of contracts can depend on the most derived contract, for example
+	// through virtual function calls, modifiers and the storage layout.
+	auto const* function = dynamic_cast<FunctionDefinition const*>(&_function);
+	return function && (function->isFree() || function->libraryFunction());
+}
+
+void CompilerContext::appendCachedFunction(FunctionCodeCache::Entry const& _entry)
+{
+	using Kind = FunctionCodeCache::Request::Kind;
+
+	// Make the requests and create the tags in the same order as while compiling the function,
+	// so that the result is identical to compiling it again.
+	map<size_t, size_t> tags;
+	auto localTag = _entry.localTags.begin();
+	auto createLocalTags = [&](size_t _usedTags) {
+		for (; localTag != _entry.localTags.end() && *localTag < _usedTags; ++localTag)
+			tags[*localTag] = static_cast<size_t>(newTag().data());
+	};
+	for (FunctionCodeCache::Request const& request: _entry.requests)
+	{
+		createLocalTags(request.usedTags);
+		switch (request.kind)
+		{
+		case Kind::StartFunction:
+			m_functionCompilationQueue.startFunction(*request.declaration);
+			break;
+		case Kind::EntryLabel:
+			tags[request.tag] = static_cast<size_t>(functionEntryLabel(*request.declaration).data());
+			break;
+		case Kind::LowLevelFunction:
+			tags[request.tag] = static_cast<size_t>(
+				lowLevelFunctionTag(request.lowLevelFunction, request.inArgs, request.outArgs, request.generator).data()
+			);
+			break;
+		case Kind::YulFunction:
+			m_externallyUsedYulFunctions.insert(request.name);
+			tags[request.tag] = static_cast<size_t>(namedTag(request.name, request.inArgs, request.outArgs, {}).data());
+			break;
+		}
+	}
+	createLocalTags(numeric_limits<size_t>::max());
+
+	m_yulFunctionCollector.addFunctions(_entry.yulFunctions);
+	for (auto const& data: _entry.data)
+		m_asm->newData(data.second);
+
+	AssemblyItems& items = m_asm->items();
+	for (evmasm::AssemblyItem const& item: _entry.items)
+	{
+		items.emplace_back(item);
+		if (item.type() == PushTag || item.type() == Tag)
+			items.back().setData(tags.at(static_cast<size_t>(item.data())));
+	}
+	setStackOffset(_entry.stackHeight);
+	setModifierDepth(_entry.modifierDepth);
+	m_arithmetic = _entry.arithmetic;
+	updateSourceLocation();
+}
+
+void CompilerContext::recordRequest(FunctionCodeCache::Request _request)
+{
+	if (m_recordedRequests)
+		m_recordedRequests->emplace_back(move(_request));
+}
+
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runExtendedCSE = _settings.runExtendedCSE;
+	asmSettings.runColdCodeMover = _settings.runColdCodeMover;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
@@ -23,10 +23,12 @@
 
 #pragma once
 
+#include <libsolidity/analysis/CalldataParameterRelocator.h>
 #include <libsolidity/ast/ASTAnnotations.h>
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -42,15 +44,112 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <functional>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <stack>
 #include <queue>
+#include <tuple>
 #include <utility>
 
 namespace solidity::frontend
 {
 
 class Compiler;
+class CompilerContext;
+
+/**
+ * Parsed, analysed and optimised Yul utility code, shared by the compiler contexts of all
+ * contracts of a compilation, so that identical code is only processed once.
+ * Can be used from several threads.
+ */
+class YulUtilityCodeCache
+{
+public:
+	struct Entry
+	{
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo const> analysisInfo;
+		/// Code to be exported as generated source.
+		std::string generatedCode;
+	};
+
+	/// @returns the entry stored under @a _key, if any.
+	std::shared_ptr<Entry const> find(std::string const& _key) const;
+	void insert(std::string _key, std::shared_ptr<Entry const> _entry);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Entry const>> m_entries;
+};
+
+/**
+ * Identifies a low-level function by the routine it implements and the types its code is
+ * generated for. Types are compared by their identifier, since equal types are not necessarily
+ * the same object.
+ */
+struct LowLevelFunctionKey
+{
+	/// Name of the routine, including any other setting its code depends on.
+	std::string routine;
+	std::vector<Type const*> types;
+
+	bool operator<(LowLevelFunctionKey const& _other) const;
+	/// @returns a name of the function for error messages.
+	std::string name() const;
+};
+
+/**
+ * Code of internal library functions and free functions compiled into the runtime code of a
+ * contract, shared by the compiler contexts of all contracts of a compilation, so that it is
+ * generated only once. Apart from its tags, the code does not depend on the contract.
+ * Can be used from several threads.
+ */
+class FunctionCodeCache
+{
+public:
+	/// A request to the compiler context that might create a tag, made while compiling the function.
+	struct Request
+	{
+		enum class Kind { StartFunction, EntryLabel, LowLevelFunction, YulFunction };
+		Kind kind;
+		/// Number of tags used by the assembly before the request.
+		unsigned usedTags = 0;
+		/// Id of the tag returned for the request.
+		size_t tag = 0;
+		Declaration const* declaration = nullptr;
+		std::string name;
+		unsigned inArgs = 0;
+		unsigned outArgs = 0;
+		std::function<void(CompilerContext&)> generator;
+		LowLevelFunctionKey lowLevelFunction;
+	};
+
+	struct Entry
+	{
+		evmasm::AssemblyItems items;
+		std::vector<Request> requests;
+		/// Ids of all other tags created while compiling the function, in ascending order.
+		std::vector<size_t> localTags;
+		std::map<util::h256, bytes> data;
+		std::vector<MultiUseYulFunctionCollector::Function> yulFunctions;
+		int stackHeight = 0;
+		size_t modifierDepth = 0;
+		Arithmetic arithmetic = Arithmetic::Checked;
+	};
+
+	/// The function together with the ABI coder and arithmetic used by the context when
+	/// compilation of the function starts.
+	using Key = std::tuple<Declaration const*, bool, Arithmetic>;
+
+	/// @returns the entry stored under @a _key, if any.
+	std::shared_ptr<Entry const> find(Key const& _key) const;
+	void insert(Key const& _key, std::shared_ptr<Entry const> _entry);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<Key, std::shared_ptr<Entry const>> m_entries;
+};
 
 /**
  * Context to be shared by all units that compile the same contract.
@@ -62,13 +161,23 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr,
+		std::shared_ptr<YulUtilityCodeCache> _yulUtilityCodeCache = nullptr,
+		std::shared_ptr<FunctionCodeCache> _functionCodeCache = nullptr,
+		std::shared_ptr<RelocatedParameters const> _relocatedParameters = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_yulFunctionCollector(std::move(_functionCache)),
+		m_yulUtilityCodeCache(std::move(_yulUtilityCodeCache)),
+		m_functionCodeCache(std::move(_functionCodeCache)),
+		m_relocatedParameters(
+			_relocatedParameters ? std::move(_relocatedParameters) : std::make_shared<RelocatedParameters const>()
+		),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -81,6 +190,10 @@ public:
 	void setUseABICoderV2(bool _value) { m_useABICoderV2 = _value; }
 	bool useABICoderV2() const { return m_useABICoderV2; }
 
+	/// @returns the parameters of external functions that are kept in calldata. The types of these
+	/// parameters and of the identifiers referring to them have to be taken from here.
+	RelocatedParameters const& relocatedParameters() const { return *m_relocatedParameters; }
+
 	void addStateVariable(VariableDeclaration const& _declaration, u256 const& _storageOffset, unsigned _byteOffset);
 	void addImmutable(VariableDeclaration const& _declaration);
 
@@ -133,13 +246,17 @@ public:
 	/// Resets function specific members, inserts the function entry label and marks the function
 	/// as "having code".
 	void startFunction(Declaration const& _function);
+	/// Appends the code of @a _function, which is generated by @a _generator, unless it can be
+	/// taken from the function code cache.
+	void appendFunction(Declaration const& _function, std::function<void()> const& _generator);
 
-	/// Appends a call to the named low-level function and inserts the generator into the
-	/// list of low-level-functions to be generated, unless it already exists.
+	/// Appends a call to the low-level function identified by @a _key and inserts the generator
+	/// into the list of low-level-functions to be generated, unless it already exists.
+	/// The code generated by the generator may only depend on the types in the key.
 	/// Note that the generator should not assume that objects are still alive when it is called,
 	/// unless they are guaranteed to be alive for the whole run of the compiler (AST nodes, for example).
 	void callLowLevelFunction(
-		std::string const& _name,
+		LowLevelFunctionKey const& _key,
 		unsigned _inArgs,
 		unsigned _outArgs,
 		std::function<void(CompilerContext&)> const& _generator
@@ -152,12 +269,12 @@ public:
 		unsigned _outArgs
 	);
 
-	/// Returns the tag of the named low-level function and inserts the generator into the
-	/// list of low-level-functions to be generated, unless it already exists.
+	/// Returns the tag of the low-level function identified by @a _key and inserts the generator
+	/// into the list of low-level-functions to be generated, unless it already exists.
 	/// Note that the generator should not assume that objects are still alive when it is called,
 	/// unless they are guaranteed to be alive for the whole run of the compiler (AST nodes, for example).
 	evmasm::AssemblyItem lowLevelFunctionTag(
-		std::string const& _name,
+		LowLevelFunctionKey const& _key,
 		unsigned _inArgs,
 		unsigned _outArgs,
 		std::function<void(CompilerContext&)> const& _generator
@@ -281,8 +398,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step. Sub-assemblies are optimised using up to @a _parallelism threads.
+	void optimise(OptimiserSettings const& _settings, size_t _parallelism = 1)
+	{
+		evmasm::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.parallelism = _parallelism;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -313,6 +435,13 @@ private:
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
+	/// @returns true if the code of @a _function can be stored in the function code cache.
+	bool isCacheable(Declaration const& _function) const;
+	/// Appends the code of a function from the function code cache.
+	void appendCachedFunction(FunctionCodeCache::Entry const& _entry);
+	/// Records @a _request if the code of a function is being recorded for the function code cache.
+	void recordRequest(FunctionCodeCache::Request _request);
+
 	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
 
 	/**
@@ -378,7 +507,7 @@ private:
 	/// The index of the runtime subroutine.
 	size_t m_runtimeSub = std::numeric_limits<size_t>::max();
 	/// An index of low-level function labels by name.
-	std::map<std::string, evmasm::AssemblyItem> m_lowLevelFunctions;
+	std::map<LowLevelFunctionKey, evmasm::AssemblyItem> m_lowLevelFunctions;
 	/// Collector for yul functions.
 	MultiUseYulFunctionCollector m_yulFunctionCollector;
 	/// Set of externally used yul functions.
@@ -386,12 +515,20 @@ private:
 	/// Generated Yul code used as utility. Source references from the bytecode can point here.
 	/// Produced from @a m_yulFunctionCollector.
 	std::string m_generatedYulUtilityCode;
+	/// Cache of the processed utility code, shared with the contexts of other contracts.
+	std::shared_ptr<YulUtilityCodeCache> m_yulUtilityCodeCache;
+	/// Cache of the code of functions, shared with the contexts of other contracts.
+	std::shared_ptr<FunctionCodeCache> m_functionCodeCache;
+	/// Parameters of external functions that are kept in calldata.
+	std::shared_ptr<RelocatedParameters const> m_relocatedParameters;
+	/// Requests made while the code of a function is recorded for the function code cache.
+	std::optional<std::vector<FunctionCodeCache::Request>> m_recordedRequests;
 	/// Container for ABI functions to be generated.
 	ABIFunctions m_abiFunctions;
 	/// Container for Yul Util functions to be generated.
 	YulUtilFunctions m_yulUtilFunctions;
 	/// The queue of low-level functions to generate.
-	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
+	std::queue<std::tuple<LowLevelFunctionKey, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that appendYulUtilityFunctions() was called exactly once
 	bool m_appendYulUtilityFunctionsRan = false;
 };
@@ -93,14 +93,16 @@ void CompilerUtils::toSizeAfterFreeMemoryPointer()
 void CompilerUtils::revertWithStringData(Type const& _argumentType)
 {
 	solAssert(_argumentType.isImplicitlyConvertibleTo(*TypeProvider::fromElementaryTypeName("string memory")), "");
-	fetchFreeMemoryPointer();
-	m_context << util::selectorFromSignature("Error(string)");
-	m_context << Instruction::DUP2 << Instruction::MSTORE;
-	m_context << u256(4) << Instruction::ADD;
-	// Stack: <string data> <mem pos of encoding start>
-	abiEncode({&_argumentType}, {TypeProvider::array(DataLocation::Memory, true)});
-	toSizeAfterFreeMemoryPointer();
-	m_context << Instruction::REVERT;
+	// Strings are encoded in the same way by both ABI coders, so this can always use the shared helper.
+	m_context.callYulFunction(
+		m_context.utilFunctions().revertWithErrorFunction(
+			"Error(string)",
+			{TypeProvider::array(DataLocation::Memory, true)},
+			{&_argumentType}
+		),
+		_argumentType.sizeOnStack(),
+		0
+	);
 }
 
 void CompilerUtils::revertWithError(
@@ -109,6 +111,16 @@ void CompilerUtils::revertWithError(
 	vector<Type const*> const& _argumentTypes
 )
 {
+	if (m_context.useABICoderV2())
+	{
+		m_context.callYulFunction(
+			m_context.utilFunctions().revertWithErrorFunction(_signature, _parameterTypes, _argumentTypes),
+			sizeOnStack(_argumentTypes),
+			0
+		);
+		return;
+	}
+
 	fetchFreeMemoryPointer();
 	m_context << util::selectorFromSignature(_signature);
 	m_context << Instruction::DUP2 << Instruction::MSTORE;
@@ -666,13 +678,28 @@ void CompilerUtils::memoryCopy32()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
+	optional<size_t> threshold = identityPrecompileCopyThreshold(m_context.evmVersion());
+	m_context.appendInlineAssembly(
+		Whiskers(R"(
 		{
+			<?identity>
+			switch lt(len, <threshold>)
+			case 0 {
+				if iszero(staticcall(gas(), 4, src, len, dst, len)) { revert(0, 0) }
+			}
+			default {
+			</identity>
 			for { let i := 0 } lt(i, len) { i := add(i, 32) } {
 				mstore(add(dst, i), mload(add(src, i)))
 			}
+			<?identity>
+			}
+			</identity>
 		}
-	)",
+		)")
+		("identity", threshold.has_value())
+		("threshold", to_string(threshold.value_or(0)))
+		.render(),
 		{ "len", "dst", "src" }
 	);
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
@@ -682,8 +709,17 @@ void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
+	optional<size_t> threshold = identityPrecompileCopyThreshold(m_context.evmVersion());
+	m_context.appendInlineAssembly(
+		Whiskers(R"(
 		{
+			<?identity>
+			switch lt(len, <threshold>)
+			case 0 {
+				if iszero(staticcall(gas(), 4, src, len, dst, len)) { revert(0, 0) }
+			}
+			default {
+			</identity>
 			// copy 32 bytes at once
 			for
 				{}
@@ -700,13 +736,49 @@ void CompilerUtils::memoryCopy()
 			let srcpart := and(mload(src), not(mask))
 			let dstpart := and(mload(dst), mask)
 			mstore(dst, or(srcpart, dstpart))
+			<?identity>
+			}
+			</identity>
 		}
-	)",
+		)")
+		("identity", threshold.has_value())
+		("threshold", to_string(threshold.value_or(0)))
+		.render(),
 		{ "len", "dst", "src" }
 	);
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
 }
 
+Type const* CompilerUtils::bytesConcatEncodingType(Type const* _argumentType)
+{
+	solAssert(_argumentType, "");
+	if (_argumentType->category() == Type::Category::FixedBytes)
+		return _argumentType;
+	else if (
+		auto const* literalType = dynamic_cast<StringLiteralType const*>(_argumentType);
+		literalType && literalType->value().size() <= 32
+	)
+		return TypeProvider::fixedBytes(static_cast<unsigned>(literalType->value().size()));
+	else
+	{
+		solAssert(_argumentType->isImplicitlyConvertibleTo(*TypeProvider::bytesMemory()), "");
+		return TypeProvider::bytesMemory();
+	}
+}
+
+optional<size_t> CompilerUtils::identityPrecompileCopyThreshold(EVMVersion _evmVersion)
+{
+	// A loop copies a word for about 50 gas. The identity precompile costs 15 gas plus 3 gas
+	// per word, on top of the call, which costs 100 gas since the precompiles are warm from
+	// the start (EIP-2929) and 700 gas before.
+	if (!_evmVersion.hasStaticCall())
+		return nullopt;
+	else if (_evmVersion >= EVMVersion::berlin())
+		return 256;
+	else
+		return 1024;
+}
+
 void CompilerUtils::splitExternalFunctionType(bool _leftAligned)
 {
 	// We have to split the left-aligned <address><function identifier> into two stack slots:
@@ -1021,57 +1093,70 @@ void CompilerUtils::convertType(
 				}
 				else
 				{
-					// stack: <source ref> (variably sized)
 					unsigned stackSize = typeOnStack.sizeOnStack();
-					ArrayUtils(m_context).retrieveLength(typeOnStack);
-
-					// allocate memory
-					// stack: <source ref> (variably sized) <length>
-					m_context << Instruction::DUP1;
-					ArrayUtils(m_context).convertLengthToSize(targetType, true);
-					// stack: <source ref> (variably sized) <length> <size>
-					if (targetType.isDynamicallySized())
-						m_context << u256(0x20) << Instruction::ADD;
-					allocateMemory();
-					// stack: <source ref> (variably sized) <length> <mem start>
-					m_context << Instruction::DUP1;
-					moveIntoStack(2 + stackSize);
-					if (targetType.isDynamicallySized())
-					{
-						m_context << Instruction::DUP2;
-						storeInMemoryDynamic(*TypeProvider::uint256());
-					}
-					// stack: <mem start> <source ref> (variably sized) <length> <mem data pos>
-					if (targetType.baseType()->isValueType())
-					{
-						copyToStackTop(2 + stackSize, stackSize);
-						ArrayUtils(m_context).copyArrayToMemory(typeOnStack);
-					}
-					else
-					{
-						m_context << u256(0) << Instruction::SWAP1;
-						// stack: <mem start> <source ref> (variably sized) <length> <counter> <mem data pos>
-						auto repeat = m_context.newTag();
-						m_context << repeat;
-						m_context << Instruction::DUP3 << Instruction::DUP3;
-						m_context << Instruction::LT << Instruction::ISZERO;
-						auto loopEnd = m_context.appendConditionalJump();
-						copyToStackTop(3 + stackSize, stackSize);
-						copyToStackTop(2 + stackSize, 1);
-						ArrayUtils(m_context).accessIndex(typeOnStack, false);
-						if (typeOnStack.location() == DataLocation::Storage)
-							StorageItem(m_context, *typeOnStack.baseType()).retrieveValue(SourceLocation(), true);
-						convertType(*typeOnStack.baseType(), *targetType.baseType(), _cleanupNeeded);
-						storeInMemoryDynamic(*targetType.baseType(), true);
-						m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
-						m_context << Instruction::SWAP1;
-						m_context.appendJumpTo(repeat);
-						m_context << loopEnd;
-						m_context << Instruction::POP;
-					}
-					// stack: <mem start> <source ref> (variably sized) <length> <mem data pos updated>
-					popStackSlots(2 + stackSize);
-					// Stack: <mem start>
+					bool cleanupNeeded = _cleanupNeeded;
+					m_context.callLowLevelFunction(
+						{
+							cleanupNeeded ? "$convertArrayToMemoryWithCleanup" : "$convertArrayToMemory",
+							{&typeOnStack, &targetType}
+						},
+						stackSize,
+						1,
+						[typeOnStack = &typeOnStack, targetType = &targetType, stackSize, cleanupNeeded](CompilerContext& _context)
+						{
+							CompilerUtils utils(_context);
+							// stack: <source ref> (variably sized)
+							ArrayUtils(_context).retrieveLength(*typeOnStack);
+
+							// allocate memory
+							// stack: <source ref> (variably sized) <length>
+							_context << Instruction::DUP1;
+							ArrayUtils(_context).convertLengthToSize(*targetType, true);
+							// stack: <source ref> (variably sized) <length> <size>
+							if (targetType->isDynamicallySized())
+								_context << u256(0x20) << Instruction::ADD;
+							utils.allocateMemory();
+							// stack: <source ref> (variably sized) <length> <mem start>
+							_context << Instruction::DUP1;
+							utils.moveIntoStack(2 + stackSize);
+							if (targetType->isDynamicallySized())
+							{
+								_context << Instruction::DUP2;
+								utils.storeInMemoryDynamic(*TypeProvider::uint256());
+							}
+							// stack: <mem start> <source ref> (variably sized) <length> <mem data pos>
+							if (targetType->baseType()->isValueType())
+							{
+								utils.copyToStackTop(2 + stackSize, stackSize);
+								ArrayUtils(_context).copyArrayToMemory(*typeOnStack);
+							}
+							else
+							{
+								_context << u256(0) << Instruction::SWAP1;
+								// stack: <mem start> <source ref> (variably sized) <length> <counter> <mem data pos>
+								auto repeat = _context.newTag();
+								_context << repeat;
+								_context << Instruction::DUP3 << Instruction::DUP3;
+								_context << Instruction::LT << Instruction::ISZERO;
+								auto loopEnd = _context.appendConditionalJump();
+								utils.copyToStackTop(3 + stackSize, stackSize);
+								utils.copyToStackTop(2 + stackSize, 1);
+								ArrayUtils(_context).accessIndex(*typeOnStack, false);
+								if (typeOnStack->location() == DataLocation::Storage)
+									StorageItem(_context, *typeOnStack->baseType()).retrieveValue(SourceLocation(), true);
+								utils.convertType(*typeOnStack->baseType(), *targetType->baseType(), cleanupNeeded);
+								utils.storeInMemoryDynamic(*targetType->baseType(), true);
+								_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
+								_context << Instruction::SWAP1;
+								_context.appendJumpTo(repeat);
+								_context << loopEnd;
+								_context << Instruction::POP;
+							}
+							// stack: <mem start> <source ref> (variably sized) <length> <mem data pos updated>
+							utils.popStackSlots(2 + stackSize);
+							// Stack: <mem start>
+						}
+					);
 				}
 			}
 			break;
@@ -1157,29 +1242,55 @@ void CompilerUtils::convertType(
 					utils.allocateMemory(typeOnStack->memoryDataSize());
 					_context << Instruction::SWAP1 << Instruction::DUP2;
 					// stack: <memory ptr> <source ref> <memory ptr>
+					// Slots shared by several members are only loaded once and their value is kept
+					// below the memory pointer while the members are extracted from it.
+					map<u256, size_t> membersPerSlot;
+					for (auto const& member: typeOnStack->members(nullptr))
+						membersPerSlot[typeOnStack->storageOffsetsOfMember(member.name).first]++;
+					optional<u256> loadedSlot;
 					for (auto const& member: typeOnStack->members(nullptr))
 					{
 						solAssert(!member.type->containsNestedMapping(), "");
 						pair<u256, unsigned> const& offsets = typeOnStack->storageOffsetsOfMember(member.name);
-						_context << offsets.first << Instruction::DUP3 << Instruction::ADD;
-						_context << u256(offsets.second);
-						StorageItem(_context, *member.type).retrieveValue(SourceLocation(), true);
+						if (loadedSlot && *loadedSlot != offsets.first)
+						{
+							_context << Instruction::SWAP1 << Instruction::POP;
+							loadedSlot.reset();
+						}
+						if (membersPerSlot.at(offsets.first) > 1)
+						{
+							solAssert(member.type->isValueType(), "");
+							if (!loadedSlot)
+							{
+								_context << offsets.first << Instruction::DUP3 << Instruction::ADD;
+								_context << Instruction::SLOAD << Instruction::SWAP1;
+								loadedSlot = offsets.first;
+							}
+							// stack: <memory ptr> <source ref> <slot value> <memory ptr>
+							_context << Instruction::DUP2 << u256(offsets.second);
+							StorageItem(_context, *member.type).retrieveValueFromSlotValue();
+						}
+						else
+						{
+							_context << offsets.first << Instruction::DUP3 << Instruction::ADD;
+							_context << u256(offsets.second);
+							StorageItem(_context, *member.type).retrieveValue(SourceLocation(), true);
+						}
 						Type const* targetMemberType = targetType->memberType(member.name);
 						solAssert(!!targetMemberType, "Member not found in target type.");
 						utils.convertType(*member.type, *targetMemberType, true);
 						utils.storeInMemoryDynamic(*targetMemberType, true);
 					}
+					if (loadedSlot)
+						_context << Instruction::SWAP1 << Instruction::POP;
 					_context << Instruction::POP << Instruction::POP;
 				};
-				if (typeOnStack.recursive())
-					m_context.callLowLevelFunction(
-						"$convertRecursiveArrayStorageToMemory_" + typeOnStack.identifier() + "_to_" + targetType.identifier(),
-						1,
-						1,
-						conversionImpl
-					);
-				else
-					conversionImpl(m_context);
+				m_context.callLowLevelFunction(
+					{"$convertStructStorageToMemory", {&typeOnStack, &targetType}},
+					1,
+					1,
+					conversionImpl
+				);
 				break;
 			}
 			case DataLocation::CallData:
@@ -1301,13 +1412,13 @@ void CompilerUtils::pushZeroValue(Type const& _type)
 	{
 		if (funType->kind() == FunctionType::Kind::Internal)
 		{
-			m_context << m_context.lowLevelFunctionTag("$invalidFunction", 0, 0, [](CompilerContext& _context) {
+			m_context << m_context.lowLevelFunctionTag({"$invalidFunction", {}}, 0, 0, [](CompilerContext& _context) {
 				_context.appendPanic(util::PanicCode::InvalidInternalFunction);
 			});
 			if (CompilerContext* runCon = m_context.runtimeContext())
 			{
 				leftShiftNumberOnStack(32);
-				m_context << runCon->lowLevelFunctionTag("$invalidFunction", 0, 0, [](CompilerContext& _context) {
+				m_context << runCon->lowLevelFunctionTag({"$invalidFunction", {}}, 0, 0, [](CompilerContext& _context) {
 					_context.appendPanic(util::PanicCode::InvalidInternalFunction);
 				}).toSubAssemblyTag(m_context.runtimeSub());
 				m_context << Instruction::OR;
@@ -1342,7 +1453,7 @@ void CompilerUtils::pushZeroValue(Type const& _type)
 
 	Type const* type = &_type;
 	m_context.callLowLevelFunction(
-		"$pushZeroValue_" + referenceType->identifier(),
+		{"$pushZeroValue", {referenceType}},
 		0,
 		1,
 		[type](CompilerContext& _context) {
@@ -1484,7 +1595,7 @@ void CompilerUtils::copyContractCodeToMemory(ContractDefinition const& contract,
 {
 	string which = _creation ? "Creation" : "Runtime";
 	m_context.callLowLevelFunction(
-		"$copyContract" + which + "CodeToMemory_" + contract.type()->identifier(),
+		{"$copyContract" + which + "CodeToMemory", {contract.type()}},
 		1,
 		1,
 		[&contract, _creation](CompilerContext& _context)
@@ -29,6 +29,8 @@
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/codegen/CompilerContext.h>
 
+#include <optional>
+
 namespace solidity::frontend
 {
 
@@ -165,6 +167,11 @@ public:
 		encodeToMemory(_givenTypes, _targetTypes, false, true, _encodeAsLibraryTypes);
 	}
 
+	/// @returns the type an argument of type @a _argumentType of ``bytes.concat`` is packed
+	/// encoded as: fixed bytes and string literals of at most 32 bytes as fixed bytes,
+	/// everything else as ``bytes memory``. Used by both code generators.
+	static Type const* bytesConcatEncodingType(Type const* _argumentType);
+
 	/// Special case of @a encodeToMemory which assumes that everything is padded to words
 	/// and dynamic data is not copied in place (i.e. a proper ABI encoding).
 	/// Stack pre: <value0> <value1> ... <valueN-1> <head_start>
@@ -214,6 +221,11 @@ public:
 	/// Stack post:
 	void memoryCopy();
 
+	/// @returns the number of bytes from which memory is copied to memory by a call to the
+	/// identity precompile instead of a loop, or nullopt if the precompile is not used
+	/// for @a _evmVersion. Used by both code generators.
+	static std::optional<size_t> identityPrecompileCopyThreshold(langutil::EVMVersion _evmVersion);
+
 	/// Stores the given string in memory.
 	/// Stack pre: mempos
 	/// Stack post:
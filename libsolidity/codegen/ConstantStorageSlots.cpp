@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/ConstantStorageSlots.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace
+{
+
+/// @returns true if @a _value can be represented in @a _type without changing it.
+bool fitsType(bigint const& _value, Type const& _type)
+{
+	if (auto const* integerType = dynamic_cast<IntegerType const*>(&_type))
+		return integerType->minValue() <= _value && _value <= integerType->maxValue();
+	else if (_type.category() == Type::Category::Address)
+		return 0 <= _value && _value < (bigint(1) << 160);
+	return false;
+}
+
+/// @returns the value of @a _expression if it is a compile-time constant of
+/// integer or address type.
+optional<bigint> constantValue(Expression const& _expression)
+{
+	Type const* type = _expression.annotation().type;
+	if (auto const* rationalType = dynamic_cast<RationalNumberType const*>(type))
+	{
+		if (rationalType->isFractional())
+			return nullopt;
+		return rationalType->value().numerator();
+	}
+	else if (auto const* literal = dynamic_cast<Literal const*>(&_expression))
+	{
+		if (type->category() == Type::Category::Address)
+			return bigint(literal->valueWithoutUnderscores());
+	}
+	else if (auto const* identifier = dynamic_cast<Identifier const*>(&_expression))
+	{
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+		if (variable && variable->isConstant() && variable->value())
+			if (optional<bigint> value = constantValue(*variable->value()))
+				if (fitsType(*value, *type))
+					return value;
+	}
+	else if (auto const* functionCall = dynamic_cast<FunctionCall const*>(&_expression))
+	{
+		// Conversions that keep the value, like ``address(0x...)`` or ``uint8(1)``.
+		if (
+			*functionCall->annotation().kind == FunctionCallKind::TypeConversion &&
+			functionCall->arguments().size() == 1
+		)
+			if (optional<bigint> value = constantValue(*functionCall->arguments().front()))
+				if (fitsType(*value, *type))
+					return value;
+	}
+	return nullopt;
+}
+
+}
+
+optional<u256> solidity::frontend::constantMappingKey(Expression const& _key, Type const& _keyType)
+{
+	if (_keyType.category() != Type::Category::Integer && _keyType.category() != Type::Category::Address)
+		return nullopt;
+	optional<bigint> value = constantValue(_key);
+	if (!value || !fitsType(*value, _keyType))
+		return nullopt;
+	// Signed keys are sign-extended to the full word.
+	if (*value < 0)
+		return s2u(s256(*value));
+	return u256(*value);
+}
+
+optional<u256> solidity::frontend::constantMappingValueSlot(
+	IndexAccess const& _indexAccess,
+	StateVariableSlotLookup const& _stateVariableSlot
+)
+{
+	auto const* mappingType = dynamic_cast<MappingType const*>(_indexAccess.baseExpression().annotation().type);
+	if (!mappingType || !_indexAccess.indexExpression())
+		return nullopt;
+
+	optional<u256> baseSlot;
+	Expression const& base = _indexAccess.baseExpression();
+	if (auto const* identifier = dynamic_cast<Identifier const*>(&base))
+	{
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+		if (variable && variable->isStateVariable() && !variable->isConstant() && !variable->immutable())
+			baseSlot = _stateVariableSlot(*variable);
+	}
+	else if (auto const* baseIndexAccess = dynamic_cast<IndexAccess const*>(&base))
+		baseSlot = constantMappingValueSlot(*baseIndexAccess, _stateVariableSlot);
+	if (!baseSlot)
+		return nullopt;
+
+	optional<u256> key = constantMappingKey(*_indexAccess.indexExpression(), *mappingType->keyType());
+	if (!key)
+		return nullopt;
+
+	bytes data = h256(*key).asBytes();
+	data += h256(*baseSlot).asBytes();
+	return u256(keccak256(data));
+}
@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Computation of the storage slots of mapping values at compile time.
+ */
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <functional>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+class Expression;
+class IndexAccess;
+class Type;
+class VariableDeclaration;
+
+/// Returns the storage slot of a state variable or nullopt if the variable is not stored
+/// in the storage of the current contract.
+using StateVariableSlotLookup = std::function<std::optional<u256>(VariableDeclaration const&)>;
+
+/// @returns the slot of the value accessed by @a _indexAccess if it is an access to a mapping
+/// stored in a state variable, possibly nested in other mappings, and all keys are compile-time
+/// constants, i.e. literals and constant variables of integer or address type and conversions
+/// between them that do not change their value. Used by both the legacy and the IR code
+/// generator to replace the hashing of the keys at runtime.
+std::optional<u256> constantMappingValueSlot(
+	IndexAccess const& _indexAccess,
+	StateVariableSlotLookup const& _stateVariableSlot
+);
+
+/// @returns the word @a _key is stored as in memory before hashing it as a key of type
+/// @a _keyType, provided it is a compile-time constant in the sense of @a constantMappingValueSlot.
+std::optional<u256> constantMappingKey(Expression const& _key, Type const& _keyType);
+
+}
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/codegen/ContractCompiler.h>
+#include <libsolidity/codegen/DispatchPlan.h>
 #include <libsolidity/codegen/ExpressionCompiler.h>
 
 #include <libyul/AsmAnalysisInfo.h>
@@ -42,7 +43,6 @@
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
-#include <libevmasm/GasMeter.h>
 
 #include <liblangutil/ErrorReporter.h>
 
@@ -323,39 +323,7 @@ void ContractCompiler::appendInternalSelector(
 	size_t _runs
 )
 {
-	// Code for selecting from n functions without split:
-	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
-	//   push2/3 <notfound> jump
-	// (called SELECT[n])
-	// Code for selecting from n functions with split:
-	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
-	//     SELECT[n/2]
-	//   tag_less:
-	//     SELECT[n/2]
-	//
-	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
-	// The average execution cost if we do not split at all are:
-	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
-	// If we split once:
-	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
-	//
-	// We should split if
-	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
-	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
-	//
-	// Which also means that the execution itself is not profitable
-	// unless we have at least 5 functions.
-
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
-
-	if (split)
+	if (DispatchPlan::split(_ids.size(), _runs))
 	{
 		size_t pivotIndex = _ids.size() / 2;
 		FixedHash<4> pivot{_ids.at(pivotIndex)};
@@ -441,14 +409,15 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 		CompilerUtils(m_context).loadFromMemory(0, IntegerType(CompilerUtils::dataStartOffset * 8), true);
 
 		// stack now is: <can-call-non-view-functions>? <funhash>
-		vector<FixedHash<4>> sortedIDs;
 		for (auto const& it: interfaceFunctions)
-		{
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
-			sortedIDs.emplace_back(it.first);
+		DispatchPlan plan(_contract, m_optimiserSettings);
+		for (auto const& id: plan.hotSelectors)
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(callDataUnpackerEntryPoints.at(id));
 		}
-		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		appendInternalSelector(callDataUnpackerEntryPoints, plan.sortedSelectors, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
 	}
 
 	m_context << notFoundOrReceiveEther;
@@ -505,6 +474,10 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 		m_context.setStackOffset(1);
 		FunctionTypePointer const& functionType = it.second;
 		solAssert(functionType->hasDeclaration(), "");
+		// Parameters kept in calldata are decoded as calldata references.
+		TypePointers parameterTypes = functionType->parameterTypes();
+		if (auto const* function = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
+			parameterTypes = m_context.relocatedParameters().parameterTypes(*function);
 		CompilerContext::LocationSetter locationSetter(m_context, functionType->declaration());
 
 		m_context << callDataUnpackerEntryPoints.at(it.first);
@@ -523,12 +496,12 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 		// Return tag is used to jump out of the function.
 		evmasm::AssemblyItem returnTag = m_context.pushNewTag();
-		if (!functionType->parameterTypes().empty())
+		if (!parameterTypes.empty())
 		{
 			// Parameter for calldataUnpacker
 			m_context << CompilerUtils::dataStartOffset;
 			m_context << Instruction::DUP1 << Instruction::CALLDATASIZE << Instruction::SUB;
-			CompilerUtils(m_context).abiDecode(functionType->parameterTypes());
+			CompilerUtils(m_context).abiDecode(parameterTypes);
 		}
 		m_context.appendJumpTo(
 			m_context.functionEntryLabel(functionType->declaration()),
@@ -538,7 +511,7 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 		// Return tag and input parameters get consumed.
 		m_context.adjustStackOffset(
 			static_cast<int>(CompilerUtils::sizeOnStack(functionType->returnParameterTypes())) -
-			static_cast<int>(CompilerUtils::sizeOnStack(functionType->parameterTypes())) -
+			static_cast<int>(CompilerUtils::sizeOnStack(parameterTypes)) -
 			1
 		);
 		// Consumes the return parameters.
@@ -613,7 +586,8 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 	// stack upon entry: [return address] [arg0] [arg1] ... [argn]
 	// reserve additional slots: [retarg0] ... [retargm]
 
-	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
+	TypePointers const parameterTypes = m_context.relocatedParameters().parameterTypes(_function);
+	unsigned parametersSize = CompilerUtils::sizeOnStack(parameterTypes);
 	if (_function.isFallback())
 		m_context.adjustStackOffset(static_cast<int>(parametersSize));
 	else if (!_function.isConstructor())
@@ -622,7 +596,7 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 	for (ASTPointer<VariableDeclaration> const& variable: _function.parameters())
 	{
 		m_context.addVariable(*variable, parametersSize);
-		parametersSize -= variable->annotation().type->sizeOnStack();
+		parametersSize -= m_context.relocatedParameters().type(*variable)->sizeOnStack();
 	}
 
 	for (ASTPointer<VariableDeclaration> const& variable: _function.returnParameters())
@@ -652,7 +626,7 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 	// Note that the fact that the return arguments are of increasing index is vital for this
 	// algorithm to work.
 
-	unsigned const c_argumentsSize = CompilerUtils::sizeOnStack(_function.parameters());
+	unsigned const c_argumentsSize = CompilerUtils::sizeOnStack(parameterTypes);
 	unsigned const c_returnValuesSize = CompilerUtils::sizeOnStack(_function.returnParameters());
 
 	vector<int> stackLayout;
@@ -1383,7 +1357,7 @@ void ContractCompiler::appendMissingFunctions()
 	while (Declaration const* function = m_context.nextFunctionToCompile())
 	{
 		m_context.setStackOffset(0);
-		function->accept(*this);
+		m_context.appendFunction(*function, [&]() { function->accept(*this); });
 		solAssert(m_context.nextFunctionToCompile() != function, "Compiled the wrong function?");
 	}
 	m_context.appendMissingLowLevelFunctions();
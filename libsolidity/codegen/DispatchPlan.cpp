@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/DispatchPlan.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libsolutil/Common.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Gas costs of comparing the selector with a constant and jumping if it matches:
+/// dup1, push4 <selector>, eq/gt, push2/3 <tag>, jumpi
+size_t constexpr comparisonGas = 3 + 3 + 3 + 3 + 10;
+
+/// @returns the average gas costs of selecting one of @a _count sorted selectors.
+bigint selectionGas(size_t _count, size_t _runs)
+{
+	if (_count == 0)
+		return 0;
+	if (!DispatchPlan::split(_count, _runs))
+		return comparisonGas * (_count + 1) / 2;
+	size_t smaller = _count / 2;
+	size_t larger = _count - smaller;
+	return comparisonGas + (smaller * selectionGas(smaller, _runs) + larger * selectionGas(larger, _runs)) / _count;
+}
+
+}
+
+DispatchPlan::DispatchPlan(ContractDefinition const& _contract, OptimiserSettings const& _optimiserSettings)
+{
+	vector<tuple<size_t, FixedHash<4>>> profiled;
+	bigint profiledExecutions = 0;
+	for (auto const& [selector, functionType]: _contract.interfaceFunctionList())
+	{
+		sortedSelectors.emplace_back(selector);
+		// Sources compiled outside of the compiler stack have no source unit name.
+		if (_optimiserSettings.executionProfile.empty())
+			continue;
+		Declaration const& declaration = functionType->declaration();
+		auto const* contract = dynamic_cast<ContractDefinition const*>(declaration.scope());
+		if (auto executions = _optimiserSettings.profiledExecutions(
+			declaration.sourceUnitName(),
+			contract ? contract->name() : "",
+			declaration.name()
+		); executions && *executions > 0)
+		{
+			profiled.emplace_back(*executions, selector);
+			profiledExecutions += *executions;
+		}
+	}
+	sort(sortedSelectors.begin(), sortedSelectors.end());
+	// Most executions first, ties are broken by the selector to keep the order deterministic.
+	sort(profiled.begin(), profiled.end(), [](auto const& _a, auto const& _b) {
+		return get<0>(_a) > get<0>(_b) || (get<0>(_a) == get<0>(_b) && get<1>(_a) < get<1>(_b));
+	});
+
+	for (auto const& [executions, selector]: profiled)
+	{
+		profiledExecutions -= executions;
+		// Comparing first saves the costs of the search for the calls of this function,
+		// but adds a comparison to the calls of all functions after it.
+		bigint savedGas = executions * (selectionGas(sortedSelectors.size(), _optimiserSettings.expectedExecutionsPerDeployment) - comparisonGas);
+		if (savedGas <= comparisonGas * profiledExecutions)
+			break;
+		hotSelectors.emplace_back(selector);
+		sortedSelectors.erase(find(sortedSelectors.begin(), sortedSelectors.end(), selector));
+	}
+}
+
+bool DispatchPlan::split(size_t _count, size_t _runs)
+{
+	// Code for selecting from n functions without split:
+	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
+	//   push2/3 <notfound> jump
+	// (called SELECT[n])
+	// Code for selecting from n functions with split:
+	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
+	//     SELECT[n/2]
+	//   tag_less:
+	//     SELECT[n/2]
+	//
+	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
+	// The average execution cost if we do not split at all are:
+	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
+	// If we split once:
+	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
+	//
+	// We should split if
+	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+	//
+	// Which also means that the execution itself is not profitable
+	// unless we have at least 5 functions.
+
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_count <= 4)
+		return false;
+	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return _runs * 6 * (_count - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
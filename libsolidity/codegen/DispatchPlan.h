@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Order in which the dispatcher of a contract compares the function selector of a call
+ * with the selectors of its interface functions.
+ */
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class ContractDefinition;
+
+/**
+ * Order in which the dispatcher of a contract compares the function selector of a call with the
+ * selectors of the interface functions. Used by both the legacy and the IR code generator.
+ *
+ * Functions that are called often according to the execution profile of the optimiser settings
+ * are compared first, one after the other, as long as the gas this saves for their calls outweighs
+ * the additional comparison for all calls of the functions after them. Functions that are not in
+ * the profile are assumed to be called rarely. The selector of a call is then looked up in the
+ * remaining selectors by a binary search, which switches to comparing with each selector for
+ * few selectors or few expected executions.
+ */
+struct DispatchPlan
+{
+	DispatchPlan(ContractDefinition const& _contract, OptimiserSettings const& _optimiserSettings);
+
+	/// @returns true if selecting from @a _count sorted selectors should first compare with
+	/// the middle one instead of comparing with each of them, given the number of intended
+	/// executions @a _runs.
+	static bool split(size_t _count, size_t _runs);
+
+	/// Selectors of frequently called functions, by decreasing number of executions.
+	std::vector<util::FixedHash<4>> hotSelectors;
+	/// Selectors of all other interface functions in ascending order.
+	std::vector<util::FixedHash<4>> sortedSelectors;
+};
+
+}
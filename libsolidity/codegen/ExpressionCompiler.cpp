@@ -26,6 +26,7 @@
 #include <libsolidity/codegen/ReturnInfo.h>
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/ConstantStorageSlots.h>
 #include <libsolidity/codegen/LValue.h>
 
 #include <libsolidity/ast/AST.h>
@@ -39,6 +40,7 @@
 #include <libsolutil/Whiskers.h>
 
 #include <boost/algorithm/string/replace.hpp>
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
@@ -846,8 +848,35 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 		{
 			solAssert(arguments.size() == 1, "");
 			solAssert(!function.padArguments(), "");
-			Type const* argType = arguments.front()->annotation().type;
+			Type const* argType = m_context.relocatedParameters().type(*arguments.front());
 			solAssert(argType, "");
+			if (FunctionCall const* encodingCall = packedEncodingCall(*arguments.front()))
+			{
+				// Optimization: Hash the result of abi.encodePacked and bytes.concat where it
+				// is encoded instead of allocating it, or at compile-time if it is constant.
+				if (optional<string> constantEncoding = constantPackedEncoding(*encodingCall))
+					m_context << u256(keccak256(*constantEncoding));
+				else
+				{
+					bool const isConcat =
+						dynamic_cast<FunctionType const&>(*encodingCall->expression().annotation().type).kind() ==
+						FunctionType::Kind::BytesConcat;
+					TypePointers argumentTypes;
+					TypePointers targetTypes;
+					for (auto const& argument: encodingCall->arguments())
+					{
+						argument->accept(*this);
+						argumentTypes.emplace_back(argument->annotation().type);
+						if (isConcat)
+							targetTypes.emplace_back(CompilerUtils::bytesConcatEncodingType(argument->annotation().type));
+					}
+					utils().fetchFreeMemoryPointer();
+					utils().packedEncode(argumentTypes, targetTypes);
+					utils().toSizeAfterFreeMemoryPointer();
+					m_context << Instruction::KECCAK256;
+				}
+				break;
+			}
 			arguments.front()->accept(*this);
 			if (auto const* stringLiteral = dynamic_cast<StringLiteralType const*>(argType))
 				// Optimization: Compute keccak256 on string literals at compile-time.
@@ -933,10 +962,28 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 					nonIndexedArgTypes.push_back(arguments[arg]->annotation().type);
 					nonIndexedParamTypes.push_back(paramTypes[arg]);
 				}
-			utils().fetchFreeMemoryPointer();
-			utils().abiEncode(nonIndexedArgTypes, nonIndexedParamTypes);
-			// need: topic1 ... topicn memsize memstart
-			utils().toSizeAfterFreeMemoryPointer();
+			// Data of at most two value types is encoded into the scratch space,
+			// where the end of the data is also its size.
+			bool const useScratchSpace =
+				nonIndexedParamTypes.size() <= 2 &&
+				all_of(nonIndexedParamTypes.begin(), nonIndexedParamTypes.end(), [](Type const* _type) {
+					return _type->isValueType();
+				});
+			if (useScratchSpace)
+			{
+				m_context << u256(0);
+				if (!nonIndexedParamTypes.empty())
+					utils().abiEncode(nonIndexedArgTypes, nonIndexedParamTypes);
+				// need: topic1 ... topicn memsize memstart
+				m_context << u256(0);
+			}
+			else
+			{
+				utils().fetchFreeMemoryPointer();
+				utils().abiEncode(nonIndexedArgTypes, nonIndexedParamTypes);
+				// need: topic1 ... topicn memsize memstart
+				utils().toSizeAfterFreeMemoryPointer();
+			}
 			m_context << logInstruction(numIndexed);
 			break;
 		}
@@ -1079,18 +1126,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				argument->accept(*this);
 				solAssert(argument->annotation().type, "");
 				argumentTypes.emplace_back(argument->annotation().type);
-				if (argument->annotation().type->category() == Type::Category::FixedBytes)
-					targetTypes.emplace_back(argument->annotation().type);
-				else if (
-					auto const* literalType = dynamic_cast<StringLiteralType const*>(argument->annotation().type);
-					literalType && literalType->value().size() <= 32
-				)
-					targetTypes.emplace_back(TypeProvider::fixedBytes(static_cast<unsigned>(literalType->value().size())));
-				else
-				{
-					solAssert(argument->annotation().type->isImplicitlyConvertibleTo(*TypeProvider::bytesMemory()), "");
-					targetTypes.emplace_back(TypeProvider::bytesMemory());
-				}
+				targetTypes.emplace_back(CompilerUtils::bytesConcatEncodingType(argument->annotation().type));
 			}
 			utils().fetchFreeMemoryPointer();
 			// stack: <arg1> <arg2> ... <argn> <free mem>
@@ -1304,7 +1340,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 		case FunctionType::Kind::ABIDecode:
 		{
 			arguments.front()->accept(*this);
-			Type const* firstArgType = arguments.front()->annotation().type;
+			Type const* firstArgType = m_context.relocatedParameters().type(*arguments.front());
 			TypePointers targetTypes;
 			if (TupleType const* targetTupleType = dynamic_cast<TupleType const*>(_functionCall.annotation().type))
 				targetTypes = targetTupleType->components();
@@ -1860,7 +1896,7 @@ bool ExpressionCompiler::visit(MemberAccess const& _memberAccess)
 	}
 	case Type::Category::Array:
 	{
-		auto const& type = dynamic_cast<ArrayType const&>(*_memberAccess.expression().annotation().type);
+		auto const& type = dynamic_cast<ArrayType const&>(*m_context.relocatedParameters().type(_memberAccess.expression()));
 		if (member == "length")
 		{
 			if (!type.isDynamicallySized())
@@ -1946,9 +1982,25 @@ bool ExpressionCompiler::visit(MemberAccess const& _memberAccess)
 bool ExpressionCompiler::visit(IndexAccess const& _indexAccess)
 {
 	CompilerContext::LocationSetter locationSetter(m_context, _indexAccess);
+	optional<u256> constantSlot = constantMappingValueSlot(
+		_indexAccess,
+		[&](VariableDeclaration const& _variable) -> optional<u256> {
+			if (!m_context.isStateVariable(&_variable))
+				return nullopt;
+			return m_context.storageLocationOfVariable(_variable).first;
+		}
+	);
+	if (constantSlot)
+	{
+		// The keys are constants, so the slot is known without evaluating the base and the key.
+		m_context << *constantSlot << u256(0);
+		setLValueToStorageItem(_indexAccess);
+		return false;
+	}
+
 	_indexAccess.baseExpression().accept(*this);
 
-	Type const& baseType = *_indexAccess.baseExpression().annotation().type;
+	Type const& baseType = *m_context.relocatedParameters().type(_indexAccess.baseExpression());
 
 	switch (baseType.category())
 	{
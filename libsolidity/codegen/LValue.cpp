@@ -37,7 +37,7 @@ using namespace solidity::util;
 
 
 StackVariable::StackVariable(CompilerContext& _compilerContext, VariableDeclaration const& _declaration):
-	LValue(_compilerContext, _declaration.annotation().type),
+	LValue(_compilerContext, _compilerContext.relocatedParameters().type(_declaration)),
 	m_baseStackOffset(m_context.baseStackOffsetOfVariable(_declaration)),
 	m_size(m_dataType->sizeOnStack())
 {
@@ -217,11 +217,22 @@ void StorageItem::retrieveValue(SourceLocation const&, bool _remove) const
 	if (m_dataType->storageBytes() == 32)
 		m_context << Instruction::POP << Instruction::SLOAD;
 	else
+	{
+		m_context << Instruction::SWAP1 << Instruction::SLOAD << Instruction::SWAP1;
+		retrieveValueFromSlotValue();
+	}
+}
+
+void StorageItem::retrieveValueFromSlotValue() const
+{
+	// stack: slot_value storage_offset
+	solAssert(m_dataType->isValueType(), "");
+	if (m_dataType->storageBytes() == 32)
+		m_context << Instruction::POP;
+	else
 	{
 		bool cleaned = false;
-		m_context
-			<< Instruction::SWAP1 << Instruction::SLOAD << Instruction::SWAP1
-			<< u256(0x100) << Instruction::EXP << Instruction::SWAP1 << Instruction::DIV;
+		m_context << u256(0x100) << Instruction::EXP << Instruction::SWAP1 << Instruction::DIV;
 		if (m_dataType->category() == Type::Category::FixedPoint)
 			// implementation should be very similar to the integer case.
 			solUnimplemented("Not yet implemented - FixedPointType.");
@@ -376,12 +387,27 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 			}
 			else
 			{
+				optional<u256> copiedSlot;
 				for (auto const& member: structType.members(nullptr))
 				{
 					// assign each member that can live outside of storage
 					Type const* memberType = member.type;
 					solAssert(memberType->nameable(), "");
 					Type const* sourceMemberType = sourceType.memberType(member.name);
+					if (sourceType.location() == DataLocation::Storage && memberType->isValueType())
+					{
+						// The layouts are the same and the slots of value members are not shared
+						// with other members, so they are copied as a whole, each only once.
+						u256 const slot = structType.storageOffsetsOfMember(member.name).first;
+						if (copiedSlot != slot)
+						{
+							// stack layout: source_ref target_ref
+							m_context << slot << Instruction::DUP3 << Instruction::ADD << Instruction::SLOAD;
+							m_context << slot << Instruction::DUP3 << Instruction::ADD << Instruction::SSTORE;
+							copiedSlot = slot;
+						}
+						continue;
+					}
 					if (sourceType.location() == DataLocation::Storage)
 					{
 						// stack layout: source_ref target_ref
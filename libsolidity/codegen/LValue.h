@@ -162,6 +162,10 @@ public:
 	StorageItem(CompilerContext& _compilerContext, Type const& _type);
 	unsigned sizeOnStack() const override { return 2; }
 	void retrieveValue(langutil::SourceLocation const& _location, bool _remove = false) const override;
+	/// Retrieves the value of a value type from the already loaded value of its storage slot.
+	/// Stack pre: slot_value storage_offset
+	/// Stack post: value
+	void retrieveValueFromSlotValue() const;
 	void storeValue(
 		Type const& _sourceType,
 		langutil::SourceLocation const& _location = {},
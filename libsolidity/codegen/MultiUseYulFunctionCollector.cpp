@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/Common.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
@@ -31,9 +32,27 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+shared_ptr<MultiUseYulFunctionCache::Entry const> MultiUseYulFunctionCache::find(string const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	return it == m_entries.end() ? nullptr : it->second;
+}
+
+void MultiUseYulFunctionCache::insert(vector<pair<string, shared_ptr<Entry const>>> _entries)
+{
+	lock_guard<mutex> lock(m_mutex);
+	for (auto& [key, entry]: _entries)
+		m_entries.emplace(move(key), move(entry));
+}
+
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
+	size_t size = 0;
+	for (auto const& function: m_requestedFunctions)
+		size += function.second.size();
 	string result;
+	result.reserve(size);
 	for (auto const& [name, code]: m_requestedFunctions)
 	{
 		solAssert(code != "<<STUB<<", "");
@@ -41,37 +60,201 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 		result += code;
 	}
 	m_requestedFunctions.clear();
+	m_cachedFunctions.clear();
+	m_dependencies.clear();
 	return result;
 }
 
+void MultiUseYulFunctionCollector::startRecording()
+{
+	solAssert(!m_recordedRequests && m_functionsBeingCreated.empty(), "");
+	m_recordedRequests.emplace();
+}
+
+vector<MultiUseYulFunctionCollector::Function> MultiUseYulFunctionCollector::stopRecording()
+{
+	solAssert(m_recordedRequests && m_functionsBeingCreated.empty(), "");
+	set<string> names;
+	vector<string> toVisit(m_recordedRequests->begin(), m_recordedRequests->end());
+	m_recordedRequests.reset();
+	while (!toVisit.empty())
+	{
+		string name = move(toVisit.back());
+		toVisit.pop_back();
+		if (!names.insert(name).second)
+			continue;
+		if (auto it = m_dependencies.find(name); it != m_dependencies.end())
+			toVisit.insert(toVisit.end(), it->second.begin(), it->second.end());
+	}
+
+	vector<Function> functions;
+	for (string const& name: names)
+	{
+		auto it = m_dependencies.find(name);
+		functions.emplace_back(Function{
+			name,
+			m_requestedFunctions.at(name),
+			it == m_dependencies.end() ? set<string>{} : it->second,
+			m_cachedFunctions.count(name) > 0
+		});
+	}
+	return functions;
+}
+
+void MultiUseYulFunctionCollector::addFunctions(vector<Function> const& _functions)
+{
+	for (Function const& function: _functions)
+	{
+		if (m_recordedRequests && m_functionsBeingCreated.empty())
+			m_recordedRequests->insert(function.name);
+		if (!m_requestedFunctions.emplace(function.name, function.code).second)
+			continue;
+		if (!function.dependencies.empty())
+			m_dependencies[function.name] = function.dependencies;
+		if (function.cached)
+			m_cachedFunctions.insert(function.name);
+	}
+}
+
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
+	noteRequest(_name);
+	if (m_cacheBatch)
+		m_cacheBatch->cacheable = false;
+	create(_name, _creator);
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::createFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return createFunction(_name, functionCreator(_name, _creator));
+}
+
+string MultiUseYulFunctionCollector::createCachedFunction(
+	string const& _name,
+	langutil::EVMVersion _evmVersion,
+	RevertStrings _revertStrings,
+	function<string()> const& _creator
+)
+{
+	if (!m_cache)
+		return createFunction(_name, _creator);
+
+	noteRequest(_name);
+
+	string const key = _name + "/" + _evmVersion.name() + "/" + revertStringsToString(_revertStrings);
+	if (m_cacheBatch)
 	{
-		m_requestedFunctions[_name] = "<<STUB<<";
+		m_cacheBatch->dependencies.back().push_back(key);
+		if (m_requestedFunctions.count(_name) && !m_cachedFunctions.count(_name))
+			m_cacheBatch->cacheable = false;
+	}
+
+	if (m_requestedFunctions.count(_name))
+		return _name;
+	if (auto entry = m_cache->find(key))
+	{
+		solAssert(entry->name == _name, "");
+		addFromCache(*entry);
+		return _name;
+	}
+
+	bool const outermost = !m_cacheBatch;
+	if (outermost)
+		m_cacheBatch.emplace();
+	try
+	{
+		m_cacheBatch->dependencies.emplace_back();
+		m_cachedFunctions.insert(_name);
+		create(_name, _creator);
+		m_cacheBatch->entries.emplace_back(key, make_shared<MultiUseYulFunctionCache::Entry const>(
+			MultiUseYulFunctionCache::Entry{_name, m_requestedFunctions.at(_name), move(m_cacheBatch->dependencies.back())}
+		));
+		m_cacheBatch->dependencies.pop_back();
+	}
+	catch (...)
+	{
+		if (outermost)
+			m_cacheBatch.reset();
+		throw;
+	}
+
+	if (outermost)
+	{
+		if (m_cacheBatch->cacheable)
+			m_cache->insert(move(m_cacheBatch->entries));
+		else
+			for (auto const& entry: m_cacheBatch->entries)
+				m_cachedFunctions.erase(entry.second->name);
+		m_cacheBatch.reset();
+	}
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::createCachedFunction(
+	string const& _name,
+	langutil::EVMVersion _evmVersion,
+	RevertStrings _revertStrings,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return createCachedFunction(_name, _evmVersion, _revertStrings, functionCreator(_name, _creator));
+}
+
+void MultiUseYulFunctionCollector::noteRequest(string const& _name)
+{
+	if (!m_functionsBeingCreated.empty())
+		m_dependencies[m_functionsBeingCreated.back()].insert(_name);
+	else if (m_recordedRequests)
+		m_recordedRequests->insert(_name);
+}
+
+void MultiUseYulFunctionCollector::create(string const& _name, function<string()> const& _creator)
+{
+	// The creator can add further functions, which does not invalidate the iterator.
+	auto [it, inserted] = m_requestedFunctions.try_emplace(_name, "<<STUB<<");
+	if (inserted)
+	{
+		m_functionsBeingCreated.push_back(_name);
+		ScopeGuard created{[&]() { m_functionsBeingCreated.pop_back(); }};
 		string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
-		m_requestedFunctions[_name] = std::move(fun);
+		it->second = std::move(fun);
 	}
-	return _name;
 }
 
-string MultiUseYulFunctionCollector::createFunction(
+void MultiUseYulFunctionCollector::addFromCache(MultiUseYulFunctionCache::Entry const& _entry)
+{
+	if (m_requestedFunctions.count(_entry.name))
+		return;
+	m_requestedFunctions[_entry.name] = _entry.code;
+	m_cachedFunctions.insert(_entry.name);
+	for (string const& key: _entry.dependencies)
+	{
+		shared_ptr<MultiUseYulFunctionCache::Entry const> dependency = m_cache->find(key);
+		solAssert(dependency, "Dependency of cached function missing.");
+		m_dependencies[_entry.name].insert(dependency->name);
+		addFromCache(*dependency);
+	}
+}
+
+function<string()> MultiUseYulFunctionCollector::functionCreator(
 	string const& _name,
 	function<string(vector<string>&, vector<string>&)> const& _creator
 )
 {
 	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions[_name] = "<<STUB<<";
+	return [&_name, &_creator]() {
 		vector<string> arguments;
 		vector<string> returnParameters;
 		string body = _creator(arguments, returnParameters);
 		solAssert(!body.empty(), "");
 
-		m_requestedFunctions[_name] = Whiskers(R"(
+		return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
@@ -79,8 +262,7 @@ string MultiUseYulFunctionCollector::createFunction(
 		("functionName", _name)
 		("args", joinHumanReadable(arguments))
 		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();;
-	}
-	return _name;
+		("body", move(body))
+		.render();
+	};
 }
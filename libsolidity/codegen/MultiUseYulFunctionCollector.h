@@ -22,13 +22,49 @@
 
 #pragma once
 
+#include <libsolidity/interface/DebugSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Functions created through MultiUseYulFunctionCollector::createCachedFunction, shared by the
+ * collectors of all contracts of a compilation, so that each of them is only rendered once.
+ * Can be used from several threads.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		std::string code;
+		/// Cache keys of the functions requested while creating this function.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the entry stored under @a _key, if any.
+	std::shared_ptr<Entry const> find(std::string const& _key) const;
+	/// Stores all entries of @a _entries at once, i.e. other threads either see none or all of them,
+	/// so that the dependencies of an entry are always present.
+	void insert(std::vector<std::pair<std::string, std::shared_ptr<Entry const>>> _entries);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Entry const>> m_entries;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -36,6 +72,20 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	/// A collected function together with the names of the functions it requested.
+	struct Function
+	{
+		std::string name;
+		std::string code;
+		std::set<std::string> dependencies;
+		/// True if the function is stored in the cache.
+		bool cached = false;
+	};
+
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<MultiUseYulFunctionCache> _cache = nullptr):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -46,6 +96,24 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Like createFunction, but takes the code from the cache if any collector sharing the cache
+	/// has created the function before. The code may only depend on the name of the function,
+	/// @a _evmVersion and @a _revertStrings. The function is not added to the cache if the creator
+	/// requests other functions through anything but createCachedFunction.
+	std::string createCachedFunction(
+		std::string const& _name,
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		std::function<std::string()> const& _creator
+	);
+
+	std::string createCachedFunction(
+		std::string const& _name,
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions.
 	/// Guarantees that the order of functions in the generated code is deterministic and
 	/// platform-independent.
@@ -56,9 +124,51 @@ public:
 	/// @returns true IFF a function with the specified name has already been collected.
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
+	/// Starts recording the functions that are requested from outside of any function creator.
+	void startRecording();
+	/// Stops recording and @returns the recorded functions together with all functions they
+	/// depend on, regardless of whether they were collected before the recording started.
+	std::vector<Function> stopRecording();
+	/// Adds the functions @a _functions that have not been collected yet. Together, they have to
+	/// include all their dependencies that have not been collected yet.
+	void addFunctions(std::vector<Function> const& _functions);
+
 private:
+	/// Cached functions created while creating the outermost cached function.
+	struct CacheBatch
+	{
+		/// For each cached function being created, the cache keys of the functions it requested.
+		std::vector<std::vector<std::string>> dependencies;
+		std::vector<std::pair<std::string, std::shared_ptr<MultiUseYulFunctionCache::Entry const>>> entries;
+		/// False if any of the functions requested a function that is not cached.
+		bool cacheable = true;
+	};
+
+	/// Records that @a _name is requested, either as a dependency of the function that is being
+	/// created or from outside.
+	void noteRequest(std::string const& _name);
+	/// Adds the function for @a _creator if it has not been created yet.
+	void create(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Adds the cached function @a _entry and all functions it depends on.
+	void addFromCache(MultiUseYulFunctionCache::Entry const& _entry);
+
+	static std::function<std::string()> functionCreator(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<MultiUseYulFunctionCache> m_cache;
+	/// Names of the functions in @a m_requestedFunctions that are or will be in the cache.
+	std::set<std::string> m_cachedFunctions;
+	std::optional<CacheBatch> m_cacheBatch;
+	/// Names of the functions requested by each function in @a m_requestedFunctions.
+	std::map<std::string, std::set<std::string>> m_dependencies;
+	/// Names of the functions that are being created, innermost last.
+	std::vector<std::string> m_functionsBeingCreated;
+	/// Names of the functions requested from outside since startRecording was called, if recording.
+	std::optional<std::set<std::string>> m_recordedRequests;
 };
 
 }
@@ -38,7 +38,7 @@ using namespace solidity::frontend;
 string YulUtilFunctions::combineExternalFunctionIdFunction()
 {
 	string functionName = "combine_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(addr, selector) -> combined {
 				combined := <shl64>(or(<shl32>(addr), and(selector, 0xffffffff)))
@@ -54,7 +54,7 @@ string YulUtilFunctions::combineExternalFunctionIdFunction()
 string YulUtilFunctions::splitExternalFunctionIdFunction()
 {
 	string functionName = "split_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(combined) -> addr, selector {
 				combined := <shr64>(combined)
@@ -72,7 +72,7 @@ string YulUtilFunctions::splitExternalFunctionIdFunction()
 string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 {
 	string functionName = "copy_" + string(_fromCalldata ? "calldata" : "memory") + "_to_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (_fromCalldata)
 		{
 			return Whiskers(R"(
@@ -87,6 +87,36 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 		}
 		else
 		{
+			optional<size_t> threshold = CompilerUtils::identityPrecompileCopyThreshold(m_evmVersion);
+			if (threshold)
+				return Whiskers(R"(
+					function <functionName>(src, dst, length) {
+						if iszero(lt(length, <threshold>))
+						{
+							// copy via the identity precompile
+							if iszero(staticcall(gas(), 4, src, length, dst, length)) { revert(0, 0) }
+							if and(length, 31)
+							{
+								// clear end
+								mstore(add(dst, length), 0)
+							}
+							leave
+						}
+						let i := 0
+						for { } lt(i, length) { i := add(i, 32) }
+						{
+							mstore(add(dst, i), mload(add(src, i)))
+						}
+						if gt(i, length)
+						{
+							// clear end
+							mstore(add(dst, length), 0)
+						}
+					}
+				)")
+				("functionName", functionName)
+				("threshold", to_string(*threshold))
+				.render();
 			return Whiskers(R"(
 				function <functionName>(src, dst, length) {
 					let i := 0
@@ -111,7 +141,7 @@ string YulUtilFunctions::copyLiteralToMemoryFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := <arrayAllocationFunction>(<size>)
@@ -130,7 +160,7 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 {
 	string functionName = "store_literal_in_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
 		vector<map<string, string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
@@ -156,7 +186,7 @@ string YulUtilFunctions::copyLiteralToStorageFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_storage_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"slot"};
 
 		if (_literal.size() >= 32)
@@ -208,7 +238,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 
 	solAssert(!_assert || !_messageType, "Asserts can't have messages!");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (!_messageType)
 			return Whiskers(R"(
 				function <functionName>(condition) {
@@ -251,10 +281,45 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 	});
 }
 
+string YulUtilFunctions::revertWithErrorFunction(
+	string const& _signature,
+	vector<Type const*> const& _parameterTypes,
+	vector<Type const*> const& _argumentTypes
+)
+{
+	string functionName = "revert_with_error_" + util::FixedHash<4>(util::keccak256(_signature)).hex();
+	for (Type const* argumentType: _argumentTypes)
+		functionName += "_" + argumentType->identifier();
+	functionName += "_to";
+	for (Type const* parameterType: _parameterTypes)
+		functionName += "_" + parameterType->identifier();
+
+	return createFunction(functionName, [&]() {
+		size_t argumentSlots = 0;
+		for (Type const* argumentType: _argumentTypes)
+			argumentSlots += argumentType->sizeOnStack();
+		string arguments = suffixedVariableNameList("argument_", 0, argumentSlots);
+		return Whiskers(R"(
+			function <functionName>(<arguments>) {
+				let memPtr := <allocateUnbounded>()
+				mstore(memPtr, <selector>)
+				let end := <encode>(add(memPtr, 4) <?+arguments>, <arguments></+arguments>)
+				revert(memPtr, sub(end, memPtr))
+			}
+		)")
+		("functionName", functionName)
+		("arguments", arguments)
+		("allocateUnbounded", allocateUnboundedFunction())
+		("selector", formatNumber(util::selectorFromSignature(_signature)))
+		("encode", ABIFunctions(m_evmVersion, m_revertStrings, m_functionCollector).tupleEncoder(_argumentTypes, _parameterTypes))
+		.render();
+	});
+}
+
 string YulUtilFunctions::leftAlignFunction(Type const& _type)
 {
 	string functionName = string("leftAlign_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> aligned {
 				<body>
@@ -316,7 +381,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 	solAssert(_numBits < 256, "");
 
 	string functionName = "shift_left_" + to_string(_numBits);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -339,7 +404,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 string YulUtilFunctions::shiftLeftFunctionDynamic()
 {
 	string functionName = "shift_left_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -365,7 +430,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 	// the opcodes SAR and SDIV behave differently with regards to rounding!
 
 	string functionName = "shift_right_" + to_string(_numBits) + "_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -388,7 +453,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 string YulUtilFunctions::shiftRightFunctionDynamic()
 {
 	string const functionName = "shift_right_unsigned_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -409,7 +474,7 @@ string YulUtilFunctions::shiftRightFunctionDynamic()
 string YulUtilFunctions::shiftRightSignedFunctionDynamic()
 {
 	string const functionName = "shift_right_signed_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> result {
@@ -440,7 +505,7 @@ string YulUtilFunctions::typedShiftLeftFunction(Type const& _type, Type const& _
 	solAssert(_amountType.category() == Type::Category::Integer, "");
 	solAssert(!dynamic_cast<IntegerType const&>(_amountType).isSigned(), "");
 	string const functionName = "shift_left_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -466,7 +531,7 @@ string YulUtilFunctions::typedShiftRightFunction(Type const& _type, Type const&
 	bool valueSigned = integerType && integerType->isSigned();
 
 	string const functionName = "shift_right_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -489,7 +554,7 @@ string YulUtilFunctions::updateByteSliceFunction(size_t _numBytes, size_t _shift
 	size_t numBits = _numBytes * 8;
 	size_t shiftBits = _shiftBytes * 8;
 	string functionName = "update_byte_slice_" + to_string(_numBytes) + "_shift_" + to_string(_shiftBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, toInsert) -> result {
@@ -511,7 +576,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 	solAssert(_numBytes <= 32, "");
 	size_t numBits = _numBytes * 8;
 	string functionName = "update_byte_slice_dynamic" + to_string(_numBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, shiftBytes, toInsert) -> result {
@@ -532,7 +597,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 string YulUtilFunctions::maskBytesFunctionDynamic()
 {
 	string functionName = "mask_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shr>(mul(8, bytes), not(0)))
@@ -548,7 +613,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 {
 	string functionName = "mask_lower_order_bytes_" + to_string(_bytes);
 	solAssert(_bytes <= 32, "");
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data) -> result {
 				result := and(data, <mask>)
@@ -562,7 +627,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 {
 	string functionName = "mask_lower_order_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shl>(mul(8, bytes), not(0)))
@@ -577,7 +642,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 string YulUtilFunctions::roundUpFunction()
 {
 	string functionName = "round_up_to_mul_of_32";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> result {
@@ -591,7 +656,7 @@ string YulUtilFunctions::roundUpFunction()
 
 string YulUtilFunctions::divide32CeilFunction()
 {
-	return m_functionCollector.createFunction(
+	return createFunction(
 		"divide_by_32_ceil",
 		[&](vector<string>& _args, vector<string>& _ret) {
 			_args = {"value"};
@@ -607,7 +672,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	// TODO: Consider to add a special case for unsigned 256-bit integers
 	//       and use the following instead:
 	//       sum := add(x, y) if lt(sum, x) { <panic>() }
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -635,10 +700,43 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	});
 }
 
+string YulUtilFunctions::overflowCheckedIntSumFunction(IntegerType const& _type, size_t _summands)
+{
+	solAssert(!_type.isSigned(), "");
+	solAssert(_summands >= 2, "");
+	// The sum of the values fits into 256 bits, so it is larger than the maximum value
+	// if and only if one of the partial sums is.
+	solAssert(_type.numBits() <= 248 && _summands <= 256, "");
+
+	string functionName = "checked_sum_" + to_string(_summands) + "_" + _type.identifier();
+	return createFunction(functionName, [&]() {
+		vector<map<string, string>> summands(_summands);
+		for (size_t i = 0; i < _summands; ++i)
+			summands[i]["name"] = "x_" + to_string(i + 1);
+
+		return
+			Whiskers(R"(
+			function <functionName>(<parameters>) -> sum {
+				<#summand>
+					sum := add(sum, <cleanupFunction>(<name>))
+				</summand>
+				if gt(sum, <maxValue>) { <panic>() }
+			}
+			)")
+			("functionName", functionName)
+			("parameters", suffixedVariableNameList("x_", 1, _summands + 1))
+			("summand", summands)
+			("maxValue", toCompactHexWithPrefix(u256(_type.maxValue())))
+			("cleanupFunction", cleanupFunction(_type))
+			("panic", panicFunction(PanicCode::UnderOverflow))
+			.render();
+	});
+}
+
 string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_add_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -654,7 +752,7 @@ string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "checked_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			// Multiplication by zero could be treated separately and directly return zero.
 			Whiskers(R"(
@@ -690,7 +788,7 @@ string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> product {
@@ -706,7 +804,7 @@ string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "checked_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -736,7 +834,7 @@ string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -757,7 +855,7 @@ string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::intModFunction(IntegerType const& _type)
 {
 	string functionName = "mod_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -778,7 +876,7 @@ string YulUtilFunctions::intModFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "checked_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -808,7 +906,7 @@ string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -829,7 +927,7 @@ string YulUtilFunctions::overflowCheckedIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "checked_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -866,7 +964,7 @@ string YulUtilFunctions::overflowCheckedIntLiteralExpFunction(
 
 	string functionName = "checked_exp_" + _baseType.richIdentifier() + "_" + _exponentType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]()
+	return createFunction(functionName, [&]()
 	{
 		// Converts a bigint number into u256 (negative numbers represented in two's complement form.)
 		// We assume that `_v` fits in 256 bits.
@@ -980,7 +1078,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 	solAssert(pow(bigint(306), 32) >= pow(bigint(2), 256), "");
 
 	string functionName = "checked_exp_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, max) -> power {
@@ -1028,7 +1126,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 string YulUtilFunctions::overflowCheckedSignedExpFunction()
 {
 	string functionName = "checked_exp_signed";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, min, max) -> power {
@@ -1084,7 +1182,7 @@ string YulUtilFunctions::overflowCheckedExpLoopFunction()
 	// This function does not include the final multiplication.
 
 	string functionName = "checked_exp_helper";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(_power, _base, exponent, max) -> power, base {
@@ -1123,7 +1221,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "wrapping_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -1142,7 +1240,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 {
 	string functionName = "array_length_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(value<?dynamic><?calldata>, len</calldata></dynamic>) -> length {
 				<?dynamic>
@@ -1184,7 +1282,7 @@ string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 string YulUtilFunctions::extractByteArrayLengthFunction()
 {
 	string functionName = "extract_byte_array_length";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(data) -> length {
 				length := div(data, 2)
@@ -1213,7 +1311,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 		return resizeDynamicByteArrayFunction(_type);
 
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
@@ -1252,7 +1350,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32, "");
 
 	string functionName = "cleanup_storage_array_end_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if lt(startIndex, len) {
@@ -1285,7 +1383,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 {
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "newLen"};
 		return Whiskers(R"(
 			let data := sload(array)
@@ -1312,7 +1410,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 	solAssert(_type.isDynamicallySized(), "");
 
 	string functionName = "clean_up_bytearray_end_slots_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if gt(len, 31) {
@@ -1333,7 +1431,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_decrease_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(newLen, 32)
@@ -1376,7 +1474,7 @@ string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_increase_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "data", "oldLen", "newLen"};
 		return Whiskers(R"(
 			if gt(newLen, <maxArrayLength>) { <panic>() }
@@ -1411,7 +1509,7 @@ string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _type)
 {
 	string functionName = "transit_byte_array_long_to_short_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, len) {
 				// we need to copy elements from old array to new
@@ -1431,7 +1529,7 @@ string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _t
 string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 {
 	string functionName = "extract_used_part_and_set_length_of_short_byte_array";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, len) -> used {
 				// we want to save only elements that are part of the array after resizing
@@ -1447,7 +1545,7 @@ string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 
 string YulUtilFunctions::longByteArrayStorageIndexAccessNoCheckFunction()
 {
-	return m_functionCollector.createFunction(
+	return createFunction(
 		"long_byte_array_index_access_no_checks",
 		[&](vector<string>& _args, vector<string>& _returnParams) {
 			_args = {"array", "index"};
@@ -1472,7 +1570,7 @@ string YulUtilFunctions::storageArrayPopFunction(ArrayType const& _type)
 		return storageByteArrayPopFunction(_type);
 
 	string functionName = "array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let oldLen := <fetchLength>(array)
@@ -1501,7 +1599,7 @@ string YulUtilFunctions::storageByteArrayPopFunction(ArrayType const& _type)
 	solAssert(_type.isByteArray(), "");
 
 	string functionName = "byte_array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let data := sload(array)
@@ -1547,12 +1645,13 @@ string YulUtilFunctions::storageArrayPushFunction(ArrayType const& _type, Type c
 	else if (_fromType->isValueType())
 		solUnimplementedAssert(*_fromType == *_type.baseType(), "");
 
-	string functionName =
-		string{"array_push_from_"} +
-		_fromType->identifier() +
-		"_to_" +
-		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	string functionName = util::concatenate({
+		"array_push_from_",
+		_fromType->identifier(),
+		"_to_",
+		_type.identifier()
+	});
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array <values>) {
 				<?isByteArray>
@@ -1616,7 +1715,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32, "Base type is not yet implemented.");
 
 	string functionName = "array_push_zero_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) -> slot, offset {
 				<?isBytes>
@@ -1645,7 +1744,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 string YulUtilFunctions::partialClearStorageSlotFunction()
 {
 	string functionName = "partial_clear_storage_slot";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 		function <functionName>(slot, offset) {
 			let mask := <shr>(mul(8, sub(32, offset)), <ones>)
@@ -1666,7 +1765,7 @@ string YulUtilFunctions::clearStorageRangeFunction(Type const& _type)
 
 	string functionName = "clear_storage_range_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(start, end) {
 				for {} lt(start, end) { start := add(start, <increment>) }
@@ -1697,7 +1796,7 @@ string YulUtilFunctions::clearStorageArrayFunction(ArrayType const& _type)
 
 	string functionName = "clear_storage_array_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(slot) {
 				<?dynamic>
@@ -1728,7 +1827,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 
 	string functionName = "clear_struct_storage_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		MemberList::MemberMap structMembers = _type.nativeMembers(nullptr);
 		vector<map<string, string>> memberSetValues;
 
@@ -1790,7 +1889,7 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 		return copyValueArrayStorageToStorageFunction(_fromType, _toType);
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return createFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
 				<?fromStorage> if eq(slot, value) { leave } </fromStorage>
@@ -1895,7 +1994,7 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 	solAssert(_toType.isByteArray(), "");
 
 	string functionName = "copy_byte_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return createFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, src<?fromCalldata>, len</fromCalldata>) {
 				<?fromStorage> if eq(slot, src) { leave } </fromStorage>
@@ -1978,7 +2077,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 	solAssert(_toType.storageStride() <= 32, "");
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return createFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(dst, src) {
 				if eq(dst, src) { leave }
@@ -2097,7 +2196,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 {
 	string functionName = "array_convert_length_to_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Type const& baseType = *_type.baseType();
 
 		switch (_type.location())
@@ -2151,7 +2250,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 {
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	string functionName = "array_allocation_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(length) -> size {
 				// Make sure we can allocate memory without overflow
@@ -2179,7 +2278,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 {
 	string functionName = "array_dataslot_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		// No special processing for calldata arrays, because they are stored as
 		// offset of the data area and length on the stack, so the offset already
 		// points to the data area.
@@ -2210,7 +2309,7 @@ string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "storage_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, index) -> slot, offset {
 				let arrayLength := <arrayLen>(array)
@@ -2255,7 +2354,7 @@ string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 string YulUtilFunctions::memoryArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "memory_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(baseRef, index) -> addr {
 				if iszero(lt(index, <arrayLen>(baseRef))) {
@@ -2282,7 +2381,7 @@ string YulUtilFunctions::calldataArrayIndexAccessFunction(ArrayType const& _type
 {
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "calldata_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref<?dynamicallySized>, length</dynamicallySized>, index) -> addr<?dynamicallySizedBase>, len</dynamicallySizedBase> {
 				if iszero(lt(index, <?dynamicallySized>length<!dynamicallySized><arrayLen></dynamicallySized>)) { <panic>() }
@@ -2309,7 +2408,7 @@ string YulUtilFunctions::calldataArrayIndexRangeAccess(ArrayType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	solAssert(_type.isDynamicallySized(), "");
 	string functionName = "calldata_array_index_range_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(offset, length, startIndex, endIndex) -> offsetOut, lengthOut {
 				if gt(startIndex, endIndex) { <revertSliceStartAfterEnd>() }
@@ -2331,7 +2430,7 @@ string YulUtilFunctions::accessCalldataTailFunction(Type const& _type)
 	solAssert(_type.isDynamicallyEncoded(), "");
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "access_calldata_tail_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref, ptr_to_tail) -> addr<?dynamicallySized>, length</dynamicallySized> {
 				let rel_offset_of_tail := calldataload(ptr_to_tail)
@@ -2362,7 +2461,7 @@ string YulUtilFunctions::nextArrayElementFunction(ArrayType const& _type)
 	if (_type.dataStoredIn(DataLocation::Storage))
 		solAssert(_type.baseType()->storageBytes() > 16, "");
 	string functionName = "array_nextElement_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(ptr) -> next {
 				next := add(ptr, <advance>)
@@ -2403,7 +2502,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 
 	string functionName = "copy_array_from_storage_to_memory_" + _from.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (_from.baseType()->isValueType())
 		{
 			solAssert(_from.baseType() == _to.baseType(), "");
@@ -2469,24 +2568,12 @@ string YulUtilFunctions::bytesConcatFunction(vector<Type const*> const& _argumen
 			argumentType->isImplicitlyConvertibleTo(*TypeProvider::fixedBytes(32)),
 			""
 		);
-		if (argumentType->category() == Type::Category::FixedBytes)
-			targetTypes.emplace_back(argumentType);
-		else if (
-			auto const* literalType = dynamic_cast<StringLiteralType const*>(argumentType);
-			literalType && literalType->value().size() <= 32
-		)
-			targetTypes.emplace_back(TypeProvider::fixedBytes(static_cast<unsigned>(literalType->value().size())));
-		else
-		{
-			solAssert(argumentType->isImplicitlyConvertibleTo(*TypeProvider::bytesMemory()), "");
-			targetTypes.emplace_back(TypeProvider::bytesMemory());
-		}
-
+		targetTypes.emplace_back(CompilerUtils::bytesConcatEncodingType(argumentType));
 		totalParams += argumentType->sizeOnStack();
 		functionName += "_" + argumentType->identifier();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<parameters>) -> outPtr {
 				outPtr := <allocateUnbounded>()
@@ -2514,7 +2601,7 @@ string YulUtilFunctions::bytesConcatFunction(vector<Type const*> const& _argumen
 string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingType, Type const& _keyType)
 {
 	string functionName = "mapping_index_access_" + _mappingType.identifier() + "_of_" + _keyType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (_mappingType.keyType()->isDynamicallySized())
 			return Whiskers(R"(
 				function <functionName>(slot <?+key>,</+key> <key>) -> dataSlot {
@@ -2566,12 +2653,13 @@ string YulUtilFunctions::readFromStorageDynamic(Type const& _type, bool _splitFu
 {
 	if (_type.isValueType())
 		return readFromStorageValueType(_type, {}, _splitFunctionTypes);
-	string functionName =
-		"read_from_storage__dynamic_" +
-		string(_splitFunctionTypes ? "split_" : "") +
-		_type.identifier();
+	string functionName = util::concatenate({
+		"read_from_storage__dynamic_",
+		(_splitFunctionTypes ? "split_" : ""),
+		_type.identifier()
+	});
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot, offset) -> value {
 				if gt(offset, 0) { <panic>() }
@@ -2599,7 +2687,7 @@ string YulUtilFunctions::readFromStorageValueType(Type const& _type, optional<si
 			"_" +
 			_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(slot<?dynamic>, offset</dynamic>) -> <?split>addr, selector<!split>value</split> {
 				<?split>let</split> value := <extract>(sload(slot)<?dynamic>, offset</dynamic>)
@@ -2641,26 +2729,50 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 	solAssert(structType.location() == DataLocation::Memory, "");
 	MemberList::MemberMap structMembers = structType.nativeMembers(nullptr);
 	vector<map<string, string>> memberSetValues(structMembers.size());
+	// The value members are extracted from a single load of the slot they share.
+	optional<u256> loadedSlotDiff;
 	for (size_t i = 0; i < structMembers.size(); ++i)
 	{
+		Type const& memberType = *structMembers[i].type;
 		auto const& [memberSlotDiff, memberStorageOffset] = structType.storageOffsetsOfMember(structMembers[i].name);
-		solAssert(structMembers[i].type->isValueType() || memberStorageOffset == 0, "");
+		solAssert(memberType.isValueType() || memberStorageOffset == 0, "");
 
-		memberSetValues[i]["setMember"] = Whiskers(R"(
+		Whiskers templ(R"(
+			<?loadSlot>let slotValue_<memberSlotDiff> := sload(add(slot, <memberSlotDiff>))</loadSlot>
 			{
-				let <memberValues> := <readFromStorage>(add(slot, <memberSlotDiff>))
+				<?isValueType>
+					let <memberValues> := <?split><splitFunction>(</split><extract>(slotValue_<memberSlotDiff>)<?split>)</split>
+				<!isValueType>
+					let <memberValues> := <readFromStorage>(add(slot, <memberSlotDiff>))
+				</isValueType>
 				<writeToMemory>(add(value, <memberMemoryOffset>), <memberValues>)
 			}
-		)")
-		("memberValues", suffixedVariableNameList("memberValue_", 0, structMembers[i].type->stackItems().size()))
-		("memberMemoryOffset", structType.memoryOffsetOfMember(structMembers[i].name).str())
-		("memberSlotDiff",  memberSlotDiff.str())
-		("readFromStorage", readFromStorage(*structMembers[i].type, memberStorageOffset, true))
-		("writeToMemory", writeToMemoryFunction(*structMembers[i].type))
-		.render();
+		)");
+		templ("memberValues", suffixedVariableNameList("memberValue_", 0, memberType.stackItems().size()));
+		templ("memberMemoryOffset", structType.memoryOffsetOfMember(structMembers[i].name).str());
+		templ("memberSlotDiff",  memberSlotDiff.str());
+		templ("writeToMemory", writeToMemoryFunction(memberType));
+		templ("isValueType", memberType.isValueType());
+		if (memberType.isValueType())
+		{
+			templ("loadSlot", loadedSlotDiff != memberSlotDiff);
+			loadedSlotDiff = memberSlotDiff;
+			templ("extract", extractFromStorageValue(memberType, memberStorageOffset));
+			auto const* funType = dynamic_cast<FunctionType const*>(&memberType);
+			bool split = funType && funType->kind() == FunctionType::Kind::External;
+			templ("split", split);
+			if (split)
+				templ("splitFunction", splitExternalFunctionIdFunction());
+		}
+		else
+		{
+			templ("loadSlot", false);
+			templ("readFromStorage", readFromStorage(memberType, memberStorageOffset, true));
+		}
+		memberSetValues[i]["setMember"] = templ.render();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot) -> value {
 				value := <allocStruct>()
@@ -2699,7 +2811,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 		"_to_" +
 		_toType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		if (_toType.isValueType())
 		{
 			solAssert(_fromType.isImplicitlyConvertibleTo(_toType), "");
@@ -2802,7 +2914,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 {
 	string const functionName = "write_to_memory_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		solAssert(!dynamic_cast<StringLiteralType const*>(&_type), "");
 		if (auto ref = dynamic_cast<ReferenceType const*>(&_type))
 		{
@@ -2859,7 +2971,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 	string functionName =
 		"extract_from_storage_value_dynamic" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value, offset) -> value {
 				value := <cleanupStorage>(<shr>(mul(offset, 8), slot_value))
@@ -2875,7 +2987,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 string YulUtilFunctions::extractFromStorageValue(Type const& _type, size_t _offset)
 {
 	string functionName = "extract_from_storage_value_offset_" + to_string(_offset) + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value) -> value {
 				value := <cleanupStorage>(<shr>(slot_value))
@@ -2893,7 +3005,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 	solAssert(_type.isValueType(), "");
 
 	string functionName = string("cleanup_from_storage_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				cleaned := <cleaned>
@@ -2930,7 +3042,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 {
 	string functionName = "prepare_store_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		solAssert(_type.isValueType(), "");
 		auto const* funType = dynamic_cast<FunctionType const*>(&_type);
 		if (funType && funType->kind() == FunctionType::Kind::External)
@@ -2966,7 +3078,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 string YulUtilFunctions::allocationFunction()
 {
 	string functionName = "allocate_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(size) -> memPtr {
 				memPtr := <allocateUnbounded>()
@@ -2983,7 +3095,7 @@ string YulUtilFunctions::allocationFunction()
 string YulUtilFunctions::allocateUnboundedFunction()
 {
 	string functionName = "allocate_unbounded";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := mload(<freeMemoryPointer>)
@@ -2998,7 +3110,7 @@ string YulUtilFunctions::allocateUnboundedFunction()
 string YulUtilFunctions::finalizeAllocationFunction()
 {
 	string functionName = "finalize_allocation";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(memPtr, size) {
 				let newFreePtr := add(memPtr, <roundUp>(size))
@@ -3027,7 +3139,7 @@ string YulUtilFunctions::zeroMemoryFunction(Type const& _type)
 	solAssert(_type.hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_memory_chunk_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				calldatacopy(dataStart, calldatasize(), dataSizeInBytes)
@@ -3043,7 +3155,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 	solAssert(!_type.baseType()->hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_complex_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		solAssert(_type.memoryStride() == 32, "");
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
@@ -3062,7 +3174,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					let allocSize := <allocSize>(length)
@@ -3083,7 +3195,7 @@ string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					memPtr := <allocArray>(length)
@@ -3108,7 +3220,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType cons
 string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <alloc>(<allocSize>)
@@ -3125,7 +3237,7 @@ string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <allocStruct>()
@@ -3174,7 +3286,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return createFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(<?external>addr, </external>functionId) -> <?external>outAddr, </external>outFunctionId {
 					<?external>outAddr := addr</external>
@@ -3213,7 +3325,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return createFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(offset, length) -> outOffset, outLength {
 					outOffset := offset
@@ -3239,12 +3351,13 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 	if (_from.sizeOnStack() != 1 || _to.sizeOnStack() != 1)
 		return conversionFunctionSpecial(_from, _to);
 
-	string functionName =
-		"convert_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	string functionName = util::concatenate({
+		"convert_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier()
+	});
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> converted {
 				<body>
@@ -3459,7 +3572,7 @@ string YulUtilFunctions::bytesToFixedBytesConversionFunction(ArrayType const& _f
 	solAssert(_from.isByteArray() && !_from.isString(), "");
 	solAssert(_from.isDynamicallySized(), "");
 	string functionName = "convert_bytes_to_fixedbytes_from_" + _from.identifier() + "_to_" + _to.identifier();
-	return m_functionCollector.createFunction(functionName, [&](auto& _args, auto& _returnParams) {
+	return createFunction(functionName, [&](auto& _args, auto& _returnParams) {
 		_args = { "array" };
 		bool fromCalldata = _from.dataStoredIn(DataLocation::CallData);
 		if (fromCalldata)
@@ -3517,13 +3630,14 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 	solAssert(_to.dataStoredIn(DataLocation::Storage), "");
 	solAssert(_from.structDefinition() == _to.structDefinition(), "");
 
-	string functionName =
-		"copy_struct_to_storage_from_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier();
+	string functionName = util::concatenate({
+		"copy_struct_to_storage_from_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier()
+	});
 
-	return m_functionCollector.createFunction(functionName, [&](auto& _arguments, auto&) {
+	return createFunction(functionName, [&](auto& _arguments, auto&) {
 		_arguments = {"slot", "value"};
 		Whiskers templ(R"(
 			<?fromStorage> if iszero(eq(slot, value)) { </fromStorage>
@@ -3538,16 +3652,14 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 
 		MemberList::MemberMap structMembers = _from.nativeMembers(nullptr);
 		MemberList::MemberMap toStructMembers = _to.nativeMembers(nullptr);
+		bool fromCalldata = _from.location() == DataLocation::CallData;
+		bool fromMemory = _from.location() == DataLocation::Memory;
+		bool fromStorage = _from.location() == DataLocation::Storage;
 
-		vector<map<string, string>> memberParams(structMembers.size());
-		for (size_t i = 0; i < structMembers.size(); ++i)
-		{
-			Type const& memberType = *structMembers[i].type;
-			solAssert(memberType.memoryHeadSize() == 32, "");
-			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[i].name);
-
+		// @returns code that declares the values of the member at @a _index of the source.
+		auto readMember = [&](size_t _index) {
+			Type const& memberType = *structMembers[_index].type;
 			Whiskers t(R"(
-				let memberSlot := add(slot, <memberStorageSlotDiff>)
 				let memberSrcPtr := add(value, <memberOffset>)
 
 				<?fromCalldata>
@@ -3568,29 +3680,17 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 				</fromMemory>
 
 				<?fromStorage>
-					let <memberValues> :=
-						<?isValueType>
-							<read>(memberSrcPtr)
-						<!isValueType>
-							memberSrcPtr
-						</isValueType>
+					let <memberValues> := memberSrcPtr
 				</fromStorage>
-
-				<updateStorageValue>(memberSlot, <memberValues>)
 			)");
-			bool fromCalldata = _from.location() == DataLocation::CallData;
 			t("fromCalldata", fromCalldata);
-			bool fromMemory = _from.location() == DataLocation::Memory;
 			t("fromMemory", fromMemory);
-			bool fromStorage = _from.location() == DataLocation::Storage;
 			t("fromStorage", fromStorage);
 			t("isValueType", memberType.isValueType());
 			t("memberValues", suffixedVariableNameList("memberValue_", 0, memberType.stackItems().size()));
-
-			t("memberStorageSlotDiff", slotDiff.str());
 			if (fromCalldata)
 			{
-				t("memberOffset", to_string(_from.calldataOffsetOfMember(structMembers[i].name)));
+				t("memberOffset", to_string(_from.calldataOffsetOfMember(structMembers[_index].name)));
 				t("dynamicallyEncodedMember", memberType.isDynamicallyEncoded());
 				if (memberType.isDynamicallyEncoded())
 					t("accessCalldataTail", accessCalldataTailFunction(memberType));
@@ -3599,25 +3699,92 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 			}
 			else if (fromMemory)
 			{
-				t("memberOffset", _from.memoryOffsetOfMember(structMembers[i].name).str());
+				t("memberOffset", _from.memoryOffsetOfMember(structMembers[_index].name).str());
 				t("read", readFromMemory(memberType));
 			}
 			else if (fromStorage)
 			{
-				auto const& [srcSlotOffset, srcOffset] = _from.storageOffsetsOfMember(structMembers[i].name);
+				solAssert(!memberType.isValueType(), "");
+				auto const& [srcSlotOffset, srcOffset] = _from.storageOffsetsOfMember(structMembers[_index].name);
+				solAssert(srcOffset == 0, "");
 				t("memberOffset", formatNumber(srcSlotOffset));
-				if (memberType.isValueType())
-					t("read", readFromStorageValueType(memberType, srcOffset, false));
-				else
-					solAssert(srcOffset == 0, "");
+			}
+			return t.render();
+		};
 
+		vector<map<string, string>> memberParams;
+		for (size_t i = 0; i < structMembers.size(); ++i)
+		{
+			Type const& memberType = *structMembers[i].type;
+			solAssert(memberType.memoryHeadSize() == 32, "");
+			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[i].name);
+
+			if (!memberType.isValueType())
+			{
+				memberParams.push_back({{"updateMemberCall", Whiskers(R"(
+					let memberSlot := add(slot, <memberStorageSlotDiff>)
+					<readMember>
+					<updateStorageValue>(memberSlot, <memberValues>)
+				)")
+				("memberStorageSlotDiff", slotDiff.str())
+				("readMember", readMember(i))
+				("memberValues", suffixedVariableNameList("memberValue_", 0, memberType.stackItems().size()))
+				("updateStorageValue", updateStorageValueFunction(
+					memberType,
+					*toStructMembers[i].type,
+					optional<unsigned>{offset}
+				))
+				.render()}});
+				continue;
 			}
-			t("updateStorageValue", updateStorageValueFunction(
-				memberType,
-				*toStructMembers[i].type,
-				optional<unsigned>{offset}
-			));
-			memberParams[i]["updateMemberCall"] = t.render();
+
+			// The slot is shared by value members only, which are all assigned, so it is
+			// composed from their values and written once, or copied as a whole from storage.
+			size_t groupEnd = i + 1;
+			while (
+				groupEnd < structMembers.size() &&
+				structMembers[groupEnd].type->isValueType() &&
+				_to.storageOffsetsOfMember(structMembers[groupEnd].name).first == slotDiff
+			)
+				groupEnd++;
+
+			vector<map<string, string>> packedMembers;
+			if (!fromStorage)
+				for (size_t j = i; j < groupEnd; ++j)
+				{
+					Type const& toMemberType = *toStructMembers[j].type;
+					packedMembers.push_back({
+						{"readMember", readMember(j)},
+						{"memberValues", suffixedVariableNameList("memberValue_", 0, structMembers[j].type->sizeOnStack())},
+						{"convertedValues", suffixedVariableNameList("convertedValue_", 0, toMemberType.sizeOnStack())},
+						{"convert", conversionFunction(*structMembers[j].type, toMemberType)},
+						{"update", updateByteSliceFunction(
+							toMemberType.storageBytes(),
+							_to.storageOffsetsOfMember(structMembers[j].name).second
+						)},
+						{"prepare", prepareStoreFunction(toMemberType)}
+					});
+				}
+			memberParams.push_back({{"updateMemberCall", Whiskers(R"(
+				<?fromStorage>
+					sstore(add(slot, <memberStorageSlotDiff>), sload(add(value, <memberStorageSlotDiff>)))
+				<!fromStorage>
+					let slotValue := 0
+					<#packedMember>
+					{
+						<readMember>
+						let <convertedValues> := <convert>(<memberValues>)
+						slotValue := <update>(slotValue, <prepare>(<convertedValues>))
+					}
+					</packedMember>
+					sstore(add(slot, <memberStorageSlotDiff>), slotValue)
+				</fromStorage>
+			)")
+			("fromStorage", fromStorage)
+			("memberStorageSlotDiff", slotDiff.str())
+			("packedMember", packedMembers)
+			.render()}});
+			i = groupEnd - 1;
 		}
 		templ("member", memberParams);
 
@@ -3641,13 +3808,14 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 			"Invalid conversion to storage type."
 		);
 
-	string functionName =
-		"convert_array_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier();
+	string functionName = util::concatenate({
+		"convert_array_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier()
+	});
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value<?fromCalldataDynamic>, length</fromCalldataDynamic>) -> converted <?toCalldataDynamic>, outLength</toCalldataDynamic> {
 				<body>
@@ -3710,7 +3878,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 string YulUtilFunctions::cleanupFunction(Type const& _type)
 {
 	string functionName = string("cleanup_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				<body>
@@ -3804,10 +3972,19 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 	});
 }
 
+bool YulUtilFunctions::cleanupIsIdentity(Type const& _type)
+{
+	if (auto const* integerType = dynamic_cast<IntegerType const*>(&_type))
+		return integerType->numBits() == 256;
+	else if (auto const* fixedBytesType = dynamic_cast<FixedBytesType const*>(&_type))
+		return fixedBytesType->numBytes() == 32;
+	return false;
+}
+
 string YulUtilFunctions::validatorFunction(Type const& _type, bool _revertOnFailure)
 {
 	string functionName = string("validator_") + (_revertOnFailure ? "revert_" : "assert_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) {
 				if iszero(<condition>) { <failure> }
@@ -3871,7 +4048,7 @@ string YulUtilFunctions::packedHashFunction(
 	size_t sizeOnStack = 0;
 	for (Type const* t: _givenTypes)
 		sizeOnStack += t->sizeOnStack();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<variables>) -> hash {
 				let pos := <allocateUnbounded>()
@@ -3892,7 +4069,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 {
 	bool forward = m_evmVersion.supportsReturndata();
 	string functionName = "revert_forward_" + to_string(forward);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (forward)
 			return Whiskers(R"(
 				function <functionName>() {
@@ -3922,7 +4099,7 @@ std::string YulUtilFunctions::decrementCheckedFunction(Type const& _type)
 
 	string const functionName = "decrement_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3945,7 +4122,7 @@ std::string YulUtilFunctions::decrementWrappingFunction(Type const& _type)
 
 	string const functionName = "decrement_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(value, 1))
@@ -3964,7 +4141,7 @@ std::string YulUtilFunctions::incrementCheckedFunction(Type const& _type)
 
 	string const functionName = "increment_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3987,7 +4164,7 @@ std::string YulUtilFunctions::incrementWrappingFunction(Type const& _type)
 
 	string const functionName = "increment_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(add(value, 1))
@@ -4006,7 +4183,7 @@ string YulUtilFunctions::negateNumberCheckedFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -4029,7 +4206,7 @@ string YulUtilFunctions::negateNumberWrappingFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(0, value))
@@ -4047,7 +4224,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 
 	string const functionName = "zero_value_for_" + string(_splitFunctionTypes ? "split_" : "") + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		FunctionType const* fType = dynamic_cast<FunctionType const*>(&_type);
 		if (fType && fType->kind() == FunctionType::Kind::External && _splitFunctionTypes)
 			return Whiskers(R"(
@@ -4120,7 +4297,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 {
 	string const functionName = "storage_set_to_zero_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		if (_type.isValueType())
 			return Whiskers(R"(
 				function <functionName>(slot, offset) {
@@ -4162,12 +4339,13 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 
 string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const& _to)
 {
-	string functionName =
-		"convert_" +
-		_from.identifier() +
-		"_to_" +
-		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	string functionName = util::concatenate({
+		"convert_",
+		_from.identifier(),
+		"_to_",
+		_to.identifier()
+	});
+	return createFunction(functionName, [&]() {
 		if (
 			auto fromTuple = dynamic_cast<TupleType const*>(&_from), toTuple = dynamic_cast<TupleType const*>(&_to);
 			fromTuple && toTuple && fromTuple->components().size() == toTuple->components().size()
@@ -4250,16 +4428,17 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 
 string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromCalldata)
 {
-	string functionName =
-		string("read_from_") +
-		(_fromCalldata ? "calldata" : "memory") +
-		_type.identifier();
+	string functionName = util::concatenate({
+		"read_from_",
+		(_fromCalldata ? "calldata" : "memory"),
+		_type.identifier()
+	});
 
 	// TODO use ABI functions for handling calldata
 	if (_fromCalldata)
 		solAssert(!_type.isDynamicallyEncoded(), "");
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return createFunction(functionName, [&] {
 		if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		{
 			solAssert(refType->sizeOnStack() == 1, "");
@@ -4319,7 +4498,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 string YulUtilFunctions::revertReasonIfDebugFunction(string const& _message)
 {
 	string functionName = "revert_error_" + util::toHex(util::keccak256(_message).asBytes());
-	return m_functionCollector.createFunction(functionName, [&](auto&, auto&) -> string {
+	return createFunction(functionName, [&](auto&, auto&) -> string {
 		return revertReasonIfDebugBody(m_revertStrings, allocateUnboundedFunction() + "()", _message);
 	});
 }
@@ -4367,7 +4546,7 @@ string YulUtilFunctions::revertReasonIfDebugBody(
 string YulUtilFunctions::panicFunction(util::PanicCode _code)
 {
 	string functionName = "panic_error_" + toCompactHexWithPrefix(uint64_t(_code));
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() {
 				mstore(0, <selector>)
@@ -4387,7 +4566,7 @@ string YulUtilFunctions::returnDataSelectorFunction()
 	string const functionName = "return_data_selector";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> sig {
 				if gt(returndatasize(), 3) {
@@ -4407,7 +4586,7 @@ string YulUtilFunctions::tryDecodeErrorMessageFunction()
 	string const functionName = "try_decode_error_message";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> ret {
 				if lt(returndatasize(), 0x44) { leave }
@@ -4446,7 +4625,7 @@ string YulUtilFunctions::tryDecodePanicDataFunction()
 	string const functionName = "try_decode_panic_data";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> success, data {
 				if gt(returndatasize(), 0x23) {
@@ -4465,7 +4644,7 @@ string YulUtilFunctions::extractReturndataFunction()
 {
 	string const functionName = "extract_returndata";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> data {
 				<?supportsReturndata>
@@ -4502,7 +4681,7 @@ string YulUtilFunctions::copyConstructorArgumentsToMemoryFunction(
 		"_" +
 		toString(_contract.id());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		string returnParams = suffixedVariableNameList("ret_param_",0, CompilerUtils::sizeOnStack(_contract.constructor()->parameters()));
 		ABIFunctions abiFunctions(m_evmVersion, m_revertStrings, m_functionCollector);
 
@@ -4530,7 +4709,7 @@ string YulUtilFunctions::externalCodeFunction()
 {
 	string functionName = "external_code_at";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return createFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>(addr) -> mpos {
 				let length := extcodesize(addr)
@@ -4543,3 +4722,16 @@ string YulUtilFunctions::externalCodeFunction()
 		.render();
 	});
 }
+
+string YulUtilFunctions::createFunction(string const& _name, function<string()> const& _creator)
+{
+	return m_functionCollector.createCachedFunction(_name, m_evmVersion, m_revertStrings, _creator);
+}
+
+string YulUtilFunctions::createFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return m_functionCollector.createCachedFunction(_name, m_evmVersion, m_revertStrings, _creator);
+}
@@ -30,6 +30,7 @@
 
 #include <libsolutil/ErrorCodes.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -89,6 +90,17 @@ public:
 	// `assert` or `require` call.
 	std::string requireOrAssertFunction(bool _assert, Type const* _messageType = nullptr);
 
+	/// @returns the name of a function that reverts with the ABI encoding of the error with
+	/// the signature @a _signature and the given arguments, converted to @a _parameterTypes.
+	/// The function is shared by all reverts with the same error and argument types, which
+	/// includes all reverts with the same string literal as message.
+	/// signature: (arguments...) ->
+	std::string revertWithErrorFunction(
+		std::string const& _signature,
+		std::vector<Type const*> const& _parameterTypes,
+		std::vector<Type const*> const& _argumentTypes
+	);
+
 	/// @returns the name of a function that takes a (cleaned) value of the given value type and
 	/// left-aligns it, usually for use in non-padded encoding.
 	std::string leftAlignFunction(Type const& _type);
@@ -144,6 +156,11 @@ public:
 	std::string overflowCheckedIntAddFunction(IntegerType const& _type);
 	/// signature: (x, y) -> sum
 	std::string wrappingIntAddFunction(IntegerType const& _type);
+	/// @returns the name of a function that adds @a _summands values of the unsigned integer
+	/// type @a _type and performs a single overflow check on the result. Requires that the sum
+	/// cannot exceed 256 bits.
+	/// signature: (x_1, ..., x_n) -> sum
+	std::string overflowCheckedIntSumFunction(IntegerType const& _type, size_t _summands);
 
 	/// signature: (x, y) -> product
 	std::string overflowCheckedIntMulFunction(IntegerType const& _type);
@@ -437,6 +454,10 @@ public:
 	/// if there is no reasonable way to clean a value.
 	std::string cleanupFunction(Type const& _type);
 
+	/// @returns true if every value of the given type is clean, i.e. the cleanup and the
+	/// validator function do nothing, as for types taking all 256 bits.
+	static bool cleanupIsIdentity(Type const& _type);
+
 	/// @returns the name of the validator function for the given type and
 	/// adds its implementation to the requested functions.
 	/// @param _revertOnFailure if true, causes revert on invalid data,
@@ -591,6 +612,14 @@ private:
 	/// signature: (array, index)
 	std::string longByteArrayStorageIndexAccessNoCheckFunction();
 
+	/// Creates the function @a _name through the collector, where it is shared with other
+	/// contracts if the collector has a cache.
+	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	std::string createFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings m_revertStrings;
 	MultiUseYulFunctionCollector& m_functionCollector;
@@ -56,6 +56,11 @@ string IRNames::modifierInvocation(ModifierInvocation const& _modifierInvocation
 	return "modifier_" + modifierName + "_" + to_string(_modifierInvocation.id());
 }
 
+string IRNames::modifierGuard(ModifierDefinition const& _modifier)
+{
+	return "modifier_guard_" + _modifier.name() + "_" + to_string(_modifier.id());
+}
+
 string IRNames::functionWithModifierInner(FunctionDefinition const& _function)
 {
 	return "fun_" + _function.name() + "_" + to_string(_function.id()) + "_inner";
@@ -50,6 +50,7 @@ struct IRNames
 	static std::string function(FunctionDefinition const& _function);
 	static std::string function(VariableDeclaration const& _varDecl);
 	static std::string modifierInvocation(ModifierInvocation const& _modifierInvocation);
+	static std::string modifierGuard(ModifierDefinition const& _modifier);
 	static std::string functionWithModifierInner(FunctionDefinition const& _function);
 	static std::string creationObject(ContractDefinition const& _contract);
 	static std::string deployedObject(ContractDefinition const& _contract);
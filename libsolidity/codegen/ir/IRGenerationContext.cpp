@@ -65,7 +65,7 @@ ContractDefinition const& IRGenerationContext::mostDerivedContract() const
 IRVariable const& IRGenerationContext::addLocalVariable(VariableDeclaration const& _varDecl)
 {
 	auto const& [it, didInsert] = m_localVariables.emplace(
-		std::make_pair(&_varDecl, IRVariable{_varDecl})
+		std::make_pair(&_varDecl, IRVariable{IRNames::localVariable(_varDecl), *m_relocatedParameters->type(_varDecl)})
 	);
 	solAssert(didInsert, "Local variable added multiple times.");
 	return it->second;
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <libsolidity/analysis/CalldataParameterRelocator.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/ir/IRVariable.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -68,11 +69,17 @@ public:
 	IRGenerationContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr,
+		std::shared_ptr<RelocatedParameters const> _relocatedParameters = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
-		m_optimiserSettings(std::move(_optimiserSettings))
+		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_relocatedParameters(
+			_relocatedParameters ? std::move(_relocatedParameters) : std::make_shared<RelocatedParameters const>()
+		),
+		m_functions(std::move(_functionCache))
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
@@ -94,6 +101,10 @@ public:
 	ContractDefinition const& mostDerivedContract() const;
 
 
+	/// @returns the parameters of external functions that are kept in calldata. The types of these
+	/// parameters and of the identifiers referring to them have to be taken from here.
+	RelocatedParameters const& relocatedParameters() const { return *m_relocatedParameters; }
+
 	IRVariable const& addLocalVariable(VariableDeclaration const& _varDecl);
 	bool isLocalVariable(VariableDeclaration const& _varDecl) const { return m_localVariables.count(&_varDecl); }
 	IRVariable const& localVariable(VariableDeclaration const& _varDecl);
@@ -154,6 +165,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings m_revertStrings;
 	OptimiserSettings m_optimiserSettings;
+	/// Parameters of external functions that are kept in calldata.
+	std::shared_ptr<RelocatedParameters const> m_relocatedParameters;
 	ContractDefinition const* m_mostDerivedContract = nullptr;
 	std::map<VariableDeclaration const*, IRVariable> m_localVariables;
 	/// Memory offsets reserved for the values of immutable variables during contract creation.
@@ -29,6 +29,7 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/DispatchPlan.h>
 
 #include <libyul/AssemblyStack.h>
 #include <libyul/Utilities.h>
@@ -86,11 +87,77 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+/// @returns true if the placeholder statement is the last statement of the body of @a _modifier
+/// and the only one in it and if the modifier does not contain return statements, i.e. if the
+/// modifier only runs code before the function body.
+bool isModifierGuard(ModifierDefinition const& _modifier)
+{
+	struct Counter: ASTConstVisitor
+	{
+		bool visit(PlaceholderStatement const&) override { ++placeholders; return false; }
+		bool visit(Return const&) override { ++returns; return false; }
+		size_t placeholders = 0;
+		size_t returns = 0;
+	};
+
+	vector<ASTPointer<Statement>> const& statements = _modifier.body().statements();
+	if (statements.empty() || !dynamic_cast<PlaceholderStatement const*>(statements.back().get()))
+		return false;
+	Counter counter;
+	_modifier.body().accept(counter);
+	return counter.placeholders == 1 && counter.returns == 0;
+}
+
+/// @returns code that executes the call in @a _calls whose function ID is equal to the variable
+/// ``fun`` and panics via @a _panic if there is none. The IDs have to be in ascending order.
+/// Like the selectors of the external dispatch, the IDs are searched by a binary search that
+/// switches to comparing with each ID for few IDs or few expected executions.
+string internalDispatchSelection(
+	vector<pair<int64_t, string>> const& _calls,
+	string const& _panic,
+	size_t _runs
+)
+{
+	if (DispatchPlan::split(_calls.size(), _runs))
+	{
+		auto pivot = _calls.begin() + static_cast<ptrdiff_t>(_calls.size() / 2);
+		return Whiskers(R"(switch lt(fun, <pivot>)
+			case 0
+			{
+				<larger>
+			}
+			default
+			{
+				<smaller>
+			})")
+		("pivot", to_string(pivot->first))
+		("larger", internalDispatchSelection({pivot, _calls.end()}, _panic, _runs))
+		("smaller", internalDispatchSelection({_calls.begin(), pivot}, _panic, _runs))
+		.render();
+	}
+
+	Whiskers t(R"(switch fun
+		<#cases>
+		case <funID>
+		{
+			<call>
+		}
+		</cases>
+		default { <panic>() })");
+	vector<map<string, string>> cases;
+	for (auto const& [id, call]: _calls)
+		cases.emplace_back(map<string, string>{{"funID", to_string(id)}, {"call", call}});
+	t("cases", move(cases));
+	t("panic", _panic);
+	return t.render();
+}
+
 }
 
-pair<string, string> IRGenerator::run(
+tuple<string, string, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	bool _optimize
 )
 {
 	string const ir = yul::reindent(generate(_contract, _otherYulSources));
@@ -103,7 +170,6 @@ pair<string, string> IRGenerator::run(
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
 
 	string warning =
 		"/*******************************************************\n"
@@ -113,7 +179,14 @@ pair<string, string> IRGenerator::run(
 		" *                !USE AT YOUR OWN RISK!               *\n"
 		" *******************************************************/\n\n";
 
-	return {warning + ir, warning + asmStack.print()};
+	if (!_optimize)
+		return {warning + ir, {}, nullptr};
+
+	asmStack.setParallelism(m_parallelism);
+	asmStack.setFunctionExecutionsPerDeployment(m_functionExecutionsPerDeployment);
+	asmStack.setObjectCache(m_objectCache);
+	asmStack.optimize();
+	return {warning + ir, warning + asmStack.print(), asmStack.parserResult()};
 }
 
 string IRGenerator::generate(
@@ -258,22 +331,16 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 		m_context.functionCollector().createFunction(funName, [&]() {
 			Whiskers templ(R"(
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
-					switch fun
-					<#cases>
-					case <funID>
-					{
-						<?+out> <out> :=</+out> <name>(<in>)
-					}
-					</cases>
-					default { <panic>() }
+					<selection>
 				}
 			)");
 			templ("functionName", funName);
-			templ("panic", m_utils.panicFunction(PanicCode::InvalidInternalFunction));
-			templ("in", suffixedVariableNameList("in_", 0, arity.in));
-			templ("out", suffixedVariableNameList("out_", 0, arity.out));
+			string in = suffixedVariableNameList("in_", 0, arity.in);
+			string out = suffixedVariableNameList("out_", 0, arity.out);
+			templ("in", in);
+			templ("out", out);
 
-			vector<map<string, string>> cases;
+			vector<pair<int64_t, string>> calls;
 			for (FunctionDefinition const* function: internalDispatchMap.at(arity))
 			{
 				solAssert(function, "");
@@ -286,13 +353,17 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 				solAssert(function->id() != 0, "Unexpected function ID: 0");
 				solAssert(m_context.functionCollector().contains(IRNames::function(*function)), "");
 
-				cases.emplace_back(map<string, string>{
-					{"funID", to_string(function->id())},
-					{"name", IRNames::function(*function)}
-				});
+				calls.emplace_back(
+					function->id(),
+					(out.empty() ? "" : out + " := ") + IRNames::function(*function) + "(" + in + ")"
+				);
 			}
 
-			templ("cases", move(cases));
+			templ("selection", internalDispatchSelection(
+				calls,
+				m_utils.panicFunction(PanicCode::InvalidInternalFunction),
+				m_optimiserSettings.expectedExecutionsPerDeployment
+			));
 			return templ.render();
 		});
 	}
@@ -309,6 +380,19 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::function(_function);
+	if (auto executions = m_optimiserSettings.profiledExecutions(
+		_function.sourceUnitName(),
+		_function.annotation().contract ? _function.annotation().contract->name() : "",
+		_function.name()
+	))
+	{
+		// The modifiers and the function body are generated as separate functions.
+		m_functionExecutionsPerDeployment[functionName] = *executions;
+		if (!_function.modifiers().empty())
+			m_functionExecutionsPerDeployment[IRNames::functionWithModifierInner(_function)] = *executions;
+		for (auto const& modifier: _function.modifiers())
+			m_functionExecutionsPerDeployment[IRNames::modifierInvocation(*modifier)] = *executions;
+	}
 	return m_context.functionCollector().createFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
@@ -430,18 +514,55 @@ string IRGenerator::generateModifier(
 			}
 
 		t("evalArgs", expressionEvaluator.code());
-		IRGeneratorForStatements generator(m_context, m_utils, [&]() {
+		auto callNextFunction = [&]() {
 			string ret = joinHumanReadable(retParams);
 			return
 				(ret.empty() ? "" : ret + " := ") +
 				_nextFunction + "(" + joinHumanReadable(params) + ")\n";
-		});
-		generator.generate(modifier->body());
-		t("body", generator.code());
+		};
+		if (isModifierGuard(*modifier))
+		{
+			vector<string> modifierParams;
+			for (auto const& varDecl: modifier->parameters())
+				modifierParams += m_context.localVariable(*varDecl).stackSlots();
+			t("body",
+				generateModifierGuard(*modifier) + "(" + joinHumanReadable(modifierParams) + ")\n" +
+				callNextFunction()
+			);
+		}
+		else
+		{
+			IRGeneratorForStatements generator(m_context, m_utils, callNextFunction);
+			generator.generate(modifier->body());
+			t("body", generator.code());
+		}
 		return t.render();
 	});
 }
 
+string IRGenerator::generateModifierGuard(ModifierDefinition const& _modifier)
+{
+	string functionName = IRNames::modifierGuard(_modifier);
+	return m_context.functionCollector().createFunction(functionName, [&]() {
+		m_context.resetLocalVariables();
+		vector<string> params;
+		for (auto const& varDecl: _modifier.parameters())
+			params += m_context.addLocalVariable(*varDecl).stackSlots();
+		// The placeholder statement is the last statement, so nothing is run after it.
+		IRGeneratorForStatements generator(m_context, m_utils, []() { return string{}; });
+		generator.generate(_modifier.body());
+		return Whiskers(R"(
+			function <functionName>(<params>) {
+				<body>
+			}
+		)")
+		("functionName", functionName)
+		("params", joinHumanReadable(params))
+		("body", generator.code())
+		.render();
+	});
+}
+
 string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::functionWithModifierInner(_function);
@@ -840,37 +961,87 @@ string IRGenerator::callValueCheck()
 	return "if callvalue() { " + m_utils.revertReasonIfDebugFunction("Ether sent to non-payable function") + "() }";
 }
 
+namespace
+{
+
+/// @returns code that executes the one of @a _cases whose selector is equal to the variable
+/// ``selector`` or falls through if there is none. The selectors in @a _prefix are compared
+/// first in the given order and only then the sorted selectors @a _ids are searched.
+string dispatchSelection(
+	vector<FixedHash<4>> const& _prefix,
+	vector<FixedHash<4>> const& _ids,
+	map<FixedHash<4>, map<string, string>> const& _cases,
+	size_t _runs
+)
+{
+	Whiskers t(R"X(switch selector
+		<#cases>
+		case <functionSelector>
+		{
+			// <functionName>
+			<delegatecallCheck>
+			<callValueCheck>
+			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
+			<?+retParams>let <retParams> := </+retParams> <function>(<params>)
+			let memPos := <allocateUnbounded>()
+			let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
+			return(memPos, sub(memEnd, memPos))
+		}
+		</cases>
+		default {<default>})X");
+	vector<map<string, string>> cases;
+	for (auto const& id: _prefix)
+		cases.emplace_back(_cases.at(id));
+	if (DispatchPlan::split(_ids.size(), _runs))
+	{
+		size_t pivotIndex = _ids.size() / 2;
+		vector<FixedHash<4>> smaller{_ids.begin(), _ids.begin() + static_cast<ptrdiff_t>(pivotIndex)};
+		vector<FixedHash<4>> larger{_ids.begin() + static_cast<ptrdiff_t>(pivotIndex), _ids.end()};
+		string search = Whiskers(R"X(switch lt(selector, <pivot>)
+			case 0
+			{
+				<larger>
+			}
+			default
+			{
+				<smaller>
+			})X")
+		("pivot", "0x" + _ids.at(pivotIndex).hex())
+		("larger", dispatchSelection({}, larger, _cases, _runs))
+		("smaller", dispatchSelection({}, smaller, _cases, _runs))
+		.render();
+		if (cases.empty())
+			return search;
+		t("default", "\n" + search + "\n");
+	}
+	else
+	{
+		for (auto const& id: _ids)
+			cases.emplace_back(_cases.at(id));
+		t("default", "");
+	}
+	t("cases", move(cases));
+	return t.render();
+}
+
+}
+
 string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 {
 	Whiskers t(R"X(
 		if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
-			case <functionSelector>
-			{
-				// <functionName>
-				<delegatecallCheck>
-				<callValueCheck>
-				<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
-				<?+retParams>let <retParams> := </+retParams> <function>(<params>)
-				let memPos := <allocateUnbounded>()
-				let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
-				return(memPos, sub(memEnd, memPos))
-			}
-			</cases>
-			default {}
+			<selection>
 		}
 		if iszero(calldatasize()) { <receiveEther> }
 		<fallback>
 	)X");
 	t("shr224", m_utils.shiftRightFunction(224));
-	vector<map<string, string>> functions;
+	map<FixedHash<4>, map<string, string>> functions;
 	for (auto const& function: _contract.interfaceFunctions())
 	{
-		functions.emplace_back();
-		map<string, string>& templ = functions.back();
+		map<string, string>& templ = functions[function.first];
 		templ["functionSelector"] = "0x" + function.first.hex();
 		FunctionTypePointer const& type = function.second;
 		templ["functionName"] = type->externalSignature();
@@ -889,11 +1060,15 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		templ["delegatecallCheck"] = delegatecallCheck;
 		templ["callValueCheck"] = (type->isPayable() || _contract.isLibrary()) ? "" : callValueCheck();
 
-		unsigned paramVars = make_shared<TupleType>(type->parameterTypes())->sizeOnStack();
+		// Parameters kept in calldata are decoded as calldata references.
+		TypePointers parameterTypes = type->parameterTypes();
+		if (auto const* function = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
+			parameterTypes = m_context.relocatedParameters().parameterTypes(*function);
+		unsigned paramVars = make_shared<TupleType>(parameterTypes)->sizeOnStack();
 		unsigned retVars = make_shared<TupleType>(type->returnParameterTypes())->sizeOnStack();
 
 		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
-		templ["abiDecode"] = abiFunctions.tupleDecoder(type->parameterTypes());
+		templ["abiDecode"] = abiFunctions.tupleDecoder(parameterTypes);
 		templ["params"] = suffixedVariableNameList("param_", 0, paramVars);
 		templ["retParams"] = suffixedVariableNameList("ret_", 0, retVars);
 
@@ -907,7 +1082,13 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		templ["allocateUnbounded"] = m_utils.allocateUnboundedFunction();
 		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary());
 	}
-	t("cases", functions);
+	DispatchPlan plan(_contract, m_optimiserSettings);
+	t("selection", dispatchSelection(
+		plan.hotSelectors,
+		plan.sortedSelectors,
+		functions,
+		m_optimiserSettings.expectedExecutionsPerDeployment
+	));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -978,7 +1159,13 @@ void IRGenerator::resetContext(ContractDefinition const& _contract)
 		m_context.internalDispatchClean(),
 		"Reset internal dispatch map without consuming it."
 	);
-	m_context = IRGenerationContext(m_evmVersion, m_context.revertStrings(), m_optimiserSettings);
+	m_context = IRGenerationContext(
+		m_evmVersion,
+		m_context.revertStrings(),
+		m_optimiserSettings,
+		m_functionCache,
+		m_relocatedParameters
+	);
 
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
@@ -29,7 +29,16 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Object;
+class OptimizedObjectCache;
+}
 
 namespace solidity::frontend
 {
@@ -39,24 +48,52 @@ class SourceUnit;
 class IRGenerator
 {
 public:
+	/// @param _functionCache cache of utility functions shared with the code generation of other contracts.
+	/// @param _objectCache cache of optimized sub-objects shared with the code generation of other contracts.
+	/// @param _relocatedParameters parameters of external functions that are kept in calldata.
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		size_t _parallelism = 1,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr,
+		std::shared_ptr<yul::OptimizedObjectCache> _objectCache = nullptr,
+		std::shared_ptr<RelocatedParameters const> _relocatedParameters = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
-		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
+		m_parallelism(_parallelism),
+		m_functionCache(_functionCache),
+		m_objectCache(std::move(_objectCache)),
+		m_relocatedParameters(_relocatedParameters),
+		m_context(
+			_evmVersion,
+			_revertStrings,
+			std::move(_optimiserSettings),
+			std::move(_functionCache),
+			std::move(_relocatedParameters)
+		),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
 	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// (or just pretty-printed, depending on the optimizer settings),
+	/// together with the parsed and analyzed object the optimized form was printed from.
+	/// The optimized form is empty and the object is null if @a _optimize is false.
+	std::tuple<std::string, std::string, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		bool _optimize = true
 	);
 
+	/// @returns the expected number of executions per deployment of the Yul functions generated
+	/// for the functions in the execution profile of the optimiser settings, indexed by their
+	/// Yul names. Filled by run().
+	std::map<std::string, size_t> const& functionExecutionsPerDeployment() const
+	{
+		return m_functionExecutionsPerDeployment;
+	}
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -80,6 +117,11 @@ private:
 		FunctionDefinition const& _function,
 		std::string const& _nextFunction
 	);
+	/// Generates the code of a modifier whose placeholder statement is the last statement of
+	/// its body and that cannot return early as a function shared by all its invocations.
+	/// Takes the parameters of the modifier.
+	/// @returns the name of the function.
+	std::string generateModifierGuard(ModifierDefinition const& _modifier);
 	std::string generateFunctionWithModifierInner(FunctionDefinition const& _function);
 	/// Generates a getter for the given declaration and returns its name
 	std::string generateGetter(VariableDeclaration const& _varDecl);
@@ -116,9 +158,14 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_parallelism;
+	std::shared_ptr<MultiUseYulFunctionCache> const m_functionCache;
+	std::shared_ptr<yul::OptimizedObjectCache> const m_objectCache;
+	std::shared_ptr<RelocatedParameters const> const m_relocatedParameters;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	std::map<std::string, size_t> m_functionExecutionsPerDeployment;
 };
 
 }
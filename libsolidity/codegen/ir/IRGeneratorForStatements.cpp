@@ -28,6 +28,7 @@
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/ConstantStorageSlots.h>
 #include <libsolidity/codegen/ReturnInfo.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTUtils.h>
@@ -47,8 +48,11 @@
 #include <libsolutil/FunctionSelector.h>
 #include <libsolutil/Visitor.h>
 
+#include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -203,6 +207,117 @@ private:
 	ExternalRefsMap const& m_references;
 };
 
+/**
+ * Checks whether a statement allocates memory that cannot be referenced after the statement,
+ * so that the free memory pointer can be reset to its value before the statement.
+ *
+ * This is the case if the statement does not store references to memory anywhere but in its
+ * temporaries, i.e. it does not declare or assign to variables or members of reference type
+ * and does not call internal functions, which could store the references in their arguments.
+ */
+class TemporaryMemoryChecker: private ASTConstVisitor
+{
+public:
+	/// @returns true if the memory allocated by @a _statement can be released after it.
+	static bool releasable(Statement const& _statement)
+	{
+		TemporaryMemoryChecker checker;
+		_statement.accept(checker);
+		return checker.m_allocates && !checker.m_escapes;
+	}
+
+private:
+	static bool onlyValueTypes(Type const* _type)
+	{
+		if (auto const* tupleType = dynamic_cast<TupleType const*>(_type))
+			return ranges::all_of(tupleType->components(), [](Type const* _component) {
+				return !_component || _component->isValueType();
+			});
+		return _type && _type->isValueType();
+	}
+
+	bool visit(VariableDeclaration const& _variable) override
+	{
+		if (!_variable.type()->isValueType())
+			m_escapes = true;
+		return true;
+	}
+	bool visit(Assignment const& _assignment) override
+	{
+		if (!onlyValueTypes(_assignment.leftHandSide().annotation().type))
+			m_escapes = true;
+		return true;
+	}
+	bool visit(UnaryOperation const& _operation) override
+	{
+		if (_operation.getOperator() == Token::Delete && !onlyValueTypes(_operation.subExpression().annotation().type))
+			m_escapes = true;
+		return true;
+	}
+	bool visit(TupleExpression const& _tuple) override
+	{
+		if (_tuple.isInlineArray())
+			m_allocates = true;
+		return true;
+	}
+	bool visit(NewExpression const&) override
+	{
+		m_allocates = true;
+		return true;
+	}
+	bool visit(InlineAssembly const&) override
+	{
+		m_escapes = true;
+		return false;
+	}
+	bool visit(FunctionCall const& _functionCall) override
+	{
+		switch (*_functionCall.annotation().kind)
+		{
+		case FunctionCallKind::StructConstructorCall:
+			m_allocates = true;
+			break;
+		case FunctionCallKind::TypeConversion:
+			if (auto const* referenceType = dynamic_cast<ReferenceType const*>(_functionCall.annotation().type))
+				if (referenceType->location() == DataLocation::Memory)
+					m_allocates = true;
+			break;
+		case FunctionCallKind::FunctionCall:
+		{
+			auto const& functionType = dynamic_cast<FunctionType const&>(*_functionCall.expression().annotation().type);
+			switch (functionType.kind())
+			{
+			case FunctionType::Kind::Internal:
+			case FunctionType::Kind::Declaration:
+				m_escapes = true;
+				break;
+			case FunctionType::Kind::External:
+			case FunctionType::Kind::DelegateCall:
+			case FunctionType::Kind::BareCall:
+			case FunctionType::Kind::BareCallCode:
+			case FunctionType::Kind::BareDelegateCall:
+			case FunctionType::Kind::BareStaticCall:
+			case FunctionType::Kind::Creation:
+			case FunctionType::Kind::BytesConcat:
+			case FunctionType::Kind::ABIEncode:
+			case FunctionType::Kind::ABIEncodePacked:
+			case FunctionType::Kind::ABIEncodeWithSelector:
+			case FunctionType::Kind::ABIEncodeWithSignature:
+				m_allocates = true;
+				break;
+			default:
+				break;
+			}
+			break;
+		}
+		}
+		return true;
+	}
+
+	bool m_allocates = false;
+	bool m_escapes = false;
+};
+
 }
 
 string IRGeneratorForStatements::code() const
@@ -334,6 +449,23 @@ string IRGeneratorForStatements::constantValueFunction(VariableDeclaration const
 	}
 }
 
+bool IRGeneratorForStatements::visit(ExpressionStatement const& _expressionStatement)
+{
+	startReleasingTemporaryMemory(_expressionStatement);
+	return true;
+}
+
+void IRGeneratorForStatements::endVisit(ExpressionStatement const&)
+{
+	releaseTemporaryMemory();
+}
+
+bool IRGeneratorForStatements::visit(VariableDeclarationStatement const& _varDeclStatement)
+{
+	startReleasingTemporaryMemory(_varDeclStatement);
+	return true;
+}
+
 void IRGeneratorForStatements::endVisit(VariableDeclarationStatement const& _varDeclStatement)
 {
 	setLocation(_varDeclStatement);
@@ -365,6 +497,8 @@ void IRGeneratorForStatements::endVisit(VariableDeclarationStatement const& _var
 				declare(m_context.addLocalVariable(*decl));
 				initializeLocalVar(*decl);
 			}
+
+	releaseTemporaryMemory();
 }
 
 bool IRGeneratorForStatements::visit(Conditional const& _conditional)
@@ -745,6 +879,23 @@ bool IRGeneratorForStatements::visit(BinaryOperation const& _binOp)
 		return false; // skip sub-expressions
 	}
 
+	if (vector<Expression const*> summands = mergeableCheckedSummands(_binOp); !summands.empty())
+	{
+		for (Expression const* summand: summands)
+			summand->accept(*this);
+		setLocation(_binOp);
+
+		vector<string> arguments;
+		for (Expression const* summand: summands)
+			arguments.emplace_back(expressionAsType(*summand, *commonType));
+		define(_binOp) <<
+			m_utils.overflowCheckedIntSumFunction(dynamic_cast<IntegerType const&>(*commonType), summands.size()) <<
+			"(" <<
+			joinHumanReadable(arguments) <<
+			")\n";
+		return false;
+	}
+
 	_binOp.leftExpression().accept(*this);
 	_binOp.rightExpression().accept(*this);
 	setLocation(_binOp);
@@ -826,6 +977,28 @@ bool IRGeneratorForStatements::visit(BinaryOperation const& _binOp)
 	return false;
 }
 
+bool IRGeneratorForStatements::visit(FunctionCall const& _functionCall)
+{
+	// A shortcut for keccak256(abi.encodePacked(...)) and keccak256(bytes.concat(...)). We skip
+	// the inner call, which would allocate the encoding, and only visit its arguments.
+	// The hash is computed in endVisit.
+	if (
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		*_functionCall.annotation().kind == FunctionCallKind::FunctionCall &&
+		functionType &&
+		functionType->kind() == FunctionType::Kind::KECCAK256
+	)
+		if (FunctionCall const* encodingCall = packedEncodingCall(*_functionCall.arguments().front()))
+		{
+			_functionCall.expression().accept(*this);
+			for (ASTPointer<Expression const> const& argument: encodingCall->arguments())
+				argument->accept(*this);
+			return false;
+		}
+
+	return true;
+}
+
 void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 {
 	setLocation(_functionCall);
@@ -987,14 +1160,36 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			}
 		}
 		solAssert(indexedArgs.size() <= 4, "Too many indexed arguments.");
-		Whiskers templ(R"({
-			let <pos> := <allocateUnbounded>()
-			let <end> := <encode>(<pos> <nonIndexedArgs>)
-			<log>(<pos>, sub(<end>, <pos>) <indexedArgs>)
-		})");
-		templ("pos", m_context.newYulVariable());
-		templ("end", m_context.newYulVariable());
-		templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
+		// Data of at most two value types is encoded into the scratch space,
+		// which avoids reading the free memory pointer.
+		bool const useScratchSpace =
+			nonIndexedParamTypes.size() <= 2 &&
+			ranges::all_of(nonIndexedParamTypes, [](Type const* _type) {
+				return _type->isValueType();
+			});
+		Whiskers templ(
+			useScratchSpace ?
+			R"({
+				<?hasData>pop(<encode>(0 <nonIndexedArgs>))</hasData>
+				<log>(0, <dataSize> <indexedArgs>)
+			})" :
+			R"({
+				let <pos> := <allocateUnbounded>()
+				let <end> := <encode>(<pos> <nonIndexedArgs>)
+				<log>(<pos>, sub(<end>, <pos>) <indexedArgs>)
+			})"
+		);
+		if (useScratchSpace)
+		{
+			templ("hasData", !nonIndexedParamTypes.empty());
+			templ("dataSize", to_string(32 * nonIndexedParamTypes.size()));
+		}
+		else
+		{
+			templ("pos", m_context.newYulVariable());
+			templ("end", m_context.newYulVariable());
+			templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
+		}
 		templ("encode", abi.tupleEncoder(nonIndexedArgTypes, nonIndexedParamTypes));
 		templ("nonIndexedArgs", joinHumanReadablePrefixed(nonIndexedArgs));
 		templ("log", "log" + to_string(indexedArgs.size()));
@@ -1131,7 +1326,8 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			<?+retVars>let <retVars> := </+retVars> <abiDecode>(<offset>, add(<offset>, <length>))
 		)");
 
-		Type const* firstArgType = arguments.front()->annotation().type;
+		IRVariable const firstArgument = expressionVariable(*arguments.front());
+		Type const* firstArgType = &firstArgument.type();
 		TypePointers targetTypes;
 
 		if (TupleType const* targetTupleType = dynamic_cast<TupleType const*>(_functionCall.annotation().type))
@@ -1145,14 +1341,14 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			)
 		{
 			solAssert(referenceType->isImplicitlyConvertibleTo(*TypeProvider::bytesCalldata()), "");
-			IRVariable var = convert(*arguments[0], *TypeProvider::bytesCalldata());
+			IRVariable var = convert(firstArgument, *TypeProvider::bytesCalldata());
 			templ("abiDecode", m_context.abiFunctions().tupleDecoder(targetTypes, false));
 			templ("offset", var.part("offset").name());
 			templ("length", var.part("length").name());
 		}
 		else
 		{
-			IRVariable var = convert(*arguments[0], *TypeProvider::bytesMemory());
+			IRVariable var = convert(firstArgument, *TypeProvider::bytesMemory());
 			templ("abiDecode", m_context.abiFunctions().tupleDecoder(targetTypes, true));
 			templ("offset", "add(" + var.part("mpos").name() + ", 32)");
 			templ("length",
@@ -1202,7 +1398,38 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 
 		ArrayType const* arrayType = TypeProvider::bytesMemory();
 
-		if (auto const* stringLiteral = dynamic_cast<StringLiteralType const*>(arguments.front()->annotation().type))
+		if (FunctionCall const* encodingCall = packedEncodingCall(*arguments.front()))
+		{
+			// Optimization: Hash the result of abi.encodePacked and bytes.concat where it
+			// is encoded instead of allocating it, or at compile-time if it is constant.
+			if (optional<string> constantEncoding = constantPackedEncoding(*encodingCall))
+				define(_functionCall) << ("0x" + keccak256(*constantEncoding).hex()) << "\n";
+			else
+			{
+				bool const isConcat =
+					dynamic_cast<FunctionType const&>(type(encodingCall->expression())).kind() ==
+					FunctionType::Kind::BytesConcat;
+				TypePointers argumentTypes;
+				TypePointers targetTypes;
+				vector<string> argumentVars;
+				for (ASTPointer<Expression const> const& argument: encodingCall->arguments())
+				{
+					argumentTypes.emplace_back(&type(*argument));
+					targetTypes.emplace_back(
+						isConcat ?
+						CompilerUtils::bytesConcatEncodingType(&type(*argument)) :
+						type(*argument).fullEncodingType(false, true, true)
+					);
+					argumentVars += IRVariable(*argument).stackSlots();
+				}
+				define(_functionCall) <<
+					m_utils.packedHashFunction(argumentTypes, targetTypes) <<
+					"(" <<
+					joinHumanReadable(argumentVars) <<
+					")\n";
+			}
+		}
+		else if (auto const* stringLiteral = dynamic_cast<StringLiteralType const*>(arguments.front()->annotation().type))
 		{
 			// Optimization: Compute keccak256 on string literals at compile-time.
 			define(_functionCall) <<
@@ -1211,7 +1438,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		}
 		else
 		{
-			auto array = convert(*arguments[0], *arrayType);
+			auto array = convert(expressionVariable(*arguments[0]), *arrayType);
 
 			define(_functionCall) <<
 				"keccak256(" <<
@@ -1833,7 +2060,8 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 	}
 	case Type::Category::Array:
 	{
-		auto const& type = dynamic_cast<ArrayType const&>(*_memberAccess.expression().annotation().type);
+		IRVariable const array = expressionVariable(_memberAccess.expression());
+		auto const& type = dynamic_cast<ArrayType const&>(array.type());
 		if (member == "length")
 		{
 			// shortcut for <address>.code.length
@@ -1851,7 +2079,7 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 				define(_memberAccess) <<
 					m_utils.arrayLengthFunction(type) <<
 					"(" <<
-					IRVariable(_memberAccess.expression()).commaSeparatedList() <<
+					array.commaSeparatedList() <<
 					")\n";
 		}
 		else if (member == "pop" || member == "push")
@@ -2027,11 +2255,38 @@ bool IRGeneratorForStatements::visit(InlineAssembly const& _inlineAsm)
 	return false;
 }
 
+bool IRGeneratorForStatements::visit(IndexAccess const& _indexAccess)
+{
+	optional<u256> constantSlot = constantMappingValueSlot(
+		_indexAccess,
+		[&](VariableDeclaration const& _variable) -> optional<u256> {
+			if (!m_context.isStateVariable(_variable))
+				return nullopt;
+			return m_context.storageLocationOfStateVariable(_variable).first;
+		}
+	);
+	if (!constantSlot)
+		return true;
+
+	// The keys are constants, so the slot is known without evaluating the base and the key.
+	setLocation(_indexAccess);
+	string slot = m_context.newYulVariable();
+	m_code << "let " << slot << " := " << formatNumber(*constantSlot) << "\n";
+	setLValue(_indexAccess, IRLValue{
+		*_indexAccess.annotation().type,
+		IRLValue::Storage{
+			slot,
+			0u
+		}
+	});
+	return false;
+}
 
 void IRGeneratorForStatements::endVisit(IndexAccess const& _indexAccess)
 {
 	setLocation(_indexAccess);
-	Type const& baseType = *_indexAccess.baseExpression().annotation().type;
+	IRVariable const base = expressionVariable(_indexAccess.baseExpression());
+	Type const& baseType = base.type();
 
 	if (baseType.category() == Type::Category::Mapping)
 	{
@@ -2112,7 +2367,7 @@ void IRGeneratorForStatements::endVisit(IndexAccess const& _indexAccess)
 				string const indexAccessFunctionCall =
 					m_utils.calldataArrayIndexAccessFunction(arrayType) +
 					"(" +
-					IRVariable(_indexAccess.baseExpression()).commaSeparatedList() +
+					base.commaSeparatedList() +
 					", " +
 					expressionAsType(*_indexAccess.indexExpression(), *TypeProvider::uint256()) +
 					")";
@@ -2317,7 +2572,7 @@ void IRGeneratorForStatements::handleVariableReference(
 		});
 	else if (m_context.isLocalVariable(_variable))
 		setLValue(_referencingExpression, IRLValue{
-			*_variable.annotation().type,
+			m_context.localVariable(_variable).type(),
 			IRLValue::Stack{m_context.localVariable(_variable)}
 		});
 	else if (m_context.isStateVariable(_variable))
@@ -2658,6 +2913,55 @@ void IRGeneratorForStatements::appendSimpleUnaryOperation(UnaryOperation const&
 		")\n";
 }
 
+vector<Expression const*> IRGeneratorForStatements::mergeableCheckedSummands(BinaryOperation const& _binOp) const
+{
+	Type const* commonType = _binOp.annotation().commonType;
+	auto const* integerType = dynamic_cast<IntegerType const*>(commonType);
+	if (
+		_binOp.getOperator() != Token::Add ||
+		m_context.arithmetic() != Arithmetic::Checked ||
+		!integerType ||
+		integerType->isSigned() ||
+		integerType->numBits() > 248
+	)
+		return {};
+
+	auto isAddition = [&](Expression const& _expression) {
+		auto const* binOp = dynamic_cast<BinaryOperation const*>(&_expression);
+		return
+			binOp &&
+			binOp->getOperator() == Token::Add &&
+			binOp->annotation().commonType == commonType;
+	};
+	auto hasNoSideEffects = [](Expression const& _expression) {
+		if (dynamic_cast<Literal const*>(&_expression))
+			return true;
+		auto const* identifier = dynamic_cast<Identifier const*>(&_expression);
+		return identifier && dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+	};
+
+	// The summands are collected from the end of the chain. There are at most 255 of them
+	// including the first two, so that their sum fits into 256 bits.
+	size_t const maxSummands = 255;
+	vector<Expression const*> summands;
+	BinaryOperation const* current = &_binOp;
+	while (
+		summands.size() + 2 < maxSummands &&
+		isAddition(current->leftExpression()) &&
+		hasNoSideEffects(current->rightExpression())
+	)
+	{
+		summands.emplace_back(&current->rightExpression());
+		current = &dynamic_cast<BinaryOperation const&>(current->leftExpression());
+	}
+	if (summands.empty())
+		return {};
+	summands.emplace_back(&current->rightExpression());
+	summands.emplace_back(&current->leftExpression());
+	reverse(summands.begin(), summands.end());
+	return summands;
+}
+
 string IRGeneratorForStatements::binaryOperation(
 	langutil::Token _operator,
 	Type const& _type,
@@ -2914,7 +3218,7 @@ void IRGeneratorForStatements::setLValue(Expression const& _expression, IRLValue
 	}
 	else
 		// Only define the expression, if it will not be written to.
-		define(_expression, readFromLValue(_lvalue));
+		define(expressionVariable(_expression), readFromLValue(_lvalue));
 }
 
 void IRGeneratorForStatements::generateLoop(
@@ -2969,6 +3273,13 @@ Type const& IRGeneratorForStatements::type(Expression const& _expression)
 	return *_expression.annotation().type;
 }
 
+IRVariable IRGeneratorForStatements::expressionVariable(Expression const& _expression) const
+{
+	Type const* expressionType = m_context.relocatedParameters().type(_expression);
+	solAssert(expressionType, "Type of expression not set.");
+	return IRVariable(IRNames::localVariable(_expression), *expressionType);
+}
+
 bool IRGeneratorForStatements::visit(TryStatement const& _tryStatement)
 {
 	Expression const& externalCall = _tryStatement.externalCall();
@@ -3082,17 +3393,6 @@ void IRGeneratorForStatements::revertWithError(
 	vector<ASTPointer<Expression const>> const& _errorArguments
 )
 {
-	Whiskers templ(R"({
-		let <pos> := <allocateUnbounded>()
-		mstore(<pos>, <hash>)
-		let <end> := <encode>(add(<pos>, 4) <argumentVars>)
-		revert(<pos>, sub(<end>, <pos>))
-	})");
-	templ("pos", m_context.newYulVariable());
-	templ("end", m_context.newYulVariable());
-	templ("hash", util::selectorFromSignature(_signature).str());
-	templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
-
 	vector<string> errorArgumentVars;
 	vector<Type const*> errorArgumentTypes;
 	for (ASTPointer<Expression const> const& arg: _errorArguments)
@@ -3101,10 +3401,11 @@ void IRGeneratorForStatements::revertWithError(
 		solAssert(arg->annotation().type, "");
 		errorArgumentTypes.push_back(arg->annotation().type);
 	}
-	templ("argumentVars", joinHumanReadablePrefixed(errorArgumentVars));
-	templ("encode", m_context.abiFunctions().tupleEncoder(errorArgumentTypes, _parameterTypes));
-
-	m_code << templ.render();
+	m_code <<
+		m_utils.revertWithErrorFunction(_signature, _parameterTypes, errorArgumentTypes) <<
+		"(" <<
+		joinHumanReadable(errorArgumentVars) <<
+		")\n";
 }
 
 
@@ -3114,6 +3415,23 @@ bool IRGeneratorForStatements::visit(TryCatchClause const& _clause)
 	return false;
 }
 
+void IRGeneratorForStatements::startReleasingTemporaryMemory(Statement const& _statement)
+{
+	solAssert(!m_temporaryMemoryStart, "");
+	if (!TemporaryMemoryChecker::releasable(_statement))
+		return;
+	m_temporaryMemoryStart = m_context.newYulVariable();
+	m_code << "let " << *m_temporaryMemoryStart << " := mload(" << to_string(CompilerUtils::freeMemoryPointer) << ")\n";
+}
+
+void IRGeneratorForStatements::releaseTemporaryMemory()
+{
+	if (!m_temporaryMemoryStart)
+		return;
+	m_code << "mstore(" << to_string(CompilerUtils::freeMemoryPointer) << ", " << *m_temporaryMemoryStart << ")\n";
+	m_temporaryMemoryStart.reset();
+}
+
 void IRGeneratorForStatements::setLocation(ASTNode const& _node)
 {
 	m_currentLocation = _node.location();
@@ -70,6 +70,9 @@ public:
 	/// and also generates the function.
 	std::string constantValueFunction(VariableDeclaration const& _constant);
 
+	bool visit(ExpressionStatement const& _expressionStatement) override;
+	void endVisit(ExpressionStatement const& _expressionStatement) override;
+	bool visit(VariableDeclarationStatement const& _variableDeclaration) override;
 	void endVisit(VariableDeclarationStatement const& _variableDeclaration) override;
 	bool visit(Conditional const& _conditional) override;
 	bool visit(Assignment const& _assignment) override;
@@ -85,11 +88,13 @@ public:
 	void endVisit(Return const& _return) override;
 	void endVisit(UnaryOperation const& _unaryOperation) override;
 	bool visit(BinaryOperation const& _binOp) override;
+	bool visit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCallOptions const& _funCallOptions) override;
 	bool visit(MemberAccess const& _memberAccess) override;
 	void endVisit(MemberAccess const& _memberAccess) override;
 	bool visit(InlineAssembly const& _inlineAsm) override;
+	bool visit(IndexAccess const& _indexAccess) override;
 	void endVisit(IndexAccess const& _indexAccess) override;
 	void endVisit(IndexRangeAccess const& _indexRangeAccess) override;
 	void endVisit(Identifier const& _identifier) override;
@@ -157,6 +162,12 @@ private:
 	IRVariable zeroValue(Type const& _type, bool _splitFunctionTypes = true);
 
 	void appendAndOrOperatorCode(BinaryOperation const& _binOp);
+	/// @returns the summands of the chain of checked additions `a + b + ... + z` ending in
+	/// @a _binOp if its overflow checks can be merged into a single one, and an empty vector
+	/// otherwise. This is the case for unsigned types of at most 248 bits if all summands
+	/// apart from the first two cannot have side-effects, since they are evaluated before the check.
+	/// Longer chains are split after 255 summands.
+	std::vector<Expression const*> mergeableCheckedSummands(BinaryOperation const& _binOp) const;
 	void appendSimpleUnaryOperation(UnaryOperation const& _operation, Expression const& _expr);
 
 	/// @returns code to perform the given binary operation in the given type on the two values.
@@ -189,6 +200,15 @@ private:
 	);
 
 	static Type const& type(Expression const& _expression);
+	/// @returns the variable holding the value of @a _expression. Unlike ``IRVariable(_expression)``,
+	/// it has the calldata type for identifiers referring to parameters that are kept in calldata.
+	IRVariable expressionVariable(Expression const& _expression) const;
+
+	/// Stores the value of the free memory pointer before @a _statement if the memory
+	/// the statement allocates can be released after it.
+	void startReleasingTemporaryMemory(Statement const& _statement);
+	/// Resets the free memory pointer to the value stored by startReleasingTemporaryMemory, if any.
+	void releaseTemporaryMemory();
 
 	void setLocation(ASTNode const& _node);
 
@@ -200,6 +220,9 @@ private:
 	YulUtilFunctions& m_utils;
 	std::optional<IRLValue> m_currentLValue;
 	langutil::SourceLocation m_currentLocation;
+	/// Name of the variable holding the free memory pointer before the current statement
+	/// if the memory it allocates is released after it.
+	std::optional<std::string> m_temporaryMemoryStart;
 };
 
 }
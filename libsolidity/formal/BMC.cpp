@@ -22,6 +22,10 @@
 
 #include <libsmtutil/SMTPortfolio.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <numeric>
+
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
 #endif
@@ -38,11 +42,20 @@ BMC::BMC(
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	smtutil::SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	smt::TimeBudget& _budget
 ):
 	SMTEncoder(_context, _settings),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
-	m_outerErrorReporter(_errorReporter)
+	m_queryCache(
+		_settings.queryCacheDirectory ?
+		make_shared<smtutil::QueryCache>(*_settings.queryCacheDirectory) :
+		nullptr
+	),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_enabledSolvers(_enabledSolvers),
+	m_smtCallback(_smtCallback),
+	m_outerErrorReporter(_errorReporter),
+	m_budget(_budget)
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (_enabledSolvers.some())
@@ -59,6 +72,16 @@ BMC::BMC(
 
 void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<VerificationTargetType>> _solvedTargets)
 {
+	if (!m_interface)
+		m_interface = make_unique<smtutil::SMTPortfolio>(
+			m_smtlib2Responses,
+			m_smtCallback,
+			m_enabledSolvers,
+			m_settings.timeout,
+			m_settings.raceSolvers,
+			m_queryCache
+		);
+
 	if (SMTEncoder::analyze(_source))
 	{
 		m_solvedTargets = move(_solvedTargets);
@@ -658,10 +681,144 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 /// Verification targets.
 
+vector<string> BMC::unhandledQueries()
+{
+	vector<string> queries = m_interface ? m_interface->unhandledQueries() : vector<string>{};
+	for (auto const& worker: m_workers)
+		queries += worker.first->unhandledQueries();
+	return queries;
+}
+
 void BMC::checkVerificationTargets()
 {
-	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+	// With a time budget, the cheapest targets are checked first, so that as many
+	// targets as possible are checked before the budget is used up.
+	if (m_budget.limited())
+	{
+		vector<size_t> sizes;
+		for (auto const& target: m_verificationTargets)
+			sizes.push_back((target.constraints && target.value).termSize());
+		vector<size_t> order(m_verificationTargets.size());
+		iota(order.begin(), order.end(), 0);
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) { return sizes[_a] < sizes[_b]; });
+		m_verificationTargets = applyMap(order, [&](size_t _i) { return move(m_verificationTargets[_i]); });
+	}
+
+	// The queries of the targets are independent of each other and only need the declarations,
+	// so they can be answered concurrently before the results are reported in the usual order.
+	if (m_settings.jobs > 1 && m_interface->solvers() > 1)
+	{
+		m_collectingQueries = true;
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		m_collectingQueries = false;
+		answerQueries();
+	}
+	// Without a native solver, the queries of all targets are sent to the SMT callback
+	// in one batch before the targets are checked with the answers.
+	else if (m_interface->batchesQueries())
+	{
+		m_collectingQueries = true;
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		m_collectingQueries = false;
+		m_interface->prefetch(applyMap(m_queries, [](Query const& _query) {
+			return make_pair(_query.condition, _query.expressionsToEvaluate);
+		}));
+		m_queries.clear();
+	}
+	// Otherwise the targets can share one solver scope in which every target's condition
+	// is guarded by an activation literal, so that what the solver learns from one target
+	// is kept for the next ones instead of being discarded with the scope of each query.
+	else if (m_settings.incremental)
+	{
+		m_interface->push();
+		m_activationLiterals = true;
+	}
+
+	for (size_t i = 0; i < m_verificationTargets.size(); ++i)
+		// The answers of concurrent queries are taken in order, so every target has to be checked.
+		if (m_queries.empty())
+			checkVerificationTargetWithinBudget(m_verificationTargets[i], m_verificationTargets.size() - i);
+		else
+			checkVerificationTarget(m_verificationTargets[i]);
+
+	if (m_activationLiterals)
+	{
+		m_activationLiterals = false;
+		m_interface->pop();
+	}
+
+	solAssert(m_nextQuery == m_queries.size(), "");
+	m_queries.clear();
+	m_nextQuery = 0;
+}
+
+void BMC::answerQueries()
+{
+	size_t jobs = min<size_t>(m_settings.jobs, m_queries.size());
+	while (m_workers.size() < jobs)
+		m_workers.emplace_back(make_unique<smtutil::SMTPortfolio>(
+			m_smtlib2Responses,
+			// The SMT callback is only called by the main solver, since it does not have to be thread-safe.
+			ReadCallback::Callback{},
+			m_enabledSolvers,
+			m_settings.timeout,
+			m_settings.raceSolvers,
+			m_queryCache
+		), 0);
+
+	// Every job gets an equal part of the remaining time for each of its queries.
+	optional<unsigned> timeLimit = m_budget.queryTimeLimit((m_queries.size() + jobs - 1) / max<size_t>(jobs, 1));
+
+	auto const& declarations = m_interface->declarations();
+	util::ThreadPool pool(jobs);
+	for (size_t job = 0; job < jobs; ++job)
+		pool.submit([&, job]() {
+			auto& [solver, declared] = m_workers[job];
+			if (declared > declarations.size())
+			{
+				solver->reset();
+				declared = 0;
+			}
+			for (; declared < declarations.size(); ++declared)
+				solver->declareVariable(declarations[declared].first, declarations[declared].second);
+			if (timeLimit)
+				solver->setQueryTimeLimit(timeLimit);
+
+			// Distributing the queries independently of their duration makes the
+			// unhandled queries of every solver deterministic.
+			for (size_t i = job; i < m_queries.size(); i += jobs)
+			{
+				Query& query = m_queries[i];
+				solver->push();
+				solver->addAssertion(query.condition);
+				query.answer = querySolver(*solver, query.expressionsToEvaluate);
+				solver->pop();
+			}
+		});
+	pool.waitAll();
+}
+
+void BMC::checkVerificationTargetWithinBudget(BMCVerificationTarget& _target, size_t _remainingTargets)
+{
+	if (!m_budget.limited())
+	{
+		checkVerificationTarget(_target);
+		return;
+	}
+	if (m_budget.exhausted())
+	{
+		m_errorReporter.warning(
+			3601_error,
+			_target.expression->location(),
+			"BMC: Verification target was not checked, since the time budget of the model checker is used up."
+		);
+		return;
+	}
+	m_interface->setQueryTimeLimit(m_budget.queryTimeLimit(_remainingTargets));
+	checkVerificationTarget(_target);
+	m_interface->setQueryTimeLimit({});
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -850,7 +1007,7 @@ void BMC::addVerificationTarget(
 		modelExpressions()
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
-		checkVerificationTarget(target);
+		checkVerificationTargetWithinBudget(target, m_verificationTargets.size() + 1);
 	else
 		m_verificationTargets.emplace_back(move(target));
 }
@@ -869,9 +1026,6 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -881,9 +1035,33 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+
+	if (m_collectingQueries)
+	{
+		m_queries.push_back({move(_condition), move(expressionsToEvaluate), {}});
+		return;
+	}
+
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	if (m_nextQuery < m_queries.size())
+		tie(result, values) = processAnswer(move(m_queries[m_nextQuery++].answer));
+	else if (m_activationLiterals)
+	{
+		smtutil::Expression literal = m_interface->newVariable(
+			"target_activation_" + to_string(m_activationLiteralCount++),
+			smtutil::SortProvider::boolSort
+		);
+		m_interface->addAssertion(smtutil::Expression::implies(literal, _condition));
+		tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate, {literal});
+	}
+	else
+	{
+		m_interface->push();
+		m_interface->addAssertion(_condition);
+		tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+		m_interface->pop();
+	}
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -940,8 +1118,6 @@ void BMC::checkCondition(
 		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -1003,23 +1179,50 @@ void BMC::checkBooleanNotConstant(
 }
 
 pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::checkSatisfiableAndGenerateModel(
+	vector<smtutil::Expression> const& _expressionsToEvaluate,
+	vector<smtutil::Expression> const& _assumptions
+)
 {
-	smtutil::CheckResult result;
-	vector<string> values;
+	return processAnswer(querySolver(*m_interface, _expressionsToEvaluate, _assumptions));
+}
+
+BMC::SolverAnswer BMC::querySolver(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate,
+	vector<smtutil::Expression> const& _assumptions
+)
+{
+	SolverAnswer answer;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		if (_assumptions.empty())
+			tie(answer.result, answer.values) = _solver.check(_expressionsToEvaluate);
+		else
+			tie(answer.result, answer.values) = _solver.checkAssuming(_assumptions, _expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
-		string description("BMC: Error querying SMT solver");
+		answer.solverError = true;
 		if (_e.comment())
-			description += ": " + *_e.comment();
+			answer.errorComment = *_e.comment();
+		answer.result = smtutil::CheckResult::ERROR;
+	}
+	return answer;
+}
+
+pair<smtutil::CheckResult, vector<string>> BMC::processAnswer(SolverAnswer _answer)
+{
+	if (_answer.solverError)
+	{
+		string description("BMC: Error querying SMT solver");
+		if (_answer.errorComment)
+			description += ": " + *_answer.errorComment;
 		m_errorReporter.warning(8140_error, description);
-		result = smtutil::CheckResult::ERROR;
 	}
 
+	smtutil::CheckResult result = _answer.result;
+	vector<string> values = move(_answer.values);
 	for (string& value: values)
 	{
 		try
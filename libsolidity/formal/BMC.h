@@ -32,9 +32,11 @@
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
@@ -63,7 +65,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		smt::TimeBudget& _budget
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>> _solvedTargets);
@@ -71,7 +74,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -138,7 +141,12 @@ private:
 	};
 
 	void checkVerificationTargets();
+	/// Answers the queries in m_queries using one solver of m_workers per job concurrently.
+	void answerQueries();
 	void checkVerificationTarget(BMCVerificationTarget& _target);
+	/// Checks @a _target with an equal part of the remaining time budget if @a _remainingTargets
+	/// targets are still to be checked, or reports it as not checked if the budget is used up.
+	void checkVerificationTargetWithinBudget(BMCVerificationTarget& _target, size_t _remainingTargets);
 	void checkConstantCondition(BMCVerificationTarget& _target);
 	void checkUnderflow(BMCVerificationTarget& _target);
 	void checkOverflow(BMCVerificationTarget& _target);
@@ -175,12 +183,67 @@ private:
 		std::vector<CallStackEntry> const& _callStack
 	);
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+		std::vector<smtutil::Expression> const& _assumptions = {}
+	);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	struct SolverAnswer
+	{
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// True if the solver threw a SolverError, with its comment if there was one.
+		bool solverError = false;
+		std::optional<std::string> errorComment;
+	};
+	/// Queries @a _solver without reporting anything, so that different solvers can be
+	/// queried concurrently.
+	static SolverAnswer querySolver(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+		std::vector<smtutil::Expression> const& _assumptions = {}
+	);
+	/// Reports a solver error contained in @a _answer and formats its values.
+	std::pair<smtutil::CheckResult, std::vector<std::string>> processAnswer(SolverAnswer _answer);
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	/// The persistent cache of query results shared by all solvers, if enabled.
+	std::shared_ptr<smtutil::QueryCache const> m_queryCache;
+
+	/// Only created by the first analysis, so that the SMT solvers are not loaded
+	/// if the BMC engine is not used.
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
+
+	/// Arguments for the creation of m_interface and of the solvers in m_workers.
+	std::map<h256, std::string> m_smtlib2Responses;
+	smtutil::SMTSolverChoice m_enabledSolvers;
+	ReadCallback::Callback m_smtCallback;
+
+	/// A query of checkCondition that is answered by one of the solvers in m_workers
+	/// or sent to the SMT callback in a batch.
+	struct Query
+	{
+		smtutil::Expression condition;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		SolverAnswer answer;
+	};
+	/// If true, checkCondition only appends its query to m_queries.
+	bool m_collectingQueries = false;
+	/// The queries of the verification targets of the current function, which checkCondition
+	/// takes the answers from in the same order as they were collected.
+	std::vector<Query> m_queries;
+	size_t m_nextQuery = 0;
+	/// If true, checkCondition guards its query by a new activation literal instead of
+	/// asserting it in a new scope.
+	bool m_activationLiterals = false;
+	/// The number of activation literals declared so far, used as their unique suffix.
+	unsigned m_activationLiteralCount = 0;
+
+	/// Additional solvers for concurrent queries, each with the number of variables of
+	/// m_interface that were already declared in it.
+	std::vector<std::pair<std::unique_ptr<smtutil::SMTPortfolio>, size_t>> m_workers;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -189,6 +252,8 @@ private:
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 
+	smt::TimeBudget& m_budget;
+
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
 	/// Targets that were already proven.
@@ -25,12 +25,14 @@
 #include <libsolidity/formal/ArraySlicePredicate.h>
 #include <libsolidity/formal/PredicateInstance.h>
 #include <libsolidity/formal/PredicateSort.h>
+#include <libsolidity/formal/StateSlicing.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <range/v3/algorithm/for_each.hpp>
 
@@ -54,32 +56,47 @@ using namespace solidity::frontend::smt;
 CHC::CHC(
 	EncodingContext& _context,
 	ErrorReporter& _errorReporter,
-	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
-	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
+	map<util::h256, string> const& _smtlib2Responses,
+	ReadCallback::Callback const& _smtCallback,
 	SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	smt::TimeBudget& _budget
 ):
 	SMTEncoder(_context, _settings),
 	m_outerErrorReporter(_errorReporter),
-	m_enabledSolvers(_enabledSolvers)
+	m_budget(_budget),
+	m_enabledSolvers(_enabledSolvers),
+	m_queryCache(
+		_settings.queryCacheDirectory ?
+		make_shared<QueryCache>(*_settings.queryCacheDirectory) :
+		nullptr
+	),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback)
 {
-	bool usesZ3 = _enabledSolvers.z3;
-#ifdef HAVE_Z3
-	usesZ3 = usesZ3 && Z3Interface::available();
-#else
-	usesZ3 = false;
-#endif
-	if (!usesZ3)
-		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
 }
 
 void CHC::analyze(SourceUnit const& _source)
 {
+	if (!m_interface)
+	{
+		bool usesZ3 = m_enabledSolvers.z3;
+#ifdef HAVE_Z3
+		usesZ3 = usesZ3 && Z3Interface::available();
+#else
+		usesZ3 = false;
+#endif
+		if (!usesZ3)
+			m_interface = make_unique<CHCSmtLib2Interface>(m_smtlib2Responses, m_smtCallback, m_settings.timeout);
+	}
+
 	if (SMTEncoder::analyze(_source))
 	{
 		resetSourceAnalysis();
 
 		auto sources = sourceDependencies(_source);
+		if (m_settings.sliceState)
+			StateSlicing::slice(sources);
 		collectFreeFunctions(sources);
 		createFreeConstants(sources);
 		for (auto const* source: sources)
@@ -210,6 +227,8 @@ void CHC::endVisit(ContractDefinition const& _contract)
 	solAssert(m_scopes.back() == &_contract, "");
 	m_scopes.pop_back();
 
+	m_encodedContracts.insert(&_contract);
+
 	SMTEncoder::endVisit(_contract);
 }
 
@@ -236,6 +255,14 @@ bool CHC::visit(FunctionDefinition const& _function)
 		return false;
 	}
 
+	if (auto const* base = reusableSummaryContext(_function))
+	{
+		// Both summaries have the same arguments, since the contracts have the same state variables.
+		auto to = summary(_function);
+		addRule(smtutil::Expression::implies(summary(_function, *base), to), to.name);
+		return false;
+	}
+
 	// No inlining.
 	solAssert(!m_currentFunction, "Function inlining should not happen in CHC.");
 	m_currentFunction = &_function;
@@ -279,6 +306,17 @@ void CHC::endVisit(FunctionDefinition const& _function)
 	)
 		return;
 
+	if (reusableSummaryContext(_function))
+	{
+		solAssert(!m_currentFunction, "");
+		m_currentFunction = &_function;
+		setCurrentBlock(*m_summaries.at(m_currentContract).at(&_function));
+		connectToInterface(_function);
+		m_currentFunction = nullptr;
+		m_context.popSolver();
+		return;
+	}
+
 	solAssert(m_currentFunction && m_currentContract, "");
 	// No inlining.
 	solAssert(m_currentFunction == &_function, "");
@@ -289,22 +327,7 @@ void CHC::endVisit(FunctionDefinition const& _function)
 	connectBlocks(m_currentBlock, summary(_function));
 	setCurrentBlock(*m_summaries.at(m_currentContract).at(&_function));
 
-	// Query placeholders for constructors are not created here because
-	// of contracts without constructors.
-	// Instead, those are created in endVisit(ContractDefinition).
-	if (
-		!_function.isConstructor() &&
-		_function.isPublic() &&
-		contractFunctions(*m_currentContract).count(&_function) &&
-		shouldAnalyze(*m_currentContract)
-	)
-	{
-		auto sum = summary(_function);
-		auto ifacePre = smt::interfacePre(*m_interfaces.at(m_currentContract), *m_currentContract, m_context);
-		auto txConstraints = state().txTypeConstraints() && state().txFunctionConstraints(_function);
-		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), ifacePre});
-		connectBlocks(ifacePre, interface(), txConstraints && sum && errorFlag().currentValue() == 0);
-	}
+	connectToInterface(_function);
 
 	m_currentFunction = nullptr;
 
@@ -722,6 +745,8 @@ void CHC::externalFunctionCall(FunctionCall const& _funCall)
 	/// so we just add the nondet_interface predicate.
 
 	solAssert(m_currentContract, "");
+	if (m_currentFunction)
+		m_contextDependentFunctions.insert(m_currentFunction);
 	if (isTrustedExternalCall(&_funCall.expression()))
 	{
 		externalFunctionCallToTrustedCode(_funCall);
@@ -922,12 +947,15 @@ void CHC::resetSourceAnalysis()
 	m_queryPlaceholders.clear();
 	m_callGraph.clear();
 	m_summaries.clear();
+	m_encodedContracts.clear();
+	m_contextDependentFunctions.clear();
 	m_interfaces.clear();
 	m_nondetInterfaces.clear();
 	m_constructorSummaries.clear();
 	m_contractInitializers.clear();
 	Predicate::reset();
 	ArraySlicePredicate::reset();
+	StateSlicing::reset();
 	m_blockCounter = 0;
 
 	bool usesZ3 = false;
@@ -935,10 +963,14 @@ void CHC::resetSourceAnalysis()
 	usesZ3 = m_enabledSolvers.z3 && Z3Interface::available();
 	if (usesZ3)
 	{
-		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface.reset(new Z3CHCInterface(m_settings.timeout));
-		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+		/// z3::fixedpoint does not have a reset mechanism, so we need to create another,
+		/// but the context and the sorts declared in it are kept.
+		if (!m_z3Context)
+			m_z3Context = make_shared<Z3Context>();
+		m_interface.reset(new Z3CHCInterface(m_settings.timeout, m_queryCache, m_z3Context));
+		auto z3Interface = dynamic_cast<Z3CHCInterface*>(m_interface.get());
 		solAssert(z3Interface, "");
+		z3Interface->enableCounterexamples(m_settings.counterexamples);
 		m_context.setSolver(z3Interface->z3Interface());
 	}
 #endif
@@ -988,6 +1020,73 @@ void CHC::clearIndices(ContractDefinition const* _contract, FunctionDefinition c
 	state().newState();
 }
 
+void CHC::connectToInterface(FunctionDefinition const& _function)
+{
+	// Query placeholders for constructors are not created here because
+	// of contracts without constructors.
+	// Instead, those are created in endVisit(ContractDefinition).
+	if (
+		!_function.isConstructor() &&
+		_function.isPublic() &&
+		contractFunctions(*m_currentContract).count(&_function) &&
+		shouldAnalyze(*m_currentContract)
+	)
+	{
+		auto sum = summary(_function);
+		auto ifacePre = smt::interfacePre(*m_interfaces.at(m_currentContract), *m_currentContract, m_context);
+		auto txConstraints = state().txTypeConstraints() && state().txFunctionConstraints(_function);
+		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), ifacePre});
+		connectBlocks(ifacePre, interface(), txConstraints && sum && errorFlag().currentValue() == 0);
+	}
+}
+
+ContractDefinition const* CHC::reusableSummaryContext(FunctionDefinition const& _function)
+{
+	solAssert(m_currentContract, "");
+	if (_function.isConstructor())
+		return nullptr;
+
+	// The encoding of a function depends on the contract it is encoded for through the
+	// resolution of virtual functions, modifiers and `super`, the state variables and the
+	// nondeterministic interface used for external calls. The first three are the same if the
+	// current contract only appends itself to the hierarchy of its direct base without
+	// overriding anything or declaring state variables.
+	auto const& hierarchy = m_currentContract->annotation().linearizedBaseContracts;
+	if (hierarchy.size() < 2)
+		return nullptr;
+	ContractDefinition const* base = hierarchy.at(1);
+	auto const& baseHierarchy = base->annotation().linearizedBaseContracts;
+	if (
+		!m_encodedContracts.count(base) ||
+		!m_summaries.at(base).count(&_function) ||
+		baseHierarchy.size() + 1 != hierarchy.size() ||
+		!equal(baseHierarchy.begin(), baseHierarchy.end(), hierarchy.begin() + 1) ||
+		stateVariablesIncludingInheritedAndPrivate(*m_currentContract) != stateVariablesIncludingInheritedAndPrivate(*base)
+	)
+		return nullptr;
+	for (auto const* function: m_currentContract->definedFunctions())
+		if (!function->annotation().baseFunctions.empty())
+			return nullptr;
+	for (auto const* modifier: m_currentContract->functionModifiers())
+		if (!modifier->annotation().baseFunctions.empty())
+			return nullptr;
+
+	// The interface of the current contract can differ from the one of its base, so functions
+	// that call external functions directly or via internal calls are encoded again.
+	bool contextDependent = false;
+	solidity::util::BreadthFirstSearch<FunctionDefinition const*>{{&_function}}.run([&](auto _node, auto&& _addChild) {
+		if (m_contextDependentFunctions.count(_node))
+			contextDependent = true;
+		for (ASTNode const* called: m_callGraph[_node])
+			if (auto const* calledFunction = dynamic_cast<FunctionDefinition const*>(called))
+				_addChild(calledFunction);
+	});
+	if (contextDependent)
+		return nullptr;
+
+	return base;
+}
+
 void CHC::setCurrentBlock(Predicate const& _block)
 {
 	if (m_context.solverStackHeigh() > 0)
@@ -1280,7 +1379,7 @@ vector<smtutil::Expression> CHC::stateVariablesAtIndex(unsigned _index)
 vector<smtutil::Expression> CHC::stateVariablesAtIndex(unsigned _index, ContractDefinition const& _contract)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		StateSlicing::encodedStateVariables(_contract),
 		[&](auto _var) { return valueAtIndex(*_var, _index); }
 	);
 }
@@ -1293,7 +1392,7 @@ vector<smtutil::Expression> CHC::currentStateVariables()
 
 vector<smtutil::Expression> CHC::currentStateVariables(ContractDefinition const& _contract)
 {
-	return applyMap(SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract), [this](auto _var) { return currentValue(*_var); });
+	return applyMap(StateSlicing::encodedStateVariables(_contract), [this](auto _var) { return currentValue(*_var); });
 }
 
 smtutil::Expression CHC::currentEqualInitialVarsConstraints(vector<VariableDeclaration const*> const& _vars) const
@@ -1416,43 +1515,31 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 	m_interface->addRule(_rule, _ruleName);
 }
 
-pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(CHCSolverInterface& _solver, smtutil::Expression const& _query)
 {
 	CheckResult result;
 	CHCSolverInterface::CexGraph cex;
-	tie(result, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
+	tie(result, cex) = _solver.query(_query);
+	if (result == CheckResult::SATISFIABLE)
 	{
 #ifdef HAVE_Z3
 		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
 		// We now disable those optimizations and check whether we can still solve the problem.
-		auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
 		solAssert(spacer, "");
+		if (!spacer->counterexamples())
+			return {result, cex};
 		spacer->setSpacerOptions(false);
 
 		CheckResult resultNoOpt;
 		CHCSolverInterface::CexGraph cexNoOpt;
-		tie(resultNoOpt, cexNoOpt) = m_interface->query(_query);
+		tie(resultNoOpt, cexNoOpt) = _solver.query(_query);
 
 		if (resultNoOpt == CheckResult::SATISFIABLE)
 			cex = move(cexNoOpt);
 
 		spacer->setSpacerOptions(true);
 #endif
-		break;
-	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
-		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
-		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
 	}
 	return {result, cex};
 }
@@ -1519,6 +1606,7 @@ void CHC::checkVerificationTargets()
 	}
 
 	set<unsigned> checkedErrorIds;
+	vector<TargetToCheck> targetsToCheck;
 	for (auto const& target: verificationTargets)
 	{
 		string errorType;
@@ -1571,9 +1659,21 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		targetsToCheck.emplace_back(&target, errorReporterId, errorType);
 		checkedErrorIds.insert(target.errorId);
 	}
+	// With a time budget, the cheapest targets are checked first, so that as many
+	// targets as possible are checked before the budget is used up.
+	if (m_budget.limited())
+	{
+		map<CHCVerificationTarget const*, size_t> sizes;
+		for (auto const& target: targetsToCheck)
+			sizes[get<0>(target)] = get<0>(target)->constraints.termSize();
+		stable_sort(targetsToCheck.begin(), targetsToCheck.end(), [&](auto const& _a, auto const& _b) {
+			return sizes.at(get<0>(_a)) < sizes.at(get<0>(_b));
+		});
+	}
+	checkAndReportTargets(targetsToCheck);
 
 	// There can be targets in internal functions that are not reachable from the external interface.
 	// These are safe by definition and are not even checked by the CHC engine, but this information
@@ -1595,6 +1695,128 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
 }
 
+void CHC::checkAndReportTargets(vector<TargetToCheck> const& _targets)
+{
+	if (m_budget.exhausted())
+	{
+		reportSkippedTargets(_targets, 0);
+		return;
+	}
+
+#ifdef HAVE_Z3
+	auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	if (m_settings.jobs > 1 && spacer && _targets.size() > 1)
+	{
+		// The error block and rule of every target are added to the main solver first,
+		// recording which of its rules belong to which target.
+		// Every job then replays the rules common to all targets and the rules of its own
+		// targets in a separate Z3 context, and the results are reported in the original order.
+		struct TargetQuery
+		{
+			size_t target;
+			smtutil::Expression error;
+			size_t rulesBegin;
+			size_t rulesEnd;
+			pair<CheckResult, CHCSolverInterface::CexGraph> answer;
+		};
+		size_t commonRules = spacer->historySize();
+		vector<TargetQuery> queries;
+		for (size_t i = 0; i < _targets.size(); ++i)
+		{
+			auto const& target = *get<0>(_targets[i]);
+			if (isKnownUnsafe(target))
+				continue;
+			size_t rulesBegin = spacer->historySize();
+			createErrorBlock();
+			connectBlocks(target.value, error(), target.constraints);
+			queries.push_back({i, error(), rulesBegin, spacer->historySize(), {}});
+		}
+
+		size_t jobs = min<size_t>(m_settings.jobs, queries.size());
+		// The constructor sets global parameters of Z3, so the solvers are not created by the jobs.
+		vector<unique_ptr<Z3CHCInterface>> solvers;
+		for (size_t job = 0; job < jobs; ++job)
+		{
+			solvers.emplace_back(make_unique<Z3CHCInterface>(m_settings.timeout, m_queryCache));
+			solvers.back()->enableCounterexamples(m_settings.counterexamples);
+		}
+
+		// Every job gets an equal part of the remaining time for each of its queries.
+		optional<unsigned> timeLimit = m_budget.queryTimeLimit((queries.size() + jobs - 1) / max<size_t>(jobs, 1));
+
+		util::ThreadPool pool(jobs);
+		for (size_t job = 0; job < jobs; ++job)
+			pool.submit([&, job]() {
+				Z3CHCInterface& solver = *solvers[job];
+				if (timeLimit)
+					solver.setQueryTimeLimit(timeLimit);
+				solver.replay(*spacer, 0, commonRules);
+				for (size_t i = job; i < queries.size(); i += jobs)
+				{
+					solver.replay(*spacer, queries[i].rulesBegin, queries[i].rulesEnd);
+					queries[i].answer = query(solver, queries[i].error);
+				}
+			});
+		pool.waitAll();
+
+		for (auto const& targetQuery: queries)
+		{
+			auto const& [target, errorReporterId, errorType] = _targets[targetQuery.target];
+			if (isKnownUnsafe(*target))
+				continue;
+			reportTarget(
+				*target,
+				errorReporterId,
+				errorType + " happens here.",
+				errorType + " might happen here.",
+				targetQuery.answer.first,
+				targetQuery.answer.second,
+				targetQuery.error.name
+			);
+		}
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < _targets.size(); ++i)
+	{
+		auto const& [target, errorReporterId, errorType] = _targets[i];
+		if (m_budget.limited())
+		{
+			if (m_budget.exhausted())
+			{
+				reportSkippedTargets(_targets, i);
+				break;
+			}
+			m_interface->setQueryTimeLimit(m_budget.queryTimeLimit(_targets.size() - i));
+		}
+		checkAndReportTarget(*target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+	}
+	if (m_budget.limited())
+		m_interface->setQueryTimeLimit({});
+}
+
+void CHC::reportSkippedTargets(vector<TargetToCheck> const& _targets, size_t _begin)
+{
+	// A target can be checked in several contexts, but it is reported only once.
+	set<pair<ASTNode const*, VerificationTargetType>> reported;
+	for (size_t i = _begin; i < _targets.size(); ++i)
+	{
+		auto const& [target, errorReporterId, errorType] = _targets[i];
+		if (!isKnownUnsafe(*target) && reported.emplace(target->errorNode, target->type).second)
+			m_errorReporter.warning(
+				4751_error,
+				target->errorNode->location(),
+				"CHC: " + errorType + " was not checked, since the time budget of the model checker is used up."
+			);
+	}
+}
+
+bool CHC::isKnownUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
 void CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	ErrorId _errorReporterId,
@@ -1602,20 +1824,40 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isKnownUnsafe(_target))
 		return;
 
 	createErrorBlock();
 	connectBlocks(_target.value, error(), _target.constraints);
+	auto const& [result, model] = query(*m_interface, error());
+	reportTarget(_target, _errorReporterId, _satMsg, _unknownMsg, result, model, error().name);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	CheckResult _result,
+	CHCSolverInterface::CexGraph const& _model,
+	string const& _root
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto const& [result, model] = query(error(), location);
-	if (result == CheckResult::UNSATISFIABLE)
+	if (_result == CheckResult::CONFLICTING)
+		m_errorReporter.warning(1988_error, location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+	else if (_result == CheckResult::ERROR)
+		m_errorReporter.warning(1218_error, location, "CHC: Error trying to invoke SMT solver.");
+
+	if (_result == CheckResult::UNSATISFIABLE)
 		m_safeTargets[_target.errorNode].insert(_target.type);
-	else if (result == CheckResult::SATISFIABLE)
+	else if (_result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
+		optional<string> cex;
+		if (m_settings.counterexamples)
+			cex = generateCounterexample(_model, _root);
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -34,16 +34,24 @@
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryCache.h>
 
 #include <boost/algorithm/string/join.hpp>
 
 #include <map>
 #include <optional>
 #include <set>
+#include <tuple>
+
+namespace solidity::smtutil
+{
+struct Z3Context;
+}
 
 namespace solidity::frontend
 {
@@ -57,7 +65,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		smt::TimeBudget& _budget
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -126,6 +135,17 @@ private:
 	void clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function = nullptr) override;
 	void setCurrentBlock(Predicate const& _block);
 	std::set<unsigned> transactionVerificationTargetsIds(ASTNode const* _txRoot);
+	/// Adds the query placeholder and the rule for a transaction that calls @a _function
+	/// to the interface of the current contract if @a _function is a public entry point.
+	void connectToInterface(FunctionDefinition const& _function);
+	//@}
+
+	/// Summary reuse.
+	//@{
+	/// @returns the direct base of the current contract whose summary of @a _function has the
+	/// same sort and semantics as the summary for the current contract, so that the summaries
+	/// can be connected instead of encoding @a _function again, or nullptr if there is none.
+	ContractDefinition const* reusableSummaryContext(FunctionDefinition const& _function);
 	//@}
 
 	/// SMT Natspec and abstraction helpers.
@@ -225,7 +245,11 @@ private:
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, empty> if query is unsatisfiable (safe).
 	/// @returns <false, model> otherwise.
-	std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Does not report anything, so that different solvers can be queried concurrently.
+	static std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query
+	);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -233,12 +257,32 @@ private:
 	// Forward declaration. Definition is below.
 	struct CHCVerificationTarget;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
+	/// A target to be checked together with its error id and the description of its error type.
+	using TargetToCheck = std::tuple<CHCVerificationTarget const*, langutil::ErrorId, std::string>;
+	/// Checks and reports @a _targets in order, concurrently with several solvers if
+	/// the settings allow it.
+	void checkAndReportTargets(std::vector<TargetToCheck> const& _targets);
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
 		langutil::ErrorId _errorReporterId,
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Reports the result of the query of @a _target whose error predicate is @a _root.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		smtutil::CheckResult _result,
+		smtutil::CHCSolverInterface::CexGraph const& _model,
+		std::string const& _root
+	);
+	/// @returns true if @a _target was already found to be unsafe.
+	bool isKnownUnsafe(CHCVerificationTarget const& _target) const;
+	/// Reports all targets of @a _targets from index @a _begin on as not checked,
+	/// since the time budget is used up.
+	void reportSkippedTargets(std::vector<TargetToCheck> const& _targets, size_t _begin);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -309,6 +353,12 @@ private:
 
 	/// Function predicates.
 	std::map<ContractDefinition const*, std::map<FunctionDefinition const*, Predicate const*>> m_summaries;
+
+	/// Contracts of the current source whose functions were already encoded.
+	std::set<ContractDefinition const*, ASTNode::CompareByID> m_encodedContracts;
+	/// Functions whose encoding depends on the interface of the contract they are encoded for,
+	/// because they call external functions.
+	std::set<FunctionDefinition const*, ASTNode::CompareByID> m_contextDependentFunctions;
 	//@}
 
 	/// Variables.
@@ -393,8 +443,22 @@ private:
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 
+	smt::TimeBudget& m_budget;
+
 	/// SMT solvers that are chosen at runtime.
 	smtutil::SMTSolverChoice m_enabledSolvers;
+
+	/// The persistent cache of query results, if enabled.
+	std::shared_ptr<smtutil::QueryCache const> m_queryCache;
+
+	/// Arguments for the creation of the SMT-LIB2 interface, which is only created
+	/// by the first analysis, so that Z3 is not loaded if the CHC engine is not used.
+	std::map<util::h256, std::string> m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+
+	/// The Z3 context shared by the Horn solvers of the analyzed sources,
+	/// so that the sorts are declared only once per run.
+	std::shared_ptr<smtutil::Z3Context> m_z3Context;
 };
 
 }
@@ -40,8 +40,9 @@ ModelChecker::ModelChecker(
 	m_errorReporter(_errorReporter),
 	m_settings(_settings),
 	m_context(),
-	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings),
-	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings)
+	m_budget(m_settings.budget),
+	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings, m_budget),
+	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings, m_budget)
 {
 }
 
@@ -116,8 +117,15 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.none())
 		return;
 
+	m_budget.start();
 	if (m_settings.engine.chc)
+	{
+		// Half of the remaining time is left for BMC, which runs afterwards.
+		if (m_settings.engine.bmc)
+			m_budget.restrictTo(0.5);
 		m_chc.analyze(_source);
+		m_budget.lift();
+	}
 
 	auto solvedTargets = m_chc.safeTargets();
 	for (auto const& target: m_chc.unsafeTargets())
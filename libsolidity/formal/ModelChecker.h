@@ -27,6 +27,7 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -80,6 +81,9 @@ private:
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
+	/// The time budget shared by the engines.
+	smt::TimeBudget m_budget;
+
 	/// Bounded Model Checker engine.
 	BMC m_bmc;
 
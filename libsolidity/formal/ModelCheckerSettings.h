@@ -106,6 +106,24 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Wall-clock time in milliseconds for the whole analysis, which is distributed
+	/// among the verification targets. Targets are skipped once it is used up.
+	std::optional<unsigned> budget;
+	/// Query the SMT solvers used by BMC concurrently and take the first answer
+	/// instead of querying them one after the other.
+	bool raceSolvers = false;
+	/// Number of solver instances that answer the queries of independent verification
+	/// targets concurrently.
+	unsigned jobs = 1;
+	/// Check the targets of a function in one solver scope using activation literals,
+	/// so that the solvers keep what they learned between the queries.
+	bool incremental = false;
+	/// Leave the state variables that are never read out of the CHC encoding.
+	bool sliceState = false;
+	/// Extract and report the counterexamples of the CHC targets that are not safe.
+	bool counterexamples = true;
+	/// Directory of the persistent cache of SMT query results, if the cache is enabled.
+	std::optional<std::string> queryCacheDirectory;
 };
 
 }
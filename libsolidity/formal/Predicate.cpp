@@ -19,6 +19,7 @@
 #include <libsolidity/formal/Predicate.h>
 
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/StateSlicing.h>
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/TypeProvider.h>
@@ -142,7 +143,7 @@ FunctionCall const* Predicate::programFunctionCall() const
 optional<vector<VariableDeclaration const*>> Predicate::stateVariables() const
 {
 	if (m_contractContext)
-		return SMTEncoder::stateVariablesIncludingInheritedAndPrivate(*m_contractContext);
+		return StateSlicing::encodedStateVariables(*m_contractContext);
 
 	return nullopt;
 }
@@ -20,6 +20,7 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/StateSlicing.h>
 
 using namespace std;
 using namespace solidity::util;
@@ -125,7 +126,7 @@ vector<smtutil::Expression> initialStateVariables(ContractDefinition const& _con
 vector<smtutil::Expression> stateVariablesAtIndex(unsigned _index, ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		StateSlicing::encodedStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->valueAtIndex(_index); }
 	);
 }
@@ -133,7 +134,7 @@ vector<smtutil::Expression> stateVariablesAtIndex(unsigned _index, ContractDefin
 vector<smtutil::Expression> currentStateVariables(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		StateSlicing::encodedStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->currentValue(); }
 	);
 }
@@ -141,7 +142,7 @@ vector<smtutil::Expression> currentStateVariables(ContractDefinition const& _con
 vector<smtutil::Expression> newStateVariables(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		StateSlicing::encodedStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->increaseIndex(); }
 	);
 }
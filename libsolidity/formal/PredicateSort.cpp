@@ -19,6 +19,7 @@
 #include <libsolidity/formal/PredicateSort.h>
 
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/StateSlicing.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
 using namespace std;
@@ -106,7 +107,7 @@ SortPointer arity0FunctionSort()
 vector<SortPointer> stateSorts(ContractDefinition const& _contract)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		StateSlicing::encodedStateVariables(_contract),
 		[](auto _var) { return smt::smtSortAbstractFunction(*_var->type()); }
 	);
 }
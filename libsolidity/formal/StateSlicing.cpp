@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/StateSlicing.h>
+
+#include <libsolidity/formal/SMTEncoder.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/view/map.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+using namespace solidity::frontend::smt;
+
+set<VariableDeclaration const*> StateSlicing::m_sliced;
+
+void StateSlicing::slice(set<SourceUnit const*, ASTNode::CompareByID> const& _sources)
+{
+	StateSlicing slicing;
+	for (auto const* source: _sources)
+		source->accept(slicing);
+
+	m_sliced.clear();
+	for (auto const* source: _sources)
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->nodes()))
+			for (auto const* var: contract->stateVariables())
+				if (!slicing.m_read.count(var))
+					m_sliced.insert(var);
+}
+
+void StateSlicing::reset()
+{
+	m_sliced.clear();
+}
+
+vector<VariableDeclaration const*> StateSlicing::encodedStateVariables(ContractDefinition const& _contract)
+{
+	vector<VariableDeclaration const*> variables;
+	for (auto const* var: SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract))
+		if (!m_sliced.count(var))
+			variables.push_back(var);
+	return variables;
+}
+
+bool StateSlicing::visit(Assignment const& _assignment)
+{
+	// Only assignments of a whole variable do not depend on its previous value.
+	if (_assignment.assignmentOperator() == Token::Assign)
+		if (auto const* identifier = dynamic_cast<Identifier const*>(&_assignment.leftHandSide()))
+			m_assigned.insert(identifier);
+	return true;
+}
+
+void StateSlicing::endVisit(Identifier const& _identifier)
+{
+	if (!m_assigned.count(&_identifier))
+		read(_identifier.annotation().referencedDeclaration);
+}
+
+void StateSlicing::endVisit(MemberAccess const& _memberAccess)
+{
+	// Getters and accesses via the contract name.
+	read(_memberAccess.annotation().referencedDeclaration);
+}
+
+void StateSlicing::endVisit(InlineAssembly const& _inlineAssembly)
+{
+	for (auto const& reference: _inlineAssembly.annotation().externalReferences | ranges::views::values)
+		read(reference.declaration);
+}
+
+void StateSlicing::read(Declaration const* _declaration)
+{
+	if (auto const* var = dynamic_cast<VariableDeclaration const*>(_declaration))
+		if (var->isStateVariable())
+			m_read.insert(var);
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <set>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Slices away the state variables that cannot influence any verification target
+ * before the CHC encoding. These are the state variables that are never read,
+ * that is, that are only assigned to as a whole.
+ * The sliced variables are not part of the arguments of the CHC predicates.
+ */
+class StateSlicing: private ASTConstVisitor
+{
+public:
+	/// Slices the state variables of the contracts in @a _sources for the following encodings.
+	static void slice(std::set<SourceUnit const*, ASTNode::CompareByID> const& _sources);
+	/// Makes all state variables part of the encodings again.
+	static void reset();
+
+	/// @returns the state variables of @a _contract, including the inherited and private ones,
+	/// without the sliced ones.
+	static std::vector<VariableDeclaration const*> encodedStateVariables(ContractDefinition const& _contract);
+
+private:
+	bool visit(Assignment const& _assignment) override;
+	void endVisit(Identifier const& _identifier) override;
+	void endVisit(MemberAccess const& _memberAccess) override;
+	void endVisit(InlineAssembly const& _inlineAssembly) override;
+
+	void read(Declaration const* _declaration);
+
+	/// Identifiers that are only assigned to.
+	std::set<Identifier const*> m_assigned;
+	std::set<VariableDeclaration const*> m_read;
+
+	static std::set<VariableDeclaration const*> m_sliced;
+};
+
+}
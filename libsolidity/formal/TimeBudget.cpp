@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/TimeBudget.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::frontend::smt;
+
+void TimeBudget::start()
+{
+	if (limited() && !m_deadline)
+		m_deadline = Clock::now() + chrono::milliseconds(*m_milliseconds);
+}
+
+void TimeBudget::restrictTo(double _share)
+{
+	if (limited())
+		m_restriction = Clock::now() + chrono::milliseconds(static_cast<unsigned>(remaining() * _share));
+}
+
+optional<unsigned> TimeBudget::queryTimeLimit(size_t _remainingTargets) const
+{
+	if (!limited())
+		return nullopt;
+	return static_cast<unsigned>(remaining() / max<size_t>(_remainingTargets, 1));
+}
+
+unsigned TimeBudget::remaining() const
+{
+	if (!m_deadline)
+		return *m_milliseconds;
+	auto deadline = m_restriction ? min(*m_deadline, *m_restriction) : *m_deadline;
+	auto now = Clock::now();
+	if (now >= deadline)
+		return 0;
+	return static_cast<unsigned>(chrono::duration_cast<chrono::milliseconds>(deadline - now).count());
+}
@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * The wall-clock time budget of the model checker, which is shared by its engines.
+ * The engines distribute the remaining time among the verification targets they
+ * still have to check and skip the targets that are left when it is used up.
+ */
+class TimeBudget
+{
+public:
+	explicit TimeBudget(std::optional<unsigned> _milliseconds = {}): m_milliseconds(_milliseconds) {}
+
+	/// @returns true if a budget was given.
+	bool limited() const { return m_milliseconds.has_value(); }
+	/// Starts the clock unless it is running already.
+	void start();
+	/// Restricts the following checks to the part @a _share of the remaining time,
+	/// so that the rest is left for the engine that runs afterwards.
+	void restrictTo(double _share);
+	/// Lifts the restriction of restrictTo().
+	void lift() { m_restriction.reset(); }
+
+	/// @returns true if the time of the budget is used up.
+	bool exhausted() const { return limited() && remaining() == 0; }
+	/// @returns the time limit of a query if @a _remainingTargets targets are still to be checked,
+	/// which is an equal part of the remaining time, or nothing if there is no budget.
+	std::optional<unsigned> queryTimeLimit(size_t _remainingTargets) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/// @returns the remaining time in milliseconds.
+	unsigned remaining() const;
+
+	std::optional<unsigned> m_milliseconds;
+	std::optional<Clock::time_point> m_deadline;
+	std::optional<Clock::time_point> m_restriction;
+};
+
+}
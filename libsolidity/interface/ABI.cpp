@@ -39,12 +39,14 @@ bool anyDataStoredInStorage(TypePointers const& _pointers)
 }
 }
 
-Json::Value ABI::generate(ContractDefinition const& _contractDef)
+Json::Value ABI::generate(ContractDefinition const& _contractDef, TypeCache* _typeCache)
 {
 	auto compare = [](Json::Value const& _a, Json::Value const& _b) -> bool {
 		return make_tuple(_a["type"], _a["name"]) < make_tuple(_b["type"], _b["name"]);
 	};
 	multiset<Json::Value, decltype(compare)> abi(compare);
+	TypeCache localTypeCache;
+	TypeCache& typeCache = _typeCache ? *_typeCache : localTypeCache;
 
 	for (auto it: _contractDef.interfaceFunctions())
 	{
@@ -64,13 +66,15 @@ Json::Value ABI::generate(ContractDefinition const& _contractDef)
 			externalFunctionType->parameterNames(),
 			externalFunctionType->parameterTypes(),
 			it.second->parameterTypes(),
-			_contractDef.isLibrary()
+			_contractDef.isLibrary(),
+			typeCache
 		);
 		method["outputs"] = formatTypeList(
 			externalFunctionType->returnParameterNames(),
 			externalFunctionType->returnParameterTypes(),
 			it.second->returnParameterTypes(),
-			_contractDef.isLibrary()
+			_contractDef.isLibrary(),
+			typeCache
 		);
 		abi.emplace(std::move(method));
 	}
@@ -87,7 +91,8 @@ Json::Value ABI::generate(ContractDefinition const& _contractDef)
 			externalFunctionType->parameterNames(),
 			externalFunctionType->parameterTypes(),
 			constrType.parameterTypes(),
-			_contractDef.isLibrary()
+			_contractDef.isLibrary(),
+			typeCache
 		);
 		abi.emplace(std::move(method));
 	}
@@ -113,7 +118,7 @@ Json::Value ABI::generate(ContractDefinition const& _contractDef)
 			Type const* type = p->annotation().type->interfaceType(false);
 			solAssert(type, "");
 			Json::Value input;
-			auto param = formatType(p->name(), *type, *p->annotation().type, false);
+			auto param = formatType(p->name(), *type, *p->annotation().type, false, typeCache);
 			param["indexed"] = p->isIndexed();
 			params.append(std::move(param));
 		}
@@ -132,7 +137,7 @@ Json::Value ABI::generate(ContractDefinition const& _contractDef)
 			Type const* type = p->annotation().type->interfaceType(false);
 			solAssert(type, "");
 			errorJson["inputs"].append(
-				formatType(p->name(), *type, *p->annotation().type, false)
+				formatType(p->name(), *type, *p->annotation().type, false, typeCache)
 			);
 		}
 		abi.emplace(move(errorJson));
@@ -148,7 +153,8 @@ Json::Value ABI::formatTypeList(
 	vector<string> const& _names,
 	vector<Type const*> const& _encodingTypes,
 	vector<Type const*> const& _solidityTypes,
-	bool _forLibrary
+	bool _forLibrary,
+	TypeCache& _typeCache
 )
 {
 	Json::Value params(Json::arrayValue);
@@ -157,7 +163,7 @@ Json::Value ABI::formatTypeList(
 	for (unsigned i = 0; i < _names.size(); ++i)
 	{
 		solAssert(_encodingTypes[i], "");
-		params.append(formatType(_names[i], *_encodingTypes[i], *_solidityTypes[i], _forLibrary));
+		params.append(formatType(_names[i], *_encodingTypes[i], *_solidityTypes[i], _forLibrary, _typeCache));
 	}
 	return params;
 }
@@ -166,11 +172,27 @@ Json::Value ABI::formatType(
 	string const& _name,
 	Type const& _encodingType,
 	Type const& _solidityType,
-	bool _forLibrary
+	bool _forLibrary,
+	TypeCache& _typeCache
 )
 {
-	Json::Value ret;
+	Json::Value ret = describeType(_encodingType, _solidityType, _forLibrary, _typeCache);
 	ret["name"] = _name;
+	return ret;
+}
+
+Json::Value const& ABI::describeType(
+	Type const& _encodingType,
+	Type const& _solidityType,
+	bool _forLibrary,
+	TypeCache& _typeCache
+)
+{
+	auto key = make_tuple(&_encodingType, &_solidityType, _forLibrary);
+	if (_typeCache.count(key))
+		return _typeCache.at(key);
+
+	Json::Value ret;
 	ret["internalType"] = _solidityType.toString(true);
 	string suffix = (_forLibrary && _encodingType.dataStoredIn(DataLocation::Storage)) ? " storage" : "";
 	if (_encodingType.isValueType() || (_forLibrary && _encodingType.dataStoredIn(DataLocation::Storage)))
@@ -187,11 +209,11 @@ Json::Value ABI::formatType(
 			else
 				suffix = string("[") + arrayType->length().str() + "]";
 			solAssert(arrayType->baseType(), "");
-			Json::Value subtype = formatType(
-				"",
+			Json::Value const& subtype = describeType(
 				*arrayType->baseType(),
 				*dynamic_cast<ArrayType const&>(_solidityType).baseType(),
-				_forLibrary
+				_forLibrary,
+				_typeCache
 			);
 			if (subtype.isMember("components"))
 			{
@@ -211,10 +233,10 @@ Json::Value ABI::formatType(
 			solAssert(member.type, "");
 			Type const* t = member.type->interfaceType(_forLibrary);
 			solAssert(t, "");
-			ret["components"].append(formatType(member.name, *t, *member.type, _forLibrary));
+			ret["components"].append(formatType(member.name, *t, *member.type, _forLibrary, _typeCache));
 		}
 	}
 	else
 		solAssert(false, "Invalid type.");
-	return ret;
+	return _typeCache[key] = move(ret);
 }
@@ -22,8 +22,11 @@
 #pragma once
 
 #include <json/json.h>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -35,10 +38,16 @@ class Type;
 class ABI
 {
 public:
+	/// Descriptions of types without the name of the parameter, keyed by the encoding type,
+	/// the Solidity type and whether they are used in a library. Can be shared between the
+	/// ABIs of all contracts of a compilation, as long as the types are alive.
+	using TypeCache = std::map<std::tuple<Type const*, Type const*, bool>, Json::Value>;
+
 	/// Get the ABI Interface of the contract
 	/// @param _contractDef The contract definition
+	/// @param _typeCache   Optional cache of type descriptions to use and fill
 	/// @return             A JSONrepresentation of the contract's ABI Interface
-	static Json::Value generate(ContractDefinition const& _contractDef);
+	static Json::Value generate(ContractDefinition const& _contractDef, TypeCache* _typeCache = nullptr);
 private:
 	/// @returns a json value suitable for a list of types in function input or output
 	/// parameters or other places. If @a _forLibrary is true, complex types are referenced
@@ -49,7 +58,8 @@ private:
 		std::vector<std::string> const& _names,
 		std::vector<Type const*> const& _encodingTypes,
 		std::vector<Type const*> const& _solidityTypes,
-		bool _forLibrary
+		bool _forLibrary,
+		TypeCache& _typeCache
 	);
 	/// @returns a Json object with "name", "type", "internalType" and potentially
 	/// "components" keys, according to the ABI specification.
@@ -60,7 +70,16 @@ private:
 		std::string const& _name,
 		Type const& _encodingType,
 		Type const& _solidityType,
-		bool _forLibrary
+		bool _forLibrary,
+		TypeCache& _typeCache
+	);
+	/// @returns the object returned by formatType without the "name" key, taking it from
+	/// @a _typeCache if possible and storing it there otherwise.
+	static Json::Value const& describeType(
+		Type const& _encodingType,
+		Type const& _solidityType,
+		bool _forLibrary,
+		TypeCache& _typeCache
 	);
 };
 
@@ -0,0 +1,204 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/JSON.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+optional<size_t> sizeFromJson(Json::Value const& _json)
+{
+	if (!_json.isUInt64())
+		return nullopt;
+	return static_cast<size_t>(_json.asUInt64());
+}
+
+optional<size_t> sizeFromString(string const& _string)
+{
+	if (_string.empty() || _string.size() > 19 || !all_of(_string.begin(), _string.end(), ::isdigit))
+		return nullopt;
+	return static_cast<size_t>(stoull(_string));
+}
+
+}
+
+optional<Json::Value> ArtifactCache::load(util::h256 const& _key) const
+{
+	ifstream file(entryPath(_key).string(), ios::binary);
+	if (!file)
+		return nullopt;
+
+	string content{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+	Json::Value entry;
+	if (file.bad() || !util::jsonParseStrict(content, entry) || !entry.isObject())
+		return nullopt;
+	return entry;
+}
+
+void ArtifactCache::store(util::h256 const& _key, Json::Value const& _entry) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a file of unique name first and move it into place afterwards, so that
+	// concurrent readers never see a partially written entry.
+	fs::path const target = entryPath(_key);
+	fs::path const temporary = m_directory / fs::unique_path(_key.hex() + "-%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return;
+
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << util::jsonCompactPrint(_entry);
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+
+	fs::rename(temporary, target, error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+Json::Value ArtifactCache::objectToJson(LinkerObject const& _object)
+{
+	Json::Value output{Json::objectValue};
+	output["bytecode"] = util::toHex(_object.bytecode);
+
+	output["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		output["linkReferences"][to_string(offset)] = library;
+
+	output["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value immutable{Json::objectValue};
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+		output["immutableReferences"][hash.str()] = immutable;
+	}
+
+	output["functionDebugData"] = Json::objectValue;
+	for (auto const& [name, info]: _object.functionDebugData)
+	{
+		Json::Value function{Json::objectValue};
+		if (info.bytecodeOffset)
+			function["bytecodeOffset"] = Json::UInt64(*info.bytecodeOffset);
+		if (info.sourceID)
+			function["sourceID"] = Json::UInt64(*info.sourceID);
+		function["params"] = Json::UInt64(info.params);
+		function["returns"] = Json::UInt64(info.returns);
+		output["functionDebugData"][name] = function;
+	}
+	return output;
+}
+
+optional<LinkerObject> ArtifactCache::objectFromJson(Json::Value const& _json)
+{
+	if (
+		!_json.isObject() ||
+		!_json["bytecode"].isString() ||
+		!_json["linkReferences"].isObject() ||
+		!_json["immutableReferences"].isObject() ||
+		!_json["functionDebugData"].isObject()
+	)
+		return nullopt;
+
+	LinkerObject object;
+	string const& bytecode = _json["bytecode"].asString();
+	if (bytecode.size() % 2 != 0)
+		return nullopt;
+	object.bytecode = util::fromHex(bytecode);
+	if (object.bytecode.size() * 2 != bytecode.size())
+		return nullopt;
+
+	for (string const& offset: _json["linkReferences"].getMemberNames())
+	{
+		optional<size_t> position = sizeFromString(offset);
+		if (!position || !_json["linkReferences"][offset].isString())
+			return nullopt;
+		object.linkReferences[*position] = _json["linkReferences"][offset].asString();
+	}
+
+	for (string const& hash: _json["immutableReferences"].getMemberNames())
+	{
+		Json::Value const& immutable = _json["immutableReferences"][hash];
+		if (
+			hash.empty() ||
+			hash.size() > 78 ||
+			!all_of(hash.begin(), hash.end(), ::isdigit) ||
+			!immutable["name"].isString() ||
+			!immutable["offsets"].isArray()
+		)
+			return nullopt;
+		vector<size_t> offsets;
+		for (Json::Value const& offset: immutable["offsets"])
+			if (optional<size_t> position = sizeFromJson(offset))
+				offsets.push_back(*position);
+			else
+				return nullopt;
+		object.immutableReferences[u256(hash)] = {immutable["name"].asString(), move(offsets)};
+	}
+
+	for (string const& name: _json["functionDebugData"].getMemberNames())
+	{
+		Json::Value const& function = _json["functionDebugData"][name];
+		if (!function.isObject())
+			return nullopt;
+		LinkerObject::FunctionDebugData info;
+		if (function.isMember("bytecodeOffset") && !(info.bytecodeOffset = sizeFromJson(function["bytecodeOffset"])))
+			return nullopt;
+		if (function.isMember("sourceID") && !(info.sourceID = sizeFromJson(function["sourceID"])))
+			return nullopt;
+		optional<size_t> params = sizeFromJson(function["params"]);
+		optional<size_t> returns = sizeFromJson(function["returns"]);
+		if (!params || !returns)
+			return nullopt;
+		info.params = *params;
+		info.returns = *returns;
+		object.functionDebugData[name] = info;
+	}
+	return object;
+}
+
+fs::path ArtifactCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of compilation artifacts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed store of JSON entries in a directory, one file per key.
+ *
+ * Entries are written atomically, so that several compiler processes can share a directory.
+ * Problems accessing the directory are not reported: an entry that cannot be stored is
+ * simply missing later and an entry that cannot be read is treated as missing.
+ */
+class ArtifactCache
+{
+public:
+	explicit ArtifactCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+	/// @returns the entry stored under @a _key, if any.
+	std::optional<Json::Value> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	/// Converts an unlinked object into the representation used in cache entries.
+	static Json::Value objectToJson(evmasm::LinkerObject const& _object);
+	/// Converts the representation created by @a objectToJson back.
+	/// @returns nullopt if @a _json is not valid.
+	static std::optional<evmasm::LinkerObject> objectFromJson(Json::Value const& _json);
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -26,6 +26,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolidity/analysis/CalldataParameterRelocator.h>
 #include <libsolidity/analysis/ControlFlowAnalyzer.h>
 #include <libsolidity/analysis/ControlFlowGraph.h>
 #include <libsolidity/analysis/ControlFlowRevertPruner.h>
@@ -50,6 +51,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -64,6 +66,7 @@
 #include <libyul/AssemblyStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -73,7 +76,9 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
@@ -114,7 +119,8 @@ void CompilerStack::createAndAssignCallGraphs()
 {
 	for (Source const* source: m_sourceOrder)
 	{
-		if (!source->ast)
+		// Call graphs of reused sources are already assigned.
+		if (!source->ast || source->reused)
 			continue;
 
 		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
@@ -214,6 +220,49 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(unsigned _jobs)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before compiling."));
+	solAssert(_jobs >= 1, "");
+	m_parallelism = _jobs;
+}
+
+void CompilerStack::setArtifactCache(shared_ptr<ArtifactCache const> _cache)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the artifact cache before compiling."));
+	m_artifactCache = move(_cache);
+}
+
+void CompilerStack::enableProfiling(bool _enable, bool _trace)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must enable profiling before parsing."));
+	if (!_enable)
+		m_profiler.reset();
+	else
+	{
+		if (!m_profiler)
+			m_profiler = make_unique<util::Profiler>();
+		m_profiler->enableTracing(_trace);
+	}
+}
+
+void CompilerStack::setIncrementalAnalysis(bool _enable)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set incremental analysis before parsing."));
+	m_incrementalAnalysis = _enable;
+}
+
+void CompilerStack::setCheckImportedSources(bool _check)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the checks of imported sources before parsing."));
+	m_checkImportedSources = _check;
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -287,9 +336,15 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	// Sources analysed without all checks must not be reused by a compilation that requests them.
+	bool const keepAnalysis = m_incrementalAnalysis && m_checkImportedSources && !m_importedSources;
+	if (keepAnalysis)
+		storeIncrementalAnalysisCache();
+
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
+	m_sourceIndices.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -301,18 +356,28 @@ void CompilerStack::reset(bool _keepSettings)
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
 		m_generateIR = false;
+		m_generateOptimizedIR = true;
 		m_generateEwasm = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_parallelism = 1;
+		m_artifactCache.reset();
+		m_incrementalAnalysis = false;
+		m_checkImportedSources = true;
+		m_profiler.reset();
 	}
-	m_globalContext.reset();
+	else if (m_profiler)
+		m_profiler->clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_abiTypeCache.clear();
+	m_storageLayoutTypeCache.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	if (!keepAnalysis)
+		clearIncrementalAnalysisCache();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -321,11 +386,19 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
 
+struct CompilerStack::PreparsedSource
+{
+	ErrorList errors;
+	ErrorReporter errorReporter{errors};
+	unique_ptr<Parser> parser;
+	ASTPointer<SourceUnit> ast;
+};
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
@@ -335,34 +408,116 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
+	util::Profiler::Scope profilerScope(m_profiler.get(), "");
 	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
 
+	unique_ptr<IncrementalAnalysisCache> cache = takeIncrementalAnalysisCache();
+
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
+	// With more than one thread, all sources known at a point are parsed concurrently and
+	// their imports are read ahead of time. The loop below then only takes over the results
+	// in order, so that node IDs and errors are the same as when parsing sequentially.
+	map<string, PreparsedSource> preparsedSources;
+	map<string, ReadCallback::Result> prefetchedReads;
+	size_t preparsedUntil = 0;
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
+		if (m_parallelism > 1 && i == preparsedUntil && sourcesToParse.size() - i > 1)
+		{
+			preparsedUntil = sourcesToParse.size();
+			util::Profiler::Phase phase("parsing");
+			parseConcurrently(
+				vector<string>(sourcesToParse.begin() + static_cast<ptrdiff_t>(i), sourcesToParse.end()),
+				cache.get(),
+				preparsedSources,
+				prefetchedReads
+			);
+		}
+
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
+		// An AST of the previous compilation is only taken over if parsing the source
+		// again would result in the same AST, including the node IDs.
+		bool const unchanged =
+			cache &&
+			cache->sources.count(path) &&
+			cache->sources.at(path).keccak256() == source.keccak256();
+		if (unchanged && cache->sources.at(path).lastNodeIDBefore != parser.lastNodeID())
+			SOL_PERF_COUNTER("solidity.incrementalAnalysis.shiftedSources", 1);
+		if (unchanged && cache->sources.at(path).lastNodeIDBefore == parser.lastNodeID())
+		{
+			source = cache->sources.at(path);
+			source.reused = true;
+			parser.setLastNodeID(source.lastNodeID);
+		}
+		else if (preparsedSources.count(path))
+		{
+			PreparsedSource& preparsed = preparsedSources.at(path);
+			source.lastNodeIDBefore = parser.lastNodeID();
+			preparsed.parser->shiftNodeIDs(parser.lastNodeID());
+			source.ast = move(preparsed.ast);
+			source.lastNodeID = preparsed.parser->lastNodeID();
+			parser.setLastNodeID(source.lastNodeID);
+			m_errorReporter.append(preparsed.errors);
+			preparsedSources.erase(path);
+		}
+		else
+		{
+			util::Profiler::Phase phase("parsing");
+			source.lastNodeIDBefore = parser.lastNodeID();
+			source.scanner->reset();
+			source.ast = parser.parse(source.scanner);
+			source.lastNodeID = parser.lastNodeID();
+		}
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
-			source.ast->annotation().path = path;
+			if (!source.reused)
+				source.ast->annotation().path = path;
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
+			{
+				util::Profiler::Phase phase("import resolution");
+				for (auto& newSource: loadMissingSources(*source.ast, path, prefetchedReads))
 				{
 					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(move(newSource.second), newPath));
 					sourcesToParse.push_back(newPath);
 				}
+			}
 		}
 	}
 
+	if (cache)
+	{
+		bool const reused = reuseAnalysis(parser, *cache);
+		// This destroys the ASTs of the previous compilation that are not used anymore.
+		cache.reset();
+		if (reused)
+			// Types cache their members keyed by AST nodes, which might have been destroyed.
+			TypeProvider::clearMemberCaches();
+		else
+			clearIncrementalAnalysisCache();
+
+		// The errors of the reused sources and of the sources parsed again are reported last,
+		// restore the order in which the sources were parsed.
+		map<string, size_t> parseOrder;
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+			parseOrder.emplace(sourcesToParse[i], i);
+		auto position = [&](Error const& _error) {
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+			if (!location || !location->source)
+				return sourcesToParse.size();
+			return util::valueOrDefault(parseOrder, location->source->name(), sourcesToParse.size());
+		};
+		stable_sort(m_errorList.begin(), m_errorList.end(), [&](auto const& _a, auto const& _b) {
+			return position(*_a) < position(*_b);
+		});
+	}
+
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
 	else
@@ -401,70 +556,131 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
-	resolveImports();
+	util::Profiler::Scope profilerScope(m_profiler.get(), "");
+	{
+		util::Profiler::Phase phase("import resolution");
+		resolveImports();
+	}
+	util::Profiler::Phase analysisPhase("analysis");
 
+	// Sources whose analysis is reused are skipped by all steps that only depend
+	// on the source unit they are applied to and the sources it imports.
+	vector<Source const*> sourcesToAnalyze;
 	for (Source const* source: m_sourceOrder)
+		if (!source->reused)
+			sourcesToAnalyze.push_back(source);
+
+	// The steps that only report errors about the function bodies skip the sources that are not
+	// requested but only imported by requested sources if imported sources are not checked.
+	// The other steps are needed for the code generated for the requested contracts.
+	vector<Source const*> sourcesToCheck;
+	for (Source const* source: sourcesToAnalyze)
+		if (m_checkImportedSources || (source->ast && isRequestedSource(*source->ast->annotation().path)))
+			sourcesToCheck.push_back(source);
+
+	// Each analysis pass is measured as a phase of its own.
+	optional<util::Profiler::Phase> pass;
+	auto beginPass = [&](string_view _name) {
+		pass.reset();
+		pass.emplace(_name);
+	};
+
+	beginPass("scoper");
+	for (Source const* source: sourcesToAnalyze)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
 
 	bool noErrors = true;
 
+	// The analysis stops early on errors. The errors of the reused sources are only reported
+	// for the steps that are reached, so that they are the same as when analysing all sources.
+	vector<size_t> stepStarts;
+	auto beginStep = [&]() { stepStarts.push_back(m_errorReporter.errors().size()); };
+	ScopeGuard reportErrorsOfReusedSources{[&]() { reportReusedErrors(stepStarts); }};
+
 	try
 	{
+		beginStep();
+		beginPass("syntax checker");
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
-		m_globalContext = make_shared<GlobalContext>();
+		// The doc strings do not depend on the declarations and are parsed in the same walk of the AST.
+		// Their errors are only reported after the declarations have been registered, as if they
+		// were parsed in a separate walk.
+		ErrorList docStringErrors;
+		ErrorReporter docStringErrorReporter(docStringErrors);
+		DocStringTagParser docStringTagParser(docStringErrorReporter);
+		FusedASTVisitor syntaxAndDocStringVisitor({&syntaxChecker.visitor(), &docStringTagParser.visitor()});
+		for (Source const* source: sourcesToAnalyze)
+			if (source->ast)
+				source->ast->accept(syntaxAndDocStringVisitor);
+		if (!Error::containsOnlyWarnings(m_errorReporter.errors()))
+			noErrors = false;
+
+		if (!m_globalContext)
+			m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		if (!m_resolver)
+			m_resolver = make_unique<NameAndTypeResolver>(*m_globalContext, m_evmVersion, m_errorReporter);
+		NameAndTypeResolver& resolver = *m_resolver;
+		beginPass("declaration registration");
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !resolver.registerDeclarations(*source->ast))
 				return false;
 
+		beginStep();
+		beginPass("import declarations");
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
 				return false;
 
+		beginStep();
+		beginPass("homonym declarations");
 		resolver.warnHomonymDeclarations();
 
-		DocStringTagParser docStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
+		beginPass("docstring tag parser");
+		m_errorReporter.append(docStringErrors);
+		if (!Error::containsOnlyWarnings(docStringErrors))
+			noErrors = false;
 
 		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
+		beginStep();
+		beginPass("name and type resolution");
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		beginStep();
+		beginPass("declaration type checker");
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
+		beginStep();
+		beginPass("docstring type validation");
 		// Requires DeclarationTypeChecker to have run
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+		for (Source const* source: sourcesToAnalyze)
+			if (source->ast && !DocStringTagParser(m_errorReporter).validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		beginPass("contract level checker");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (auto sourceAst = source->ast)
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
+		beginPass("docstring analyser");
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
@@ -475,16 +691,19 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		beginPass("type checker");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("post type checker");
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 			if (!postTypeChecker.finalize())
@@ -494,39 +713,55 @@ bool CompilerStack::analyze()
 		// Create & assign callgraphs and check for contract dependency cycles
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("call graphs");
 			createAndAssignCallGraphs();
 			findAndReportCyclicContractDependencies();
 		}
 
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+		{
+			beginStep();
+			beginPass("post type contract level checker");
+			for (Source const* source: sourcesToAnalyze)
 				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 					noErrors = false;
+		}
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+		{
+			beginStep();
+			beginPass("immutable validator");
+			for (Source const* source: sourcesToCheck)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("control flow graph");
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
-			CFG cfg(m_errorReporter);
+			auto cfg = make_shared<CFG>(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !cfg.constructFlow(*source->ast))
+				if (source->ast && !cfg->constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
-				ControlFlowRevertPruner pruner(cfg);
+				beginStep();
+				beginPass("control flow analyzer");
+				ControlFlowRevertPruner pruner(*cfg);
 				pruner.run();
+				// Keep the pruned graph for later analysis steps and tools.
+				CFG::annotateFunctions(cfg);
 
-				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
+				ControlFlowAnalyzer controlFlowAnalyzer(*cfg, m_errorReporter);
 				if (!controlFlowAnalyzer.run())
 					noErrors = false;
 			}
@@ -534,18 +769,22 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("static analyzer");
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToCheck)
 				if (source->ast && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
 
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("view pure checker");
 			// Check for state mutability in every function.
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToCheck)
 				if (source->ast)
 					ast.push_back(source->ast);
 
@@ -555,6 +794,8 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			beginStep();
+			beginPass("model checker");
 			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
 			auto allSources = applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 			modelChecker.enableAllEnginesIfPragmaPresent(allSources);
@@ -571,11 +812,15 @@ bool CompilerStack::analyze()
 			throw; // Something is weird here, rather throw again.
 		noErrors = false;
 	}
+	pass.reset();
 
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
 
+	if (m_incrementalAnalysis)
+		recordAnalysis(stepStarts);
+
 	return !m_hasError;
 }
 
@@ -631,12 +876,60 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<pair<ContractDefinition const*, size_t>> compiledContracts;
+	// Contracts to be added to the artifact cache, with the warnings issued while compiling them.
+	vector<pair<ContractDefinition const*, ErrorList>> contractsToCache;
+	// The utility functions are only rendered, parsed and optimised once for all contracts,
+	// the code of library and free functions is only generated once and the IR of contracts
+	// created by several other contracts is only optimised once.
+	m_yulFunctionCache = make_shared<MultiUseYulFunctionCache>();
+	m_yulUtilityCodeCache = make_shared<YulUtilityCodeCache>();
+	m_functionCodeCache = make_shared<FunctionCodeCache>();
+	m_yulObjectCache = make_shared<yul::OptimizedObjectCache>();
+	// The parameters kept in calldata are only known to the code generators,
+	// the annotations of the AST are not changed.
+	auto relocatedParameters = make_shared<RelocatedParameters>();
+	if (m_optimiserSettings.runCalldataParameters)
+		for (Source const* source: m_sourceOrder)
+			CalldataParameterRelocator::relocate(*source->ast, *relocatedParameters);
+	m_relocatedParameters = move(relocatedParameters);
+	ScopeGuard releaseYulCaches{[&]() {
+		m_yulFunctionCache.reset();
+		m_yulUtilityCodeCache.reset();
+		m_functionCodeCache.reset();
+		m_yulObjectCache.reset();
+		m_relocatedParameters.reset();
+	}};
+
+	// Warnings issued while assembling the contracts compiled via the legacy code generator.
+	ErrorList assemblyWarnings;
+	// Assembles the contracts compiled so far, also if the code generation of a later
+	// contract fails. @returns false if an error was reported.
+	auto assembleCompiledContracts = [&]() -> bool {
+		try
+		{
+			assemblyWarnings = assembleContracts(compiledContracts);
+		}
+		catch (Error const& _error)
+		{
+			if (_error.type() != Error::Type::CodeGenerationError)
+				throw;
+			m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+			return false;
+		}
+		return true;
+	};
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
+					bool const useArtifactCache = m_artifactCache && !m_generateEwasm && contract->canBeDeployed();
+					if (useArtifactCache && loadFromArtifactCache(m_contracts.at(contract->fullyQualifiedName())))
+						continue;
+
+					size_t const errorCount = m_errorReporter.errors().size();
 					try
 					{
 						if (m_viaIR || m_generateIR || m_generateEwasm)
@@ -646,7 +939,7 @@ bool CompilerStack::compile(State _stopAfter)
 							if (m_viaIR)
 								generateEVMFromIR(*contract);
 							else
-								compileContract(*contract, otherCompilers);
+								compileContract(*contract, otherCompilers, compiledContracts);
 						}
 						if (m_generateEwasm)
 							generateEwasm(*contract);
@@ -655,7 +948,9 @@ bool CompilerStack::compile(State _stopAfter)
 					{
 						if (_error.type() != Error::Type::CodeGenerationError)
 							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+						// The warnings about the contracts compiled so far precede the error.
+						if (assembleCompiledContracts())
+							m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
 						return false;
 					}
 					catch (UnimplementedFeatureError const& _unimplementedError)
@@ -665,6 +960,8 @@ bool CompilerStack::compile(State _stopAfter)
 							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
 						)
 						{
+							if (!assembleCompiledContracts())
+								return false;
 							string const* comment = _unimplementedError.comment();
 							m_errorReporter.error(
 								1834_error,
@@ -680,12 +977,121 @@ bool CompilerStack::compile(State _stopAfter)
 						else
 							throw;
 					}
+
+					if (useArtifactCache)
+						contractsToCache.emplace_back(
+							contract,
+							ErrorList(m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(errorCount), m_errorReporter.errors().end())
+						);
 				}
+
+	if (!assembleCompiledContracts())
+		return false;
+	m_sourceIndices = sourceIndices();
 	m_stackState = CompilationSuccessful;
+
+	for (auto& [contract, warnings]: contractsToCache)
+	{
+		// Assembling only reports warnings about the contract as a whole.
+		for (auto const& error: assemblyWarnings)
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			if (location && *location == contract->location())
+				warnings.push_back(error);
+		}
+		storeInArtifactCache(m_contracts.at(contract->fullyQualifiedName()), warnings);
+	}
+
 	this->link();
 	return true;
 }
 
+ErrorList CompilerStack::assembleContracts(vector<pair<ContractDefinition const*, size_t>> const& _contracts)
+{
+	// The assembly of a contract shares the sub-assemblies of the contracts it creates and
+	// assembling caches the result inside the Assembly object. Because of that, a contract
+	// can only be assembled after all its dependencies and contracts that are not related
+	// through a bytecode dependency are processed together in one wave.
+	map<ContractDefinition const*, size_t> waveOfContract;
+	vector<vector<ContractDefinition const*>> waves;
+	for (auto const& compiledContract: _contracts)
+	{
+		ContractDefinition const* contract = compiledContract.first;
+		size_t wave = 0;
+		for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+			if (waveOfContract.count(dependency))
+				wave = max(wave, waveOfContract.at(dependency) + 1);
+		waveOfContract[contract] = wave;
+		if (waves.size() <= wave)
+			waves.resize(wave + 1);
+		waves[wave].push_back(contract);
+	}
+
+	util::ThreadPool pool(m_parallelism);
+	for (auto const& wave: waves)
+	{
+		// A wave with a single contract cannot make use of the pool, but its sub-assemblies can.
+		size_t const subParallelism = wave.size() == 1 ? m_parallelism : 1;
+		pool.forEach(wave, [&](ContractDefinition const* _contract) {
+			Contract& compiledContract = m_contracts.at(_contract->fullyQualifiedName());
+			util::Profiler::Scope profilerScope(m_profiler.get(), _contract->fullyQualifiedName());
+			util::Profiler::Phase phase("assembly");
+			solAssert(compiledContract.evmAssembly, "");
+			try
+			{
+				// Assemble deployment (incl. runtime)  object.
+				compiledContract.object = compiledContract.evmAssembly->assemble(subParallelism);
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for bytecode");
+			}
+			solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
+
+			solAssert(compiledContract.evmRuntimeAssembly, "");
+			try
+			{
+				// Assemble runtime object.
+				compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble(subParallelism);
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for deployed bytecode");
+			}
+		});
+	}
+
+	// Warnings are reported in order of compilation, independently of the scheduling above.
+	ErrorList warnings;
+	for (auto const& [contract, errorCount]: _contracts)
+		// Throw a warning if EIP-170 limits are exceeded:
+		//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
+		//   contract creation fails with an out of gas error.
+		if (
+			m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+			m_contracts.at(contract->fullyQualifiedName()).runtimeObject.bytecode.size() > 0x6000
+		)
+		{
+			size_t const previousSize = m_errorList.size();
+			m_errorReporter.warning(
+				5574_error,
+				contract->location(),
+				"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
+				"This contract may not be deployable on mainnet. "
+				"Consider enabling the optimizer (with a low \"runs\" value!), "
+				"turning off revert strings, or using libraries."
+			);
+			if (m_errorList.size() == previousSize)
+				continue;
+			// Move the warning in front of the errors reported after the code generation of the
+			// contract, shifted by the warnings moved before it.
+			auto position = m_errorList.begin() + static_cast<ptrdiff_t>(errorCount + warnings.size());
+			rotate(position, m_errorList.end() - 1, m_errorList.end());
+			warnings.push_back(*position);
+		}
+	return warnings;
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -696,6 +1102,171 @@ void CompilerStack::link()
 	}
 }
 
+void CompilerStack::releaseContract(string const& _contractName)
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract& released = m_contracts.at(contract(_contractName).contract->fullyQualifiedName());
+	// The assemblies stay alive as long as they are sub-assemblies of contracts not released yet.
+	released.compiler.reset();
+	released.evmAssembly.reset();
+	released.evmRuntimeAssembly.reset();
+	string().swap(released.yulIR);
+	string().swap(released.yulIROptimized);
+	released.yulIROptimizedObject.reset();
+	released.yulFunctionExecutionsPerDeployment.clear();
+	string().swap(released.ewasm);
+	released.metadata.reset();
+	released.abi.reset();
+	released.storageLayout.reset();
+	released.userDocumentation.reset();
+	released.devDocumentation.reset();
+	released.generatedSources.reset();
+	released.runtimeGeneratedSources.reset();
+	released.sourceMappingEntries.reset();
+	released.runtimeSourceMappingEntries.reset();
+	released.sourceMapping.reset();
+	released.runtimeSourceMapping.reset();
+}
+
+util::h256 CompilerStack::artifactCacheKey(Contract const& _contract) const
+{
+	// The metadata covers the sources and all settings that influence the generated code,
+	// apart from the format of the metadata itself and from which outputs are generated.
+	return util::keccak256(
+		metadata(_contract) +
+		"\n" + to_string(static_cast<int>(m_metadataFormat)) +
+		(m_generateEvmBytecode ? "\nevm" : "") +
+		(m_viaIR || m_generateIR ? "\nir" : "") +
+		(m_viaIR || (m_generateIR && m_generateOptimizedIR) ? "\nirOptimized" : "")
+	);
+}
+
+bool CompilerStack::loadFromArtifactCache(Contract& _contract)
+{
+	solAssert(m_artifactCache, "");
+	optional<Json::Value> entry = m_artifactCache->load(artifactCacheKey(_contract));
+	if (!entry)
+		return false;
+
+	optional<evmasm::LinkerObject> object;
+	optional<evmasm::LinkerObject> runtimeObject;
+	if (m_generateEvmBytecode)
+	{
+		object = ArtifactCache::objectFromJson((*entry)["bytecode"]);
+		runtimeObject = ArtifactCache::objectFromJson((*entry)["deployedBytecode"]);
+		if (!object || !runtimeObject)
+			return false;
+	}
+	if ((m_viaIR || m_generateIR) && (!(*entry)["ir"].isString() || !(*entry)["irOptimized"].isString()))
+		return false;
+	for (char const* sourceMap: {"sourceMap", "deployedSourceMap"})
+		if (entry->isMember(sourceMap) && !(*entry)[sourceMap].isString())
+			return false;
+
+	vector<tuple<ErrorId, SourceLocation, string>> warnings;
+	if (!(*entry)["warnings"].isArray())
+		return false;
+	for (Json::Value const& warning: (*entry)["warnings"])
+	{
+		if (!warning.isObject() || !warning["errorId"].isUInt64() || !warning["message"].isString())
+			return false;
+		SourceLocation location;
+		if (warning.isMember("source"))
+		{
+			if (
+				!warning["source"].isString() ||
+				!m_sources.count(warning["source"].asString()) ||
+				!warning["start"].isInt() ||
+				!warning["end"].isInt()
+			)
+				return false;
+			location.source = m_sources.at(warning["source"].asString()).scanner->charStream();
+			location.start = warning["start"].asInt();
+			location.end = warning["end"].asInt();
+			if (location.start < 0 || location.end < location.start || static_cast<size_t>(location.end) > location.source->source().size())
+				return false;
+		}
+		warnings.emplace_back(ErrorId{warning["errorId"].asUInt64()}, move(location), warning["message"].asString());
+	}
+
+	if (m_generateEvmBytecode)
+	{
+		_contract.object = move(*object);
+		_contract.runtimeObject = move(*runtimeObject);
+		if (entry->isMember("sourceMap"))
+			_contract.sourceMapping.emplace((*entry)["sourceMap"].asString());
+		if (entry->isMember("deployedSourceMap"))
+			_contract.runtimeSourceMapping.emplace((*entry)["deployedSourceMap"].asString());
+	}
+	if (m_viaIR || m_generateIR)
+	{
+		_contract.yulIR = (*entry)["ir"].asString();
+		_contract.yulIROptimized = (*entry)["irOptimized"].asString();
+	}
+
+	// Warnings about contracts that are also generated or taken from the cache otherwise
+	// would be reported several times.
+	for (auto const& [errorId, location, message]: warnings)
+		if (none_of(
+			m_errorReporter.errors().begin(),
+			m_errorReporter.errors().end(),
+			[&, &errorId = errorId, &location = location, &message = message](shared_ptr<Error const> const& _error) {
+				SourceLocation const* errorLocation = boost::get_error_info<errinfo_sourceLocation>(*_error);
+				return
+					_error->errorId() == errorId &&
+					_error->comment() && *_error->comment() == message &&
+					(errorLocation ? *errorLocation : SourceLocation{}) == location;
+			}
+		))
+			m_errorReporter.warning(errorId, location, message);
+	return true;
+}
+
+void CompilerStack::storeInArtifactCache(Contract const& _contract, ErrorList const& _warnings) const
+{
+	solAssert(m_artifactCache, "");
+	string const& contractName = _contract.contract->fullyQualifiedName();
+
+	Json::Value entry{Json::objectValue};
+	if (m_generateEvmBytecode)
+	{
+		entry["bytecode"] = ArtifactCache::objectToJson(_contract.object);
+		entry["deployedBytecode"] = ArtifactCache::objectToJson(_contract.runtimeObject);
+		if (string const* sourceMap = sourceMapping(contractName))
+			entry["sourceMap"] = *sourceMap;
+		if (string const* sourceMap = runtimeSourceMapping(contractName))
+			entry["deployedSourceMap"] = *sourceMap;
+	}
+	if (m_viaIR || m_generateIR)
+	{
+		entry["ir"] = _contract.yulIR;
+		entry["irOptimized"] = _contract.yulIROptimized;
+	}
+
+	entry["warnings"] = Json::arrayValue;
+	for (auto const& error: _warnings)
+	{
+		// Only plain warnings can be reproduced from the cache.
+		if (error->type() != Error::Type::Warning || boost::get_error_info<errinfo_secondarySourceLocation>(*error))
+			return;
+		Json::Value warning{Json::objectValue};
+		warning["errorId"] = Json::UInt64(error->errorId().error);
+		warning["message"] = error->comment() ? *error->comment() : string{};
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		if (location && location->source)
+		{
+			warning["source"] = location->source->name();
+			warning["start"] = location->start;
+			warning["end"] = location->end;
+		}
+		entry["warnings"].append(move(warning));
+	}
+
+	m_artifactCache->store(artifactCacheKey(_contract), entry);
+}
+
 vector<string> CompilerStack::contractNames() const
 {
 	if (m_stackState < Parsed)
@@ -779,6 +1350,36 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 	});
 }
 
+evmasm::SourceMapping const* CompilerStack::sourceMappingEntries(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	if (!c.sourceMappingEntries)
+	{
+		if (auto items = assemblyItems(_contractName))
+			c.sourceMappingEntries.emplace(evmasm::AssemblyItem::computeSourceMappingEntries(*items, m_sourceIndices));
+	}
+	return c.sourceMappingEntries ? &*c.sourceMappingEntries : nullptr;
+}
+
+evmasm::SourceMapping const* CompilerStack::runtimeSourceMappingEntries(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	if (!c.runtimeSourceMappingEntries)
+	{
+		if (auto items = runtimeAssemblyItems(_contractName))
+			c.runtimeSourceMappingEntries.emplace(
+				evmasm::AssemblyItem::computeSourceMappingEntries(*items, m_sourceIndices)
+			);
+	}
+	return c.runtimeSourceMappingEntries ? &*c.runtimeSourceMappingEntries : nullptr;
+}
+
 string const* CompilerStack::sourceMapping(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -787,8 +1388,8 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	Contract const& c = contract(_contractName);
 	if (!c.sourceMapping)
 	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
+		if (auto entries = sourceMappingEntries(_contractName))
+			c.sourceMapping.emplace(evmasm::AssemblyItem::renderSourceMapping(*entries));
 	}
 	return c.sourceMapping ? &*c.sourceMapping : nullptr;
 }
@@ -801,10 +1402,8 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	Contract const& c = contract(_contractName);
 	if (!c.runtimeSourceMapping)
 	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.emplace(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
+		if (auto entries = runtimeSourceMappingEntries(_contractName))
+			c.runtimeSourceMapping.emplace(evmasm::AssemblyItem::renderSourceMapping(*entries));
 	}
 	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
 }
@@ -941,7 +1540,7 @@ Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract); });
+	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract, &m_abiTypeCache); });
 }
 
 Json::Value const& CompilerStack::storageLayout(string const& _contractName) const
@@ -959,7 +1558,7 @@ Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract); });
+	return _contract.storageLayout.init([&]{ return StorageLayout(&m_storageLayoutTypeCache).generate(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
@@ -1102,21 +1701,98 @@ h256 const& CompilerStack::Source::keccak256() const
 	return keccak256HashCached;
 }
 
-h256 const& CompilerStack::Source::swarmHash() const
+h256 const& CompilerStack::Source::swarmHash(size_t _parallelism) const
 {
 	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(scanner->source());
+		swarmHashCached = util::bzzr1Hash(scanner->source(), _parallelism);
 	return swarmHashCached;
 }
 
-string const& CompilerStack::Source::ipfsUrl() const
+string const& CompilerStack::Source::ipfsUrl(size_t _parallelism) const
 {
 	if (ipfsUrlCached.empty())
-		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(scanner->source());
+		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(scanner->source(), _parallelism);
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+Json::Value const& CompilerStack::Source::metadata(bool _literalContent, size_t _parallelism) const
+{
+	optional<Json::Value>& cached = _literalContent ? metadataWithContentCached : metadataWithUrlsCached;
+	if (cached)
+		return *cached;
+
+	solAssert(scanner, "Scanner not available");
+	Json::Value entry{Json::objectValue};
+	entry["keccak256"] = "0x" + toHex(keccak256().asBytes());
+	if (optional<string> licenseString = ast->licenseString())
+		entry["license"] = *licenseString;
+	if (_literalContent)
+		entry["content"] = scanner->source();
+	else
+	{
+		entry["urls"] = Json::arrayValue;
+		entry["urls"].append("bzz-raw://" + toHex(swarmHash(_parallelism).asBytes()));
+		entry["urls"].append(ipfsUrl(_parallelism));
+	}
+	cached = std::move(entry);
+	return *cached;
+}
+
+void CompilerStack::parseConcurrently(
+	vector<string> const& _paths,
+	IncrementalAnalysisCache const* _cache,
+	map<string, PreparsedSource>& _parsed,
+	map<string, ReadCallback::Result>& _prefetchedReads
+)
+{
+	// The dialect is created lazily and its creation is not thread-safe.
+	yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+
+	vector<pair<string, PreparsedSource*>> tasks;
+	for (string const& path: _paths)
+	{
+		Source const& source = m_sources.at(path);
+		if (_cache && _cache->sources.count(path) && _cache->sources.at(path).keccak256() == source.keccak256())
+			continue;
+		PreparsedSource& preparsed = _parsed[path];
+		preparsed.parser = make_unique<Parser>(preparsed.errorReporter, m_evmVersion, m_parserErrorRecovery);
+		preparsed.parser->setRelocatableNodeIDs();
+		tasks.emplace_back(path, &preparsed);
+	}
+
+	util::ThreadPool pool(m_parallelism);
+	pool.forEach(tasks, [&](pair<string, PreparsedSource*> const& _task) {
+		auto const& [path, preparsed] = _task;
+		Source const& source = m_sources.at(path);
+		source.scanner->reset();
+		preparsed->ast = preparsed->parser->parse(source.scanner);
+	});
+
+	if (m_stopAfter < ParsedAndImported || !m_readFile)
+		return;
+	// The read callback is provided by the user of the compiler and does not have to be
+	// thread-safe (e.g. in solc-js), so the imports are only read on this thread.
+	for (auto const& [path, preparsed]: tasks)
+	{
+		if (!preparsed->ast)
+			continue;
+		for (auto const* import: ASTNode::filteredNodes<ImportDirective>(preparsed->ast->nodes()))
+		{
+			if (import->path().empty())
+				continue;
+			string const importedPath = importPath(*import, path);
+			if (m_sources.count(importedPath) || _prefetchedReads.count(importedPath))
+				continue;
+			_prefetchedReads[importedPath] = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importedPath);
+		}
+	}
+}
+
+StringMap CompilerStack::loadMissingSources(
+	SourceUnit const& _ast,
+	string const& _sourcePath,
+	map<string, ReadCallback::Result>& _prefetchedReads
+)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
 	StringMap newSources;
@@ -1127,21 +1803,28 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 			{
 				solAssert(!import->path().empty(), "Import path cannot be empty.");
 
-				string importPath = util::absolutePath(import->path(), _sourcePath);
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				importPath = applyRemapping(importPath, _sourcePath);
-				import->annotation().absolutePath = importPath;
+				string const importPath = this->importPath(*import, _sourcePath);
+				// ASTs taken over from the previous compilation already store the path.
+				if (import->annotation().absolutePath.set())
+					solAssert(*import->annotation().absolutePath == importPath, "");
+				else
+					import->annotation().absolutePath = importPath;
 				if (m_sources.count(importPath) || newSources.count(importPath))
 					continue;
 
 				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
+				if (auto prefetched = _prefetchedReads.find(importPath); prefetched != _prefetchedReads.end())
+				{
+					// A prefetched result is only used once. Imports of files that were not found
+					// read them again, like they would without prefetching.
+					result = move(prefetched->second);
+					_prefetchedReads.erase(prefetched);
+				}
+				else if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1160,6 +1843,14 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 	return newSources;
 }
 
+string CompilerStack::importPath(ImportDirective const& _import, string const& _path)
+{
+	// The result of `absolutePath` is the absolute path as seen from this source file.
+	// We first have to apply remappings before we can store the actual absolute path
+	// as seen globally.
+	return applyRemapping(util::absolutePath(_import.path(), _path), _path);
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1198,6 +1889,200 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+void CompilerStack::storeIncrementalAnalysisCache()
+{
+	// Nothing was parsed since the cache was stored.
+	if (m_stackState < Parsed)
+		return;
+
+	auto cache = make_unique<IncrementalAnalysisCache>();
+	cache->evmVersion = m_evmVersion;
+	cache->remappings = m_importRemapper.remappings();
+	cache->runYulOptimiser = m_optimiserSettings.runYulOptimiser;
+	bool reusedAnalysis = false;
+	for (auto& [path, source]: m_sources)
+	{
+		reusedAnalysis = reusedAnalysis || source.reused;
+		if (source.ast && source.analysed)
+			cache->sources[path] = move(source);
+		else if (source.ast && m_resolver)
+			m_resolver->removeSourceUnit(*source.ast);
+	}
+	if (!reusedAnalysis)
+		m_typeCountAfterFullAnalysis = TypeProvider::generalTypeCount();
+	m_incrementalAnalysisCache = move(cache);
+}
+
+void CompilerStack::recordAnalysis(vector<size_t> const& _stepStarts)
+{
+	auto sourceOf = [&](Error const& _error) -> Source*
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+		if (!location || !location->source)
+			return nullptr;
+		auto it = m_sources.find(location->source->name());
+		return it == m_sources.end() ? nullptr : &it->second;
+	};
+
+	for (size_t i = 0; i < m_errorList.size(); ++i)
+		if (Source* source = sourceOf(*m_errorList[i]); source && !source->reused)
+		{
+			size_t const step = static_cast<size_t>(
+				upper_bound(_stepStarts.begin(), _stepStarts.end(), i) - _stepStarts.begin()
+			);
+			source->errors.emplace_back(m_errorList[i], step);
+		}
+
+	// The steps applied to all sources can report the errors of reused sources again.
+	m_errorList.erase(
+		remove_if(m_errorList.begin(), m_errorList.end(), [&](shared_ptr<Error const> const& _error) {
+			Source const* source = sourceOf(*_error);
+			return
+				source &&
+				source->reused &&
+				none_of(source->errors.begin(), source->errors.end(), [&](auto const& _reused) {
+					return _reused.first == _error;
+				}) &&
+				any_of(source->errors.begin(), source->errors.end(), [&](auto const& _reused) {
+					Error const& reused = *_reused.first;
+					return
+						reused.errorId() == _error->errorId() &&
+						reused.type() == _error->type() &&
+						string(reused.what()) == _error->what() &&
+						*boost::get_error_info<errinfo_sourceLocation>(reused) ==
+							*boost::get_error_info<errinfo_sourceLocation>(*_error);
+				});
+		}),
+		m_errorList.end()
+	);
+
+	if (!m_hasError)
+		for (Source const* source: m_sourceOrder)
+			if (source->ast)
+				m_sources.at(*source->ast->annotation().path).analysed = true;
+}
+
+void CompilerStack::reportReusedErrors(vector<size_t> const& _stepStarts)
+{
+	// The steps visit the sources in the order of m_sourceOrder.
+	for (size_t step = 1; step <= _stepStarts.size(); ++step)
+		for (Source const* source: m_sourceOrder)
+			if (source->reused)
+				for (auto const& [error, errorStep]: source->errors)
+					if (errorStep == step)
+						m_errorReporter.append({error});
+}
+
+void CompilerStack::clearIncrementalAnalysisCache()
+{
+	m_incrementalAnalysisCache.reset();
+	m_resolver.reset();
+	m_globalContext.reset();
+	TypeProvider::reset();
+}
+
+unique_ptr<CompilerStack::IncrementalAnalysisCache> CompilerStack::takeIncrementalAnalysisCache()
+{
+	// Types are never destroyed while analysis results are kept, so start from scratch
+	// once the types of discarded ASTs and of code generation are dominating.
+	size_t const maxTypeCount = 4 * m_typeCountAfterFullAnalysis;
+
+	unique_ptr<IncrementalAnalysisCache> cache = move(m_incrementalAnalysisCache);
+	if (
+		cache &&
+		m_incrementalAnalysis &&
+		m_stopAfter >= AnalysisPerformed &&
+		cache->evmVersion == m_evmVersion &&
+		cache->remappings == m_importRemapper.remappings() &&
+		cache->runYulOptimiser == m_optimiserSettings.runYulOptimiser &&
+		TypeProvider::generalTypeCount() <= maxTypeCount
+	)
+		return cache;
+
+	cache.reset();
+	clearIncrementalAnalysisCache();
+	return nullptr;
+}
+
+bool CompilerStack::reuseAnalysis(Parser& _parser, IncrementalAnalysisCache const& _cache)
+{
+	// Sources that are analysed again force the analysis of all sources importing them.
+	set<string> changedSources;
+	vector<string> worklist;
+	auto markChanged = [&](string const& _path)
+	{
+		if (changedSources.insert(_path).second)
+			worklist.push_back(_path);
+	};
+	map<string, vector<string>> importers;
+	for (auto const& [path, source]: m_sources)
+	{
+		if (!source.reused)
+			markChanged(path);
+		if (source.ast)
+			for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			{
+				if (!import->annotation().absolutePath.set())
+					continue;
+				string const& importPath = *import->annotation().absolutePath;
+				if (m_sources.count(importPath))
+					importers[importPath].push_back(path);
+				else
+					markChanged(path);
+			}
+	}
+	while (!worklist.empty())
+	{
+		string path = move(worklist.back());
+		worklist.pop_back();
+		for (string const& importer: importers[path])
+			markChanged(importer);
+	}
+
+	// The annotations of the ASTs taken over cannot be overwritten, so parse them again.
+	for (string const& path: changedSources)
+	{
+		Source& source = m_sources.at(path);
+		if (!source.reused)
+			continue;
+
+		SOL_PERF_COUNTER("solidity.incrementalAnalysis.reparsedSources", 1);
+		ASTPointer<SourceUnit> previousAST = move(source.ast);
+		source.errors.clear();
+		source.analysed = false;
+		source.reused = false;
+		_parser.setLastNodeID(source.lastNodeIDBefore);
+		source.scanner->reset();
+		source.ast = _parser.parse(source.scanner);
+		solAssert(source.ast && _parser.lastNodeID() == source.lastNodeID, "");
+		source.ast->annotation().path = path;
+
+		auto imports = ASTNode::filteredNodes<ImportDirective>(source.ast->nodes());
+		auto previousImports = ASTNode::filteredNodes<ImportDirective>(previousAST->nodes());
+		solAssert(imports.size() == previousImports.size(), "");
+		for (size_t i = 0; i < imports.size(); ++i)
+			imports[i]->annotation().absolutePath = *previousImports[i]->annotation().absolutePath;
+	}
+
+	bool reused = false;
+	for (auto const& [path, source]: m_sources)
+		if (source.reused)
+		{
+			SOL_PERF_COUNTER("solidity.incrementalAnalysis.reusedSources", 1);
+			for (auto const& [error, step]: source.errors)
+				if (step == 0)
+					m_errorReporter.append({error});
+			reused = true;
+		}
+
+	if (m_resolver)
+		for (auto const& [path, cachedSource]: _cache.sources)
+			if (!m_sources.count(path) || m_sources.at(path).ast != cachedSource.ast)
+				m_resolver->removeSourceUnit(*cachedSource.ast);
+
+	return reused;
+}
+
 void CompilerStack::storeContractDefinitions()
 {
 	for (auto const& pair: m_sources)
@@ -1229,7 +2114,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	vector<pair<ContractDefinition const*, size_t>>& _compiledContracts
 )
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1240,14 +2126,25 @@ void CompilerStack::compileContract(
 		return;
 
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _compiledContracts);
 
 	if (!_contract.canBeDeployed())
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Phase phase("code generation");
+
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		m_parallelism,
+		m_yulFunctionCache,
+		m_yulUtilityCodeCache,
+		m_functionCodeCache,
+		m_relocatedParameters
+	);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1264,46 +2161,11 @@ void CompilerStack::compileContract(
 
 	compiledContract.evmAssembly = compiler->assemblyPtr();
 	solAssert(compiledContract.evmAssembly, "");
-	try
-	{
-		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiledContract.evmAssembly->assemble();
-	}
-	catch(evmasm::AssemblyException const&)
-	{
-		solAssert(false, "Assembly exception for bytecode");
-	}
-	solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
-
 	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
 	solAssert(compiledContract.evmRuntimeAssembly, "");
-	try
-	{
-		// Assemble runtime object.
-		compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble();
-	}
-	catch(evmasm::AssemblyException const&)
-	{
-		solAssert(false, "Assembly exception for deployed bytecode");
-	}
-
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			5574_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
 
 	_otherCompilers[compiledContract.contract] = compiler;
+	_compiledContracts.emplace_back(compiledContract.contract, m_errorReporter.errors().size());
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1335,8 +2197,28 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Phase phase("IR generation");
+	IRGenerator generator(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		m_parallelism,
+		m_yulFunctionCache,
+		m_yulObjectCache,
+		m_relocatedParameters
+	);
+	shared_ptr<yul::Object> optimizedObject;
+	tie(compiledContract.yulIR, compiledContract.yulIROptimized, optimizedObject) = generator.run(
+		_contract,
+		otherYulSources,
+		m_generateOptimizedIR || m_viaIR || m_generateEwasm
+	);
+	compiledContract.yulFunctionExecutionsPerDeployment = generator.functionExecutionsPerDeployment();
+	// Keep the object for the bytecode generation, which can then skip parsing and analyzing
+	// the optimized IR again.
+	if (m_viaIR || m_generateEwasm)
+		compiledContract.yulIROptimizedObject = move(optimizedObject);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1353,9 +2235,14 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Phase phase("EVM code generation from IR");
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.setParallelism(m_parallelism);
+	stack.setFunctionExecutionsPerDeployment(compiledContract.yulFunctionExecutionsPerDeployment);
+	stack.setObjectCache(m_yulObjectCache);
+	useYulIROptimized(stack, compiledContract);
+	// The optimized IR is optimized again. Skipping this would change the bytecode generated via IR.
 	stack.optimize();
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
@@ -1364,7 +2251,8 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	// TODO: use stack.assemble here!
 	yul::MachineAssemblyObject init;
 	yul::MachineAssemblyObject runtime;
-	std::tie(init, runtime) = stack.assembleWithDeployed(IRNames::deployedObject(_contract));
+	// The assembly text and source mappings are not available for this code path (see below).
+	std::tie(init, runtime) = stack.assembleWithDeployed(IRNames::deployedObject(_contract), false);
 	compiledContract.object = std::move(*init.bytecode);
 	compiledContract.runtimeObject = std::move(*runtime.bytecode);
 	// TODO: refactor assemblyItems, runtimeAssemblyItems, generatedSources,
@@ -1387,6 +2275,16 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		);
 }
 
+void CompilerStack::useYulIROptimized(yul::AssemblyStack& _stack, Contract& _contract)
+{
+	// The stack modifies the object, so only the first stage can use it and later
+	// stages re-parse the Yul IR in EVM dialect.
+	if (_contract.yulIROptimizedObject)
+		_stack.useAnalyzedObject(move(_contract.yulIROptimizedObject));
+	else
+		solAssert(_stack.parseAndAnalyze("", _contract.yulIROptimized), "");
+}
+
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1401,9 +2299,12 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	if (!compiledContract.ewasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Phase phase("Ewasm generation");
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.setParallelism(m_parallelism);
+	stack.setFunctionExecutionsPerDeployment(compiledContract.yulFunctionExecutionsPerDeployment);
+	useYulIROptimized(stack, compiledContract);
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1476,28 +2377,23 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		if (!referencedSources.count(s.first))
 			continue;
 
-		solAssert(s.second.scanner, "Scanner not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + toHex(s.second.keccak256().asBytes());
-		if (optional<string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.scanner->source();
-		else
-		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
-		}
+		meta["sources"][s.first] = s.second.metadata(m_metadataLiteralSources, m_parallelism);
 	}
 
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	for (auto const& [sourceUnit, contracts]: m_optimiserSettings.executionProfile)
+		for (auto const& [contractName, functions]: contracts)
+			for (auto const& [functionName, executions]: functions)
+				meta["settings"]["optimizer"]["executionProfile"][sourceUnit][contractName][functionName] =
+					Json::Value(Json::LargestUInt(executions));
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.executionProfile = {};
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1512,6 +2408,12 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
+		if (m_optimiserSettings.runExtendedCSE)
+			details["cseExtendedBlocks"] = true;
+		if (m_optimiserSettings.runColdCodeMover)
+			details["coldCodeMover"] = true;
+		if (m_optimiserSettings.runCalldataParameters)
+			details["calldataParameters"] = true;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
@@ -1519,6 +2421,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.optimizeStackLayout)
+				details["yulDetails"]["stackLayout"] = true;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1688,7 +2592,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
-Json::Value CompilerStack::gasEstimates(string const& _contractName) const
+Json::Value CompilerStack::gasEstimates(string const& _contractName, bool _upperBoundOnly) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -1716,20 +2620,26 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 
 	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
 	{
+		/// Without a signature, all paths through the runtime code are taken into account,
+		/// so this is an upper bound for every function.
+		optional<Gas> upperBound;
+		if (_upperBoundOnly)
+			upperBound = gasEstimator.functionalEstimation(*items);
+
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
 		Json::Value externalFunctions(Json::objectValue);
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalFunctions[sig] = gasToJson(upperBound ? *upperBound : gasEstimator.functionalEstimation(*items, sig));
 		}
 
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			externalFunctions[""] = gasToJson(upperBound ? *upperBound : gasEstimator.functionalEstimation(*items, "INVALID"));
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
@@ -1745,7 +2655,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 			size_t entry = functionEntryPoint(_contractName, *it);
 			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
 			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+				gas = upperBound ? *upperBound : gasEstimator.functionalEstimation(*items, entry, *it);
 
 			/// TODO: This could move into a method shared with externalSignature()
 			FunctionType type(*it);
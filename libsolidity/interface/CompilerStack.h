@@ -25,9 +25,11 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/StorageLayout.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
@@ -39,16 +41,19 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <libevmasm/AssemblyItem.h>
 #include <libevmasm/LinkerObject.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -67,6 +72,13 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class AssemblyStack;
+struct Object;
+class OptimizedObjectCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -79,6 +91,13 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class ArtifactCache;
+class MultiUseYulFunctionCache;
+class YulUtilityCodeCache;
+class FunctionCodeCache;
+class RelocatedParameters;
+class NameAndTypeResolver;
+class Parser;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -163,10 +182,42 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Enables or disables reusing the analysis results of the previous compilation.
+	/// When enabled, reset() keeps the analysed source units and the next compilation
+	/// only analyses the source units whose content changed, together with all source units
+	/// that import them directly or indirectly. The results do not depend on this setting,
+	/// apart from the order of the reported errors.
+	/// Must be set before parsing. Disabled by reset() unless the settings are kept.
+	void setIncrementalAnalysis(bool _enable = true);
+
+	/// Enables or disables the checks of the source units that are not requested but only imported
+	/// by requested ones. When disabled, these source units are only analysed as far as needed to
+	/// compile the requested contracts, i.e. the steps that only report errors and warnings about
+	/// function bodies, like the static analyzer and the view and pure checker, skip them.
+	/// Disables keeping the analysis for incremental analysis.
+	/// Must be set before parsing. Enabled by reset() unless the settings are kept.
+	void setCheckImportedSources(bool _check);
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the number of threads that may be used during parsing and code generation.
+	/// Source units are parsed concurrently, contracts that do not depend on each other's
+	/// bytecode are processed concurrently and the Yul optimizer processes functions concurrently.
+	/// The output does not depend on this setting. The read callback is always called from the
+	/// thread that calls into the compiler stack.
+	/// Must be set before compiling.
+	void setParallelism(unsigned _jobs);
+
+	/// Sets the cache from which the bytecode and IR of contracts are taken instead of
+	/// generating them, and to which newly generated ones are added.
+	/// Entries are keyed by the hash of the metadata of the contract and by which outputs are
+	/// generated. Contracts taken from the cache have no assembly, so the cache must not be
+	/// used if assembly outputs, gas estimates, generated sources or Ewasm are requested.
+	/// Must be set before compiling.
+	void setArtifactCache(std::shared_ptr<ArtifactCache const> _cache);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -190,11 +241,22 @@ public:
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
 	/// Enable experimental generation of Yul IR code.
-	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
+	/// If @a _optimized is false, the optimized IR is only generated where the bytecode or
+	/// Ewasm code is generated from it.
+	void enableIRGeneration(bool _enable = true, bool _optimized = true)
+	{
+		m_generateIR = _enable;
+		m_generateOptimizedIR = _optimized;
+	}
 
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enables measuring the time and memory spent in the phases of the compilation,
+	/// which are available from @a profiler afterwards. If @a _trace is true, the spans of
+	/// the phases are also recorded for a timeline of the compilation.
+	void enableProfiling(bool _enable = true, bool _trace = false);
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -232,6 +294,14 @@ public:
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Releases the compiler, the assemblies, the IR and the cached outputs of the contract
+	/// @a _contractName, keeping only its bytecode objects, once its outputs were retrieved.
+	/// Afterwards, the assembly, IR, Ewasm text, source mappings, generated sources and gas
+	/// estimates of the contract are no longer available, while the other outputs are
+	/// generated again if requested.
+	/// Can only be called after state is CompilationSuccessful.
+	void releaseContract(std::string const& _contractName);
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -258,6 +328,11 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the measurements of the phases of the compilation, by fully qualified contract
+	/// name and with the empty name for the phases that apply to all contracts, or null if
+	/// profiling is not enabled.
+	util::Profiler const* profiler() const { return m_profiler.get(); }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -303,6 +378,13 @@ public:
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
+	/// @returns the mapping between bytecode and sourcecode with one entry per assembly item,
+	/// which is rendered by @a sourceMapping, or a nullptr if the contract does not (yet) have bytecode.
+	evmasm::SourceMapping const* sourceMappingEntries(std::string const& _contractName) const;
+
+	/// @returns the same as @a sourceMappingEntries for the runtime bytecode.
+	evmasm::SourceMapping const* runtimeSourceMappingEntries(std::string const& _contractName) const;
+
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
@@ -339,7 +421,9 @@ public:
 	bytes cborMetadata(std::string const& _contractName) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json::Value gasEstimates(std::string const& _contractName) const;
+	/// @param _upperBoundOnly if true, the runtime code is only analysed once and the resulting upper bound
+	/// on the costs of any call is reported for all functions.
+	Json::Value gasEstimates(std::string const& _contractName, bool _upperBoundOnly = false) const;
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	/// This is mostly a workaround to avoid bytecode and gas differences between compiler builds
@@ -354,10 +438,28 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// Entries of the source in the metadata with the URLs and with the literal content.
+		std::optional<Json::Value> mutable metadataWithUrlsCached;
+		std::optional<Json::Value> mutable metadataWithContentCached;
+		/// Last AST node ID assigned by the parser before and after parsing this source.
+		int64_t lastNodeIDBefore = 0;
+		int64_t lastNodeID = 0;
+		/// Errors located in this source, recorded in incremental analysis mode, together with
+		/// the step of the analysis that reported them (zero for the parser).
+		std::vector<std::pair<std::shared_ptr<langutil::Error const>, size_t>> errors;
+		/// True if the AST was analysed without errors.
+		bool analysed = false;
+		/// True if the analysis of the AST was done by a previous compilation.
+		bool reused = false;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
-		util::h256 const& swarmHash() const;
-		std::string const& ipfsUrl() const;
+		/// The hashes of large sources are computed using up to @a _parallelism threads.
+		util::h256 const& swarmHash(size_t _parallelism = 1) const;
+		std::string const& ipfsUrl(size_t _parallelism = 1) const;
+		/// @returns the entry of the source in the "sources" of the metadata, which contains the
+		/// literal content if @a _literalContent is true and the URLs otherwise. It is shared by
+		/// the metadata of all contracts that reference the source.
+		Json::Value const& metadata(bool _literalContent, size_t _parallelism = 1) const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -371,6 +473,10 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Parsed and analyzed form of @a yulIROptimized, taken by the first stage that compiles it further.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
+		/// Expected executions per deployment of the profiled functions in the Yul IR, by Yul name.
+		std::map<std::string, size_t> yulFunctionExecutionsPerDeployment;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -380,20 +486,76 @@ private:
 		util::LazyInit<Json::Value const> devDocumentation;
 		util::LazyInit<Json::Value const> generatedSources;
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
+		mutable std::optional<evmasm::SourceMapping const> sourceMappingEntries;
+		mutable std::optional<evmasm::SourceMapping const> runtimeSourceMappingEntries;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
 	};
 
+	/// Sources of the previous compilation kept for incremental analysis.
+	struct IncrementalAnalysisCache
+	{
+		/// The sources whose analysis can be reused.
+		std::map<std::string, Source> sources;
+		/// Settings affecting the analysis.
+		langutil::EVMVersion evmVersion;
+		std::vector<ImportRemapper::Remapping> remappings;
+		bool runYulOptimiser = false;
+	};
+
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
+	/// A source parsed ahead of its turn by @a parseConcurrently.
+	struct PreparsedSource;
+	/// Parses the sources @a _paths concurrently, each with a parser of its own, and then
+	/// reads the sources they import ahead of time. @a m_readFile is only called from the
+	/// calling thread.
+	/// Sources that are likely to be taken over from @a _cache are not parsed.
+	void parseConcurrently(
+		std::vector<std::string> const& _paths,
+		IncrementalAnalysisCache const* _cache,
+		std::map<std::string, PreparsedSource>& _parsed,
+		std::map<std::string, ReadCallback::Result>& _prefetchedReads
+	);
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
+	/// @a m_readFile, unless they are part of @a _prefetchedReads, and stores the absolute
+	/// paths of all imports in the AST annotations. The results used from @a _prefetchedReads
+	/// are removed from it, so that a file that was not found is read again by the next import.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	StringMap loadMissingSources(
+		SourceUnit const& _ast,
+		std::string const& _path,
+		std::map<std::string, ReadCallback::Result>& _prefetchedReads
+	);
+	/// @returns the path of the source imported by @a _import in the source @a _path.
+	std::string importPath(ImportDirective const& _import, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Moves the analysed sources into m_incrementalAnalysisCache.
+	void storeIncrementalAnalysisCache();
+	/// Records which sources were analysed and their errors for incremental analysis.
+	/// Removes the errors that were reported again for reused sources.
+	/// @param _stepStarts the number of errors reported before each step of the analysis.
+	void recordAnalysis(std::vector<size_t> const& _stepStarts);
+	/// Reports the errors of the reused sources that the steps of the analysis in
+	/// @a _stepStarts reported in the compilation that analysed them.
+	void reportReusedErrors(std::vector<size_t> const& _stepStarts);
+	/// Drops m_incrementalAnalysisCache together with the analysis state that is
+	/// kept across compilations for it.
+	void clearIncrementalAnalysisCache();
+	/// @returns m_incrementalAnalysisCache if it can be used with the current settings.
+	/// Otherwise clears it and returns nullptr.
+	std::unique_ptr<IncrementalAnalysisCache> takeIncrementalAnalysisCache();
+	/// Decides which of the sources taken over from @a _cache keep their analysis: those
+	/// that only import such sources, directly or indirectly. All other sources taken over
+	/// are parsed again using @a _parser, which assigns the same node IDs as before.
+	/// Reports the errors of the parser for the sources that keep their analysis.
+	/// @returns false if no source keeps its analysis.
+	bool reuseAnalysis(Parser& _parser, IncrementalAnalysisCache const& _cache);
+
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
 
@@ -404,11 +566,16 @@ private:
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
 	/// Compile a single contract.
+	/// The contract is not assembled. This has to be done via assembleContracts.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _compiledContracts the contract and all its newly compiled dependencies are
+	///                           appended in the order of compilation, each together with the
+	///                           number of errors reported when its code generation finished.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::vector<std::pair<ContractDefinition const*, size_t>>& _compiledContracts
 	);
 
 	/// Generate Yul IR for a single contract.
@@ -423,6 +590,28 @@ private:
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
 
+	/// Makes @a _stack use the optimized IR of @a _contract, preferably the object kept by generateIR.
+	static void useYulIROptimized(yul::AssemblyStack& _stack, Contract& _contract);
+
+	/// Assembles the deployment and runtime objects of the contracts compiled via the legacy
+	/// code generator, using up to m_parallelism threads.
+	/// The warnings about the contracts are inserted into the list of errors at the position
+	/// at which the code generation of the contract finished, as if each contract had been
+	/// assembled right after its code generation.
+	/// @param _contracts the compiled contracts, each one listed after all its dependencies,
+	///                   together with the number of errors reported after its code generation.
+	/// @returns the warnings reported about the contracts.
+	langutil::ErrorList assembleContracts(std::vector<std::pair<ContractDefinition const*, size_t>> const& _contracts);
+
+	/// @returns the key of @a _contract in the artifact cache.
+	util::h256 artifactCacheKey(Contract const& _contract) const;
+	/// Fills the outputs of @a _contract from the artifact cache and reports the warnings
+	/// that were issued when they were generated.
+	/// @returns false if there is no complete entry for the contract.
+	bool loadFromArtifactCache(Contract& _contract);
+	/// Adds the outputs of @a _contract to the artifact cache, together with @a _warnings.
+	void storeInArtifactCache(Contract const& _contract, langutil::ErrorList const& _warnings) const;
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -472,6 +661,23 @@ private:
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
+	unsigned m_parallelism = 1;
+	std::shared_ptr<ArtifactCache const> m_artifactCache;
+	std::unique_ptr<util::Profiler> m_profiler;
+	/// Utility functions generated for the contracts compiled by the current call to compile().
+	std::shared_ptr<MultiUseYulFunctionCache> m_yulFunctionCache;
+	/// Yul utility code processed for the contracts compiled by the current call to compile().
+	std::shared_ptr<YulUtilityCodeCache> m_yulUtilityCodeCache;
+	/// Code of library and free functions compiled for the contracts compiled by the current call to compile().
+	std::shared_ptr<FunctionCodeCache> m_functionCodeCache;
+	/// Yul sub-objects optimized for the contracts compiled by the current call to compile(),
+	/// e.g. of contracts created by several other contracts.
+	std::shared_ptr<yul::OptimizedObjectCache> m_yulObjectCache;
+	/// Parameters of external functions kept in calldata by the code generators during the current call to compile().
+	std::shared_ptr<RelocatedParameters const> m_relocatedParameters;
+	/// Descriptions of types shared by the ABIs and storage layouts of the contracts of the current compilation.
+	mutable ABI::TypeCache m_abiTypeCache;
+	mutable StorageLayout::TypeCache m_storageLayoutTypeCache;
 	bool m_viaIR = false;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
@@ -479,15 +685,20 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_generateOptimizedIR = true;
 	bool m_generateEwasm = false;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	/// The result of @a sourceIndices, determined once the compilation was successful.
+	std::map<std::string, unsigned> m_sourceIndices;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// Resolver used during analysis, kept across compilations in incremental analysis mode.
+	std::unique_ptr<NameAndTypeResolver> m_resolver;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 
@@ -496,6 +707,11 @@ private:
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	bool m_parserErrorRecovery = false;
+	bool m_incrementalAnalysis = false;
+	bool m_checkImportedSources = true;
+	std::unique_ptr<IncrementalAnalysisCache> m_incrementalAnalysisCache;
+	/// Number of types created by the last compilation that did not reuse any analysis.
+	size_t m_typeCountAfterFullAnalysis = 0;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
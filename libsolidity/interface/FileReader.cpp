@@ -22,6 +22,8 @@
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 
+#include <optional>
+
 using solidity::frontend::ReadCallback;
 using solidity::langutil::InternalCompilerError;
 using solidity::util::errinfo_comment;
@@ -34,11 +36,72 @@ namespace solidity::frontend
 void FileReader::setSource(boost::filesystem::path const& _path, SourceCode _source)
 {
 	m_sourceCodes[_path.generic_string()] = std::move(_source);
+	if (boost::filesystem::is_regular_file(_path))
+		m_sourcePaths[_path.generic_string()] = boost::filesystem::weakly_canonical(_path);
+	else
+		m_sourcePaths.erase(_path.generic_string());
 }
 
 void FileReader::setSources(StringMap _sources)
 {
 	m_sourceCodes = std::move(_sources);
+	m_sourcePaths.clear();
+}
+
+void FileReader::setCacheContents(bool _cacheContents)
+{
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	m_cacheContents = _cacheContents;
+	if (!m_cacheContents)
+		m_fileContents.clear();
+}
+
+void FileReader::invalidateContents(FileSystemPathSet const& _paths)
+{
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	for (auto const& path: _paths)
+		m_fileContents.erase(path);
+}
+
+std::pair<boost::filesystem::path, boost::filesystem::file_status> FileReader::resolvePath(boost::filesystem::path const& _path)
+{
+	namespace fs = boost::filesystem;
+
+	fs::path const fileName = _path.filename();
+	if (fileName.empty() || fileName == "." || fileName == ".." || fileName == "/")
+	{
+		fs::path canonicalPath = fs::weakly_canonical(_path);
+		return {canonicalPath, fs::status(canonicalPath)};
+	}
+
+	fs::path const directory = _path.parent_path();
+	std::optional<fs::path> canonicalDirectory;
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		if (auto it = m_canonicalDirectories.find(directory); it != m_canonicalDirectories.end())
+			canonicalDirectory = it->second;
+	}
+	if (!canonicalDirectory)
+	{
+		canonicalDirectory = fs::weakly_canonical(directory.empty() ? fs::current_path() : directory);
+		// The canonical path of a directory that does not exist yet could change when it is created.
+		if (!fs::is_directory(*canonicalDirectory))
+		{
+			fs::path canonicalPath = fs::weakly_canonical(_path);
+			return {canonicalPath, fs::status(canonicalPath)};
+		}
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		m_canonicalDirectories[directory] = *canonicalDirectory;
+	}
+
+	fs::path canonicalPath = *canonicalDirectory / fileName;
+	fs::file_status status = fs::symlink_status(canonicalPath);
+	if (fs::is_symlink(status))
+	{
+		canonicalPath = fs::weakly_canonical(canonicalPath);
+		status = fs::status(canonicalPath);
+	}
+	return {canonicalPath, status};
 }
 
 ReadCallback::Result FileReader::readFile(string const& _kind, string const& _sourceUnitName)
@@ -54,7 +117,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		if (strippedSourceUnitName.find("file://") == 0)
 			strippedSourceUnitName.erase(0, 7);
 
-		auto canonicalPath = boost::filesystem::weakly_canonical(m_basePath / strippedSourceUnitName);
+		auto const [canonicalPath, status] = resolvePath(m_basePath / strippedSourceUnitName);
 		bool isAllowed = false;
 		for (auto const& allowedDir: m_allowedDirectories)
 		{
@@ -71,16 +134,30 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		if (!isAllowed)
 			return ReadCallback::Result{false, "File outside of allowed directories."};
 
-		if (!boost::filesystem::exists(canonicalPath))
+		if (!boost::filesystem::exists(status))
 			return ReadCallback::Result{false, "File not found."};
 
-		if (!boost::filesystem::is_regular_file(canonicalPath))
+		if (!boost::filesystem::is_regular_file(status))
 			return ReadCallback::Result{false, "Not a valid file."};
 
-		// NOTE: we ignore the FileNotFound exception as we manually check above
-		auto contents = readFileAsString(canonicalPath.string());
-		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		std::optional<SourceCode> contents;
+		{
+			std::lock_guard<std::mutex> lock(m_cacheMutex);
+			if (auto cached = m_fileContents.find(canonicalPath); cached != m_fileContents.end())
+				contents = cached->second;
+		}
+		if (!contents)
+		{
+			// NOTE: we ignore the FileNotFound exception as we manually check above
+			contents = readFileAsString(canonicalPath.string());
+			std::lock_guard<std::mutex> lock(m_cacheMutex);
+			if (m_cacheContents)
+				m_fileContents[canonicalPath] = *contents;
+		}
+		std::lock_guard<std::mutex> lock(m_sourceCodesMutex);
+		m_sourceCodes[_sourceUnitName] = *contents;
+		m_sourcePaths[_sourceUnitName] = canonicalPath;
+		return ReadCallback::Result{true, std::move(*contents)};
 	}
 	catch (util::Exception const& _exception)
 	{
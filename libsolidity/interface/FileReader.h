@@ -23,6 +23,7 @@
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace solidity::frontend
@@ -58,6 +59,10 @@ public:
 
 	StringMap const& sourceCodes() const noexcept { return m_sourceCodes; }
 
+	/// @returns the canonical paths of the files on disk that the sources in @a sourceCodes()
+	/// were read from.
+	PathMap const& sourcePaths() const noexcept { return m_sourcePaths; }
+
 	/// Retrieves the source code for a given source unit ID.
 	SourceCode const& sourceCode(SourceUnitName const& _sourceUnitName) const { return m_sourceCodes.at(_sourceUnitName); }
 
@@ -66,6 +71,7 @@ public:
 	void setSources(StringMap _sources);
 
 	/// Adds the source code for a given source unit ID.
+	/// If @a _path refers to an existing file, it is recorded in @a sourcePaths().
 	/// Does not enforce @a allowedDirectories().
 	void setSource(boost::filesystem::path const& _path, SourceCode _source);
 
@@ -74,16 +80,26 @@ public:
 	/// The read will only succeed if the canonical path of the file is within one of the @a allowedDirectories().
 	/// @param _kind must be equal to "source". Other values are not supported.
 	/// @return Content of the loaded file or an error message. If the operation succeeds, a copy of
-	/// the content is retained in @a sourceCodes() under the key of @a _sourceUnitName. If the key
-	/// already exists, previous content is discarded.
+	/// the content is retained in @a sourceCodes() and its path in @a sourcePaths() under the key
+	/// of @a _sourceUnitName. If the key already exists, previous content is discarded.
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 
+	/// Keeps the contents of the files read by @a readFile, so that reading them again, e.g. in
+	/// a later compilation, does not access the file system until they are invalidated.
+	void setCacheContents(bool _cacheContents);
+	/// Removes the files at the given canonical paths from the cache of file contents.
+	void invalidateContents(FileSystemPathSet const& _paths);
+
 	frontend::ReadCallback::Callback reader()
 	{
 		return [this](std::string const& _kind, std::string const& _path) { return readFile(_kind, _path); };
 	}
 
 private:
+	/// @returns the weakly canonical form of @a _path and the status of the file it refers to.
+	/// Uses @a m_canonicalDirectories so that only the file itself has to be accessed.
+	std::pair<boost::filesystem::path, boost::filesystem::file_status> resolvePath(boost::filesystem::path const& _path);
+
 	/// Base path, used for resolving relative paths in imports.
 	boost::filesystem::path m_basePath;
 
@@ -92,6 +108,20 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+	/// map of the source unit names of the sources read from disk to their canonical paths
+	PathMap m_sourcePaths;
+	/// Makes @a readFile safe to be called concurrently.
+	std::mutex m_sourceCodesMutex;
+
+	/// Canonical paths of the existing directories that files were read from, by their path
+	/// relative to the base path. Resolving them is the expensive part of reading a file,
+	/// because every component of the path has to be accessed.
+	std::map<boost::filesystem::path, boost::filesystem::path> m_canonicalDirectories;
+	/// Contents of the files read, by canonical path, if contents are cached.
+	std::map<boost::filesystem::path, SourceCode> m_fileContents;
+	bool m_cacheContents = false;
+	/// Protects @a m_canonicalDirectories and @a m_fileContents.
+	std::mutex m_cacheMutex;
 };
 
 }
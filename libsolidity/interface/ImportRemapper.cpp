@@ -19,9 +19,9 @@
 #include <libsolutil/CommonIO.h>
 #include <liblangutil/Exceptions.h>
 
-using std::equal;
 using std::move;
 using std::optional;
+using std::pair;
 using std::string;
 using std::string;
 using std::vector;
@@ -29,52 +29,73 @@ using std::vector;
 namespace solidity::frontend
 {
 
-void ImportRemapper::setRemappings(vector<Remapping> _remappings)
+template <typename Value>
+optional<Value>& ImportRemapper::Trie<Value>::operator[](string const& _key)
 {
-	for (auto const& remapping: _remappings)
-		solAssert(!remapping.prefix.empty(), "");
-	m_remappings = move(_remappings);
+	size_t node = 0;
+	for (char c: _key)
+	{
+		auto [child, inserted] = nodes[node].children.emplace(c, nodes.size());
+		if (inserted)
+			nodes.emplace_back();
+		node = child->second;
+	}
+	return nodes[node].value;
 }
 
-SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
+template <typename Value>
+vector<pair<size_t, Value const*>> ImportRemapper::Trie<Value>::prefixesOf(string const& _string) const
 {
-	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](string const& _a, string const& _b)
+	vector<pair<size_t, Value const*>> values;
+	size_t node = 0;
+	for (size_t length = 0; ; ++length)
 	{
-		if (_a.length() > _b.length())
-			return false;
-		return equal(_a.begin(), _a.end(), _b.begin());
-	};
+		if (nodes[node].value)
+			values.emplace_back(length, &*nodes[node].value);
+		if (length == _string.size())
+			break;
+		auto child = nodes[node].children.find(_string[length]);
+		if (child == nodes[node].children.end())
+			break;
+		node = child->second;
+	}
+	return values;
+}
 
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
+void ImportRemapper::clear()
+{
+	m_remappings.clear();
+	m_remappingTrie = {};
+}
 
-	for (auto const& redir: m_remappings)
+void ImportRemapper::setRemappings(vector<Remapping> _remappings)
+{
+	m_remappingTrie = {};
+	for (auto const& remapping: _remappings)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		solAssert(!remapping.prefix.empty(), "");
+		auto& prefixTrie = m_remappingTrie[util::sanitizePath(remapping.context)];
+		if (!prefixTrie)
+			prefixTrie.emplace();
+		(*prefixTrie)[util::sanitizePath(remapping.prefix)] = util::sanitizePath(remapping.target);
 	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
-	return path;
+	m_remappings = move(_remappings);
+}
+
+SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
+{
+	// Try to find the longest context that is a prefix of _context and has a prefix of _path,
+	// and the longest prefix match in it.
+	auto contexts = m_remappingTrie.prefixesOf(_context);
+	for (auto context = contexts.rbegin(); context != contexts.rend(); ++context)
+		if (auto prefixes = context->second->prefixesOf(_path); !prefixes.empty())
+		{
+			auto const& [prefixLength, target] = prefixes.back();
+			string path = *target;
+			path.append(_path.begin() + static_cast<string::difference_type>(prefixLength), _path.end());
+			return path;
+		}
+	return _path;
 }
 
 optional<ImportRemapper::Remapping> ImportRemapper::parseRemapping(string const& _remapping)
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -38,22 +39,51 @@ public:
 		std::string context;
 		std::string prefix;
 		std::string target;
+
+		bool operator==(Remapping const& _other) const
+		{
+			return context == _other.context && prefix == _other.prefix && target == _other.target;
+		}
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear();
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
 
+	/// Applies the remapping with the longest context that is a prefix of @a _context and, among
+	/// those, with the longest prefix of @a _path. If there are several, the last one is used.
+	/// Takes time proportional to the lengths of @a _path and @a _context, not to the number
+	/// of remappings.
 	SourceUnitName apply(ImportPath const& _path, std::string const& _context) const;
 
 	// Parses a remapping of the format "context:prefix=target".
 	static std::optional<Remapping> parseRemapping(std::string const& _remapping);
 
 private:
+	/// Trie over strings, whose nodes are stored in a vector with the root at index zero.
+	template <typename Value>
+	struct Trie
+	{
+		struct Node
+		{
+			std::map<char, size_t> children;
+			std::optional<Value> value;
+		};
+		std::vector<Node> nodes = std::vector<Node>(1);
+
+		/// @returns the value of the node of @a _key, which is created if it does not exist.
+		std::optional<Value>& operator[](std::string const& _key);
+		/// @returns the lengths and values of the keys that are prefixes of @a _string, shortest first.
+		std::vector<std::pair<size_t, Value const*>> prefixesOf(std::string const& _string) const;
+	};
+
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+	/// Sanitized contexts of the remappings, each with a trie over the sanitized prefixes
+	/// of its remappings, which maps to the sanitized target of the last one.
+	Trie<Trie<std::string>> m_remappingTrie;
 };
 
 }
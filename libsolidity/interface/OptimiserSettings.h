@@ -26,6 +26,8 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <map>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -41,6 +43,11 @@ enum class OptimisationPreset
 
 struct OptimiserSettings
 {
+	/// Expected number of executions per deployment of individual functions, indexed by the name
+	/// of the source unit, the name of the contract (empty for free functions) and the name of the
+	/// function.
+	using ExecutionProfile = std::map<std::string, std::map<std::string, std::map<std::string, size_t>>>;
+
 	static char constexpr DefaultYulOptimiserSteps[] =
 		"dhfoDgvulfnTUtnIf"            // None of these can make stack problems worse
 		"["
@@ -115,11 +122,36 @@ struct OptimiserSettings
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
+			runExtendedCSE == _other.runExtendedCSE &&
+			runColdCodeMover == _other.runColdCodeMover &&
+			runCalldataParameters == _other.runCalldataParameters &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			optimizeStackLayout == _other.optimizeStackLayout &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			executionProfile == _other.executionProfile;
+	}
+
+	/// @returns the expected number of executions per deployment of the given function
+	/// according to the execution profile or nullopt if it is not part of the profile.
+	std::optional<size_t> profiledExecutions(
+		std::string const& _sourceUnit,
+		std::string const& _contract,
+		std::string const& _function
+	) const
+	{
+		auto source = executionProfile.find(_sourceUnit);
+		if (source == executionProfile.end())
+			return std::nullopt;
+		auto contract = source->second.find(_contract);
+		if (contract == source->second.end())
+			return std::nullopt;
+		auto function = contract->second.find(_function);
+		if (function == contract->second.end())
+			return std::nullopt;
+		return function->second;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -135,11 +167,25 @@ struct OptimiserSettings
 	bool runDeduplicate = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
+	/// Let the common subexpression eliminator keep its knowledge across conditional jumps
+	/// into code that cannot be jumped to. Has no effect unless runCSE is set.
+	bool runExtendedCSE = false;
+	/// Move code that always reverts behind conditional jumps to the end of the assembly, so that
+	/// the code that does not revert is reached by falling through. Also applies to the assembly
+	/// generated via the IR.
+	bool runColdCodeMover = false;
+	/// Keep read-only ``bytes``, ``string`` and arrays of full-word elements that are memory
+	/// parameters of external functions in calldata instead of copying them to memory during
+	/// code generation.
+	bool runCalldataParameters = false;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
+	/// Generate bytecode from Yul using the code transform that plans the stack layout of each
+	/// basic block ahead of time. Falls back to the default code transform if a slot is out of reach.
+	bool optimizeStackLayout = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
@@ -150,6 +196,10 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Expected number of executions per deployment of individual functions, e.g. measured by
+	/// a profiler, which replaces @a expectedExecutionsPerDeployment for their code in the
+	/// Yul optimizer and determines the order of the selectors in the dispatcher.
+	ExecutionProfile executionProfile;
 };
 
 }
@@ -43,7 +43,10 @@ public:
 	enum class Kind
 	{
 		ReadFile,
-		SMTQuery
+		SMTQuery,
+		/// A JSON array of SMT-LIB2 queries, answered by a JSON array of the
+		/// responses of the solver in the same order.
+		SMTQueryBatch
 	};
 
 	static std::string kindString(Kind _kind)
@@ -54,6 +57,8 @@ public:
 			return "source";
 		case Kind::SMTQuery:
 			return "smt-query";
+		case Kind::SMTQueryBatch:
+			return "smt-query-batch";
 		default:
 			solAssert(false, "");
 		}
@@ -22,6 +22,7 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
@@ -288,6 +289,19 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the assembly text was requested for any contract.
+bool isAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			if (isArtifactRequested(requests, "evm.assembly", false))
+				return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -323,6 +337,48 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the optimized Yul IR was requested, either directly or because Ewasm
+/// code was requested.
+bool isOptimizedIRRequested(Json::Value const& _outputSelection)
+{
+	if (isEwasmRequested(_outputSelection))
+		return true;
+
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "irOptimized")
+					return true;
+
+	return false;
+}
+
+/// @returns true if all requested outputs can be taken from the artifact cache, i.e. none of
+/// them needs the assembly of a contract.
+bool canUseArtifactCache(Json::Value const& _outputSelection)
+{
+	if (isEwasmRequested(_outputSelection))
+		return false;
+
+	if (!_outputSelection.isObject())
+		return true;
+
+	static vector<string> const outputsThatRequireAssembly{
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly",
+		"evm.bytecode.generatedSources", "evm.deployedBytecode.generatedSources"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return false;
+	return true;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -373,10 +429,73 @@ Json::Value formatImmutableReferences(map<u256, pair<string, vector<size_t>>> co
 	return ret;
 }
 
+/// @returns the measurements of @a _profiler by scope, with the times in milliseconds.
+Json::Value formatProfile(util::Profiler const& _profiler)
+{
+	Json::Value ret(Json::objectValue);
+	for (auto const& [scope, phases]: _profiler.measurements())
+	{
+		Json::Value scopeOutput(Json::arrayValue);
+		for (auto const& [name, measurement]: phases)
+		{
+			Json::Value phase(Json::objectValue);
+			phase["name"] = name;
+			phase["count"] = Json::UInt64(measurement.count);
+			phase["wallTime"] = measurement.wallTimeSeconds * 1000;
+			phase["cpuTime"] = measurement.cpuTimeSeconds * 1000;
+			phase["peakMemoryIncrease"] = Json::UInt64(measurement.peakMemoryIncrease);
+			scopeOutput.append(move(phase));
+		}
+		ret[scope] = move(scopeOutput);
+	}
+	return ret;
+}
+
+/// @returns the effect of the Yul optimizer steps recorded by @a _profiler by scope,
+/// with the times in milliseconds.
+Json::Value formatYulOptimizerSteps(util::Profiler const& _profiler)
+{
+	Json::Value ret(Json::objectValue);
+	for (auto const& [scope, transformations]: _profiler.transformations())
+	{
+		Json::Value scopeOutput(Json::arrayValue);
+		for (auto const& transformation: transformations)
+		{
+			Json::Value step(Json::objectValue);
+			step["object"] = transformation.object;
+			step["name"] = transformation.name;
+			step["codeSizeBefore"] = Json::UInt64(transformation.codeSizeBefore);
+			step["codeSizeAfter"] = Json::UInt64(transformation.codeSizeAfter);
+			step["codeCostBefore"] = Json::UInt64(transformation.codeCostBefore);
+			step["codeCostAfter"] = Json::UInt64(transformation.codeCostAfter);
+			step["wallTime"] = transformation.wallTimeSeconds * 1000;
+			scopeOutput.append(move(step));
+		}
+		ret[scope] = move(scopeOutput);
+	}
+	return ret;
+}
+
+/// @returns the counters recorded by @a _profiler by scope.
+Json::Value formatPerformanceCounters(util::Profiler const& _profiler)
+{
+	Json::Value ret(Json::objectValue);
+	for (auto const& [scope, counters]: _profiler.counters())
+	{
+		Json::Value scopeOutput(Json::objectValue);
+		for (auto const& [name, value]: counters)
+			scopeOutput[name] = Json::UInt64(value);
+		ret[scope] = move(scopeOutput);
+	}
+	return ret;
+}
+
+/// Collects the requested components of @a _object. The source map and the generated sources
+/// are only retrieved if they are requested, since they are expensive to compute.
 Json::Value collectEVMObject(
 	evmasm::LinkerObject const& _object,
-	string const* _sourceMap,
-	Json::Value _generatedSources,
+	function<string const*()> const& _sourceMap,
+	function<Json::Value()> const& _generatedSources,
 	bool _runtimeObject,
 	function<bool(string)> const& _artifactRequested
 )
@@ -387,7 +506,10 @@ Json::Value collectEVMObject(
 	if (_artifactRequested("opcodes"))
 		output["opcodes"] = evmasm::disassemble(_object.bytecode);
 	if (_artifactRequested("sourceMap"))
-		output["sourceMap"] = _sourceMap ? *_sourceMap : "";
+	{
+		string const* sourceMap = _sourceMap();
+		output["sourceMap"] = sourceMap ? *sourceMap : "";
+	}
 	if (_artifactRequested("functionDebugData"))
 		output["functionDebugData"] = StandardCompiler::formatFunctionDebugData(_object.functionDebugData);
 	if (_artifactRequested("linkReferences"))
@@ -395,10 +517,135 @@ Json::Value collectEVMObject(
 	if (_runtimeObject && _artifactRequested("immutableReferences"))
 		output["immutableReferences"] = formatImmutableReferences(_object.immutableReferences);
 	if (_artifactRequested("generatedSources"))
-		output["generatedSources"] = move(_generatedSources);
+		output["generatedSources"] = _generatedSources();
 	return output;
 }
 
+/// Writes a JSON object to a stream member by member. The object is closed on destruction.
+/// To get the same result as serialising the complete object with jsonCompactPrint, the members
+/// have to be written in the order in which jsoncpp sorts them.
+class JsonObjectWriter
+{
+public:
+	explicit JsonObjectWriter(ostream& _stream): m_stream(_stream) { m_stream << '{'; }
+	~JsonObjectWriter() { m_stream << '}'; }
+
+	JsonObjectWriter(JsonObjectWriter const&) = delete;
+	JsonObjectWriter& operator=(JsonObjectWriter const&) = delete;
+
+	/// Writes the key of the next member. Its value has to be written directly afterwards.
+	void key(string const& _key)
+	{
+		if (!m_empty)
+			m_stream << ',';
+		m_empty = false;
+		util::jsonCompactPrint(Json::Value(_key), m_stream);
+		m_stream << ':';
+	}
+
+	void write(string const& _key, Json::Value const& _value)
+	{
+		key(_key);
+		util::jsonCompactPrint(_value, m_stream);
+	}
+
+private:
+	ostream& m_stream;
+	bool m_empty = true;
+};
+
+Json::Value formatOutputException()
+{
+	return formatError(
+		false,
+		"InternalCompilerError",
+		"general",
+		"Internal exception while generating the output: " + boost::current_exception_diagnostic_information()
+	);
+}
+
+/// Writes the output of a Solidity compilation to @a _stream, generating the output of each
+/// source and contract only right before it is written. Apart from failures while generating
+/// these outputs, the result is the same as serialising the complete output.
+/// @param _output the output apart from the sources and contracts.
+void writeOutput(
+	ostream& _stream,
+	Json::Value _output,
+	vector<string> const& _sourceNames,
+	function<Json::Value(string const&, unsigned)> const& _sourceOutput,
+	map<string, vector<string>> const& _contractNames,
+	function<Json::Value(string const&, string const&)> const& _contractOutput
+)
+{
+	solAssert(!_output.isMember("contracts") && !_output.isMember("sources"), "");
+
+	// The members are written in the order "auxiliaryInputRequested", "contracts", "errors", "performanceCounters",
+	// "profile", "sources", "trace", "yulOptimizerSteps".
+	JsonObjectWriter output(_stream);
+	if (_output.isMember("auxiliaryInputRequested"))
+		output.write("auxiliaryInputRequested", _output["auxiliaryInputRequested"]);
+
+	Json::Value errors = _output.isMember("errors") ? move(_output["errors"]) : Json::Value{Json::arrayValue};
+	try
+	{
+		optional<JsonObjectWriter> contracts;
+		for (auto const& [file, names]: _contractNames)
+		{
+			optional<JsonObjectWriter> fileOutput;
+			for (string const& name: names)
+			{
+				Json::Value contractData = _contractOutput(file, name);
+				if (contractData.empty())
+					continue;
+				if (!contracts)
+				{
+					output.key("contracts");
+					contracts.emplace(_stream);
+				}
+				if (!fileOutput)
+				{
+					contracts->key(file);
+					fileOutput.emplace(_stream);
+				}
+				fileOutput->write(name, contractData);
+			}
+		}
+	}
+	catch (...)
+	{
+		errors.append(formatOutputException());
+	}
+
+	if (!errors.empty())
+		output.write("errors", errors);
+	if (_output.isMember("performanceCounters"))
+		output.write("performanceCounters", _output["performanceCounters"]);
+	if (_output.isMember("profile"))
+		output.write("profile", _output["profile"]);
+
+	try
+	{
+		output.key("sources");
+		JsonObjectWriter sources(_stream);
+		unsigned sourceIndex = 0;
+		for (string const& sourceName: _sourceNames)
+			sources.write(sourceName, _sourceOutput(sourceName, sourceIndex++));
+	}
+	catch (...)
+	{
+		// The errors have already been written. Report the failure in another "errors" member,
+		// which strict parsers reject, so that it cannot go unnoticed.
+		Json::Value error{Json::arrayValue};
+		error.append(formatOutputException());
+		output.write("errors", error);
+	}
+
+	if (_output.isMember("trace"))
+		output.write("trace", _output["trace"]);
+	if (_output.isMember("yulOptimizerSteps"))
+		output.write("yulOptimizerSteps", _output["yulOptimizerSteps"]);
+}
+
 std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -431,25 +678,25 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"cache", "checkImportedSources", "parserErrorRecovery", "debug", "evmVersion", "gasEstimation", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "engine", "targets", "timeout"};
+	static set<string> keys{"budget", "contracts", "counterexamples", "engine", "incremental", "jobs", "raceSolvers", "sliceState", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "executionProfile", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "cseExtendedBlocks", "coldCodeMover", "calldataParameters", "constantOptimizer", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -491,6 +738,41 @@ std::optional<Json::Value> checkOptimizerDetailSteps(Json::Value const& _details
 	return {};
 }
 
+std::optional<Json::Value> checkOptimizerExecutionProfile(
+	Json::Value const& _profile,
+	OptimiserSettings::ExecutionProfile& _setting
+)
+{
+	string const prefix = "settings.optimizer.executionProfile";
+	if (!_profile.isObject())
+		return formatFatalError("JSONError", "\"" + prefix + "\" must be an object");
+	for (auto const& sourceName: _profile.getMemberNames())
+	{
+		Json::Value const& sourceVal = _profile[sourceName];
+		if (!sourceVal.isObject())
+			return formatFatalError("JSONError", "\"" + prefix + "." + sourceName + "\" must be an object");
+		for (auto const& contractName: sourceVal.getMemberNames())
+		{
+			Json::Value const& contractVal = sourceVal[contractName];
+			if (!contractVal.isObject())
+				return formatFatalError(
+					"JSONError",
+					"\"" + prefix + "." + sourceName + "." + contractName + "\" must be an object"
+				);
+			for (auto const& functionName: contractVal.getMemberNames())
+			{
+				if (!contractVal[functionName].isUInt())
+					return formatFatalError(
+						"JSONError",
+						"\"" + prefix + "." + sourceName + "." + contractName + "." + functionName + "\" must be an unsigned number"
+					);
+				_setting[sourceName][contractName][functionName] = contractVal[functionName].asUInt();
+			}
+		}
+	}
+	return {};
+}
+
 std::optional<Json::Value> checkMetadataKeys(Json::Value const& _input)
 {
 	if (_input.isObject())
@@ -575,6 +857,10 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("executionProfile"))
+		if (auto error = checkOptimizerExecutionProfile(_jsonInput["executionProfile"], settings.executionProfile))
+			return *error;
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -593,6 +879,12 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "cseExtendedBlocks", settings.runExtendedCSE))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "coldCodeMover", settings.runColdCodeMover))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "calldataParameters", settings.runCalldataParameters))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
@@ -603,10 +895,12 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "stackLayout"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackLayout", settings.optimizeStackLayout))
+				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
 		}
@@ -614,10 +908,283 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+/// Cuts the strings of the "content" members of the sources out of a Standard JSON input, so that
+/// they can be decoded straight into the strings passed to the compiler instead of going through
+/// a Json::Value. Only checks as much of the syntax as is needed to find them, the remaining input
+/// is still parsed by jsoncpp, which also reports all errors.
+class SourceContentCutter
+{
+public:
+	explicit SourceContentCutter(string const& _input): m_input(_input) {}
+
+	/// @returns the input with the contents replaced by empty strings and the decoded contents
+	/// by source name, or nullopt if the contents cannot be found like this.
+	optional<pair<string, map<string, string>>> cut()
+	{
+		if (
+			!skipWhitespace() ||
+			!object(1, [&](string const& _key) {
+				if (_key != "sources" || peek() != '{')
+					return value(2);
+				return object(2, [&](string const& _sourceName) {
+					if (peek() != '{')
+						return value(3);
+					return object(3, [&](string const& _member) {
+						if (_member != "content" || peek() != '"')
+							return value(4);
+						return cutContent(_sourceName);
+					});
+				});
+			})
+		)
+			return nullopt;
+		m_output.append(m_input, m_copiedUntil, string::npos);
+		return {{move(m_output), move(m_contents)}};
+	}
+
+private:
+	/// Same limit as the one of jsoncpp in strict mode.
+	static size_t constexpr c_maxDepth = 1000;
+
+	char peek() const { return m_position < m_input.size() ? m_input[m_position] : '\0'; }
+
+	bool skipWhitespace()
+	{
+		m_position = m_input.find_first_not_of(" \t\n\r", m_position);
+		if (m_position == string::npos)
+			m_position = m_input.size();
+		return m_position < m_input.size();
+	}
+
+	template <typename MemberHandler>
+	bool object(size_t _depth, MemberHandler const& _member)
+	{
+		if (_depth > c_maxDepth || peek() != '{')
+			return false;
+		++m_position;
+		if (!skipWhitespace())
+			return false;
+		if (peek() == '}')
+		{
+			++m_position;
+			return true;
+		}
+		while (true)
+		{
+			optional<string> key = decodeString();
+			if (!key || !skipWhitespace() || peek() != ':')
+				return false;
+			++m_position;
+			if (!skipWhitespace() || !_member(*key) || !skipWhitespace())
+				return false;
+			char const next = m_input[m_position++];
+			if (next == '}')
+				return true;
+			if (next != ',' || !skipWhitespace())
+				return false;
+		}
+	}
+
+	bool value(size_t _depth)
+	{
+		if (_depth > c_maxDepth)
+			return false;
+		switch (peek())
+		{
+		case '{':
+			return object(_depth, [&](string const&) { return value(_depth + 1); });
+		case '[':
+			++m_position;
+			if (!skipWhitespace())
+				return false;
+			if (peek() == ']')
+			{
+				++m_position;
+				return true;
+			}
+			while (true)
+			{
+				if (!value(_depth + 1) || !skipWhitespace())
+					return false;
+				char const next = m_input[m_position++];
+				if (next == ']')
+					return true;
+				if (next != ',' || !skipWhitespace())
+					return false;
+			}
+		case '"':
+			return skipString();
+		default:
+		{
+			// Numbers and literals are checked by jsoncpp.
+			size_t end = m_input.find_first_of(",]} \t\n\r", m_position);
+			if (end == string::npos)
+				end = m_input.size();
+			if (end == m_position)
+				return false;
+			m_position = end;
+			return true;
+		}
+		}
+	}
+
+	bool skipString()
+	{
+		if (peek() != '"')
+			return false;
+		for (++m_position; m_position < m_input.size(); ++m_position)
+			if (m_input[m_position] == '\\')
+				++m_position;
+			else if (m_input[m_position] == '"')
+			{
+				++m_position;
+				return true;
+			}
+		return false;
+	}
+
+	optional<unsigned> hexQuad()
+	{
+		if (m_input.size() - m_position < 4)
+			return nullopt;
+		unsigned result = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			char const c = m_input[m_position++];
+			result <<= 4;
+			if ('0' <= c && c <= '9')
+				result |= unsigned(c - '0');
+			else if ('a' <= c && c <= 'f')
+				result |= unsigned(c - 'a' + 10);
+			else if ('A' <= c && c <= 'F')
+				result |= unsigned(c - 'A' + 10);
+			else
+				return nullopt;
+		}
+		return result;
+	}
+
+	/// Decodes the string at the current position in the same way as jsoncpp.
+	optional<string> decodeString()
+	{
+		size_t const start = m_position;
+		if (!skipString())
+			return nullopt;
+		size_t const end = m_position - 1;
+		string result;
+		result.reserve(end - start - 1);
+		for (m_position = start + 1; m_position < end;)
+		{
+			size_t escape = m_input.find('\\', m_position);
+			if (escape == string::npos || escape > end)
+				escape = end;
+			result.append(m_input, m_position, escape - m_position);
+			m_position = escape;
+			if (m_position == end)
+				break;
+			++m_position;
+			char const escaped = m_input[m_position++];
+			switch (escaped)
+			{
+			case '"': result += '"'; break;
+			case '/': result += '/'; break;
+			case '\\': result += '\\'; break;
+			case 'b': result += '\b'; break;
+			case 'f': result += '\f'; break;
+			case 'n': result += '\n'; break;
+			case 'r': result += '\r'; break;
+			case 't': result += '\t'; break;
+			case 'u':
+			{
+				optional<unsigned> codePoint = hexQuad();
+				if (!codePoint)
+					return nullopt;
+				if (0xD800 <= *codePoint && *codePoint <= 0xDBFF)
+				{
+					if (m_input.compare(m_position, 2, "\\u") != 0)
+						return nullopt;
+					m_position += 2;
+					optional<unsigned> lowSurrogate = hexQuad();
+					if (!lowSurrogate || *lowSurrogate < 0xDC00 || *lowSurrogate > 0xDFFF)
+						return nullopt;
+					*codePoint = 0x10000 + ((*codePoint & 0x3FF) << 10) + (*lowSurrogate & 0x3FF);
+				}
+				appendUTF8(result, *codePoint);
+				break;
+			}
+			default:
+				return nullopt;
+			}
+		}
+		m_position = end + 1;
+		return result;
+	}
+
+	static void appendUTF8(string& _output, unsigned _codePoint)
+	{
+		if (_codePoint <= 0x7F)
+			_output += static_cast<char>(_codePoint);
+		else if (_codePoint <= 0x7FF)
+		{
+			_output += static_cast<char>(0xC0 | (_codePoint >> 6));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3F));
+		}
+		else if (_codePoint <= 0xFFFF)
+		{
+			_output += static_cast<char>(0xE0 | (_codePoint >> 12));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 6) & 0x3F));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3F));
+		}
+		else
+		{
+			_output += static_cast<char>(0xF0 | (_codePoint >> 18));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 12) & 0x3F));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 6) & 0x3F));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3F));
+		}
+	}
+
+	bool cutContent(string const& _sourceName)
+	{
+		size_t const start = m_position;
+		optional<string> content = decodeString();
+		if (!content || !m_contents.emplace(_sourceName, move(*content)).second)
+			return false;
+		m_output.append(m_input, m_copiedUntil, start - m_copiedUntil);
+		m_output += "\"\"";
+		m_copiedUntil = m_position;
+		return true;
+	}
+
+	string const& m_input;
+	size_t m_position = 0;
+	/// Part of the input that is cut and the position up to which it is copied to m_output.
+	string m_output;
+	size_t m_copiedUntil = 0;
+	map<string, string> m_contents;
+};
+
+/// Parses the Standard JSON input @a _input like util::jsonParseStrict, but decodes the
+/// contents of the sources into @a _sourceContents instead of @a _json, where they are empty.
+bool parseInputJson(string const& _input, Json::Value& _json, map<string, string>& _sourceContents, string* _errors)
+{
+	if (auto cut = SourceContentCutter(_input).cut())
+		if (util::jsonParseStrict(cut->first, _json))
+		{
+			_sourceContents = move(cut->second);
+			return true;
+		}
+	// The errors refer to the original input.
+	return util::jsonParseStrict(_input, _json, _errors);
+}
+
 }
 
 
-std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(
+	Json::Value const& _input,
+	map<string, string>& _sourceContents
+)
 {
 	InputsAndSettings ret;
 
@@ -651,7 +1218,11 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 		if (sources[sourceName]["content"].isString())
 		{
-			string content = sources[sourceName]["content"].asString();
+			auto decodedContent = _sourceContents.find(sourceName);
+			string content =
+				decodedContent != _sourceContents.end() ?
+				move(decodedContent->second) :
+				sources[sourceName]["content"].asString();
 			if (!hash.empty() && !hashMatchesContent(hash, content))
 				ret.errors.append(formatError(
 					false,
@@ -660,7 +1231,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -686,7 +1257,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -776,6 +1347,35 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("checkImportedSources"))
+	{
+		if (!settings["checkImportedSources"].isBool())
+			return formatFatalError("JSONError", "\"settings.checkImportedSources\" must be a Boolean.");
+		ret.checkImportedSources = settings["checkImportedSources"].asBool();
+	}
+
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("gasEstimation"))
+	{
+		Json::Value const& gasEstimation = settings["gasEstimation"];
+		if (!gasEstimation.isString() || (gasEstimation.asString() != "perFunction" && gasEstimation.asString() != "upperBound"))
+			return formatFatalError("JSONError", "\"settings.gasEstimation\" must be \"perFunction\" or \"upperBound\".");
+		ret.gasEstimationUpperBoundOnly = gasEstimation.asString() == "upperBound";
+	}
+
+	if (settings.isMember("cache"))
+	{
+		if (!settings["cache"].isString() || settings["cache"].asString().empty())
+			return formatFatalError("JSONError", "\"settings.cache\" must be a non-empty string.");
+		ret.cacheDirectory = settings["cache"].asString();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -788,7 +1388,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	if (settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"profile", "revertStrings", "trace"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].isMember("revertStrings"))
@@ -805,6 +1405,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				);
 			ret.revertStrings = *revertStrings;
 		}
+
+		if (settings["debug"].isMember("profile"))
+		{
+			if (!settings["debug"]["profile"].isBool())
+				return formatFatalError("JSONError", "\"settings.debug.profile\" must be a Boolean.");
+			ret.profile = settings["debug"]["profile"].asBool();
+		}
+
+		if (settings["debug"].isMember("trace"))
+		{
+			if (!settings["debug"]["trace"].isBool())
+				return formatFatalError("JSONError", "\"settings.debug.trace\" must be a Boolean.");
+			ret.trace = settings["debug"]["trace"].asBool();
+		}
 	}
 
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
@@ -973,19 +1587,84 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("budget"))
+	{
+		if (!modelCheckerSettings["budget"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.budget must be an unsigned integer.");
+		ret.modelCheckerSettings.budget = modelCheckerSettings["budget"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("jobs"))
+	{
+		if (!modelCheckerSettings["jobs"].isUInt() || modelCheckerSettings["jobs"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.jobs must be a positive integer.");
+		ret.modelCheckerSettings.jobs = modelCheckerSettings["jobs"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("incremental"))
+	{
+		if (!modelCheckerSettings["incremental"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.incremental must be a Boolean.");
+		ret.modelCheckerSettings.incremental = modelCheckerSettings["incremental"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		if (!modelCheckerSettings["raceSolvers"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean.");
+		ret.modelCheckerSettings.raceSolvers = modelCheckerSettings["raceSolvers"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("sliceState"))
+	{
+		if (!modelCheckerSettings["sliceState"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.sliceState must be a Boolean.");
+		ret.modelCheckerSettings.sliceState = modelCheckerSettings["sliceState"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("counterexamples"))
+	{
+		if (!modelCheckerSettings["counterexamples"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.counterexamples must be a Boolean.");
+		ret.modelCheckerSettings.counterexamples = modelCheckerSettings["counterexamples"].asBool();
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::setIncrementalAnalysis(bool _enable)
 {
-	CompilerStack compilerStack(m_readFile);
+	m_incrementalAnalysis = _enable;
+	if (!_enable)
+		m_compilerStack.reset();
+}
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, ostream* _outputStream)
+{
+	unique_ptr<CompilerStack> temporaryCompilerStack;
+	if (!m_incrementalAnalysis)
+		temporaryCompilerStack = make_unique<CompilerStack>(m_readFile);
+	else if (m_compilerStack)
+		m_compilerStack->reset();
+	else
+		m_compilerStack = make_unique<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = m_incrementalAnalysis ? *m_compilerStack : *temporaryCompilerStack;
+
+	compilerStack.setIncrementalAnalysis(m_incrementalAnalysis);
+	// The sources are only needed again to annotate the assembly text,
+	// so avoid the copy if it is not requested.
+	StringMap sourceList;
+	if (isAssemblyRequested(_inputsAndSettings.outputSelection))
+		sourceList = _inputsAndSettings.sources;
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setCheckImportedSources(_inputsAndSettings.checkImportedSources);
+	if (_inputsAndSettings.cacheDirectory && canUseArtifactCache(_inputsAndSettings.outputSelection))
+		compilerStack.setArtifactCache(make_shared<ArtifactCache>(*_inputsAndSettings.cacheDirectory));
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -995,9 +1674,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+	compilerStack.enableProfiling(_inputsAndSettings.profile || _inputsAndSettings.trace, _inputsAndSettings.trace);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableIRGeneration(
+		isIRRequested(_inputsAndSettings.outputSelection),
+		isOptimizedIRRequested(_inputsAndSettings.outputSelection)
+	);
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
@@ -1146,80 +1829,94 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
-	bool const wildcardMatchesExperimental = false;
+	if (_inputsAndSettings.profile)
+	{
+		output["profile"] = formatProfile(*compilerStack.profiler());
+		output["performanceCounters"] = formatPerformanceCounters(*compilerStack.profiler());
+		output["yulOptimizerSteps"] = formatYulOptimizerSteps(*compilerStack.profiler());
+	}
+	if (_inputsAndSettings.trace)
+		output["trace"] = formatTrace(*compilerStack.profiler());
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
-		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
+	bool const wildcardMatchesExperimental = false;
 
-	Json::Value contractsOutput = Json::objectValue;
+	vector<string> const sourceNames =
+		compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery) ?
+		compilerStack.sourceNames() :
+		vector<string>{};
+	auto sourceOutput = [&](string const& _sourceName, unsigned _sourceIndex)
+	{
+		Json::Value sourceResult = Json::objectValue;
+		sourceResult["id"] = _sourceIndex;
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _sourceName, "", "ast", wildcardMatchesExperimental))
+			sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(_sourceName));
+		return sourceResult;
+	};
+
+	// Contract names by file, in the order of the members of JSON objects.
+	map<string, vector<string>> contractNames;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contractNames[contractName.substr(0, colon)].push_back(contractName.substr(colon + 1));
+	}
+	auto contractOutput = [&](string const& _file, string const& _name)
+	{
+		string const contractName = _file + ":" + _name;
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "abi", wildcardMatchesExperimental))
 			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "storageLayout", false))
 			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "metadata", wildcardMatchesExperimental))
 			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "userdoc", wildcardMatchesExperimental))
 			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "devdoc", wildcardMatchesExperimental))
 			contractData["devdoc"] = compilerStack.natspecDev(contractName);
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ir", wildcardMatchesExperimental))
 			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "irOptimized", wildcardMatchesExperimental))
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
 
 		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ewasm.wast", wildcardMatchesExperimental))
 			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ewasm.wasm", wildcardMatchesExperimental))
 			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.assembly", wildcardMatchesExperimental))
 			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.legacyAssembly", wildcardMatchesExperimental))
 			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.methodIdentifiers", wildcardMatchesExperimental))
 			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName, _inputsAndSettings.gasEstimationUpperBoundOnly);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
-			file,
-			name,
+			_file,
+			_name,
 			evmObjectComponents("bytecode"),
 			wildcardMatchesExperimental
 		))
 			evmData["bytecode"] = collectEVMObject(
 				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
+				[&]() { return compilerStack.sourceMapping(contractName); },
+				[&]() { return compilerStack.generatedSources(contractName); },
 				false,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
-					file,
-					name,
+					_file,
+					_name,
 					"evm.bytecode." + _element,
 					wildcardMatchesExperimental
 				); }
@@ -1227,20 +1924,20 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
-			file,
-			name,
+			_file,
+			_name,
 			evmObjectComponents("deployedBytecode"),
 			wildcardMatchesExperimental
 		))
 			evmData["deployedBytecode"] = collectEVMObject(
 				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
+				[&]() { return compilerStack.runtimeSourceMapping(contractName); },
+				[&]() { return compilerStack.generatedSources(contractName, true); },
 				true,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
-					file,
-					name,
+					_file,
+					_name,
 					"evm.deployedBytecode." + _element,
 					wildcardMatchesExperimental
 				); }
@@ -1248,14 +1945,32 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
+		return contractData;
+	};
+
+	if (_outputStream)
+	{
+		writeOutput(*_outputStream, move(output), sourceNames, sourceOutput, contractNames, contractOutput);
+		return Json::nullValue;
+	}
+
+	output["sources"] = Json::objectValue;
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: sourceNames)
+		output["sources"][sourceName] = sourceOutput(sourceName, sourceIndex++);
 
-		if (!contractData.empty())
+	Json::Value contractsOutput = Json::objectValue;
+	for (auto const& [file, names]: contractNames)
+		for (string const& name: names)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			Json::Value contractData = contractOutput(file, name);
+			if (!contractData.empty())
+			{
+				if (!contractsOutput.isMember(file))
+					contractsOutput[file] = Json::objectValue;
+				contractsOutput[file][name] = move(contractData);
+			}
 		}
-	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
@@ -1273,6 +1988,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return formatFatalError("JSONError", "Field \"settings.remappings\" cannot be used for Yul.");
 	if (_inputsAndSettings.revertStrings != RevertStrings::Default)
 		return formatFatalError("JSONError", "Field \"settings.debug.revertStrings\" cannot be used for Yul.");
+	if (_inputsAndSettings.profile)
+		return formatFatalError("JSONError", "Field \"settings.debug.profile\" cannot be used for Yul.");
+	if (_inputsAndSettings.trace)
+		return formatFatalError("JSONError", "Field \"settings.debug.trace\" cannot be used for Yul.");
 
 	Json::Value output = Json::objectValue;
 
@@ -1281,6 +2000,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		AssemblyStack::Language::StrictAssembly,
 		_inputsAndSettings.optimiserSettings
 	);
+	stack.setParallelism(_inputsAndSettings.parallelism);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
 
@@ -1321,7 +2041,13 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject runtimeObject;
-	tie(object, runtimeObject) = stack.assembleWithDeployed();
+	tie(object, runtimeObject) = stack.assembleWithDeployed({}, isArtifactRequested(
+		_inputsAndSettings.outputSelection,
+		sourceName,
+		contractName,
+		{"evm.assembly", "evm.bytecode.sourceMap", "evm.deployedBytecode.sourceMap"},
+		wildcardMatchesExperimental
+	));
 
 	if (object.bytecode)
 		object.bytecode->link(_inputsAndSettings.libraries);
@@ -1342,8 +2068,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 				output["contracts"][sourceName][contractName]["evm"][objectKind] =
 					collectEVMObject(
 						*o.bytecode,
-						o.sourceMappings.get(),
-						Json::arrayValue,
+						[&]() { return o.sourceMappings.get(); },
+						[]() { return Json::Value(Json::arrayValue); },
 						false,
 						[&](string const& _element) { return isArtifactRequested(
 							_inputsAndSettings.outputSelection,
@@ -1366,16 +2092,30 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	return compileInternal(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compileInternal(
+	Json::Value const& _input,
+	ostream* _outputStream,
+	map<string, string> _sourceContents
+) noexcept
+{
+	if (YulStringRepository::instance().size() > m_yulStringRepositoryLimit)
+	{
+		// The kept ASTs contain Yul identifiers.
+		m_compilerStack.reset();
+		YulStringRepository::reset();
+	}
 
 	try
 	{
-		auto parsed = parseInput(_input);
+		auto parsed = parseInput(_input, _sourceContents);
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _outputStream);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1402,10 +2142,11 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 string StandardCompiler::compile(string const& _input) noexcept
 {
 	Json::Value input;
+	map<string, string> sourceContents;
 	string errors;
 	try
 	{
-		if (!util::jsonParseStrict(_input, input, &errors))
+		if (!parseInputJson(_input, input, sourceContents, &errors))
 			return util::jsonCompactPrint(formatFatalError("JSONError", errors));
 	}
 	catch (...)
@@ -1414,7 +2155,7 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	Json::Value output = compileInternal(input, nullptr, move(sourceContents));
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
@@ -1427,6 +2168,40 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	Json::Value input;
+	map<string, string> sourceContents;
+	string errors;
+	try
+	{
+		if (!parseInputJson(_input, input, sourceContents, &errors))
+		{
+			util::jsonCompactPrint(formatFatalError("JSONError", errors), _output);
+			return;
+		}
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
+	}
+
+	Json::Value output = compileInternal(input, &_output, move(sourceContents));
+	// A null value means that the output has already been written.
+	if (output.isNull())
+		return;
+
+	try
+	{
+		util::jsonCompactPrint(output, _output);
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	}
+}
+
 Json::Value StandardCompiler::formatFunctionDebugData(
 	map<string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -1450,3 +2225,29 @@ Json::Value StandardCompiler::formatFunctionDebugData(
 
 	return ret;
 }
+
+Json::Value StandardCompiler::formatTrace(util::Profiler const& _profiler)
+{
+	Json::Value events(Json::arrayValue);
+	for (util::Profiler::TraceEvent const& traceEvent: _profiler.traceEvents())
+	{
+		Json::Value event(Json::objectValue);
+		event["name"] = traceEvent.name;
+		event["cat"] = traceEvent.category;
+		// Complete events, which carry their duration.
+		event["ph"] = "X";
+		event["ts"] = traceEvent.start;
+		event["dur"] = traceEvent.duration;
+		event["pid"] = 0;
+		event["tid"] = Json::UInt64(traceEvent.thread);
+		event["args"]["scope"] = traceEvent.scope;
+		if (!traceEvent.object.empty())
+			event["args"]["object"] = traceEvent.object;
+		events.append(move(event));
+	}
+
+	Json::Value ret(Json::objectValue);
+	ret["traceEvents"] = move(events);
+	ret["displayTimeUnit"] = "ms";
+	return ret;
+}
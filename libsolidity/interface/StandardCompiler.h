@@ -26,6 +26,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -51,16 +52,36 @@ public:
 	{
 	}
 
+	/// Sets the number of Yul identifiers that are kept between compilations.
+	/// Before a compilation, the repository of Yul identifiers (and everything caching them,
+	/// like the dialects) is cleared if it contains more strings than this.
+	/// The default of zero clears it before every compilation.
+	void setYulStringRepositoryLimit(size_t _limit) { m_yulStringRepositoryLimit = _limit; }
+
+	/// Enables or disables keeping the analysed Solidity sources between compilations,
+	/// so that only the sources affected by changes are analysed again.
+	/// The sources are dropped whenever the repository of Yul identifiers is cleared.
+	void setIncrementalAnalysis(bool _enable);
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Performs the same steps, but writes the serialized JSON output to @a _output.
+	/// The output of each source and contract is generated right before it is written, so that
+	/// the complete output is never held in memory. The result is the same as the one of the
+	/// function above, unless an internal error occurs while generating these outputs. In that
+	/// case, the outputs written so far are kept and the error is reported in addition.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
+	/// @returns the spans recorded by @a _profiler in the Trace Event Format, which can be
+	/// loaded into chrome://tracing or Perfetto.
+	static Json::Value formatTrace(util::Profiler const& _profiler);
 
 private:
 	struct InputsAndSettings
@@ -74,6 +95,8 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<ImportRemapper::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		bool profile = false;
+		bool trace = false;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
@@ -81,16 +104,38 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		unsigned parallelism = 1;
+		bool checkImportedSources = true;
+		bool gasEstimationUpperBoundOnly = false;
+		std::optional<std::string> cacheDirectory;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
-	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
+	/// @param _sourceContents contents of sources already decoded from the input, which are
+	/// used instead of the (empty) contents in @a _input.
+	std::variant<InputsAndSettings, Json::Value> parseInput(
+		Json::Value const& _input,
+		std::map<std::string, std::string>& _sourceContents
+	);
+
+	/// Compiles and writes the output to @a _outputStream if given.
+	/// @returns the output or, if it was written to @a _outputStream, a null value.
+	Json::Value compileInternal(
+		Json::Value const& _input,
+		std::ostream* _outputStream,
+		std::map<std::string, std::string> _sourceContents = {}
+	) noexcept;
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// @returns the output or, if @a _outputStream is given, writes it there and returns a null value.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, std::ostream* _outputStream = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	size_t m_yulStringRepositoryLimit = 0;
+	bool m_incrementalAnalysis = false;
+	/// Compiler stack kept between compilations in incremental analysis mode.
+	std::unique_ptr<CompilerStack> m_compilerStack;
 };
 
 }
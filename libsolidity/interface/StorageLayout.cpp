@@ -64,11 +64,26 @@ Json::Value StorageLayout::generate(VariableDeclaration const& _var, u256 const&
 
 void StorageLayout::generate(Type const* _type)
 {
-	if (m_types.isMember(typeKeyName(_type)))
+	string const keyName = typeKeyName(_type);
+	if (m_types.isMember(keyName))
 		return;
 
 	// Register it now to cut recursive visits.
-	Json::Value& typeInfo = m_types[typeKeyName(_type)];
+	Json::Value& typeInfo = m_types[keyName];
+	if (m_typeCache && m_typeCache->count(_type))
+	{
+		typeInfo = m_typeCache->at(_type);
+		if (auto mappingType = dynamic_cast<MappingType const*>(_type))
+		{
+			generate(mappingType->keyType());
+			generate(mappingType->valueType());
+		}
+		else if (auto arrayType = dynamic_cast<ArrayType const*>(_type))
+			if (!arrayType->isByteArray())
+				generate(arrayType->baseType());
+		return;
+	}
+
 	typeInfo["label"] = _type->toString(true);
 	typeInfo["numberOfBytes"] = u256(_type->storageBytes() * _type->storageSize()).str();
 
@@ -110,6 +125,9 @@ void StorageLayout::generate(Type const* _type)
 	}
 
 	solAssert(typeInfo.isMember("encoding"), "");
+	// The members of structs refer to the contract.
+	if (m_typeCache && !dynamic_cast<StructType const*>(_type))
+		(*m_typeCache)[_type] = typeInfo;
 }
 
 string StorageLayout::typeKeyName(Type const* _type)
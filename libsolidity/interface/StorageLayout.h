@@ -26,12 +26,21 @@
 
 #include <json/json.h>
 
+#include <map>
+
 namespace solidity::frontend
 {
 
 class StorageLayout
 {
 public:
+	/// Descriptions of types by type that do not depend on the contract, i.e. of all but
+	/// struct types. Can be shared between the storage layouts of all contracts of a
+	/// compilation, as long as the types are alive.
+	using TypeCache = std::map<Type const*, Json::Value>;
+
+	explicit StorageLayout(TypeCache* _typeCache = nullptr): m_typeCache(_typeCache) {}
+
 	/// Generates the storage layout of the contract
 	/// @param _contractDef The contract definition
 	/// @return A JSON representation of the contract's storage layout.
@@ -48,6 +57,7 @@ private:
 	std::string typeKeyName(Type const* _type);
 
 	Json::Value m_types;
+	TypeCache* m_typeCache = nullptr;
 
 	/// Current analyzed contract
 	ContractDefinition const* m_contract = nullptr;
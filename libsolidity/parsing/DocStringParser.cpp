@@ -91,10 +91,12 @@ multimap<string, DocTag> DocStringParser::parse()
 
 	while (currPos != end)
 	{
-		iter tagPos = find(currPos, end, '@');
+		// Only look for a tag in the current line, so that long comments are not
+		// searched until their end for every line.
 		iter nlPos = find(currPos, end, '\n');
+		iter tagPos = find(currPos, nlPos, '@');
 
-		if (tagPos != end && tagPos < nlPos)
+		if (tagPos != nlPos)
 		{
 			// we found a tag
 			iter tagNameEndPos = firstWhitespaceOrNewline(tagPos, end);
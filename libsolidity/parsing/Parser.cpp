@@ -31,6 +31,7 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
 #include <liblangutil/SourceLocation.h>
+#include <libsolutil/CommonData.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -66,7 +67,15 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		auto node = allocate_shared<NodeType>(
+			util::ArenaAllocator<NodeType>(m_parser.m_arena),
+			m_parser.nextID(),
+			m_location,
+			std::forward<Args>(_args)...
+		);
+		if (m_parser.m_relocatableNodeIDs)
+			m_parser.m_createdNodes.push_back(node);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -76,6 +85,15 @@ private:
 	SourceLocation m_location;
 };
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(m_relocatableNodeIDs, "");
+	for (ASTPointer<ASTNode> const& node: m_createdNodes)
+		node->m_id = static_cast<size_t>(node->id() + _offset);
+	m_createdNodes.clear();
+	m_currentNodeID += _offset;
+}
+
 ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 {
 	solAssert(!m_insideModifier, "");
@@ -83,6 +101,8 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	{
 		m_recursionDepth = 0;
 		m_scanner = _scanner;
+		m_arena = make_shared<util::Arena>();
+		m_names.clear();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -1915,13 +1935,13 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 	}
 	case Token::Identifier:
 		nodeFactory.markEndPosition();
-		expression = nodeFactory.createNode<Identifier>(getLiteralAndAdvance());
+		expression = nodeFactory.createNode<Identifier>(expectIdentifierToken());
 		break;
 	case Token::Type:
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		m_scanner->next();
-		expression = nodeFactory.createNode<Identifier>(make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(internName("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -2262,7 +2282,9 @@ ASTPointer<ParameterList> Parser::createEmptyParameterList()
 ASTPointer<ASTString> Parser::expectIdentifierToken()
 {
 	expectToken(Token::Identifier, false /* do not advance */);
-	return getLiteralAndAdvance();
+	ASTPointer<ASTString> name = internName(m_scanner->currentLiteral());
+	m_scanner->next();
+	return name;
 }
 
 ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
@@ -2270,14 +2292,11 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 	ASTPointer<ASTString> result;
 	if (m_scanner->currentToken() == Token::Address)
 	{
-		result = make_shared<ASTString>("address");
+		result = internName("address");
 		m_scanner->next();
 	}
 	else
-	{
-		expectToken(Token::Identifier, false /* do not advance */);
-		result = getLiteralAndAdvance();
-	}
+		result = expectIdentifierToken();
 	return result;
 }
 
@@ -2288,4 +2307,13 @@ ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 	return identifier;
 }
 
+ASTPointer<ASTString> Parser::internName(string const& _name)
+{
+	if (ASTPointer<ASTString> const* name = util::valueOrNullptr(m_names, string_view(_name)))
+		return *name;
+	auto name = make_shared<ASTString>(_name);
+	m_names.emplace(string_view(*name), name);
+	return name;
+}
+
 }
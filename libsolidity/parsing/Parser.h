@@ -26,6 +26,10 @@
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Arena.h>
+
+#include <string_view>
+#include <unordered_map>
 
 namespace solidity::langutil
 {
@@ -49,6 +53,19 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// @returns the ID of the most recently created AST node.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Continues assigning node IDs after @a _id. Used to reproduce the IDs of a previous
+	/// run when parsing only some of the sources again.
+	void setLastNodeID(int64_t _id) { m_currentNodeID = _id; }
+	/// Keeps track of the nodes created by the following calls to @a parse, so that their
+	/// IDs can be moved by @a shiftNodeIDs. This allows parsing source units independently
+	/// and still assigning the IDs they would get if they were parsed one after the other.
+	void setRelocatableNodeIDs(bool _relocatable = true) { m_relocatableNodeIDs = _relocatable; }
+	/// Adds @a _offset to the IDs of the nodes created since the last call and to the ID
+	/// of the most recently created node. Requires relocatable node IDs.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -206,6 +223,9 @@ private:
 	ASTPointer<ASTString> expectIdentifierToken();
 	ASTPointer<ASTString> expectIdentifierTokenOrAddress();
 	ASTPointer<ASTString> getLiteralAndAdvance();
+	/// @returns the identifier @a _name as a string that is shared by all its occurrences in the
+	/// source unit being parsed.
+	ASTPointer<ASTString> internName(std::string const& _name);
 	///@}
 
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
@@ -216,6 +236,14 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Storage for the nodes of the source unit being parsed. Every node keeps it alive,
+	/// so it is released together with the last node.
+	std::shared_ptr<util::Arena> m_arena;
+	/// Identifiers of the source unit being parsed, each stored once.
+	std::unordered_map<std::string_view, ASTPointer<ASTString>> m_names;
+	bool m_relocatableNodeIDs = false;
+	/// The nodes created since the last call to @a shiftNodeIDs, if node IDs are relocatable.
+	std::vector<ASTPointer<ASTNode>> m_createdNodes;
 };
 
 }
@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+using namespace solidity::util;
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+	assertThrow(
+		_alignment <= alignof(max_align_t),
+		Exception,
+		"Alignment not supported by the arena."
+	);
+
+	void* position = m_position;
+	if (!m_position || !align(_alignment, _size, position, m_available))
+	{
+		// Requests that do not fit into a regular chunk get a chunk of their own, so that
+		// the remainder of the current chunk can still be used.
+		size_t const chunkSize = max(_size, m_chunkSize);
+		m_chunks.emplace_back(new byte[chunkSize]);
+		m_reservedBytes += chunkSize;
+		if (chunkSize > m_chunkSize && m_position)
+			return m_chunks.back().get();
+		m_position = m_chunks.back().get();
+		m_available = chunkSize;
+		position = m_position;
+	}
+
+	m_position = static_cast<byte*>(position) + _size;
+	m_available -= _size;
+	return position;
+}
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump allocator for objects that are released together.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory region that hands out storage from large chunks and releases all of it at once
+ * when it is destroyed. Deallocating individual objects is a no-op.
+ *
+ * Allocation is not thread-safe, but the memory can be used and the objects destroyed
+ * from any thread.
+ */
+class Arena
+{
+public:
+	explicit Arena(size_t _chunkSize = 64 * 1024): m_chunkSize(_chunkSize) {}
+
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns storage for @a _size bytes aligned to @a _alignment, which cannot exceed
+	/// the alignment of std::max_align_t.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the total number of bytes requested from the system.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	size_t m_chunkSize;
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	std::byte* m_position = nullptr;
+	size_t m_available = 0;
+	size_t m_reservedBytes = 0;
+};
+
+/**
+ * Standard allocator that allocates from an Arena and keeps it alive as long as any
+ * allocator (and thus any container or shared pointer using it) refers to it.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -28,6 +28,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -35,8 +37,38 @@ using namespace solidity::util;
 namespace
 {
 
-static char const* upperHexChars = "0123456789ABCDEF";
-static char const* lowerHexChars = "0123456789abcdef";
+constexpr char upperHexChars[] = "0123456789ABCDEF";
+constexpr char lowerHexChars[] = "0123456789abcdef";
+
+/// @returns the two hex characters of every byte value, one pair after another.
+constexpr array<char, 512> hexPairs(char const* _chars)
+{
+	array<char, 512> pairs{};
+	for (size_t i = 0; i < 256; ++i)
+	{
+		pairs[2 * i] = _chars[i >> 4];
+		pairs[2 * i + 1] = _chars[i & 0xf];
+	}
+	return pairs;
+}
+
+constexpr array<char, 512> upperHexPairs = hexPairs(upperHexChars);
+constexpr array<char, 512> lowerHexPairs = hexPairs(lowerHexChars);
+
+/// The value of every hex character and -1 for all other characters.
+constexpr array<int8_t, 256> hexValues = []() {
+	array<int8_t, 256> values{};
+	for (size_t i = 0; i < 256; ++i)
+		values[i] = -1;
+	for (int8_t i = 0; i < 10; ++i)
+		values[static_cast<size_t>('0' + i)] = i;
+	for (int8_t i = 0; i < 6; ++i)
+	{
+		values[static_cast<size_t>('a' + i)] = static_cast<int8_t>(10 + i);
+		values[static_cast<size_t>('A' + i)] = static_cast<int8_t>(10 + i);
+	}
+	return values;
+}();
 
 }
 
@@ -56,38 +88,43 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 {
 	std::string ret(_data.size() * 2 + (_prefix == HexPrefix::Add ? 2 : 0), 0);
 
-	size_t i = 0;
+	char* output = ret.data();
 	if (_prefix == HexPrefix::Add)
 	{
-		ret[i++] = '0';
-		ret[i++] = 'x';
+		*output++ = '0';
+		*output++ = 'x';
 	}
 
-	// Mixed case will be handled inside the loop.
-	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
-	size_t rix = _data.size() - 1;
-	for (uint8_t c: _data)
+	if (_case == HexCase::Mixed)
 	{
 		// switch hex case every four hexchars
-		if (_case == HexCase::Mixed)
-			chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
-
-		ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
-		ret[i++] = chars[c & 0xfu];
+		size_t rix = _data.size() - 1;
+		for (uint8_t c: _data)
+		{
+			char const* pair = ((rix-- & 2) == 0 ? lowerHexPairs : upperHexPairs).data() + 2 * size_t(c);
+			*output++ = pair[0];
+			*output++ = pair[1];
+		}
+	}
+	else
+	{
+		char const* pairs = (_case == HexCase::Upper ? upperHexPairs : lowerHexPairs).data();
+		for (uint8_t c: _data)
+		{
+			*output++ = pairs[2 * size_t(c)];
+			*output++ = pairs[2 * size_t(c) + 1];
+		}
 	}
-	assertThrow(i == ret.size(), Exception, "");
+	assertThrow(output == ret.data() + ret.size(), Exception, "");
 
 	return ret;
 }
 
 int solidity::util::fromHex(char _i, WhenError _throw)
 {
-	if (_i >= '0' && _i <= '9')
-		return _i - '0';
-	if (_i >= 'a' && _i <= 'f')
-		return _i - 'a' + 10;
-	if (_i >= 'A' && _i <= 'F')
-		return _i - 'A' + 10;
+	int8_t value = hexValues[static_cast<uint8_t>(_i)];
+	if (value >= 0)
+		return value;
 	if (_throw == WhenError::Throw)
 		assertThrow(false, BadHexCharacter, to_string(_i));
 	else
@@ -99,26 +136,32 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 	if (_s.empty())
 		return {};
 
-	unsigned s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
-	std::vector<uint8_t> ret;
-	ret.reserve((_s.size() - s + 1) / 2);
+	size_t s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
+	bytes ret((_s.size() - s + 1) / 2);
+	uint8_t* output = ret.data();
 
-	if (_s.size() % 2)
+	if ((_s.size() - s) % 2)
 	{
-		int h = fromHex(_s[s++], _throw);
-		if (h != -1)
-			ret.push_back(static_cast<uint8_t>(h));
-		else
+		int8_t h = hexValues[static_cast<uint8_t>(_s[s])];
+		if (h < 0)
+		{
+			// Throws if requested.
+			fromHex(_s[s], _throw);
 			return bytes();
+		}
+		*output++ = static_cast<uint8_t>(h);
+		++s;
 	}
-	for (unsigned i = s; i < _s.size(); i += 2)
+	for (size_t i = s; i < _s.size(); i += 2)
 	{
-		int h = fromHex(_s[i], _throw);
-		int l = fromHex(_s[i + 1], _throw);
-		if (h != -1 && l != -1)
-			ret.push_back(static_cast<uint8_t>(h * 16 + l));
-		else
+		int8_t h = hexValues[static_cast<uint8_t>(_s[i])];
+		int8_t l = hexValues[static_cast<uint8_t>(_s[i + 1])];
+		if (h < 0 || l < 0)
+		{
+			fromHex(h < 0 ? _s[i] : _s[i + 1], _throw);
 			return bytes();
+		}
+		*output++ = static_cast<uint8_t>(h * 16 + l);
 	}
 	return ret;
 }
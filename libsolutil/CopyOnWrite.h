@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace solidity::util
+{
+
+/**
+ * A value that is shared between copies until one of them is modified. Copying is O(1),
+ * the first modification of a shared value copies it.
+ *
+ * A default constructed or cleared CopyOnWrite holds a default constructed value without
+ * allocating it. Copies must not be modified concurrently with other copies of the same value.
+ *
+ * @tparam T the type of the stored value; has to be default constructible and copyable.
+ */
+template<typename T>
+class CopyOnWrite
+{
+public:
+	using value_type = T;
+
+	static_assert(std::is_default_constructible_v<value_type>, "The value type has to be default constructible.");
+	static_assert(std::is_copy_constructible_v<value_type>, "The value type has to be copyable.");
+
+	CopyOnWrite() = default;
+	explicit CopyOnWrite(value_type _value): m_value(std::make_shared<value_type>(std::move(_value))) {}
+
+	value_type const& operator*() const { return m_value ? *m_value : empty(); }
+	value_type const* operator->() const { return &**this; }
+
+	/// @returns a reference to the value that can be modified, after copying it if it is shared
+	/// with other copies. The reference is invalidated by copying this object.
+	value_type& write()
+	{
+		if (!m_value)
+			m_value = std::make_shared<value_type>();
+		else if (m_value.use_count() > 1)
+			m_value = std::make_shared<value_type>(*m_value);
+		return *m_value;
+	}
+
+	/// Resets the value to a default constructed one without copying it.
+	void clear() { m_value.reset(); }
+
+	/// @returns true if both objects share the same value, which implies that they are equal.
+	bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+	bool operator==(CopyOnWrite const& _other) const { return sharesValueWith(_other) || **this == *_other; }
+	bool operator!=(CopyOnWrite const& _other) const { return !(*this == _other); }
+
+private:
+	static value_type const& empty()
+	{
+		static value_type const emptyValue{};
+		return emptyValue;
+	}
+
+	std::shared_ptr<value_type> m_value;
+};
+
+}
@@ -0,0 +1,184 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Maps and relations that also store their inverse.
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Map that also stores the inverse relation, so that all keys mapped to
+ * a given value can be found and removed without iterating over the whole map.
+ *
+ * Checkpoints allow forking the map at a point in the control-flow and joining it
+ * there again at cost proportional to the number of changes in between: Since the
+ * innermost checkpoint, the value each changed key had at the checkpoint is recorded.
+ *
+ * All modifications have to be done via the member functions, but @a values can be read directly.
+ */
+template<typename K, typename V>
+struct InvertibleMap
+{
+	/// Current contents of the map.
+	std::map<K, V> values;
+	/// references[v] == {k | values[k] == v}
+	std::map<V, std::set<K>> references;
+
+	void set(K const& _key, V const& _value)
+	{
+		recordChange(_key);
+		if (auto it = values.find(_key); it != values.end())
+			removeReference(_key, it->second);
+		values[_key] = _value;
+		references[_value].insert(_key);
+	}
+
+	void eraseKey(K const& _key)
+	{
+		auto it = values.find(_key);
+		if (it == values.end())
+			return;
+		recordChange(_key);
+		removeReference(_key, it->second);
+		values.erase(it);
+	}
+
+	/// Removes all keys mapped to @a _value.
+	void eraseValue(V const& _value)
+	{
+		auto it = references.find(_value);
+		if (it == references.end())
+			return;
+		std::set<K> keys = std::move(it->second);
+		references.erase(it);
+		for (K const& key: keys)
+		{
+			recordChange(key);
+			values.erase(key);
+		}
+	}
+
+	/// Removes all keys for which @a _predicate(key, value) is true.
+	template<typename Predicate>
+	void eraseIf(Predicate&& _predicate)
+	{
+		std::vector<K> keys;
+		for (auto const& [key, value]: values)
+			if (_predicate(key, value))
+				keys.push_back(key);
+		for (K const& key: keys)
+			eraseKey(key);
+	}
+
+	void clear()
+	{
+		for (auto const& entry: values)
+			recordChange(entry.first);
+		values.clear();
+		references.clear();
+	}
+
+	/// Creates a new checkpoint at the current state.
+	void pushCheckpoint()
+	{
+		m_checkpoints.emplace_back();
+	}
+
+	/// Removes the innermost checkpoint. Afterwards, only the keys whose value is the same
+	/// as at the checkpoint remain in the map.
+	void joinCheckpoint()
+	{
+		std::map<K, std::optional<V>> changes = std::move(m_checkpoints.back());
+		m_checkpoints.pop_back();
+		// The values at the innermost checkpoint are the values at the enclosing checkpoint
+		// for all keys that were not changed between the two.
+		if (!m_checkpoints.empty())
+			m_checkpoints.back().insert(changes.begin(), changes.end());
+		for (auto const& [key, oldValue]: changes)
+			if (auto it = values.find(key); it != values.end() && (!oldValue || *oldValue != it->second))
+				eraseKey(key);
+	}
+
+private:
+	void recordChange(K const& _key)
+	{
+		if (m_checkpoints.empty() || m_checkpoints.back().count(_key))
+			return;
+		auto it = values.find(_key);
+		m_checkpoints.back()[_key] = it == values.end() ? std::nullopt : std::optional<V>(it->second);
+	}
+
+	void removeReference(K const& _key, V const& _value)
+	{
+		auto it = references.find(_value);
+		it->second.erase(_key);
+		if (it->second.empty())
+			references.erase(it);
+	}
+
+	/// For each checkpoint the values the changed keys had at that point.
+	std::vector<std::map<K, std::optional<V>>> m_checkpoints;
+};
+
+/**
+ * Relation that also stores its inverse, so that all keys related to a given value
+ * can be found without iterating over the whole relation.
+ */
+template<typename T>
+struct InvertibleRelation
+{
+	/// values[a].contains(b) <=> a is related to b
+	std::map<T, std::set<T>> values;
+	/// references[b].contains(a) <=> a is related to b
+	std::map<T, std::set<T>> references;
+
+	/// Replaces the values related to @a _key by @a _values.
+	void set(T const& _key, std::set<T> _values)
+	{
+		eraseKey(_key);
+		for (T const& value: _values)
+			references[value].insert(_key);
+		values[_key] = std::move(_values);
+	}
+
+	void eraseKey(T const& _key)
+	{
+		auto it = values.find(_key);
+		if (it == values.end())
+			return;
+		for (T const& value: it->second)
+		{
+			auto referencesIt = references.find(value);
+			referencesIt->second.erase(_key);
+			if (referencesIt->second.empty())
+				references.erase(referencesIt);
+		}
+		values.erase(it);
+	}
+};
+
+}
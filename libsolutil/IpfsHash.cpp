@@ -21,6 +21,9 @@
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/picosha2.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <numeric>
 
 using namespace std;
 using namespace solidity;
@@ -152,51 +155,63 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data, size_t _parallelism)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
 	chunkCount = chunkCount == 0 ? 1 : chunkCount;
 
-	Chunks allChunks;
+	Chunks allChunks(chunkCount);
+	vector<size_t> chunkIndices(chunkCount);
+	iota(chunkIndices.begin(), chunkIndices.end(), 0);
 
-	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
-	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+	// The data of a chunk is only fed to the hash function, it is never copied.
+	ThreadPool(chunkCount > 1 ? _parallelism : 1).forEach(chunkIndices, [&](size_t _chunkIndex) {
+		bytesConstRef chunkBytes = bytesConstRef(_data).cropped(
+			_chunkIndex * maxChunkSize,
+			min(maxChunkSize, _data.length() - _chunkIndex * maxChunkSize)
 		);
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
-		bytes protobufEncodedData;
+		bytes protobufPrefix;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
+		protobufPrefix += bytes{0x08, 0x02};
 		if (!chunkBytes.empty())
 		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			protobufPrefix += bytes{0x12};
+			protobufPrefix += lengthAsVarint;
 		}
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		size_t const protobufSize = protobufPrefix.size() + chunkBytes.size() + protobufSuffix.size();
+		bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize) + protobufPrefix;
 
 		// Multihash: sha2-256, 256 bits
-		allChunks.emplace_back(
-			encodeHash(blockData),
+		picosha2::hash256_one_by_one hasher;
+		hasher.process(blockPrefix.begin(), blockPrefix.end());
+		hasher.process(chunkBytes.begin(), chunkBytes.end());
+		hasher.process(protobufSuffix.begin(), protobufSuffix.end());
+		hasher.finish();
+		bytes hash{0x12, 0x20};
+		hash.resize(2 + picosha2::k_digest_size);
+		hasher.get_hash_bytes(hash.begin() + 2, hash.end());
+
+		allChunks[_chunkIndex] = Chunk(
+			move(hash),
 			chunkBytes.size(),
-			blockData.size()
+			blockPrefix.size() + chunkBytes.size() + protobufSuffix.size()
 		);
-	}
+	});
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data, size_t _parallelism)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data, _parallelism));
 }
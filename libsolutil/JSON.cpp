@@ -123,10 +123,18 @@ string jsonPrettyPrint(Json::Value const& _input)
 }
 
 string jsonCompactPrint(Json::Value const& _input)
+{
+	stringstream stream;
+	jsonCompactPrint(_input, stream);
+	return stream.str();
+}
+
+void jsonCompactPrint(Json::Value const& _input, ostream& _stream)
 {
 	static map<string, Json::Value> settings{{"indentation", ""}};
 	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+	writer->write(_input, &_stream);
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
@@ -25,6 +25,7 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
 
 namespace solidity::util
@@ -39,6 +40,9 @@ std::string jsonPrettyPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) without indentation
 std::string jsonCompactPrint(Json::Value const& _input);
 
+/// Serialise the JSON object (@a _input) without indentation directly into @a _stream
+void jsonCompactPrint(Json::Value const& _input, std::ostream& _stream);
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
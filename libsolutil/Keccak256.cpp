@@ -22,8 +22,10 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <numeric>
 
 using namespace std;
 
@@ -169,6 +171,115 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+/******** Multi-buffer Keccak-256. ********/
+
+#if defined(__GNUC__)
+
+/// Number of states that are permuted together, one in each element of a vector.
+size_t constexpr lanes = 4;
+size_t constexpr keccak256Rate = 200 - (256 / 4);
+
+typedef uint64_t LaneVector __attribute__((vector_size(8 * lanes)));
+using LaneState = uint64_t[25][lanes];
+
+inline uint64_t loadLittleEndian(uint8_t const* _data)
+{
+	uint64_t result = 0;
+	for (size_t i = 0; i < 8; ++i)
+		result |= uint64_t(_data[i]) << (8 * i);
+	return result;
+}
+
+inline void storeLittleEndian(uint64_t _value, uint8_t* _data)
+{
+	for (size_t i = 0; i < 8; ++i)
+		_data[i] = static_cast<uint8_t>(_value >> (8 * i));
+}
+
+/// Keccak-f[1600] applied to @a lanes independent states. It is the same as keccakf,
+/// only on vectors instead of single words.
+__attribute__((always_inline)) inline void keccakfLanesImpl(LaneState& _state)
+{
+	LaneVector a[25];
+	memcpy(a, _state, sizeof(a));
+	for (int i = 0; i < 24; i++)
+	{
+		LaneVector b[5];
+		LaneVector t;
+		uint8_t x, y;
+		// Theta
+		FOR5(uint8_t, x, 1,
+			b[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20]; )
+		FOR5(uint8_t, x, 1,
+			t = b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1);
+			FOR5(uint8_t, y, 5,
+				a[y + x] ^= t; ))
+		// Rho and pi
+		t = a[1];
+		x = 0;
+		REPEAT24(b[0] = a[pi[x]];
+				a[pi[x]] = rol(t, rho[x]);
+				t = b[0];
+				x++; )
+		// Chi
+		FOR5(uint8_t,
+			y,
+			5,
+			FOR5(uint8_t, x, 1,
+				b[x] = a[y + x];)
+			FOR5(uint8_t, x, 1,
+				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
+		// Iota
+		a[0] ^= RC[i];
+	}
+	memcpy(_state, a, sizeof(a));
+}
+
+void keccakfLanes(LaneState& _state)
+{
+	keccakfLanesImpl(_state);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) void keccakfLanesAVX2(LaneState& _state)
+{
+	keccakfLanesImpl(_state);
+}
+#endif
+
+/// @returns the fastest variant of keccakfLanes supported by the processor.
+auto selectKeccakfLanes()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return &keccakfLanesAVX2;
+#endif
+	return &keccakfLanes;
+}
+
+/// Absorbs the block @a _block of the given input into lane @a _lane of @a _state.
+/// The last block is padded.
+void absorbBlock(LaneState& _state, size_t _lane, bytesConstRef _input, size_t _block)
+{
+	uint8_t padded[keccak256Rate];
+	uint8_t const* data = _input.data() + _block * keccak256Rate;
+	size_t const remaining = _input.size() - _block * keccak256Rate;
+	if (remaining < keccak256Rate)
+	{
+		memset(padded, 0, keccak256Rate);
+		if (remaining > 0)
+			memcpy(padded, data, remaining);
+		padded[remaining] ^= 0x01;
+		padded[keccak256Rate - 1] ^= 0x80;
+		data = padded;
+	}
+	for (size_t word = 0; word < keccak256Rate / 8; ++word)
+		_state[word][_lane] ^= loadLittleEndian(data + 8 * word);
+}
+
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -182,4 +293,52 @@ h256 keccak256(bytesConstRef _input)
 	return output;
 }
 
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> outputs(_inputs.size());
+#if defined(__GNUC__)
+	static auto const permute = selectKeccakfLanes();
+
+	// Every input needs one permutation per full block and one for the padded last block.
+	auto blockCount = [](bytesConstRef _input) { return _input.size() / keccak256Rate + 1; };
+
+	// Group inputs of the same number of blocks, so that few permutations are wasted.
+	vector<size_t> order(_inputs.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		return blockCount(_inputs[_a]) < blockCount(_inputs[_b]);
+	});
+
+	for (size_t group = 0; group < order.size(); group += lanes)
+	{
+		size_t const groupSize = min(lanes, order.size() - group);
+		if (groupSize == 1)
+		{
+			outputs[order[group]] = keccak256(_inputs[order[group]]);
+			continue;
+		}
+
+		LaneState state = {};
+		size_t const blocks = blockCount(_inputs[order[group + groupSize - 1]]);
+		for (size_t block = 0; block < blocks; ++block)
+		{
+			for (size_t lane = 0; lane < groupSize; ++lane)
+				if (block < blockCount(_inputs[order[group + lane]]))
+					absorbBlock(state, lane, _inputs[order[group + lane]], block);
+			permute(state);
+			for (size_t lane = 0; lane < groupSize; ++lane)
+				if (block + 1 == blockCount(_inputs[order[group + lane]]))
+				{
+					h256& output = outputs[order[group + lane]];
+					for (size_t word = 0; word < h256::size / 8; ++word)
+						storeLittleEndian(state[word][lane], output.data() + 8 * word);
+				}
+		}
+	}
+#else
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		outputs[i] = keccak256(_inputs[i]);
+#endif
+	return outputs;
+}
 }
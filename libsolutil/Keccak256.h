@@ -27,6 +27,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -43,4 +44,9 @@ inline h256 keccak256(std::string const& _input) { return keccak256(bytesConstRe
 /// Calculate Keccak-256 hash of the given input (presented as a FixedHash), returns a 256-bit hash.
 template<unsigned N> inline h256 keccak256(FixedHash<N> const& _input) { return keccak256(_input.ref()); }
 
+/// Calculate the Keccak-256 hashes of all given inputs. The inputs are processed several
+/// at a time, which is faster than hashing them one after the other.
+/// @returns the hashes in the order of the inputs.
+std::vector<h256> keccak256Batch(std::vector<bytesConstRef> const& _inputs);
+
 }
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Thread-safe map of bounded size that evicts the least recently used entries.
+ */
+
+#pragma once
+
+#include <libsolutil/Assertions.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Map from keys to values that holds at most a given number of entries.
+ * Inserting into a full cache removes the entry that was accessed least recently.
+ * All member functions can be called concurrently.
+ */
+template<typename Key, typename Value>
+class LRUCache
+{
+public:
+	explicit LRUCache(size_t _capacity): m_capacity(_capacity)
+	{
+		assertThrow(m_capacity > 0, Exception, "Cache capacity has to be positive.");
+	}
+
+	/// @returns a copy of the value stored for @a _key, if any, and marks the entry as recently used.
+	std::optional<Value> find(Key const& _key)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return std::nullopt;
+		m_usage.splice(m_usage.begin(), m_usage, it->second.second);
+		return it->second.first;
+	}
+
+	/// Stores @a _value for @a _key, replacing any previous value.
+	void insert(Key const& _key, Value _value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it != m_entries.end())
+		{
+			it->second.first = std::move(_value);
+			m_usage.splice(m_usage.begin(), m_usage, it->second.second);
+			return;
+		}
+		if (m_entries.size() == m_capacity)
+		{
+			m_entries.erase(m_usage.back());
+			m_usage.pop_back();
+		}
+		m_usage.push_front(_key);
+		m_entries.emplace(_key, std::make_pair(std::move(_value), m_usage.begin()));
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entries.clear();
+		m_usage.clear();
+	}
+
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+	size_t capacity() const { return m_capacity; }
+
+private:
+	using UsageList = std::list<Key>;
+
+	size_t const m_capacity;
+	mutable std::mutex m_mutex;
+	/// Keys ordered from the most to the least recently used.
+	UsageList m_usage;
+	std::map<Key, std::pair<Value, typename UsageList::iterator>> m_entries;
+};
+
+}
@@ -63,6 +63,7 @@ public:
 	{
 		this->m_value.swap(_other.m_value);
 		_other.m_value.reset();
+		return *this;
 	}
 
 	template<typename F>
@@ -79,6 +80,9 @@ public:
 		return m_value.value();
 	}
 
+	/// Destroys the stored value, so that it is initialized again by the next call to "init".
+	void reset() noexcept { m_value.reset(); }
+
 private:
 	/// Although not quite logically const, this is marked const for pragmatic reasons. It doesn't change the platonic
 	/// value of the object (which is something that is initialized to some computed value on first use).
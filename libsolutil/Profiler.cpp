@@ -0,0 +1,241 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+Profiler::Attribution& currentAttribution()
+{
+	static thread_local Profiler::Attribution attribution;
+	return attribution;
+}
+
+/// Counts of the current thread that have not been added to its profiler yet. Keyed by the
+/// address of the name, so that hot code does not have to compare strings.
+map<char const*, size_t>& pendingCounts()
+{
+	static thread_local map<char const*, size_t> counts;
+	return counts;
+}
+
+/// @returns the peak resident memory of the process in bytes or zero if it is not known.
+size_t peakMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+}
+
+Profiler::Scope::Scope(Profiler* _profiler, string _scope):
+	Scope(Attribution{_profiler, move(_scope), {}})
+{
+	if (m_active && _profiler->m_tracing && !currentAttribution().scope.empty())
+	{
+		m_traced = true;
+		m_wallStart = chrono::steady_clock::now();
+	}
+}
+
+Profiler::Scope::Scope(Attribution _attribution)
+{
+	if (!_attribution.profiler)
+		return;
+	m_active = true;
+	flushCounts();
+	m_previous = exchange(currentAttribution(), move(_attribution));
+}
+
+Profiler::Scope::~Scope()
+{
+	if (!m_active)
+		return;
+	flushCounts();
+	Attribution& attribution = currentAttribution();
+	if (m_traced)
+	{
+		TraceEvent event;
+		event.name = attribution.scope;
+		event.category = "scope";
+		event.scope = attribution.scope;
+		attribution.profiler->recordTraceEvent(move(event), m_wallStart);
+	}
+	attribution = move(m_previous);
+}
+
+Profiler::Phase::Phase(string_view _name)
+{
+	Attribution& attribution = currentAttribution();
+	if (!attribution.profiler)
+		return;
+	m_active = true;
+	m_parentLength = attribution.phase.size();
+	if (!attribution.phase.empty())
+		attribution.phase += '/';
+	attribution.phase += _name;
+	// Registers the phase, so that it is listed before the phases nested inside it.
+	attribution.profiler->record(attribution.scope, attribution.phase, Measurement{});
+	m_peakMemoryStart = peakMemory();
+	m_cpuStart = clock();
+	m_wallStart = chrono::steady_clock::now();
+}
+
+Profiler::Phase::Phase(string_view _name, string _object):
+	Phase(_name)
+{
+	m_object = move(_object);
+}
+
+Profiler::Phase::~Phase()
+{
+	if (!m_active)
+		return;
+	Measurement measurement;
+	measurement.count = 1;
+	measurement.wallTimeSeconds = chrono::duration<double>(chrono::steady_clock::now() - m_wallStart).count();
+	measurement.cpuTimeSeconds = static_cast<double>(clock() - m_cpuStart) / CLOCKS_PER_SEC;
+	size_t const peakMemoryEnd = peakMemory();
+	measurement.peakMemoryIncrease = peakMemoryEnd > m_peakMemoryStart ? peakMemoryEnd - m_peakMemoryStart : 0;
+
+	Attribution& attribution = currentAttribution();
+	attribution.profiler->record(attribution.scope, attribution.phase, measurement);
+	if (attribution.profiler->m_tracing)
+	{
+		TraceEvent event;
+		event.name = attribution.phase.substr(m_parentLength == 0 ? 0 : m_parentLength + 1);
+		event.category = "phase";
+		event.scope = attribution.scope;
+		event.object = move(m_object);
+		attribution.profiler->recordTraceEvent(move(event), m_wallStart);
+	}
+	attribution.phase.resize(m_parentLength);
+}
+
+Profiler::Attribution const& Profiler::attribution()
+{
+	return currentAttribution();
+}
+
+void Profiler::recordTransformation(Transformation _transformation)
+{
+	Attribution const& attribution = currentAttribution();
+	if (!attribution.profiler)
+		return;
+	lock_guard<mutex> lock(attribution.profiler->m_mutex);
+	attribution.profiler->m_transformations[attribution.scope].emplace_back(move(_transformation));
+}
+
+void Profiler::count(char const* _name, size_t _value)
+{
+	if (currentAttribution().profiler)
+		pendingCounts()[_name] += _value;
+}
+
+map<string, Profiler::Phases> Profiler::measurements() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	map<string, Phases> result;
+	for (auto const& [scope, scopeMeasurements]: m_scopes)
+		result[scope] = scopeMeasurements.phases;
+	return result;
+}
+
+map<string, vector<Profiler::Transformation>> Profiler::transformations() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_transformations;
+}
+
+map<string, Profiler::Counters> Profiler::counters() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_counters;
+}
+
+vector<Profiler::TraceEvent> Profiler::traceEvents() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_traceEvents;
+}
+
+void Profiler::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_scopes.clear();
+	m_transformations.clear();
+	m_counters.clear();
+	m_traceEvents.clear();
+	m_threadNumbers.clear();
+	m_traceStart = chrono::steady_clock::now();
+}
+
+void Profiler::record(string const& _scope, string const& _phase, Measurement const& _measurement)
+{
+	lock_guard<mutex> lock(m_mutex);
+	ScopeMeasurements& scope = m_scopes[_scope];
+	auto [it, inserted] = scope.phaseIndices.emplace(_phase, scope.phases.size());
+	if (inserted)
+		scope.phases.emplace_back(_phase, Measurement{});
+	Measurement& total = scope.phases[it->second].second;
+	total.count += _measurement.count;
+	total.wallTimeSeconds += _measurement.wallTimeSeconds;
+	total.cpuTimeSeconds += _measurement.cpuTimeSeconds;
+	total.peakMemoryIncrease += _measurement.peakMemoryIncrease;
+}
+
+void Profiler::flushCounts()
+{
+	map<char const*, size_t>& counts = pendingCounts();
+	Attribution const& attribution = currentAttribution();
+	if (counts.empty() || !attribution.profiler)
+		return;
+	lock_guard<mutex> lock(attribution.profiler->m_mutex);
+	Counters& scopeCounters = attribution.profiler->m_counters[attribution.scope];
+	for (auto const& [name, value]: counts)
+		scopeCounters[name] += value;
+	counts.clear();
+}
+
+void Profiler::recordTraceEvent(TraceEvent _event, chrono::steady_clock::time_point _start)
+{
+	auto const end = chrono::steady_clock::now();
+	lock_guard<mutex> lock(m_mutex);
+	_event.thread = m_threadNumbers.emplace(this_thread::get_id(), m_threadNumbers.size()).first->second;
+	_event.start = chrono::duration<double, micro>(_start - m_traceStart).count();
+	_event.duration = chrono::duration<double, micro>(end - _start).count();
+	m_traceEvents.emplace_back(move(_event));
+}
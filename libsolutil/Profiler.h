@@ -0,0 +1,218 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measurement of the time and memory spent in the phases of a compilation and counters of
+ * events in hot code.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Collects the wall time, CPU time and memory usage of the phases of a compilation,
+ * grouped by scopes like the contract that is compiled.
+ *
+ * Measurements are only taken on threads that are attributed to a profiler through
+ * @a Profiler::Scope, in all other cases @a Profiler::Phase does nothing. Tasks of a
+ * ThreadPool are attributed like the thread that submitted them.
+ *
+ * Counters are meant for code that runs too often to be measured as a phase, like matching
+ * a single simplification rule. They are incremented through @a SOL_PERF_COUNTER, which is
+ * cheap if the thread is not attributed to a profiler. The counts are accumulated per thread
+ * and added to the profiler when the attribution of the thread changes.
+ *
+ * If tracing is enabled, every phase and every named scope is also recorded as a span with
+ * its start time and thread, see @a traceEvents.
+ */
+class Profiler
+{
+public:
+	struct Measurement
+	{
+		/// Number of times the phase was entered.
+		size_t count = 0;
+		double wallTimeSeconds = 0;
+		/// CPU time of the whole process, which includes the work of other threads.
+		double cpuTimeSeconds = 0;
+		/// Increase of the peak resident memory of the process, in bytes.
+		size_t peakMemoryIncrease = 0;
+	};
+	/// Phases in the order in which they were entered first. Nested phases are named
+	/// by the names of the enclosing phases and their own name, separated by "/".
+	using Phases = std::vector<std::pair<std::string, Measurement>>;
+	/// Values of the counters by name.
+	using Counters = std::map<std::string, size_t>;
+
+	/// Effect of one invocation of a code transformation, like a step of the Yul optimiser.
+	struct Transformation
+	{
+		/// Name of the object the transformed code belongs to.
+		std::string object;
+		std::string name;
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+		size_t codeCostBefore = 0;
+		size_t codeCostAfter = 0;
+		double wallTimeSeconds = 0;
+	};
+
+	/// Span of a phase or a scope in the timeline of the compilation, recorded if tracing is enabled.
+	struct TraceEvent
+	{
+		/// Name of the phase without the enclosing phases or name of the scope.
+		std::string name;
+		/// "phase" or "scope".
+		std::string category;
+		std::string scope;
+		/// Name of the object processed by the phase, e.g. a Yul object. Can be empty.
+		std::string object;
+		/// Number of the thread the span was recorded on, in the order in which threads recorded spans first.
+		size_t thread = 0;
+		/// Start relative to the creation of the profiler and duration, in microseconds.
+		double start = 0;
+		double duration = 0;
+	};
+
+	/// The profiler, scope and enclosing phases measurements of a thread are attributed to.
+	struct Attribution
+	{
+		Profiler* profiler = nullptr;
+		std::string scope;
+		std::string phase;
+	};
+
+	/// Attributes the measurements of the current thread to a scope of @a _profiler while alive.
+	/// Does nothing if @a _profiler is null.
+	class Scope
+	{
+	public:
+		Scope(Profiler* _profiler, std::string _scope);
+		explicit Scope(Attribution _attribution);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		bool m_active = false;
+		bool m_traced = false;
+		std::chrono::steady_clock::time_point m_wallStart;
+		Attribution m_previous;
+	};
+
+	/// Measures the time and memory spent while alive as the phase @a _name, nested inside
+	/// the phase that is active on the current thread.
+	class Phase
+	{
+	public:
+		explicit Phase(std::string_view _name);
+		/// Also records @a _object as the object processed by the phase in the trace.
+		Phase(std::string_view _name, std::string _object);
+		~Phase();
+
+		Phase(Phase const&) = delete;
+		Phase& operator=(Phase const&) = delete;
+
+	private:
+		bool m_active = false;
+		size_t m_parentLength = 0;
+		std::string m_object;
+		std::chrono::steady_clock::time_point m_wallStart;
+		std::clock_t m_cpuStart = 0;
+		size_t m_peakMemoryStart = 0;
+	};
+
+	/// @returns the attribution of the current thread.
+	static Attribution const& attribution();
+	/// @returns true if the measurements of the current thread are attributed to a profiler.
+	/// Can be used to skip computing information that is only needed for @a recordTransformation.
+	static bool active() { return attribution().profiler; }
+	/// Records @a _transformation in the scope of the current thread. Does nothing if it is not
+	/// attributed to a profiler.
+	static void recordTransformation(Transformation _transformation);
+	/// Adds @a _value to the counter @a _name in the scope of the current thread. Does nothing if
+	/// it is not attributed to a profiler. @a _name has to be a string literal.
+	/// Use @a SOL_PERF_COUNTER instead of calling this directly.
+	static void count(char const* _name, size_t _value);
+
+	/// @returns the phases by scope.
+	std::map<std::string, Phases> measurements() const;
+	/// @returns the transformations by scope, in the order in which they were recorded.
+	std::map<std::string, std::vector<Transformation>> transformations() const;
+	/// @returns the counters by scope. Counts of threads that are still attributed to
+	/// the profiler are not included yet.
+	std::map<std::string, Counters> counters() const;
+	/// @returns the spans recorded while tracing was enabled, in the order in which they ended.
+	std::vector<TraceEvent> traceEvents() const;
+	/// Enables recording the spans of phases and scopes. Has to be called before any of them start.
+	void enableTracing(bool _enable = true) { m_tracing = _enable; }
+	bool tracing() const { return m_tracing; }
+	/// Removes all measurements and restarts the timeline of the trace.
+	void clear();
+
+private:
+	struct ScopeMeasurements
+	{
+		Phases phases;
+		std::map<std::string, size_t> phaseIndices;
+	};
+
+	void record(std::string const& _scope, std::string const& _phase, Measurement const& _measurement);
+	/// Adds the counts accumulated by the current thread to the profiler it is attributed to.
+	static void flushCounts();
+	void recordTraceEvent(TraceEvent _event, std::chrono::steady_clock::time_point _start);
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, ScopeMeasurements> m_scopes;
+	std::map<std::string, std::vector<Transformation>> m_transformations;
+	std::map<std::string, Counters> m_counters;
+	bool m_tracing = false;
+	std::chrono::steady_clock::time_point m_traceStart = std::chrono::steady_clock::now();
+	std::vector<TraceEvent> m_traceEvents;
+	std::map<std::thread::id, size_t> m_threadNumbers;
+};
+
+}
+
+/// Adds @a _value to the counter @a _name (a string literal) of the profiler the current thread
+/// is attributed to. The value is only evaluated if there is one. Compiled out completely if
+/// SOL_PERF_COUNTERS_DISABLED is defined (CMake option PERF_COUNTERS=OFF).
+#ifdef SOL_PERF_COUNTERS_DISABLED
+#define SOL_PERF_COUNTER(_name, _value) do {} while (false)
+#else
+#define SOL_PERF_COUNTER(_name, _value) \
+	do \
+	{ \
+		if (::solidity::util::Profiler::active()) \
+			::solidity::util::Profiler::count(_name, static_cast<size_t>(_value)); \
+	} \
+	while (false)
+#endif
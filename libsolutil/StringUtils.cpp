@@ -99,17 +99,29 @@ string solidity::util::quotedAlternativesList(vector<string> const& suggestions)
 string solidity::util::suffixedVariableNameList(string const& _baseName, size_t _startSuffix, size_t _endSuffix)
 {
 	string result;
+	auto append = [&](size_t _suffix) {
+		if (!result.empty())
+			result += ", ";
+		result += _baseName;
+		result += to_string(_suffix);
+	};
 	if (_startSuffix < _endSuffix)
-	{
-		result = _baseName + to_string(_startSuffix++);
-		while (_startSuffix < _endSuffix)
-			result += ", " + _baseName + to_string(_startSuffix++);
-	}
-	else if (_endSuffix < _startSuffix)
-	{
-		result = _baseName + to_string(_endSuffix++);
-		while (_endSuffix < _startSuffix)
-			result = _baseName + to_string(_endSuffix++) + ", " + result;
-	}
+		for (size_t suffix = _startSuffix; suffix < _endSuffix; ++suffix)
+			append(suffix);
+	else
+		for (size_t suffix = _startSuffix; suffix > _endSuffix; --suffix)
+			append(suffix - 1);
+	return result;
+}
+
+string solidity::util::concatenate(initializer_list<string_view> _parts)
+{
+	size_t size = 0;
+	for (string_view part: _parts)
+		size += part.size();
+	string result;
+	result.reserve(size);
+	for (string_view part: _parts)
+		result += part;
 	return result;
 }
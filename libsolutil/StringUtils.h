@@ -24,7 +24,9 @@
 
 #pragma once
 
+#include <initializer_list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <libsolutil/CommonData.h>
@@ -46,6 +48,10 @@ std::string quotedAlternativesList(std::vector<std::string> const& suggestions);
 /// If @a _startSuffix == @a _endSuffix, the empty string is returned.
 std::string suffixedVariableNameList(std::string const& _baseName, size_t _startSuffix, size_t _endSuffix);
 
+/// @returns the concatenation of @a _parts, which, unlike a chain of `+`, allocates memory
+/// for the result only once.
+std::string concatenate(std::initializer_list<std::string_view> _parts);
+
 /// Joins collection of strings into one string with separators between, last separator can be different.
 /// @param _list collection of strings to join
 /// @param _separator defaults to ", "
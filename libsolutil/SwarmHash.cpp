@@ -21,6 +21,11 @@
 #include <libsolutil/SwarmHash.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <array>
+#include <cstring>
+#include <numeric>
 
 using namespace std;
 using namespace solidity;
@@ -39,7 +44,9 @@ bytes toLittleEndian(uint64_t _size)
 
 h256 swarmHashSimple(bytesConstRef _data, size_t _size)
 {
-	return keccak256(toLittleEndian(_size) + _data.toBytes());
+	bytes data = toLittleEndian(_size);
+	data.insert(data.end(), _data.begin(), _data.end());
+	return keccak256(data);
 }
 
 h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
@@ -63,45 +70,72 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 	return swarmHashSimple(ref, _length);
 }
 
-h256 bmtHash(bytesConstRef _data)
+size_t constexpr chunkSize = 0x1000;
+
+/// Binary Merkle tree hash of a chunk of @a chunkSize bytes. The leaves of the tree
+/// are the sections of 64 bytes of the chunk. All nodes of a level are hashed at once.
+h256 bmtHash(bytesConstRef _chunk)
 {
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	vector<bytesConstRef> sections;
+	for (size_t i = 0; i < _chunk.size(); i += 64)
+		sections.emplace_back(_chunk.cropped(i, 64));
+
+	bytes nodes;
+	while (true)
+	{
+		vector<h256> hashes = keccak256Batch(sections);
+		if (hashes.size() == 1)
+			return hashes.front();
+		nodes.resize(hashes.size() * h256::size);
+		for (size_t i = 0; i < hashes.size(); ++i)
+			memcpy(nodes.data() + i * h256::size, hashes[i].data(), h256::size);
+		sections.clear();
+		for (size_t i = 0; i < nodes.size(); i += 64)
+			sections.emplace_back(bytesConstRef(&nodes).cropped(i, 64));
+	}
 }
 
-h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
+/// @returns the hash of the chunk tree of @a _data. The subtrees below the root are
+/// hashed using up to @a _parallelism threads.
+h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false, size_t _parallelism = 1)
 {
-	bytes dataToHash;
-	if (_data.size() < 0x1000)
-		dataToHash = _data.toBytes();
-	else if (_data.size() == 0x1000 && !_forceHigherLevel)
-		dataToHash = _data.toBytes();
+	array<uint8_t, chunkSize> chunk{};
+	bytesConstRef chunkData;
+	if (_data.size() == chunkSize && !_forceHigherLevel)
+		chunkData = _data;
+	else if (_data.size() < chunkSize)
+	{
+		if (!_data.empty())
+			memcpy(chunk.data(), _data.data(), _data.size());
+		chunkData = bytesConstRef(chunk.data(), chunk.size());
+	}
 	else
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _data.size())
-			maxRepresentedSize *= (0x1000 / 32);
+		size_t maxRepresentedSize = chunkSize;
+		while (maxRepresentedSize * (chunkSize / 32) < _data.size())
+			maxRepresentedSize *= (chunkSize / 32);
 		// If remaining size is 0x1000, but maxRepresentedSize is not,
 		// we have to still do one level of the chunk hashes.
-		bool forceHigher = maxRepresentedSize > 0x1000;
-		for (size_t i = 0; i < _data.size(); i += maxRepresentedSize)
-		{
-			size_t size = std::min(maxRepresentedSize, _data.size() - i);
-			dataToHash += chunkHash(_data.cropped(i, size), forceHigher).asBytes();
-		}
+		bool forceHigher = maxRepresentedSize > chunkSize;
+		vector<size_t> children((_data.size() + maxRepresentedSize - 1) / maxRepresentedSize);
+		iota(children.begin(), children.end(), 0);
+		ThreadPool(children.size() > 1 ? _parallelism : 1).forEach(children, [&](size_t _child) {
+			size_t offset = _child * maxRepresentedSize;
+			size_t size = std::min(maxRepresentedSize, _data.size() - offset);
+			h256 hash = chunkHash(_data.cropped(offset, size), forceHigher);
+			memcpy(chunk.data() + _child * h256::size, hash.data(), h256::size);
+		});
+		chunkData = bytesConstRef(chunk.data(), chunk.size());
 	}
 
-	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+	array<uint8_t, 8 + h256::size> span;
+	for (size_t i = 0; i < 8; ++i)
+		span[i] = (_data.size() >> (8 * i)) & 0xff;
+	h256 root = bmtHash(chunkData);
+	memcpy(span.data() + 8, root.data(), h256::size);
+	return keccak256(bytesConstRef(span.data(), span.size()));
 }
 
-
 }
 
 h256 solidity::util::bzzr0Hash(string const& _input)
@@ -110,9 +144,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input, size_t _parallelism)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input, false, _parallelism);
 }
@@ -31,11 +31,18 @@ namespace solidity::util
 h256 bzzr0Hash(std::string const& _input);
 
 /// Compute the "bzz hash" of @a _input (the NEW binary / BMT version)
-h256 bzzr1Hash(bytes const& _input);
+/// If the input consists of more than one chunk, up to @a _parallelism subtrees
+/// are hashed concurrently.
+h256 bzzr1Hash(bytesConstRef _input, size_t _parallelism = 1);
 
-inline h256 bzzr1Hash(std::string const& _input)
+inline h256 bzzr1Hash(bytes const& _input, size_t _parallelism = 1)
 {
-	return bzzr1Hash(asBytes(_input));
+	return bzzr1Hash(bytesConstRef(&_input), _parallelism);
+}
+
+inline h256 bzzr1Hash(std::string const& _input, size_t _parallelism = 1)
+{
+	return bzzr1Hash(bytesConstRef(_input), _parallelism);
 }
 
 }
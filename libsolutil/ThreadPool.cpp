@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <libsolutil/Profiler.h>
+
+using namespace std;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	if (_threads > 1)
+		for (size_t i = 0; i < _threads; ++i)
+			m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_shutdown = true;
+	}
+	m_taskAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::submit(function<void()> _task)
+{
+	if (Profiler::attribution().profiler)
+		_task = [attribution = Profiler::attribution(), task = move(_task)]() {
+			Profiler::Scope scope(attribution);
+			task();
+		};
+	Task task{m_submitted++, move(_task)};
+	if (m_workers.empty())
+	{
+		// Like in a plain loop, nothing runs after the first failure.
+		if (!m_exception)
+			run(task);
+		++m_finished;
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_queue.emplace_back(move(task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::waitAll()
+{
+	exception_ptr exception;
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_batchDone.wait(lock, [this]() { return m_finished == m_submitted; });
+		m_submitted = 0;
+		m_finished = 0;
+		swap(exception, m_exception);
+	}
+	if (exception)
+		rethrow_exception(exception);
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		Task task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+			if (m_queue.empty())
+				return;
+			task = move(m_queue.front());
+			m_queue.pop_front();
+		}
+
+		run(task);
+
+		{
+			lock_guard<mutex> lock(m_mutex);
+			++m_finished;
+		}
+		m_batchDone.notify_all();
+	}
+}
+
+void ThreadPool::run(Task& _task)
+{
+	try
+	{
+		_task.function();
+	}
+	catch (...)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_exception || _task.index < m_failedIndex)
+		{
+			m_exception = current_exception();
+			m_failedIndex = _task.index;
+		}
+	}
+}
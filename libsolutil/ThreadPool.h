@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Fixed-size pool of worker threads that executes submitted tasks.
+ *
+ * Tasks are grouped into batches that are terminated by a call to @a waitAll.
+ * If any task of a batch throws, the exception of the task that was submitted first
+ * is rethrown from @a waitAll, so that error reporting does not depend on scheduling.
+ *
+ * A pool with at most one thread does not spawn any threads at all and runs every
+ * task on the calling thread at the time it is submitted. This keeps the behaviour
+ * of single-threaded builds (e.g. emscripten) identical to code not using the pool.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _threads);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the number of tasks that can run at the same time.
+	size_t size() const { return m_workers.empty() ? 1 : m_workers.size(); }
+
+	/// Schedules @a _task for execution as part of the current batch.
+	void submit(std::function<void()> _task);
+
+	/// Blocks until all tasks of the current batch have finished and starts a new batch.
+	/// Rethrows the exception of the earliest submitted task that failed, if any.
+	void waitAll();
+
+	/// Runs @a _function on every element of @a _range and waits for all of them to finish.
+	template <typename Range, typename Function>
+	void forEach(Range&& _range, Function&& _function)
+	{
+		for (auto&& element: _range)
+			submit([&_function, &element]() { _function(element); });
+		waitAll();
+	}
+
+private:
+	struct Task
+	{
+		size_t index = 0;
+		std::function<void()> function;
+	};
+
+	void work();
+	void run(Task& _task);
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::condition_variable m_batchDone;
+	std::deque<Task> m_queue;
+	/// Number of tasks of the current batch that have been submitted.
+	size_t m_submitted = 0;
+	/// Number of tasks of the current batch that have finished.
+	size_t m_finished = 0;
+	/// Index and exception of the earliest failing task of the current batch.
+	size_t m_failedIndex = 0;
+	std::exception_ptr m_exception;
+	bool m_shutdown = false;
+};
+
+}
@@ -26,13 +26,273 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos in @a _source, which is @a _pos
+/// itself if there is none.
+size_t parameterEnd(string_view _source, size_t _pos)
+{
+	while (_pos < _source.size() && isParameterCharacter(_source[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// @returns the name of the tag "<" + _prefix + name + ">" starting at @a _pos in @a _source
+/// and the position after the tag, if there is such a tag.
+optional<pair<string, size_t>> tagAt(string_view _source, size_t _pos, string_view _prefix)
+{
+	if (_source.substr(_pos + 1, _prefix.size()) != _prefix)
+		return nullopt;
+	size_t const nameStart = _pos + 1 + _prefix.size();
+	size_t const nameEnd = parameterEnd(_source, nameStart);
+	if (nameEnd == nameStart || nameEnd == _source.size() || _source[nameEnd] != '>')
+		return nullopt;
+	return make_pair(string(_source.substr(nameStart, nameEnd - nameStart)), nameEnd + 1);
+}
+
+}
+
+struct Whiskers::Template
+{
+	struct Node;
+	/// Sequence of nodes together with the template they were parsed from.
+	struct Sequence
+	{
+		string source;
+		vector<Node> nodes;
+	};
+	struct Node
+	{
+		enum class Kind { Text, Tag, List, Condition };
+		Kind kind;
+		/// The text for text nodes or the name of the parameter otherwise.
+		/// The name of a conditional string parameter starts with "+".
+		string value;
+		/// The repeated part of a list or the part used if a condition is true.
+		Sequence body;
+		/// The part used if a condition is false.
+		Sequence elseBody;
+	};
+
+	/// Looks up regular parameters in the parameters of the current list element first.
+	struct Parameters
+	{
+		string const* find(string const& _name) const
+		{
+			if (element)
+				if (auto it = element->find(_name); it != element->end())
+					return &it->second;
+			if (auto it = base.find(_name); it != base.end())
+				return &it->second;
+			return nullptr;
+		}
+
+		StringMap const& base;
+		StringMap const* element = nullptr;
+	};
+
+	explicit Template(string const& _template):
+		sequence(parseSequence(_template))
+	{
+		for (size_t pos = _template.find('<'); pos != string::npos; pos = _template.find('<', pos + 1))
+		{
+			size_t nameStart = pos + 1;
+			if (nameStart < _template.size() && string_view("?/#!").find(_template[nameStart]) != string_view::npos)
+				++nameStart;
+			if (nameStart < _template.size() && _template[nameStart] == '+')
+				++nameStart;
+			size_t const nameEnd = parameterEnd(_template, nameStart);
+			if (nameEnd != nameStart && nameEnd < _template.size() && _template[nameEnd] == '>')
+				tags.emplace(_template.substr(pos, nameEnd + 1 - pos));
+		}
+	}
+
+	/// Splits @a _source into text and elements. Like a regular expression search, this looks for
+	/// the first position at which an element starts and continues after its end; for lists and
+	/// conditions, the element ends at the first matching closing tag.
+	static Sequence parseSequence(string_view _source)
+	{
+		Sequence sequence{string(_source), {}};
+		size_t textStart = 0;
+		for (size_t pos = _source.find('<'); pos != string_view::npos; pos = _source.find('<', pos))
+		{
+			optional<pair<Node, size_t>> element = parseElement(_source, pos);
+			if (!element)
+			{
+				++pos;
+				continue;
+			}
+			if (pos > textStart)
+				sequence.nodes.emplace_back(Node{Node::Kind::Text, string(_source.substr(textStart, pos - textStart)), {}, {}});
+			sequence.nodes.emplace_back(move(element->first));
+			pos = textStart = element->second;
+		}
+		if (textStart < _source.size())
+			sequence.nodes.emplace_back(Node{Node::Kind::Text, string(_source.substr(textStart)), {}, {}});
+		return sequence;
+	}
+
+	/// @returns the element starting at @a _pos and the position after it, if there is one.
+	static optional<pair<Node, size_t>> parseElement(string_view _source, size_t _pos)
+	{
+		if (auto tag = tagAt(_source, _pos, ""))
+			return make_pair(Node{Node::Kind::Tag, move(tag->first), {}, {}}, tag->second);
+
+		if (auto list = tagAt(_source, _pos, "#"))
+		{
+			string const closingTag = "</" + list->first + ">";
+			size_t const end = _source.find(closingTag, list->second);
+			if (end != string_view::npos)
+				return make_pair(
+					Node{
+						Node::Kind::List,
+						move(list->first),
+						parseSequence(_source.substr(list->second, end - list->second)),
+						{}
+					},
+					end + closingTag.size()
+				);
+		}
+
+		optional<pair<string, size_t>> condition = tagAt(_source, _pos, "?");
+		if (!condition)
+			if ((condition = tagAt(_source, _pos, "?+")))
+				condition->first = "+" + condition->first;
+		if (condition)
+		{
+			string name = move(condition->first);
+			string const elseTag = "<!" + name + ">";
+			string const closingTag = "</" + name + ">";
+			size_t const bodyStart = condition->second;
+			size_t const end = _source.find(closingTag, bodyStart);
+			if (end != string_view::npos)
+			{
+				size_t const elsePos = _source.substr(0, end).find(elseTag, bodyStart);
+				size_t const bodyEnd = elsePos == string_view::npos ? end : elsePos;
+				size_t const elseStart = elsePos == string_view::npos ? end : elsePos + elseTag.size();
+				return make_pair(
+					Node{
+						Node::Kind::Condition,
+						move(name),
+						parseSequence(_source.substr(bodyStart, bodyEnd - bodyStart)),
+						parseSequence(_source.substr(elseStart, end - elseStart))
+					},
+					end + closingTag.size()
+				);
+			}
+		}
+
+		return nullopt;
+	}
+
+	static void render(
+		Sequence const& _sequence,
+		Parameters const& _parameters,
+		map<string, bool> const& _conditions,
+		StringListMap const& _listParameters,
+		string& _output
+	)
+	{
+		for (Node const& node: _sequence.nodes)
+			switch (node.kind)
+			{
+			case Node::Kind::Text:
+				_output += node.value;
+				break;
+			case Node::Kind::Tag:
+			{
+				string const* value = _parameters.find(node.value);
+				assertThrow(
+					value,
+					WhiskersError,
+					"Value for tag " + node.value + " not provided.\n" +
+					"Template:\n" +
+					_sequence.source
+				);
+				_output += *value;
+				break;
+			}
+			case Node::Kind::List:
+			{
+				auto list = _listParameters.find(node.value);
+				assertThrow(
+					list != _listParameters.end(),
+					WhiskersError, "List parameter " + node.value + " not set."
+				);
+				for (StringMap const& element: list->second)
+				{
+					for (auto const& parameter: element)
+						assertThrow(
+							!_parameters.find(parameter.first),
+							WhiskersError,
+							"Parameter collision"
+						);
+					// Lists cannot be nested.
+					render(node.body, Parameters{_parameters.base, &element}, _conditions, {}, _output);
+				}
+				break;
+			}
+			case Node::Kind::Condition:
+			{
+				bool conditionValue = false;
+				if (node.value[0] == '+')
+				{
+					string const tag = node.value.substr(1);
+					string const* value = _parameters.find(tag);
+					assertThrow(
+						value,
+						WhiskersError, "Tag " + tag + " used as condition but was not set."
+					);
+					conditionValue = !value->empty();
+				}
+				else
+				{
+					auto condition = _conditions.find(node.value);
+					assertThrow(
+						condition != _conditions.end(),
+						WhiskersError, "Condition parameter " + node.value + " not set."
+					);
+					conditionValue = condition->second;
+				}
+				render(
+					conditionValue ? node.body : node.elseBody,
+					_parameters,
+					_conditions,
+					_listParameters,
+					_output
+				);
+				break;
+			}
+			}
+	}
+
+	Sequence sequence;
+	/// All tags of the form "<" + prefix + name + ">" anywhere in the template.
+	set<string> tags;
+};
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(move(_template)),
+	m_parsedTemplate(parse(m_template))
 {
 }
 
@@ -71,14 +331,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	Template::render(m_parsedTemplate->sequence, Template::Parameters{m_parameters}, m_conditions, m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -109,122 +371,23 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_parsedTemplate->tags.count(tag),
 			WhiskersError,
 			"Tag '" + tag + "' not found in template:\n" + m_template
 		);
 	}
 }
 
-namespace
+shared_ptr<Whiskers::Template const> Whiskers::parse(string const& _template)
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
+	// The templates are string literals of the code generator, possibly combined from a few
+	// variants, so the cache stays small.
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
-				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
-				);
-				conditionValue = !_parameters.at(tag).empty();
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	lock_guard<mutex> lock(cacheMutex);
+	shared_ptr<Template const>& parsedTemplate = cache[_template];
+	if (!parsedTemplate)
+		parsedTemplate = make_shared<Template const>(_template);
+	return parsedTemplate;
 }
-
@@ -26,8 +26,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -66,6 +67,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once per process and the parsed form is shared between
+ * all instances created from the same template string.
  */
 class Whiskers
 {
@@ -77,7 +81,7 @@ public:
 
 	/// Sets a single regular parameter, <paramName>.
 	Whiskers& operator()(std::string _parameter, std::string _value);
-	Whiskers& operator()(std::string _parameter, char const* _value) { return (*this)(_parameter, std::string{_value}); }
+	Whiskers& operator()(std::string _parameter, char const* _value) { return (*this)(std::move(_parameter), std::string{_value}); }
 	/// Sets a condition parameter, <?paramName>...<!paramName>...</paramName>
 	Whiskers& operator()(std::string _parameter, bool _value);
 	/// Sets a list parameter, <#listName> </listName>.
@@ -100,19 +104,14 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
+	/// Parsed form of a template, defined in the implementation.
+	struct Template;
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed form of @a _template from a process-wide cache.
+	static std::shared_ptr<Template const> parse(std::string const& _template);
 
 	std::string m_template;
+	std::shared_ptr<Template const> m_parsedTemplate;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/XXHash.h>
+
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+
+uint64_t constexpr c_prime1 = 0x9E3779B185EBCA87ull;
+uint64_t constexpr c_prime2 = 0xC2B2AE3D27D4EB4Full;
+uint64_t constexpr c_prime3 = 0x165667B19E3779F9ull;
+uint64_t constexpr c_prime4 = 0x85EBCA77C2B2AE63ull;
+uint64_t constexpr c_prime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t rotateLeft(uint64_t _value, unsigned _bits)
+{
+	return (_value << _bits) | (_value >> (64 - _bits));
+}
+
+// The reference implementation reads the input in little endian byte order.
+// Big endian systems are not supported (see the top-level CMakeLists.txt).
+inline uint64_t read64(char const* _data)
+{
+	uint64_t value;
+	memcpy(&value, _data, sizeof(value));
+	return value;
+}
+
+inline uint64_t read32(char const* _data)
+{
+	uint32_t value;
+	memcpy(&value, _data, sizeof(value));
+	return value;
+}
+
+inline uint64_t round(uint64_t _accumulator, uint64_t _input)
+{
+	_accumulator += _input * c_prime2;
+	_accumulator = rotateLeft(_accumulator, 31);
+	return _accumulator * c_prime1;
+}
+
+inline uint64_t mergeRound(uint64_t _accumulator, uint64_t _value)
+{
+	_accumulator ^= round(0, _value);
+	return _accumulator * c_prime1 + c_prime4;
+}
+
+}
+
+uint64_t solidity::util::xxhash64(char const* _data, size_t _size, uint64_t _seed)
+{
+	char const* end = _data + _size;
+	uint64_t hash;
+
+	if (_size >= 32)
+	{
+		uint64_t v1 = _seed + c_prime1 + c_prime2;
+		uint64_t v2 = _seed + c_prime2;
+		uint64_t v3 = _seed;
+		uint64_t v4 = _seed - c_prime1;
+		for (; end - _data >= 32; _data += 32)
+		{
+			v1 = round(v1, read64(_data));
+			v2 = round(v2, read64(_data + 8));
+			v3 = round(v3, read64(_data + 16));
+			v4 = round(v4, read64(_data + 24));
+		}
+		hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+		hash = mergeRound(hash, v1);
+		hash = mergeRound(hash, v2);
+		hash = mergeRound(hash, v3);
+		hash = mergeRound(hash, v4);
+	}
+	else
+		hash = _seed + c_prime5;
+
+	hash += static_cast<uint64_t>(_size);
+
+	for (; end - _data >= 8; _data += 8)
+	{
+		hash ^= round(0, read64(_data));
+		hash = rotateLeft(hash, 27) * c_prime1 + c_prime4;
+	}
+	if (end - _data >= 4)
+	{
+		hash ^= read32(_data) * c_prime1;
+		hash = rotateLeft(hash, 23) * c_prime2 + c_prime3;
+		_data += 4;
+	}
+	for (; _data != end; ++_data)
+	{
+		hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*_data)) * c_prime5;
+		hash = rotateLeft(hash, 11) * c_prime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= c_prime2;
+	hash ^= hash >> 29;
+	hash *= c_prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
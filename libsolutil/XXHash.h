@@ -0,0 +1,41 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Non-cryptographic 64-bit hash function xxHash64.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/// Computes the xxHash64 hash of @a _size bytes at @a _data.
+/// This is a fast, non-cryptographic hash suitable for hash tables. The result is
+/// identical to the one of the reference implementation and does not depend on the platform.
+std::uint64_t xxhash64(char const* _data, std::size_t _size, std::uint64_t _seed = 0);
+
+inline std::uint64_t xxhash64(std::string_view _input, std::uint64_t _seed = 0)
+{
+	return xxhash64(_input.data(), _input.size(), _seed);
+}
+
+}
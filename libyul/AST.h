@@ -39,9 +39,16 @@ struct DebugData
 {
 	explicit DebugData(langutil::SourceLocation _location): location(std::move(_location)) {}
 	langutil::SourceLocation location;
+	/// @returns debug data for @a _location. Nodes without location share a single
+	/// instance, which avoids an allocation per node created by the optimiser.
 	static std::shared_ptr<DebugData const> create(langutil::SourceLocation _location = {})
 	{
-		return std::make_shared<DebugData const>(_location);
+		if (!_location.isValid())
+		{
+			static std::shared_ptr<DebugData const> const empty = std::make_shared<DebugData const>(_location);
+			return empty;
+		}
+		return std::make_shared<DebugData const>(std::move(_location));
 	}
 };
 
@@ -39,20 +39,24 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
-namespace
-{
-
-[[nodiscard]]
-shared_ptr<DebugData const> updateLocationEndFrom(
+shared_ptr<DebugData const> Parser::updateLocationEndFrom(
 	shared_ptr<DebugData const> const& _debugData,
 	langutil::SourceLocation const& _location
 )
 {
+	if (_debugData->location.end == _location.end)
+		return _debugData;
 	SourceLocation updatedLocation = _debugData->location;
 	updatedLocation.end = _location.end;
 	return make_shared<DebugData const>(updatedLocation);
 }
 
+YulString Parser::internName(string const& _name)
+{
+	auto it = m_names.find(_name);
+	if (it == m_names.end())
+		it = m_names.emplace(_name, YulString{_name}).first;
+	return it->second;
 }
 
 unique_ptr<Block> Parser::parse(std::shared_ptr<Scanner> const& _scanner, bool _reuseScanner)
@@ -295,7 +299,7 @@ variant<Literal, Identifier> Parser::parseLiteralOrIdentifier()
 	{
 	case Token::Identifier:
 	{
-		Identifier identifier{DebugData::create(currentLocation()), YulString{currentLiteral()}};
+		Identifier identifier{createDebugData(), internName(currentLiteral())};
 		advance();
 		return identifier;
 	}
@@ -326,9 +330,9 @@ variant<Literal, Identifier> Parser::parseLiteralOrIdentifier()
 		}
 
 		Literal literal{
-			DebugData::create(currentLocation()),
+			createDebugData(),
 			kind,
-			YulString{currentLiteral()},
+			internName(currentLiteral()),
 			kind == LiteralKind::Boolean ? m_dialect.boolType : m_dialect.defaultType
 		};
 		advance();
@@ -467,7 +471,7 @@ TypedName Parser::parseTypedName()
 
 YulString Parser::expectAsmIdentifier()
 {
-	YulString name{currentLiteral()};
+	YulString name = internName(currentLiteral());
 	if (currentToken() == Token::Identifier && m_dialect.builtin(name))
 		fatalParserError(5568_error, "Cannot use builtin function name \"" + name.str() + "\" as identifier name.");
 	// NOTE: We keep the expectation here to ensure the correct source location for the error above.
@@ -495,6 +499,21 @@ void Parser::checkBreakContinuePosition(string const& _which)
 
 bool Parser::isValidNumberLiteral(string const& _literal)
 {
+	// Literals that obviously fit into 256 bits do not need to be converted.
+	if (boost::starts_with(_literal, "0x"))
+	{
+		if (_literal.size() > 2 && _literal.size() <= 66 && all_of(_literal.begin() + 2, _literal.end(), ::isxdigit))
+			return true;
+	}
+	// A leading zero would make the conversion below interpret the literal as octal.
+	else if (
+		!_literal.empty() &&
+		_literal.size() <= 77 &&
+		(_literal.front() != '0' || _literal.size() == 1) &&
+		all_of(_literal.begin(), _literal.end(), ::isdigit)
+	)
+		return true;
+
 	try
 	{
 		// Try to convert _literal to u256.
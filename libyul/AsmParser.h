@@ -23,7 +23,7 @@
 
 #pragma once
 
-#include <libyul/ASTForward.h>
+#include <libyul/AST.h>
 #include <libyul/Dialect.h>
 
 #include <liblangutil/SourceLocation.h>
@@ -31,6 +31,8 @@
 #include <liblangutil/ParserBase.h>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -53,7 +55,10 @@ public:
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
 		m_locationOverride(std::move(_locationOverride))
-	{}
+	{
+		if (m_locationOverride)
+			m_debugDataOverride = DebugData::create(*m_locationOverride);
+	}
 
 	/// Parses an inline assembly block starting with `{` and ending with `}`.
 	/// @param _reuseScanner if true, do check for end of input after the `}`.
@@ -70,10 +75,26 @@ protected:
 	template <class T> T createWithLocation() const
 	{
 		T r;
-		r.debugData = DebugData::create(currentLocation());
+		r.debugData = createDebugData();
 		return r;
 	}
 
+	/// @returns debug data with the current source location. All nodes share the same
+	/// instance if the location is overridden.
+	std::shared_ptr<DebugData const> createDebugData() const
+	{
+		return m_debugDataOverride ? m_debugDataOverride : DebugData::create(currentLocation());
+	}
+	/// @returns @a _debugData with the end of its location set to the end of @a _location.
+	/// Only allocates new debug data if the end actually changes.
+	static std::shared_ptr<DebugData const> updateLocationEndFrom(
+		std::shared_ptr<DebugData const> const& _debugData,
+		langutil::SourceLocation const& _location
+	);
+	/// @returns the YulString of @a _name. Names are interned once per parser, which avoids
+	/// locking the string repository for every occurrence of an identifier.
+	YulString internName(std::string const& _name);
+
 	Block parseBlock();
 	Statement parseStatement();
 	Case parseCase();
@@ -97,6 +118,8 @@ protected:
 private:
 	Dialect const& m_dialect;
 	std::optional<langutil::SourceLocation> m_locationOverride;
+	std::shared_ptr<DebugData const> m_debugDataOverride;
+	std::unordered_map<std::string, YulString> m_names;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
 };
@@ -28,10 +28,7 @@
 
 #include <libsolutil/CommonData.h>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/replace.hpp>
-
-#include <range/v3/view/transform.hpp>
+#include <libsolutil/Visitor.h>
 
 #include <memory>
 #include <functional>
@@ -68,111 +65,58 @@ string AsmPrinter::operator()(Identifier const& _identifier) const
 
 string AsmPrinter::operator()(ExpressionStatement const& _statement) const
 {
-	return std::visit(*this, _statement.expression);
+	string out;
+	appendNode(out, _statement.expression);
+	return out;
 }
 
 string AsmPrinter::operator()(Assignment const& _assignment) const
 {
-	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
-	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
-	return variables + " := " + std::visit(*this, *_assignment.value);
+	string out;
+	appendNode(out, _assignment);
+	return out;
 }
 
 string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) const
 {
-	string out = "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	if (_variableDeclaration.value)
-	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
-	}
+	string out;
+	appendNode(out, _variableDeclaration);
 	return out;
 }
 
 string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) const
 {
-	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
-	string out = "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
-	if (!_functionDefinition.returnVariables.empty())
-	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | ranges::views::transform(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
-	}
-
-	return out + "\n" + (*this)(_functionDefinition.body);
+	string out;
+	appendNode(out, _functionDefinition, 0);
+	return out;
 }
 
 string AsmPrinter::operator()(FunctionCall const& _functionCall) const
 {
-	return
-		(*this)(_functionCall.functionName) + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	string out;
+	appendNode(out, _functionCall);
+	return out;
 }
 
 string AsmPrinter::operator()(If const& _if) const
 {
-	yulAssert(_if.condition, "Invalid if condition.");
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-	return "if " + std::visit(*this, *_if.condition) + delim + (*this)(_if.body);
+	string out;
+	appendNode(out, _if, 0);
+	return out;
 }
 
 string AsmPrinter::operator()(Switch const& _switch) const
 {
-	yulAssert(_switch.expression, "Invalid expression pointer.");
-	string out = "switch " + std::visit(*this, *_switch.expression);
-	for (auto const& _case: _switch.cases)
-	{
-		if (!_case.value)
-			out += "\ndefault ";
-		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
-	}
+	string out;
+	appendNode(out, _switch, 0);
 	return out;
 }
 
 string AsmPrinter::operator()(ForLoop const& _forLoop) const
 {
-	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
-	)
-		delim = ' ';
-	return
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
+	string out;
+	appendNode(out, _forLoop, 0);
+	return out;
 }
 
 string AsmPrinter::operator()(Break const&) const
@@ -192,18 +136,203 @@ string AsmPrinter::operator()(Leave const&) const
 
 string AsmPrinter::operator()(Block const& _block) const
 {
-	if (_block.statements.empty())
-		return "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return "{ " + body + " }";
+	string out;
+	appendBlock(out, _block, 0);
+	return out;
+}
+
+void AsmPrinter::append(string& _out, Block const& _block, size_t _indentation) const
+{
+	appendBlock(_out, _block, _indentation);
+}
+
+namespace
+{
+
+void newLine(string& _out, size_t _indentation)
+{
+	_out += '\n';
+	_out.append(_indentation, ' ');
+}
+
+}
+
+void AsmPrinter::appendNode(string& _out, Expression const& _expression) const
+{
+	if (FunctionCall const* functionCall = get_if<FunctionCall>(&_expression))
+		appendNode(_out, *functionCall);
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		_out += (*this)(*identifier);
 	else
+		_out += (*this)(get<Literal>(_expression));
+}
+
+void AsmPrinter::appendNode(string& _out, FunctionCall const& _functionCall) const
+{
+	_out += (*this)(_functionCall.functionName);
+	_out += '(';
+	for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+	{
+		if (i > 0)
+			_out += ", ";
+		appendNode(_out, _functionCall.arguments[i]);
+	}
+	_out += ')';
+}
+
+void AsmPrinter::appendNode(string& _out, Statement const& _statement, size_t _indentation) const
+{
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement const& _expressionStatement) { appendNode(_out, _expressionStatement.expression); },
+		[&](Assignment const& _assignment) { appendNode(_out, _assignment); },
+		[&](VariableDeclaration const& _variableDeclaration) { appendNode(_out, _variableDeclaration); },
+		[&](FunctionDefinition const& _functionDefinition) { appendNode(_out, _functionDefinition, _indentation); },
+		[&](If const& _if) { appendNode(_out, _if, _indentation); },
+		[&](Switch const& _switch) { appendNode(_out, _switch, _indentation); },
+		[&](ForLoop const& _forLoop) { appendNode(_out, _forLoop, _indentation); },
+		[&](Block const& _block) { appendBlock(_out, _block, _indentation); },
+		[&](auto const& _other) { _out += (*this)(_other); }
+	}, _statement);
+}
+
+void AsmPrinter::appendNode(string& _out, Assignment const& _assignment) const
+{
+	yulAssert(_assignment.variableNames.size() >= 1, "");
+	_out += (*this)(_assignment.variableNames.front());
+	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
+	{
+		_out += ", ";
+		_out += (*this)(_assignment.variableNames[i]);
+	}
+	_out += " := ";
+	appendNode(_out, *_assignment.value);
+}
+
+void AsmPrinter::appendNode(string& _out, VariableDeclaration const& _variableDeclaration) const
+{
+	_out += "let ";
+	appendTypedNames(_out, _variableDeclaration.variables);
+	if (_variableDeclaration.value)
+	{
+		_out += " := ";
+		appendNode(_out, *_variableDeclaration.value);
+	}
+}
+
+void AsmPrinter::appendNode(string& _out, FunctionDefinition const& _functionDefinition, size_t _indentation) const
+{
+	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
+	_out += "function ";
+	_out += _functionDefinition.name.str();
+	_out += '(';
+	appendTypedNames(_out, _functionDefinition.parameters);
+	_out += ')';
+	if (!_functionDefinition.returnVariables.empty())
+	{
+		_out += " -> ";
+		appendTypedNames(_out, _functionDefinition.returnVariables);
+	}
+	newLine(_out, _indentation);
+	appendBlock(_out, _functionDefinition.body, _indentation);
+}
+
+void AsmPrinter::appendNode(string& _out, If const& _if, size_t _indentation) const
+{
+	yulAssert(_if.condition, "Invalid if condition.");
+	_out += "if ";
+	appendNode(_out, *_if.condition);
+	// The body is separated by a space instead if it fits on the line.
+	size_t const delimiter = _out.size();
+	newLine(_out, _indentation);
+	size_t const bodyStart = _out.size();
+	if (appendBlock(_out, _if.body, _indentation))
+		_out.replace(delimiter, bodyStart - delimiter, " ");
+}
+
+void AsmPrinter::appendNode(string& _out, Switch const& _switch, size_t _indentation) const
+{
+	yulAssert(_switch.expression, "Invalid expression pointer.");
+	_out += "switch ";
+	appendNode(_out, *_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		newLine(_out, _indentation);
+		if (!_case.value)
+			_out += "default ";
+		else
+		{
+			_out += "case ";
+			_out += (*this)(*_case.value);
+			_out += ' ';
+		}
+		appendBlock(_out, _case.body, _indentation);
+	}
+}
+
+void AsmPrinter::appendNode(string& _out, ForLoop const& _forLoop, size_t _indentation) const
+{
+	yulAssert(_forLoop.condition, "Invalid for loop condition.");
+	_out += "for ";
+	size_t const preStart = _out.size();
+	bool singleLine = appendBlock(_out, _forLoop.pre, _indentation);
+	size_t const conditionDelimiter = _out.size();
+	newLine(_out, _indentation);
+	size_t const conditionStart = _out.size();
+	appendNode(_out, *_forLoop.condition);
+	size_t const postDelimiter = _out.size();
+	newLine(_out, _indentation);
+	size_t const postStart = _out.size();
+	singleLine = appendBlock(_out, _forLoop.post, _indentation) && singleLine;
+	// The header is written on a single line if it is short.
+	size_t const headerSize =
+		(conditionDelimiter - preStart) +
+		(postDelimiter - conditionStart) +
+		(_out.size() - postStart);
+	if (singleLine && headerSize < 60)
+	{
+		_out.replace(postDelimiter, postStart - postDelimiter, " ");
+		_out.replace(conditionDelimiter, conditionStart - conditionDelimiter, " ");
+	}
+	newLine(_out, _indentation);
+	appendBlock(_out, _forLoop.body, _indentation);
+}
+
+bool AsmPrinter::appendBlock(string& _out, Block const& _block, size_t _indentation) const
+{
+	if (_block.statements.empty())
+	{
+		_out += "{ }";
+		return true;
+	}
+	size_t const start = _out.size();
+	_out += '{';
+	newLine(_out, _indentation + 4);
+	size_t const bodyStart = _out.size();
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		if (i > 0)
+			newLine(_out, _indentation + 4);
+		appendNode(_out, _block.statements[i], _indentation + 4);
+	}
+	// Short blocks with a single line are written on the line of the braces.
+	if (_out.size() - bodyStart < 30 && _out.find('\n', bodyStart) == string::npos)
+	{
+		_out.replace(start, bodyStart - start, "{ ");
+		_out += " }";
+		return true;
+	}
+	newLine(_out, _indentation);
+	_out += '}';
+	return false;
+}
+
+void AsmPrinter::appendTypedNames(string& _out, vector<TypedName> const& _names) const
+{
+	for (size_t i = 0; i < _names.size(); ++i)
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return "{\n    " + body + "\n}";
+		if (i > 0)
+			_out += ", ";
+		_out += formatTypedName(_names[i]);
 	}
 }
 
@@ -27,6 +27,9 @@
 
 #include <libyul/YulString.h>
 
+#include <string>
+#include <vector>
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -35,6 +38,10 @@ struct Dialect;
  * Converts a parsed Yul AST into readable string representation.
  * Ignores source locations.
  * If a dialect is provided, the dialect's default type is omitted.
+ *
+ * Statements are written into a single output string with the indentation of their
+ * nesting level, instead of indenting the representation of each block again in the
+ * enclosing blocks.
  */
 class AsmPrinter
 {
@@ -57,7 +64,26 @@ public:
 	std::string operator()(Leave const& _continue) const;
 	std::string operator()(Block const& _block) const;
 
+	/// Appends the representation of @a _block to @a _out, indenting all its lines but
+	/// the first by @a _indentation spaces.
+	void append(std::string& _out, Block const& _block, size_t _indentation = 0) const;
+
 private:
+	/// Appends the representation of a node to @a _out, continuing the current line, which
+	/// is indented by @a _indentation spaces.
+	void appendNode(std::string& _out, Expression const& _expression) const;
+	void appendNode(std::string& _out, FunctionCall const& _functionCall) const;
+	void appendNode(std::string& _out, Statement const& _statement, size_t _indentation) const;
+	void appendNode(std::string& _out, Assignment const& _assignment) const;
+	void appendNode(std::string& _out, VariableDeclaration const& _variableDeclaration) const;
+	void appendNode(std::string& _out, FunctionDefinition const& _functionDefinition, size_t _indentation) const;
+	void appendNode(std::string& _out, If const& _if, size_t _indentation) const;
+	void appendNode(std::string& _out, Switch const& _switch, size_t _indentation) const;
+	void appendNode(std::string& _out, ForLoop const& _forLoop, size_t _indentation) const;
+	/// @returns true if the block was written on a single line.
+	bool appendBlock(std::string& _out, Block const& _block, size_t _indentation) const;
+	void appendTypedNames(std::string& _out, std::vector<TypedName> const& _names) const;
+
 	std::string formatTypedName(TypedName _variable) const;
 	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
 
@@ -35,12 +35,16 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
+
 #include <optional>
 
 using namespace std;
@@ -50,6 +54,16 @@ using namespace solidity::langutil;
 
 namespace
 {
+
+/// Sets the analysis information of @a _object and its sub-objects, which have to be valid.
+void analyzeOptimized(Object& _object, Dialect const& _dialect)
+{
+	_object.analysisInfo = make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object));
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			analyzeOptimized(*subObject, _dialect);
+}
+
 Dialect const& languageToDialect(AssemblyStack::Language _language, EVMVersion _version)
 {
 	switch (_language)
@@ -89,6 +103,17 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::useAnalyzedObject(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "");
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -98,8 +123,10 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	optimize(*m_parserResult, true, m_parallelism);
+	// The optimiser suite analyses every object it optimised and asserts that the code is valid,
+	// so the analysis info of the whole object tree is up to date.
+	m_analysisSuccessful = true;
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -146,7 +173,7 @@ bool AssemblyStack::analyzeParsed(Object& _object)
 	return success;
 }
 
-void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
+void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize, bool _optimizeStackLayout) const
 {
 	EVMDialect const* dialect = nullptr;
 	switch (m_language)
@@ -163,21 +190,47 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) cons
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, _optimizeStackLayout);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(Object& _object, bool _isCreation, size_t _parallelism)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+	vector<pair<Object*, util::h256>> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+		{
+			util::h256 cacheKey;
+			if (m_objectCache)
+			{
+				cacheKey = objectCacheKey(*subObject, false);
+				if (shared_ptr<Object> cached = m_objectCache->find(cacheKey))
+				{
+					analyzeOptimized(*cached, languageToDialect(m_language, m_evmVersion));
+					subNode = move(cached);
+					continue;
+				}
+			}
+			subObjects.emplace_back(subObject, cacheKey);
+		}
+
+	// The sub-objects (e.g. the deployed code and the contracts created via ``new``)
+	// are optimized independently of each other and of their parent.
+	size_t subObjectParallelism = max<size_t>(1, _parallelism / max<size_t>(1, subObjects.size()));
+	util::ThreadPool{min(_parallelism, subObjects.size())}.forEach(subObjects, [&](auto const& _subObject) {
+		optimize(*_subObject.first, false, subObjectParallelism);
+		if (m_objectCache)
+			m_objectCache->insert(_subObject.second, *_subObject.first);
+	});
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
+	map<YulString, size_t> functionExecutionsPerDeployment;
+	for (auto const& [name, executions]: m_functionExecutionsPerDeployment)
+		functionExecutionsPerDeployment[YulString{name}] = executions;
 	OptimiserSuite::run(
 		dialect,
 		meter.get(),
@@ -185,10 +238,36 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		m_optimiserSettings.optimizeStackAllocation,
 		m_optimiserSettings.yulOptimiserSteps,
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		_parallelism,
+		functionExecutionsPerDeployment,
+		m_objectCache ? &m_objectCache->functionCache() : nullptr
 	);
 }
 
+util::h256 AssemblyStack::objectCacheKey(Object const& _object, bool _isCreation) const
+{
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	string key = _object.toString(&dialect) + (_isCreation ? "\ncreation" : "\nruntime");
+	// Only the executions of the functions contained in the object affect its optimization.
+	if (!_isCreation && !m_functionExecutionsPerDeployment.empty())
+	{
+		set<YulString> names;
+		auto collectNames = [&](Object const& _subObject, auto const& _recurse) -> void {
+			set<YulString> const& codeNames = NameCollector{*_subObject.code}.names();
+			names.insert(codeNames.begin(), codeNames.end());
+			for (auto const& subNode: _subObject.subObjects)
+				if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+					_recurse(*subObject, _recurse);
+		};
+		collectNames(_object, collectNames);
+		for (auto const& [name, executions]: m_functionExecutionsPerDeployment)
+			if (names.count(YulString{name}))
+				key += "\n" + name + ": " + to_string(executions);
+	}
+	return util::keccak256(key);
+}
+
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 {
 	yulAssert(m_analysisSuccessful, "");
@@ -217,7 +296,10 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 	return MachineAssemblyObject();
 }
 
-std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleWithDeployed(optional<string_view> _deployName) const
+std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleWithDeployed(
+	optional<string_view> _deployName,
+	bool _withAssemblyText
+) const
 {
 	yulAssert(m_analysisSuccessful, "");
 	yulAssert(m_parserResult, "");
@@ -226,18 +308,32 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 
 	evmasm::Assembly assembly;
 	EthAssemblyAdapter adapter(assembly);
-	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
+	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation, m_optimiserSettings.optimizeStackLayout);
+	if (m_optimiserSettings.runColdCodeMover)
+	{
+		// The assembly generated from Yul is not optimised otherwise, so only move the cold code
+		// and remove the jump destinations that are no longer used.
+		evmasm::Assembly::OptimiserSettings settings;
+		settings.runJumpdestRemover = true;
+		settings.runColdCodeMover = true;
+		settings.evmVersion = m_evmVersion;
+		settings.parallelism = m_parallelism;
+		assembly.optimise(settings);
+	}
 
 	MachineAssemblyObject creationObject;
-	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble());
+	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble(m_parallelism));
 	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
-	creationObject.assembly = assembly.assemblyString();
-	creationObject.sourceMappings = make_unique<string>(
-		evmasm::AssemblyItem::computeSourceMapping(
-			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-		)
-	);
+	if (_withAssemblyText)
+	{
+		creationObject.assembly = assembly.assemblyString();
+		creationObject.sourceMappings = make_unique<string>(
+			evmasm::AssemblyItem::computeSourceMapping(
+				assembly.items(),
+				{{m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "", 0}}
+			)
+		);
+	}
 
 	MachineAssemblyObject deployedObject;
 	optional<size_t> subIndex;
@@ -261,14 +357,17 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 	if (subIndex.has_value())
 	{
 		evmasm::Assembly& runtimeAssembly = assembly.sub(*subIndex);
-		deployedObject.bytecode = make_shared<evmasm::LinkerObject>(runtimeAssembly.assemble());
-		deployedObject.assembly = runtimeAssembly.assemblyString();
-		deployedObject.sourceMappings = make_unique<string>(
-			evmasm::AssemblyItem::computeSourceMapping(
-				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-			)
-		);
+		deployedObject.bytecode = make_shared<evmasm::LinkerObject>(runtimeAssembly.assemble(m_parallelism));
+		if (_withAssemblyText)
+		{
+			deployedObject.assembly = runtimeAssembly.assemblyString();
+			deployedObject.sourceMappings = make_unique<string>(
+				evmasm::AssemblyItem::computeSourceMapping(
+					runtimeAssembly.items(),
+					{{m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "", 0}}
+				)
+			);
+		}
 	}
 
 	return {std::move(creationObject), std::move(deployedObject)};
@@ -27,11 +27,13 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/OptimizedObjectCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -79,6 +81,29 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Uses @a _object instead of parsing source code. It has to be the result of parsing and
+	/// analyzing (and possibly optimizing) in a stack for the same language and EVM version.
+	/// The object is modified by subsequent steps. Multiple calls overwrite the previous state.
+	void useAnalyzedObject(std::shared_ptr<Object> _object);
+
+	/// Sets the number of threads the optimizer can use to apply its function-local steps
+	/// to the individual functions. The result does not depend on this setting.
+	void setParallelism(size_t _jobs) { m_parallelism = _jobs; }
+
+	/// Sets the expected number of executions per deployment of the functions with the given
+	/// names, which the optimizer uses for them instead of the setting in the optimiser settings.
+	/// Only applies to runtime code.
+	void setFunctionExecutionsPerDeployment(std::map<std::string, size_t> _executions)
+	{
+		m_functionExecutionsPerDeployment = std::move(_executions);
+	}
+
+	/// Sets a cache of optimized sub-objects shared with the stacks of other contracts, so that
+	/// sub-objects contained in several of them are only optimized once and the results of the
+	/// function-local optimiser steps on their functions are reused. @a _cache may only be
+	/// shared by stacks for the same language, EVM version and optimiser settings.
+	void setObjectCache(std::shared_ptr<OptimizedObjectCache> _cache) { m_objectCache = std::move(_cache); }
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -98,8 +123,13 @@ public:
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// In addition to the value returned by @a assemble, returns
 	/// a second object that is the runtime code.
+	/// If @a _withAssemblyText is false, the assembly text and the source mappings of the
+	/// objects are not generated.
 	/// Only available for EVM.
-	std::pair<MachineAssemblyObject, MachineAssemblyObject> assembleWithDeployed(std::optional<std::string_view> _deployeName = {}) const;
+	std::pair<MachineAssemblyObject, MachineAssemblyObject> assembleWithDeployed(
+		std::optional<std::string_view> _deployeName = {},
+		bool _withAssemblyText = true
+	) const;
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
 	langutil::ErrorList const& errors() const { return m_errors; }
@@ -114,13 +144,21 @@ private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
 
-	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
+	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize, bool _optimizeStackLayout) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes the sub-objects of @a _object concurrently, sharing the @a _parallelism
+	/// threads among them, and @a _object itself afterwards. Sub-objects found in the object
+	/// cache are replaced by the cached result instead.
+	void optimize(yul::Object& _object, bool _isCreation, size_t _parallelism);
+	/// @returns the key of the result of optimizing @a _object in the object cache.
+	util::h256 objectCacheKey(yul::Object const& _object, bool _isCreation) const;
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	size_t m_parallelism = 1;
+	std::map<std::string, size_t> m_functionExecutionsPerDeployment;
+	std::shared_ptr<OptimizedObjectCache> m_objectCache;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
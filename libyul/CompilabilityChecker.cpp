@@ -26,11 +26,80 @@
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/NameCollector.h>
+
+#include <libyul/AST.h>
+
+#include <range/v3/view/drop.hpp>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns a copy of @a _object whose code only consists of the function @a _function
+/// (or the outermost block if @a _function is empty) and of functions with empty bodies
+/// in place of the functions it calls.
+Object reducedObject(Object const& _object, YulString _function)
+{
+	yulAssert(
+		_object.code &&
+		!_object.code->statements.empty() &&
+		holds_alternative<Block>(_object.code->statements.front()),
+		"Need to run the function grouper first."
+	);
+
+	Object reduced;
+	reduced.name = _object.name;
+	reduced.subObjects = _object.subObjects;
+	reduced.subIndexByName = _object.subIndexByName;
+	reduced.code = make_shared<Block>();
+	reduced.code->debugData = _object.code->debugData;
+
+	map<YulString, FunctionDefinition const*> functions;
+	for (auto const& statement: _object.code->statements | ranges::views::drop(1))
+	{
+		auto const& function = std::get<FunctionDefinition>(statement);
+		functions[function.name] = &function;
+	}
+
+	map<YulString, size_t> references;
+	if (_function.empty())
+	{
+		Block const& outermostBlock = std::get<Block>(_object.code->statements.front());
+		references = ReferencesCounter::countReferences(outermostBlock, ReferencesCounter::VariablesAndFunctions);
+		reduced.code->statements.emplace_back(ASTCopier{}.translate(outermostBlock));
+	}
+	else
+	{
+		FunctionDefinition const* function = functions.at(_function);
+		references = ReferencesCounter::countReferences(*function, ReferencesCounter::VariablesAndFunctions);
+		reduced.code->statements.emplace_back(Block{_object.code->debugData, {}});
+		reduced.code->statements.emplace_back(ASTCopier{}(*function));
+	}
+
+	// Calls only depend on the signature of the called function.
+	for (auto const& [name, count]: references)
+		if (name != _function && functions.count(name))
+		{
+			FunctionDefinition const* callee = functions.at(name);
+			reduced.code->statements.emplace_back(FunctionDefinition{
+				callee->debugData,
+				callee->name,
+				callee->parameters,
+				callee->returnVariables,
+				Block{callee->debugData, {}}
+			});
+		}
+	return reduced;
+}
+
+}
+
 CompilabilityChecker::CompilabilityChecker(
 	Dialect const& _dialect,
 	Object const& _object,
@@ -39,7 +108,7 @@ CompilabilityChecker::CompilabilityChecker(
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
-		NoOutputEVMDialect noOutputDialect(*evmDialect);
+		NoOutputEVMDialect const& noOutputDialect = NoOutputEVMDialect::instance(*evmDialect);
 
 		yul::AsmAnalysisInfo analysisInfo =
 			yul::AsmAnalyzer::analyzeStrictAssertCorrect(noOutputDialect, _object);
@@ -69,3 +138,18 @@ CompilabilityChecker::CompilabilityChecker(
 		}
 	}
 }
+
+CompilabilityChecker::CompilabilityChecker(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	YulString _function
+):
+	CompilabilityChecker(_dialect, reducedObject(_object, _function), _optimizeStackAllocation)
+{
+	// The functions replacing the called ones keep their signature, which can be too large on its own.
+	for (auto it = stackDeficit.begin(); it != stackDeficit.end();)
+		it = it->first == _function ? next(it) : stackDeficit.erase(it);
+	for (auto it = unreachableVariables.begin(); it != unreachableVariables.end();)
+		it = it->first == _function ? next(it) : unreachableVariables.erase(it);
+}
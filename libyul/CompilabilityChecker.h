@@ -45,6 +45,16 @@ namespace solidity::yul
 struct CompilabilityChecker
 {
 	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	/// Only checks the function @a _function, or the outermost block if @a _function is empty.
+	/// Since functions are compiled independently of each other, the result for that code is the
+	/// same as when checking the whole object. Only reports the stack deficit and unreachable
+	/// variables of that code. Requires the code to be grouped by the FunctionGrouper.
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		YulString _function
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
 };
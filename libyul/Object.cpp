@@ -28,7 +28,6 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/replace.hpp>
 
 using namespace std;
 using namespace solidity;
@@ -38,11 +37,27 @@ using namespace solidity::util;
 namespace
 {
 
-string indent(std::string const& _input)
+/// Appends the representation of @a _object to @a _out, indenting all its lines but the first
+/// by @a _indentation spaces.
+void appendObject(string& _out, Object const& _object, Dialect const* _dialect, size_t _indentation)
 {
-	if (_input.empty())
-		return _input;
-	return boost::replace_all_copy("    " + _input, "\n", "\n    ");
+	yulAssert(_object.code, "No code");
+	_out += "object \"" + _object.name.str() + "\" {\n";
+	_out.append(_indentation + 4, ' ');
+	_out += "code ";
+	(_dialect ? AsmPrinter{*_dialect} : AsmPrinter{}).append(_out, *_object.code, _indentation + 4);
+	for (auto const& subNode: _object.subObjects)
+	{
+		_out += '\n';
+		_out.append(_indentation + 4, ' ');
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			appendObject(_out, *subObject, _dialect, _indentation + 4);
+		else
+			_out += subNode->toString(_dialect);
+	}
+	_out += '\n';
+	_out.append(_indentation, ' ');
+	_out += '}';
 }
 
 }
@@ -54,13 +69,9 @@ string Data::toString(Dialect const*) const
 
 string Object::toString(Dialect const* _dialect) const
 {
-	yulAssert(code, "No code");
-	string inner = "code " + (_dialect ? AsmPrinter{*_dialect} : AsmPrinter{})(*code);
-
-	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_dialect);
-
-	return "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	string out;
+	appendObject(out, *this, _dialect, 0);
+	return out;
 }
 
 set<YulString> Object::qualifiedDataNames() const
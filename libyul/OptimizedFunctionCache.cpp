@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/OptimizedFunctionCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/AsmPrinter.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+string OptimizedFunctionCache::key(
+	Dialect const& _dialect,
+	string const& _step,
+	Block const& _part,
+	InterproceduralInformation const& _information,
+	optional<size_t> _expectedExecutionsPerDeployment
+)
+{
+	string key = _step + "\n";
+	key += _expectedExecutionsPerDeployment ? to_string(*_expectedExecutionsPerDeployment) : "creation";
+	key += _information.containsMSize ? " msize\n" : "\n";
+	for (auto const& [function, sideEffects]: _information.functionSideEffects)
+	{
+		key += function.str() + ":";
+		for (bool flag: {
+			sideEffects.movable,
+			sideEffects.movableApartFromEffects,
+			sideEffects.canBeRemoved,
+			sideEffects.canBeRemovedIfNoMSize,
+			sideEffects.cannotLoop
+		})
+			key += flag ? '1' : '0';
+		for (SideEffects::Effect effect: {sideEffects.otherState, sideEffects.storage, sideEffects.memory})
+			key += to_string(static_cast<int>(effect));
+		key += "\n";
+	}
+	AsmPrinter{_dialect}.append(key, _part);
+	return key;
+}
+
+optional<Block> OptimizedFunctionCache::find(string const& _key) const
+{
+	shared_ptr<Block const> part;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_parts.find(_key);
+		if (it == m_parts.end())
+			return nullopt;
+		part = it->second;
+	}
+	return ASTCopier{}.translate(*part);
+}
+
+void OptimizedFunctionCache::insert(string _key, Block const& _part)
+{
+	auto part = make_shared<Block const>(ASTCopier{}.translate(_part));
+	lock_guard<mutex> lock(m_mutex);
+	m_parts.emplace(move(_key), move(part));
+}
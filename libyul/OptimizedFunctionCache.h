@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the results of function-local optimiser steps on individual functions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+/**
+ * Results of applying function-local optimiser steps to the parts of an AST, i.e. to single
+ * function definitions or to the code outside of functions, so that a function contained in
+ * several objects, like most utility functions, is only transformed once by every step.
+ *
+ * The key of a result consists of the name of the step, the code of the part including all
+ * names, since the result of many steps depends on them, and everything else a function-local
+ * step can depend on: the side-effects of the called functions, whether the AST contains msize
+ * and the expected number of executions. Debug data is not taken into account.
+ *
+ * The cache keeps its own copies of the code, which are never modified. Can only be shared
+ * by optimiser suites for the same dialect. Can be used from several threads.
+ */
+class OptimizedFunctionCache
+{
+public:
+	/// @returns the key of the result of applying the step with name @a _step to @a _part.
+	static std::string key(
+		Dialect const& _dialect,
+		std::string const& _step,
+		Block const& _part,
+		InterproceduralInformation const& _information,
+		std::optional<size_t> _expectedExecutionsPerDeployment
+	);
+
+	/// @returns a copy of the code stored under @a _key, if any.
+	std::optional<Block> find(std::string const& _key) const;
+	/// Stores a copy of @a _part under @a _key, unless there already is code.
+	void insert(std::string _key, Block const& _part);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Block const>> m_parts;
+};
+
+}
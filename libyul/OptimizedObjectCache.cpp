@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/OptimizedObjectCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/AST.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+shared_ptr<Object> OptimizedObjectCache::find(util::h256 const& _key) const
+{
+	shared_ptr<Object const> object;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_objects.find(_key);
+		if (it == m_objects.end())
+			return nullptr;
+		object = it->second;
+	}
+	return copy(*object);
+}
+
+void OptimizedObjectCache::insert(util::h256 const& _key, Object const& _object)
+{
+	shared_ptr<Object const> object = copy(_object);
+	lock_guard<mutex> lock(m_mutex);
+	m_objects.emplace(_key, move(object));
+}
+
+shared_ptr<Object> OptimizedObjectCache::copy(Object const& _object)
+{
+	auto result = make_shared<Object>();
+	result->name = _object.name;
+	result->subId = _object.subId;
+	result->code = make_shared<Block>(ASTCopier{}.translate(*_object.code));
+	result->subIndexByName = _object.subIndexByName;
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			result->subObjects.emplace_back(copy(*subObject));
+		else
+			result->subObjects.emplace_back(subNode);
+	return result;
+}
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of optimized Yul objects, shared by the assembly stacks of several contracts.
+ */
+
+#pragma once
+
+#include <libyul/Object.h>
+#include <libyul/OptimizedFunctionCache.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimized sub-objects, e.g. of contracts created via ``new``, by a hash of the object
+ * before the optimization and of the settings it was optimized with, so that a sub-object
+ * contained in several objects is only optimized once.
+ *
+ * The cache keeps its own copies of the objects, which are never modified. Can only be shared
+ * by assembly stacks for the same language, EVM version and optimiser settings.
+ * Also provides the cache of the results of the function-local optimiser steps on individual
+ * functions, which can be reused for objects that are not equal as a whole.
+ * Can be used from several threads.
+ */
+class OptimizedObjectCache
+{
+public:
+	/// @returns a copy of the object stored under @a _key without analysis information,
+	/// or null if there is none.
+	std::shared_ptr<Object> find(util::h256 const& _key) const;
+	/// Stores a copy of @a _object under @a _key, unless there already is an object.
+	void insert(util::h256 const& _key, Object const& _object);
+
+	/// @returns a copy of the code of @a _object and of its sub-objects without analysis information.
+	/// Data is shared with @a _object.
+	static std::shared_ptr<Object> copy(Object const& _object);
+
+	OptimizedFunctionCache& functionCache() { return m_functionCache; }
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Object const>> m_objects;
+	OptimizedFunctionCache m_functionCache;
+};
+
+}
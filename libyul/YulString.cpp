@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/XXHash.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t lookupHash = util::xxhash64(_string);
+	Shard& shard = m_shards[lookupHash >> (64 - c_shardBits)];
+
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.lookupHashToID.equal_range(lookupHash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		Entry const& existing = entry(it->second);
+		if (existing.string == _string)
+			return Handle{it->second, existing.hash};
+	}
+	uint64_t h = hash(_string);
+	size_t id = addString(_string, h);
+	shard.lookupHashToID.emplace_hint(range.second, lookupHash, id);
+
+	return Handle{id, h};
+}
+
+size_t YulStringRepository::addString(string const& _string, uint64_t _hash)
+{
+	size_t id = m_nextID.fetch_add(1);
+	size_t chunkIndex = id >> c_chunkBits;
+	yulAssert(chunkIndex < c_maxChunks, "Too many distinct Yul strings.");
+
+	Entry* chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+	if (!chunk)
+	{
+		lock_guard<mutex> lock(m_chunkAllocationMutex);
+		chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+		if (!chunk)
+		{
+			chunk = new Entry[c_chunkSize];
+			m_chunks[chunkIndex].store(chunk, memory_order_release);
+		}
+	}
+	chunk[id & (c_chunkSize - 1)] = Entry{_string, _hash};
+	return id;
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+		shard.lookupHashToID.clear();
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr);
+	// Allocate the first chunk, which contains the empty string at ID zero.
+	m_chunks[0].store(new Entry[c_chunkSize]);
+	m_nextID = 1;
+}
+
+void YulStringRepository::truncate(size_t _size)
+{
+	// The empty string is always kept.
+	_size = max<size_t>(_size, 1);
+	size_t size = m_nextID;
+	if (_size >= size)
+		return;
+
+	for (Shard& shard: m_shards)
+		for (auto it = shard.lookupHashToID.begin(); it != shard.lookupHashToID.end();)
+			if (it->second >= _size)
+				it = shard.lookupHashToID.erase(it);
+			else
+				++it;
+
+	// Release the string data of the removed entries in the last chunk that is kept
+	// and all chunks after it.
+	size_t lastChunk = (_size - 1) >> c_chunkBits;
+	Entry* chunk = m_chunks[lastChunk].load();
+	for (size_t id = _size; id < min(size, (lastChunk + 1) << c_chunkBits); ++id)
+		chunk[id & (c_chunkSize - 1)] = Entry{};
+	for (size_t i = lastChunk + 1; i <= (size - 1) >> c_chunkBits; ++i)
+		delete[] m_chunks[i].exchange(nullptr);
+	m_nextID = _size;
+}
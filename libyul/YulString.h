@@ -21,6 +21,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -34,6 +38,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Interning strings and looking up the string of an ID is safe to do from multiple threads
+/// at the same time. Strings are looked up via xxhash64 in one of several lock-striped shards.
+/// The string data is stored in chunks that are never moved, so resolving an ID does not
+/// require any locking.
 class YulStringRepository
 {
 public:
@@ -49,26 +58,16 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
-	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
-	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	Handle stringToHandle(std::string const& _string);
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size() const { return m_nextID.load(); }
+	std::string const& idToString(size_t _id) const { return entry(_id).string; }
 
+	/// @returns the hash stored in the handles, which determines the order of YulStrings.
+	/// This is the FNV hash, which is slow to compute, but is kept since optimiser
+	/// results depend on the order. It is only computed once per distinct string.
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -80,40 +79,88 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and
+	/// the repository must not be used concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
 		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+			cb(0);
+		instance().clear();
+	}
+	/// Removes all strings added after the repository contained @a _size strings, as
+	/// returned by size(), and keeps the others with their IDs. Meant for processes that
+	/// compile many independent inputs, like fuzzers in persistent mode, so that the
+	/// repository does not keep growing while state created upfront, like dialects, stays valid.
+	/// The same restrictions as for reset() apply to the removed strings.
+	static void resetTo(size_t _size)
+	{
+		for (auto const& cb: resetCallbacks())
+			cb(_size);
+		instance().truncate(_size);
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
+	/// Callbacks that take an argument are passed the number of strings that are kept,
+	/// which is zero for reset(), and only need to clear references to the removed strings.
+	/// The others are called for both reset() and resetTo().
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
+		{
+			YulStringRepository::resetCallbacks().emplace_back([fun = std::move(_fun)](size_t) { fun(); });
+		}
+		ResetCallback(std::function<void(size_t)> _fun)
 		{
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	struct Entry
+	{
+		std::string string;
+		std::uint64_t hash = emptyHash();
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		/// Maps the xxhash64 of a string to the IDs of all strings with that hash.
+		std::unordered_multimap<std::uint64_t, size_t> lookupHashToID;
+	};
+
+	static constexpr size_t c_shardBits = 5;
+	static constexpr size_t c_chunkBits = 12;
+	static constexpr size_t c_chunkSize = size_t(1) << c_chunkBits;
+	static constexpr size_t c_maxChunks = size_t(1) << 14;
+
+	YulStringRepository();
+	~YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	static std::vector<std::function<void(size_t)>>& resetCallbacks()
 	{
-		static std::vector<std::function<void()>> callbacks;
+		static std::vector<std::function<void(size_t)>> callbacks;
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	Entry const& entry(size_t _id) const
+	{
+		return m_chunks[_id >> c_chunkBits].load(std::memory_order_acquire)[_id & (c_chunkSize - 1)];
+	}
+	/// Allocates a new ID and stores @a _string under it.
+	size_t addString(std::string const& _string, std::uint64_t _hash);
+	void clear();
+	/// Removes the strings with an ID of at least @a _size.
+	void truncate(size_t _size);
+
+	std::array<Shard, size_t(1) << c_shardBits> m_shards;
+	std::array<std::atomic<Entry*>, c_maxChunks> m_chunks{};
+	std::mutex m_chunkAllocationMutex;
+	std::atomic<size_t> m_nextID{1};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -154,6 +201,9 @@ public:
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
+	/// @returns the ID of the string in the repository, which depends on the order in which
+	/// strings were added, but is small for strings added early, like the names of builtins.
+	size_t id() const { return m_handle.id; }
 
 private:
 	/// Handle of the string. Assumes that the empty string has ID zero.
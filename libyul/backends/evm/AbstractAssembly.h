@@ -58,6 +58,9 @@ public:
 
 	virtual ~AbstractAssembly() = default;
 
+	/// Hints that about @a _items further operations will be appended, so that storage
+	/// for them can be allocated at once.
+	virtual void reserve(size_t /*_items*/) {}
 	/// Set a new source location valid starting from the next instruction.
 	virtual void setSourceLocation(langutil::SourceLocation const& _location) = 0;
 	/// Retrieve the current height of the stack. This does not have to be zero
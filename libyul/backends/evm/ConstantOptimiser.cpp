@@ -27,7 +27,9 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/LRUCache.h>
 
+#include <tuple>
 #include <variant>
 
 using namespace std;
@@ -88,6 +90,41 @@ struct MiniEVMInterpreter
 
 	EVMDialect const& m_dialect;
 };
+
+struct SharedRepresentation
+{
+	Expression expression;
+	bigint cost;
+};
+
+using SharedRepresentationKey = tuple<u256, EVMDialect const*, bool, bigint>;
+
+/// Representations shared by all runs of the optimiser in this process, keyed by the value,
+/// the dialect (and thus the EVM version), whether it is creation code and the number of runs.
+/// The expressions do not have debug data. They refer to YulStrings, so the cache is cleared
+/// together with the YulStringRepository.
+util::LRUCache<SharedRepresentationKey, SharedRepresentation>& sharedRepresentations()
+{
+	static util::LRUCache<SharedRepresentationKey, SharedRepresentation> cache(4096);
+	static YulStringRepository::ResetCallback callback{[&] { cache.clear(); }};
+	return cache;
+}
+
+void setDebugData(Expression& _expression, shared_ptr<DebugData const> const& _debugData)
+{
+	if (Literal* literal = get_if<Literal>(&_expression))
+		literal->debugData = _debugData;
+	else if (FunctionCall* call = get_if<FunctionCall>(&_expression))
+	{
+		call->debugData = _debugData;
+		call->functionName.debugData = _debugData;
+		for (Expression& argument: call->arguments)
+			setDebugData(argument, _debugData);
+	}
+	else
+		yulAssert(false, "Unexpected expression in constant representation.");
+}
+
 }
 
 void ConstantOptimiser::visit(Expression& _e)
@@ -98,17 +135,71 @@ void ConstantOptimiser::visit(Expression& _e)
 		if (literal.kind != LiteralKind::Number)
 			return;
 
-		if (
-			Expression const* repr =
-				RepresentationFinder(m_dialect, m_meter, debugDataOf(_e), m_cache)
-				.tryFindRepresentation(valueOfLiteral(literal))
-		)
+		u256 const value = valueOfLiteral(literal);
+		if (value < 0x10000)
+			return;
+
+		shared_ptr<DebugData const> debugData = debugDataOf(_e);
+		SharedRepresentationKey key{value, &m_dialect, m_meter.isCreation(), m_meter.runs()};
+		bool search = !m_cache.count(value);
+		bool const cacheWasEmpty = m_cache.empty();
+		if (search)
+		{
+			m_searchedValues.push_back(value);
+			if (m_cacheIsExact)
+				if (optional<SharedRepresentation> shared = sharedRepresentations().find(key))
+				{
+					setDebugData(shared->expression, debugData);
+					m_cache[value] = Representation{make_unique<Expression>(move(shared->expression)), move(shared->cost)};
+					m_usedSharedRepresentations = true;
+					search = false;
+				}
+		}
+
+		RepresentationFinder finder(m_dialect, m_meter, debugData, m_cache);
+		Expression const* repr = finder.tryFindRepresentation(value);
+		if (search && finder.exhausted())
+		{
+			m_cacheIsExact = false;
+			if (m_usedSharedRepresentations)
+			{
+				// Shared representations do not add the representations of their parts to the
+				// cache, so the search might have stopped early only because of them. Rebuild
+				// the cache as if all values so far had been searched for without them.
+				m_cache.clear();
+				for (u256 const& searchedValue: m_searchedValues)
+					RepresentationFinder(m_dialect, m_meter, debugData, m_cache).tryFindRepresentation(searchedValue);
+				m_usedSharedRepresentations = false;
+				repr = RepresentationFinder(m_dialect, m_meter, debugData, m_cache).tryFindRepresentation(value);
+			}
+		}
+		else if (search && m_cacheIsExact && (cacheWasEmpty || searchFinishesWithEmptyCache(value)))
+		{
+			Representation const& found = m_cache.at(value);
+			SharedRepresentation shared{ASTCopier{}.translate(*found.expression), found.cost};
+			setDebugData(shared.expression, nullptr);
+			sharedRepresentations().insert(key, move(shared));
+		}
+
+		if (repr)
+		{
+			// Parts of the representation might have been found for other literals.
 			_e = ASTCopier{}.translate(*repr);
+			setDebugData(_e, debugData);
+		}
 	}
 	else
 		ASTModifier::visit(_e);
 }
 
+bool ConstantOptimiser::searchFinishesWithEmptyCache(u256 const& _value) const
+{
+	map<u256, Representation> cache;
+	RepresentationFinder finder(m_dialect, m_meter, nullptr, cache);
+	finder.tryFindRepresentation(_value);
+	return !finder.exhausted();
+}
+
 Expression const* RepresentationFinder::tryFindRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -34,6 +34,7 @@
 #include <tuple>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -43,6 +44,12 @@ class GasMeter;
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
  *
+ * Representations are also stored in a process-wide cache of bounded size, which is
+ * consulted before searching, if their search finishes even when it starts with an empty
+ * cache. Another run then also finds them without reaching the step limit. If a search
+ * stops early after representations were taken from that cache, the search is repeated
+ * as if they had not been, so that the result does not depend on earlier compilations.
+ *
  * Prerequisite: None
  */
 class ConstantOptimiser: public ASTModifier
@@ -62,9 +69,21 @@ public:
 	};
 
 private:
+	/// @returns true if the search for @a _value does not reach the step limit
+	/// if it starts without any known representations.
+	bool searchFinishesWithEmptyCache(u256 const& _value) const;
+
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
 	std::map<u256, Representation> m_cache;
+	/// False if a search in this run stopped early, i.e. some entries of m_cache might not
+	/// be the best representation and cannot be shared. The shared representations are
+	/// then also no longer used, since the result could depend on which ones are found.
+	bool m_cacheIsExact = true;
+	/// True if m_cache contains shared representations without their parts.
+	bool m_usedSharedRepresentations = false;
+	/// The values searched for or taken from the shared representations in this run, in order.
+	std::vector<u256> m_searchedValues;
 };
 
 class RepresentationFinder
@@ -86,6 +105,8 @@ public:
 	/// @returns a cheaper representation for the number than its representation
 	/// as a literal or nullptr otherwise.
 	Expression const* tryFindRepresentation(u256 const& _value);
+	/// @returns true if the search stopped early because the step limit was reached.
+	bool exhausted() const { return m_maxSteps == 0; }
 
 private:
 	/// Recursively try to find the cheapest representation of the given number,
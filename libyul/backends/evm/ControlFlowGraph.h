@@ -0,0 +1,209 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control flow graph of Yul code in terms of basic blocks operating on an abstract stack,
+ * used by the stack layout generator and the stack-layout-aware code transform.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Scope.h>
+
+#include <libsolutil/Common.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// The label pushed as return label before jumping to a function.
+struct FunctionCallReturnLabelSlot
+{
+	FunctionCall const* call = nullptr;
+	bool operator==(FunctionCallReturnLabelSlot const& _rhs) const { return call == _rhs.call; }
+	bool operator<(FunctionCallReturnLabelSlot const& _rhs) const { return call < _rhs.call; }
+};
+/// The return label of the function that is currently being generated.
+struct FunctionReturnLabelSlot
+{
+	Scope::Function const* function = nullptr;
+	bool operator==(FunctionReturnLabelSlot const& _rhs) const { return function == _rhs.function; }
+	bool operator<(FunctionReturnLabelSlot const& _rhs) const { return function < _rhs.function; }
+};
+/// The current value of a variable.
+struct VariableSlot
+{
+	Scope::Variable const* variable = nullptr;
+	std::shared_ptr<DebugData const> debugData{};
+	bool operator==(VariableSlot const& _rhs) const { return variable == _rhs.variable; }
+	bool operator<(VariableSlot const& _rhs) const { return variable < _rhs.variable; }
+};
+/// A constant value, which can be pushed whenever it is needed.
+struct LiteralSlot
+{
+	u256 value;
+	std::shared_ptr<DebugData const> debugData{};
+	bool operator==(LiteralSlot const& _rhs) const { return value == _rhs.value; }
+	bool operator<(LiteralSlot const& _rhs) const { return value < _rhs.value; }
+};
+/// The @a index-th return value of the function call @a call.
+struct TemporarySlot
+{
+	FunctionCall const* call = nullptr;
+	size_t index = 0;
+	bool operator==(TemporarySlot const& _rhs) const { return call == _rhs.call && index == _rhs.index; }
+	bool operator<(TemporarySlot const& _rhs) const
+	{
+		return call == _rhs.call ? index < _rhs.index : call < _rhs.call;
+	}
+};
+/// A slot whose value does not matter.
+struct JunkSlot
+{
+	bool operator==(JunkSlot const&) const { return true; }
+	bool operator<(JunkSlot const&) const { return false; }
+};
+using StackSlot = std::variant<FunctionCallReturnLabelSlot, FunctionReturnLabelSlot, VariableSlot, LiteralSlot, TemporarySlot, JunkSlot>;
+/// The layout of a stack, the last element being the top.
+using Stack = std::vector<StackSlot>;
+
+/// @returns true if @a _slot can be produced whenever it is needed without it being on the stack.
+inline bool canBeFreelyGenerated(StackSlot const& _slot)
+{
+	return
+		std::holds_alternative<LiteralSlot>(_slot) ||
+		std::holds_alternative<FunctionCallReturnLabelSlot>(_slot) ||
+		std::holds_alternative<JunkSlot>(_slot);
+}
+
+/**
+ * Control flow graph consisting of basic blocks. Each block is a sequence of operations,
+ * each of which consumes its input slots from the stack top and replaces them by its output slots,
+ * followed by an exit that transfers control to other blocks.
+ *
+ * The main code and every function have their own entry block. Blocks that are not reachable
+ * from any entry, e.g. code following a terminating call, are kept, but no code is generated for them.
+ */
+struct CFG
+{
+	explicit CFG() {}
+	CFG(CFG const&) = delete;
+	CFG(CFG&&) = delete;
+	CFG& operator=(CFG const&) = delete;
+	CFG& operator=(CFG&&) = delete;
+
+	struct BuiltinCall
+	{
+		std::shared_ptr<DebugData const> debugData;
+		BuiltinFunction const* builtin = nullptr;
+		yul::FunctionCall const* functionCall = nullptr;
+		/// Number of arguments that are passed on the stack, i.e. excluding literal arguments.
+		size_t arguments = 0;
+	};
+	struct FunctionCall
+	{
+		std::shared_ptr<DebugData const> debugData;
+		Scope::Function const* function = nullptr;
+		yul::FunctionCall const* functionCall = nullptr;
+		/// False, if the called function never returns. In that case no return label is pushed.
+		bool canContinue = true;
+	};
+	struct Assignment
+	{
+		std::shared_ptr<DebugData const> debugData;
+		/// The variables being assigned to, which are also the output of the operation.
+		std::vector<VariableSlot> variables;
+	};
+
+	struct Operation
+	{
+		/// Slots expected at the stack top before the operation, the last being the top.
+		Stack input;
+		/// Slots at the stack top after the operation, the last being the top.
+		Stack output;
+		std::variant<FunctionCall, BuiltinCall, Assignment> operation;
+	};
+
+	struct FunctionInfo;
+	struct BasicBlock
+	{
+		struct MainExit {};
+		struct ConditionalJump
+		{
+			std::shared_ptr<DebugData const> debugData;
+			StackSlot condition;
+			BasicBlock* nonZero = nullptr;
+			BasicBlock* zero = nullptr;
+		};
+		struct Jump
+		{
+			std::shared_ptr<DebugData const> debugData;
+			BasicBlock* target = nullptr;
+			/// True for the jumps back to the condition of a for-loop.
+			bool backwards = false;
+		};
+		struct FunctionReturn
+		{
+			std::shared_ptr<DebugData const> debugData;
+			FunctionInfo* info = nullptr;
+		};
+		struct Terminated {};
+		std::shared_ptr<DebugData const> debugData;
+		std::vector<BasicBlock*> entries;
+		std::vector<Operation> operations;
+		std::variant<MainExit, Jump, ConditionalJump, FunctionReturn, Terminated> exit = MainExit{};
+	};
+
+	struct FunctionInfo
+	{
+		std::shared_ptr<DebugData const> debugData;
+		Scope::Function const* function = nullptr;
+		BasicBlock* entry = nullptr;
+		std::vector<VariableSlot> parameters;
+		std::vector<VariableSlot> returnVariables;
+		/// False, if no path through the function reaches its end or a ``leave``.
+		bool canContinue = true;
+	};
+
+	/// The main entry point, i.e. the start of the outermost block.
+	BasicBlock* entry = nullptr;
+	/// Functions in order of their definition.
+	std::vector<Scope::Function const*> functions;
+	std::map<Scope::Function const*, FunctionInfo> functionInfo;
+
+	/// Container for blocks for explicit ownership.
+	std::list<BasicBlock> blocks;
+	/// Container for the variables holding the values of switch expressions.
+	std::list<Scope::Variable> ghostVariables;
+	/// Container for the comparisons of the switch expression with the case values.
+	std::list<yul::FunctionCall> ghostCalls;
+
+	BasicBlock& makeBlock(std::shared_ptr<DebugData const> _debugData)
+	{
+		return blocks.emplace_back(BasicBlock{std::move(_debugData), {}, {}});
+	}
+};
+
+}
@@ -0,0 +1,499 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Transformation of a Yul AST into a control flow graph.
+ */
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+unique_ptr<CFG> ControlFlowGraphBuilder::build(
+	AsmAnalysisInfo const& _analysisInfo,
+	EVMDialect const& _dialect,
+	Block const& _block
+)
+{
+	// The graph is first built assuming that every function returns. If some of them do not,
+	// it is built again, such that calls to those functions do not push return labels and
+	// the code following them is not reachable.
+	unique_ptr<CFG> graph = build(_analysisInfo, _dialect, _block, {});
+	set<Scope::Function const*> nonContinuing = nonContinuingFunctions(*graph);
+	if (nonContinuing.empty())
+		return graph;
+	graph = build(_analysisInfo, _dialect, _block, nonContinuing);
+	for (auto&& [function, info]: graph->functionInfo)
+		info.canContinue = !nonContinuing.count(function);
+	return graph;
+}
+
+unique_ptr<CFG> ControlFlowGraphBuilder::build(
+	AsmAnalysisInfo const& _analysisInfo,
+	EVMDialect const& _dialect,
+	Block const& _block,
+	set<Scope::Function const*> const& _nonContinuingFunctions
+)
+{
+	auto graph = make_unique<CFG>();
+	graph->entry = &graph->makeBlock(_block.debugData);
+
+	ControlFlowGraphBuilder builder(*graph, _analysisInfo, _dialect, _nonContinuingFunctions);
+	builder.m_currentBlock = graph->entry;
+	builder(_block);
+	return graph;
+}
+
+set<Scope::Function const*> ControlFlowGraphBuilder::nonContinuingFunctions(CFG const& _graph)
+{
+	// A function returns, if its end or a ``leave`` can be reached without calling a function
+	// that does not return. Starting from the assumption that no function returns, this is iterated
+	// until the set of returning functions is stable.
+	set<Scope::Function const*> returning;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (Scope::Function const* function: _graph.functions)
+		{
+			if (returning.count(function))
+				continue;
+			bool reachesReturn = false;
+			BreadthFirstSearch<CFG::BasicBlock const*> bfs{{_graph.functionInfo.at(function).entry}};
+			bfs.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+				for (CFG::Operation const& operation: _block->operations)
+					if (auto const* call = get_if<CFG::FunctionCall>(&operation.operation))
+						if (!returning.count(call->function))
+							return;
+				visit(GenericVisitor{
+					[&](CFG::BasicBlock::Jump const& _jump) { _addChild(_jump.target); },
+					[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+						_addChild(_jump.zero);
+						_addChild(_jump.nonZero);
+					},
+					[&](CFG::BasicBlock::FunctionReturn const&) {
+						reachesReturn = true;
+						bfs.abort();
+					},
+					[](auto const&) {}
+				}, _block->exit);
+			});
+			if (reachesReturn)
+			{
+				returning.insert(function);
+				changed = true;
+			}
+		}
+	}
+
+	set<Scope::Function const*> nonContinuing;
+	for (Scope::Function const* function: _graph.functions)
+		if (!returning.count(function))
+			nonContinuing.insert(function);
+	return nonContinuing;
+}
+
+ControlFlowGraphBuilder::ControlFlowGraphBuilder(
+	CFG& _graph,
+	AsmAnalysisInfo const& _analysisInfo,
+	EVMDialect const& _dialect,
+	set<Scope::Function const*> const& _nonContinuingFunctions
+):
+	m_graph(_graph),
+	m_info(_analysisInfo),
+	m_dialect(_dialect),
+	m_nonContinuingFunctions(_nonContinuingFunctions)
+{
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Expression const& _expression)
+{
+	return std::visit(*this, _expression);
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Literal const& _literal)
+{
+	return LiteralSlot{valueOfLiteral(_literal), _literal.debugData};
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Identifier const& _identifier)
+{
+	return VariableSlot{&lookupVariable(_identifier.name), _identifier.debugData};
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(FunctionCall const& _call)
+{
+	CFG::Operation& operation = visitFunctionCall(_call);
+	yulAssert(operation.output.size() == 1, "");
+	return operation.output.front();
+}
+
+void ControlFlowGraphBuilder::operator()(Statement const& _statement)
+{
+	std::visit(*this, _statement);
+}
+
+void ControlFlowGraphBuilder::operator()(VariableDeclaration const& _varDecl)
+{
+	yulAssert(m_currentBlock, "");
+	vector<VariableSlot> variables;
+	for (TypedName const& variable: _varDecl.variables)
+		variables.emplace_back(VariableSlot{&lookupVariable(variable.name), variable.debugData});
+
+	Stack input;
+	if (_varDecl.value)
+		input = visitAssignmentRightHandSide(*_varDecl.value, variables.size());
+	else
+		input = Stack(variables.size(), LiteralSlot{0, _varDecl.debugData});
+	m_currentBlock->operations.emplace_back(CFG::Operation{
+		move(input),
+		Stack(variables.begin(), variables.end()),
+		CFG::Assignment{_varDecl.debugData, variables}
+	});
+}
+
+void ControlFlowGraphBuilder::operator()(Assignment const& _assignment)
+{
+	yulAssert(m_currentBlock, "");
+	vector<VariableSlot> variables;
+	for (Identifier const& variable: _assignment.variableNames)
+		variables.emplace_back(VariableSlot{&lookupVariable(variable.name), variable.debugData});
+
+	Stack input = visitAssignmentRightHandSide(*_assignment.value, variables.size());
+	m_currentBlock->operations.emplace_back(CFG::Operation{
+		move(input),
+		Stack(variables.begin(), variables.end()),
+		CFG::Assignment{_assignment.debugData, variables}
+	});
+}
+
+void ControlFlowGraphBuilder::operator()(ExpressionStatement const& _statement)
+{
+	yulAssert(m_currentBlock, "");
+	FunctionCall const* call = get_if<FunctionCall>(&_statement.expression);
+	yulAssert(call, "Expression statement has to be a function call.");
+	CFG::Operation& operation = visitFunctionCall(*call);
+	yulAssert(operation.output.empty(), "");
+}
+
+void ControlFlowGraphBuilder::operator()(Block const& _block)
+{
+	ScopedSaveAndRestore saveScope(m_scope, m_info.scopes.at(&_block).get());
+	// Functions can be called before their definition, so they are registered first.
+	for (Statement const& statement: _block.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			registerFunction(*function);
+	for (Statement const& statement: _block.statements)
+		(*this)(statement);
+}
+
+void ControlFlowGraphBuilder::operator()(If const& _if)
+{
+	yulAssert(m_currentBlock, "");
+	StackSlot condition = (*this)(*_if.condition);
+	CFG::BasicBlock& ifBranch = m_graph.makeBlock(_if.body.debugData);
+	CFG::BasicBlock& afterIf = m_graph.makeBlock(_if.debugData);
+	makeConditionalJump(_if.debugData, move(condition), ifBranch, afterIf);
+	m_currentBlock = &ifBranch;
+	(*this)(_if.body);
+	jump(_if.body.debugData, afterIf);
+}
+
+void ControlFlowGraphBuilder::operator()(Switch const& _switch)
+{
+	yulAssert(m_currentBlock, "");
+	yulAssert(!_switch.cases.empty(), "");
+
+	// The value of the expression is stored in a ghost variable, i.e. as if the code was
+	// let <ghost> := <expression>
+	Scope::Variable& ghostVariable = m_graph.ghostVariables.emplace_back(Scope::Variable{""_yulstring});
+	YulString ghostVariableName("GHOST[" + to_string(m_graph.ghostVariables.size() - 1) + "]");
+	VariableSlot ghostSlot{&ghostVariable, debugDataOf(*_switch.expression)};
+	StackSlot value = (*this)(*_switch.expression);
+	m_currentBlock->operations.emplace_back(CFG::Operation{
+		Stack{move(value)},
+		Stack{ghostSlot},
+		CFG::Assignment{_switch.debugData, {ghostSlot}}
+	});
+
+	BuiltinFunctionForEVM const* equality = m_dialect.builtin("eq"_yulstring);
+	yulAssert(equality, "");
+	// Compares the ghost variable with the value of a case, i.e. eq(<value>, <ghost>).
+	auto compareWithCase = [&](Case const& _case) -> StackSlot {
+		FunctionCall const& ghostCall = m_graph.ghostCalls.emplace_back(FunctionCall{
+			_case.debugData,
+			Identifier{{}, "eq"_yulstring},
+			{*_case.value, Identifier{{}, ghostVariableName}}
+		});
+		CFG::Operation& operation = m_currentBlock->operations.emplace_back(CFG::Operation{
+			Stack{ghostSlot, LiteralSlot{valueOfLiteral(*_case.value), _case.value->debugData}},
+			Stack{TemporarySlot{&ghostCall, 0}},
+			CFG::BuiltinCall{_case.debugData, equality, &ghostCall, 2}
+		});
+		return operation.output.front();
+	};
+
+	CFG::BasicBlock& afterSwitch = m_graph.makeBlock(_switch.debugData);
+	for (size_t i = 0; i < _switch.cases.size(); ++i)
+	{
+		Case const& switchCase = _switch.cases[i];
+		bool isLast = i + 1 == _switch.cases.size();
+		if (switchCase.value)
+		{
+			CFG::BasicBlock& caseBranch = m_graph.makeBlock(switchCase.body.debugData);
+			CFG::BasicBlock& elseBranch = isLast ? afterSwitch : m_graph.makeBlock(_switch.debugData);
+			makeConditionalJump(switchCase.debugData, compareWithCase(switchCase), caseBranch, elseBranch);
+			m_currentBlock = &caseBranch;
+			(*this)(switchCase.body);
+			jump(switchCase.body.debugData, afterSwitch);
+			if (!isLast)
+				m_currentBlock = &elseBranch;
+		}
+		else
+		{
+			yulAssert(isLast, "The default case has to be the last one.");
+			(*this)(switchCase.body);
+			jump(switchCase.body.debugData, afterSwitch);
+		}
+	}
+}
+
+void ControlFlowGraphBuilder::operator()(ForLoop const& _loop)
+{
+	yulAssert(m_currentBlock, "");
+	// The variables declared in the initialization part are visible in the rest of the loop.
+	ScopedSaveAndRestore saveScope(m_scope, m_info.scopes.at(&_loop.pre).get());
+	(*this)(_loop.pre);
+
+	optional<bool> constantCondition;
+	if (auto const* literal = get_if<Literal>(_loop.condition.get()))
+		constantCondition = valueOfLiteral(*literal) != 0;
+
+	CFG::BasicBlock& loopCondition = m_graph.makeBlock(debugDataOf(*_loop.condition));
+	CFG::BasicBlock& loopBody = m_graph.makeBlock(_loop.body.debugData);
+	CFG::BasicBlock& post = m_graph.makeBlock(_loop.post.debugData);
+	CFG::BasicBlock& afterLoop = m_graph.makeBlock(_loop.debugData);
+
+	ScopedSaveAndRestore saveForLoopInfo(m_forLoopInfo, make_optional(ForLoopInfo{&afterLoop, &post}));
+
+	if (constantCondition && !*constantCondition)
+	{
+		jump(_loop.pre.debugData, afterLoop);
+		return;
+	}
+
+	CFG::BasicBlock& loopStart = constantCondition ? loopBody : loopCondition;
+	jump(_loop.pre.debugData, loopStart);
+	if (!constantCondition)
+	{
+		StackSlot condition = (*this)(*_loop.condition);
+		makeConditionalJump(debugDataOf(*_loop.condition), move(condition), loopBody, afterLoop);
+		m_currentBlock = &loopBody;
+	}
+	(*this)(_loop.body);
+	jump(_loop.body.debugData, post);
+	(*this)(_loop.post);
+	jump(_loop.post.debugData, loopStart, true);
+	m_currentBlock = &afterLoop;
+}
+
+void ControlFlowGraphBuilder::operator()(Break const& _break)
+{
+	yulAssert(m_forLoopInfo, "");
+	jump(_break.debugData, *m_forLoopInfo->afterLoop);
+	m_currentBlock = &m_graph.makeBlock(_break.debugData);
+}
+
+void ControlFlowGraphBuilder::operator()(Continue const& _continue)
+{
+	yulAssert(m_forLoopInfo, "");
+	jump(_continue.debugData, *m_forLoopInfo->post);
+	m_currentBlock = &m_graph.makeBlock(_continue.debugData);
+}
+
+void ControlFlowGraphBuilder::operator()(Leave const& _leave)
+{
+	yulAssert(m_currentFunction, "");
+	terminate(CFG::BasicBlock::FunctionReturn{_leave.debugData, m_currentFunction});
+}
+
+void ControlFlowGraphBuilder::operator()(FunctionDefinition const& _function)
+{
+	yulAssert(m_scope, "");
+	Scope::Function const& function = lookupFunction(_function.name);
+	m_graph.functions.emplace_back(&function);
+	CFG::FunctionInfo& info = m_graph.functionInfo.at(&function);
+
+	ControlFlowGraphBuilder builder{m_graph, m_info, m_dialect, m_nonContinuingFunctions};
+	builder.m_currentFunction = &info;
+	builder.m_currentBlock = info.entry;
+	builder(_function.body);
+	builder.m_currentBlock->exit = CFG::BasicBlock::FunctionReturn{_function.debugData, &info};
+}
+
+void ControlFlowGraphBuilder::registerFunction(FunctionDefinition const& _function)
+{
+	yulAssert(m_scope, "");
+	Scope::Function const& function = lookupFunction(_function.name);
+	Scope& virtualFunctionScope = *m_info.scopes.at(m_info.virtualBlocks.at(&_function).get());
+	auto slotOf = [&](TypedName const& _variable) {
+		return VariableSlot{
+			&std::get<Scope::Variable>(virtualFunctionScope.identifiers.at(_variable.name)),
+			_variable.debugData
+		};
+	};
+
+	CFG::FunctionInfo info{
+		_function.debugData,
+		&function,
+		&m_graph.makeBlock(_function.body.debugData),
+		applyMap(_function.parameters, slotOf),
+		applyMap(_function.returnVariables, slotOf),
+		!m_nonContinuingFunctions.count(&function)
+	};
+	bool inserted = m_graph.functionInfo.emplace(&function, move(info)).second;
+	yulAssert(inserted, "");
+}
+
+CFG::Operation& ControlFlowGraphBuilder::visitFunctionCall(FunctionCall const& _call)
+{
+	yulAssert(m_currentBlock, "");
+	// Arguments are evaluated from right to left, such that the first argument ends up at the stack top.
+	if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionName.name))
+	{
+		Stack input;
+		for (size_t i = _call.arguments.size(); i > 0; --i)
+			if (!builtin->literalArgument(i - 1))
+				input.emplace_back((*this)(_call.arguments[i - 1]));
+		Stack output;
+		for (size_t i = 0; i < builtin->returns.size(); ++i)
+			output.emplace_back(TemporarySlot{&_call, i});
+		size_t arguments = input.size();
+		CFG::Operation& operation = m_currentBlock->operations.emplace_back(CFG::Operation{
+			move(input),
+			move(output),
+			CFG::BuiltinCall{_call.debugData, builtin, &_call, arguments}
+		});
+		if (builtin->controlFlowSideEffects.terminates)
+			terminate(CFG::BasicBlock::Terminated{});
+		return operation;
+	}
+
+	Scope::Function const& function = lookupFunction(_call.functionName.name);
+	bool canContinue = !m_nonContinuingFunctions.count(&function);
+	Stack input;
+	if (canContinue)
+		input.emplace_back(FunctionCallReturnLabelSlot{&_call});
+	for (size_t i = _call.arguments.size(); i > 0; --i)
+		input.emplace_back((*this)(_call.arguments[i - 1]));
+	Stack output;
+	for (size_t i = 0; i < function.returns.size(); ++i)
+		output.emplace_back(TemporarySlot{&_call, i});
+	CFG::Operation& operation = m_currentBlock->operations.emplace_back(CFG::Operation{
+		move(input),
+		move(output),
+		CFG::FunctionCall{_call.debugData, &function, &_call, canContinue}
+	});
+	if (!canContinue)
+		terminate(CFG::BasicBlock::Terminated{});
+	return operation;
+}
+
+Stack ControlFlowGraphBuilder::visitAssignmentRightHandSide(Expression const& _expression, size_t _expectedSlotCount)
+{
+	if (auto const* call = get_if<FunctionCall>(&_expression))
+	{
+		Stack output = visitFunctionCall(*call).output;
+		yulAssert(output.size() == _expectedSlotCount, "");
+		return output;
+	}
+	yulAssert(_expectedSlotCount == 1, "");
+	return {(*this)(_expression)};
+}
+
+Scope::Function const& ControlFlowGraphBuilder::lookupFunction(YulString _name) const
+{
+	Scope::Function const* function = nullptr;
+	yulAssert(m_scope->lookup(_name, GenericVisitor{
+		[](Scope::Variable&) { yulAssert(false, "Expected function name."); },
+		[&](Scope::Function& _function) { function = &_function; }
+	}), "Function name not found.");
+	yulAssert(function, "");
+	return *function;
+}
+
+Scope::Variable const& ControlFlowGraphBuilder::lookupVariable(YulString _name) const
+{
+	yulAssert(m_scope, "");
+	Scope::Variable const* variable = nullptr;
+	yulAssert(m_scope->lookup(_name, GenericVisitor{
+		[&](Scope::Variable& _variable) { variable = &_variable; },
+		[](Scope::Function&) { yulAssert(false, "Function not removed during desugaring."); }
+	}), "Variable not found.");
+	yulAssert(variable, "");
+	return *variable;
+}
+
+void ControlFlowGraphBuilder::jump(
+	shared_ptr<DebugData const> _debugData,
+	CFG::BasicBlock& _target,
+	bool _backwards
+)
+{
+	yulAssert(m_currentBlock, "");
+	m_currentBlock->exit = CFG::BasicBlock::Jump{move(_debugData), &_target, _backwards};
+	_target.entries.emplace_back(m_currentBlock);
+	m_currentBlock = &_target;
+}
+
+void ControlFlowGraphBuilder::makeConditionalJump(
+	shared_ptr<DebugData const> _debugData,
+	StackSlot _condition,
+	CFG::BasicBlock& _nonZero,
+	CFG::BasicBlock& _zero
+)
+{
+	yulAssert(m_currentBlock, "");
+	m_currentBlock->exit = CFG::BasicBlock::ConditionalJump{
+		move(_debugData),
+		move(_condition),
+		&_nonZero,
+		&_zero
+	};
+	_nonZero.entries.emplace_back(m_currentBlock);
+	_zero.entries.emplace_back(m_currentBlock);
+	m_currentBlock = nullptr;
+}
+
+void ControlFlowGraphBuilder::terminate(variant<CFG::BasicBlock::FunctionReturn, CFG::BasicBlock::Terminated> _exit)
+{
+	yulAssert(m_currentBlock, "");
+	std::visit([&](auto&& _concreteExit) { m_currentBlock->exit = move(_concreteExit); }, move(_exit));
+	m_currentBlock = &m_graph.makeBlock(m_currentBlock->debugData);
+}
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Transformation of a Yul AST into a control flow graph.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct AsmAnalysisInfo;
+struct EVMDialect;
+
+class ControlFlowGraphBuilder
+{
+public:
+	ControlFlowGraphBuilder(ControlFlowGraphBuilder const&) = delete;
+	ControlFlowGraphBuilder& operator=(ControlFlowGraphBuilder const&) = delete;
+
+	/// Builds the control flow graph of @a _block, which has to be the outermost block of the code
+	/// analyzed in @a _analysisInfo.
+	static std::unique_ptr<CFG> build(
+		AsmAnalysisInfo const& _analysisInfo,
+		EVMDialect const& _dialect,
+		Block const& _block
+	);
+
+	StackSlot operator()(Expression const& _expression);
+	StackSlot operator()(Literal const& _literal);
+	StackSlot operator()(Identifier const& _identifier);
+	StackSlot operator()(FunctionCall const& _call);
+
+	void operator()(Statement const& _statement);
+	void operator()(VariableDeclaration const& _varDecl);
+	void operator()(Assignment const& _assignment);
+	void operator()(ExpressionStatement const& _statement);
+	void operator()(Block const& _block);
+	void operator()(If const& _if);
+	void operator()(Switch const& _switch);
+	void operator()(ForLoop const& _loop);
+	void operator()(Break const& _break);
+	void operator()(Continue const& _continue);
+	void operator()(Leave const& _leave);
+	void operator()(FunctionDefinition const& _function);
+
+private:
+	ControlFlowGraphBuilder(
+		CFG& _graph,
+		AsmAnalysisInfo const& _analysisInfo,
+		EVMDialect const& _dialect,
+		std::set<Scope::Function const*> const& _nonContinuingFunctions
+	);
+
+	/// Builds the graph assuming that exactly the functions in @a _nonContinuingFunctions never return.
+	static std::unique_ptr<CFG> build(
+		AsmAnalysisInfo const& _analysisInfo,
+		EVMDialect const& _dialect,
+		Block const& _block,
+		std::set<Scope::Function const*> const& _nonContinuingFunctions
+	);
+	/// @returns the functions of @a _graph that never return, taking the calls between them into account.
+	static std::set<Scope::Function const*> nonContinuingFunctions(CFG const& _graph);
+
+	void registerFunction(FunctionDefinition const& _function);
+	CFG::Operation& visitFunctionCall(FunctionCall const& _call);
+	Stack visitAssignmentRightHandSide(Expression const& _expression, size_t _expectedSlotCount);
+
+	Scope::Function const& lookupFunction(YulString _name) const;
+	Scope::Variable const& lookupVariable(YulString _name) const;
+
+	/// Ends the current block with a jump to @a _target and continues with @a _target.
+	void jump(std::shared_ptr<DebugData const> _debugData, CFG::BasicBlock& _target, bool _backwards = false);
+	/// Ends the current block with a conditional jump. The current block is reset and has to be set afterwards.
+	void makeConditionalJump(
+		std::shared_ptr<DebugData const> _debugData,
+		StackSlot _condition,
+		CFG::BasicBlock& _nonZero,
+		CFG::BasicBlock& _zero
+	);
+	/// Ends the current block with @a _exit and continues in a new block that cannot be reached.
+	void terminate(std::variant<CFG::BasicBlock::FunctionReturn, CFG::BasicBlock::Terminated> _exit);
+
+	CFG& m_graph;
+	AsmAnalysisInfo const& m_info;
+	EVMDialect const& m_dialect;
+	std::set<Scope::Function const*> const& m_nonContinuingFunctions;
+	CFG::BasicBlock* m_currentBlock = nullptr;
+	Scope* m_scope = nullptr;
+	struct ForLoopInfo
+	{
+		CFG::BasicBlock* afterLoop = nullptr;
+		CFG::BasicBlock* post = nullptr;
+	};
+	std::optional<ForLoopInfo> m_forLoopInfo;
+	CFG::FunctionInfo* m_currentFunction = nullptr;
+};
+
+}
@@ -21,6 +21,7 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/Utilities.h>
@@ -84,6 +85,8 @@ CodeTransform::CodeTransform(
 		m_context = make_shared<Context>();
 		if (m_allowStackOpt)
 			m_context->variableReferences = VariableReferenceCounter::run(m_info, _block);
+		// Most AST elements result in one or two assembly items.
+		m_assembly.reserve(2 * CodeSize::codeSizeIncludingFunctions(_block));
 	}
 }
 
@@ -36,7 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
-#include <regex>
+#include <mutex>
 
 using namespace std;
 using namespace solidity;
@@ -64,7 +64,7 @@ pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
 	evmasm::Instruction _instruction
 )
 {
-	evmasm::InstructionInfo info = evmasm::instructionInfo(_instruction);
+	evmasm::InstructionInfo const& info = evmasm::instructionInfo(_instruction);
 	BuiltinFunctionForEVM f;
 	f.name = YulString{_name};
 	f.parameters.resize(static_cast<size_t>(info.args));
@@ -283,12 +283,73 @@ map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVe
 	return builtins;
 }
 
-regex const& verbatimPattern()
+/// Parses a number between 0 and 99 without leading zeros at @a _pos of @a _name,
+/// advancing @a _pos past it.
+optional<size_t> parseVerbatimCount(string const& _name, size_t& _pos)
 {
-	regex static const pattern{"verbatim_([1-9]?[0-9])i_([1-9]?[0-9])o"};
-	return pattern;
+	auto isDigit = [&](size_t _i) { return _i < _name.size() && _name[_i] >= '0' && _name[_i] <= '9'; };
+	if (!isDigit(_pos))
+		return nullopt;
+	size_t value = static_cast<size_t>(_name[_pos++] - '0');
+	if (value != 0 && isDigit(_pos))
+		value = 10 * value + static_cast<size_t>(_name[_pos++] - '0');
+	return value;
 }
 
+/// @returns the number of arguments and return variables of @a _name if it matches
+/// verbatim_<n>i_<m>o with n and m between 0 and 99.
+optional<pair<size_t, size_t>> parseVerbatimName(string const& _name)
+{
+	static string const prefix = "verbatim_";
+	if (_name.compare(0, prefix.size(), prefix) != 0)
+		return nullopt;
+	size_t pos = prefix.size();
+	optional<size_t> arguments = parseVerbatimCount(_name, pos);
+	if (!arguments || _name.compare(pos, 2, "i_") != 0)
+		return nullopt;
+	pos += 2;
+	optional<size_t> returnVariables = parseVerbatimCount(_name, pos);
+	if (!returnVariables || _name.compare(pos, string::npos, "o") != 0)
+		return nullopt;
+	return {{*arguments, *returnVariables}};
+}
+
+/**
+ * Dialects of one kind for each EVM version. A dialect is kept when the Yul string repository
+ * is reset to a size that includes all strings that existed after the dialect was created.
+ */
+template <typename DialectType>
+class DialectCache
+{
+public:
+	DialectCache():
+		m_resetCallback{[this](size_t _keptStrings) {
+			for (auto it = m_dialects.begin(); it != m_dialects.end();)
+				if (it->second.second > _keptStrings)
+					it = m_dialects.erase(it);
+				else
+					++it;
+		}}
+	{}
+
+	DialectType const& get(langutil::EVMVersion _version, bool _objectAccess)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto& [dialect, strings] = m_dialects[_version];
+		if (!dialect)
+		{
+			dialect = make_unique<DialectType>(_version, _objectAccess);
+			strings = YulStringRepository::instance().size();
+		}
+		return *dialect;
+	}
+
+private:
+	map<langutil::EVMVersion, pair<unique_ptr<DialectType const>, size_t>> m_dialects;
+	mutex m_mutex;
+	YulStringRepository::ResetCallback m_resetCallback;
+};
+
 }
 
 
@@ -298,21 +359,39 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 	m_functions(createBuiltins(_evmVersion, _objectAccess)),
 	m_reserved(createReservedIdentifiers())
 {
+	if (m_objectAccess)
+		m_verbatimFunctions = make_unique<atomic<BuiltinFunctionForEVM const*>[]>(maxVerbatimCount * maxVerbatimCount);
+	indexBuiltins();
 }
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
+	if (_name.id() < m_builtinsByID.size())
+		if (BuiltinFunctionForEVM const* function = m_builtinsByID[_name.id()])
+			return function;
 	if (m_objectAccess)
+		if (auto counts = parseVerbatimName(_name.str()))
+			return verbatimFunction(counts->first, counts->second);
+	return nullptr;
+}
+
+void EVMDialect::indexBuiltins()
+{
+	m_builtinsByID.clear();
+	for (auto const& [name, function]: m_functions)
 	{
-		smatch match;
-		if (regex_match(_name.str(), match, verbatimPattern()))
-			return verbatimFunction(stoul(match[1]), stoul(match[2]));
+		if (m_builtinsByID.size() <= name.id())
+			m_builtinsByID.resize(name.id() + 1, nullptr);
+		m_builtinsByID[name.id()] = &function;
 	}
-	auto it = m_functions.find(_name);
-	if (it != m_functions.end())
-		return &it->second;
-	else
-		return nullptr;
+	m_discardFunction = builtin("pop"_yulstring);
+	m_equalityFunction = builtin("eq"_yulstring);
+	m_booleanNegationFunction = builtin("iszero"_yulstring);
+	m_memoryStoreFunction = builtin("mstore"_yulstring);
+	m_memoryLoadFunction = builtin("mload"_yulstring);
+	m_storageStoreFunction = builtin("sstore"_yulstring);
+	m_storageLoadFunction = builtin("sload"_yulstring);
+	m_hashFunction = "keccak256"_yulstring;
 }
 
 bool EVMDialect::reservedIdentifier(YulString _name) const
@@ -325,20 +404,14 @@ bool EVMDialect::reservedIdentifier(YulString _name) const
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, false);
-	return *dialects[_version];
+	static DialectCache<EVMDialect> dialects;
+	return dialects.get(_version, false);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, true);
-	return *dialects[_version];
+	static DialectCache<EVMDialect> dialects;
+	return dialects.get(_version, true);
 }
 
 SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instruction)
@@ -362,8 +435,14 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
-	pair<size_t, size_t> key{_arguments, _returnVariables};
-	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
+	yulAssert(m_verbatimFunctions && _arguments < maxVerbatimCount && _returnVariables < maxVerbatimCount, "");
+	atomic<BuiltinFunctionForEVM const*>& slot = m_verbatimFunctions[_arguments * maxVerbatimCount + _returnVariables];
+	// Fast path without locking: an entry never changes once it is set.
+	if (BuiltinFunctionForEVM const* function = slot.load(memory_order_acquire))
+		return function;
+
+	lock_guard<mutex> lock(m_verbatimFunctionsMutex);
+	BuiltinFunctionForEVM const* function = slot.load(memory_order_relaxed);
 	if (!function)
 	{
 		BuiltinFunctionForEVM builtinFunction = createFunction(
@@ -390,9 +469,12 @@ BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, siz
 			}
 		).second;
 		builtinFunction.isMSize = true;
-		function = make_shared<BuiltinFunctionForEVM const>(move(builtinFunction));
+		function = m_verbatimFunctionStorage.emplace_back(
+			make_unique<BuiltinFunctionForEVM const>(move(builtinFunction))
+		).get();
+		slot.store(function, memory_order_release);
 	}
-	return function.get();
+	return function;
 }
 
 EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectAccess):
@@ -470,6 +552,7 @@ EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectA
 	}));
 	m_functions["u256_to_bool"_yulstring].parameters = {"u256"_yulstring};
 	m_functions["u256_to_bool"_yulstring].returns = {"bool"_yulstring};
+	indexBuiltins();
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::discardFunction(YulString _type) const
@@ -496,9 +579,6 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
-	return *dialects[_version];
+	static DialectCache<EVMDialectTyped> dialects;
+	return dialects.get(_version, true);
 }
@@ -27,8 +27,12 @@
 #include <libyul/ASTForward.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -74,14 +78,14 @@ struct EVMDialect: public Dialect
 	/// @returns true if the identifier is reserved. This includes the builtins too.
 	bool reservedIdentifier(YulString _name) const override;
 
-	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return builtin("pop"_yulstring); }
-	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return builtin("eq"_yulstring); }
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("iszero"_yulstring); }
-	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return builtin("mstore"_yulstring); }
-	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return builtin("mload"_yulstring); }
-	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return builtin("sstore"_yulstring); }
-	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return builtin("sload"_yulstring); }
-	YulString hashFunction(YulString /*_type*/) const override { return "keccak256"_yulstring; }
+	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return m_discardFunction; }
+	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return m_equalityFunction; }
+	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return m_booleanNegationFunction; }
+	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return m_memoryStoreFunction; }
+	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return m_memoryLoadFunction; }
+	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return m_storageStoreFunction; }
+	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return m_storageLoadFunction; }
+	YulString hashFunction(YulString /*_type*/) const override { return m_hashFunction; }
 
 	static EVMDialect const& strictAssemblyForEVM(langutil::EVMVersion _version);
 	static EVMDialect const& strictAssemblyForEVMObjects(langutil::EVMVersion _version);
@@ -94,11 +98,34 @@ struct EVMDialect: public Dialect
 
 protected:
 	BuiltinFunctionForEVM const* verbatimFunction(size_t _arguments, size_t _returnVariables) const;
+	/// Fills the lookup tables of the builtins from @a m_functions. Has to be called again
+	/// by derived dialects after they changed the set of builtins.
+	void indexBuiltins();
 
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulString, BuiltinFunctionForEVM> m_functions;
-	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
+	/// The builtins indexed by the ID of their name. The names of the builtins are added to
+	/// the YulStringRepository when the dialect is created, so their IDs are small.
+	std::vector<BuiltinFunctionForEVM const*> m_builtinsByID;
+	BuiltinFunctionForEVM const* m_discardFunction = nullptr;
+	BuiltinFunctionForEVM const* m_equalityFunction = nullptr;
+	BuiltinFunctionForEVM const* m_booleanNegationFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryLoadFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageLoadFunction = nullptr;
+	YulString m_hashFunction;
+	/// Exclusive upper bound for the number of arguments and return variables of verbatim functions.
+	static constexpr size_t maxVerbatimCount = 100;
+	/// The verbatim functions indexed by number of arguments and return variables, created on first use.
+	/// Entries only change once from null to the function, so lookups from several threads only
+	/// have to lock when the function does not exist yet. Only allocated with object access.
+	std::unique_ptr<std::atomic<BuiltinFunctionForEVM const*>[]> m_verbatimFunctions;
+	/// Owns the verbatim functions.
+	std::vector<std::unique_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctionStorage;
+	/// Protects the creation of verbatim functions.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<YulString> m_reserved;
 };
 
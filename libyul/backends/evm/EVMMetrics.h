@@ -54,6 +54,10 @@ public:
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
 
+	EVMDialect const& dialect() const { return m_dialect; }
+	bool isCreation() const { return m_isCreation; }
+	bigint const& runs() const { return m_runs; }
+
 private:
 	bigint combineCosts(std::pair<bigint, bigint> _costs) const;
 
@@ -44,6 +44,11 @@ EthAssemblyAdapter::EthAssemblyAdapter(evmasm::Assembly& _assembly):
 {
 }
 
+void EthAssemblyAdapter::reserve(size_t _items)
+{
+	m_assembly.reserveItems(_items);
+}
+
 void EthAssemblyAdapter::setSourceLocation(SourceLocation const& _location)
 {
 	m_assembly.setSourceLocation(_location);
@@ -38,6 +38,7 @@ class EthAssemblyAdapter: public AbstractAssembly
 {
 public:
 	explicit EthAssemblyAdapter(evmasm::Assembly& _assembly);
+	void reserve(size_t _items) override;
 	void setSourceLocation(langutil::SourceLocation const& _location) override;
 	int stackHeight() const override;
 	void setStackHeight(int height) override;
@@ -23,9 +23,12 @@
 
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Instruction.h>
 
+#include <mutex>
+
 
 using namespace std;
 using namespace solidity;
@@ -156,3 +159,15 @@ NoOutputEVMDialect::NoOutputEVMDialect(EVMDialect const& _copyFrom):
 		};
 	}
 }
+
+NoOutputEVMDialect const& NoOutputEVMDialect::instance(EVMDialect const& _copyFrom)
+{
+	static map<pair<langutil::EVMVersion, bool>, unique_ptr<NoOutputEVMDialect const>> dialects;
+	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
+	unique_ptr<NoOutputEVMDialect const>& dialect = dialects[{_copyFrom.evmVersion(), _copyFrom.providesObjectAccess()}];
+	if (!dialect)
+		dialect = make_unique<NoOutputEVMDialect>(_copyFrom);
+	return *dialect;
+}
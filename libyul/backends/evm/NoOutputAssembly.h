@@ -85,7 +85,11 @@ private:
  */
 struct NoOutputEVMDialect: public EVMDialect
 {
+	/// Constructor, should only be used internally. Use the factory function below.
 	explicit NoOutputEVMDialect(EVMDialect const& _copyFrom);
+
+	/// @returns the shared dialect for the EVM version and object access of @a _copyFrom.
+	static NoOutputEVMDialect const& instance(EVMDialect const& _copyFrom);
 };
 
 
@@ -0,0 +1,373 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Code generator for translating Yul to EVM that plans the stack layout of each basic block
+ * of the control flow graph ahead of time.
+ */
+
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/NoOutputAssembly.h>
+#include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+namespace
+{
+
+langutil::SourceLocation extractSourceLocationFromDebugData(shared_ptr<DebugData const> const& _debugData)
+{
+	return _debugData ? _debugData->location : langutil::SourceLocation{};
+}
+
+}
+
+vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	AsmAnalysisInfo const& _analysisInfo,
+	Block const& _block,
+	EVMDialect const& _dialect,
+	BuiltinContext& _builtinContext
+)
+{
+	unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	StackLayout stackLayout = StackLayoutGenerator::run(*cfg);
+
+	// Slots that are out of reach are only detected while generating code, so the code is
+	// generated without output first, in order to leave the assembly untouched in that case.
+	{
+		NoOutputAssembly dryRunAssembly;
+		NoOutputEVMDialect const& dryRunDialect = NoOutputEVMDialect::instance(_dialect);
+		OptimizedEVMCodeTransform dryRun{dryRunAssembly, dryRunDialect, _builtinContext, *cfg, stackLayout};
+		dryRun.generate();
+		if (!dryRun.m_stackErrors.empty())
+			return move(dryRun.m_stackErrors);
+	}
+
+	OptimizedEVMCodeTransform codeTransform{_assembly, _dialect, _builtinContext, *cfg, stackLayout};
+	codeTransform.generate();
+	yulAssert(codeTransform.m_stackErrors.empty(), "");
+	return {};
+}
+
+OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	BuiltinContext& _builtinContext,
+	CFG const& _cfg,
+	StackLayout const& _stackLayout
+):
+	m_assembly(_assembly),
+	m_dialect(_dialect),
+	m_builtinContext(_builtinContext),
+	m_cfg(_cfg),
+	m_stackLayout(_stackLayout)
+{
+}
+
+void OptimizedEVMCodeTransform::generate()
+{
+	int const initialStackHeight = m_assembly.stackHeight();
+	m_assembly.setStackHeight(0);
+
+	// The entry layout of the main code can only consist of slots that can be generated.
+	createStackLayout(m_cfg.entry->debugData, m_stackLayout.blockInfos.at(m_cfg.entry).entryLayout);
+	(*this)(*m_cfg.entry);
+	for (Scope::Function const* function: m_cfg.functions)
+		(*this)(m_cfg.functionInfo.at(function));
+
+	m_assembly.setStackHeight(initialStackHeight);
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
+{
+	size_t const arguments = _call.functionCall->arguments.size();
+	size_t const returns = _call.function->returns.size();
+	size_t const consumed = arguments + (_call.canContinue ? 1 : 0);
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+	yulAssert(m_stack.size() >= consumed, "");
+	if (_call.canContinue)
+	{
+		auto const* returnLabelSlot = get_if<FunctionCallReturnLabelSlot>(&m_stack.at(m_stack.size() - consumed));
+		yulAssert(returnLabelSlot && returnLabelSlot->call == _call.functionCall, "");
+	}
+
+	m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_call.debugData));
+	m_assembly.appendJumpTo(
+		functionLabel(_call.function),
+		static_cast<int>(returns) - static_cast<int>(consumed),
+		AbstractAssembly::JumpType::IntoFunction
+	);
+	if (_call.canContinue)
+		m_assembly.appendLabel(returnLabel(_call.functionCall));
+
+	m_stack.resize(m_stack.size() - consumed);
+	for (size_t i = 0; i < returns; ++i)
+		m_stack.emplace_back(TemporarySlot{_call.functionCall, i});
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::BuiltinCall const& _call)
+{
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+	yulAssert(m_stack.size() >= _call.arguments, "");
+	// Look the builtin up again, since the dialect generating the code can differ from the one
+	// the control flow graph was built with.
+	BuiltinFunctionForEVM const* builtinPtr = m_dialect.builtin(_call.builtin->name);
+	yulAssert(builtinPtr, "");
+	BuiltinFunctionForEVM const& builtin = *builtinPtr;
+	vector<Expression> const& arguments = _call.functionCall->arguments;
+
+	m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_call.debugData));
+	builtin.generateCode(
+		*_call.functionCall,
+		m_assembly,
+		m_builtinContext,
+		[&](Expression const& _argument) {
+			// Arguments are already on the stack, except for literal arguments the builtin pushes itself.
+			for (size_t i = 0; i < arguments.size(); ++i)
+				if (&arguments[i] == &_argument && builtin.literalArgument(i))
+					m_assembly.appendConstant(valueOfLiteral(std::get<Literal>(_argument)));
+		}
+	);
+
+	m_stack.resize(m_stack.size() - _call.arguments);
+	for (size_t i = 0; i < builtin.returns.size(); ++i)
+		m_stack.emplace_back(TemporarySlot{_call.functionCall, i});
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::Assignment const& _assignment)
+{
+	yulAssert(m_stack.size() >= _assignment.variables.size(), "");
+	// Any remaining copies of the old values are outdated.
+	for (StackSlot& slot: m_stack)
+		if (auto const* variableSlot = get_if<VariableSlot>(&slot))
+			if (contains(_assignment.variables, *variableSlot))
+				slot = JunkSlot{};
+	size_t const base = m_stack.size() - _assignment.variables.size();
+	for (size_t i = 0; i < _assignment.variables.size(); ++i)
+		m_stack[base + i] = _assignment.variables[i];
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
+{
+	yulAssert(m_generated.insert(&_block).second, "");
+	m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_block.debugData));
+
+	StackLayout::BlockInfo const& blockInfo = m_stackLayout.blockInfos.at(&_block);
+	yulAssert(areLayoutsCompatible(m_stack, blockInfo.entryLayout), "");
+	m_stack = blockInfo.entryLayout;
+	m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+
+	// Blocks with several entries can be jumped to after they have been generated.
+	if (m_blockLabels.count(&_block) || _block.entries.size() > 1)
+		m_assembly.appendLabel(blockLabel(&_block));
+
+	for (CFG::Operation const& operation: _block.operations)
+	{
+		createStackLayout(
+			std::visit([](auto const& _operation) { return _operation.debugData; }, operation.operation),
+			m_stackLayout.operationEntryLayout.at(&operation)
+		);
+		size_t const base = m_stack.size() - operation.input.size();
+		std::visit(*this, operation.operation);
+		yulAssert(m_stack.size() == base + operation.output.size(), "");
+		for (size_t i = 0; i < operation.output.size(); ++i)
+			yulAssert(m_stack[base + i] == operation.output[i], "");
+	}
+
+	std::visit(GenericVisitor{
+		[&](CFG::BasicBlock::MainExit const&)
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::STOP);
+		},
+		[&](CFG::BasicBlock::Jump const& _jump)
+		{
+			createStackLayout(_jump.debugData, m_stackLayout.blockInfos.at(_jump.target).entryLayout);
+			// A block that is only entered from here directly follows without a label.
+			if (!m_blockLabels.count(_jump.target) && _jump.target->entries.size() == 1)
+			{
+				yulAssert(!_jump.backwards, "");
+				(*this)(*_jump.target);
+			}
+			else if (m_generated.count(_jump.target))
+				m_assembly.appendJumpTo(blockLabel(_jump.target));
+			else
+			{
+				blockLabel(_jump.target);
+				(*this)(*_jump.target);
+			}
+		},
+		[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+		{
+			createStackLayout(_conditionalJump.debugData, blockInfo.exitLayout);
+			yulAssert(!m_stack.empty() && m_stack.back() == _conditionalJump.condition, "");
+			m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_conditionalJump.debugData));
+			m_assembly.appendJumpToIf(blockLabel(_conditionalJump.nonZero));
+			m_stack.pop_back();
+
+			Stack const stackAfterJump = m_stack;
+			if (m_generated.count(_conditionalJump.zero))
+			{
+				yulAssert(areLayoutsCompatible(m_stack, m_stackLayout.blockInfos.at(_conditionalJump.zero).entryLayout), "");
+				m_assembly.appendJumpTo(blockLabel(_conditionalJump.zero));
+			}
+			else
+				(*this)(*_conditionalJump.zero);
+
+			// The code of every block ends with leaving it, so the non-zero case starts from the jump.
+			if (!m_generated.count(_conditionalJump.nonZero))
+			{
+				m_stack = stackAfterJump;
+				m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+				(*this)(*_conditionalJump.nonZero);
+			}
+		},
+		[&](CFG::BasicBlock::FunctionReturn const& _functionReturn)
+		{
+			yulAssert(m_currentFunctionInfo && m_currentFunctionInfo == _functionReturn.info, "");
+			createStackLayout(_functionReturn.debugData, blockInfo.exitLayout);
+			m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_functionReturn.debugData));
+			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+		},
+		[&](CFG::BasicBlock::Terminated const&)
+		{
+			// The last operation does not return.
+		}
+	}, _block.exit);
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::FunctionInfo const& _functionInfo)
+{
+	yulAssert(!m_currentFunctionInfo, "");
+	ScopedSaveAndRestore saveFunctionInfo(m_currentFunctionInfo, &_functionInfo);
+
+	// The caller provides the return label below the arguments, the first argument being at the top.
+	m_stack.clear();
+	if (_functionInfo.canContinue)
+		m_stack.emplace_back(FunctionReturnLabelSlot{_functionInfo.function});
+	for (auto it = _functionInfo.parameters.rbegin(); it != _functionInfo.parameters.rend(); ++it)
+		m_stack.emplace_back(*it);
+	m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+	m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_functionInfo.debugData));
+	m_assembly.appendLabel(functionLabel(_functionInfo.function));
+
+	createStackLayout(_functionInfo.debugData, m_stackLayout.blockInfos.at(_functionInfo.entry).entryLayout);
+	(*this)(*_functionInfo.entry);
+
+	m_stack.clear();
+	m_assembly.setStackHeight(0);
+}
+
+void OptimizedEVMCodeTransform::createStackLayout(shared_ptr<DebugData const> const& _debugData, Stack _targetStack)
+{
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+	m_assembly.setSourceLocation(extractSourceLocationFromDebugData(_debugData));
+	::createStackLayout(
+		m_stack,
+		_targetStack,
+		[&](unsigned _depth) {
+			yulAssert(_depth > 0 && _depth < m_stack.size(), "");
+			if (_depth <= 16)
+				m_assembly.appendInstruction(evmasm::swapInstruction(_depth));
+			else
+				m_stackErrors.emplace_back(
+					YulString{},
+					static_cast<int>(_depth) - 16,
+					"Cannot swap a slot " + to_string(_depth - 16) + " slots too deep in the stack."
+				);
+		},
+		[&](StackSlot const& _slot) {
+			if (!holds_alternative<JunkSlot>(_slot))
+				if (optional<size_t> depth = findDepth(m_stack, _slot))
+				{
+					if (*depth < 16)
+					{
+						m_assembly.appendInstruction(evmasm::dupInstruction(static_cast<unsigned>(*depth + 1)));
+						return;
+					}
+					else if (!canBeFreelyGenerated(_slot))
+					{
+						m_stackErrors.emplace_back(
+							YulString{},
+							static_cast<int>(*depth) - 15,
+							"Cannot duplicate a slot " + to_string(*depth - 15) + " slots too deep in the stack."
+						);
+						m_assembly.setStackHeight(m_assembly.stackHeight() + 1);
+						return;
+					}
+				}
+			std::visit(GenericVisitor{
+				[&](LiteralSlot const& _literal) { m_assembly.appendConstant(_literal.value); },
+				[&](FunctionCallReturnLabelSlot const& _returnLabel) {
+					m_assembly.appendLabelReference(returnLabel(_returnLabel.call));
+				},
+				[&](FunctionReturnLabelSlot const&) { yulAssert(false, "Return label not on the stack."); },
+				[&](VariableSlot const& _variable) {
+					// Return variables that have not been assigned yet are zero.
+					yulAssert(
+						m_currentFunctionInfo && contains(m_currentFunctionInfo->returnVariables, _variable),
+						"Variable not on the stack."
+					);
+					m_assembly.appendConstant(0);
+				},
+				[&](TemporarySlot const&) { yulAssert(false, "Function call result not on the stack."); },
+				[&](JunkSlot const&) {
+					// Any value will do, so use the cheapest instruction that pushes one.
+					m_assembly.appendInstruction(evmasm::Instruction::CODESIZE);
+				}
+			}, _slot);
+		},
+		[&]() { m_assembly.appendInstruction(evmasm::Instruction::POP); }
+	);
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::functionLabel(Scope::Function const* _function)
+{
+	if (!m_functionLabels.count(_function))
+		m_functionLabels[_function] = m_assembly.newLabelId();
+	return m_functionLabels.at(_function);
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::returnLabel(FunctionCall const* _call)
+{
+	if (!m_returnLabels.count(_call))
+		m_returnLabels[_call] = m_assembly.newLabelId();
+	return m_returnLabels.at(_call);
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::blockLabel(CFG::BasicBlock const* _block)
+{
+	if (!m_blockLabels.count(_block))
+		m_blockLabels[_block] = m_assembly.newLabelId();
+	return m_blockLabels.at(_block);
+}
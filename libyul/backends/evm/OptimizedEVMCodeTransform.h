@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Code generator for translating Yul to EVM that plans the stack layout of each basic block
+ * of the control flow graph ahead of time.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/AbstractAssembly.h>
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/Exceptions.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+struct BuiltinContext;
+struct EVMDialect;
+struct StackLayout;
+
+class OptimizedEVMCodeTransform
+{
+public:
+	/// Generates code for @a _block and appends it to @a _assembly.
+	/// @returns the errors caused by slots that were out of reach. In that case,
+	/// nothing is appended to @a _assembly.
+	[[nodiscard]] static std::vector<StackTooDeepError> run(
+		AbstractAssembly& _assembly,
+		AsmAnalysisInfo const& _analysisInfo,
+		Block const& _block,
+		EVMDialect const& _dialect,
+		BuiltinContext& _builtinContext
+	);
+
+	OptimizedEVMCodeTransform(OptimizedEVMCodeTransform const&) = delete;
+	OptimizedEVMCodeTransform& operator=(OptimizedEVMCodeTransform const&) = delete;
+
+	/// Generate code for the operations. The inputs are expected at the stack top.
+	void operator()(CFG::FunctionCall const& _call);
+	void operator()(CFG::BuiltinCall const& _call);
+	void operator()(CFG::Assignment const& _assignment);
+
+private:
+	OptimizedEVMCodeTransform(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		BuiltinContext& _builtinContext,
+		CFG const& _cfg,
+		StackLayout const& _stackLayout
+	);
+
+	/// Generates the main code followed by all functions.
+	void generate();
+	/// Generates the code of @a _block, starting from the current stack, and recursively
+	/// the code of its successors that have not been generated yet.
+	void operator()(CFG::BasicBlock const& _block);
+	void operator()(CFG::FunctionInfo const& _functionInfo);
+
+	/// Shuffles the current stack to @a _targetStack.
+	void createStackLayout(std::shared_ptr<DebugData const> const& _debugData, Stack _targetStack);
+
+	AbstractAssembly::LabelID functionLabel(Scope::Function const* _function);
+	AbstractAssembly::LabelID returnLabel(FunctionCall const* _call);
+	AbstractAssembly::LabelID blockLabel(CFG::BasicBlock const* _block);
+
+	AbstractAssembly& m_assembly;
+	/// The dialect whose builtins generate the code.
+	EVMDialect const& m_dialect;
+	BuiltinContext& m_builtinContext;
+	CFG const& m_cfg;
+	StackLayout const& m_stackLayout;
+	/// The stack as it is at the current point of code generation.
+	Stack m_stack;
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> m_functionLabels;
+	std::map<FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
+	std::map<CFG::BasicBlock const*, AbstractAssembly::LabelID> m_blockLabels;
+	/// Blocks whose code has already been generated.
+	std::set<CFG::BasicBlock const*> m_generated;
+	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
+	std::vector<StackTooDeepError> m_stackErrors;
+};
+
+}
@@ -0,0 +1,266 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Utilities to transform one stack layout into another using SWAP, DUP, PUSH and POP.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/Exceptions.h>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+/// @returns the depth of the topmost occurrence of @a _slot in @a _stack, starting with zero at the top.
+inline std::optional<size_t> findDepth(Stack const& _stack, StackSlot const& _slot)
+{
+	for (size_t depth = 0; depth < _stack.size(); ++depth)
+		if (_stack[_stack.size() - 1 - depth] == _slot)
+			return depth;
+	return std::nullopt;
+}
+
+/// @returns true if @a _stack can be used where @a _target is expected, i.e. if both have the same
+/// size and all slots agree, except for the ones that do not matter in @a _target.
+inline bool areLayoutsCompatible(Stack const& _stack, Stack const& _target)
+{
+	if (_stack.size() != _target.size())
+		return false;
+	for (size_t i = 0; i < _stack.size(); ++i)
+		if (!std::holds_alternative<JunkSlot>(_target[i]) && !(_stack[i] == _target[i]))
+			return false;
+	return true;
+}
+
+/**
+ * Shuffles a source stack layout into a target layout, one stack operation per step.
+ *
+ * The operations are performed on an object of type @a ShuffleOperations that is newly constructed
+ * in each step and has to provide:
+ * - isCompatible(source, target): whether the source slot at the given offset can stay at the target offset.
+ * - sourceIsSame(lhs, rhs): whether the source slots at the given offsets are equal.
+ * - sourceMultiplicity(offset): how many more copies of the source slot at the given offset
+ *   are needed in the target; negative, if there are too many.
+ * - targetMultiplicity(offset): the same for the target slot at the given offset.
+ * - targetIsArbitrary(offset): whether the target slot at the given offset may be anything.
+ * - swap(depth), pop(), pushOrDupTarget(offset): the stack operations.
+ * - sourceSize(), targetSize().
+ * Offsets are counted from the bottom of the stack.
+ */
+template<typename ShuffleOperations>
+class Shuffler
+{
+public:
+	/// Performs the shuffling. Afterwards source and target have the same size and all slots
+	/// of the source are compatible with the target slots at the same offset.
+	template<typename... Args>
+	static void shuffle(Args&&... _args)
+	{
+		// The shuffling is expected to terminate well within this limit;
+		// the limit only guards against infinite loops due to bugs.
+		size_t iterations = 0;
+		bool needsMoreShuffling = true;
+		while (iterations < 1000 && (needsMoreShuffling = shuffleStep(std::forward<Args>(_args)...)))
+			++iterations;
+		yulAssert(!needsMoreShuffling, "Could not create stack layout after 1000 iterations.");
+	}
+
+private:
+	/// Pushes or duplicates a slot that eventually allows fixing the target slot at @a _targetOffset.
+	/// If more copies of the slot at @a _targetOffset are needed, it is produced directly.
+	/// Otherwise, there is a copy of it at some offset that is not yet in place and the slot
+	/// that is supposed to end up at that offset is (recursively) produced instead: once it is
+	/// swapped into place, the copy ends up at the stack top.
+	/// @returns false if no such slot was found.
+	static bool bringUpTargetSlot(ShuffleOperations& _ops, size_t _targetOffset)
+	{
+		std::list<size_t> toVisit{_targetOffset};
+		std::set<size_t> visited;
+		while (!toVisit.empty())
+		{
+			size_t offset = toVisit.front();
+			toVisit.pop_front();
+			if (!visited.insert(offset).second)
+				continue;
+			if (_ops.targetMultiplicity(offset) > 0)
+			{
+				_ops.pushOrDupTarget(offset);
+				return true;
+			}
+			for (size_t next = 0; next < std::min(_ops.sourceSize(), _ops.targetSize()); ++next)
+				if (!_ops.isCompatible(next, next) && _ops.isCompatible(next, offset) && !visited.count(next))
+					toVisit.emplace_back(next);
+		}
+		return false;
+	}
+
+	/// Performs a single stack operation.
+	/// @returns false if the source is already compatible with the target.
+	template<typename... Args>
+	static bool shuffleStep(Args&&... _args)
+	{
+		ShuffleOperations ops{std::forward<Args>(_args)...};
+		size_t const commonSize = std::min(ops.sourceSize(), ops.targetSize());
+
+		auto isInPlace = [&](size_t _offset) { return ops.isCompatible(_offset, _offset); };
+		bool allInPlace = true;
+		for (size_t offset = 0; offset < ops.sourceSize(); ++offset)
+			if (!isInPlace(offset))
+			{
+				allInPlace = false;
+				break;
+			}
+		if (allInPlace)
+		{
+			if (ops.sourceSize() == ops.targetSize())
+				return false;
+			// The source is a prefix of the target: produce the next target slot.
+			yulAssert(bringUpTargetSlot(ops, ops.sourceSize()), "");
+			return true;
+		}
+
+		size_t const sourceTop = ops.sourceSize() - 1;
+		// The stack top is not needed anymore and does not fill an arbitrary slot.
+		if (ops.sourceMultiplicity(sourceTop) < 0 && !ops.targetIsArbitrary(sourceTop))
+		{
+			ops.pop();
+			return true;
+		}
+
+		// The stack top is not in place: swap it to a lower position that wants it.
+		if (!isInPlace(sourceTop) || ops.targetIsArbitrary(sourceTop))
+			for (size_t offset = 0; offset < commonSize; ++offset)
+				if (
+					!isInPlace(offset) &&
+					!ops.sourceIsSame(offset, sourceTop) &&
+					ops.isCompatible(sourceTop, offset)
+				)
+				{
+					ops.swap(sourceTop - offset);
+					return true;
+				}
+
+		// Fix the lowest slot that is not in place.
+		for (size_t offset = 0; offset < commonSize; ++offset)
+			if (!isInPlace(offset) && bringUpTargetSlot(ops, offset))
+				return true;
+
+		// Everything that is needed is on the stack, but something that has to be removed or moved
+		// is not at the top. Bring the lowest such slot to the top.
+		for (size_t offset = 0; offset < ops.sourceSize(); ++offset)
+			if (!isInPlace(offset) && !ops.sourceIsSame(offset, sourceTop))
+			{
+				ops.swap(sourceTop - offset);
+				return true;
+			}
+
+		// All slots that are not in place are equal to the stack top.
+		if (ops.sourceSize() < ops.targetSize())
+		{
+			yulAssert(bringUpTargetSlot(ops, ops.sourceSize()), "");
+			return true;
+		}
+		ops.pop();
+		return true;
+	}
+};
+
+/// Transforms @a _currentStack into @a _targetStack, calling @a _swap(depth),
+/// @a _pushOrDup(slot) and @a _pop() for every stack operation. Junk slots in the target may be
+/// filled with anything. The remaining slots of the target have to be present in @a _currentStack
+/// or be generated by @a _pushOrDup.
+/// Afterwards @a _currentStack is equal to @a _targetStack.
+template<typename Swap, typename PushOrDup, typename Pop>
+void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
+{
+	struct ShuffleOperations
+	{
+		Stack& currentStack;
+		Stack const& targetStack;
+		Swap swapCallback;
+		PushOrDup pushOrDupCallback;
+		Pop popCallback;
+		std::map<StackSlot, int> multiplicity;
+
+		ShuffleOperations(Stack& _current, Stack const& _target, Swap _swap, PushOrDup _pushOrDup, Pop _pop):
+			currentStack(_current),
+			targetStack(_target),
+			swapCallback(_swap),
+			pushOrDupCallback(_pushOrDup),
+			popCallback(_pop)
+		{
+			for (StackSlot const& slot: currentStack)
+				--multiplicity[slot];
+			for (size_t offset = 0; offset < targetStack.size(); ++offset)
+				// Whatever is in an arbitrary slot can stay there.
+				if (std::holds_alternative<JunkSlot>(targetStack[offset]) && offset < currentStack.size())
+					++multiplicity[currentStack[offset]];
+				else
+					++multiplicity[targetStack[offset]];
+		}
+		bool isCompatible(size_t _source, size_t _target)
+		{
+			return
+				_source < currentStack.size() &&
+				_target < targetStack.size() &&
+				(
+					std::holds_alternative<JunkSlot>(targetStack[_target]) ||
+					currentStack[_source] == targetStack[_target]
+				);
+		}
+		bool sourceIsSame(size_t _lhs, size_t _rhs) { return currentStack[_lhs] == currentStack[_rhs]; }
+		int sourceMultiplicity(size_t _offset) { return multiplicity.at(currentStack[_offset]); }
+		int targetMultiplicity(size_t _offset) { return multiplicity.at(targetStack[_offset]); }
+		bool targetIsArbitrary(size_t _offset)
+		{
+			return _offset < targetStack.size() && std::holds_alternative<JunkSlot>(targetStack[_offset]);
+		}
+		void swap(size_t _depth)
+		{
+			swapCallback(static_cast<unsigned>(_depth));
+			std::swap(currentStack[currentStack.size() - _depth - 1], currentStack.back());
+		}
+		size_t sourceSize() { return currentStack.size(); }
+		size_t targetSize() { return targetStack.size(); }
+		void pop()
+		{
+			popCallback();
+			currentStack.pop_back();
+		}
+		void pushOrDupTarget(size_t _offset)
+		{
+			StackSlot const& slot = targetStack[_offset];
+			pushOrDupCallback(slot);
+			currentStack.push_back(slot);
+		}
+	};
+
+	Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
+
+	yulAssert(areLayoutsCompatible(_currentStack, _targetStack), "");
+	_currentStack = _targetStack;
+}
+
+}
@@ -0,0 +1,369 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Stack layout generator for the stack-layout-aware Yul to EVM code transform.
+ */
+
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+
+#include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+namespace
+{
+
+/// @returns the slots of @a _post that have to be on the stack before an operation with outputs
+/// @a _operationOutput, in the order in which they appear in @a _post.
+Stack createIdealLayout(Stack const& _operationOutput, Stack const& _post)
+{
+	Stack layout;
+	for (StackSlot const& slot: _post)
+		if (!canBeFreelyGenerated(slot) && !contains(_operationOutput, slot) && !contains(layout, slot))
+			layout.emplace_back(slot);
+	return layout;
+}
+
+/// @returns true if all slots of @a _target that cannot be generated are contained in @a _source.
+bool providesAllSlots(Stack const& _source, Stack const& _target)
+{
+	for (StackSlot const& slot: _target)
+		if (!canBeFreelyGenerated(slot) && !contains(_source, slot))
+			return false;
+	return true;
+}
+
+}
+
+StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+{
+	StackLayout layout;
+	StackLayoutGenerator generator{layout};
+	generator.processEntryPoint(*_cfg.entry);
+	for (Scope::Function const* function: _cfg.functions)
+		generator.processEntryPoint(*_cfg.functionInfo.at(function).entry);
+	return layout;
+}
+
+Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG::Operation const& _operation)
+{
+	// Keep everything that is needed after the operation, except for its results,
+	// and put the inputs of the operation on top.
+	Stack stack = createIdealLayout(_operation.output, _exitStack);
+	stack += _operation.input;
+
+	m_layout.operationEntryLayout[&_operation] = stack;
+
+	// The code transform creates the exact layout before the operation anyway, so slots at the top
+	// that can be generated or duplicated from deeper in the stack need not be provided beforehand.
+	while (!stack.empty())
+	{
+		StackSlot const& top = stack.back();
+		if (canBeFreelyGenerated(top))
+		{
+			stack.pop_back();
+			continue;
+		}
+		Stack below(stack.begin(), prev(stack.end()));
+		if (optional<size_t> depth = findDepth(below, top); depth && *depth + 1 <= 16)
+		{
+			stack.pop_back();
+			continue;
+		}
+		break;
+	}
+	return stack;
+}
+
+Stack StackLayoutGenerator::propagateStackThroughBlock(Stack _exitStack, CFG::BasicBlock const& _block)
+{
+	Stack stack = move(_exitStack);
+	for (auto it = _block.operations.rbegin(); it != _block.operations.rend(); ++it)
+		stack = propagateStackThroughOperation(move(stack), *it);
+	return stack;
+}
+
+void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry)
+{
+	list<CFG::BasicBlock const*> toVisit{&_entry};
+	set<CFG::BasicBlock const*> visited;
+	list<pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> backwardsJumps = collectBackwardsJumps(_entry);
+
+	// Changes of an entry layout are propagated to the predecessors of the block. The number of
+	// such revisits is bounded to guarantee termination; the remaining mismatches are fixed below.
+	size_t revisitBudget = 0;
+	BreadthFirstSearch<CFG::BasicBlock const*>{{&_entry}}.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+		revisitBudget += 32;
+		std::visit(GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) { _addChild(_jump.target); },
+			[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+				_addChild(_jump.zero);
+				_addChild(_jump.nonZero);
+			},
+			[](auto const&) {}
+		}, _block->exit);
+	});
+
+	for (size_t round = 0; !toVisit.empty(); ++round)
+	{
+		yulAssert(round < 1000, "Could not determine consistent stack layouts.");
+		while (!toVisit.empty())
+		{
+			CFG::BasicBlock const* block = toVisit.front();
+			toVisit.pop_front();
+			if (visited.count(block))
+				continue;
+
+			if (optional<Stack> exitLayout = getExitLayoutOrStageDependencies(*block, visited, toVisit))
+			{
+				visited.emplace(block);
+				StackLayout::BlockInfo& info = m_layout.blockInfos[block];
+				info.exitLayout = move(*exitLayout);
+				Stack entryLayout = propagateStackThroughBlock(info.exitLayout, *block);
+				bool changed = entryLayout != info.entryLayout;
+				info.entryLayout = move(entryLayout);
+
+				for (CFG::BasicBlock const* entry: block->entries)
+				{
+					if (changed && visited.count(entry) && revisitBudget > 0)
+					{
+						--revisitBudget;
+						visited.erase(entry);
+					}
+					toVisit.emplace_back(entry);
+				}
+			}
+		}
+
+		// A block that jumps back to the start of a loop was processed using the layout of the
+		// loop start that was known at that time. If the loop start now requires more, the loop
+		// is visited again.
+		for (auto&& [jumpingBlock, target]: backwardsJumps)
+			if (!providesAllSlots(
+				m_layout.blockInfos.at(jumpingBlock).exitLayout,
+				m_layout.blockInfos.at(target).entryLayout
+			))
+			{
+				toVisit.emplace_front(jumpingBlock);
+				for (CFG::BasicBlock const* entry: target->entries)
+					visited.erase(entry);
+				BreadthFirstSearch<CFG::BasicBlock const*>{{jumpingBlock}}.run(
+					[&, target = target](CFG::BasicBlock const* _block, auto&& _addChild) {
+						visited.erase(_block);
+						if (_block == target)
+							return;
+						for (CFG::BasicBlock const* entry: _block->entries)
+							_addChild(entry);
+					}
+				);
+			}
+
+		// Blocks whose successors changed after they were processed are visited again.
+		if (toVisit.empty())
+			BreadthFirstSearch<CFG::BasicBlock const*>{{&_entry}}.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+				Stack const& exitLayout = m_layout.blockInfos.at(_block).exitLayout;
+				auto check = [&](CFG::BasicBlock const* _target, Stack const& _available) {
+					if (!providesAllSlots(_available, m_layout.blockInfos.at(_target).entryLayout))
+					{
+						visited.erase(_block);
+						toVisit.emplace_back(_block);
+					}
+				};
+				std::visit(GenericVisitor{
+					[&](CFG::BasicBlock::Jump const& _jump) {
+						check(_jump.target, exitLayout);
+						if (!_jump.backwards)
+							_addChild(_jump.target);
+					},
+					[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+						check(_jump.zero, exitLayout);
+						check(_jump.nonZero, exitLayout);
+						_addChild(_jump.zero);
+						_addChild(_jump.nonZero);
+					},
+					[](auto const&) {}
+				}, _block->exit);
+			});
+	}
+
+	stitchConditionalJumps(_entry);
+}
+
+optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
+	CFG::BasicBlock const& _block,
+	set<CFG::BasicBlock const*> const& _visited,
+	list<CFG::BasicBlock const*>& _toVisit
+) const
+{
+	return std::visit(GenericVisitor{
+		[&](CFG::BasicBlock::MainExit const&) -> optional<Stack>
+		{
+			return Stack{};
+		},
+		[&](CFG::BasicBlock::Jump const& _jump) -> optional<Stack>
+		{
+			if (_jump.backwards)
+			{
+				// The layout of the loop start may not be final yet, which is checked afterwards.
+				if (auto const* info = valueOrNullptr(m_layout.blockInfos, _jump.target))
+					return info->entryLayout;
+				return Stack{};
+			}
+			if (_visited.count(_jump.target))
+				return m_layout.blockInfos.at(_jump.target).entryLayout;
+			_toVisit.emplace_front(_jump.target);
+			return nullopt;
+		},
+		[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump) -> optional<Stack>
+		{
+			bool zeroVisited = _visited.count(_conditionalJump.zero);
+			bool nonZeroVisited = _visited.count(_conditionalJump.nonZero);
+			if (zeroVisited && nonZeroVisited)
+			{
+				Stack stack = combineStack(
+					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
+					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
+				);
+				// The condition is consumed by the jump.
+				stack.emplace_back(_conditionalJump.condition);
+				return stack;
+			}
+			if (!zeroVisited)
+				_toVisit.emplace_front(_conditionalJump.zero);
+			if (!nonZeroVisited)
+				_toVisit.emplace_front(_conditionalJump.nonZero);
+			return nullopt;
+		},
+		[&](CFG::BasicBlock::FunctionReturn const& _functionReturn) -> optional<Stack>
+		{
+			// The return values are expected in order, followed by the return label.
+			yulAssert(_functionReturn.info, "");
+			Stack stack(_functionReturn.info->returnVariables.begin(), _functionReturn.info->returnVariables.end());
+			stack.emplace_back(FunctionReturnLabelSlot{_functionReturn.info->function});
+			return stack;
+		},
+		[&](CFG::BasicBlock::Terminated const&) -> optional<Stack>
+		{
+			return Stack{};
+		}
+	}, _block.exit);
+}
+
+list<pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> StackLayoutGenerator::collectBackwardsJumps(
+	CFG::BasicBlock const& _entry
+) const
+{
+	list<pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> backwardsJumps;
+	BreadthFirstSearch<CFG::BasicBlock const*>{{&_entry}}.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+		std::visit(GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump)
+			{
+				if (_jump.backwards)
+					backwardsJumps.emplace_back(_block, _jump.target);
+				_addChild(_jump.target);
+			},
+			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+			{
+				_addChild(_conditionalJump.zero);
+				_addChild(_conditionalJump.nonZero);
+			},
+			[](auto const&) {}
+		}, _block->exit);
+	});
+	return backwardsJumps;
+}
+
+void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _entry)
+{
+	set<CFG::BasicBlock const*> stitched;
+	BreadthFirstSearch<CFG::BasicBlock const*>{{&_entry}}.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+		StackLayout::BlockInfo const& info = m_layout.blockInfos.at(_block);
+		std::visit(GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump)
+			{
+				if (!_jump.backwards)
+					_addChild(_jump.target);
+			},
+			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+			{
+				Stack exitLayout = info.exitLayout;
+				yulAssert(!exitLayout.empty() && exitLayout.back() == _conditionalJump.condition, "");
+				exitLayout.pop_back();
+
+				// Both targets are entered with the stack left by the jump. What a target does not need is junk.
+				for (CFG::BasicBlock const* target: {_conditionalJump.zero, _conditionalJump.nonZero})
+				{
+					bool inserted = stitched.insert(target).second;
+					yulAssert(inserted, "Block is the target of more than one conditional jump.");
+					Stack& targetEntryLayout = m_layout.blockInfos.at(target).entryLayout;
+					yulAssert(providesAllSlots(exitLayout, targetEntryLayout), "");
+					Stack newEntryLayout = exitLayout;
+					for (StackSlot& slot: newEntryLayout)
+						if (!contains(targetEntryLayout, slot))
+							slot = JunkSlot{};
+					targetEntryLayout = move(newEntryLayout);
+				}
+				_addChild(_conditionalJump.zero);
+				_addChild(_conditionalJump.nonZero);
+			},
+			[](auto const&) {}
+		}, _block->exit);
+	});
+}
+
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+{
+	// Keep the slots in the order of one of the stacks and append what only the other one needs.
+	auto merge = [](Stack const& _first, Stack const& _second) {
+		Stack result;
+		for (Stack const* stack: {&_first, &_second})
+			for (StackSlot const& slot: *stack)
+				if (!canBeFreelyGenerated(slot) && !contains(result, slot))
+					result.emplace_back(slot);
+		return result;
+	};
+	Stack candidate1 = merge(_stack1, _stack2);
+	Stack candidate2 = merge(_stack2, _stack1);
+	if (candidate1 == candidate2)
+		return candidate1;
+
+	auto cost = [&](Stack const& _candidate) {
+		size_t operations = 0;
+		for (Stack const* target: {&_stack1, &_stack2})
+		{
+			Stack stack = _candidate;
+			createStackLayout(
+				stack,
+				*target,
+				[&](unsigned) { ++operations; },
+				[&](StackSlot const&) { ++operations; },
+				[&]() { ++operations; }
+			);
+		}
+		return operations;
+	};
+	return cost(candidate2) < cost(candidate1) ? candidate2 : candidate1;
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Stack layout generator for the stack-layout-aware Yul to EVM code transform.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct StackLayout
+{
+	struct BlockInfo
+	{
+		/// The complete stack layout that is required for entering the block.
+		Stack entryLayout;
+		/// The stack layout after executing the block, directly before its exit.
+		Stack exitLayout;
+	};
+	std::map<CFG::BasicBlock const*, BlockInfo> blockInfos;
+	/// For each operation the complete stack layout directly before it, which has the inputs of the
+	/// operation at the top and keeps everything that is needed afterwards below them.
+	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+};
+
+/**
+ * Determines the stack layouts at the entry and exit of each basic block and before each operation.
+ *
+ * The layouts are propagated backwards from the exits of the control flow graph, such that each
+ * operation finds its inputs at the stack top and the slots that are needed later are kept
+ * in the order in which they are needed. Blocks that jump backwards are revisited until they
+ * provide everything that is needed at the start of the loop.
+ */
+class StackLayoutGenerator
+{
+public:
+	static StackLayout run(CFG const& _cfg);
+
+private:
+	explicit StackLayoutGenerator(StackLayout& _layout): m_layout(_layout) {}
+
+	/// @returns the layout before @a _operation, such that @a _exitStack can be created cheaply
+	/// afterwards. Records the exact layout required by the operation.
+	Stack propagateStackThroughOperation(Stack _exitStack, CFG::Operation const& _operation);
+	/// @returns the entry layout of @a _block, given its exit layout.
+	Stack propagateStackThroughBlock(Stack _exitStack, CFG::BasicBlock const& _block);
+
+	/// Determines the layouts of all blocks reachable from @a _entry.
+	void processEntryPoint(CFG::BasicBlock const& _entry);
+	/// @returns the exit layout of @a _block, if the entry layouts of all its successors are known.
+	/// Otherwise, stages the successors for visiting and returns nothing.
+	std::optional<Stack> getExitLayoutOrStageDependencies(
+		CFG::BasicBlock const& _block,
+		std::set<CFG::BasicBlock const*> const& _visited,
+		std::list<CFG::BasicBlock const*>& _toVisit
+	) const;
+	/// @returns pairs of a block and the start of the loop it jumps back to.
+	std::list<std::pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> collectBackwardsJumps(
+		CFG::BasicBlock const& _entry
+	) const;
+	/// Makes the entry layouts of the targets of conditional jumps equal to the layout left by the jump,
+	/// marking slots that are not needed by the target as junk.
+	void stitchConditionalJumps(CFG::BasicBlock const& _entry);
+
+	/// @returns a layout from which both @a _stack1 and @a _stack2 can be created cheaply.
+	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+
+	StackLayout& m_layout;
+};
+
+}
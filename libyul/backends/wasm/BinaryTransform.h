@@ -33,35 +33,40 @@ namespace solidity::yul::wasm
 
 /**
  * Web assembly to binary transform.
+ *
+ * All parts of the module are appended to a single output buffer. Since the size of sections
+ * and function bodies precedes their contents, it is inserted once they are complete.
  */
 class BinaryTransform
 {
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
 	BinaryTransform(
+		bytes& _output,
 		std::map<std::string, size_t> _globalIDs,
 		std::map<std::string, size_t> _functionIDs,
 		std::map<std::string, size_t> _functionTypes,
 		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
 	):
+		m_output(_output),
 		m_globalIDs(std::move(_globalIDs)),
 		m_functionIDs(std::move(_functionIDs)),
 		m_functionTypes(std::move(_functionTypes)),
@@ -87,28 +92,32 @@ private:
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
-	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
-	static bytes importSection(
+	/// The section functions append the respective section to @a _output.
+	static void typeSection(bytes& _output, std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
+	static void importSection(
+		bytes& _output,
 		std::vector<wasm::FunctionImport> const& _imports,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes functionSection(
+	static void functionSection(
+		bytes& _output,
 		std::vector<wasm::FunctionDefinition> const& _functions,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes memorySection();
-	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
-	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static void memorySection(bytes& _output);
+	static void globalSection(bytes& _output, std::vector<wasm::GlobalVariableDeclaration> const& _globals);
+	static void exportSection(bytes& _output, std::map<std::string, size_t> const& _functionIDs);
+	static void customSection(bytes& _output, std::string const& _name, bytes const& _data);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
 
-	bytes encodeLabelIdx(std::string const& _label) const;
+	size_t labelIdx(std::string const& _label) const;
 
-	static bytes encodeName(std::string const& _name);
+	static void encodeName(bytes& _output, std::string const& _name);
 
+	/// The buffer the code section is appended to.
+	bytes& m_output;
 	std::map<std::string, size_t> const m_globalIDs;
 	std::map<std::string, size_t> const m_functionIDs;
 	std::map<std::string, size_t> const m_functionTypes;
@@ -121,4 +130,3 @@ private:
 };
 
 }
-
@@ -23,6 +23,7 @@
 
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/backends/wasm/WasmDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/MainFunction.h>
@@ -56,16 +57,103 @@
 #include <ewasmPolyfills/Logical.h>
 #include <ewasmPolyfills/Memory.h>
 
+#include <range/v3/view/map.hpp>
+
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The polyfill functions, shared by all translations.
+struct Polyfill
+{
+	/// The function definitions, which must not be modified.
+	std::shared_ptr<Block const> code;
+	/// The names of the polyfill functions.
+	std::set<YulString> functions;
+	/// The functions (and builtins) called by each polyfill function.
+	CallGraph callGraph;
+};
+
+shared_ptr<Polyfill const> parsePolyfill()
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
+		"{" +
+			string(solidity::yul::wasm::polyfill::Arithmetic) +
+			string(solidity::yul::wasm::polyfill::Bitwise) +
+			string(solidity::yul::wasm::polyfill::Comparison) +
+			string(solidity::yul::wasm::polyfill::Conversion) +
+			string(solidity::yul::wasm::polyfill::Interface) +
+			string(solidity::yul::wasm::polyfill::Keccak) +
+			string(solidity::yul::wasm::polyfill::Logical) +
+			string(solidity::yul::wasm::polyfill::Memory) +
+		"}", ""))};
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+	if (!errors.empty())
+	{
+		string message;
+		for (auto const& err: errors)
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+		yulAssert(false, message);
+	}
+
+	auto polyfill = make_shared<Polyfill>();
+	for (auto const& statement: code->statements)
+		polyfill->functions.insert(std::get<FunctionDefinition>(statement).name);
+	polyfill->callGraph = CallGraphGenerator::callGraph(*code);
+	polyfill->code = move(code);
+	return polyfill;
+}
+
+/// @returns the polyfill, which is parsed only once per process. It contains
+/// YulStrings and is thus parsed again after the YulStringRepository is reset.
+shared_ptr<Polyfill const> polyfill()
+{
+	static shared_ptr<Polyfill const> polyfill;
+	static YulStringRepository::ResetCallback callback{[&] { polyfill.reset(); }};
+	static mutex polyfillMutex;
+	lock_guard<mutex> lock(polyfillMutex);
+	if (!polyfill)
+		polyfill = parsePolyfill();
+	return polyfill;
+}
+
+/// @returns the names of the polyfill functions that are called from @a _ast,
+/// directly or via other polyfill functions.
+set<YulString> usedPolyfillFunctions(Polyfill const& _polyfill, Block const& _ast)
+{
+	CallGraph const callGraph = CallGraphGenerator::callGraph(_ast);
+	set<YulString> used;
+	vector<YulString> toVisit;
+	for (auto const& callees: callGraph.functionCalls | ranges::views::values)
+		for (YulString callee: callees)
+			if (_polyfill.functions.count(callee) && used.insert(callee).second)
+				toVisit.emplace_back(callee);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (_polyfill.callGraph.functionCalls.count(function))
+			for (YulString callee: _polyfill.callGraph.functionCalls.at(function))
+				if (_polyfill.functions.count(callee) && used.insert(callee).second)
+					toVisit.emplace_back(callee);
+	}
+	return used;
+}
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	shared_ptr<Polyfill const> polyfill = ::polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -85,9 +173,12 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill->functions}(ast);
+	// Only append the polyfill functions that are used, in the order of the polyfill.
+	set<YulString> const usedFunctions = usedPolyfillFunctions(*polyfill, ast);
+	for (auto const& st: polyfill->code->statements)
+		if (usedFunctions.count(std::get<FunctionDefinition>(st).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
 	ret.name = _object.name;
@@ -119,32 +210,3 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 
 	return ret;
 }
-
-void EVMToEwasmTranslator::parsePolyfill()
-{
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
-}
@@ -27,6 +27,7 @@ class BlockFlattener: public ASTModifier
 {
 public:
 	static constexpr char const* name{"BlockFlattener"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast) { BlockFlattener{}(_ast); }
 
 	using ASTModifier::operator();
@@ -46,11 +46,32 @@ static constexpr uint64_t compileTimeLiteralHash(char const (&_literal)[N])
 std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 {
 	std::map<Block const*, uint64_t> result;
-	BlockHasher blockHasher(result);
+	BlockHasher blockHasher(&result);
 	blockHasher(_block);
 	return result;
 }
 
+uint64_t BlockHasher::run(FunctionDefinition const& _function)
+{
+	BlockHasher hasher(nullptr);
+	hasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hasher.hash64(_function.parameters.size());
+	hasher.hash64(_function.returnVariables.size());
+	// Parameters and return variables are referred to by their position, like the variables
+	// declared in the body, so their order is taken into account.
+	for (auto const* variables: {&_function.parameters, &_function.returnVariables})
+		for (auto const& variable: *variables)
+			hasher.m_variableReferences[variable.name] = VariableReference{
+				hasher.m_internalIdentifierCount++,
+				false
+			};
+	hasher.hash64(compileTimeLiteralHash("Block"));
+	hasher.hash64(_function.body.statements.size());
+	for (auto const& statement: _function.body.statements)
+		hasher.visit(statement);
+	return hasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -184,7 +205,8 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto const& statement: _block.statements)
 		subBlockHasher.visit(statement);
 
-	m_blockHashes[&_block] = subBlockHasher.m_hash;
+	if (m_blockHashes)
+		(*m_blockHashes)[&_block] = subBlockHasher.m_hash;
 
 	hash64(subBlockHasher.m_hash);
 	hash64(subBlockHasher.m_externalReferences.size());
@@ -192,3 +214,164 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ASTHasher::run(Block const& _block)
+{
+	ASTHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hash64(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hashTypedNames(_varDecl.variables);
+	hash8(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		hash8(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	ASTWalker::operator()(_funDef);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const& _break)
+{
+	hash64(compileTimeLiteralHash("Break"));
+	ASTWalker::operator()(_break);
+}
+
+void ASTHasher::operator()(Continue const& _continue)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+	ASTWalker::operator()(_continue);
+}
+
+void ASTHasher::operator()(Leave const& _leaveStatement)
+{
+	hash64(compileTimeLiteralHash("Leave"));
+	ASTWalker::operator()(_leaveStatement);
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
+
+uint64_t ExpressionHasher::run(Expression const& _expression)
+{
+	ExpressionHasher hasher;
+	hasher.visit(_expression);
+	return hasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	if (_literal.kind == LiteralKind::Number)
+	{
+		u256 value = valueOfNumberLiteral(_literal);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			hash64(static_cast<uint64_t>(value & numeric_limits<uint64_t>::max()));
+			value >>= 64;
+		}
+	}
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
@@ -16,7 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 /**
- * Optimiser component that calculates hash values for blocks.
+ * Optimiser components that calculate hash values for blocks, whole ASTs and expressions.
  */
 #pragma once
 
@@ -27,6 +27,40 @@
 namespace solidity::yul
 {
 
+/**
+ * Base class of the AST hashers, which computes FNV-1a hashes.
+ */
+class ASTHasherBase: public ASTWalker
+{
+public:
+	static constexpr uint64_t fnvPrime = 1099511628211u;
+	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+
+protected:
+	void hash8(uint8_t _value)
+	{
+		m_hash *= fnvPrime;
+		m_hash ^= _value;
+	}
+	void hash16(uint16_t _value)
+	{
+		hash8(static_cast<uint8_t>(_value & 0xFF));
+		hash8(static_cast<uint8_t>(_value >> 8));
+	}
+	void hash32(uint32_t _value)
+	{
+		hash16(static_cast<uint16_t>(_value & 0xFFFF));
+		hash16(static_cast<uint16_t>(_value >> 16));
+	}
+	void hash64(uint64_t _value)
+	{
+		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
+		hash32(static_cast<uint32_t>(_value >> 32));
+	}
+
+	uint64_t m_hash = fnvEmptyHash;
+};
+
 /**
  * Optimiser component that calculates hash values for blocks.
  * Syntactically equal blocks will have identical hashes and
@@ -41,7 +75,7 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
-class BlockHasher: public ASTWalker
+class BlockHasher: public ASTHasherBase
 {
 public:
 
@@ -63,37 +97,16 @@ public:
 	void operator()(Block const& _block) override;
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
-
-	static constexpr uint64_t fnvPrime = 1099511628211u;
-	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+	/// @returns the hash of a function definition, which is the same for syntactically equal
+	/// functions regardless of their names and the names of their parameters and return variables.
+	static uint64_t run(FunctionDefinition const& _function);
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
-
-	void hash8(uint8_t _value)
-	{
-		m_hash *= fnvPrime;
-		m_hash ^= _value;
-	}
-	void hash16(uint16_t _value)
-	{
-		hash8(static_cast<uint8_t>(_value & 0xFF));
-		hash8(static_cast<uint8_t>(_value >> 8));
-	}
-	void hash32(uint32_t _value)
-	{
-		hash16(static_cast<uint16_t>(_value & 0xFFFF));
-		hash16(static_cast<uint16_t>(_value >> 16));
-	}
-	void hash64(uint64_t _value)
-	{
-		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
-		hash32(static_cast<uint32_t>(_value >> 32));
-	}
+	BlockHasher(std::map<Block const*, uint64_t>* _blockHashes): m_blockHashes(_blockHashes) {}
 
-	std::map<Block const*, uint64_t>& m_blockHashes;
+	/// Hashes of all visited blocks, or nullptr if they are not requested.
+	std::map<Block const*, uint64_t>* m_blockHashes = nullptr;
 
-	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
 	{
 		size_t id = 0;
@@ -105,5 +118,59 @@ private:
 	size_t m_internalIdentifierCount = 0;
 };
 
+/**
+ * Optimiser component that calculates a hash value for a whole AST, including all names.
+ * Syntactically equal ASTs will have identical hashes and ASTs with equal hashes
+ * will likely be syntactically equal. Debug data is not taken into account.
+ */
+class ASTHasher: public ASTHasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+	static uint64_t run(Block const& _block);
+
+private:
+	void hashTypedNames(std::vector<TypedName> const& _names);
+};
+
+/**
+ * Optimiser component that calculates hash values for expressions.
+ * Expressions that are equal according to SyntacticallyEqual will have identical hashes
+ * and expressions with equal hashes will likely be equal. In particular, number literals
+ * are hashed by their value.
+ */
+class ExpressionHasher: public ASTHasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+	static uint64_t run(Expression const& _expression);
+};
+
+/// Hash function object for expressions, to be used in unordered containers.
+struct ExpressionHash
+{
+	uint64_t operator()(Expression const& _expression) const { return ExpressionHasher::run(_expression); }
+};
 
 }
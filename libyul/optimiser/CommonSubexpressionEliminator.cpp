@@ -39,11 +39,21 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 {
 	CommonSubexpressionEliminator cse{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		_context.analysisCache.information(_context.dialect, _ast).functionSideEffects
 	};
 	cse(_ast);
 }
 
+void CommonSubexpressionEliminator::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
+	CommonSubexpressionEliminator cse{_context.dialect, _information.functionSideEffects};
+	cse(_ast);
+}
+
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
 	map<YulString, SideEffects> _functionSideEffects
@@ -55,6 +65,7 @@ CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 {
 	ScopedSaveAndRestore returnVariables(m_returnVariables, {});
+	ScopedSaveAndRestore replacementCandidates(m_replacementCandidates, {});
 
 	for (auto const& v: _fun.returnVariables)
 		m_returnVariables.insert(v.name);
@@ -105,23 +116,35 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
-		{
-			assertThrow(value.value, OptimizerException, "");
-			// Prevent using the default value of return variables
-			// instead of literal zeros.
-			if (
-				m_returnVariables.count(variable) &&
-				holds_alternative<Literal>(*value.value) &&
-				valueOfLiteral(get<Literal>(*value.value)) == 0
-			)
-				continue;
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+		auto candidates = m_replacementCandidates.find(_e);
+		if (candidates != m_replacementCandidates.end())
+			for (YulString variable: candidates->second)
 			{
-				_e = Identifier{debugDataOf(_e), variable};
-				break;
+				// The variable might have been assigned a different value in the meantime.
+				auto value = m_value.find(variable);
+				if (value == m_value.end())
+					continue;
+				assertThrow(value->second.value, OptimizerException, "");
+				// Prevent using the default value of return variables
+				// instead of literal zeros.
+				if (
+					m_returnVariables.count(variable) &&
+					holds_alternative<Literal>(*value->second.value) &&
+					valueOfLiteral(get<Literal>(*value->second.value)) == 0
+				)
+					continue;
+				if (SyntacticallyEqual{}(_e, *value->second.value) && inScope(variable))
+				{
+					_e = Identifier{debugDataOf(_e), variable};
+					break;
+				}
 			}
-		}
 	}
 }
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	if (_value)
+		m_replacementCandidates[*_value].insert(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
+}
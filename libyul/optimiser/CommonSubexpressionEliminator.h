@@ -24,8 +24,12 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 
+#include <functional>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -43,7 +47,9 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void run(OptimiserStepContext&, Block& _ast, InterproceduralInformation const& _information);
 
 	using DataFlowAnalyzer::operator();
 	void operator()(FunctionDefinition&) override;
@@ -58,8 +64,19 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
+	void assignValue(YulString _variable, Expression const* _value) override;
+
 private:
 	std::set<YulString> m_returnVariables;
+	/// For each value ever assigned to a variable, the variables it was assigned to.
+	/// Entries are not removed when the variables change, so they have to be checked
+	/// against the current values before use.
+	std::unordered_map<
+		std::reference_wrapper<Expression const>,
+		std::set<YulString>,
+		ExpressionHash,
+		SyntacticallyEqualExpression
+	> m_replacementCandidates;
 };
 
 }
@@ -0,0 +1,399 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves computations that are repeated in several branches
+ * in front of the branching statement.
+ */
+
+#include <libyul/optimiser/CommonSubexpressionHoister.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void CommonSubexpressionHoister::run(OptimiserStepContext& _context, Block& _ast)
+{
+	run(_context, _ast, _context.analysisCache.information(_context.dialect, _ast));
+}
+
+void CommonSubexpressionHoister::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	Assignments assignments;
+	assignments(_ast);
+	CommonSubexpressionHoister{
+		_context.dialect,
+		ssaValues.values(),
+		assignments.names(),
+		_information.functionSideEffects,
+		_information.containsMSize
+	}(_ast);
+}
+
+void CommonSubexpressionHoister::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	BlockInformation information = blockInformation(_block);
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+		if (holds_alternative<If>(_block.statements[i]) || holds_alternative<Switch>(_block.statements[i]))
+			if (size_t inserted = hoistFromBranches(_block, i, information))
+			{
+				i += inserted;
+				information = blockInformation(_block);
+			}
+}
+
+CommonSubexpressionHoister::BlockInformation CommonSubexpressionHoister::blockInformation(Block const& _block)
+{
+	BlockInformation information;
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		Statement const& statement = _block.statements[i];
+		information.statementSideEffects.emplace_back(sideEffectsOf(statement));
+		if (auto number = declarationNumber(statement))
+			information.declarationsByNumber[*number].emplace_back(i);
+	}
+	return information;
+}
+
+size_t CommonSubexpressionHoister::hoistFromBranches(
+	Block& _block,
+	size_t _index,
+	BlockInformation const& _information
+)
+{
+	size_t inserted = 0;
+	while (true)
+	{
+		Statement& statement = _block.statements[_index + inserted];
+		size_t const statementIndex = _index + inserted;
+
+		vector<Block*> branches;
+		bool exhaustive = false;
+		SideEffects entrySideEffects;
+		if (If* ifStatement = get_if<If>(&statement))
+		{
+			branches.emplace_back(&ifStatement->body);
+			entrySideEffects = sideEffectsOf(*ifStatement->condition);
+		}
+		else
+		{
+			Switch& switchStatement = get<Switch>(statement);
+			for (Case& switchCase: switchStatement.cases)
+			{
+				branches.emplace_back(&switchCase.body);
+				if (!switchCase.value)
+					exhaustive = true;
+			}
+			entrySideEffects = sideEffectsOf(*switchStatement.expression);
+		}
+
+		vector<vector<Candidate>> branchCandidates;
+		for (Block const* branch: branches)
+			branchCandidates.emplace_back(candidates(*branch, entrySideEffects));
+
+		vector<Statement> hoisted;
+		vector<set<size_t>> removed(branches.size());
+		vector<set<size_t>> replaced(branches.size());
+		set<size_t> replacedLater;
+		auto const replaceValue = [](VariableDeclaration& _declaration, YulString _variable) {
+			*_declaration.value = Identifier{debugDataOf(*_declaration.value), _variable};
+		};
+
+		// Values computed in all cases of a switch.
+		if (exhaustive && branches.size() > 1)
+		{
+			vector<map<size_t, Candidate const*>> byNumber(branches.size());
+			for (size_t i = 1; i < branches.size(); ++i)
+				for (Candidate const& candidate: branchCandidates[i])
+					byNumber[i].emplace(candidate.valueNumber, &candidate);
+
+			for (Candidate const& candidate: branchCandidates.front())
+			{
+				if (!movable(*branches.front(), candidate))
+					continue;
+				vector<Candidate const*> matches;
+				for (size_t i = 1; i < branches.size(); ++i)
+				{
+					auto match = byNumber[i].find(candidate.valueNumber);
+					if (match == byNumber[i].end() || !movable(*branches[i], *match->second))
+						break;
+					matches.emplace_back(match->second);
+				}
+				if (matches.size() + 1 != branches.size())
+					continue;
+				auto declaration = extractDeclaration(*branches.front(), candidate, removed.front());
+				if (!declaration)
+					continue;
+				YulString variable = get<VariableDeclaration>(*declaration).variables.front().name;
+				for (size_t i = 1; i < branches.size(); ++i)
+				{
+					replaceValue(get<VariableDeclaration>(branches[i]->statements[matches[i - 1]->index]), variable);
+					replaced[i].insert(matches[i - 1]->index);
+				}
+				hoisted.emplace_back(std::move(*declaration));
+			}
+		}
+
+		// Values computed in a branch and again after the statement.
+		for (size_t i = 0; i < branches.size(); ++i)
+			for (Candidate const& candidate: branchCandidates[i])
+			{
+				if (removed[i].count(candidate.index) || replaced[i].count(candidate.index))
+					continue;
+				auto later = _information.declarationsByNumber.find(candidate.valueNumber);
+				if (later == _information.declarationsByNumber.end())
+					continue;
+				auto laterIndex = upper_bound(later->second.begin(), later->second.end(), _index);
+				if (laterIndex == later->second.end() || replacedLater.count(*laterIndex))
+					continue;
+				if (!movable(*branches[i], candidate))
+					continue;
+				// The statement indices of the block information do not include the declarations
+				// inserted in front of the statement.
+				SideEffects inBetween;
+				for (size_t j = _index; j < *laterIndex; ++j)
+					inBetween += _information.statementSideEffects[j];
+				Statement& laterStatement = _block.statements[*laterIndex + inserted];
+				// The value might have been replaced in a previous round.
+				if (declarationNumber(laterStatement) != candidate.valueNumber)
+					continue;
+				VariableDeclaration& laterDeclaration = get<VariableDeclaration>(laterStatement);
+				if (!SideEffectsCollector::movableRelativeTo(
+					sideEffectsOf(*laterDeclaration.value),
+					inBetween,
+					m_containsMSize
+				))
+					continue;
+				auto declaration = extractDeclaration(*branches[i], candidate, removed[i]);
+				if (!declaration)
+					continue;
+				replaceValue(laterDeclaration, get<VariableDeclaration>(*declaration).variables.front().name);
+				replacedLater.insert(*laterIndex);
+				hoisted.emplace_back(std::move(*declaration));
+			}
+
+		if (hoisted.empty())
+			return inserted;
+
+		for (size_t i = 0; i < branches.size(); ++i)
+		{
+			vector<Statement>& statements = branches[i]->statements;
+			size_t index = 0;
+			statements.erase(
+				remove_if(
+					statements.begin(),
+					statements.end(),
+					[&](Statement const&) { return removed[i].count(index++) > 0; }
+				),
+				statements.end()
+			);
+		}
+		size_t const numberOfHoisted = hoisted.size();
+		_block.statements.insert(
+			_block.statements.begin() + static_cast<ptrdiff_t>(statementIndex),
+			make_move_iterator(hoisted.begin()),
+			make_move_iterator(hoisted.end())
+		);
+		inserted += numberOfHoisted;
+		// The numbers of variables that were only copies of others can change.
+		m_variableNumbers.clear();
+	}
+}
+
+vector<CommonSubexpressionHoister::Candidate> CommonSubexpressionHoister::candidates(
+	Block const& _branch,
+	SideEffects const& _entrySideEffects
+)
+{
+	vector<Candidate> result;
+	SideEffects precedingSideEffects = _entrySideEffects;
+	for (size_t i = 0; i < _branch.statements.size(); ++i)
+	{
+		Statement const& statement = _branch.statements[i];
+		if (auto number = declarationNumber(statement))
+			result.emplace_back(Candidate{i, *number, precedingSideEffects});
+		precedingSideEffects += sideEffectsOf(statement);
+	}
+	return result;
+}
+
+bool CommonSubexpressionHoister::movable(Block const& _branch, Candidate const& _candidate) const
+{
+	VariableDeclaration const& declaration = get<VariableDeclaration>(_branch.statements[_candidate.index]);
+	return SideEffectsCollector::movableRelativeTo(
+		sideEffectsOf(*declaration.value),
+		_candidate.precedingSideEffects,
+		m_containsMSize
+	);
+}
+
+optional<Statement> CommonSubexpressionHoister::extractDeclaration(
+	Block& _branch,
+	Candidate const& _candidate,
+	set<size_t>& _removed
+)
+{
+	map<YulString, size_t> declaredBefore;
+	for (size_t i = 0; i < _candidate.index; ++i)
+		if (!_removed.count(i))
+			if (VariableDeclaration const* declaration = get_if<VariableDeclaration>(&_branch.statements[i]))
+				for (TypedName const& variable: declaration->variables)
+					declaredBefore[variable.name] = i;
+
+	// @returns an expression with the value of @a _variable that can be used in front of the branch.
+	auto const replacementOf = [&](YulString _variable) -> optional<Expression> {
+		for (size_t depth = 0; depth < 32; ++depth)
+		{
+			if (!declaredBefore.count(_variable))
+				return Identifier{{}, _variable};
+			auto value = m_ssaValues.find(_variable);
+			if (value == m_ssaValues.end())
+				return nullopt;
+			if (holds_alternative<Literal>(*value->second))
+				return *value->second;
+			else if (Identifier const* identifier = get_if<Identifier>(value->second))
+				_variable = identifier->name;
+			else
+				return nullopt;
+		}
+		return nullopt;
+	};
+
+	FunctionCall& call = get<FunctionCall>(*get<VariableDeclaration>(_branch.statements[_candidate.index]).value);
+	vector<pair<size_t, Expression>> replacements;
+	for (size_t i = 0; i < call.arguments.size(); ++i)
+		if (Identifier const* identifier = get_if<Identifier>(&call.arguments[i]))
+			if (declaredBefore.count(identifier->name))
+			{
+				auto replacement = replacementOf(identifier->name);
+				if (!replacement)
+					return nullopt;
+				if (Identifier* replacementIdentifier = get_if<Identifier>(&*replacement))
+					replacementIdentifier->debugData = identifier->debugData;
+				else
+					get<Literal>(*replacement).debugData = identifier->debugData;
+				replacements.emplace_back(i, std::move(*replacement));
+			}
+	for (auto& [index, replacement]: replacements)
+		call.arguments[index] = std::move(replacement);
+
+	_removed.insert(_candidate.index);
+	return std::move(_branch.statements[_candidate.index]);
+}
+
+optional<size_t> CommonSubexpressionHoister::declarationNumber(Statement const& _statement)
+{
+	VariableDeclaration const* declaration = get_if<VariableDeclaration>(&_statement);
+	if (
+		!declaration ||
+		declaration->variables.size() != 1 ||
+		!declaration->value ||
+		!holds_alternative<FunctionCall>(*declaration->value) ||
+		!m_ssaValues.count(declaration->variables.front().name)
+	)
+		return nullopt;
+	return valueNumber(*declaration->value);
+}
+
+optional<size_t> CommonSubexpressionHoister::valueNumber(Expression const& _expression)
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+	{
+		if (literal->kind == LiteralKind::String && literal->value.str().size() > 32)
+			return nullopt;
+		auto [it, inserted] = m_literalNumbers.try_emplace(valueOfLiteral(*literal), m_nextNumber);
+		if (inserted)
+			++m_nextNumber;
+		return it->second;
+	}
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		return variableNumber(identifier->name);
+
+	FunctionCall const& call = get<FunctionCall>(_expression);
+	BuiltinFunction const* builtin = m_dialect.builtin(call.functionName.name);
+	if (!builtin)
+		return nullopt;
+	vector<size_t> argumentNumbers;
+	for (size_t i = 0; i < call.arguments.size(); ++i)
+	{
+		if (builtin->literalArgument(i))
+			return nullopt;
+		auto number = valueNumber(call.arguments[i]);
+		if (!number)
+			return nullopt;
+		argumentNumbers.emplace_back(*number);
+	}
+	auto [it, inserted] = m_callNumbers.try_emplace({call.functionName.name, std::move(argumentNumbers)}, m_nextNumber);
+	if (inserted)
+		++m_nextNumber;
+	return it->second;
+}
+
+optional<size_t> CommonSubexpressionHoister::variableNumber(YulString _variable)
+{
+	if (auto number = util::valueOrNullptr(m_variableNumbers, _variable))
+		return *number;
+	if (m_assignedVariables.count(_variable))
+		return nullopt;
+
+	// Variables without a tracked value, like function parameters, get a number of their own.
+	// Only values that do not depend on the state are the same wherever the variable is visible.
+	optional<size_t> number;
+	if (auto value = m_ssaValues.find(_variable); value != m_ssaValues.end())
+		if (!holds_alternative<FunctionCall>(*value->second) || sideEffectsOf(*value->second).movable)
+			number = valueNumber(*value->second);
+	if (!number)
+	{
+		auto [it, inserted] = m_opaqueNumbers.try_emplace(_variable, m_nextNumber);
+		if (inserted)
+			++m_nextNumber;
+		number = it->second;
+	}
+	m_variableNumbers[_variable] = *number;
+	return number;
+}
+
+SideEffects CommonSubexpressionHoister::sideEffectsOf(Statement const& _statement) const
+{
+	SideEffectsCollector collector{m_dialect, &m_functionSideEffects};
+	collector.visit(_statement);
+	return collector.sideEffects();
+}
+
+SideEffects CommonSubexpressionHoister::sideEffectsOf(Expression const& _expression) const
+{
+	return SideEffectsCollector{m_dialect, _expression, &m_functionSideEffects}.sideEffects();
+}
@@ -0,0 +1,165 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves computations that are repeated in several branches
+ * in front of the branching statement.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ASTForward.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Numbers the values of the SSA variables of a function and moves variable declarations
+ * out of the branches of ``switch`` and ``if`` statements if the same value is computed
+ * again on every path after the point in front of the statement:
+ *  - in all cases of a ``switch`` with a ``default`` case, or
+ *  - in a branch and again at the top level of the enclosing block after the statement.
+ *
+ * Two values get the same number if they are computed by the same built-in function from
+ * arguments with the same numbers. A variable that is assigned to has no number, a variable
+ * whose value is not movable gets a number of its own. Thus, for example, ``calldataload(4)``
+ * in the cases of the switch of a contract's dispatcher is computed only once.
+ *
+ * The first of the declarations is moved in front of the statement and the values of the others
+ * are replaced by a reference to its variable, which other steps like the Rematerialiser and
+ * the UnusedPruner can remove. Values that read state, like ``keccak256`` or ``sload``, are only
+ * moved if the code in between cannot change that state.
+ *
+ * This is a form of partial redundancy elimination restricted to the structured control flow
+ * of Yul, where the paths through a statement join at its end.
+ *
+ * Works best if the code is in SSA form and literal arguments are in variables.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class CommonSubexpressionHoister: public ASTModifier
+{
+public:
+	static constexpr char const* name{"CommonSubexpressionHoister"};
+	static constexpr bool functionLocal = true;
+	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(
+		OptimiserStepContext& _context,
+		Block& _ast,
+		InterproceduralInformation const& _information
+	);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	CommonSubexpressionHoister(
+		Dialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues,
+		std::set<YulString> const& _assignedVariables,
+		std::map<YulString, SideEffects> const& _functionSideEffects,
+		bool _containsMSize
+	):
+		m_dialect(_dialect),
+		m_ssaValues(_ssaValues),
+		m_assignedVariables(_assignedVariables),
+		m_functionSideEffects(_functionSideEffects),
+		m_containsMSize(_containsMSize)
+	{}
+
+	/// A declaration of a single variable with a value that can be numbered at the top level
+	/// of a branch.
+	struct Candidate
+	{
+		size_t index = 0;
+		size_t valueNumber = 0;
+		/// Side-effects of the code that is executed between the point in front of the branching
+		/// statement and the declaration.
+		SideEffects precedingSideEffects;
+	};
+
+	/// Side-effects of the statements of a block and the indices of its top-level declarations
+	/// by the numbers of their values.
+	struct BlockInformation
+	{
+		std::vector<SideEffects> statementSideEffects;
+		std::map<size_t, std::vector<size_t>> declarationsByNumber;
+	};
+	BlockInformation blockInformation(Block const& _block);
+
+	/// Moves declarations out of the branches of the statement at @a _index of @a _block.
+	/// @returns the number of declarations inserted in front of the statement.
+	size_t hoistFromBranches(Block& _block, size_t _index, BlockInformation const& _information);
+
+	/// @returns the candidates to be moved out of @a _branch, which is executed after code with
+	/// the side-effects @a _entrySideEffects.
+	std::vector<Candidate> candidates(Block const& _branch, SideEffects const& _entrySideEffects);
+
+	/// @returns true if the value of @a _candidate can be computed in front of the branching statement.
+	bool movable(Block const& _branch, Candidate const& _candidate) const;
+
+	/// Moves the declaration of @a _candidate out of @a _branch and @returns it with references
+	/// to variables declared before it in @a _branch replaced by their literal values or by the
+	/// variables they are copies of, or nullopt if that is not possible. The declaration is only
+	/// removed from @a _branch later and its index is added to @a _removed; the declarations
+	/// at these indices are not considered to be declared before the candidate.
+	std::optional<Statement> extractDeclaration(
+		Block& _branch,
+		Candidate const& _candidate,
+		std::set<size_t>& _removed
+	);
+
+	/// @returns the number of the value of @a _statement if it is a candidate declaration.
+	std::optional<size_t> declarationNumber(Statement const& _statement);
+
+	/// @returns the number of the value of @a _expression, or nullopt if it cannot be numbered.
+	std::optional<size_t> valueNumber(Expression const& _expression);
+	/// @returns the number of the value of @a _variable, or nullopt if it is assigned to.
+	std::optional<size_t> variableNumber(YulString _variable);
+
+	SideEffects sideEffectsOf(Statement const& _statement) const;
+	SideEffects sideEffectsOf(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, Expression const*> const& m_ssaValues;
+	std::set<YulString> const& m_assignedVariables;
+	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	bool m_containsMSize = true;
+
+	/// Numbers of the SSA variables, determined on demand. Has to be cleared whenever
+	/// a value is replaced.
+	std::map<YulString, size_t> m_variableNumbers;
+	/// Numbers assigned to literal values, to variables with a number of their own
+	/// and to calls of built-in functions with the numbers of their arguments.
+	std::map<u256, size_t> m_literalNumbers;
+	std::map<YulString, size_t> m_opaqueNumbers;
+	std::map<std::pair<YulString, std::vector<size_t>>, size_t> m_callNumbers;
+	size_t m_nextNumber = 0;
+};
+
+}
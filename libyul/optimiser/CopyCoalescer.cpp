@@ -0,0 +1,145 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that merges variables with their copies if their lifetimes do not overlap.
+ */
+
+#include <libyul/optimiser/CopyCoalescer.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/action/remove_if.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Renames the merged variables and removes the copies.
+class CopyRemover: public ASTModifier
+{
+public:
+	CopyRemover(
+		map<YulString, YulString> const& _coalesced,
+		set<VariableDeclaration const*> const& _copies
+	):
+		m_coalesced(_coalesced),
+		m_copies(_copies)
+	{}
+
+	using ASTModifier::operator();
+	void operator()(Identifier& _identifier) override
+	{
+		if (YulString const* variable = util::valueOrNullptr(m_coalesced, _identifier.name))
+			_identifier.name = *variable;
+	}
+	void operator()(Block& _block) override
+	{
+		ranges::actions::remove_if(_block.statements, [&](Statement const& _statement) -> bool {
+			return holds_alternative<VariableDeclaration>(_statement) && m_copies.count(&std::get<VariableDeclaration>(_statement));
+		});
+
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	map<YulString, YulString> const& m_coalesced;
+	set<VariableDeclaration const*> const& m_copies;
+};
+
+}
+
+void CopyCoalescer::run(OptimiserStepContext&, Block& _ast)
+{
+	CopyCoalescer coalescer;
+	coalescer(_ast);
+	if (!coalescer.m_copies.empty())
+		CopyRemover{coalescer.m_coalesced, coalescer.m_copies}(_ast);
+}
+
+void CopyCoalescer::operator()(FunctionDefinition const& _functionDefinition)
+{
+	m_functionParameters = &_functionDefinition.parameters;
+	ASTWalker::operator()(_functionDefinition);
+}
+
+void CopyCoalescer::operator()(Block const& _block)
+{
+	// The variables that are declared directly in this block and not merged, with their types.
+	map<YulString, YulString> declared;
+	if (m_functionParameters)
+	{
+		for (TypedName const& parameter: *m_functionParameters)
+			declared[parameter.name] = parameter.type;
+		m_functionParameters = nullptr;
+	}
+
+	// The index of the last statement of the block that references a variable.
+	map<YulString, size_t> lastReference;
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		ReferencesCounter counter{ReferencesCounter::OnlyVariables};
+		counter.visit(_block.statements[i]);
+		for (auto const& reference: counter.references())
+			lastReference[representative(reference.first)] = i;
+	}
+
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		auto const* varDecl = get_if<VariableDeclaration>(&_block.statements[i]);
+		if (!varDecl)
+			continue;
+
+		if (varDecl->variables.size() == 1 && varDecl->value)
+			if (auto const* identifier = get_if<Identifier>(varDecl->value.get()))
+			{
+				TypedName const& copy = varDecl->variables.front();
+				YulString const variable = representative(identifier->name);
+				if (
+					declared.count(variable) &&
+					declared.at(variable) == copy.type &&
+					lastReference.at(variable) == i
+				)
+				{
+					m_coalesced[copy.name] = variable;
+					m_copies.insert(varDecl);
+					if (lastReference.count(copy.name))
+						lastReference[variable] = lastReference.at(copy.name);
+					continue;
+				}
+			}
+
+		for (TypedName const& variable: varDecl->variables)
+			declared[variable.name] = variable.type;
+	}
+
+	ASTWalker::operator()(_block);
+}
+
+YulString CopyCoalescer::representative(YulString _variable) const
+{
+	if (YulString const* variable = util::valueOrNullptr(m_coalesced, _variable))
+		return *variable;
+	return _variable;
+}
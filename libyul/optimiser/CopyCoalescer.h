@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that merges variables with their copies if their lifetimes do not overlap.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct OptimiserStepContext;
+
+/**
+ * Optimiser component that removes copies of variables of the form ``let y := x``
+ * where ``x`` is not used after the copy, by renaming ``y`` to ``x``.
+ *
+ * Example:
+ *
+ * {
+ *   let x_1 := calldataload(0)
+ *   let x := x_1
+ *   for { } lt(x, 10) { x := add(x, 1) } { sstore(x, 1) }
+ * }
+ *
+ * is transformed to
+ *
+ * {
+ *   let x_1 := calldataload(0)
+ *   for { } lt(x_1, 10) { x_1 := add(x_1, 1) } { sstore(x_1, 1) }
+ * }
+ *
+ * Such copies remain after the SSAReverser if the copy is re-assigned, so that the
+ * CommonSubexpressionEliminator cannot replace its references. In the code transform, they
+ * cost a stack slot and a ``DUP`` each.
+ *
+ * Two variables can share a stack slot if they do not interfere, i.e. if none of them is
+ * assigned while the other one is still used. The step only uses the simplest case of this:
+ * ``x`` is declared in the same block as the copy (or is a parameter of the function whose
+ * body the block is) and the block does not reference ``x`` after the copy. Then the lifetime
+ * of ``x`` ends where the one of ``y`` begins and both end with the block, so ``y`` can be
+ * replaced by ``x`` in all following statements. Return variables are never merged into,
+ * since they are still read at the end of the function. Chains of copies are merged into
+ * their first variable.
+ *
+ * Both variables have to have the same type.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ *
+ * Works best after the SSAReverser and the CommonSubexpressionEliminator, before the code
+ * is generated.
+ */
+class CopyCoalescer: public ASTWalker
+{
+public:
+	static constexpr char const* name{"CopyCoalescer"};
+	static constexpr bool functionLocal = true;
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _functionDefinition) override;
+	void operator()(Block const& _block) override;
+
+private:
+	CopyCoalescer() = default;
+
+	/// @returns the variable that @a _variable was merged into, or @a _variable itself.
+	YulString representative(YulString _variable) const;
+
+	/// Parameters of the function whose body is visited next.
+	std::vector<TypedName> const* m_functionParameters = nullptr;
+	/// Maps each merged variable to the variable it was merged into.
+	std::map<YulString, YulString> m_coalesced;
+	/// The copies that are removed.
+	std::set<VariableDeclaration const*> m_copies;
+};
+
+}
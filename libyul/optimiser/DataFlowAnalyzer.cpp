@@ -30,7 +30,7 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
+#include <libsolutil/Profiler.h>
 
 #include <variant>
 
@@ -64,20 +64,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		m_storage.eraseIf([&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		m_storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		m_memory.eraseIf([&](YulString _key, YulString /* _value */) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		m_memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -88,7 +88,7 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 
 void DataFlowAnalyzer::operator()(Assignment& _assignment)
 {
-	set<YulString> names;
+	ScratchNameSet names = scratchNameSet();
 	for (auto const& var: _assignment.variableNames)
 		names.emplace(var.name);
 	assertThrow(_assignment.value, OptimizerException, "");
@@ -99,7 +99,7 @@ void DataFlowAnalyzer::operator()(Assignment& _assignment)
 
 void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 {
-	set<YulString> names;
+	ScratchNameSet names = scratchNameSet();
 	for (auto const& var: _varDecl.variables)
 		names.emplace(var.name);
 	m_variableScopes.back().variables += names;
@@ -116,12 +116,11 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	forkKnowledge();
 
 	ASTModifier::operator()(_if);
 
-	joinKnowledge(storage, memory);
+	joinKnowledge();
 
 	Assignments assignments;
 	assignments(_if.body);
@@ -132,28 +131,36 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 {
 	clearKnowledgeIfInvalidated(*_switch.expression);
 	visit(*_switch.expression);
-	set<YulString> assignedVariables;
+	ScratchNameSet assignedVariables = scratchNameSet();
+	// The bodies are not modified anymore once they have been visited,
+	// so their side-effects are only determined once.
+	vector<SideEffects> caseSideEffects;
+	caseSideEffects.reserve(_switch.cases.size());
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		forkKnowledge();
 		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		joinKnowledge();
 
 		Assignments assignments;
 		assignments(_case.body);
 		assignedVariables += assignments.names();
 		// This is a little too destructive, we could retain the old values.
 		clearValues(assignments.names());
-		clearKnowledgeIfInvalidated(_case.body);
+		caseSideEffects.emplace_back(sideEffectsOf(_case.body));
+		clearKnowledgeIfInvalidated(caseSideEffects.back());
 	}
-	for (auto& _case: _switch.cases)
-		clearKnowledgeIfInvalidated(_case.body);
+	for (SideEffects const& sideEffects: caseSideEffects)
+		clearKnowledgeIfInvalidated(sideEffects);
 	clearValues(assignedVariables);
 }
 
 void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 {
+	SOL_PERF_COUNTER(
+		"yul.DataFlowAnalyzer.savedStateEntries",
+		m_value.size() + m_references.values.size() + m_storage.values.size() + m_memory.values.size()
+	);
 	// Save all information. We might rather reinstantiate this class,
 	// but this could be difficult if it is subclassed.
 	ScopedSaveAndRestore valueResetter(m_value, {});
@@ -168,7 +175,9 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	for (auto const& var: _fun.returnVariables)
 	{
 		m_variableScopes.back().variables.emplace(var.name);
-		handleAssignment({var.name}, nullptr, true);
+		ScratchNameSet names = scratchNameSet();
+		names.emplace(var.name);
+		handleAssignment(names, nullptr, true);
 	}
 	ASTModifier::operator()(_fun);
 
@@ -203,12 +212,14 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 	visit(*_for.condition);
 	(*this)(_for.body);
 	clearValues(assignmentsSinceCont.names());
-	clearKnowledgeIfInvalidated(_for.body);
+	// The body is not modified by visiting the post block, so its side-effects are re-used below.
+	SideEffects bodySideEffects = sideEffectsOf(_for.body);
+	clearKnowledgeIfInvalidated(bodySideEffects);
 	(*this)(_for.post);
 	clearValues(assignments.names());
 	clearKnowledgeIfInvalidated(*_for.condition);
 	clearKnowledgeIfInvalidated(_for.post);
-	clearKnowledgeIfInvalidated(_for.body);
+	clearKnowledgeIfInvalidated(bodySideEffects);
 
 	--m_loopDepth;
 }
@@ -222,7 +233,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 	assertThrow(numScopes == m_variableScopes.size(), OptimizerException, "");
 }
 
-void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value, bool _isDeclaration)
+void DataFlowAnalyzer::handleAssignment(ScratchNameSet const& _variables, Expression* _value, bool _isDeclaration)
 {
 	if (!_isDeclaration)
 		clearValues(_variables);
@@ -246,17 +257,17 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_references[name] = referencedVariables;
+		m_references.set(name, referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
-			m_storage.erase(name);
+			m_storage.eraseKey(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_storage.eraseValue(name);
 			// assignment to slot denoted by "name"
-			m_memory.erase(name);
+			m_memory.eraseKey(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_memory.eraseValue(name);
 		}
 	}
 
@@ -269,9 +280,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				m_memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				m_storage.set(*key, variable);
 		}
 	}
 }
@@ -286,12 +297,19 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 	m_variableScopes.pop_back();
 }
 
-void DataFlowAnalyzer::clearValues(set<YulString> _variables)
+void DataFlowAnalyzer::clearValues(set<YulString> const& _variables)
+{
+	ScratchNameSet variables = scratchNameSet();
+	variables += _variables;
+	clearValues(move(variables));
+}
+
+void DataFlowAnalyzer::clearValues(ScratchNameSet _variables)
 {
 	// All variables that reference variables to be cleared also have to be
 	// cleared, but not recursively, since only the value of the original
@@ -309,23 +327,23 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	for (auto const& name: _variables)
+		for (auto* knowledge: {&m_storage, &m_memory})
+		{
+			knowledge->eraseKey(name);
+			knowledge->eraseValue(name);
+		}
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_references)
-			if (names.count(variableToClear))
-				_variables.emplace(ref);
+		if (auto const* references = valueOrNullptr(m_references.references, variableToClear))
+			_variables += *references;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 }
 
@@ -334,46 +352,46 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 	m_value[_variable] = {_value, m_loopDepth};
 }
 
+SideEffects DataFlowAnalyzer::sideEffectsOf(Block const& _block) const
+{
+	return SideEffectsCollector(m_dialect, _block, &m_functionSideEffects).sideEffects();
+}
+
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
-	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
-	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+	clearKnowledgeIfInvalidated(sideEffectsOf(_block));
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
-	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
+	clearKnowledgeIfInvalidated(SideEffectsCollector(m_dialect, _expr, &m_functionSideEffects).sideEffects());
+}
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(SideEffects const& _sideEffects)
+{
+	if (_sideEffects.storage == SideEffects::Write)
 		m_storage.clear();
-	if (sideEffects.invalidatesMemory())
+	if (_sideEffects.memory == SideEffects::Write)
 		m_memory.clear();
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
-)
+void DataFlowAnalyzer::forkKnowledge()
 {
-	joinKnowledgeHelper(m_storage, _olderStorage);
-	joinKnowledgeHelper(m_memory, _olderMemory);
+	SOL_PERF_COUNTER("yul.DataFlowAnalyzer.knowledgeForks", 1);
+	m_storage.pushCheckpoint();
+	m_memory.pushCheckpoint();
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge()
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// We clear if the key did not exist at the fork or if the value is different.
+	// Only keys changed since the fork have to be checked.
+	// This also works for memory because the state at the fork is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	SOL_PERF_COUNTER("yul.DataFlowAnalyzer.joinedKnowledgeEntries", m_storage.values.size() + m_memory.values.size());
+	m_storage.joinCheckpoint();
+	m_memory.joinCheckpoint();
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
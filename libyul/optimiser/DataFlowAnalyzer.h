@@ -29,9 +29,12 @@
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/Arena.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/InvertibleMap.h>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace solidity::yul
@@ -99,8 +102,13 @@ public:
 	void operator()(Block& _block) override;
 
 protected:
+	/// Set of names that is only used while visiting a single node. Its memory is taken from
+	/// an arena of the analyzer, which is released when the analyzer is destroyed.
+	using ScratchNameSet = std::set<YulString, std::less<YulString>, util::ArenaAllocator<YulString>>;
+	ScratchNameSet scratchNameSet() const { return ScratchNameSet{util::ArenaAllocator<YulString>{m_scratch}}; }
+
 	/// Registers the assignment.
-	void handleAssignment(std::set<YulString> const& _names, Expression* _value, bool _isDeclaration);
+	void handleAssignment(ScratchNameSet const& _names, Expression* _value, bool _isDeclaration);
 
 	/// Creates a new inner scope.
 	void pushScope(bool _functionScope);
@@ -110,9 +118,10 @@ protected:
 
 	/// Clears information about the values assigned to the given variables,
 	/// for example at points where control flow is merged.
-	void clearValues(std::set<YulString> _names);
+	void clearValues(std::set<YulString> const& _names);
+	void clearValues(ScratchNameSet _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	virtual void assignValue(YulString _variable, Expression const* _value);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -120,18 +129,20 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
-	);
+	/// Clears knowledge about storage or memory if they may be modified by code with the given side-effects.
+	void clearKnowledgeIfInvalidated(SideEffects const& _sideEffects);
 
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// @returns the side-effects of the block, to be used with @a clearKnowledgeIfInvalidated
+	/// if the same block has to be checked more than once.
+	SideEffects sideEffectsOf(Block const& _block) const;
+
+	/// Marks the current point in the control-flow as the one to join the knowledge about
+	/// storage and memory with later on.
+	void forkKnowledge();
+
+	/// Joins knowledge about storage and memory with the point of the matching call to
+	/// @a forkKnowledge. This only works if the current state is a direct successor of that point.
+	void joinKnowledge();
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -166,11 +177,11 @@ protected:
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
-	/// m_references[a].contains(b) <=> the current expression assigned to a references b
-	std::unordered_map<YulString, std::set<YulString>> m_references;
+	/// m_references.values[a].contains(b) <=> the current expression assigned to a references b
+	util::InvertibleRelation<YulString> m_references;
 
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	util::InvertibleMap<YulString, YulString> m_storage;
+	util::InvertibleMap<YulString, YulString> m_memory;
 
 	KnowledgeBase m_knowledgeBase;
 
@@ -191,6 +202,8 @@ protected:
 	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 	/// List of scopes.
 	std::vector<Scope> m_variableScopes;
+	/// Memory of the temporary sets of names.
+	std::shared_ptr<util::Arena> m_scratch = std::make_shared<util::Arena>(16 * 1024);
 };
 
 }
@@ -31,8 +31,9 @@ using namespace solidity::yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
-	auto& candidates = m_candidates[bodyHash];
+	// The hash includes the number and the order of use of parameters and return variables,
+	// so that only functions that are very likely to be equal are compared.
+	auto& candidates = m_candidates[BlockHasher::run(_fun)];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
 		{
@@ -37,7 +37,7 @@ class EquivalentFunctionDetector: public ASTWalker
 public:
 	static std::map<YulString, FunctionDefinition const*> run(Block& _block)
 	{
-		EquivalentFunctionDetector detector{BlockHasher::run(_block)};
+		EquivalentFunctionDetector detector;
 		detector(_block);
 		return std::move(detector.m_duplicates);
 	}
@@ -46,9 +46,9 @@ public:
 	void operator()(FunctionDefinition const& _fun) override;
 
 private:
-	EquivalentFunctionDetector(std::map<Block const*, uint64_t> _blockHashes): m_blockHashes(std::move(_blockHashes)) {}
+	EquivalentFunctionDetector() = default;
 
-	std::map<Block const*, uint64_t> m_blockHashes;
+	/// Functions that are not duplicates, by the hash of their definition.
 	std::map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
@@ -82,7 +82,8 @@ void ExpressionJoiner::visit(Expression& _e)
 
 ExpressionJoiner::ExpressionJoiner(Block& _ast)
 {
-	m_references = ReferencesCounter::countReferences(_ast);
+	// Only variables declared in the latest statement can be joined.
+	m_references = ReferencesCounter::countReferences(_ast, ReferencesCounter::OnlyVariables);
 }
 
 void ExpressionJoiner::handleArguments(vector<Expression>& _arguments)
@@ -141,5 +142,8 @@ bool ExpressionJoiner::isLatestStatementVarDeclJoinable(Identifier const& _ident
 		return false;
 	assertThrow(varDecl.variables.size() == 1, OptimizerException, "");
 	assertThrow(varDecl.value, OptimizerException, "");
-	return varDecl.variables.at(0).name == _identifier.name && m_references[_identifier.name] == 1;
+	if (varDecl.variables.at(0).name != _identifier.name)
+		return false;
+	auto references = m_references.find(_identifier.name);
+	return references != m_references.end() && references->second == 1;
 }
@@ -23,8 +23,13 @@
 
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -40,4 +45,38 @@ void ExpressionSimplifier::visit(Expression& _expression)
 
 	while (auto const* match = SimplificationRules::findFirstMatch(_expression, m_dialect, m_value))
 		_expression = match->action().toExpression(debugDataOf(_expression));
+
+	if (auto replacement = simplifyUsingValueRanges(_expression))
+		_expression = std::move(*replacement);
+}
+
+optional<Expression> ExpressionSimplifier::simplifyUsingValueRanges(Expression const& _expression)
+{
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+	if (!instruction || !SideEffectsCollector(m_dialect, _expression).movable())
+		return nullopt;
+
+	KnowledgeBase::ValueRange range = m_knowledgeBase.valueRange(_expression);
+	if (range.isConstant())
+		return Literal{debugDataOf(_expression), LiteralKind::Number, YulString{util::formatNumber(range.min)}, {}};
+
+	vector<Expression> const& arguments = *instruction->second;
+	if (instruction->first == evmasm::Instruction::AND)
+		// Masks that do not remove any bit the other argument can have, e.g. the cleanup of a value
+		// that is known to fit its type.
+		for (size_t i = 0; i < 2; ++i)
+		{
+			KnowledgeBase::ValueRange mask = m_knowledgeBase.valueRange(arguments[1 - i]);
+			u256 valueMax = m_knowledgeBase.valueRange(arguments[i]).max;
+			if (mask.isConstant() && (mask.min & (mask.min + 1)) == 0 && valueMax <= mask.min)
+				return arguments[i];
+		}
+	else if (instruction->first == evmasm::Instruction::ISZERO)
+		// Double negation of a value that is already zero or one, e.g. the cleanup of a boolean.
+		if (auto inner = SimplificationRules::instructionAndArguments(m_dialect, arguments.front()))
+			if (inner->first == evmasm::Instruction::ISZERO)
+				if (m_knowledgeBase.valueRange(inner->second->front()).max <= 1)
+					return inner->second->front();
+
+	return nullopt;
 }
@@ -25,6 +25,8 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <optional>
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -39,12 +41,17 @@ struct OptimiserStepContext;
  * It tracks the current values of variables using the DataFlowAnalyzer
  * and takes them into account for replacements.
  *
+ * Furthermore, it replaces movable expressions whose value is known from the ranges
+ * of the values of their arguments by a literal, and removes masks and double negations
+ * that do not change the value, e.g. ``and(x, 0xff)`` if ``x`` is known to be below ``0x100``.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class ExpressionSimplifier: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -52,6 +59,10 @@ public:
 
 private:
 	explicit ExpressionSimplifier(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+
+	/// @returns a simpler expression with the same value as @a _expression, determined using the
+	/// ranges of the values of its arguments, or nullopt if there is none.
+	std::optional<Expression> simplifyUsingValueRanges(Expression const& _expression);
 };
 
 }
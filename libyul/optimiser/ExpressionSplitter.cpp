@@ -30,6 +30,8 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <optional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -38,8 +40,12 @@ using namespace solidity::langutil;
 
 void ExpressionSplitter::run(OptimiserStepContext& _context, Block& _ast)
 {
-	TypeInfo typeInfo(_context.dialect, _ast);
-	ExpressionSplitter{_context.dialect, _context.dispenser, typeInfo}(_ast);
+	// All expressions of an untyped dialect have the default type, so collecting
+	// the types of all variables beforehand is not needed.
+	optional<TypeInfo> typeInfo;
+	if (_context.dialect.types.size() > 1)
+		typeInfo.emplace(_context.dialect, _ast);
+	ExpressionSplitter{_context.dialect, _context.dispenser, typeInfo ? &*typeInfo : nullptr}(_ast);
 }
 
 void ExpressionSplitter::operator()(FunctionCall& _funCall)
@@ -78,16 +84,14 @@ void ExpressionSplitter::operator()(Block& _block)
 	vector<Statement> saved;
 	swap(saved, m_statementsToPrefix);
 
-	function<std::optional<vector<Statement>>(Statement&)> f =
-			[&](Statement& _statement) -> std::optional<vector<Statement>> {
+	iterateReplacing(_block.statements, [&](Statement& _statement) -> std::optional<vector<Statement>> {
 		m_statementsToPrefix.clear();
 		visit(_statement);
 		if (m_statementsToPrefix.empty())
 			return {};
 		m_statementsToPrefix.emplace_back(std::move(_statement));
 		return std::move(m_statementsToPrefix);
-	};
-	iterateReplacing(_block.statements, f);
+	});
 
 	swap(saved, m_statementsToPrefix);
 }
@@ -101,13 +105,14 @@ void ExpressionSplitter::outlineExpression(Expression& _expr)
 
 	shared_ptr<DebugData const> debugData = debugDataOf(_expr);
 	YulString var = m_nameDispenser.newName({});
-	YulString type = m_typeInfo.typeOf(_expr);
+	YulString type = m_typeInfo ? m_typeInfo->typeOf(_expr) : m_dialect.defaultType;
 	m_statementsToPrefix.emplace_back(VariableDeclaration{
 		debugData,
 		{{TypedName{debugData, var, type}}},
 		make_unique<Expression>(std::move(_expr))
 	});
 	_expr = Identifier{debugData, var};
-	m_typeInfo.setVariableType(var, type);
+	if (m_typeInfo)
+		m_typeInfo->setVariableType(var, type);
 }
 
@@ -69,10 +69,12 @@ public:
 	void operator()(Block& _block) override;
 
 private:
+	/// @param _typeInfo types of the variables, which are only tracked for dialects with
+	/// several types. Otherwise, nullptr.
 	explicit ExpressionSplitter(
 		Dialect const& _dialect,
 		NameDispenser& _nameDispenser,
-		TypeInfo& _typeInfo
+		TypeInfo* _typeInfo
 	):
 		m_dialect(_dialect),
 		m_nameDispenser(_nameDispenser),
@@ -89,7 +91,7 @@ private:
 	std::vector<Statement> m_statementsToPrefix;
 	Dialect const& m_dialect;
 	NameDispenser& m_nameDispenser;
-	TypeInfo& m_typeInfo;
+	TypeInfo* m_typeInfo = nullptr;
 };
 
 }
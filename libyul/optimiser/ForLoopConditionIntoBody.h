@@ -44,6 +44,7 @@ class ForLoopConditionIntoBody: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -59,6 +59,7 @@ class ForLoopConditionOutOfBody: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ForLoopConditionOutOfBody"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
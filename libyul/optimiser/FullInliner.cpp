@@ -27,13 +27,18 @@
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 
+#include <queue>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -45,6 +50,25 @@ void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 	inliner.run(Pass::InlineRest);
 }
 
+void FullInliner::runWithBudget(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+	{
+		run(_context, _ast);
+		return;
+	}
+
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	inliner.run(Pass::CollectCallSites);
+	inliner.selectCallSites(
+		_context.expectedExecutionsPerDeployment,
+		_context.functionExecutionsPerDeployment
+	);
+	// Since inlined code is not visited again, every function body is traversed in the same way
+	// as before and queries the same function calls.
+	inliner.run(Pass::InlineSelected);
+}
+
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
 	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
 {
@@ -155,8 +179,23 @@ map<YulString, size_t> FullInliner::callDepths() const
 	return depths;
 }
 
-bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
+bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite, size_t _loopDepth)
 {
+	SOL_PERF_COUNTER("yul.FullInliner.candidates", 1);
+	if (m_pass == Pass::InlineSelected)
+	{
+		vector<CallSite> const& callSites = m_callSites.at(_callSite);
+		size_t index = m_queriedCallSites[_callSite]++;
+		yulAssert(index < callSites.size() && callSites[index].callee == _funCall.functionName.name, "");
+		return callSites[index].selected;
+	}
+	if (m_pass == Pass::CollectCallSites)
+		m_callSites[_callSite].emplace_back(CallSite{
+			_funCall.functionName.name,
+			_loopDepth,
+			hasConstantArgument(_funCall)
+		});
+
 	// No recursive inlining
 	if (_funCall.functionName.name == _callSite)
 		return false;
@@ -168,6 +207,12 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (m_noInlineFunctions.count(_funCall.functionName.name) || recursive(*calledFunction))
 		return false;
 
+	if (m_pass == Pass::CollectCallSites)
+	{
+		m_callSites[_callSite].back().inlinable = true;
+		return false;
+	}
+
 	// Inline really, really tiny functions
 	size_t size = m_functionSizes.at(calledFunction->name);
 	if (size <= 1)
@@ -185,18 +230,125 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		return true;
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
-	bool constantArg = false;
+	bool constantArg = hasConstantArgument(_funCall);
+
+	return (size < 6 || (constantArg && size < 12));
+}
+
+bool FullInliner::hasConstantArgument(FunctionCall const& _funCall) const
+{
 	for (auto const& argument: _funCall.arguments)
 		if (holds_alternative<Literal>(argument) || (
 			holds_alternative<Identifier>(argument) &&
 			m_constants.count(std::get<Identifier>(argument).name)
 		))
+			return true;
+	return false;
+}
+
+void FullInliner::selectCallSites(
+	optional<size_t> _expectedExecutionsPerDeployment,
+	map<YulString, size_t> const& _functionExecutionsPerDeployment
+)
+{
+	// Functions larger than this are not inlined into, as in the InlineRest pass.
+	size_t const maxCallerSize = 45;
+	// The code may grow by half its size, but at least by this amount.
+	size_t const minGrowthBudget = 64;
+	// Code is assumed to be executed ten times more often per level of loop nesting,
+	// up to this level.
+	size_t const maxLoopDepth = 3;
+	// Rough number of bytes of bytecode per unit of code size.
+	size_t const bytesPerCodeSize = 2;
+
+	auto const& dialect = dynamic_cast<EVMDialect const&>(m_dialect);
+	bool const isCreation = !_expectedExecutionsPerDeployment;
+	bigint const runs = isCreation ? 1 : *_expectedExecutionsPerDeployment;
+	bigint const byteDataGas = GasMeterVisitor::instructionCosts(evmasm::Instruction::JUMPDEST, dialect, isCreation).second;
+
+	// Costs saved by each call that is inlined: Pushing the return label and the function label,
+	// jumping to the function and back and moving each argument and return value into place.
+	auto callCosts = [&](FunctionDefinition const& _function) {
+		size_t movedValues = _function.parameters.size() + _function.returnVariables.size();
+		bigint runGas =
+			2 * GasMeterVisitor::instructionCosts(evmasm::Instruction::PUSH2, dialect, isCreation).first +
+			2 * GasMeterVisitor::instructionCosts(evmasm::Instruction::JUMP, dialect, isCreation).first +
+			2 * GasMeterVisitor::instructionCosts(evmasm::Instruction::JUMPDEST, dialect, isCreation).first +
+			movedValues * GasMeterVisitor::instructionCosts(evmasm::Instruction::SWAP1, dialect, isCreation).first;
+		bigint dataGas = (8 + movedValues) * byteDataGas;
+		return pair{runGas, dataGas};
+	};
+
+	struct Candidate
+	{
+		bigint netSavings;
+		/// Growth of the code in units of code size.
+		size_t growth;
+		/// Size of the called function at the time the candidate was evaluated.
+		size_t calleeSize;
+		YulString caller;
+		size_t index;
+	};
+	auto evaluate = [&](YulString _caller, size_t _index) -> optional<Candidate> {
+		CallSite const& callSite = m_callSites.at(_caller).at(_index);
+		if (!callSite.inlinable)
+			return nullopt;
+		size_t calleeSize = m_functionSizes.at(callSite.callee);
+		// The called function can be removed after inlining its only call.
+		size_t growth = m_singleUse.count(callSite.callee) ? 0 : calleeSize;
+		auto [runGas, dataGas] = callCosts(*m_functions.at(callSite.callee));
+		bigint callerRuns = runs;
+		if (!isCreation && _functionExecutionsPerDeployment.count(_caller))
+			callerRuns = _functionExecutionsPerDeployment.at(_caller);
+		bigint executions = callerRuns * boost::multiprecision::pow(bigint(10), static_cast<unsigned>(min(callSite.loopDepth, maxLoopDepth)));
+		bigint savings = runGas * executions * (callSite.constantArgument ? 2 : 1) + dataGas;
+		bigint netSavings = savings - bytesPerCodeSize * growth * byteDataGas;
+		if (netSavings <= 0)
+			return nullopt;
+		return Candidate{move(netSavings), growth, calleeSize, _caller, _index};
+	};
+	// Candidates with higher net savings per growth come first. Ties are broken by
+	// the name of the calling function and the order of the calls in it.
+	auto lowerPriority = [](Candidate const& _a, Candidate const& _b) {
+		bigint a = _a.netSavings * max<size_t>(_b.growth, 1);
+		bigint b = _b.netSavings * max<size_t>(_a.growth, 1);
+		if (a != b)
+			return a < b;
+		return tie(_b.caller, _b.index) < tie(_a.caller, _a.index);
+	};
+	priority_queue<Candidate, vector<Candidate>, decltype(lowerPriority)> queue(lowerPriority);
+	for (auto const& [caller, callSites]: m_callSites)
+		for (size_t index = 0; index < callSites.size(); ++index)
+			if (optional<Candidate> candidate = evaluate(caller, index))
+				queue.push(move(*candidate));
+
+	size_t budget = max(CodeSize::codeSizeIncludingFunctions(m_ast) / 2, minGrowthBudget);
+	// Functions whose body was copied by a selected call site. Inlining into them would
+	// make the copies larger than accounted for.
+	set<YulString> copiedFunctions;
+	while (!queue.empty())
+	{
+		Candidate candidate = queue.top();
+		queue.pop();
+		CallSite& callSite = m_callSites.at(candidate.caller).at(candidate.index);
+		if (m_functionSizes.at(callSite.callee) != candidate.calleeSize)
 		{
-			constantArg = true;
-			break;
+			if (optional<Candidate> updated = evaluate(candidate.caller, candidate.index))
+				queue.push(move(*updated));
+			continue;
 		}
+		if (
+			copiedFunctions.count(candidate.caller) ||
+			candidate.growth > budget ||
+			(candidate.calleeSize > 1 && m_functionSizes.at(candidate.caller) > maxCallerSize)
+		)
+			continue;
 
-	return (size < 6 || (constantArg && size < 12));
+		callSite.selected = true;
+		budget -= candidate.growth;
+		m_functionSizes.at(candidate.caller) += candidate.calleeSize;
+		copiedFunctions.insert(callSite.callee);
+	}
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
@@ -220,6 +372,13 @@ bool FullInliner::recursive(FunctionDefinition const& _fun) const
 	return references[_fun.name] > 0;
 }
 
+void InlineModifier::operator()(ForLoop& _loop)
+{
+	++m_loopDepth;
+	ASTModifier::operator()(_loop);
+	--m_loopDepth;
+}
+
 void InlineModifier::operator()(Block& _block)
 {
 	function<std::optional<vector<Statement>>(Statement&)> f = [&](Statement& _statement) -> std::optional<vector<Statement>> {
@@ -245,7 +404,7 @@ std::optional<vector<Statement>> InlineModifier::tryInlineStatement(Statement& _
 			util::VisitorFallback<FunctionCall*>{},
 			[](FunctionCall& _e) { return &_e; }
 		}, *e);
-		if (funCall && m_driver.shallInline(*funCall, m_currentFunction))
+		if (funCall && m_driver.shallInline(*funCall, m_currentFunction, m_loopDepth))
 			return performInline(_statement, *funCall);
 	}
 	return {};
@@ -260,6 +419,7 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	SOL_PERF_COUNTER("yul.FullInliner.inlinedCalls", 1);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -30,9 +30,11 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <map>
 #include <optional>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -73,9 +75,14 @@ public:
 	static constexpr char const* name{"FullInliner"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
+	/// Inlines the calls that are selected using a benefit/cost model under a global
+	/// code size budget, see BudgetedInliner.
+	static void runWithBudget(OptimiserStepContext& _context, Block& _ast);
+
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
-	bool shallInline(FunctionCall const& _funCall, YulString _callSite);
+	/// @param _loopDepth the number of for loops the function call is nested in.
+	bool shallInline(FunctionCall const& _funCall, YulString _callSite, size_t _loopDepth = 0);
 
 	FunctionDefinition* function(YulString _name)
 	{
@@ -91,11 +98,33 @@ public:
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
 private:
-	enum Pass { InlineTiny, InlineRest };
+	enum Pass { InlineTiny, InlineRest, CollectCallSites, InlineSelected };
+
+	/// A function call that is queried for inlining in the CollectCallSites pass.
+	struct CallSite
+	{
+		YulString callee;
+		size_t loopDepth = 0;
+		bool constantArgument = false;
+		/// True if the function can be inlined at all.
+		bool inlinable = false;
+		/// Set when the call is selected to be inlined in the InlineSelected pass.
+		bool selected = false;
+	};
 
 	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
 	void run(Pass _pass);
 
+	/// @returns true if there is a literal or a constant among the arguments of @a _funCall.
+	bool hasConstantArgument(FunctionCall const& _funCall) const;
+	/// Selects the call sites to inline among the ones found in the CollectCallSites pass.
+	/// The calls inside the functions in @a _functionExecutionsPerDeployment are assumed
+	/// to be executed as often as given there instead of @a _expectedExecutionsPerDeployment.
+	void selectCallSites(
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		std::map<YulString, size_t> const& _functionExecutionsPerDeployment
+	);
+
 	/// @returns a map containing the maximum depths of a call chain starting at each
 	/// function. For recursive functions, the value is one larger than for all others.
 	std::map<YulString, size_t> callDepths() const;
@@ -116,10 +145,42 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// The function calls queried for inlining per calling function, in the order
+	/// they are queried in. Only used by runWithBudget.
+	std::map<YulString, std::vector<CallSite>> m_callSites;
+	/// The number of function calls queried for inlining per calling function in the current pass.
+	std::map<YulString, size_t> m_queriedCallSites;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
 
+/**
+ * Optimiser component that inlines functions like the FullInliner, but decides which
+ * function calls to inline by comparing the gas saved by not calling the function
+ * to the gas needed to deploy the larger code, taking the expected number of executions
+ * of the code and the nesting of the call in loops into account.
+ *
+ * The function calls are inlined in the order of their net savings relative to the
+ * growth of the code, until a global budget for the growth of the code is used up.
+ * The size of functions that can be inlined into is limited in the same way as for the
+ * FullInliner. Calls to functions that are only called once are always beneficial.
+ *
+ * Only cost models for the EVM dialects are available. For other dialects,
+ * the step behaves like the FullInliner.
+ *
+ * Prerequisites: Disambiguator
+ * More efficient if run after: Function Hoister, Expression Splitter
+ */
+class BudgetedInliner
+{
+public:
+	static constexpr char const* name{"BudgetedInliner"};
+	static void run(OptimiserStepContext& _context, Block& _ast)
+	{
+		FullInliner::runWithBudget(_context, _ast);
+	}
+};
+
 /**
  * Class that walks the AST of a block that does not contain function definitions and perform
  * the actual code modifications.
@@ -135,12 +196,14 @@ public:
 	{ }
 
 	void operator()(Block& _block) override;
+	void operator()(ForLoop& _loop) override;
 
 private:
 	std::optional<std::vector<Statement>> tryInlineStatement(Statement& _statement);
 	std::vector<Statement> performInline(Statement& _statement, FunctionCall& _funCall);
 
 	YulString m_currentFunction;
+	size_t m_loopDepth = 0;
 	FullInliner& m_driver;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
@@ -20,22 +20,42 @@
 
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 #include <libyul/YulString.h>
 #include <libsolutil/CommonData.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <algorithm>
 #include <variant>
 
 using namespace std;
+using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// @returns the values and types of the literal arguments, which identify a specialization.
+vector<optional<pair<u256, YulString>>> literalArgumentValues(FunctionSpecializer::LiteralArguments const& _arguments)
+{
+	return applyMap(_arguments, [](optional<Expression> const& _argument) -> optional<pair<u256, YulString>> {
+		if (!_argument)
+			return nullopt;
+		Literal const& literal = get<Literal>(*_argument);
+		return make_pair(valueOfLiteral(literal), literal.type);
+	});
+}
+
+}
+
 FunctionSpecializer::LiteralArguments FunctionSpecializer::specializableArguments(
 	FunctionCall const& _f
 )
@@ -57,7 +77,8 @@ void FunctionSpecializer::operator()(FunctionCall& _f)
 	// TODO When backtracking is implemented, the restriction of recursive functions can be lifted.
 	if (
 		m_dialect.builtin(_f.functionName.name) ||
-		m_recursiveFunctions.count(_f.functionName.name)
+		m_recursiveFunctions.count(_f.functionName.name) ||
+		!m_functions.count(_f.functionName.name)
 	)
 		return;
 
@@ -65,10 +86,22 @@ void FunctionSpecializer::operator()(FunctionCall& _f)
 
 	if (ranges::any_of(arguments, [](auto& _a) { return _a.has_value(); }))
 	{
-		YulString oldName = move(_f.functionName.name);
-		auto newName = m_nameDispenser.newName(oldName);
-
-		m_oldToNewMap[oldName].emplace_back(make_pair(newName, arguments));
+		YulString newName;
+		if (auto existing = existingSpecialization(_f.functionName.name, arguments))
+			newName = *existing;
+		else
+		{
+			size_t growth = CodeSize::codeSize(m_functions.at(_f.functionName.name)->body);
+			if (growth > m_growthBudget)
+				return;
+			m_growthBudget -= growth;
+
+			YulString oldName = _f.functionName.name;
+			newName = m_nameDispenser.newName(oldName);
+			m_specializations[{oldName, literalArgumentValues(arguments)}] = newName;
+			m_newParameterCounts[newName] = static_cast<size_t>(count(arguments.begin(), arguments.end(), nullopt));
+			m_oldToNewMap[oldName].emplace_back(make_pair(newName, arguments));
+		}
 
 		_f.functionName.name = newName;
 		_f.arguments = util::filter(
@@ -78,6 +111,37 @@ void FunctionSpecializer::operator()(FunctionCall& _f)
 	}
 }
 
+optional<YulString> FunctionSpecializer::existingSpecialization(
+	YulString _function,
+	LiteralArguments const& _arguments
+)
+{
+	YulString const* name = valueOrNullptr(m_specializations, make_pair(_function, literalArgumentValues(_arguments)));
+	if (!name)
+		return nullopt;
+
+	// The specialization might have been removed or replaced by a function with fewer parameters
+	// by other steps.
+	size_t parameterCount = static_cast<size_t>(count(_arguments.begin(), _arguments.end(), nullopt));
+	if (size_t const* newParameterCount = valueOrNullptr(m_newParameterCounts, *name))
+		return *newParameterCount == parameterCount ? optional<YulString>{*name} : nullopt;
+	FunctionDefinition const* const* function = valueOrNullptr(m_functions, *name);
+	if (!function || (*function)->parameters.size() != parameterCount)
+		return nullopt;
+	return *name;
+}
+
+size_t FunctionSpecializer::growthBudget(Block const& _ast, optional<size_t> _expectedExecutionsPerDeployment)
+{
+	// The code may grow by a fraction of its size that depends on how often it is executed,
+	// but at least by this amount.
+	size_t const minGrowthBudget = 64;
+	size_t divisor = 8;
+	if (_expectedExecutionsPerDeployment)
+		divisor = *_expectedExecutionsPerDeployment < 200 ? 4 : *_expectedExecutionsPerDeployment < 10000 ? 2 : 1;
+	return max(CodeSize::codeSizeIncludingFunctions(_ast) / divisor, minGrowthBudget);
+}
+
 FunctionDefinition FunctionSpecializer::specialize(
 	FunctionDefinition const& _f,
 	YulString _newName,
@@ -127,8 +191,16 @@ FunctionDefinition FunctionSpecializer::specialize(
 
 void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
 {
+	map<YulString, FunctionDefinition const*> functions;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions[function->name] = function;
+
 	FunctionSpecializer f{
 		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
+		move(functions),
+		_context.functionSpecializations,
+		growthBudget(_ast, _context.expectedExecutionsPerDeployment),
 		_context.dispenser,
 		_context.dialect
 	};
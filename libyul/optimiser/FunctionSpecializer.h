@@ -47,6 +47,11 @@ namespace solidity::yul
  * Other optimization steps will be able to make more simplifications to the function. The
  * optimization step is mainly useful for functions that would not be inlined.
  *
+ * Calls with the same literal arguments share a specialization, also with the specializations
+ * created by earlier applications of the step that still exist. Each new specialization adds
+ * the size of the function to the code, which is limited by a budget that is larger if the
+ * code is expected to be executed more often.
+ *
  * Prerequisites: Disambiguator, FunctionHoister
  *
  * LiteralRematerialiser is recommended as a prerequisite, even though it's not required for
@@ -68,13 +73,25 @@ public:
 private:
 	explicit FunctionSpecializer(
 		std::set<YulString> _recursiveFunctions,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		FunctionSpecializations& _specializations,
+		size_t _growthBudget,
 		NameDispenser& _nameDispenser,
 		Dialect const& _dialect
 	):
 		m_recursiveFunctions(std::move(_recursiveFunctions)),
+		m_functions(std::move(_functions)),
+		m_specializations(_specializations),
+		m_growthBudget(_growthBudget),
 		m_nameDispenser(_nameDispenser),
 		m_dialect(_dialect)
 	{}
+	/// @returns the growth of the code in units of code size up to which new specializations
+	/// are created in @a _ast.
+	static size_t growthBudget(Block const& _ast, std::optional<size_t> _expectedExecutionsPerDeployment);
+	/// @returns the name of an existing specialization of @a _function for @a _arguments or
+	/// nullopt if there is none.
+	std::optional<YulString> existingSpecialization(YulString _function, LiteralArguments const& _arguments);
 	/// Returns a vector of Expressions, where the index `i` is an expression if the function's
 	/// `i`-th argument can be specialized, nullopt otherwise.
 	LiteralArguments specializableArguments(FunctionCall const& _f);
@@ -105,6 +122,13 @@ private:
 	std::map<YulString, std::vector<std::pair<YulString, LiteralArguments>>> m_oldToNewMap;
 	/// We skip specializing recursive functions. Need backtracking to properly deal with them.
 	std::set<YulString> const m_recursiveFunctions;
+	/// Function definitions at the top level of the AST by name.
+	std::map<YulString, FunctionDefinition const*> const m_functions;
+	/// Number of parameters of the specializations created by this application of the step.
+	std::map<YulString, size_t> m_newParameterCounts;
+	FunctionSpecializations& m_specializations;
+	/// Remaining growth of the code in units of code size.
+	size_t m_growthBudget = 0;
 
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
@@ -0,0 +1,220 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/InterproceduralConstantPropagator.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <functional>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Collects the assignments to a variable and whether the code contains a leave statement.
+ */
+class AssignmentAndLeaveCollector: public ASTWalker
+{
+public:
+	explicit AssignmentAndLeaveCollector(YulString _variable): m_variable(_variable) {}
+
+	using ASTWalker::operator();
+	void operator()(Assignment const& _assignment) override
+	{
+		for (auto const& var: _assignment.variableNames)
+			if (var.name == m_variable)
+				assignments.emplace_back(&_assignment);
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(Leave const&) override { containsLeave = true; }
+
+	vector<Assignment const*> assignments;
+	bool containsLeave = false;
+
+private:
+	YulString m_variable;
+};
+
+/**
+ * Replaces calls to functions with a known constant result that can be removed.
+ */
+class ConstantCallReplacer: public ASTModifier
+{
+public:
+	ConstantCallReplacer(
+		Dialect const& _dialect,
+		map<YulString, SideEffects> const& _functionSideEffects,
+		map<YulString, u256> const& _constantResults
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects),
+		m_constantResults(_constantResults)
+	{}
+
+	using ASTModifier::operator();
+	void visit(Expression& _expression) override
+	{
+		ASTModifier::visit(_expression);
+		FunctionCall const* call = get_if<FunctionCall>(&_expression);
+		if (!call)
+			return;
+		auto result = m_constantResults.find(call->functionName.name);
+		if (result == m_constantResults.end())
+			return;
+		SideEffectsCollector sideEffects{m_dialect, _expression, &m_functionSideEffects};
+		if (sideEffects.movable() && sideEffects.canBeRemoved())
+			_expression = Literal{debugDataOf(_expression), LiteralKind::Number, YulString{util::formatNumber(result->second)}, {}};
+	}
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	map<YulString, u256> const& m_constantResults;
+};
+
+/// @returns the value of @a _expression if it is a literal or an SSA variable with a constant value.
+optional<u256> constantValue(Expression const& _expression, map<YulString, Expression const*> const& _ssaValues)
+{
+	Expression const* expression = &_expression;
+	while (Identifier const* identifier = get_if<Identifier>(expression))
+	{
+		auto value = _ssaValues.find(identifier->name);
+		if (value == _ssaValues.end())
+			return nullopt;
+		expression = value->second;
+	}
+	if (Literal const* literal = get_if<Literal>(expression))
+		return valueOfLiteral(*literal);
+	return nullopt;
+}
+
+/// @returns the value returned by @a _function if it is always the same constant.
+optional<u256> constantResult(FunctionDefinition const& _function, map<YulString, Expression const*> const& _ssaValues)
+{
+	if (_function.returnVariables.size() != 1)
+		return nullopt;
+	YulString returnVariable = _function.returnVariables.front().name;
+
+	AssignmentAndLeaveCollector assignments{returnVariable};
+	assignments(_function.body);
+	if (assignments.assignments.empty())
+		return u256(0);
+
+	optional<u256> result;
+	for (Assignment const* assignment: assignments.assignments)
+	{
+		if (assignment->variableNames.size() != 1)
+			return nullopt;
+		optional<u256> value = constantValue(*assignment->value, _ssaValues);
+		if (!value || (result && *result != *value))
+			return nullopt;
+		result = value;
+	}
+	if (*result == 0)
+		return result;
+
+	// The return variable keeps its initial value zero on paths that leave the function
+	// before it is assigned. Only paths through the top level of the body are considered.
+	AssignmentAndLeaveCollector leaves{returnVariable};
+	for (Statement const& statement: _function.body.statements)
+	{
+		if (
+			Assignment const* assignment = get_if<Assignment>(&statement);
+			assignment && assignment->variableNames.front().name == returnVariable
+		)
+			return leaves.containsLeave ? nullopt : result;
+		leaves.visit(statement);
+	}
+	return nullopt;
+}
+
+}
+
+void InterproceduralConstantPropagator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	run(_context, _ast, _context.analysisCache.information(_context.dialect, _ast));
+}
+
+void InterproceduralConstantPropagator::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
+	map<YulString, FunctionDefinition*> functions;
+	for (Statement& statement: _ast.statements)
+		if (FunctionDefinition* definition = get_if<FunctionDefinition>(&statement))
+			functions[definition->name] = definition;
+	if (functions.empty())
+		return;
+
+	// Visit callees before their callers. Functions in cycles are visited
+	// before all their callees are done, which only means that fewer calls are replaced.
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	vector<FunctionDefinition*> order;
+	set<YulString> visited;
+	function<void(YulString)> addInOrder = [&](YulString _function) {
+		if (!functions.count(_function) || !visited.insert(_function).second)
+			return;
+		if (auto callees = callGraph.functionCalls.find(_function); callees != callGraph.functionCalls.end())
+			for (YulString callee: callees->second)
+				addInOrder(callee);
+		order.emplace_back(functions.at(_function));
+	};
+	for (auto const& item: functions)
+		addInOrder(item.first);
+
+	// Expressions are only replaced by literals in place, so the values stay valid.
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+
+	map<YulString, u256> constantResults;
+	ConstantCallReplacer replacer{_context.dialect, _information.functionSideEffects, constantResults};
+	for (FunctionDefinition* definition: order)
+	{
+		replacer(definition->body);
+		if (optional<u256> result = constantResult(*definition, ssaValues.values()))
+			constantResults[definition->name] = *result;
+	}
+	if (constantResults.empty())
+		return;
+	for (Statement& statement: _ast.statements)
+		if (!holds_alternative<FunctionDefinition>(statement))
+			replacer.visit(statement);
+
+	map<YulString, size_t> references = ReferencesCounter::countReferences(_ast);
+	util::iterateReplacing(_ast.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+		if (FunctionDefinition const* definition = get_if<FunctionDefinition>(&_statement))
+			if (constantResults.count(definition->name) && !references.count(definition->name))
+				return vector<Statement>{};
+		return nullopt;
+	});
+}
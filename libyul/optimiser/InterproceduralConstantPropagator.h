@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimiser step that replaces calls to functions that always return the same constant by it.
+ *
+ * A function with a single return variable returns a constant if all assignments to the return
+ * variable assign the same constant, either a literal or an SSA variable with a constant value,
+ * and the function cannot return before the first such assignment at the top level of its body.
+ * A function whose return variable is never assigned returns zero.
+ *
+ * Calls to such functions are replaced by the constant if the call, including the evaluation of
+ * its arguments, is movable and can be removed. The functions are visited in the order of the call
+ * graph such that callees come first, which makes results propagate through chains of calls
+ * like `function f() -> r { r := g() }`. Functions whose calls were all replaced are removed.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister
+ */
+struct InterproceduralConstantPropagator
+{
+	static constexpr char const* name{"InterproceduralConstantPropagator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(
+		OptimiserStepContext& _context,
+		Block& _ast,
+		InterproceduralInformation const& _information
+	);
+};
+
+}
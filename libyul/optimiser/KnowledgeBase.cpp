@@ -26,6 +26,8 @@
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <libevmasm/Instruction.h>
+
 #include <libsolutil/CommonData.h>
 
 #include <variant>
@@ -48,7 +50,9 @@ bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
 	if (holds_alternative<Literal>(expr2))
 		return valueOfLiteral(std::get<Literal>(expr2)) == 0;
 
-	return false;
+	ValueRange a = valueRange(Identifier{{}, _a});
+	ValueRange b = valueRange(Identifier{{}, _b});
+	return a.max < b.min || b.max < a.min;
 }
 
 bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
@@ -63,7 +67,159 @@ bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 		return val >= 32 && val <= u256(0) - 32;
 	}
 
-	return false;
+	// The difference `_b - _a` is between `b.min - a.max` and `b.max - a.min` if `_a` is smaller.
+	ValueRange a = valueRange(Identifier{{}, _a});
+	ValueRange b = valueRange(Identifier{{}, _b});
+	if (b.max < a.min)
+		swap(a, b);
+	return a.max < b.min && b.min - a.max >= 32 && b.max - a.min <= u256(0) - 32;
+}
+
+KnowledgeBase::ValueRange KnowledgeBase::valueRange(Expression const& _expression)
+{
+	bool startedRecursion = (m_valueRangeBudget == 0);
+	ScopeGuard resetBudget{[&] { if (startedRecursion) m_valueRangeBudget = 0; }};
+
+	if (startedRecursion)
+		m_valueRangeBudget = 100;
+	else if (m_valueRangeBudget == 1)
+		return {};
+	else
+		--m_valueRangeBudget;
+
+	if (Literal const* literal = get_if<Literal>(&_expression))
+	{
+		u256 value = valueOfLiteral(*literal);
+		return {value, value};
+	}
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		auto value = m_variableValues.find(identifier->name);
+		if (value != m_variableValues.end() && value->second.value)
+			return valueRange(*value->second.value);
+	}
+	else if (auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression))
+		return valueRangeOfInstruction(instruction->first, *instruction->second);
+	return {};
+}
+
+KnowledgeBase::ValueRange KnowledgeBase::valueRangeOfInstruction(
+	evmasm::Instruction _instruction,
+	vector<Expression> const& _arguments
+)
+{
+	using evmasm::Instruction;
+	static u256 const maxValue = ~u256(0);
+	// @returns the smallest number of the form 2**n - 1 that is at least @a _value.
+	auto const allOnesUpTo = [](u256 const& _value) -> u256 {
+		if (_value == 0)
+			return 0;
+		unsigned highestBit = boost::multiprecision::msb(_value);
+		return highestBit == 255 ? maxValue : (u256(1) << (highestBit + 1)) - 1;
+	};
+	ValueRange const boolean{0, 1};
+
+	switch (_instruction)
+	{
+	case Instruction::ADDRESS:
+	case Instruction::CALLER:
+	case Instruction::ORIGIN:
+	case Instruction::COINBASE:
+		return {0, (u256(1) << 160) - 1};
+	default:
+		break;
+	}
+
+	if (_arguments.size() == 1)
+	{
+		ValueRange a = valueRange(_arguments[0]);
+		switch (_instruction)
+		{
+		case Instruction::ISZERO:
+			if (a.min > 0)
+				return {0, 0};
+			else if (a.max == 0)
+				return {1, 1};
+			return boolean;
+		case Instruction::NOT:
+			return {~a.max, ~a.min};
+		default:
+			return {};
+		}
+	}
+	if (_arguments.size() != 2)
+		return {};
+
+	ValueRange a = valueRange(_arguments[0]);
+	ValueRange b = valueRange(_arguments[1]);
+	switch (_instruction)
+	{
+	case Instruction::ADD:
+		if (a.max <= maxValue - b.max)
+			return {a.min + b.min, a.max + b.max};
+		break;
+	case Instruction::SUB:
+		if (a.min >= b.max)
+			return {a.min - b.max, a.max - b.min};
+		break;
+	case Instruction::MUL:
+		if (bigint(a.max) * bigint(b.max) <= bigint(maxValue))
+			return {a.min * b.min, a.max * b.max};
+		break;
+	case Instruction::DIV:
+		// Division by zero results in zero.
+		if (b.min == 0)
+			return {0, a.max};
+		return {a.min / b.max, a.max / b.min};
+	case Instruction::MOD:
+		if (b.max == 0)
+			return {0, 0};
+		return {0, min(a.max, b.max - 1)};
+	case Instruction::AND:
+		return {0, min(a.max, b.max)};
+	case Instruction::OR:
+		return {max(a.min, b.min), allOnesUpTo(max(a.max, b.max))};
+	case Instruction::XOR:
+		return {0, allOnesUpTo(max(a.max, b.max))};
+	case Instruction::SHL:
+		if (a.isConstant() && a.min < 256 && b.max <= (maxValue >> unsigned(a.min)))
+			return {b.min << unsigned(a.min), b.max << unsigned(a.min)};
+		break;
+	case Instruction::SHR:
+		if (a.isConstant())
+		{
+			if (a.min >= 256)
+				return {0, 0};
+			return {b.min >> unsigned(a.min), b.max >> unsigned(a.min)};
+		}
+		return {0, b.max};
+	case Instruction::BYTE:
+		return {0, 0xff};
+	case Instruction::LT:
+		if (a.max < b.min)
+			return {1, 1};
+		else if (a.min >= b.max)
+			return {0, 0};
+		return boolean;
+	case Instruction::GT:
+		if (a.min > b.max)
+			return {1, 1};
+		else if (a.max <= b.min)
+			return {0, 0};
+		return boolean;
+	case Instruction::EQ:
+		if (a.isConstant() && b.isConstant() && a.min == b.min)
+			return {1, 1};
+		else if (a.max < b.min || b.max < a.min)
+			return {0, 0};
+		return boolean;
+	case Instruction::SLT:
+	case Instruction::SGT:
+		return boolean;
+	default:
+		break;
+	}
+	return {};
 }
 
 Expression KnowledgeBase::simplify(Expression _expression)
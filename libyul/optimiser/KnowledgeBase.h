@@ -24,8 +24,15 @@
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
 
+#include <libsolutil/Common.h>
+
 #include <map>
 
+namespace solidity::evmasm
+{
+enum class Instruction: uint8_t;
+}
+
 namespace solidity::yul
 {
 
@@ -45,16 +52,32 @@ public:
 		m_variableValues(_variableValues)
 	{}
 
+	/// Inclusive bounds of the values an expression can evaluate to, interpreted as unsigned numbers.
+	struct ValueRange
+	{
+		u256 min = 0;
+		u256 max = ~u256(0);
+
+		bool isConstant() const { return min == max; }
+	};
+
 	bool knownToBeDifferent(YulString _a, YulString _b);
 	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b);
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
 
+	/// @returns bounds of the value of @a _expression, derived from the current values of the variables
+	/// and from the ranges of the results of built-in functions. Only EVM instructions are taken into account.
+	ValueRange valueRange(Expression const& _expression);
+
 private:
 	Expression simplify(Expression _expression);
+	ValueRange valueRangeOfInstruction(evmasm::Instruction _instruction, std::vector<Expression> const& _arguments);
 
 	Dialect const& m_dialect;
 	std::map<YulString, AssignedValue> const& m_variableValues;
 	size_t m_recursionCounter = 0;
+	/// Number of expressions that can still be visited by the current call to @a valueRange.
+	size_t m_valueRangeBudget = 0;
 };
 
 }
@@ -43,11 +43,19 @@ using namespace solidity::yul;
 
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	run(_context, _ast, _context.analysisCache.information(_context.dialect, _ast));
+}
+
+void LoadResolver::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
+		_information.functionSideEffects,
+		_information.containsMSize,
 		_context.expectedExecutionsPerDeployment
 	}(_ast);
 }
@@ -82,12 +90,12 @@ void LoadResolver::tryResolve(
 	YulString key = std::get<Identifier>(_arguments.at(0)).name;
 	if (_location == StoreLoadLocation::Storage)
 	{
-		if (auto value = util::valueOrNullptr(m_storage, key))
+		if (auto value = util::valueOrNullptr(m_storage.values, key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 	}
 	else if (!m_containsMSize && _location == StoreLoadLocation::Memory)
-		if (auto value = util::valueOrNullptr(m_memory, key))
+		if (auto value = util::valueOrNullptr(m_memory.values, key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 }
@@ -129,7 +137,7 @@ void LoadResolver::tryEvaluateKeccak(
 	if (!memoryKey || !length)
 		return;
 
-	auto memoryValue = util::valueOrNullptr(m_memory, memoryKey->name);
+	auto memoryValue = util::valueOrNullptr(m_memory.values, memoryKey->name);
 	if (memoryValue && inScope(*memoryValue))
 	{
 		optional<u256> memoryContent = valueOfIdentifier(*memoryValue);
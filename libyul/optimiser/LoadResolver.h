@@ -44,7 +44,9 @@ class LoadResolver: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void run(OptimiserStepContext&, Block& _ast, InterproceduralInformation const& _information);
 
 private:
 	LoadResolver(
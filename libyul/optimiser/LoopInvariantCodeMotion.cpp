@@ -23,21 +23,100 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
 #include <libsolutil/CommonData.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Collects the keys of the simple stores to storage and memory inside a loop,
+ * i.e. of the calls to the store functions of the dialect whose key is a variable.
+ * The keys of a location are reset to nullopt if anything else in the loop may write to it.
+ */
+class LoopWriteCollector: public ASTWalker
+{
+public:
+	LoopWriteCollector(Dialect const& _dialect, map<YulString, SideEffects> const& _functionSideEffects):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects),
+		m_storageStore(_dialect.storageStoreFunction(YulString{})),
+		m_memoryStore(_dialect.memoryStoreFunction(YulString{}))
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		YulString functionName = _functionCall.functionName.name;
+		Identifier const* key =
+			_functionCall.arguments.empty() ? nullptr : get_if<Identifier>(&_functionCall.arguments.front());
+		if (key && m_storageStore && functionName == m_storageStore->name)
+		{
+			if (writes.storageKeys)
+				writes.storageKeys->emplace_back(key->name);
+			return;
+		}
+		if (key && m_memoryStore && functionName == m_memoryStore->name)
+		{
+			if (writes.memoryKeys)
+				writes.memoryKeys->emplace_back(key->name);
+			return;
+		}
+
+		SideEffects sideEffects = SideEffects::worst();
+		if (BuiltinFunction const* f = m_dialect.builtin(functionName))
+			sideEffects = f->sideEffects;
+		else if (m_functionSideEffects.count(functionName))
+			sideEffects = m_functionSideEffects.at(functionName);
+		if (sideEffects.storage == SideEffects::Write)
+			writes.storageKeys.reset();
+		if (sideEffects.memory == SideEffects::Write)
+			writes.memoryKeys.reset();
+	}
+
+	LoopInvariantCodeMotion::LoopWrites writes{vector<YulString>{}, vector<YulString>{}};
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	BuiltinFunction const* m_storageStore = nullptr;
+	BuiltinFunction const* m_memoryStore = nullptr;
+};
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
-	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	run(_context, _ast, _context.analysisCache.information(_context.dialect, _ast));
+}
+
+void LoopInvariantCodeMotion::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	set<YulString> ssaVars;
+	for (auto const& value: ssaValues.values())
+		ssaVars.insert(value.first);
+	LoopInvariantCodeMotion{
+		_context.dialect,
+		ssaVars,
+		ssaValues.values(),
+		_information.functionSideEffects,
+		_information.containsMSize
+	}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,35 +137,129 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
-) const
+	SideEffects const& _forLoopSideEffects,
+	optional<LoopWrites> const& _loopWrites
+)
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable, or it is a load from a location the loop is known not to write to
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
 			return false;
 	if (_varDecl.value)
 	{
-		for (auto const& ref: ReferencesCounter::countReferences(*_varDecl.value, ReferencesCounter::OnlyVariables))
-			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
+		ValueInformation const& value = valueInformation(*_varDecl.value);
+		for (YulString ref: value.referencedVariables)
+			if (_varsDefinedInCurrentScope.count(ref) || !m_ssaVariables.count(ref))
 				return false;
-		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!SideEffectsCollector::movableRelativeTo(value.sideEffects, _forLoopSideEffects, m_containsMSize) &&
+			!(_loopWrites && isInvariantLoad(*_varDecl.value, value.sideEffects, _forLoopSideEffects, *_loopWrites))
+		)
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::isInvariantLoad(
+	Expression const& _value,
+	SideEffects const& _valueSideEffects,
+	SideEffects const& _forLoopSideEffects,
+	LoopWrites const& _loopWrites
+)
+{
+	FunctionCall const* funCall = get_if<FunctionCall>(&_value);
+	if (!funCall || funCall->arguments.size() != 1)
+		return false;
+	Identifier const* key = get_if<Identifier>(&funCall->arguments.front());
+	if (!key)
+		return false;
+
+	// The loads are compared against all simple stores inside the loop. If none of them can
+	// overlap the loaded location, the effect of the loop on this location is the same as
+	// if it did not write to it at all.
+	SideEffects otherSideEffects = _forLoopSideEffects;
+	BuiltinFunction const* storageLoad = m_dialect.storageLoadFunction(YulString{});
+	BuiltinFunction const* memoryLoad = m_dialect.memoryLoadFunction(YulString{});
+	if (storageLoad && funCall->functionName.name == storageLoad->name)
+	{
+		if (!_loopWrites.storageKeys)
+			return false;
+		for (YulString writtenKey: *_loopWrites.storageKeys)
+			if (!knowledgeBase().knownToBeDifferent(key->name, writtenKey))
+				return false;
+		otherSideEffects.storage = SideEffects::Read;
+	}
+	else if (memoryLoad && funCall->functionName.name == memoryLoad->name)
+	{
+		if (!_loopWrites.memoryKeys)
+			return false;
+		for (YulString writtenKey: *_loopWrites.memoryKeys)
+			if (!knowledgeBase().knownToBeDifferentByAtLeast32(key->name, writtenKey))
+				return false;
+		otherSideEffects.memory = SideEffects::Read;
+	}
+	else
+		return false;
+
+	return SideEffectsCollector::movableRelativeTo(_valueSideEffects, otherSideEffects, m_containsMSize);
+}
+
+KnowledgeBase& LoopInvariantCodeMotion::knowledgeBase()
+{
+	if (!m_knowledgeBase)
+	{
+		// Only the values of SSA variables that are movable and only depend on other SSA variables
+		// are the same wherever the variable is in scope. All other variables are treated as unknown.
+		for (auto const& [name, value]: m_ssaValues)
+		{
+			MovableChecker checker{m_dialect, &m_functionSideEffects};
+			checker.visit(*value);
+			if (
+				checker.movable() &&
+				all_of(
+					checker.referencedVariables().begin(),
+					checker.referencedVariables().end(),
+					[&](YulString _reference) { return m_ssaVariables.count(_reference); }
+				)
+			)
+				m_knownValues[name] = AssignedValue{value, 0};
+		}
+		m_knowledgeBase = make_unique<KnowledgeBase>(m_dialect, m_knownValues);
+	}
+	return *m_knowledgeBase;
+}
+
+LoopInvariantCodeMotion::ValueInformation const& LoopInvariantCodeMotion::valueInformation(
+	Expression const& _value
+)
+{
+	auto [it, inserted] = m_valueInformation.try_emplace(&_value);
+	if (inserted)
+	{
+		it->second.sideEffects = SideEffectsCollector{m_dialect, _value, &m_functionSideEffects}.sideEffects();
+		for (auto const& ref: ReferencesCounter::countReferences(_value, ReferencesCounter::OnlyVariables))
+			it->second.referencedVariables.emplace_back(ref.first);
+	}
+	return it->second;
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	optional<LoopWrites> loopWrites;
+	if (forLoopSideEffects.storage == SideEffects::Write || forLoopSideEffects.memory == SideEffects::Write)
+	{
+		LoopWriteCollector collector{m_dialect, m_functionSideEffects};
+		collector(_for);
+		loopWrites = move(collector.writes);
+	}
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +272,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, loopWrites))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
@@ -18,9 +18,14 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <memory>
+#include <optional>
+
 namespace solidity::yul
 {
 
@@ -28,6 +33,8 @@ namespace solidity::yul
  * Loop-invariant code motion.
  *
  * This optimization moves movable SSA variable declarations outside the loop.
+ * Loads from storage or memory are also moved if all writes to the same kind of location
+ * inside the loop are simple stores to locations known to be different from the loaded one.
  *
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
@@ -41,35 +48,78 @@ class LoopInvariantCodeMotion: public ASTModifier
 {
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(
+		OptimiserStepContext& _context,
+		Block& _ast,
+		InterproceduralInformation const& _information
+	);
 
 	void operator()(Block& _block) override;
 
+	/// Keys of the storage and memory locations written to by simple stores inside a loop,
+	/// or nullopt if the loop may also write to other locations of that kind.
+	struct LoopWrites
+	{
+		std::optional<std::vector<YulString>> storageKeys;
+		std::optional<std::vector<YulString>> memoryKeys;
+	};
+
 private:
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
+		std::map<YulString, Expression const*> const& _ssaValues,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
+		m_ssaValues(_ssaValues),
 		m_functionSideEffects(_functionSideEffects)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
+	/// @param _loopWrites the simple stores inside the loop, only set if the loop writes to storage or memory.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
-	) const;
+		SideEffects const& _forLoopSideEffects,
+		std::optional<LoopWrites> const& _loopWrites
+	);
+	/// @returns true if @a _value is a load from storage or memory that is not affected by the writes
+	/// inside the loop and is movable relative to the rest of the loop.
+	bool isInvariantLoad(
+		Expression const& _value,
+		SideEffects const& _valueSideEffects,
+		SideEffects const& _forLoopSideEffects,
+		LoopWrites const& _loopWrites
+	);
+	/// @returns the knowledge base about the values of the SSA variables, created on first use.
+	KnowledgeBase& knowledgeBase();
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
+	struct ValueInformation
+	{
+		SideEffects sideEffects;
+		std::vector<YulString> referencedVariables;
+	};
+	/// @returns the side-effects and the referenced variables of the value of a variable declaration.
+	/// They are determined once per value because declarations that are moved out of an inner loop
+	/// are considered again for every enclosing loop. This step does not modify expressions and
+	/// the values are owned by their declarations, so their addresses stay valid when moved.
+	ValueInformation const& valueInformation(Expression const& _value);
+
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
+	std::map<YulString, Expression const*> const& m_ssaValues;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	std::map<Expression const*, ValueInformation> m_valueInformation;
+	std::map<YulString, AssignedValue> m_knownValues;
+	std::unique_ptr<KnowledgeBase> m_knowledgeBase;
 };
 
 }
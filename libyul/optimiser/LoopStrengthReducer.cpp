@@ -0,0 +1,483 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/LoopStrengthReducer.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/**
+ * Counts the assignments to each variable.
+ */
+class AssignmentCounter: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Assignment const& _assignment) override
+	{
+		for (auto const& var: _assignment.variableNames)
+			++counts[var.name];
+		ASTWalker::operator()(_assignment);
+	}
+
+	map<YulString, size_t> counts;
+};
+
+/**
+ * Replaces comparisons of the counter of a loop, or of SSA variables copying it,
+ * that follow from the counter being smaller than the bound of the loop.
+ */
+class CounterComparisonReplacer: public ASTModifier
+{
+public:
+	CounterComparisonReplacer(
+		Dialect const& _dialect,
+		KnowledgeBase& _knowledgeBase,
+		map<YulString, Expression const*> const& _ssaValues,
+		YulString _counter,
+		Expression const& _bound,
+		u256 _counterMax
+	):
+		m_dialect(_dialect),
+		m_knowledgeBase(_knowledgeBase),
+		m_ssaValues(_ssaValues),
+		m_aliases{_counter},
+		m_bound(_bound),
+		m_counterMax(move(_counterMax))
+	{}
+
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override
+	{
+		ASTModifier::operator()(_varDecl);
+		if (
+			_varDecl.variables.size() == 1 &&
+			m_ssaValues.count(_varDecl.variables.front().name) &&
+			_varDecl.value &&
+			isCounter(*_varDecl.value)
+		)
+			m_aliases.insert(_varDecl.variables.front().name);
+	}
+	void operator()(FunctionDefinition&) override {}
+
+	void visit(Expression& _expression) override
+	{
+		ASTModifier::visit(_expression);
+		if (optional<u256> value = knownValue(_expression))
+			_expression = Literal{debugDataOf(_expression), LiteralKind::Number, YulString{util::formatNumber(*value)}, {}};
+	}
+
+private:
+	bool isCounter(Expression const& _expression) const
+	{
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		return identifier && m_aliases.count(identifier->name);
+	}
+
+	optional<u256> knownValue(Expression const& _expression)
+	{
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+		if (!instruction || instruction->second->size() != 2)
+			return nullopt;
+		Expression const& a = instruction->second->at(0);
+		Expression const& b = instruction->second->at(1);
+		switch (instruction->first)
+		{
+		case Instruction::LT:
+			return lessThan(a, b);
+		case Instruction::GT:
+			return lessThan(b, a);
+		case Instruction::EQ:
+			if (
+				(isCounter(a) && m_knowledgeBase.valueRange(b).min > m_counterMax) ||
+				(isCounter(b) && m_knowledgeBase.valueRange(a).min > m_counterMax)
+			)
+				return 0;
+			return nullopt;
+		default:
+			return nullopt;
+		}
+	}
+
+	optional<u256> lessThan(Expression const& _a, Expression const& _b)
+	{
+		if (isCounter(_a) && (SyntacticallyEqual{}(_b, m_bound) || m_knowledgeBase.valueRange(_b).min > m_counterMax))
+			return 1;
+		if (isCounter(_b) && m_knowledgeBase.valueRange(_a).min >= m_counterMax)
+			return 0;
+		return nullopt;
+	}
+
+	Dialect const& m_dialect;
+	KnowledgeBase& m_knowledgeBase;
+	map<YulString, Expression const*> const& m_ssaValues;
+	set<YulString> m_aliases;
+	Expression const& m_bound;
+	u256 m_counterMax;
+};
+
+/**
+ * Replaces the expressions for which the given function returns a name by a reference to it.
+ * Sub-expressions of replaced expressions are not visited.
+ */
+class ExpressionReplacer: public ASTModifier
+{
+public:
+	explicit ExpressionReplacer(function<optional<YulString>(Expression const&)> _replacement):
+		m_replacement(move(_replacement))
+	{}
+
+	using ASTModifier::operator();
+	void operator()(FunctionDefinition&) override {}
+
+	void visit(Expression& _expression) override
+	{
+		if (optional<YulString> name = m_replacement(_expression))
+			_expression = Identifier{debugDataOf(_expression), *name};
+		else
+			ASTModifier::visit(_expression);
+	}
+
+private:
+	function<optional<YulString>(Expression const&)> m_replacement;
+};
+
+}
+
+void LoopStrengthReducer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	run(_context, _ast, _context.analysisCache.information(_context.dialect, _ast));
+}
+
+void LoopStrengthReducer::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	InterproceduralInformation const& _information
+)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	LoopStrengthReducer{
+		_context.dialect,
+		_context.dispenser,
+		ssaValues.values(),
+		_information.functionSideEffects
+	}(_ast);
+}
+
+LoopStrengthReducer::LoopStrengthReducer(
+	Dialect const& _dialect,
+	NameDispenser& _nameDispenser,
+	map<YulString, Expression const*> const& _ssaValues,
+	map<YulString, SideEffects> const& _functionSideEffects
+):
+	m_dialect(_dialect),
+	m_nameDispenser(_nameDispenser),
+	m_ssaValues(_ssaValues),
+	m_functionSideEffects(_functionSideEffects)
+{
+	// As in the LoopInvariantCodeMotion step, only the values of movable SSA variables
+	// that depend on other SSA variables are the same wherever the variable is in scope.
+	for (auto const& [name, value]: m_ssaValues)
+	{
+		MovableChecker checker{m_dialect, &m_functionSideEffects};
+		checker.visit(*value);
+		if (
+			checker.movable() &&
+			all_of(
+				checker.referencedVariables().begin(),
+				checker.referencedVariables().end(),
+				[&](YulString _reference) { return m_ssaValues.count(_reference); }
+			)
+		)
+			m_knownValues[name] = AssignedValue{value, 0};
+	}
+	m_knowledgeBase = make_unique<KnowledgeBase>(m_dialect, m_knownValues);
+}
+
+void LoopStrengthReducer::operator()(Block& _block)
+{
+	util::iterateReplacing(
+		_block.statements,
+		[&](Statement& _s) -> optional<vector<Statement>>
+		{
+			visit(_s);
+			if (holds_alternative<ForLoop>(_s))
+				return rewriteLoop(get<ForLoop>(_s));
+			else
+				return {};
+		}
+	);
+}
+
+optional<LoopStrengthReducer::Counter> LoopStrengthReducer::findCounter(
+	ForLoop const& _for,
+	map<YulString, size_t> const& _assignmentCounts,
+	set<YulString> const& _declaredInLoop,
+	set<YulString> const& _changedInLoop
+)
+{
+	for (size_t index = 0; index < _for.post.statements.size(); ++index)
+	{
+		Assignment const* assignment = get_if<Assignment>(&_for.post.statements[index]);
+		if (!assignment || assignment->variableNames.size() != 1)
+			continue;
+		YulString name = assignment->variableNames.front().name;
+		if (_assignmentCounts.at(name) != 1 || _declaredInLoop.count(name))
+			continue;
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, *assignment->value);
+		if (!instruction || instruction->first != Instruction::ADD)
+			continue;
+		for (auto&& [self, increment]: {
+			pair{&instruction->second->at(0), &instruction->second->at(1)},
+			pair{&instruction->second->at(1), &instruction->second->at(0)}
+		})
+		{
+			Identifier const* identifier = get_if<Identifier>(self);
+			if (!identifier || identifier->name != name || !invariant(*increment, _changedInLoop))
+				continue;
+			if (optional<u256> value = constantValue(*increment))
+				return Counter{name, *value, index};
+		}
+	}
+	return nullopt;
+}
+
+bool LoopStrengthReducer::invariant(Expression const& _expression, set<YulString> const& _changedInLoop)
+{
+	MovableChecker checker{m_dialect, &m_functionSideEffects};
+	checker.visit(_expression);
+	return checker.movable() && none_of(
+		checker.referencedVariables().begin(),
+		checker.referencedVariables().end(),
+		[&](YulString _reference) { return _changedInLoop.count(_reference); }
+	);
+}
+
+optional<u256> LoopStrengthReducer::constantValue(Expression const& _expression)
+{
+	KnowledgeBase::ValueRange range = m_knowledgeBase->valueRange(_expression);
+	if (range.isConstant())
+		return range.min;
+	return nullopt;
+}
+
+void LoopStrengthReducer::removeRedundantChecks(
+	ForLoop& _for,
+	Counter const& _counter,
+	set<YulString> const& _changedInLoop
+)
+{
+	// @returns the bound `n` if @a _condition is `lt(i, n)` or `gt(n, i)`.
+	auto boundOf = [&](Expression const& _condition) -> Expression const* {
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _condition);
+		if (!instruction || instruction->second->size() != 2)
+			return nullptr;
+		size_t counterIndex = 0;
+		if (instruction->first == Instruction::LT)
+			counterIndex = 0;
+		else if (instruction->first == Instruction::GT)
+			counterIndex = 1;
+		else
+			return nullptr;
+		Identifier const* counter = get_if<Identifier>(&instruction->second->at(counterIndex));
+		if (!counter || counter->name != _counter.name)
+			return nullptr;
+		return &instruction->second->at(1 - counterIndex);
+	};
+
+	Expression const* bound = nullptr;
+	size_t bodyStart = 0;
+	Literal const* constantCondition = get_if<Literal>(_for.condition.get());
+	if (constantCondition && valueOfLiteral(*constantCondition) != 0 && !_for.body.statements.empty())
+	{
+		// The form produced by the ForLoopConditionIntoBody step.
+		If const* guard = get_if<If>(&_for.body.statements.front());
+		if (
+			guard &&
+			guard->body.statements.size() == 1 &&
+			holds_alternative<Break>(guard->body.statements.front())
+		)
+			if (auto negation = SimplificationRules::instructionAndArguments(m_dialect, *guard->condition))
+				if (negation->first == Instruction::ISZERO)
+					bound = boundOf(negation->second->front());
+		bodyStart = 1;
+	}
+	else
+		bound = boundOf(*_for.condition);
+
+	if (!bound || !invariant(*bound, _changedInLoop))
+		return;
+	u256 boundMax = m_knowledgeBase->valueRange(*bound).max;
+	if (boundMax == 0)
+		return;
+
+	// The counter is smaller than the bound after the guard until it is increased.
+	CounterComparisonReplacer replacer{m_dialect, *m_knowledgeBase, m_ssaValues, _counter.name, *bound, boundMax - 1};
+	for (size_t index = bodyStart; index < _for.body.statements.size(); ++index)
+		replacer.visit(_for.body.statements[index]);
+	for (size_t index = 0; index < _counter.assignmentIndex; ++index)
+		replacer.visit(_for.post.statements[index]);
+}
+
+vector<Statement> LoopStrengthReducer::reduceMultiplications(
+	ForLoop& _for,
+	Counter const& _counter,
+	set<YulString> const& _changedInLoop
+)
+{
+	auto isCounter = [&](Expression const& _expression) {
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		return identifier && identifier->name == _counter.name;
+	};
+	// @returns the factor if @a _expression is a constant multiple of the counter.
+	auto factorOf = [&](Expression const& _expression) -> optional<u256> {
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+		if (!instruction || instruction->second->size() != 2)
+			return nullopt;
+		Expression const& a = instruction->second->at(0);
+		Expression const& b = instruction->second->at(1);
+		if (instruction->first == Instruction::MUL)
+		{
+			if (isCounter(a) && invariant(b, _changedInLoop))
+				return constantValue(b);
+			if (isCounter(b) && invariant(a, _changedInLoop))
+				return constantValue(a);
+		}
+		else if (instruction->first == Instruction::SHL && isCounter(b) && invariant(a, _changedInLoop))
+			if (optional<u256> shift = constantValue(a); shift && *shift < 256)
+				return u256(1) << unsigned(*shift);
+		return nullopt;
+	};
+	// @returns the factor if @a _expression is a constant multiple of the counter
+	// or the sum of an invariant base and such a multiple.
+	auto strideOf = [&](Expression const& _expression) -> optional<u256> {
+		if (optional<u256> factor = factorOf(_expression))
+			return factor;
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+		if (!instruction || instruction->first != Instruction::ADD)
+			return nullopt;
+		Expression const& a = instruction->second->at(0);
+		Expression const& b = instruction->second->at(1);
+		if (invariant(a, _changedInLoop))
+			return factorOf(b);
+		if (invariant(b, _changedInLoop))
+			return factorOf(a);
+		return nullopt;
+	};
+
+	struct InductionVariable
+	{
+		Expression value;
+		YulString name;
+		u256 step;
+	};
+	vector<InductionVariable> inductionVariables;
+	ExpressionReplacer replacer{[&](Expression const& _expression) -> optional<YulString> {
+		optional<u256> stride = strideOf(_expression);
+		if (!stride)
+			return nullopt;
+		for (InductionVariable const& variable: inductionVariables)
+			if (SyntacticallyEqual{}(variable.value, _expression))
+				return variable.name;
+		YulString name = m_nameDispenser.newName(_counter.name);
+		inductionVariables.emplace_back(InductionVariable{ASTCopier{}.translate(_expression), name, *stride * _counter.increment});
+		return name;
+	}};
+	replacer.visit(*_for.condition);
+	replacer(_for.body);
+	replacer(_for.post);
+
+	vector<Statement> declarations;
+	vector<Statement> updates;
+	for (InductionVariable& variable: inductionVariables)
+	{
+		shared_ptr<DebugData const> debugData = debugDataOf(variable.value);
+		updates.emplace_back(Assignment{
+			debugData,
+			{Identifier{debugData, variable.name}},
+			make_unique<Expression>(FunctionCall{
+				debugData,
+				Identifier{debugData, "add"_yulstring},
+				util::make_vector<Expression>(
+					Identifier{debugData, variable.name},
+					Literal{debugData, LiteralKind::Number, YulString{util::formatNumber(variable.step)}, {}}
+				)
+			})
+		});
+		declarations.emplace_back(VariableDeclaration{
+			debugData,
+			{TypedName{debugData, variable.name, {}}},
+			make_unique<Expression>(move(variable.value))
+		});
+	}
+	auto afterAssignment = _for.post.statements.begin() + static_cast<ptrdiff_t>(_counter.assignmentIndex + 1);
+	_for.post.statements.insert(
+		afterAssignment,
+		make_move_iterator(updates.begin()),
+		make_move_iterator(updates.end())
+	);
+	return declarations;
+}
+
+optional<vector<Statement>> LoopStrengthReducer::rewriteLoop(ForLoop& _for)
+{
+	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
+
+	set<YulString> declaredInLoop = NameCollector(_for.body, NameCollector::OnlyVariables).names();
+	declaredInLoop += NameCollector(_for.post, NameCollector::OnlyVariables).names();
+	AssignmentCounter assignments;
+	assignments(_for);
+	set<YulString> changedInLoop = declaredInLoop;
+	for (auto const& [name, count]: assignments.counts)
+		changedInLoop.insert(name);
+
+	optional<Counter> counter = findCounter(_for, assignments.counts, declaredInLoop, changedInLoop);
+	if (!counter)
+		return {};
+
+	removeRedundantChecks(_for, *counter, changedInLoop);
+	vector<Statement> replacement = reduceMultiplications(_for, *counter, changedInLoop);
+	if (replacement.empty())
+		return {};
+	replacement.emplace_back(std::move(_for));
+	return {std::move(replacement)};
+}
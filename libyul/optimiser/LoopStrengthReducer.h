@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+
+#include <memory>
+#include <optional>
+
+namespace solidity::yul
+{
+
+class NameDispenser;
+
+/**
+ * Loop strength reduction for loops over a counter.
+ *
+ * A variable is the counter of a loop if it is declared outside of the loop and the
+ * only assignment to it inside the loop is a statement `i := add(i, c)` at the top level
+ * of the post block, where `c` is a constant.
+ *
+ * If the loop is guarded by `lt(i, n)`, either as its condition or, after the
+ * ForLoopConditionIntoBody step, as an `if iszero(lt(i, n)) { break }` at the start of its
+ * body, and `n` is a movable expression that does not depend on variables changed in the loop,
+ * then `i` is smaller than `n` in the rest of the body and in the post block up to the
+ * assignment. Comparisons of `i` (or of copies of it made there) whose result follows from
+ * this, like the bounds check `lt(i, n)` or the overflow check `eq(i, not(0))`, are replaced
+ * by their value.
+ *
+ * Expressions `mul(i, s)`, `mul(s, i)` and `shl(k, i)` with constant `s` and `k`, as well as
+ * `add(b, ...)` of them with a movable base `b` that does not depend on variables changed in the
+ * loop, are replaced by a new variable that is initialised in front of the loop and increased
+ * by the constant `c * s` right after the assignment to the counter.
+ *
+ * Requirements:
+ * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
+ * - The step works on code whose expressions are not split; LoopInvariantCodeMotion should
+ *   be run upfront to move loads of the bound and of the base out of the loop.
+ */
+class LoopStrengthReducer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopStrengthReducer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(
+		OptimiserStepContext& _context,
+		Block& _ast,
+		InterproceduralInformation const& _information
+	);
+
+	void operator()(Block& _block) override;
+
+private:
+	LoopStrengthReducer(
+		Dialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::map<YulString, Expression const*> const& _ssaValues,
+		std::map<YulString, SideEffects> const& _functionSideEffects
+	);
+
+	/// The counter of a loop and the assignment to it in the post block.
+	struct Counter
+	{
+		YulString name;
+		u256 increment;
+		size_t assignmentIndex;
+	};
+	std::optional<Counter> findCounter(
+		ForLoop const& _for,
+		std::map<YulString, size_t> const& _assignmentCounts,
+		std::set<YulString> const& _declaredInLoop,
+		std::set<YulString> const& _changedInLoop
+	);
+	/// @returns true if @a _expression is movable and does not reference variables changed in the loop.
+	bool invariant(Expression const& _expression, std::set<YulString> const& _changedInLoop);
+	/// @returns the value of @a _expression if it is known to be constant.
+	std::optional<u256> constantValue(Expression const& _expression);
+
+	/// Replaces comparisons of the counter that are decided by the guard of the loop.
+	void removeRedundantChecks(ForLoop& _for, Counter const& _counter, std::set<YulString> const& _changedInLoop);
+	/// Replaces multiples of the counter by new variables.
+	/// @returns the declarations of the new variables.
+	std::vector<Statement> reduceMultiplications(
+		ForLoop& _for,
+		Counter const& _counter,
+		std::set<YulString> const& _changedInLoop
+	);
+
+	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::map<YulString, Expression const*> const& m_ssaValues;
+	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	std::map<YulString, AssignedValue> m_knownValues;
+	std::unique_ptr<KnowledgeBase> m_knowledgeBase;
+};
+
+}
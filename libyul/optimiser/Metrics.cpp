@@ -132,6 +132,14 @@ size_t CodeCost::codeCost(Dialect const& _dialect, Expression const& _expr)
 	return cc.m_cost;
 }
 
+size_t CodeCost::codeCost(Dialect const& _dialect, Block const& _block)
+{
+	CodeCost cc(_dialect);
+	for (Statement const& statement: _block.statements)
+		cc.visit(statement);
+	return cc.m_cost;
+}
+
 
 void CodeCost::operator()(FunctionCall const& _funCall)
 {
@@ -114,6 +114,8 @@ class CodeCost: public ASTWalker
 {
 public:
 	static size_t codeCost(Dialect const& _dialect, Expression const& _expression);
+	/// @returns the cost of @a _block including the functions defined in it.
+	static size_t codeCost(Dialect const& _dialect, Block const& _block);
 
 private:
 	CodeCost(Dialect const& _dialect): m_dialect(_dialect) {}
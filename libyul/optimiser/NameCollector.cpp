@@ -61,21 +61,21 @@ map<YulString, size_t> ReferencesCounter::countReferences(Block const& _block, C
 {
 	ReferencesCounter counter(_countWhat);
 	counter(_block);
-	return counter.references();
+	return std::move(counter.m_references);
 }
 
 map<YulString, size_t> ReferencesCounter::countReferences(FunctionDefinition const& _function, CountWhat _countWhat)
 {
 	ReferencesCounter counter(_countWhat);
 	counter(_function);
-	return counter.references();
+	return std::move(counter.m_references);
 }
 
 map<YulString, size_t> ReferencesCounter::countReferences(Expression const& _expression, CountWhat _countWhat)
 {
 	ReferencesCounter counter(_countWhat);
 	counter.visit(_expression);
-	return counter.references();
+	return std::move(counter.m_references);
 }
 
 void Assignments::operator()(Assignment const& _assignment)
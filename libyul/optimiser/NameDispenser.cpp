@@ -29,6 +29,8 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -44,20 +46,41 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 	m_dialect(_dialect),
 	m_usedNames(std::move(_usedNames))
 {
+	for (YulString name: m_usedNames)
+		indexSuffix(name.str());
 }
 
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
-	while (illegalName(name))
+	if (illegalName(name))
 	{
-		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		set<size_t> const* usedSuffixes = valueOrNullptr(m_usedSuffixes, _nameHint.str());
+		do
+		{
+			m_counter++;
+			// Skip the names that are known to be used without creating them.
+			if (usedSuffixes)
+				for (
+					auto it = usedSuffixes->lower_bound(m_counter);
+					it != usedSuffixes->end() && *it == m_counter;
+					++it
+				)
+					m_counter++;
+			name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		}
+		while (illegalName(name));
 	}
-	m_usedNames.emplace(name);
+	markUsed(name);
 	return name;
 }
 
+void NameDispenser::markUsed(YulString _name)
+{
+	if (m_usedNames.insert(_name).second)
+		indexSuffix(_name.str());
+}
+
 bool NameDispenser::illegalName(YulString _name)
 {
 	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
@@ -66,5 +89,33 @@ bool NameDispenser::illegalName(YulString _name)
 void NameDispenser::reset(Block const& _ast)
 {
 	m_usedNames = NameCollector(_ast).names() + m_reservedNames;
+	m_usedSuffixes.clear();
+	for (YulString name: m_usedNames)
+		indexSuffix(name.str());
 	m_counter = 0;
 }
+
+void NameDispenser::indexSuffix(string_view _name)
+{
+	size_t separator = _name.rfind('_');
+	if (separator == string_view::npos)
+		return;
+	string_view decimal = _name.substr(separator + 1);
+	// Only decimals as created by to_string, which fit into size_t.
+	if (
+		decimal.empty() ||
+		decimal.size() > 18 ||
+		(decimal.size() > 1 && decimal.front() == '0') ||
+		!all_of(decimal.begin(), decimal.end(), [](char _c) { return '0' <= _c && _c <= '9'; })
+	)
+		return;
+	size_t suffix = 0;
+	for (char c: decimal)
+		suffix = suffix * 10 + static_cast<size_t>(c - '0');
+
+	string_view prefix = _name.substr(0, separator);
+	auto it = m_usedSuffixes.find(prefix);
+	if (it == m_usedSuffixes.end())
+		it = m_usedSuffixes.emplace(string(prefix), set<size_t>{}).first;
+	it->second.insert(suffix);
+}
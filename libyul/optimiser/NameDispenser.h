@@ -24,7 +24,11 @@
 
 #include <libyul/YulString.h>
 
+#include <functional>
+#include <map>
 #include <set>
+#include <string>
+#include <string_view>
 
 namespace solidity::yul
 {
@@ -35,6 +39,8 @@ struct Dialect;
  * do not conflict with existing names.
  *
  * Tries to keep names short and appends decimals to disambiguate.
+ * The decimals that are already used for a name are indexed, so that finding
+ * an unused decimal does not require creating and looking up all the names in between.
  */
 class NameDispenser
 {
@@ -49,7 +55,7 @@ public:
 
 	/// Mark @a _name as used, i.e. the dispenser's newName function will not
 	/// return it.
-	void markUsed(YulString _name) { m_usedNames.insert(_name); }
+	void markUsed(YulString _name);
 
 	std::set<YulString> const& usedNames() { return m_usedNames; }
 
@@ -61,9 +67,14 @@ public:
 	void reset(Block const& _ast);
 
 private:
+	/// Adds the decimal of @a _name to m_usedSuffixes if it is of the form ``<prefix>_<decimal>``.
+	void indexSuffix(std::string_view _name);
+
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
+	/// Decimals appended to the prefixes of used names of the form ``<prefix>_<decimal>``.
+	std::map<std::string, std::set<size_t>, std::less<>> m_usedSuffixes;
 	size_t m_counter = 0;
 };
 
@@ -35,6 +35,9 @@ NameSimplifier::NameSimplifier(OptimiserStepContext& _context, Block const& _ast
 {
 	for (YulString name: _context.reservedIdentifiers)
 		m_translations[name] = name;
+	// Keep the names of profiled functions so that later steps can still find their profile.
+	for (auto const& profiledFunction: _context.functionExecutionsPerDeployment)
+		m_translations[profiledFunction.first] = profiledFunction.first;
 
 	for (YulString const& name: NameCollector(_ast).names())
 		findSimplification(name);
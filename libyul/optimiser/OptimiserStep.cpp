@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+InterproceduralInformation InterproceduralInformation::fromAST(Dialect const& _dialect, Block const& _ast)
+{
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	return InterproceduralInformation{
+		SideEffectsPropagator::sideEffects(_dialect, callGraph),
+		MSizeFinder::containsMSize(_dialect, callGraph)
+	};
+}
+
+InterproceduralInformation InterproceduralInformation::restrictedTo(Block const& _part) const
+{
+	InterproceduralInformation result{{}, containsMSize};
+	for (auto const& reference: ReferencesCounter::countReferences(_part))
+		if (auto it = functionSideEffects.find(reference.first); it != functionSideEffects.end())
+			result.functionSideEffects.emplace_hint(result.functionSideEffects.end(), *it);
+	return result;
+}
+
+InterproceduralInformation const& InterproceduralInformationCache::information(
+	Dialect const& _dialect,
+	Block const& _ast
+)
+{
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	if (m_callGraph)
+		SideEffectsPropagator::update(_dialect, *m_callGraph, callGraph, m_information.functionSideEffects);
+	else
+		m_information.functionSideEffects = SideEffectsPropagator::sideEffects(_dialect, callGraph);
+	m_information.containsMSize = MSizeFinder::containsMSize(_dialect, callGraph);
+	m_callGraph = std::move(callGraph);
+	return m_information;
+}
@@ -18,20 +18,72 @@
 
 #pragma once
 
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/Exceptions.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
 
+#include <libsolutil/Common.h>
+
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
 
 struct Dialect;
 struct Block;
-class YulString;
 class NameDispenser;
 
+/**
+ * Properties of the whole AST that function-local steps need to know about
+ * but cannot determine from the single function they are applied to.
+ */
+struct InterproceduralInformation
+{
+	/// Side-effects of all user-defined functions.
+	std::map<YulString, SideEffects> functionSideEffects;
+	/// True if the AST contains the msize instruction or a verbatim builtin anywhere.
+	bool containsMSize = false;
+
+	static InterproceduralInformation fromAST(Dialect const& _dialect, Block const& _ast);
+	/// @returns a copy that only contains the side-effects of the functions called in @a _part.
+	InterproceduralInformation restrictedTo(Block const& _part) const;
+};
+
+/**
+ * Cache of the interprocedural information about an AST, which is needed by many steps.
+ *
+ * Since any step can change the AST, the call graph is generated again for every request.
+ * The side-effects are only determined again for the functions that directly or indirectly
+ * call functions whose calls or loops changed since the previous request.
+ */
+class InterproceduralInformationCache
+{
+public:
+	/// @returns the information about @a _ast, which is valid until the next call.
+	InterproceduralInformation const& information(Dialect const& _dialect, Block const& _ast);
+
+private:
+	std::optional<CallGraph> m_callGraph;
+	InterproceduralInformation m_information;
+};
+
+/**
+ * Names of the specializations created by the FunctionSpecializer, by the name of the specialized
+ * function and the values and types of the literal arguments it was specialized for, which are
+ * nullopt for the arguments that are still passed.
+ */
+using FunctionSpecializations = std::map<
+	std::pair<YulString, std::vector<std::optional<std::pair<u256, YulString>>>>,
+	YulString
+>;
+
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
@@ -39,9 +91,17 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Expected number of executions per deployment of the functions with the given names, which
+	/// replaces expectedExecutionsPerDeployment for their code. Empty for creation code.
+	std::map<YulString, size_t> functionExecutionsPerDeployment = {};
+	/// Information about the AST shared by the steps applied to it one after the other.
+	/// Must not be used by steps applied to parts of the AST concurrently.
+	InterproceduralInformationCache analysisCache = {};
+	/// Specializations of functions that can be reused by later applications of the FunctionSpecializer
+	/// as long as they still exist.
+	FunctionSpecializations functionSpecializations = {};
 };
 
-
 /**
  * Construction to create dynamically callable objects out of the
  * statically callable optimiser steps.
@@ -52,6 +112,18 @@ struct OptimiserStep
 	virtual ~OptimiserStep() = default;
 
 	virtual void run(OptimiserStepContext&, Block&) const = 0;
+	/// @returns true if the step transforms each function definition and the code outside
+	/// of functions independently of each other and does not introduce new names.
+	/// Such steps can be applied to the parts of an AST concurrently, producing the same result
+	/// as applying them to the whole AST.
+	virtual bool isFunctionLocal() const = 0;
+	/// Applies a function-local step to @a _part, which consists either of a function definition
+	/// or of the code outside of functions. @a _information has to be computed on the whole AST.
+	virtual void runOnPart(
+		OptimiserStepContext&,
+		Block& _part,
+		InterproceduralInformation const& _information
+	) const = 0;
 	/// @returns non-nullopt if the step cannot be run, for example because it requires
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
@@ -74,12 +146,54 @@ private:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
 
+	template<typename T>
+	struct IsFunctionLocal
+	{
+	private:
+		template<typename U> static auto test(int) -> std::bool_constant<U::functionLocal>;
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
+	template<typename T>
+	struct UsesInterproceduralInformation
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::run(
+			std::declval<OptimiserStepContext&>(),
+			std::declval<Block&>(),
+			std::declval<InterproceduralInformation const&>()
+		), std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
 	void run(OptimiserStepContext& _context, Block& _ast) const override
 	{
 		Step::run(_context, _ast);
 	}
+	bool isFunctionLocal() const override
+	{
+		return IsFunctionLocal<Step>::value;
+	}
+	void runOnPart(
+		OptimiserStepContext& _context,
+		Block& _part,
+		InterproceduralInformation const& _information
+	) const override
+	{
+		yulAssert(IsFunctionLocal<Step>::value, "Step is not function-local.");
+		if constexpr (UsesInterproceduralInformation<Step>::value)
+			Step::run(_context, _part, _information);
+		else
+			Step::run(_context, _part);
+	}
 	std::optional<std::string> invalidInCurrentEnvironment() const override
 	{
 		if constexpr (HasInvalidInCurrentEnvironmentMethod<Step>::value)
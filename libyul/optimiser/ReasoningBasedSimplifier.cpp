@@ -21,6 +21,7 @@
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
+#include <libyul/AsmPrinter.h>
 #include <libyul/Dialect.h>
 
 #include <libsmtutil/SMTPortfolio.h>
@@ -62,42 +63,74 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 	if (!SideEffectsCollector{m_dialect, *_if.condition}.movable())
 		return;
 
+	// The encoding only depends on the names of the (SSA) variables, which
+	// refer to the same values everywhere, and on the path conditions.
+	string const conditionKey = m_pathConditions + std::visit(AsmPrinter{m_dialect}, *_if.condition);
 	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+
+	ConditionValue value = ConditionValue::Unknown;
+	if (ConditionValue const* cachedValue = valueOrNullptr(m_conditionValues, conditionKey))
+		value = *cachedValue;
+	else if (m_remainingQueries > 0)
+		value = m_conditionValues[conditionKey] = evaluateCondition(condition);
+
+	if (value == ConditionValue::AlwaysTrue)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.debugData = debugDataOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(move(trueCondition));
 	}
-	else
+	else if (value == ConditionValue::AlwaysFalse)
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.debugData = debugDataOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.debugData = debugDataOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
 	m_solver->push();
 	m_solver->addAssertion(condition != constantValue(0));
+	size_t const pathLength = m_pathConditions.size();
+	m_pathConditions = conditionKey + "\n";
 
 	ASTModifier::operator()(_if.body);
 
+	m_pathConditions.resize(pathLength);
 	m_solver->pop();
 }
 
+void ReasoningBasedSimplifier::operator()(FunctionDefinition& _functionDefinition)
+{
+	size_t const outerRemainingQueries = m_remainingQueries;
+	m_remainingQueries = maxSolverQueriesPerFunction;
+	ASTModifier::operator()(_functionDefinition);
+	m_remainingQueries = outerRemainingQueries;
+}
+
+ReasoningBasedSimplifier::ConditionValue ReasoningBasedSimplifier::evaluateCondition(
+	smtutil::Expression const& _condition
+)
+{
+	auto isUnsatisfiable = [&](smtutil::Expression const& _assertion) {
+		if (m_remainingQueries > 0)
+			--m_remainingQueries;
+		m_solver->push();
+		m_solver->addAssertion(_assertion);
+		CheckResult result = m_solver->check({}).first;
+		m_solver->pop();
+		return result == CheckResult::UNSATISFIABLE;
+	};
+
+	if (isUnsatisfiable(_condition == constantValue(0)))
+		return ConditionValue::AlwaysTrue;
+	else if (isUnsatisfiable(_condition != constantValue(0)))
+		return ConditionValue::AlwaysFalse;
+	else
+		return ConditionValue::Unknown;
+}
+
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	Dialect const& _dialect,
 	set<YulString> const& _ssaVariables
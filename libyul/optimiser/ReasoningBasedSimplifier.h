@@ -25,6 +25,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <map>
+#include <string>
 
 namespace solidity::smtutil
 {
@@ -43,6 +44,12 @@ namespace solidity::yul
  * - If `constraints AND NOT condition` is UNSAT, the condition is always true and can be replaced by `1`.
  * The simplifications above can only be applied if the condition is movable.
  *
+ * The answers of the solver are cached for each condition together with the conditions of the
+ * enclosing `if` statements, so that repeated conditions are only checked once. The number of
+ * queries sent to the solver for the code of a function is limited by
+ * ``maxSolverQueriesPerFunction``; conditions beyond that limit are left unchanged.
+ * Each query is also bounded by the (deterministic) resource limit of the solver.
+ *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
  * Prerequisite: Disambiguator, SSATransform.
@@ -54,11 +61,18 @@ public:
 	static void run(OptimiserStepContext& _context, Block& _ast);
 	static std::optional<std::string> invalidInCurrentEnvironment();
 
+	/// Maximum number of solver queries for the code of a single function or the code
+	/// outside of functions.
+	static size_t constexpr maxSolverQueriesPerFunction = 100;
+
 	using ASTModifier::operator();
 	void operator()(VariableDeclaration& _varDecl) override;
 	void operator()(If& _if) override;
+	void operator()(FunctionDefinition& _functionDefinition) override;
 
 private:
+	enum class ConditionValue { Unknown, AlwaysTrue, AlwaysFalse };
+
 	explicit ReasoningBasedSimplifier(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables
@@ -69,7 +83,15 @@ private:
 		std::vector<Expression> const& _arguments
 	) override;
 
+	/// Asks the solver whether @a _condition is constant, given the current assertions.
+	ConditionValue evaluateCondition(smtutil::Expression const& _condition);
+
 	Dialect const& m_dialect;
+	/// Conditions of the enclosing `if` statements, one per line.
+	std::string m_pathConditions;
+	/// Values of the conditions checked so far, keyed by the path conditions and the condition.
+	std::map<std::string, ConditionValue> m_conditionValues;
+	size_t m_remainingQueries = maxSolverQueriesPerFunction;
 };
 
 }
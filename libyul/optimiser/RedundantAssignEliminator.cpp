@@ -33,9 +33,34 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Collects the single-variable assignments of a block in the order of their appearance,
+ * skipping function definitions.
+ */
+class AssignmentCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Assignment const& _assignment) override
+	{
+		if (_assignment.variableNames.size() == 1)
+			assignments.emplace_back(&_assignment);
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(FunctionDefinition const&) override {}
+
+	vector<Assignment const*> assignments;
+};
+
+}
+
 void RedundantAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
 	RedundantAssignEliminator rae{_context.dialect};
+	rae.numberAssignments(_ast);
 	rae(_ast);
 
 	AssignmentRemover remover{rae.m_pendingRemovals};
@@ -62,8 +87,7 @@ void RedundantAssignEliminator::operator()(Assignment const& _assignment)
 		changeUndecidedTo(var.name, State::Unused);
 
 	if (_assignment.variableNames.size() == 1)
-		// Default-construct it in "Undecided" state if it does not yet exist.
-		m_assignments[_assignment.variableNames.front().name][&_assignment];
+		m_assignments.track(m_assignmentNumbers.at(&_assignment));
 }
 
 void RedundantAssignEliminator::operator()(If const& _if)
@@ -73,7 +97,7 @@ void RedundantAssignEliminator::operator()(If const& _if)
 	TrackedAssignments skipBranch{m_assignments};
 	(*this)(_if.body);
 
-	merge(m_assignments, move(skipBranch));
+	merge(m_assignments, skipBranch);
 }
 
 void RedundantAssignEliminator::operator()(Switch const& _switch)
@@ -99,20 +123,28 @@ void RedundantAssignEliminator::operator()(Switch const& _switch)
 		branches.pop_back();
 	}
 	for (auto& branch: branches)
-		merge(m_assignments, move(branch));
+		merge(m_assignments, branch);
 }
 
 void RedundantAssignEliminator::operator()(FunctionDefinition const& _functionDefinition)
 {
 	std::set<YulString> outerDeclaredVariables;
 	std::set<YulString> outerReturnVariables;
+	vector<Assignment const*> outerAssignmentsByNumber;
+	map<Assignment const*, size_t> outerAssignmentNumbers;
+	map<YulString, boost::dynamic_bitset<>> outerAssignmentsToVariable;
 	TrackedAssignments outerAssignments;
 	ForLoopInfo forLoopInfo;
 	swap(m_declaredVariables, outerDeclaredVariables);
 	swap(m_returnVariables, outerReturnVariables);
+	swap(m_assignmentsByNumber, outerAssignmentsByNumber);
+	swap(m_assignmentNumbers, outerAssignmentNumbers);
+	swap(m_assignmentsToVariable, outerAssignmentsToVariable);
 	swap(m_assignments, outerAssignments);
 	swap(m_forLoopInfo, forLoopInfo);
 
+	numberAssignments(_functionDefinition.body);
+
 	for (auto const& retParam: _functionDefinition.returnVariables)
 		m_returnVariables.insert(retParam.name);
 
@@ -125,6 +157,9 @@ void RedundantAssignEliminator::operator()(FunctionDefinition const& _functionDe
 
 	swap(m_declaredVariables, outerDeclaredVariables);
 	swap(m_returnVariables, outerReturnVariables);
+	swap(m_assignmentsByNumber, outerAssignmentsByNumber);
+	swap(m_assignmentNumbers, outerAssignmentNumbers);
+	swap(m_assignmentsToVariable, outerAssignmentsToVariable);
 	swap(m_assignments, outerAssignments);
 	swap(m_forLoopInfo, forLoopInfo);
 }
@@ -166,7 +201,7 @@ void RedundantAssignEliminator::operator()(ForLoop const& _forLoop)
 
 		visit(*_forLoop.condition);
 		// Order of merging does not matter because "max" is commutative and associative.
-		merge(m_assignments, move(oneRun));
+		merge(m_assignments, oneRun);
 	}
 	else
 	{
@@ -174,19 +209,11 @@ void RedundantAssignEliminator::operator()(ForLoop const& _forLoop)
 		// Change all assignments that were newly introduced in the for loop to "used".
 		// We do not have to do that with the "break" or "continue" paths, because
 		// they will be joined later anyway.
-		// TODO parallel traversal might be more efficient here.
-		for (auto& var: m_assignments)
-			for (auto& assignment: var.second)
-			{
-				auto zeroIt = zeroRuns.find(var.first);
-				if (zeroIt != zeroRuns.end() && zeroIt->second.count(assignment.first))
-					continue;
-				assignment.second = State::Value::Used;
-			}
+		m_assignments.setUsedUnlessTrackedIn(zeroRuns);
 	}
 
 	// Order of merging does not matter because "max" is commutative and associative.
-	merge(m_assignments, move(zeroRuns));
+	merge(m_assignments, zeroRuns);
 	merge(m_assignments, move(m_forLoopInfo.pendingBreakStmts));
 	m_forLoopInfo.pendingBreakStmts.clear();
 
@@ -197,13 +224,13 @@ void RedundantAssignEliminator::operator()(ForLoop const& _forLoop)
 
 void RedundantAssignEliminator::operator()(Break const&)
 {
-	m_forLoopInfo.pendingBreakStmts.emplace_back(move(m_assignments));
+	m_forLoopInfo.pendingBreakStmts.emplace_back(m_assignments);
 	m_assignments.clear();
 }
 
 void RedundantAssignEliminator::operator()(Continue const&)
 {
-	m_forLoopInfo.pendingContinueStmts.emplace_back(move(m_assignments));
+	m_forLoopInfo.pendingContinueStmts.emplace_back(m_assignments);
 	m_assignments.clear();
 }
 
@@ -227,82 +254,136 @@ void RedundantAssignEliminator::operator()(Block const& _block)
 }
 
 
-template <class K, class V, class F>
-void joinMap(std::map<K, V>& _a, std::map<K, V>&& _b, F _conflictSolver)
+void RedundantAssignEliminator::TrackedAssignments::track(size_t _id)
+{
+	if (!m_unused[_id] && !m_used[_id])
+		m_undecided.set(_id);
+}
+
+void RedundantAssignEliminator::TrackedAssignments::changeUndecidedTo(
+	boost::dynamic_bitset<> const& _mask,
+	State _newState
+)
+{
+	if (_newState == State::Undecided)
+		return;
+	boost::dynamic_bitset<> const changed = m_undecided & _mask;
+	if (changed.none())
+		return;
+	m_undecided -= changed;
+	(_newState == State::Used ? m_used : m_unused) |= changed;
+}
+
+void RedundantAssignEliminator::TrackedAssignments::setUsedUnlessTrackedIn(TrackedAssignments const& _other)
+{
+	boost::dynamic_bitset<> const introduced = tracked() - _other.tracked();
+	m_unused -= introduced;
+	m_undecided -= introduced;
+	m_used |= introduced;
+}
+
+void RedundantAssignEliminator::TrackedAssignments::join(TrackedAssignments const& _other)
+{
+	// The state of an assignment after the join is the maximum of the states
+	// in the order "unused" < "undecided" < "used".
+	m_used |= _other.m_used;
+	m_undecided |= _other.m_undecided;
+	m_undecided -= m_used;
+	m_unused |= _other.m_unused;
+	m_unused -= m_used;
+	m_unused -= m_undecided;
+}
+
+void RedundantAssignEliminator::TrackedAssignments::erase(boost::dynamic_bitset<> const& _mask)
 {
-	// TODO Perhaps it is better to just create a sorted list
-	// and then use insert(begin, end)
+	m_unused -= _mask;
+	m_undecided -= _mask;
+	m_used -= _mask;
+}
 
-	auto ita = _a.begin();
-	auto aend = _a.end();
-	auto itb = _b.begin();
-	auto bend = _b.end();
+void RedundantAssignEliminator::TrackedAssignments::clear()
+{
+	m_unused.reset();
+	m_undecided.reset();
+	m_used.reset();
+}
 
-	for (; itb != bend; ++ita)
+RedundantAssignEliminator::TrackedAssignments RedundantAssignEliminator::TrackedAssignments::restrictedTo(
+	boost::dynamic_bitset<> const& _mask
+) const
+{
+	TrackedAssignments restricted;
+	restricted.m_unused = m_unused & _mask;
+	restricted.m_undecided = m_undecided & _mask;
+	restricted.m_used = m_used & _mask;
+	return restricted;
+}
+
+void RedundantAssignEliminator::numberAssignments(Block const& _block)
+{
+	AssignmentCollector collector;
+	collector(_block);
+
+	m_assignmentsByNumber = move(collector.assignments);
+	size_t const numAssignments = m_assignmentsByNumber.size();
+	for (size_t i = 0; i < numAssignments; ++i)
 	{
-		if (ita == aend)
-			ita = _a.insert(ita, std::move(*itb++));
-		else if (ita->first < itb->first)
-			continue;
-		else if (itb->first < ita->first)
-			ita = _a.insert(ita, std::move(*itb++));
-		else
-		{
-			_conflictSolver(ita->second, std::move(itb->second));
-			++itb;
-		}
+		Assignment const* assignment = m_assignmentsByNumber[i];
+		m_assignmentNumbers[assignment] = i;
+		auto [it, inserted] = m_assignmentsToVariable.try_emplace(assignment->variableNames.front().name);
+		if (inserted)
+			it->second.resize(numAssignments);
+		it->second.set(i);
 	}
+	m_assignments = TrackedAssignments{numAssignments};
 }
 
-void RedundantAssignEliminator::merge(TrackedAssignments& _target, TrackedAssignments&& _other)
+void RedundantAssignEliminator::merge(TrackedAssignments& _target, TrackedAssignments const& _other)
 {
-	joinMap(_target, move(_other), [](
-		map<Assignment const*, State>& _assignmentHere,
-		map<Assignment const*, State>&& _assignmentThere
-	)
-	{
-		return joinMap(_assignmentHere, move(_assignmentThere), State::join);
-	});
+	_target.join(_other);
 }
 
 void RedundantAssignEliminator::merge(TrackedAssignments& _target, vector<TrackedAssignments>&& _source)
 {
-	for (TrackedAssignments& ts: _source)
-		merge(_target, move(ts));
+	for (TrackedAssignments const& ts: _source)
+		merge(_target, ts);
 	_source.clear();
 }
 
 void RedundantAssignEliminator::changeUndecidedTo(YulString _variable, RedundantAssignEliminator::State _newState)
 {
-	for (auto& assignment: m_assignments[_variable])
-		if (assignment.second == State::Undecided)
-			assignment.second = _newState;
+	if (auto assignments = m_assignmentsToVariable.find(_variable); assignments != m_assignmentsToVariable.end())
+		m_assignments.changeUndecidedTo(assignments->second, _newState);
 }
 
 void RedundantAssignEliminator::finalize(YulString _variable, RedundantAssignEliminator::State _finalState)
 {
-	std::map<Assignment const*, State> assignments;
-	joinMap(assignments, std::move(m_assignments[_variable]), State::join);
-	m_assignments.erase(_variable);
+	auto it = m_assignmentsToVariable.find(_variable);
+	if (it == m_assignmentsToVariable.end())
+		return;
+	boost::dynamic_bitset<> const& mask = it->second;
+
+	TrackedAssignments assignments = m_assignments.restrictedTo(mask);
+	m_assignments.erase(mask);
 
 	for (auto& breakAssignments: m_forLoopInfo.pendingBreakStmts)
 	{
-		joinMap(assignments, std::move(breakAssignments[_variable]), State::join);
-		breakAssignments.erase(_variable);
+		assignments.join(breakAssignments.restrictedTo(mask));
+		breakAssignments.erase(mask);
 	}
 	for (auto& continueAssignments: m_forLoopInfo.pendingContinueStmts)
 	{
-		joinMap(assignments, std::move(continueAssignments[_variable]), State::join);
-		continueAssignments.erase(_variable);
+		assignments.join(continueAssignments.restrictedTo(mask));
+		continueAssignments.erase(mask);
 	}
 
-	for (auto const& assignment: assignments)
-	{
-		State const state = assignment.second == State::Undecided ? _finalState : assignment.second;
-
-		if (state == State::Unused && SideEffectsCollector{*m_dialect, *assignment.first->value}.movable())
-			m_pendingRemovals.insert(assignment.first);
-	}
+	boost::dynamic_bitset<> const unused =
+		_finalState == State::Unused ?
+		assignments.unused() | assignments.undecided() :
+		assignments.unused();
+	for (size_t i = unused.find_first(); i != boost::dynamic_bitset<>::npos; i = unused.find_next(i))
+		if (SideEffectsCollector{*m_dialect, *m_assignmentsByNumber[i]->value}.movable())
+			m_pendingRemovals.insert(m_assignmentsByNumber[i]);
 }
 
 void AssignmentRemover::operator()(Block& _block)
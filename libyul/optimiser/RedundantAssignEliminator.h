@@ -26,6 +26,8 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <map>
 #include <vector>
 
@@ -100,6 +102,10 @@ struct Dialect;
  *
  * In the second traversal, all assignments that are in the "unused" state are removed.
  *
+ * Implementation note: The assignments of each function are numbered up front and the
+ * states of all assignments are stored as one bitset per state, so that joining control-flow
+ * paths is a sequence of bitwise operations instead of a merge of nested maps.
+ *
  *
  * This step is usually run right after the SSA transform to complete
  * the generation of the pseudo-SSA.
@@ -110,6 +116,7 @@ class RedundantAssignEliminator: public ASTWalker
 {
 public:
 	static constexpr char const* name{"RedundantAssignEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	explicit RedundantAssignEliminator(Dialect const& _dialect): m_dialect(&_dialect) {}
@@ -148,14 +155,45 @@ private:
 		Value m_value = Undecided;
 	};
 
-	// TODO check that this does not cause nondeterminism!
-	// This could also be a pseudo-map from state to assignment.
-	using TrackedAssignments = std::map<YulString, std::map<Assignment const*, State>>;
+	/// States of the tracked assignments of the current function, indexed by the number
+	/// of the assignment. Assignments that are not tracked are in none of the sets.
+	class TrackedAssignments
+	{
+	public:
+		explicit TrackedAssignments(size_t _size = 0): m_unused(_size), m_undecided(_size), m_used(_size) {}
+
+		/// Starts tracking the assignment @a _id in "undecided" state if it is not yet tracked.
+		void track(size_t _id);
+		/// Changes the state of all undecided assignments in @a _mask to @a _newState.
+		void changeUndecidedTo(boost::dynamic_bitset<> const& _mask, State _newState);
+		/// Changes the state of all tracked assignments that are not tracked in @a _other to "used".
+		void setUsedUnlessTrackedIn(TrackedAssignments const& _other);
+		/// Joins the states of @a _other into the states of this object, where assignments
+		/// missing in one of them take the state of the other.
+		void join(TrackedAssignments const& _other);
+		/// Stops tracking the assignments in @a _mask.
+		void erase(boost::dynamic_bitset<> const& _mask);
+		/// Stops tracking all assignments.
+		void clear();
+		/// @returns a copy that only tracks the assignments in @a _mask.
+		TrackedAssignments restrictedTo(boost::dynamic_bitset<> const& _mask) const;
+
+		boost::dynamic_bitset<> tracked() const { return m_unused | m_undecided | m_used; }
+		boost::dynamic_bitset<> const& unused() const { return m_unused; }
+		boost::dynamic_bitset<> const& undecided() const { return m_undecided; }
+
+	private:
+		boost::dynamic_bitset<> m_unused;
+		boost::dynamic_bitset<> m_undecided;
+		boost::dynamic_bitset<> m_used;
+	};
+
+	/// Numbers the assignments that can be removed inside @a _block, excluding nested functions.
+	void numberAssignments(Block const& _block);
 
-	/// Joins the assignment mapping of @a _source into @a _target according to the rules laid out
+	/// Joins the assignment states of @a _source into @a _target according to the rules laid out
 	/// above.
-	/// Will destroy @a _source.
-	static void merge(TrackedAssignments& _target, TrackedAssignments&& _source);
+	static void merge(TrackedAssignments& _target, TrackedAssignments const& _source);
 	static void merge(TrackedAssignments& _target, std::vector<TrackedAssignments>&& _source);
 	void changeUndecidedTo(YulString _variable, State _newState);
 	/// Called when a variable goes out of scope. Sets the state of all still undecided
@@ -167,6 +205,11 @@ private:
 	std::set<YulString> m_declaredVariables;
 	std::set<YulString> m_returnVariables;
 	std::set<Assignment const*> m_pendingRemovals;
+	/// Assignments of the current function, indexed by their number.
+	std::vector<Assignment const*> m_assignmentsByNumber;
+	std::map<Assignment const*, size_t> m_assignmentNumbers;
+	/// The numbers of the assignments to each variable of the current function.
+	std::map<YulString, boost::dynamic_bitset<>> m_assignmentsToVariable;
 	TrackedAssignments m_assignments;
 
 	/// Working data for traversing for-loops.
@@ -88,7 +88,7 @@ void Rematerialiser::visit(Expression& _e)
 			)
 			{
 				assertThrow(m_referenceCounts[name] > 0, OptimizerException, "");
-				if (ranges::all_of(m_references[name], [&](auto const& ref) { return inScope(ref); }))
+				if (ranges::all_of(m_references.values[name], [&](auto const& ref) { return inScope(ref); }))
 				{
 					// update reference counts
 					m_referenceCounts[name]--;
@@ -42,6 +42,7 @@ class Rematerialiser: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"Rematerialiser"};
+	static constexpr bool functionLocal = true;
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
@@ -92,6 +93,7 @@ class LiteralRematerialiser: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"LiteralRematerialiser"};
+	static constexpr bool functionLocal = true;
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
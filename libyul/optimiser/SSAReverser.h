@@ -72,6 +72,7 @@ class SSAReverser: public ASTModifier
 {
 public:
 	static constexpr char const* name{"SSAReverser"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
 	using ASTModifier::operator();
@@ -92,6 +92,16 @@ bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 	return finder.m_msizeFound;
 }
 
+bool MSizeFinder::containsMSize(Dialect const& _dialect, CallGraph const& _callGraph)
+{
+	for (auto const& call: _callGraph.functionCalls)
+		for (YulString callee: call.second)
+			if (BuiltinFunction const* f = _dialect.builtin(callee))
+				if (f->isMSize)
+					return true;
+	return false;
+}
+
 void MSizeFinder::operator()(FunctionCall const& _functionCall)
 {
 	ASTWalker::operator()(_functionCall);
@@ -105,6 +115,65 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	Dialect const& _dialect,
 	CallGraph const& _directCallGraph
 )
+{
+	map<YulString, SideEffects> ret;
+	propagate(_dialect, _directCallGraph, util::keys(_directCallGraph.functionCalls), ret);
+	return ret;
+}
+
+void SideEffectsPropagator::update(
+	Dialect const& _dialect,
+	CallGraph const& _previousCallGraph,
+	CallGraph const& _directCallGraph,
+	map<YulString, SideEffects>& _sideEffects
+)
+{
+	set<YulString> changed;
+	for (auto const* graph: {&_previousCallGraph, &_directCallGraph})
+		for (auto const& [function, callees]: graph->functionCalls)
+		{
+			CallGraph const& other = graph == &_previousCallGraph ? _directCallGraph : _previousCallGraph;
+			auto it = other.functionCalls.find(function);
+			if (
+				it == other.functionCalls.end() ||
+				it->second != callees ||
+				graph->functionsWithLoops.count(function) != other.functionsWithLoops.count(function)
+			)
+				changed.insert(function);
+		}
+	if (changed.empty())
+		return;
+
+	// The side-effects of a function only depend on the functions reachable from it.
+	// If none of them changed, then the paths leading to them did not change either.
+	map<YulString, set<YulString>> callers;
+	for (auto const& [caller, callees]: _directCallGraph.functionCalls)
+		for (YulString callee: callees)
+			callers[callee].insert(caller);
+	set<YulString> affected = util::BreadthFirstSearch<YulString>{{changed.begin(), changed.end()}}.run(
+		[&](YulString _function, auto&& _addChild) {
+			if (auto it = callers.find(_function); it != callers.end())
+				for (YulString caller: it->second)
+					_addChild(caller);
+		}
+	).visited;
+
+	for (YulString function: affected)
+		_sideEffects.erase(function);
+	for (auto it = affected.begin(); it != affected.end();)
+		if (_directCallGraph.functionCalls.count(*it))
+			++it;
+		else
+			it = affected.erase(it);
+	propagate(_dialect, _directCallGraph, affected, _sideEffects);
+}
+
+void SideEffectsPropagator::propagate(
+	Dialect const& _dialect,
+	CallGraph const& _directCallGraph,
+	set<YulString> const& _functions,
+	map<YulString, SideEffects>& _sideEffects
+)
 {
 	// Any loop currently makes a function non-movable, because
 	// it could be a non-terminating loop.
@@ -112,18 +181,18 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	// In the future, we should refine that, because the property
 	// is actually a bit different from "not movable".
 
-	map<YulString, SideEffects> ret;
+	map<YulString, SideEffects>& ret = _sideEffects;
 	for (auto const& function: _directCallGraph.functionsWithLoops + _directCallGraph.recursiveFunctions())
-	{
-		ret[function].movable = false;
-		ret[function].canBeRemoved = false;
-		ret[function].canBeRemovedIfNoMSize = false;
-		ret[function].cannotLoop = false;
-	}
+		if (_functions.count(function))
+		{
+			ret[function].movable = false;
+			ret[function].canBeRemoved = false;
+			ret[function].canBeRemovedIfNoMSize = false;
+			ret[function].cannotLoop = false;
+		}
 
-	for (auto const& call: _directCallGraph.functionCalls)
+	for (YulString funName: _functions)
 	{
-		YulString funName = call.first;
 		SideEffects sideEffects;
 		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
 			if (!visited.insert(_function).second)
@@ -140,11 +209,10 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 					_recurse(callee, _recurse);
 			}
 		};
-		for (auto const& _v: call.second)
+		for (auto const& _v: _directCallGraph.functionCalls.at(funName))
 			_visit(_v, _visit);
 		ret[funName] += sideEffects;
 	}
-	return ret;
 }
 
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
@@ -65,31 +65,42 @@ public:
 
 	bool movable() const { return m_sideEffects.movable; }
 
-	bool movableRelativeTo(SideEffects const& _other, bool _codeContainsMSize)
+	bool movableRelativeTo(SideEffects const& _other, bool _codeContainsMSize) const
 	{
-		if (!m_sideEffects.cannotLoop)
+		return movableRelativeTo(m_sideEffects, _other, _codeContainsMSize);
+	}
+
+	/// @returns true if code with the side-effects @a _sideEffects can be moved across code
+	/// with the side-effects @a _other.
+	static bool movableRelativeTo(
+		SideEffects const& _sideEffects,
+		SideEffects const& _other,
+		bool _codeContainsMSize
+	)
+	{
+		if (!_sideEffects.cannotLoop)
 			return false;
 
-		if (m_sideEffects.movable)
+		if (_sideEffects.movable)
 			return true;
 
 		if (
-			!m_sideEffects.movableApartFromEffects ||
-			m_sideEffects.storage == SideEffects::Write ||
-			m_sideEffects.otherState == SideEffects::Write ||
-			m_sideEffects.memory == SideEffects::Write
+			!_sideEffects.movableApartFromEffects ||
+			_sideEffects.storage == SideEffects::Write ||
+			_sideEffects.otherState == SideEffects::Write ||
+			_sideEffects.memory == SideEffects::Write
 		)
 			return false;
 
-		if (m_sideEffects.otherState == SideEffects::Read)
+		if (_sideEffects.otherState == SideEffects::Read)
 			if (_other.otherState == SideEffects::Write)
 				return false;
 
-		if (m_sideEffects.storage == SideEffects::Read)
+		if (_sideEffects.storage == SideEffects::Read)
 			if (_other.storage == SideEffects::Write)
 				return false;
 
-		if (m_sideEffects.memory == SideEffects::Read)
+		if (_sideEffects.memory == SideEffects::Read)
 			if (_codeContainsMSize || _other.memory == SideEffects::Write)
 				return false;
 
@@ -128,6 +139,27 @@ public:
 		Dialect const& _dialect,
 		CallGraph const& _directCallGraph
 	);
+
+	/// Updates @a _sideEffects, which are the side-effects for @a _previousCallGraph,
+	/// to the side-effects for @a _directCallGraph.
+	/// Only the side-effects of the functions that directly or indirectly call a function
+	/// whose calls or loops are different in the two call graphs are determined again.
+	static void update(
+		Dialect const& _dialect,
+		CallGraph const& _previousCallGraph,
+		CallGraph const& _directCallGraph,
+		std::map<YulString, SideEffects>& _sideEffects
+	);
+
+private:
+	/// Determines the side-effects of @a _functions, assuming that @a _sideEffects
+	/// already contains the side-effects of all other functions in @a _directCallGraph.
+	static void propagate(
+		Dialect const& _dialect,
+		CallGraph const& _directCallGraph,
+		std::set<YulString> const& _functions,
+		std::map<YulString, SideEffects>& _sideEffects
+	);
 };
 
 /**
@@ -143,6 +175,10 @@ class MSizeFinder: public ASTWalker
 {
 public:
 	static bool containsMSize(Dialect const& _dialect, Block const& _ast);
+	/// @returns true if the code of which @a _callGraph is the call graph contains
+	/// the msize instruction or a verbatim builtin. This is equivalent to the above,
+	/// since both builtins and user-defined functions are part of the call graph.
+	static bool containsMSize(Dialect const& _dialect, CallGraph const& _callGraph);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
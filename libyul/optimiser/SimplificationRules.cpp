@@ -31,6 +31,11 @@
 
 #include <libevmasm/RuleList.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
+
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -47,28 +52,69 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
-
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
 
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
-
-	SimplificationRules& rules = *evmRules[version];
+	SimplificationRules const& rules = SimplificationRules::rules(version);
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	vector<unsigned> argumentKeys;
+	for (Expression const& argument: *instruction->second)
 	{
-		rules.resetMatchGroups();
+		// Rules never match direct function call arguments, see Pattern::matches.
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		argumentKeys.push_back(Pattern::expressionKey(argument, _dialect, _ssaValues));
+	}
+
+	uint8_t const index = uint8_t(instruction->first);
+	for (size_t i = 0; i < rules.m_rules[index].size(); ++i)
+	{
+		vector<optional<unsigned>> const& requiredKeys = rules.m_argumentKeys[index][i];
+		bool candidate = true;
+		for (size_t j = 0; candidate && j < min(requiredKeys.size(), argumentKeys.size()); ++j)
+			candidate = !requiredKeys[j] || *requiredKeys[j] == argumentKeys[j];
+		if (!candidate)
+			continue;
+
+		auto const& rule = rules.m_rules[index][i];
+		resetMatchGroups();
+		SOL_PERF_COUNTER("yul.SimplificationRules.findFirstMatch.attempts", 1);
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
+			{
+				SOL_PERF_COUNTER("yul.SimplificationRules.findFirstMatch.matches", 1);
 				return &rule;
+			}
 	}
 	return nullptr;
 }
 
+array<Expression const*, 8>& SimplificationRules::matchGroups()
+{
+	static thread_local array<Expression const*, 8> matchGroups{};
+	return matchGroups;
+}
+
+SimplificationRules const& SimplificationRules::rules(optional<EVMVersion> _evmVersion)
+{
+	// Every thread remembers the rules it used, so that the lock is only taken
+	// the first time a thread uses the rules of an EVM version.
+	static thread_local map<optional<EVMVersion>, SimplificationRules const*> rulesOfThread;
+	if (SimplificationRules const* const* rules = util::valueOrNullptr(rulesOfThread, _evmVersion))
+		return **rules;
+
+	static mutex evmRulesMutex;
+	static map<optional<EVMVersion>, unique_ptr<SimplificationRules const>> evmRules;
+	lock_guard<mutex> lock(evmRulesMutex);
+	unique_ptr<SimplificationRules const>& rules = evmRules[_evmVersion];
+	if (!rules)
+		rules = make_unique<SimplificationRules const>(_evmVersion);
+	rulesOfThread[_evmVersion] = rules.get();
+	return *rules;
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -94,7 +140,12 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	uint8_t const instruction = uint8_t(_rule.pattern.instruction());
+	m_rules[instruction].push_back(_rule);
+	vector<optional<unsigned>> argumentKeys;
+	for (Pattern const& argument: _rule.pattern.arguments())
+		argumentKeys.push_back(argument.key());
+	m_argumentKeys[instruction].emplace_back(move(argumentKeys));
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
@@ -109,13 +160,13 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -128,10 +179,10 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group)
 {
+	assertThrow(0 < _group && _group < SimplificationRules::matchGroups().size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
-	m_matchGroups = &_matchGroups;
 }
 
 bool Pattern::matches(
@@ -202,10 +253,11 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		array<Expression const*, 8>& matchGroups = SimplificationRules::matchGroups();
+		if (matchGroups[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
+			Expression const* firstMatch = matchGroups[m_matchGroup];
 			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!holds_alternative<FunctionCall>(_expr) &&
@@ -217,17 +269,50 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			matchGroups[m_matchGroup] = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			matchGroups[m_matchGroup] = expr;
 		}
 	}
 	return true;
 }
 
+optional<unsigned> Pattern::key() const
+{
+	// Instructions use the keys below 256.
+	if (m_kind == PatternKind::Constant)
+		return 256;
+	else if (m_kind == PatternKind::Operation)
+		return unsigned(m_instruction);
+	return nullopt;
+}
+
+unsigned Pattern::expressionKey(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, AssignedValue> const& _ssaValues
+)
+{
+	Expression const* expr = &_expr;
+	if (holds_alternative<Identifier>(_expr))
+	{
+		YulString varName = std::get<Identifier>(_expr).name;
+		if (_ssaValues.count(varName))
+			if (Expression const* value = _ssaValues.at(varName).value)
+				expr = value;
+	}
+
+	if (holds_alternative<Literal>(*expr) && std::get<Literal>(*expr).kind == LiteralKind::Number)
+		return 256;
+	else if (auto instrAndArgs = SimplificationRules::instructionAndArguments(_dialect, *expr))
+		return unsigned(instrAndArgs->first);
+	// Only matched by patterns without key.
+	return numeric_limits<unsigned>::max();
+}
+
 evmasm::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
@@ -268,7 +353,7 @@ u256 Pattern::d() const
 Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	Expression const* value = SimplificationRules::matchGroups()[m_matchGroup];
+	assertThrow(value, OptimizerException, "");
+	return *value;
 }
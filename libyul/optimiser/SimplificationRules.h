@@ -31,6 +31,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -56,7 +57,7 @@ public:
 	explicit SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion = std::nullopt);
 
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups of the calling thread accordingly.
 	/// @param _ssaValues values of variables that are assigned exactly once.
 	static Rule const* findFirstMatch(
 		Expression const& _expr,
@@ -71,14 +72,23 @@ public:
 	static std::optional<std::pair<evmasm::Instruction, std::vector<Expression> const*>>
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
+	/// @returns the expressions matched by the last call to @a findFirstMatch on the calling
+	/// thread, indexed by the match group, which is between one and seven.
+	static std::array<Expression const*, 8>& matchGroups();
+
 private:
+	/// @returns the rules for @a _evmVersion, which are created once and shared by all threads.
+	static SimplificationRules const& rules(std::optional<langutil::EVMVersion> _evmVersion);
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	static void resetMatchGroups() { matchGroups().fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	/// For each rule in @a m_rules, the keys of the arguments of its pattern (see
+	/// Pattern::key), which allow to discard most rules without matching them.
+	std::vector<std::vector<std::optional<unsigned>>> m_argumentKeys[256];
 };
 
 enum class PatternKind
@@ -90,8 +100,8 @@ enum class PatternKind
 
 /**
  * Pattern to match against an expression.
- * Also stores matched expressions to retrieve them later, for constructing new expressions using
- * ExpressionTemplate.
+ * The matched expressions are stored per thread in SimplificationRules::matchGroups, to retrieve
+ * them later for constructing new expressions using ExpressionTemplate.
  */
 class Pattern
 {
@@ -113,7 +123,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -123,6 +133,16 @@ public:
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
+	/// @returns a key such that this pattern can only match expressions with the same key
+	/// (see @a expressionKey), or nullopt if it can match any expression.
+	std::optional<unsigned> key() const;
+	/// @returns the key of @a _expr, after resolving it through @a _ssaValues like @a matches does.
+	static unsigned expressionKey(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::map<YulString, AssignedValue> const& _ssaValues
+	);
+
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
 
@@ -140,7 +160,6 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
 }
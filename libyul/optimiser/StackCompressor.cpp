@@ -31,6 +31,12 @@
 
 #include <libyul/AST.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -56,7 +62,12 @@ public:
 		for (auto const& codeCost: m_expressionCodeCost)
 		{
 			size_t numRef = m_numReferences[codeCost.first];
-			cand.emplace(make_tuple(codeCost.second * numRef, codeCost.first, m_references[codeCost.first]));
+			set<YulString> const* references = util::valueOrNullptr(m_references.values, codeCost.first);
+			cand.emplace(make_tuple(
+				codeCost.second * numRef,
+				codeCost.first,
+				references ? *references : set<YulString>{}
+			));
 		}
 		return cand;
 	}
@@ -156,7 +167,8 @@ bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	size_t _parallelism
 )
 {
 	yulAssert(
@@ -164,39 +176,61 @@ bool StackCompressor::run(
 		_object.code->statements.size() > 0 && holds_alternative<Block>(_object.code->statements.at(0)),
 		"Need to run the function grouper before the stack compressor."
 	);
+	if (_maxIterations == 0)
+		return false;
+
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
-	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
-	{
-		map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
-		if (stackSurplus.empty())
-			return true;
+	map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+	if (stackSurplus.empty())
+		return true;
 
-		if (stackSurplus.count(YulString{}))
-		{
-			yulAssert(stackSurplus.at({}) > 0, "Invalid surplus value.");
-			eliminateVariables(
-				_dialect,
-				std::get<Block>(_object.code->statements.at(0)),
-				static_cast<size_t>(stackSurplus.at({})),
-				allowMSizeOptimzation
-			);
-		}
+	map<YulString, FunctionDefinition*> functions;
+	for (size_t i = 1; i < _object.code->statements.size(); ++i)
+	{
+		auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
+		functions[fun.name] = &fun;
+	}
 
-		for (size_t i = 1; i < _object.code->statements.size(); ++i)
+	// Functions are compiled independently of each other and eliminating variables
+	// only changes the code of the function it is applied to. Because of that, only the
+	// code that was not compilable has to be checked again and it can be processed in parallel.
+	auto compress = [&](YulString _name, int _surplus) -> bool
+	{
+		for (size_t iterations = 1; ; iterations++)
 		{
-			auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
-			if (!stackSurplus.count(fun.name))
-				continue;
-
-			yulAssert(stackSurplus.at(fun.name) > 0, "Invalid surplus value.");
-			eliminateVariables(
-				_dialect,
-				fun,
-				static_cast<size_t>(stackSurplus.at(fun.name)),
-				allowMSizeOptimzation
-			);
+			yulAssert(_surplus > 0, "Invalid surplus value.");
+			if (_name.empty())
+				eliminateVariables(
+					_dialect,
+					std::get<Block>(_object.code->statements.at(0)),
+					static_cast<size_t>(_surplus),
+					allowMSizeOptimzation
+				);
+			else
+				eliminateVariables(
+					_dialect,
+					*functions.at(_name),
+					static_cast<size_t>(_surplus),
+					allowMSizeOptimzation
+				);
+
+			if (iterations == _maxIterations)
+				return false;
+			map<YulString, int> deficit =
+				CompilabilityChecker(_dialect, _object, _optimizeStackAllocation, _name).stackDeficit;
+			if (deficit.empty())
+				return true;
+			yulAssert(deficit.size() == 1 && deficit.count(_name), "");
+			_surplus = deficit.at(_name);
 		}
-	}
-	return false;
+	};
+
+	vector<pair<YulString, int>> parts(stackSurplus.begin(), stackSurplus.end());
+	vector<char> compressed(parts.size(), false);
+	vector<size_t> indices(parts.size());
+	iota(indices.begin(), indices.end(), 0);
+	util::ThreadPool{_parallelism}.forEach(indices, [&](size_t _index) {
+		compressed[_index] = compress(parts[_index].first, parts[_index].second);
+	});
+	return all_of(compressed.begin(), compressed.end(), [](char _compressed) { return _compressed; });
 }
-
@@ -45,12 +45,14 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// The functions that are not compilable are processed by up to @a _parallelism threads.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		size_t _parallelism = 1
 	);
 };
 
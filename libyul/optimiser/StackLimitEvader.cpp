@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -28,12 +29,68 @@
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines the blocks in which variables are declared, in order to find variables that are
+ * never in scope at the same time and can therefore share a memory slot.
+ *
+ * The block of a variable is identified by the path of blocks leading to it from the root.
+ * The scope of the variables declared in the pre block of a for loop includes its body and post block.
+ */
+class VariableScopes: public ASTWalker
+{
+public:
+	explicit VariableScopes(Block const& _ast) { (*this)(_ast); }
+
+	/// @returns false if @a _a and @a _b are declared in blocks that are not nested inside each other.
+	/// Variables that are not declared in a block, like function parameters, overlap with all others.
+	bool overlap(YulString _a, YulString _b) const
+	{
+		auto a = m_blockPaths.find(_a);
+		auto b = m_blockPaths.find(_b);
+		if (a == m_blockPaths.end() || b == m_blockPaths.end())
+			return true;
+		vector<size_t> const& shorter = a->second.size() < b->second.size() ? a->second : b->second;
+		vector<size_t> const& longer = a->second.size() < b->second.size() ? b->second : a->second;
+		return equal(shorter.begin(), shorter.end(), longer.begin());
+	}
+
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (TypedName const& variable: _varDecl.variables)
+			m_blockPaths[variable.name] = m_path;
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		m_path.emplace_back(m_nextBlock++);
+		walkVector(_forLoop.pre.statements);
+		visit(*_forLoop.condition);
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+		m_path.pop_back();
+	}
+	void operator()(Block const& _block) override
+	{
+		m_path.emplace_back(m_nextBlock++);
+		ASTWalker::operator()(_block);
+		m_path.pop_back();
+	}
+
+private:
+	vector<size_t> m_path;
+	size_t m_nextBlock = 0;
+	map<YulString, vector<size_t>> m_blockPaths;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -44,8 +101,9 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
- * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
+ * - If not, assign each variable the lowest slot starting from ``n`` that is not used by another variable
+ *   of the function whose scope overlaps with its scope, see ``VariableScopes``.
+ * - Assign the number of slots used by the function, including ``n``, to ``slotsRequiredForFunction``.
  */
 struct MemoryOffsetAllocator
 {
@@ -65,13 +123,26 @@ struct MemoryOffsetAllocator
 		if (unreachableVariables.count(_function))
 		{
 			yulAssert(!slotAllocations.count(_function), "");
+			uint64_t const firstSlot = requiredSlots;
+			vector<YulString> assigned;
 			for (YulString variable: unreachableVariables.at(_function))
 				if (variable.empty())
 				{
 					// TODO: Too many function arguments or return parameters.
 				}
 				else
-					slotAllocations[variable] = requiredSlots++;
+				{
+					set<uint64_t> usedSlots;
+					for (YulString other: assigned)
+						if (variableScopes.overlap(variable, other))
+							usedSlots.insert(slotAllocations.at(other));
+					uint64_t slot = firstSlot;
+					while (usedSlots.count(slot))
+						++slot;
+					slotAllocations[variable] = slot;
+					requiredSlots = std::max(requiredSlots, slot + 1);
+					assigned.emplace_back(variable);
+				}
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
@@ -79,6 +150,7 @@ struct MemoryOffsetAllocator
 
 	map<YulString, set<YulString>> const& unreachableVariables;
 	map<YulString, set<YulString>> const& callGraph;
+	VariableScopes const& variableScopes;
 
 	map<YulString, uint64_t> slotAllocations{};
 	map<YulString, uint64_t> slotsRequiredForFunction{};
@@ -127,7 +199,8 @@ void StackLimitEvader::run(
 		if (_unreachableVariables.count(function))
 			return;
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls};
+	VariableScopes variableScopes{*_object.code};
+	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, variableScopes};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 
 	StackToMemoryMover::run(_context, reservedMemory, memoryOffsetAllocator.slotAllocations, requiredSlots, *_object.code);
@@ -40,6 +40,8 @@ struct Object;
  *
  * Offsets are assigned to the variables, s.t. on every path through the call graph each variable gets a unique offset
  * in memory. However, distinct paths through the call graph can use the same memory offsets for their variables.
+ * Within a function, variables declared in blocks that are not nested inside each other are never in scope at
+ * the same time and share offsets as well.
  *
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
@@ -42,6 +42,7 @@ class StructuralSimplifier: public ASTModifier
 {
 public:
 	static constexpr char const* name{"StructuralSimplifier"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -24,11 +24,13 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/CopyCoalescer.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
@@ -42,12 +44,15 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/InterproceduralConstantPropagator.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/optimiser/UnusedStoreEliminator.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/CommonSubexpressionHoister.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
@@ -59,19 +64,23 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopStrengthReducer.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Object.h>
+#include <libyul/OptimizedFunctionCache.h>
 
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -89,9 +98,13 @@ void OptimiserSuite::run(
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _parallelism,
+	map<YulString, size_t> const& _functionExecutionsPerDeployment,
+	OptimizedFunctionCache* _functionCache
 )
 {
+	util::Profiler::Phase phase("Yul optimiser", _object.name.str());
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -102,7 +115,18 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _expectedExecutionsPerDeployment);
+	OptimiserSuite suite(
+		_dialect,
+		reservedIdentifiers,
+		Debug::None,
+		ast,
+		_expectedExecutionsPerDeployment,
+		_parallelism,
+		_functionCache
+	);
+	suite.m_objectName = _object.name.str();
+	if (_expectedExecutionsPerDeployment)
+		suite.m_context.functionExecutionsPerDeployment = _functionExecutionsPerDeployment;
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -122,14 +146,29 @@ void OptimiserSuite::run(
 		_dialect,
 		_object,
 		_optimizeStackAllocation,
-		stackCompressorMaxIterations
+		stackCompressorMaxIterations,
+		_parallelism
 	);
 	suite.runSequence("fDnTOc g", ast);
 
 	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*dialect, *_meter}(ast);
+		ConstantOptimiser constantOptimiser{*dialect, *_meter};
+		for (Statement& statement: ast.statements)
+		{
+			auto* function = get_if<FunctionDefinition>(&statement);
+			auto profile = function ?
+				suite.m_context.functionExecutionsPerDeployment.find(function->name) :
+				suite.m_context.functionExecutionsPerDeployment.end();
+			if (profile == suite.m_context.functionExecutionsPerDeployment.end())
+				std::visit(constantOptimiser, statement);
+			else
+			{
+				GasMeter meter{*dialect, _meter->isCreation(), profile->second};
+				ConstantOptimiser{*dialect, meter}(*function);
+			}
+		}
 		if (dialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object, CompilabilityChecker{
 				_dialect,
@@ -170,45 +209,73 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 	return ret;
 }
 
+/// @returns a hash of @a _part and of the information a function-local step applied to it depends on.
+uint64_t partHash(Block const& _part, InterproceduralInformation const& _information)
+{
+	uint64_t hash = ASTHasher::run(_part);
+	auto combine = [&](uint64_t _value) { hash = (hash ^ _value) * ASTHasherBase::fnvPrime; };
+	combine(_information.containsMSize ? 1 : 0);
+	for (auto const& [function, sideEffects]: _information.functionSideEffects)
+	{
+		combine(function.hash());
+		combine(
+			uint64_t(sideEffects.movable) |
+			uint64_t(sideEffects.movableApartFromEffects) << 1 |
+			uint64_t(sideEffects.canBeRemoved) << 2 |
+			uint64_t(sideEffects.canBeRemovedIfNoMSize) << 3 |
+			uint64_t(sideEffects.cannotLoop) << 4 |
+			uint64_t(sideEffects.otherState) << 5 |
+			uint64_t(sideEffects.storage) << 7 |
+			uint64_t(sideEffects.memory) << 9
+		);
+	}
+	return hash;
+}
+
 }
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	// Initialised only once, also if the optimiser runs on several threads.
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		BudgetedInliner,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		CommonSubexpressionHoister,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		CopyCoalescer,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		InterproceduralConstantPropagator,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopStrengthReducer,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		UnusedStoreEliminator,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -218,11 +285,14 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 {
 	static map<string, char> lookupTable{
 		{BlockFlattener::name,                'f'},
+		{BudgetedInliner::name,               'B'},
 		{CircularReferencesPruner::name,      'l'},
 		{CommonSubexpressionEliminator::name, 'c'},
+		{CommonSubexpressionHoister::name,    'H'},
 		{ConditionalSimplifier::name,         'C'},
 		{ConditionalUnsimplifier::name,       'U'},
 		{ControlFlowSimplifier::name,         'n'},
+		{CopyCoalescer::name,                 'K'},
 		{DeadCodeEliminator::name,            'D'},
 		{EquivalentFunctionCombiner::name,    'v'},
 		{ExpressionInliner::name,             'e'},
@@ -236,9 +306,11 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
 		{FunctionSpecializer::name,           'F'},
+		{InterproceduralConstantPropagator::name, 'P'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopStrengthReducer::name,           'S'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{RedundantAssignEliminator::name,     'r'},
 		{Rematerialiser::name,                'm'},
@@ -247,6 +319,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
+		{UnusedStoreEliminator::name,         'E'},
 		{VarDeclInitializer::name,            'd'},
 	};
 	yulAssert(lookupTable.size() == allSteps().size(), "");
@@ -350,11 +423,10 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		runStep(*allSteps().at(step), _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
-			// TODO should add switch to also compare variable names!
-			if (SyntacticallyEqual{}.statementEqual(_ast, *copy))
+			if (SyntacticallyEqual{true}.statementEqual(_ast, *copy))
 				cout << "== Running " << step << " did not cause changes." << endl;
 			else
 			{
@@ -366,6 +438,129 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	}
 }
 
+void OptimiserSuite::runStep(OptimiserStep const& _step, Block& _ast, set<uint64_t>* _stableParts)
+{
+	// The metrics are only computed while profiling and are not part of the measured time.
+	optional<util::Profiler::Transformation> transformation;
+	if (util::Profiler::active())
+	{
+		transformation.emplace();
+		transformation->object = m_objectName;
+		transformation->name = _step.name;
+		transformation->codeSizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+		transformation->codeCostBefore = CodeCost::codeCost(m_context.dialect, _ast);
+	}
+
+	auto const start = chrono::steady_clock::now();
+	{
+		// All rounds of a step are measured together.
+		util::Profiler::Phase phase(
+			string{stepNameToAbbreviationMap().at(_step.name)} + " (" + _step.name + ")",
+			m_objectName
+		);
+		applyStep(_step, _ast, _stableParts);
+	}
+
+	if (transformation)
+	{
+		transformation->wallTimeSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		transformation->codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+		transformation->codeCostAfter = CodeCost::codeCost(m_context.dialect, _ast);
+		util::Profiler::recordTransformation(move(*transformation));
+	}
+}
+
+void OptimiserSuite::applyStep(OptimiserStep const& _step, Block& _ast, set<uint64_t>* _stableParts)
+{
+	auto isFunction = [](Statement const& _statement) { return holds_alternative<FunctionDefinition>(_statement); };
+	auto firstFunction = find_if(_ast.statements.begin(), _ast.statements.end(), isFunction);
+	// The parts are only independent if all code outside of functions precedes the
+	// function definitions, which is the case after FunctionHoister or FunctionGrouper.
+	if (
+		(!m_threadPool && !m_functionCache && !_stableParts) ||
+		!_step.isFunctionLocal() ||
+		firstFunction == _ast.statements.end() ||
+		!all_of(firstFunction, _ast.statements.end(), isFunction)
+	)
+	{
+		_step.run(m_context, _ast);
+		return;
+	}
+
+	InterproceduralInformation const& information = m_context.analysisCache.information(m_context.dialect, _ast);
+
+	vector<Block> parts;
+	if (firstFunction != _ast.statements.begin())
+		parts.emplace_back(Block{_ast.debugData, vector<Statement>(
+			make_move_iterator(_ast.statements.begin()),
+			make_move_iterator(firstFunction)
+		)});
+	for (auto it = firstFunction; it != _ast.statements.end(); ++it)
+		parts.emplace_back(Block{_ast.debugData, util::make_vector<Statement>(std::move(*it))});
+	_ast.statements.clear();
+
+	// Reassemble the AST in the original order, even if one of the parts failed.
+	ScopeGuard reassemble([&]() {
+		for (Block& part: parts)
+			_ast.statements += std::move(part.statements);
+	});
+	// The hashes of the parts that were not changed by the step, which are only
+	// added to the stable parts afterwards, since the parts can be processed concurrently.
+	vector<optional<uint64_t>> unchangedParts(parts.size());
+	auto process = [&](Block& _part) {
+		InterproceduralInformation partInformation = information.restrictedTo(_part);
+		if (!_stableParts)
+		{
+			applyStepToPart(_step, _part, partInformation);
+			return;
+		}
+		uint64_t hash = partHash(_part, partInformation);
+		if (_stableParts->count(hash))
+			return;
+		applyStepToPart(_step, _part, partInformation);
+		if (partHash(_part, partInformation) == hash)
+			unchangedParts[static_cast<size_t>(&_part - parts.data())] = hash;
+	};
+	if (m_threadPool)
+		m_threadPool->forEach(parts, process);
+	else
+		for (Block& part: parts)
+			process(part);
+
+	if (_stableParts)
+		for (optional<uint64_t> const& hash: unchangedParts)
+			if (hash)
+				_stableParts->insert(*hash);
+}
+
+void OptimiserSuite::applyStepToPart(
+	OptimiserStep const& _step,
+	Block& _part,
+	InterproceduralInformation const& _information
+)
+{
+	if (!m_functionCache)
+	{
+		_step.runOnPart(m_context, _part, _information);
+		return;
+	}
+
+	string key = OptimizedFunctionCache::key(
+		m_context.dialect,
+		_step.name,
+		_part,
+		_information,
+		m_context.expectedExecutionsPerDeployment
+	);
+	if (optional<Block> cached = m_functionCache->find(key))
+		_part = std::move(*cached);
+	else
+	{
+		_step.runOnPart(m_context, _part, _information);
+		m_functionCache->insert(move(key), _part);
+	}
+}
+
 void OptimiserSuite::runSequenceUntilStable(
 	std::vector<string> const& _steps,
 	Block& _ast,
@@ -375,6 +570,20 @@ void OptimiserSuite::runSequenceUntilStable(
 	if (_steps.empty())
 		return;
 
+	// The AST is numbered by the changes made to it. For each step of the sequence, the number
+	// of the last AST it was applied to without changing it. Applying the step to the same AST
+	// again is skipped, since the steps are deterministic.
+	size_t astVersion = 0;
+	vector<optional<size_t>> unchangedBy(_steps.size());
+	// For each step of the sequence, the hashes of the functions it did not change, if it is
+	// function-local. In later rounds, most functions are stable and the step is only applied
+	// to the others.
+	vector<set<uint64_t>> stableParts(_steps.size());
+	// The AST only counts as unchanged by a step if it has the same hash as before and is equal
+	// to a copy made before the step, including all names.
+	uint64_t astHash = ASTHasher::run(_ast);
+	unique_ptr<Block> astBefore;
+
 	size_t codeSize = 0;
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
@@ -383,6 +592,36 @@ void OptimiserSuite::runSequenceUntilStable(
 			break;
 		codeSize = newSize;
 
-		runSequence(_steps, _ast);
+		if (m_debug == Debug::PrintChanges)
+		{
+			runSequence(_steps, _ast);
+			continue;
+		}
+
+		bool changed = false;
+		for (size_t i = 0; i < _steps.size(); ++i)
+		{
+			if (unchangedBy[i] == astVersion)
+				continue;
+			if (m_debug == Debug::PrintStep)
+				cout << "Running " << _steps[i] << endl;
+			if (!astBefore)
+				astBefore = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+			runStep(*allSteps().at(_steps[i]), _ast, &stableParts[i]);
+
+			uint64_t newHash = ASTHasher::run(_ast);
+			if (newHash == astHash && SyntacticallyEqual{true}.statementEqual(_ast, *astBefore))
+				unchangedBy[i] = astVersion;
+			else
+			{
+				changed = true;
+				++astVersion;
+				astHash = newHash;
+				astBefore.reset();
+			}
+		}
+		// Fixpoint: Another round would not change anything either.
+		if (!changed)
+			break;
 	}
 }
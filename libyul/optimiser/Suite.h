@@ -26,7 +26,9 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
@@ -38,6 +40,7 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimizedFunctionCache;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -59,6 +62,13 @@ public:
 		PrintChanges
 	};
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// For runtime code, `_functionExecutionsPerDeployment` can provide the expected number of
+	/// executions of individual functions, e.g. from a profile, that is used for them instead.
+	/// If `_parallelism` is greater than one, function-local steps are applied to
+	/// the individual functions concurrently using that many threads. The result does
+	/// not depend on the number of threads.
+	/// If `_functionCache` is given, the results of function-local steps on the individual
+	/// functions are taken from it, if present, and stored in it otherwise.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -66,7 +76,10 @@ public:
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _parallelism = 1,
+		std::map<YulString, size_t> const& _functionExecutionsPerDeployment = {},
+		OptimizedFunctionCache* _functionCache = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -91,16 +104,36 @@ private:
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
 		Block& _ast,
-		std::optional<size_t> expectedExecutionsPerDeployment
+		std::optional<size_t> expectedExecutionsPerDeployment,
+		size_t _parallelism,
+		OptimizedFunctionCache* _functionCache = nullptr
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, expectedExecutionsPerDeployment},
-		m_debug(_debug)
+		m_debug(_debug),
+		m_threadPool(_parallelism > 1 ? std::make_unique<util::ThreadPool>(_parallelism) : nullptr),
+		m_functionCache(_functionCache)
 	{}
 
+	/// Applies @a _step to @a _ast and records its effect on the code if profiling is active.
+	void runStep(OptimiserStep const& _step, Block& _ast, std::set<uint64_t>* _stableParts = nullptr);
+	/// Applies @a _step to @a _ast, concurrently for every function if the step is function-local
+	/// and a thread pool is available. The results for the functions are reused from the function
+	/// cache, if available.
+	/// If @a _stableParts is given, a function-local step is not applied to the functions and the
+	/// code outside of functions whose hash, including the information the step depends on, is
+	/// contained in it, and the hashes of the parts the step does not change are added to it.
+	void applyStep(OptimiserStep const& _step, Block& _ast, std::set<uint64_t>* _stableParts = nullptr);
+	/// Applies the function-local step @a _step to @a _part or takes the result from the function cache.
+	void applyStepToPart(OptimiserStep const& _step, Block& _part, InterproceduralInformation const& _information);
+
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	std::unique_ptr<util::ThreadPool> m_threadPool;
+	OptimizedFunctionCache* m_functionCache = nullptr;
+	/// Name of the optimised object, used to report the effect of the steps.
+	std::string m_objectName;
 };
 
 }
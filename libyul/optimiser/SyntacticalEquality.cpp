@@ -24,6 +24,7 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 using namespace std;
 using namespace solidity;
@@ -31,6 +32,7 @@ using namespace solidity::yul;
 
 bool SyntacticallyEqual::operator()(Expression const& _lhs, Expression const& _rhs)
 {
+	SOL_PERF_COUNTER("yul.SyntacticallyEqual.expressionComparisons", 1);
 	return std::visit([this](auto&& _lhsExpr, auto&& _rhsExpr) -> bool {
 		// ``this->`` is redundant, but required to work around a bug present in gcc 6.x.
 		return this->expressionEqual(_lhsExpr, _rhsExpr);
@@ -39,6 +41,7 @@ bool SyntacticallyEqual::operator()(Expression const& _lhs, Expression const& _r
 
 bool SyntacticallyEqual::operator()(Statement const& _lhs, Statement const& _rhs)
 {
+	SOL_PERF_COUNTER("yul.SyntacticallyEqual.statementComparisons", 1);
 	return std::visit([this](auto&& _lhsStmt, auto&& _rhsStmt) -> bool {
 		// ``this->`` is redundant, but required to work around a bug present in gcc 6.x.
 		return this->statementEqual(_lhsStmt, _rhsStmt);
@@ -99,6 +102,8 @@ bool SyntacticallyEqual::statementEqual(VariableDeclaration const& _lhs, Variabl
 
 bool SyntacticallyEqual::statementEqual(FunctionDefinition const& _lhs, FunctionDefinition const& _rhs)
 {
+	if (m_exact && _lhs.name != _rhs.name)
+		return false;
 	auto compare = [this](TypedName const& _lhsVarName, TypedName const& _rhsVarName) -> bool {
 		return this->visitDeclaration(_lhsVarName, _rhsVarName);
 	};
@@ -119,6 +124,13 @@ bool SyntacticallyEqual::statementEqual(If const& _lhs, If const& _rhs)
 
 bool SyntacticallyEqual::statementEqual(Switch const& _lhs, Switch const& _rhs)
 {
+	if (m_exact)
+		return
+			compareUniquePtr<Expression, &SyntacticallyEqual::operator()>(_lhs.expression, _rhs.expression) &&
+			util::containerEqual(_lhs.cases, _rhs.cases, [this](Case const& _lhsCase, Case const& _rhsCase) -> bool {
+				return this->switchCaseEqual(_lhsCase, _rhsCase);
+			});
+
 	std::set<Case const*, SwitchCaseCompareByLiteralValue> lhsCases;
 	std::set<Case const*, SwitchCaseCompareByLiteralValue> rhsCases;
 	for (auto const& lhsCase: _lhs.cases)
@@ -158,10 +170,15 @@ bool SyntacticallyEqual::statementEqual(Block const& _lhs, Block const& _rhs)
 
 bool SyntacticallyEqual::visitDeclaration(TypedName const& _lhs, TypedName const& _rhs)
 {
-	if (_lhs.type != _rhs.type)
+	if (_lhs.type != _rhs.type || (m_exact && _lhs.name != _rhs.name))
 		return false;
 	std::size_t id = m_idsUsed++;
 	m_identifiersLHS[_lhs.name] = id;
 	m_identifiersRHS[_rhs.name] = id;
 	return true;
 }
+
+bool SyntacticallyEqualExpression::operator()(Expression const& _lhs, Expression const& _rhs) const
+{
+	return SyntacticallyEqual{}(_lhs, _rhs);
+}
@@ -34,12 +34,16 @@ namespace solidity::yul
 /**
  * Component that can compare ASTs for equality on a syntactic basis.
  * Ignores source locations and allows for different variable names but requires exact matches otherwise.
+ * If constructed with @a _exact set, it also requires the names of variables and functions and the
+ * order of the cases of switch statements to be the same.
  *
  * Prerequisite: Disambiguator (unless only expressions are compared)
  */
 class SyntacticallyEqual
 {
 public:
+	explicit SyntacticallyEqual(bool _exact = false): m_exact(_exact) {}
+
 	bool operator()(Expression const& _lhs, Expression const& _rhs);
 	bool operator()(Statement const& _lhs, Statement const& _rhs);
 
@@ -80,9 +84,16 @@ private:
 		return (_lhs == _rhs) || (_lhs && _rhs && (this->*CompareMember)(*_lhs, *_rhs));
 	}
 
+	bool m_exact = false;
 	std::size_t m_idsUsed = 0;
 	std::map<YulString, std::size_t> m_identifiersLHS;
 	std::map<YulString, std::size_t> m_identifiersRHS;
 };
 
+/// Equality function object for expressions, to be used in unordered containers.
+struct SyntacticallyEqualExpression
+{
+	bool operator()(Expression const& _lhs, Expression const& _rhs) const;
+};
+
 }
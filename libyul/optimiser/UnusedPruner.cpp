@@ -33,6 +33,18 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	InterproceduralInformation const& information = _context.analysisCache.information(_context.dialect, _ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		!information.containsMSize,
+		&information.functionSideEffects,
+		_context.reservedIdentifiers
+	);
+}
+
 UnusedPruner::UnusedPruner(
 	Dialect const& _dialect,
 	Block& _ast,
@@ -150,9 +162,9 @@ void UnusedPruner::runUntilStabilisedOnFullAST(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast));
-	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_dialect, _ast);
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	map<YulString, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(_dialect, callGraph);
+	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_dialect, callGraph);
 	runUntilStabilised(_dialect, _ast, allowMSizeOptimization, &functionSideEffects, _externallyUsedFunctions);
 }
 
@@ -0,0 +1,443 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that removes ``sstore``, ``mstore`` and ``mstore8`` statements
+ * whose stored value is never read.
+ */
+
+#include <libyul/optimiser/UnusedStoreEliminator.h>
+
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/action/remove_if.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/**
+ * Removes the expression statements that consist of one of the given function calls.
+ */
+class StoreRemover: public ASTModifier
+{
+public:
+	explicit StoreRemover(set<FunctionCall const*> const& _toRemove): m_toRemove(_toRemove) {}
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override
+	{
+		ranges::actions::remove_if(_block.statements, [&](Statement const& _statement) -> bool {
+			ExpressionStatement const* expressionStatement = get_if<ExpressionStatement>(&_statement);
+			return
+				expressionStatement &&
+				holds_alternative<FunctionCall>(expressionStatement->expression) &&
+				m_toRemove.count(&std::get<FunctionCall>(expressionStatement->expression));
+		});
+
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	set<FunctionCall const*> const& m_toRemove;
+};
+
+}
+
+void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!evmDialect)
+		return;
+
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	UnusedStoreEliminator use{
+		*evmDialect,
+		ssaValues.values(),
+		_context.analysisCache.information(_context.dialect, _ast).containsMSize
+	};
+	use(_ast);
+	// Falling off the end of the code stops the execution.
+	use.terminate(false);
+
+	set<FunctionCall const*> toRemove;
+	for (auto const& store: use.m_stores)
+		if (!use.m_usedStores.count(store.first))
+			toRemove.insert(store.first);
+	StoreRemover{toRemove}(_ast);
+}
+
+UnusedStoreEliminator::UnusedStoreEliminator(
+	EVMDialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues,
+	bool _containsMSize
+):
+	m_dialect(_dialect),
+	m_ssaValues(_ssaValues),
+	m_containsMSize(_containsMSize)
+{
+}
+
+void UnusedStoreEliminator::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+
+	BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+	if (!builtin)
+	{
+		markAllUsed();
+		return;
+	}
+
+	if (optional<Store> store = trackableStore(_functionCall))
+	{
+		bool const reassignedKey = m_activeStores.reassignedKeys.count(&_functionCall);
+		for (auto it = m_activeStores.stores.begin(); it != m_activeStores.stores.end();)
+			if (coveredBy(*it, *store))
+			{
+				m_activeStores.reassignedKeys.erase(*it);
+				it = m_activeStores.stores.erase(it);
+			}
+			else
+				++it;
+		m_stores.emplace(&_functionCall, *store);
+		m_activeStores.stores.insert(&_functionCall);
+		// An earlier execution of the store that is still active might have used a different key.
+		if (reassignedKey)
+			m_activeStores.reassignedKeys.insert(&_functionCall);
+		return;
+	}
+
+	vector<Expression> const& arguments = _functionCall.arguments;
+	switch (builtin->instruction ? *builtin->instruction : Instruction::INVALID)
+	{
+	case Instruction::SSTORE:
+	case Instruction::MSTORE:
+	case Instruction::MSTORE8:
+		break;
+	case Instruction::SLOAD:
+		markRead(Location::Storage, constantValue(arguments.at(0)), 1);
+		break;
+	case Instruction::MLOAD:
+		markRead(Location::Memory, constantValue(arguments.at(0)), 32);
+		break;
+	case Instruction::KECCAK256:
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		markRead(Location::Memory, constantValue(arguments.at(0)), constantValue(arguments.at(1)));
+		break;
+	default:
+		if (builtin->sideEffects.storage != SideEffects::None)
+			markRead(Location::Storage, nullopt, nullopt);
+		if (builtin->sideEffects.memory != SideEffects::None)
+			markRead(Location::Memory, nullopt, nullopt);
+		break;
+	}
+
+	if (builtin->controlFlowSideEffects.terminates)
+		terminate(builtin->controlFlowSideEffects.reverts);
+}
+
+void UnusedStoreEliminator::operator()(VariableDeclaration const& _variableDeclaration)
+{
+	ASTWalker::operator()(_variableDeclaration);
+
+	for (auto const& var: _variableDeclaration.variables)
+		invalidateKey(var.name);
+}
+
+void UnusedStoreEliminator::operator()(Assignment const& _assignment)
+{
+	ASTWalker::operator()(_assignment);
+
+	for (auto const& var: _assignment.variableNames)
+		invalidateKey(var.name);
+}
+
+void UnusedStoreEliminator::operator()(If const& _if)
+{
+	visit(*_if.condition);
+
+	ActiveStores skipBranch{m_activeStores};
+	(*this)(_if.body);
+
+	m_activeStores.join(skipBranch);
+}
+
+void UnusedStoreEliminator::operator()(Switch const& _switch)
+{
+	visit(*_switch.expression);
+
+	ActiveStores const preState{m_activeStores};
+
+	bool hasDefault = false;
+	vector<ActiveStores> branches;
+	for (auto const& c: _switch.cases)
+	{
+		if (!c.value)
+			hasDefault = true;
+		(*this)(c.body);
+		branches.emplace_back(move(m_activeStores));
+		m_activeStores = preState;
+	}
+
+	if (hasDefault)
+	{
+		m_activeStores = move(branches.back());
+		branches.pop_back();
+	}
+	merge(m_activeStores, move(branches));
+}
+
+void UnusedStoreEliminator::operator()(FunctionDefinition const& _functionDefinition)
+{
+	ActiveStores outerActiveStores;
+	ForLoopInfo outerForLoopInfo;
+	size_t outerForLoopNestingDepth = 0;
+	swap(m_activeStores, outerActiveStores);
+	swap(m_forLoopInfo, outerForLoopInfo);
+	swap(m_forLoopNestingDepth, outerForLoopNestingDepth);
+
+	(*this)(_functionDefinition.body);
+	markAllUsed();
+
+	swap(m_activeStores, outerActiveStores);
+	swap(m_forLoopInfo, outerForLoopInfo);
+	swap(m_forLoopNestingDepth, outerForLoopNestingDepth);
+}
+
+void UnusedStoreEliminator::operator()(ForLoop const& _forLoop)
+{
+	ForLoopInfo outerForLoopInfo;
+	swap(outerForLoopInfo, m_forLoopInfo);
+	++m_forLoopNestingDepth;
+
+	// If the pre block was not empty,
+	// we would have to deal with more complicated scoping rules.
+	assertThrow(_forLoop.pre.statements.empty(), OptimizerException, "");
+
+	// Like in the RedundantAssignEliminator, we run the loop twice to account for the back edge.
+	// Stores active at the end of the first run are read in the second run if they are read
+	// at all before being overwritten inside the loop.
+
+	visit(*_forLoop.condition);
+
+	ActiveStores zeroRuns{m_activeStores};
+
+	(*this)(_forLoop.body);
+	merge(m_activeStores, move(m_forLoopInfo.pendingContinueStmts));
+	m_forLoopInfo.pendingContinueStmts = {};
+	(*this)(_forLoop.post);
+
+	visit(*_forLoop.condition);
+
+	if (m_forLoopNestingDepth < 6)
+	{
+		// Do the second run only for small nesting depths to avoid horrible runtime.
+		ActiveStores oneRun{m_activeStores};
+
+		(*this)(_forLoop.body);
+
+		merge(m_activeStores, move(m_forLoopInfo.pendingContinueStmts));
+		m_forLoopInfo.pendingContinueStmts.clear();
+		(*this)(_forLoop.post);
+
+		visit(*_forLoop.condition);
+		m_activeStores.join(oneRun);
+	}
+	else
+		// Shortcut to avoid horrible runtime: Assume that the second run reads all stores.
+		markAllUsed();
+
+	m_activeStores.join(zeroRuns);
+	merge(m_activeStores, move(m_forLoopInfo.pendingBreakStmts));
+	m_forLoopInfo.pendingBreakStmts.clear();
+
+	// Restore potential outer for-loop states.
+	swap(m_forLoopInfo, outerForLoopInfo);
+	--m_forLoopNestingDepth;
+}
+
+void UnusedStoreEliminator::operator()(Break const&)
+{
+	m_forLoopInfo.pendingBreakStmts.emplace_back(move(m_activeStores));
+	m_activeStores = {};
+}
+
+void UnusedStoreEliminator::operator()(Continue const&)
+{
+	m_forLoopInfo.pendingContinueStmts.emplace_back(move(m_activeStores));
+	m_activeStores = {};
+}
+
+void UnusedStoreEliminator::operator()(Leave const&)
+{
+	markAllUsed();
+	m_activeStores = {};
+}
+
+void UnusedStoreEliminator::ActiveStores::join(ActiveStores const& _other)
+{
+	stores += _other.stores;
+	reassignedKeys += _other.reassignedKeys;
+}
+
+optional<UnusedStoreEliminator::Store> UnusedStoreEliminator::trackableStore(FunctionCall const& _functionCall) const
+{
+	BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+	if (!builtin || !builtin->instruction)
+		return nullopt;
+
+	Store store;
+	switch (*builtin->instruction)
+	{
+	case Instruction::SSTORE:
+		store.location = Location::Storage;
+		store.length = 1;
+		break;
+	case Instruction::MSTORE:
+		store.location = Location::Memory;
+		store.length = 32;
+		break;
+	case Instruction::MSTORE8:
+		store.location = Location::Memory;
+		store.length = 1;
+		break;
+	default:
+		return nullopt;
+	}
+	if (store.location == Location::Memory && m_containsMSize)
+		return nullopt;
+
+	for (Expression const& argument: _functionCall.arguments)
+		if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+			return nullopt;
+
+	store.key = &_functionCall.arguments.at(0);
+	store.constantKey = constantValue(*store.key);
+	return store;
+}
+
+optional<u256> UnusedStoreEliminator::constantValue(Expression const& _expression) const
+{
+	Expression const* expression = &_expression;
+	while (Identifier const* identifier = get_if<Identifier>(expression))
+		if (Expression const* const* value = util::valueOrNullptr(m_ssaValues, identifier->name))
+			expression = *value;
+		else
+			return nullopt;
+
+	if (Literal const* literal = get_if<Literal>(expression))
+		return valueOfLiteral(*literal);
+	return nullopt;
+}
+
+bool UnusedStoreEliminator::coveredBy(FunctionCall const* _store, Store const& _other) const
+{
+	Store const& store = m_stores.at(_store);
+	if (store.location != _other.location)
+		return false;
+
+	if (store.constantKey && _other.constantKey)
+		return
+			*_other.constantKey <= *store.constantKey &&
+			bigint(*store.constantKey) + store.length <= bigint(*_other.constantKey) + _other.length;
+
+	if (m_activeStores.reassignedKeys.count(_store))
+		return false;
+	Identifier const* key = get_if<Identifier>(store.key);
+	Identifier const* otherKey = get_if<Identifier>(_other.key);
+	return key && otherKey && key->name == otherKey->name && store.length <= _other.length;
+}
+
+bool UnusedStoreEliminator::knownDisjoint(
+	FunctionCall const* _store,
+	optional<u256> const& _offset,
+	optional<u256> const& _length
+) const
+{
+	if (_length && *_length == 0)
+		return true;
+
+	Store const& store = m_stores.at(_store);
+	if (!store.constantKey || !_offset || !_length)
+		return false;
+	return
+		bigint(*store.constantKey) + store.length <= *_offset ||
+		bigint(*_offset) + *_length <= *store.constantKey;
+}
+
+void UnusedStoreEliminator::markRead(Location _location, optional<u256> const& _offset, optional<u256> const& _length)
+{
+	for (auto it = m_activeStores.stores.begin(); it != m_activeStores.stores.end();)
+		if (m_stores.at(*it).location == _location && !knownDisjoint(*it, _offset, _length))
+		{
+			m_usedStores.insert(*it);
+			m_activeStores.reassignedKeys.erase(*it);
+			it = m_activeStores.stores.erase(it);
+		}
+		else
+			++it;
+}
+
+void UnusedStoreEliminator::markAllUsed()
+{
+	markRead(Location::Storage, nullopt, nullopt);
+	markRead(Location::Memory, nullopt, nullopt);
+}
+
+void UnusedStoreEliminator::terminate(bool _reverts)
+{
+	if (!_reverts)
+		markRead(Location::Storage, nullopt, nullopt);
+	m_activeStores = {};
+}
+
+void UnusedStoreEliminator::invalidateKey(YulString _variable)
+{
+	for (FunctionCall const* store: m_activeStores.stores)
+	{
+		Identifier const* key = get_if<Identifier>(m_stores.at(store).key);
+		if (key && key->name == _variable && !m_stores.at(store).constantKey)
+			m_activeStores.reassignedKeys.insert(store);
+	}
+}
+
+void UnusedStoreEliminator::merge(ActiveStores& _target, vector<ActiveStores>&& _source)
+{
+	for (ActiveStores const& activeStores: _source)
+		_target.join(activeStores);
+	_source.clear();
+}
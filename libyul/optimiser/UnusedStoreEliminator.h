@@ -0,0 +1,185 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that removes ``sstore``, ``mstore`` and ``mstore8`` statements
+ * whose stored value is never read.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+class EVMDialect;
+
+/**
+ * Optimiser component that removes ``sstore``, ``mstore`` and ``mstore8`` statements
+ * whose stored value is not read on any control-flow path, because it is overwritten
+ * before or because execution ends without reading it.
+ *
+ * Example:
+ *
+ * {
+ *   let x := calldataload(0)
+ *   sstore(0, x)
+ *   mstore(0x40, 0x80)
+ *   if x { sstore(0, 1) }
+ *   sstore(0, 2)
+ *   mstore(0x40, 0xa0)
+ *   return(0, 0)
+ * }
+ *
+ * Both ``sstore(0, x)`` and ``sstore(0, 1)`` are removed, because the slot is overwritten
+ * on all paths by ``sstore(0, 2)`` before it is read. Both stores to ``0x40`` are removed,
+ * because memory is not read before execution ends. ``sstore(0, 2)`` is kept, since storage
+ * persists after ``return``.
+ *
+ * Only stores whose arguments are identifiers or literals are removed. The AST is traversed
+ * like in the RedundantAssignEliminator: Every path keeps the set of "active" stores, i.e. the
+ * stores whose value might still be read. At points where control flow splits, the set is
+ * copied, where it joins, the sets are united, and loops are traversed twice.
+ *
+ * - A store removes the active stores to the same location from the set. Locations are the
+ *   same if the keys are the same constant or the same variable that was not (re-)assigned
+ *   in between.
+ * - A load or another operation reading the location of an active store marks it "used".
+ *   ``sload(k)`` and ``mload(k)`` as well as ``keccak256``, ``log``, ``return`` and ``revert``
+ *   of a memory area only read the stores that are not known to be different, all other
+ *   operations accessing storage or memory and all calls of user-defined functions read
+ *   every active store.
+ * - When execution ends by ``stop``, ``return``, ``selfdestruct`` or the end of the code,
+ *   active storage stores are marked "used". When execution reverts, they stay unused.
+ *   Memory does not outlive the execution, so active memory stores stay unused in both cases.
+ * - At the end of a function and at ``leave``, all active stores are marked "used",
+ *   since the caller can still read them.
+ *
+ * In the second traversal, all tracked stores that were never marked "used" are removed.
+ * This includes updates of the free memory pointer that are not read before the end of
+ * the execution.
+ *
+ * If the code contains ``msize``, memory stores are not removed, since removing them could
+ * change the size of the memory.
+ *
+ * The step only works with EVM dialects. It works best on code after the ExpressionSplitter
+ * and SSATransform, where all arguments of stores are identifiers or literals.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class UnusedStoreEliminator: public ASTWalker
+{
+public:
+	static constexpr char const* name{"UnusedStoreEliminator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(VariableDeclaration const& _variableDeclaration) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+
+private:
+	enum class Location { Storage, Memory };
+
+	/// A store whose arguments are identifiers or literals.
+	struct Store
+	{
+		Location location = Location::Storage;
+		/// Identifier or literal.
+		Expression const* key = nullptr;
+		/// The constant value of the key, if known.
+		std::optional<u256> constantKey;
+		/// Number of bytes written, 1 for storage.
+		u256 length = 1;
+	};
+
+	/// The stores whose value might still be read on the current control-flow path.
+	struct ActiveStores
+	{
+		std::set<FunctionCall const*> stores;
+		/// Active stores whose key is a variable that was assigned since the store.
+		std::set<FunctionCall const*> reassignedKeys;
+
+		/// Adds the stores active in @a _other, keeping reassigned keys from both.
+		void join(ActiveStores const& _other);
+	};
+
+	UnusedStoreEliminator(
+		EVMDialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues,
+		bool _containsMSize
+	);
+
+	/// @returns the description of @a _functionCall if it is a store that can be removed.
+	std::optional<Store> trackableStore(FunctionCall const& _functionCall) const;
+	std::optional<u256> constantValue(Expression const& _expression) const;
+
+	/// @returns true if the location written by @a _store is known to be written by @a _other.
+	bool coveredBy(FunctionCall const* _store, Store const& _other) const;
+	/// @returns true if the area of @a _length bytes at @a _offset is known to be disjoint from
+	/// the area written by @a _store. For storage, the length is 1.
+	bool knownDisjoint(
+		FunctionCall const* _store,
+		std::optional<u256> const& _offset,
+		std::optional<u256> const& _length
+	) const;
+
+	/// Marks the active stores to @a _location that might overlap the given area as used.
+	void markRead(Location _location, std::optional<u256> const& _offset, std::optional<u256> const& _length);
+	void markAllUsed();
+	/// Handles the end of the execution, which reverts the changes to storage if @a _reverts.
+	void terminate(bool _reverts);
+	/// Removes the active stores whose key is @a _variable from comparisons of locations.
+	void invalidateKey(YulString _variable);
+
+	static void merge(ActiveStores& _target, std::vector<ActiveStores>&& _source);
+
+	EVMDialect const& m_dialect;
+	std::map<YulString, Expression const*> const& m_ssaValues;
+	bool m_containsMSize;
+
+	std::map<FunctionCall const*, Store> m_stores;
+	std::set<FunctionCall const*> m_usedStores;
+	ActiveStores m_activeStores;
+
+	/// Working data for traversing for-loops.
+	struct ForLoopInfo
+	{
+		std::vector<ActiveStores> pendingBreakStmts;
+		std::vector<ActiveStores> pendingContinueStmts;
+	};
+	ForLoopInfo m_forLoopInfo;
+	size_t m_forLoopNestingDepth = 0;
+};
+
+}
@@ -35,6 +35,7 @@ class VarDeclInitializer: public ASTModifier
 {
 public:
 	static constexpr char const* name{"VarDeclInitializer"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext& _ctx, Block& _ast) { VarDeclInitializer{_ctx.dialect}(_ast); }
 
 	void operator()(Block& _block) override;
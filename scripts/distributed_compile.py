@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+
+"""
+Compiles a Standard JSON input by distributing the code generation of its contracts
+over several solc processes, which may run on other machines.
+
+The coordinator first runs solc once with all outputs that do not require code generation
+(e.g. the AST, ABI and documentation). This parses and analyses the sources and lists the
+contracts. Then it splits the contracts into jobs and sends each of them to a worker as a
+Standard JSON input that only selects the code generation outputs (``evm.*``, ``ir``,
+``irOptimized`` and ``ewasm.*``) of the contracts of the job. The compiler only generates
+code for selected contracts and the contracts they create. The outputs are merged
+independently of the order in which the jobs finish.
+
+A worker is a shell command that reads a Standard JSON input on stdin and writes the output
+to stdout, for example ``solc --standard-json`` or ``ssh build-node-1 solc --standard-json``.
+All workers must run the same compiler version. Since workers analyse the sources again,
+all sources must be given by their ``content``.
+
+Example:
+
+    scripts/distributed_compile.py input.json \\
+        --worker 'ssh node1 solc --standard-json' \\
+        --worker 'ssh node2 solc --standard-json' \\
+        > output.json
+"""
+
+import json
+import shlex
+import subprocess
+import sys
+from argparse import ArgumentParser
+from concurrent.futures import ThreadPoolExecutor
+from copy import deepcopy
+from itertools import cycle
+from typing import Dict, List, Set, Tuple
+
+
+CODEGEN_OUTPUT_PREFIXES = ['evm', 'ir', 'irOptimized', 'ewasm']
+# The contract outputs other than the code generation outputs that '*' selects.
+ANALYSIS_OUTPUTS = ['abi', 'metadata', 'devdoc', 'userdoc', 'storageLayout']
+
+Contract = Tuple[str, str]
+
+
+class DistributedCompilationError(Exception):
+    pass
+
+
+def is_codegen_output(output: str) -> bool:
+    return output.split('.')[0] in CODEGEN_OUTPUT_PREFIXES
+
+
+def expand_wildcard(outputs: List[str]) -> List[str]:
+    if '*' not in outputs:
+        return outputs
+    return ANALYSIS_OUTPUTS + CODEGEN_OUTPUT_PREFIXES
+
+
+def selected_outputs(output_selection: dict, source: str, contract: str) -> List[str]:
+    """Returns the outputs selected for a contract, taking wildcards into account."""
+    outputs: List[str] = []
+    for source_key in ('*', source):
+        for contract_key in ('*', contract):
+            for output in expand_wildcard(output_selection.get(source_key, {}).get(contract_key, [])):
+                if output not in outputs:
+                    outputs.append(output)
+    return outputs
+
+
+def analysis_input(standard_json_input: dict) -> dict:
+    """
+    Returns the input of the run of the coordinator: The selection without the code generation
+    outputs and with the ABI of all contracts, which makes all contracts appear in the output.
+    """
+    analysis = deepcopy(standard_json_input)
+    output_selection = analysis.setdefault('settings', {}).get('outputSelection', {})
+    new_selection: Dict[str, Dict[str, List[str]]] = {}
+    for source, contracts in output_selection.items():
+        for contract, outputs in contracts.items():
+            if contract == '':
+                new_selection.setdefault(source, {})[contract] = outputs
+            else:
+                kept = [output for output in expand_wildcard(outputs) if not is_codegen_output(output)]
+                if kept:
+                    new_selection.setdefault(source, {})[contract] = kept
+    star = new_selection.setdefault('*', {}).setdefault('*', [])
+    if 'abi' not in star:
+        star.append('abi')
+    analysis['settings']['outputSelection'] = new_selection
+    return analysis
+
+
+def job_input(standard_json_input: dict, contracts: List[Contract]) -> dict:
+    """Returns the input of a worker that generates the code of @a contracts."""
+    job = deepcopy(standard_json_input)
+    output_selection = job.setdefault('settings', {}).get('outputSelection', {})
+    new_selection: Dict[str, Dict[str, List[str]]] = {}
+    for source, contract in contracts:
+        outputs = [
+            output
+            for output in selected_outputs(output_selection, source, contract)
+            if is_codegen_output(output)
+        ]
+        assert outputs
+        new_selection.setdefault(source, {})[contract] = outputs
+    job['settings']['outputSelection'] = new_selection
+    return job
+
+
+def codegen_contracts(standard_json_input: dict, analysis_output: dict) -> List[Contract]:
+    """Returns the contracts for which code generation outputs are selected in a deterministic order."""
+    output_selection = standard_json_input.get('settings', {}).get('outputSelection', {})
+    return sorted(
+        (source, contract)
+        for source, contracts in analysis_output.get('contracts', {}).items()
+        for contract in contracts
+        if any(is_codegen_output(output) for output in selected_outputs(output_selection, source, contract))
+    )
+
+
+def split_into_jobs(contracts: List[Contract], job_count: int) -> List[List[Contract]]:
+    jobs: List[List[Contract]] = [[] for _ in range(min(job_count, len(contracts)))]
+    for job, contract in zip(cycle(jobs), contracts):
+        job.append(contract)
+    return jobs
+
+
+def merge_contract_output(target: dict, source: dict):
+    for key, value in source.items():
+        if isinstance(value, dict) and isinstance(target.get(key), dict):
+            merge_contract_output(target[key], value)
+        else:
+            target[key] = value
+
+
+def merge_outputs(
+    standard_json_input: dict,
+    analysis_output: dict,
+    job_outputs: List[dict],
+) -> dict:
+    """
+    Merges the outputs of the jobs into the output of the analysis run. Errors reported by several
+    runs are only included once. The order of the result only depends on the order of @a job_outputs.
+    """
+    merged = deepcopy(analysis_output)
+
+    # Remove the ABIs that were only added to list the contracts.
+    output_selection = standard_json_input.get('settings', {}).get('outputSelection', {})
+    for source, contracts in merged.get('contracts', {}).items():
+        for contract, contract_output in contracts.items():
+            if 'abi' not in selected_outputs(output_selection, source, contract):
+                contract_output.pop('abi', None)
+
+    seen_errors: Set[str] = {json.dumps(error, sort_keys=True) for error in merged.get('errors', [])}
+    for job_output in job_outputs:
+        for error in job_output.get('errors', []):
+            key = json.dumps(error, sort_keys=True)
+            if key not in seen_errors:
+                seen_errors.add(key)
+                merged.setdefault('errors', []).append(error)
+        for source, contracts in job_output.get('contracts', {}).items():
+            for contract, contract_output in contracts.items():
+                target = merged.setdefault('contracts', {}).setdefault(source, {}).setdefault(contract, {})
+                merge_contract_output(target, contract_output)
+
+    for source in list(merged.get('contracts', {})):
+        contracts = merged['contracts'][source]
+        for contract in [contract for contract, contract_output in contracts.items() if not contract_output]:
+            del contracts[contract]
+        if not contracts:
+            del merged['contracts'][source]
+
+    return merged
+
+
+def has_errors(standard_json_output: dict) -> bool:
+    return any(error.get('severity') == 'error' for error in standard_json_output.get('errors', []))
+
+
+def run_worker(command: str, standard_json_input: dict) -> dict:
+    process = subprocess.run(
+        shlex.split(command),
+        input=json.dumps(standard_json_input),
+        encoding='utf8',
+        stdout=subprocess.PIPE,
+        check=False,
+    )
+    if process.returncode != 0:
+        raise DistributedCompilationError(f"Worker '{command}' failed with exit code {process.returncode}.")
+    return json.loads(process.stdout)
+
+
+def compile_distributed(standard_json_input: dict, workers: List[str], jobs_per_worker: int) -> dict:
+    for source_name, source in standard_json_input.get('sources', {}).items():
+        if 'content' not in source:
+            raise DistributedCompilationError(f"Source '{source_name}' must be given by its content.")
+
+    analysis_output = run_worker(workers[0], analysis_input(standard_json_input))
+    if has_errors(analysis_output):
+        return analysis_output
+
+    jobs = split_into_jobs(
+        codegen_contracts(standard_json_input, analysis_output),
+        len(workers) * jobs_per_worker
+    )
+    with ThreadPoolExecutor(max_workers=len(workers) * jobs_per_worker) as executor:
+        job_outputs = list(executor.map(
+            lambda worker_and_job: run_worker(worker_and_job[0], job_input(standard_json_input, worker_and_job[1])),
+            zip(cycle(workers), jobs)
+        ))
+
+    return merge_outputs(standard_json_input, analysis_output, job_outputs)
+
+
+def commandline_parser() -> ArgumentParser:
+    parser = ArgumentParser(description=__doc__.strip().split('\n\n')[0])
+    parser.add_argument(
+        'input',
+        nargs='?',
+        default='-',
+        help="The Standard JSON input. Read from stdin if omitted or '-'.",
+    )
+    parser.add_argument(
+        '--worker',
+        dest='workers',
+        action='append',
+        help=(
+            "Shell command running a worker that reads Standard JSON from stdin. Can be given several times. "
+            "Defaults to 'solc --standard-json'."
+        ),
+    )
+    parser.add_argument(
+        '--jobs-per-worker',
+        type=int,
+        default=1,
+        help="Number of jobs sent to each worker at the same time.",
+    )
+    return parser
+
+
+def main():
+    options = commandline_parser().parse_args()
+    if options.input == '-':
+        standard_json_input = json.load(sys.stdin)
+    else:
+        with open(options.input, encoding='utf8') as input_file:
+            standard_json_input = json.load(input_file)
+
+    try:
+        output = compile_distributed(
+            standard_json_input,
+            options.workers or ['solc --standard-json'],
+            max(options.jobs_per_worker, 1)
+        )
+    except DistributedCompilationError as exception:
+        print(exception, file=sys.stderr)
+        sys.exit(1)
+
+    print(json.dumps(output, sort_keys=True))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+
+"""
+Attributes the gas of an execution trace to the lines of the Solidity sources.
+
+The trace has to be in the JSON lines format of EIP-3155, i.e. one JSON object per executed
+instruction with at least the fields ``pc``, ``gasCost`` and ``depth``, as produced for example
+by ``geth evm --json run``. The program counters of the outermost call frame are mapped to
+source locations via the runtime source map of the contract; instructions executed in nested
+calls are attributed to the instruction that made the call.
+
+The tool prints the gas per source line. With ``--collapsed`` it prints the gas per stack of
+internal function calls in the collapsed format of flamegraph tools instead, e.g. for
+``flamegraph.pl`` or ``inferno-flamegraph``. The call stack is reconstructed from the jump types
+of the source map.
+
+Example:
+
+    solc --standard-json input.json > output.json
+    geth evm --json --code <runtime bytecode> --input <calldata> run 2> trace.jsonl
+    scripts/gas_profile.py input.json output.json C.sol:C trace.jsonl
+"""
+
+import json
+import sys
+from argparse import ArgumentParser
+from collections import defaultdict
+from dataclasses import dataclass
+from typing import Dict, Iterable, List, Optional, Tuple
+
+
+@dataclass(frozen=True)
+class SourceMapEntry:
+    start: int
+    length: int
+    source_index: int
+    jump: str
+
+
+def parse_source_map(source_map: str) -> List[SourceMapEntry]:
+    """Decompresses a source map of the form ``s:l:f:j;s:l:f:j;...``."""
+    entries: List[SourceMapEntry] = []
+    fields = ['0', '0', '-1', '-']
+    for item in source_map.split(';'):
+        for i, value in enumerate(item.split(':')[:4]):
+            if value != '':
+                fields[i] = value
+        entries.append(SourceMapEntry(int(fields[0]), int(fields[1]), int(fields[2]), fields[3]))
+    return entries
+
+
+def instruction_offsets(bytecode: bytes) -> Dict[int, int]:
+    """Returns the index of the instruction starting at each program counter."""
+    offsets: Dict[int, int] = {}
+    pc = 0
+    index = 0
+    while pc < len(bytecode):
+        offsets[pc] = index
+        opcode = bytecode[pc]
+        # PUSH1 to PUSH32 are followed by their immediate data.
+        pc += 1 + (opcode - 0x5f if 0x60 <= opcode <= 0x7f else 0)
+        index += 1
+    return offsets
+
+
+class LineIndex:
+    def __init__(self, sources: Dict[int, Tuple[str, str]]):
+        self.sources = sources
+        self.line_starts = {
+            index: [0] + [i + 1 for i, char in enumerate(content) if char == '\n']
+            for index, (_, content) in sources.items()
+        }
+
+    def line(self, source_index: int, offset: int) -> Optional[Tuple[str, int]]:
+        if source_index not in self.sources:
+            return None
+        starts = self.line_starts[source_index]
+        low, high = 0, len(starts)
+        while high - low > 1:
+            middle = (low + high) // 2
+            if starts[middle] <= offset:
+                low = middle
+            else:
+                high = middle
+        return self.sources[source_index][0], low + 1
+
+    def text(self, source_index: int, line: int) -> str:
+        content = self.sources[source_index][1]
+        starts = self.line_starts[source_index]
+        end = starts[line] - 1 if line < len(starts) else len(content)
+        return content[starts[line - 1]:end].strip()
+
+
+@dataclass
+class Profile:
+    per_line: Dict[Tuple[int, int], int]
+    per_stack: Dict[Tuple[str, ...], int]
+    unattributed: int
+
+
+def profile_trace(
+    steps: Iterable[dict],
+    bytecode: bytes,
+    source_map: List[SourceMapEntry],
+    lines: LineIndex,
+) -> Profile:
+    offsets = instruction_offsets(bytecode)
+    per_line: Dict[Tuple[int, int], int] = defaultdict(int)
+    per_stack: Dict[Tuple[str, ...], int] = defaultdict(int)
+    unattributed = 0
+    stack: List[str] = []
+    # The location of the last instruction of the outermost frame, to which nested calls are attributed.
+    current: Optional[Tuple[int, int]] = None
+    pending_jump: Optional[str] = None
+
+    def label(source_index: int, line: int) -> str:
+        return f"{lines.sources[source_index][0]}:{line}"
+
+    for step in steps:
+        gas = int(str(step['gasCost']), 0)
+        if int(step.get('depth', 1)) == 1:
+            index = offsets.get(int(step['pc']))
+            if index is None or index >= len(source_map):
+                current = None
+                pending_jump = None
+            else:
+                entry = source_map[index]
+                located = lines.line(entry.source_index, entry.start)
+                current = (entry.source_index, located[1]) if located else None
+                if pending_jump == 'i' and current:
+                    stack.append(label(*current))
+                elif pending_jump == 'o' and stack:
+                    stack.pop()
+                pending_jump = entry.jump if entry.jump in ('i', 'o') else None
+
+        if current is None:
+            unattributed += gas
+            continue
+        per_line[current] += gas
+        per_stack[tuple(stack) + (label(*current),)] += gas
+
+    return Profile(dict(per_line), dict(per_stack), unattributed)
+
+
+def format_per_line(profile: Profile, lines: LineIndex) -> str:
+    total = sum(profile.per_line.values()) + profile.unattributed
+    result = ''
+    for (source_index, line), gas in sorted(profile.per_line.items(), key=lambda item: (-item[1], item[0])):
+        name = lines.sources[source_index][0]
+        result += f"{gas:>10} {100 * gas / total:6.2f}%  {name}:{line}  {lines.text(source_index, line)}\n"
+    if profile.unattributed > 0:
+        result += f"{profile.unattributed:>10} {100 * profile.unattributed / total:6.2f}%  <no source>\n"
+    return result
+
+
+def format_collapsed(profile: Profile) -> str:
+    return ''.join(f"{';'.join(stack)} {gas}\n" for stack, gas in sorted(profile.per_stack.items()))
+
+
+def load_contract(
+    standard_json_input: dict,
+    standard_json_output: dict,
+    contract: str,
+) -> Tuple[bytes, List[SourceMapEntry], LineIndex]:
+    source_name, _, contract_name = contract.rpartition(':')
+    deployed_bytecode = standard_json_output['contracts'][source_name][contract_name]['evm']['deployedBytecode']
+    sources = {
+        output['id']: (name, standard_json_input['sources'][name]['content'])
+        for name, output in standard_json_output['sources'].items()
+        if 'content' in standard_json_input['sources'].get(name, {})
+    }
+    return (
+        bytes.fromhex(deployed_bytecode['object']),
+        parse_source_map(deployed_bytecode['sourceMap']),
+        LineIndex(sources),
+    )
+
+
+def commandline_parser() -> ArgumentParser:
+    parser = ArgumentParser(description=__doc__.strip().split('\n\n')[0])
+    parser.add_argument('input', help="The Standard JSON input, which contains the sources.")
+    parser.add_argument(
+        'output',
+        help=(
+            "The Standard JSON output with evm.deployedBytecode.object and "
+            "evm.deployedBytecode.sourceMap of the contract."
+        ),
+    )
+    parser.add_argument('contract', help="The executed contract as <source name>:<contract name>.")
+    parser.add_argument('trace', nargs='?', default='-', help="The EIP-3155 trace. Read from stdin if omitted or '-'.")
+    parser.add_argument(
+        '--collapsed',
+        action='store_true',
+        help="Print collapsed stacks for flamegraph tools instead of the gas per line.",
+    )
+    return parser
+
+
+def main():
+    options = commandline_parser().parse_args()
+    with open(options.input, encoding='utf8') as input_file:
+        standard_json_input = json.load(input_file)
+    with open(options.output, encoding='utf8') as output_file:
+        standard_json_output = json.load(output_file)
+    bytecode, source_map, lines = load_contract(standard_json_input, standard_json_output, options.contract)
+
+    trace_file = sys.stdin if options.trace == '-' else open(options.trace, encoding='utf8')
+    with trace_file:
+        steps = (
+            json.loads(line)
+            for line in trace_file
+            if line.startswith('{') and '"pc"' in line
+        )
+        profile = profile_trace(steps, bytecode, source_map, lines)
+
+    print(format_collapsed(profile) if options.collapsed else format_per_line(profile, lines), end='')
+
+
+if __name__ == "__main__":
+    main()
@@ -22,13 +22,17 @@
  * Solidity command line interface.
  */
 #include <solc/CommandLineInterface.h>
+#include <solc/CompilationServer.h>
+#include <solc/FileWatcher.h>
 
 #include "solidity/BuildInfo.h"
 #include "license.h"
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/FileReader.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/ast/ASTBinary.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
@@ -56,6 +60,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <algorithm>
 #include <memory>
@@ -80,6 +86,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -122,13 +130,16 @@ static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strAbi = "abi";
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
+static string const g_strBatch = "batch";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
 static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -144,20 +155,30 @@ static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
+static string const g_strKeepUnchanged = "keep-unchanged";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
 static string const g_strIROptimized = "ir-optimized";
 static string const g_strIPFS = "ipfs";
 static string const g_strLicense = "license";
+static string const g_strLowMemory = "low-memory";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
 static string const g_strMachine = "machine";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCache = "model-checker-cache";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerIncremental = "model-checker-incremental";
+static string const g_strModelCheckerBudget = "model-checker-budget";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
+static string const g_strModelCheckerNoCounterexamples = "model-checker-no-counterexamples";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
+static string const g_strModelCheckerSliceState = "model-checker-slice-state";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNatspecDev = "devdoc";
@@ -185,6 +206,8 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
+static string const g_strServerSocket = "server-socket";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -195,8 +218,11 @@ static string const g_strFunDebugRuntime = "function-debug-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strTimePasses = "time-passes";
+static string const g_strTraceFile = "trace-file";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
+static string const g_strWatch = "watch";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
@@ -206,12 +232,15 @@ static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
 static string const g_argBasePath = g_strBasePath;
+static string const g_argBatch = g_strBatch;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
@@ -219,6 +248,9 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
+static string const g_argKeepUnchanged = g_strKeepUnchanged;
+static string const g_argLowMemory = g_strLowMemory;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
@@ -230,8 +262,15 @@ static string const g_argMachine = g_strMachine;
 static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
+static string const g_argModelCheckerCache = g_strModelCheckerCache;
 static string const g_argModelCheckerContracts = g_strModelCheckerContracts;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
+static string const g_argModelCheckerIncremental = g_strModelCheckerIncremental;
+static string const g_argModelCheckerBudget = g_strModelCheckerBudget;
+static string const g_argModelCheckerJobs = g_strModelCheckerJobs;
+static string const g_argModelCheckerNoCounterexamples = g_strModelCheckerNoCounterexamples;
+static string const g_argModelCheckerRaceSolvers = g_strModelCheckerRaceSolvers;
+static string const g_argModelCheckerSliceState = g_strModelCheckerSliceState;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
 static string const g_argNatspecDev = g_strNatspecDev;
@@ -240,11 +279,16 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
+static string const g_argServerSocket = g_strServerSocket;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTimePasses = g_strTimePasses;
+static string const g_argTraceFile = g_strTraceFile;
 static string const g_argVersion = g_strVersion;
+static string const g_argWatch = g_strWatch;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
@@ -340,6 +384,78 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 	return false;
 }
 
+/// @returns true if none of the requested outputs needs the assembly of a contract,
+/// so that contracts can be taken from the artifact cache.
+static bool canUseArtifactCache(po::variables_map const& _args)
+{
+	for (string const& arg: {g_argAsm, g_argAsmJson, g_argEwasm, g_argGas})
+		if (_args.count(arg))
+			return false;
+	if (_args.count(g_argCombinedJson))
+	{
+		set<string> requests;
+		boost::split(requests, _args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+		for (string const& request: {g_strAsm, g_strGeneratedSources, g_strGeneratedSourcesRuntime})
+			if (requests.count(request))
+				return false;
+	}
+	return true;
+}
+
+/// Prints the time and memory spent in each phase of the compilation, the effect of the Yul
+/// optimizer steps and the performance counters, by contract.
+static void printProfile(Profiler const& _profiler)
+{
+	ostringstream out;
+	out << fixed << setprecision(3);
+	out << endl << "======= Compiler phases =======" << endl;
+	for (auto const& [scope, phases]: _profiler.measurements())
+	{
+		out << endl << (scope.empty() ? "All contracts" : scope) << ":" << endl;
+		out << setw(12) << "wall (ms)" << setw(12) << "CPU (ms)" << setw(14) << "memory (KiB)" << setw(8) << "count";
+		out << "  phase" << endl;
+		for (auto const& [name, measurement]: phases)
+		{
+			out << setw(12) << measurement.wallTimeSeconds * 1000 << setw(12) << measurement.cpuTimeSeconds * 1000;
+			out << setw(14) << measurement.peakMemoryIncrease / 1024 << setw(8) << measurement.count;
+			out << "  " << name << endl;
+		}
+	}
+
+	map<string, vector<Profiler::Transformation>> const transformations = _profiler.transformations();
+	if (!transformations.empty())
+		out << endl << "======= Yul optimizer steps =======" << endl;
+	for (auto const& [scope, scopeTransformations]: transformations)
+	{
+		out << endl << (scope.empty() ? "All contracts" : scope) << ":" << endl;
+		out << setw(12) << "wall (ms)" << setw(10) << "size" << setw(10) << "change";
+		out << setw(10) << "cost" << setw(10) << "change" << "  object / step" << endl;
+		for (auto const& transformation: scopeTransformations)
+		{
+			auto change = [](size_t _before, size_t _after) {
+				return to_string(static_cast<long long>(_after) - static_cast<long long>(_before));
+			};
+			out << setw(12) << transformation.wallTimeSeconds * 1000;
+			out << setw(10) << transformation.codeSizeAfter;
+			out << setw(10) << change(transformation.codeSizeBefore, transformation.codeSizeAfter);
+			out << setw(10) << transformation.codeCostAfter;
+			out << setw(10) << change(transformation.codeCostBefore, transformation.codeCostAfter);
+			out << "  " << transformation.object << " / " << transformation.name << endl;
+		}
+	}
+
+	map<string, Profiler::Counters> const counters = _profiler.counters();
+	if (!counters.empty())
+		out << endl << "======= Performance counters =======" << endl;
+	for (auto const& [scope, scopeCounters]: counters)
+	{
+		out << endl << (scope.empty() ? "All contracts" : scope) << ":" << endl;
+		for (auto const& [name, value]: scopeCounters)
+			out << setw(14) << value << "  " << name << endl;
+	}
+	serr(false) << out.str();
+}
+
 namespace
 {
 
@@ -754,6 +870,17 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	for (SourceCode const& sourceCode: m_fileReader.sourceCodes() | ranges::views::values)
 	{
 		Json::Value ast;
+		if (ASTBinary::isEncoded(sourceCode))
+		{
+			ast = ASTBinary::decode(sourceCode);
+			astAssert(ast.isObject() && ast["nodeType"].asString() == "SourceUnit", "Top-level node should be a 'SourceUnit'");
+			astAssert(ast["absolutePath"].isString(), "Source unit must have an absolute path");
+			string src = ast["absolutePath"].asString();
+			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
+			tmpSources[src] = util::jsonCompactPrint(ast);
+			sourceJsons.emplace(move(src), move(ast));
+			continue;
+		}
 		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
@@ -774,32 +901,98 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+void CommandLineInterface::createFile(string const& _fileName, string const& _data, bool _binary)
+{
+	boost::filesystem::path outputDir(m_args.at(g_argOutputDir).as<string>());
+	OutputFile file;
+	file.path = (outputDir / _fileName).string();
+	file.data = _data;
+	file.binary = _binary;
+	m_outputFiles.emplace_back(move(file));
+}
+
+void CommandLineInterface::writeOutputFiles()
 {
 	namespace fs = boost::filesystem;
 
-	fs::path outputDir(m_args.at(g_argOutputDir).as<string>());
+	if (m_outputFiles.empty())
+		return;
 
 	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
 	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
 	// The simplest workaround is to use an absolute path.
-	fs::create_directories(fs::absolute(outputDir));
+	fs::create_directories(fs::absolute(fs::path(m_args.at(g_argOutputDir).as<string>())));
 
-	string pathName = (outputDir / _fileName).string();
-	if (fs::exists(pathName) && !m_args.count(g_strOverwrite))
-	{
-		serr() << "Refusing to overwrite existing file \"" << pathName << "\" (use --" << g_strOverwrite << " to force)." << endl;
-		m_error = true;
-		return;
-	}
-	ofstream outFile(pathName);
-	outFile << _data;
-	if (!outFile)
+	bool const overwrite = m_args.count(g_strOverwrite);
+	bool const keepUnchanged = m_args.count(g_argKeepUnchanged);
+
+	// A file created more than once replaces the earlier one, as if they were written one after another.
+	map<string, OutputFile*> filesByPath;
+	for (OutputFile& file: m_outputFiles)
 	{
-		serr() << "Could not write to file \"" << pathName << "\"." << endl;
-		m_error = true;
-		return;
+		auto [previous, inserted] = filesByPath.emplace(file.path, &file);
+		if (!inserted)
+		{
+			if (!overwrite)
+			{
+				file.skip = true;
+				file.error = "Refusing to overwrite existing file \"" + file.path + "\" (use --" + g_strOverwrite + " to force).";
+				continue;
+			}
+			previous->second->skip = true;
+			previous->second = &file;
+		}
+		if (m_args.count(g_argWatch))
+		{
+			// Only files whose contents changed are written again, so that tools watching
+			// the output directory are not triggered by every compilation.
+			file.hash = keccak256(file.data);
+			auto writtenFile = m_writtenFiles.find(file.path);
+			if (writtenFile != m_writtenFiles.end() && writtenFile->second == *file.hash)
+				file.skip = true;
+		}
 	}
+
+	util::ThreadPool pool(min<size_t>(m_args[g_argJobs].as<unsigned>(), m_outputFiles.size()));
+	pool.forEach(m_outputFiles, [&](OutputFile& _file) {
+		if (_file.skip)
+			return;
+		boost::system::error_code error;
+		if (fs::exists(_file.path, error))
+		{
+			if (
+				keepUnchanged &&
+				fs::file_size(_file.path, error) == _file.data.size() &&
+				!error &&
+				readFileAsString(_file.path) == _file.data
+			)
+			{
+				_file.upToDate = true;
+				return;
+			}
+			if (!overwrite && !m_writtenFiles.count(_file.path))
+			{
+				_file.error = "Refusing to overwrite existing file \"" + _file.path + "\" (use --" + g_strOverwrite + " to force).";
+				return;
+			}
+		}
+		ofstream outFile(_file.path, _file.binary ? ios::binary : ios::out);
+		outFile << _file.data;
+		if (outFile)
+			_file.upToDate = true;
+		else
+			_file.error = "Could not write to file \"" + _file.path + "\".";
+	});
+
+	for (OutputFile const& file: m_outputFiles)
+		if (file.error)
+		{
+			serr() << *file.error << endl;
+			m_error = true;
+		}
+		else if (file.upToDate && file.hash)
+			m_writtenFiles[file.path] = *file.hash;
+	m_outputFiles.clear();
 }
 
 void CommandLineInterface::createJson(string const& _fileName, string const& _json)
@@ -857,6 +1050,13 @@ General Information)").c_str(),
 			g_argErrorRecovery.c_str(),
 			"Enables additional parser error recovery."
 		)
+		(
+			g_argWatch.c_str(),
+			("Keep running after the compilation and compile again whenever one of the source files "
+			"changes. Only the analysis of the changed sources and the sources importing them is repeated "
+			"and only the files in --" + g_argOutputDir + " whose contents changed are written. "
+			"Combine with --" + g_argCacheDir + " to also reuse the bytecode of unchanged contracts.").c_str()
+		)
 	;
 	desc.add(inputOptions);
 
@@ -871,6 +1071,17 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_argKeepUnchanged.c_str(),
+			"Do not write the files whose contents are identical to the existing file, so that their "
+			"modification times are kept (used together with -o). Such files are not refused without --overwrite."
+		)
+		(
+			g_argLowMemory.c_str(),
+			("Release the assemblies, the IR and the other intermediate data of each contract and write "
+			"its files to --" + g_argOutputDir + " as soon as its outputs are complete, instead of keeping "
+			"them until the outputs of all contracts are complete.").c_str()
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<string>()->value_name("version")->default_value(EVMVersion{}.name()),
@@ -881,6 +1092,24 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			(g_argJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads during parsing and code generation. "
+			"Source files are parsed concurrently, "
+			"contracts that do not depend on each other's bytecode are processed concurrently "
+			"and the optimizers process sub-assemblies and Yul functions concurrently. "
+			"In linker mode, the binaries are linked concurrently. "
+			"In assembly modes, the input files are compiled concurrently. "
+			"The output does not depend on this setting."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Take the bytecode and IR of contracts that were compiled before with the same metadata "
+			"from the given directory instead of generating them, and store newly generated ones there. "
+			"Not used if assembly, gas estimates, generated sources or Ewasm are requested."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(boost::join(g_revertStringsArgs, ",")),
@@ -891,6 +1120,19 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_argTimePasses.c_str(),
+			"Print the wall time, the CPU time and the increase of the peak memory usage of each "
+			"phase of the compilation to standard error, for each contract. Nested phases, like the "
+			"steps of the optimizers, are listed after the phase containing them."
+		)
+		(
+			g_argTraceFile.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write a timeline of the phases of the compilation, including the contracts, the Yul objects "
+			"and the optimizer steps and the threads they ran on, to the given file in the Trace Event Format. "
+			"It can be viewed in chrome://tracing or Perfetto."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -901,10 +1143,18 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argServer.c_str(),
+			("Switch to compilation server mode, ignoring all options apart from --" + g_argServerSocket + ", "
+			"--" + g_argBasePath + " and --" + g_argAllowPaths + ". "
+			"Answers JSON-RPC 2.0 requests framed by \"Content-Length\" headers, read from standard input. "
+			"The method \"compile\" takes a Standard JSON input and returns the Standard JSON output. "
+			"The server keeps running until it receives a \"shutdown\" request.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
-			"and modify binaries in place.").c_str()
+			"and --" + g_argJobs + " and modify binaries in place.").c_str()
 		)
 		(
 			g_argAssemble.c_str(),
@@ -928,11 +1178,34 @@ General Information)").c_str(),
 			g_argImportAst.c_str(),
 			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
 			"Supported Inputs is the output of the --" + g_argStandardJSON + " or the one produced by "
-			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON).c_str()
+			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON + " or the files written by "
+			"--" + g_argAstBinary).c_str()
 		)
 	;
 	desc.add(alternativeInputModes);
 
+	po::options_description standardJsonModeOptions("Standard JSON Mode Options");
+	standardJsonModeOptions.add_options()
+		(
+			g_argBatch.c_str(),
+			("Read one Standard JSON input per line and write the outputs in the same order, one per line, "
+			"in --" + g_argStandardJSON + " mode. The inputs are compiled one after another by the same compiler, "
+			"which reuses its caches and the analysis of identical sources.").c_str()
+		)
+	;
+	desc.add(standardJsonModeOptions);
+
+	po::options_description serverModeOptions("Server Mode Options");
+	serverModeOptions.add_options()
+		(
+			g_argServerSocket.c_str(),
+			po::value<string>()->value_name("path"),
+			("Listen for connections on the unix domain socket at the given path instead of using "
+			"standard input and output in --" + g_argServer + " mode.").c_str()
+		)
+	;
+	desc.add(serverModeOptions);
+
 	po::options_description assemblyModeOptions("Assembly Mode Options");
 	assemblyModeOptions.add_options()
 		(
@@ -984,6 +1257,11 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(
+			g_argAstBinary.c_str(),
+			("AST of all source files in a compact binary format, which can be read by --" + g_argImportAst + ". "
+			"Requires --" + g_argOutputDir + ".").c_str()
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -1071,6 +1349,47 @@ General Information)").c_str(),
 			po::value<string>()->value_name("all,bmc,chc,none")->default_value("none"),
 			"Select model checker engine."
 		)
+		(
+			g_strModelCheckerIncremental.c_str(),
+			"Check the targets of a function in one scope of the BMC solvers, guarding every query "
+			"by an activation literal, so that the solvers keep what they learned between the queries."
+		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Check the verification targets of a function (BMC) or a source (CHC) "
+			"with this many solver instances concurrently. "
+			"Requires an SMT solver (Z3 or CVC4) linked into the binary."
+		)
+		(
+			g_strModelCheckerBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Set the wall-clock time of the whole model checker analysis in milliseconds. "
+			"The verification targets are checked cheapest first, the remaining time is "
+			"distributed among the remaining targets, and the targets that are left "
+			"when the time is used up are reported as not checked."
+		)
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the results of SMT queries in the given directory and reuse them "
+			"in later runs instead of querying the solvers (Z3, CVC4) again."
+		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Query the SMT solvers used by the BMC engine concurrently, take the first answer "
+			"and interrupt the other solvers. Only has an effect if more than one solver is available."
+		)
+		(
+			g_strModelCheckerSliceState.c_str(),
+			"Leave the state variables that are never read out of the CHC encoding. "
+			"Counterexamples do not show the values of these variables."
+		)
+		(
+			g_strModelCheckerNoCounterexamples.c_str(),
+			"Only report whether the CHC verification targets are safe, without extracting "
+			"and printing counterexamples, which requires another query for every unsafe target."
+		)
 		(
 			g_strModelCheckerTargets.c_str(),
 			po::value<string>()->value_name("default,constantCondition,underflow,overflow,divByZero,balance,assert,popEmptyArray,outOfBounds")->default_value("default"),
@@ -1166,6 +1485,12 @@ General Information)").c_str(),
 		m_revertStrings = *revertStrings;
 	}
 
+	if (m_args[g_argJobs].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_argJobs << ": must be at least 1." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argCombinedJson))
 	{
 		vector<string> requests;
@@ -1223,6 +1548,7 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_argServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1236,6 +1562,42 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_argWatch) && countEnabledOptions(exclusiveModes) > 0)
+	{
+		serr() << "Option --" << g_argWatch << " is only valid when compiling source files." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argServerSocket) && !m_args.count(g_argServer))
+	{
+		serr() << "Option --" << g_argServerSocket << " is only valid in --" << g_argServer << " mode." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argBatch) && !m_args.count(g_argStandardJSON))
+	{
+		serr() << "Option --" << g_argBatch << " is only valid in --" << g_argStandardJSON << " mode." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argServer))
+	{
+		CompilationServer server(m_fileReader.reader());
+		if (!m_args.count(g_argServerSocket))
+		{
+			server.serve(cin, sout());
+			return true;
+		}
+
+		string error;
+		if (!server.serveSocket(m_args[g_argServerSocket].as<string>(), error))
+		{
+			serr() << "Could not listen on socket: " << error << endl;
+			return false;
+		}
+		return true;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1249,6 +1611,23 @@ bool CommandLineInterface::processInput()
 			serr() << "If --" << g_argStandardJSON << " is used, only zero or one input files are supported." << endl;
 			return false;
 		}
+		if (m_args.count(g_argBatch))
+		{
+			CompilationServer server(m_fileReader.reader());
+			if (jsonFile.empty())
+				server.serveBatch(cin, sout());
+			else
+			{
+				ifstream inputStream(jsonFile, ios::binary);
+				if (!inputStream)
+				{
+					serr() << "File not found: " << jsonFile << endl;
+					return false;
+				}
+				server.serveBatch(inputStream, sout());
+			}
+			return true;
+		}
 		string input;
 		if (jsonFile.empty())
 			input = readStandardInput();
@@ -1265,13 +1644,20 @@ bool CommandLineInterface::processInput()
 			}
 		}
 		StandardCompiler compiler(m_fileReader.reader());
-		sout() << compiler.compile(std::move(input)) << endl;
+		compiler.compile(input, sout());
+		sout() << endl;
 		return true;
 	}
 
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
+	if (m_args.count(g_argWatch) && m_fileReader.sourceCodes().count(g_stdinFileName))
+	{
+		serr() << "Option --" << g_argWatch << " cannot be used with the standard input." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argLibraries))
 		for (string const& library: m_args[g_argLibraries].as<vector<string>>())
 			if (!parseLibraryOption(library))
@@ -1469,64 +1855,123 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
-	m_compiler = make_unique<CompilerStack>(m_fileReader.reader());
+	if (m_args.count(g_argModelCheckerBudget))
+		m_modelCheckerSettings.budget = m_args[g_argModelCheckerBudget].as<unsigned>();
 
-	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	if (m_args.count(g_argModelCheckerRaceSolvers))
+		m_modelCheckerSettings.raceSolvers = true;
 
-	try
+	if (m_args.count(g_argModelCheckerIncremental))
+		m_modelCheckerSettings.incremental = true;
+
+	if (m_args.count(g_argModelCheckerSliceState))
+		m_modelCheckerSettings.sliceState = true;
+
+	if (m_args.count(g_argModelCheckerNoCounterexamples))
+		m_modelCheckerSettings.counterexamples = false;
+
+	if (m_args.count(g_argModelCheckerCache))
+		m_modelCheckerSettings.queryCacheDirectory = m_args[g_argModelCheckerCache].as<string>();
+
+	if (m_args.count(g_argModelCheckerJobs))
 	{
-		if (m_args.count(g_argMetadataLiteral) > 0)
-			m_compiler->useMetadataLiteralSources(true);
-		if (m_args.count(g_argMetadataHash))
-			m_compiler->setMetadataHash(m_metadataHash);
-		if (
-			m_args.count(g_argModelCheckerContracts) ||
-			m_args.count(g_argModelCheckerEngine) ||
-			m_args.count(g_argModelCheckerTargets) ||
-			m_args.count(g_argModelCheckerTimeout)
-		)
-			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
-		if (m_args.count(g_argInputFile))
-			m_compiler->setRemappings(m_remappings);
-
-		if (m_args.count(g_argLibraries))
-			m_compiler->setLibraries(m_libraries);
-		if (m_args.count(g_argExperimentalViaIR))
-			m_compiler->setViaIR(true);
-		m_compiler->setEVMVersion(m_evmVersion);
-		m_compiler->setRevertStringBehaviour(m_revertStrings);
-		// TODO: Perhaps we should not compile unless requested
-
-		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
-		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
-
-		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
-		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
-		if (m_args.count(g_strNoOptimizeYul))
-			settings.runYulOptimiser = false;
-		if (m_args.count(g_strYulOptimizations))
+		m_modelCheckerSettings.jobs = m_args[g_argModelCheckerJobs].as<unsigned>();
+		if (m_modelCheckerSettings.jobs == 0)
 		{
-			if (!settings.runYulOptimiser)
-			{
-				serr() << "--" << g_strYulOptimizations << " is invalid if Yul optimizer is disabled" << endl;
-				return false;
-			}
+			serr() << "Invalid option for --" << g_argModelCheckerJobs << ": must be at least 1." << endl;
+			return false;
+		}
+	}
 
-			try
-			{
-				yul::OptimiserSuite::validateSequence(m_args[g_strYulOptimizations].as<string>());
-			}
-			catch (yul::OptimizerException const& _exception)
-			{
-				serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizations << ": " << _exception.what() << endl;
-				return false;
-			}
+	if (!createCompiler())
+		return false;
 
-			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
+	if (m_args.count(g_argWatch))
+		// Compiled in "actOnInput" phase, which keeps watching the sources.
+		return true;
+
+	return compile();
+}
+
+bool CommandLineInterface::createCompiler()
+{
+	m_compiler = make_unique<CompilerStack>(m_fileReader.reader());
+
+	if (m_args.count(g_argMetadataLiteral) > 0)
+		m_compiler->useMetadataLiteralSources(true);
+	if (m_args.count(g_argMetadataHash))
+		m_compiler->setMetadataHash(m_metadataHash);
+	if (
+		m_args.count(g_argModelCheckerBudget) ||
+		m_args.count(g_argModelCheckerCache) ||
+		m_args.count(g_argModelCheckerContracts) ||
+		m_args.count(g_argModelCheckerEngine) ||
+		m_args.count(g_argModelCheckerIncremental) ||
+		m_args.count(g_argModelCheckerJobs) ||
+		m_args.count(g_argModelCheckerNoCounterexamples) ||
+		m_args.count(g_argModelCheckerRaceSolvers) ||
+		m_args.count(g_argModelCheckerSliceState) ||
+		m_args.count(g_argModelCheckerTargets) ||
+		m_args.count(g_argModelCheckerTimeout)
+	)
+		m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
+	if (m_args.count(g_argInputFile))
+		m_compiler->setRemappings(m_remappings);
+
+	if (m_args.count(g_argLibraries))
+		m_compiler->setLibraries(m_libraries);
+	if (m_args.count(g_argExperimentalViaIR))
+		m_compiler->setViaIR(true);
+	m_compiler->setEVMVersion(m_evmVersion);
+	m_compiler->setRevertStringBehaviour(m_revertStrings);
+	m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+	if (m_args.count(g_argTimePasses) || m_args.count(g_argTraceFile))
+		m_compiler->enableProfiling(true, m_args.count(g_argTraceFile));
+	if (m_args.count(g_argCacheDir) && canUseArtifactCache(m_args))
+		m_compiler->setArtifactCache(make_shared<ArtifactCache>(m_args[g_argCacheDir].as<string>()));
+	// TODO: Perhaps we should not compile unless requested
+
+	m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized), m_args.count(g_argIROptimized));
+	m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
+
+	OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+	settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
+	if (m_args.count(g_strNoOptimizeYul))
+		settings.runYulOptimiser = false;
+	if (m_args.count(g_strYulOptimizations))
+	{
+		if (!settings.runYulOptimiser)
+		{
+			serr() << "--" << g_strYulOptimizations << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
 		}
-		settings.optimizeStackAllocation = settings.runYulOptimiser;
-		m_compiler->setOptimiserSettings(settings);
 
+		try
+		{
+			yul::OptimiserSuite::validateSequence(m_args[g_strYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizations << ": " << _exception.what() << endl;
+			return false;
+		}
+
+		settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
+	}
+	settings.optimizeStackAllocation = settings.runYulOptimiser;
+	m_compiler->setOptimiserSettings(settings);
+
+	if (m_args.count(g_argWatch))
+		m_compiler->setIncrementalAnalysis();
+	return true;
+}
+
+bool CommandLineInterface::compile()
+{
+	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+
+	try
+	{
 		if (m_args.count(g_argImportAst))
 		{
 			try
@@ -1561,6 +2006,20 @@ bool CommandLineInterface::processInput()
 			formatter.printErrorInformation(*error);
 		}
 
+		if (m_args.count(g_argTimePasses))
+			printProfile(*m_compiler->profiler());
+		if (m_args.count(g_argTraceFile))
+		{
+			string const traceFile = m_args[g_argTraceFile].as<string>();
+			ofstream outFile(traceFile);
+			outFile << jsonCompactPrint(StandardCompiler::formatTrace(*m_compiler->profiler()));
+			if (!outFile)
+			{
+				serr() << "Could not write to file \"" << traceFile << "\"." << endl;
+				m_error = true;
+			}
+		}
+
 		if (!successful)
 		{
 			if (m_args.count(g_argErrorRecovery))
@@ -1725,6 +2184,24 @@ void CommandLineInterface::handleCombinedJSON()
 
 void CommandLineInterface::handleAst()
 {
+	if (m_args.count(g_argAstBinary))
+	{
+		if (!m_args.count(g_argOutputDir))
+		{
+			serr() << "--" << g_argAstBinary << " requires --" << g_argOutputDir << "." << endl;
+			m_error = true;
+		}
+		else
+			for (auto const& sourceCode: m_fileReader.sourceCodes())
+			{
+				Json::Value ast = ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).toJson(
+					m_compiler->ast(sourceCode.first)
+				);
+				boost::filesystem::path path(sourceCode.first);
+				createFile(path.filename().string() + "_binary.ast", ASTBinary::encode(ast), true);
+			}
+	}
+
 	if (!m_args.count(g_argAstCompactJson))
 		return;
 
@@ -1757,68 +2234,114 @@ void CommandLineInterface::handleAst()
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
 		writeLinkedFiles();
+	else if (m_args.count(g_argWatch))
+		watch();
 	else
 		outputCompilationResults();
 	return !m_error;
 }
 
-bool CommandLineInterface::link()
+void CommandLineInterface::watch()
 {
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
-	for (auto const& library: m_libraries)
-	{
-		string const& name = library.first;
-		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
-		// This leaves 36 characters for the library identifier. The identifier used to
-		// be just the cropped or '_'-padded library name, but this changed to
-		// the cropped hex representation of the hash of the library name.
-		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+	// Input files given on the commandline, the other sources are read again via the callback.
+	FileReader::PathMap const inputFiles = m_fileReader.sourcePaths();
+	// Imported files that did not change are not read again.
+	m_fileReader.setCacheContents(true);
+	FileWatcher watcher;
+	while (true)
+	{
+		if (compile())
+			outputCompilationResults();
+		sout().flush();
+
+		// Files that do not belong to the sources cannot affect the compilation, unless it failed
+		// because of an import of a file that did not exist.
+		FileWatcher::PathSet sourceFiles;
+		map<boost::filesystem::path, SourceUnitName> sourceUnitNames;
+		for (auto const& [sourceUnitName, path]: m_fileReader.sourcePaths())
+		{
+			sourceFiles.insert(path);
+			sourceUnitNames[path] = sourceUnitName;
+		}
+		watcher.watch(
+			sourceFiles,
+			m_compiler->compilationSuccessful() ? FileWatcher::PathSet{} : m_fileReader.allowedDirectories()
+		);
+		serr(false) << endl << "Watching " << sourceFiles.size() << " source files for changes." << endl;
 
-		string replacement = "__";
-		for (size_t i = 0; i < placeholderSize - 4; ++i)
-			replacement.push_back(i < name.size() ? name[i] : '_');
-		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		auto sourcesChanged = [&](FileWatcher::PathSet const& _changes) {
+			for (auto const& path: _changes)
+			{
+				auto sourceUnitName = sourceUnitNames.find(path);
+				if (sourceUnitName == sourceUnitNames.end())
+					return true;
+				try
+				{
+					if (readFileAsString(path.string()) != m_fileReader.sourceCode(sourceUnitName->second))
+						return true;
+				}
+				catch (FileNotFound const&)
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+		FileWatcher::PathSet changes;
+		do
+			changes = watcher.waitForChanges();
+		while (!sourcesChanged(changes));
+		m_fileReader.invalidateContents(changes);
+
+		m_fileReader.setSources({});
+		for (auto const& [sourceUnitName, path]: inputFiles)
+			try
+			{
+				m_fileReader.setSource(sourceUnitName, readFileAsString(path.string()));
+			}
+			catch (FileNotFound const&)
+			{
+				serr() << path << " is not found. Skipping." << endl;
+			}
+		m_compiler->reset(true);
+		m_error = false;
+		serr(false) << "Compiling..." << endl;
 	}
+}
 
+bool CommandLineInterface::link()
+{
 	FileReader::StringMap sourceCodes = m_fileReader.sourceCodes();
+	vector<string*> objects;
+	for (auto& src: sourceCodes)
+		objects.push_back(&src.second);
+	vector<evmasm::LinkerObject::HexLinkingResult> results = evmasm::LinkerObject::linkHex(
+		objects,
+		m_libraries,
+		m_args[g_argJobs].as<unsigned>()
+	);
+
+	int const placeholderSize = 40; // 20 bytes or 40 hex characters
+	size_t index = 0;
 	for (auto& src: sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		evmasm::LinkerObject::HexLinkingResult const& result = results[index++];
+		for (auto const& [position, placeholder]: result.unresolvedReferences)
+			serr() << "Reference \"" << placeholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
+		if (result.invalidReference)
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
-			)
-			{
-				serr() << "Error in binary object file " << src.first << " at position " << (it - src.second.begin()) << endl;
-				serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
-				return false;
-			}
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
-			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+			auto it = src.second.begin() + static_cast<ptrdiff_t>(*result.invalidReference);
+			auto end = src.second.end();
+			serr() << "Error in binary object file " << src.first << " at position " << *result.invalidReference << endl;
+			serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
+			return false;
 		}
+
 		// Remove hints for resolved libraries.
 		for (auto const& library: m_libraries)
 			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
@@ -1874,45 +2397,81 @@ bool CommandLineInterface::assemble(
 {
 	solAssert(_optimize || !_yulOptimiserSteps.has_value(), "");
 
-	bool successful = true;
-	map<string, yul::AssemblyStack> assemblyStacks;
-	for (auto const& src: m_fileReader.sourceCodes())
-	{
-		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
-		if (_yulOptimiserSteps.has_value())
-			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+	/// The state of the compilation of a single source.
+	struct SourceAssembly
+	{
+		yul::AssemblyStack stack;
+		bool analysisSuccessful = false;
+		/// Message of an exception thrown during parsing or optimisation.
+		optional<string> parsingException;
+		string prettyPrinted;
+		/// Message of an exception thrown during the translation to Ewasm.
+		optional<string> translationException;
+		optional<string> translated;
+		/// Message of an exception thrown during code generation or linking.
+		optional<string> assemblingException;
+		yul::MachineAssemblyObject object;
+	};
 
-		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+	/// Runs @a _work and @returns the message of the exception it throws, if any.
+	auto exceptionMessage = [](string const& _activity, auto const& _work) -> optional<string> {
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
-				successful = false;
-			else
-				stack.optimize();
+			_work();
 		}
 		catch (Exception const& _exception)
 		{
-			serr() << "Exception in assembler: " << boost::diagnostic_information(_exception) << endl;
-			return false;
+			return "Exception " + _activity + ": " + boost::diagnostic_information(_exception);
 		}
 		catch (std::exception const& _e)
 		{
-			serr() <<
-				"Unknown exception during compilation" <<
-				(_e.what() ? ": " + string(_e.what()) : ".") <<
-				endl;
-			return false;
+			return "Unknown exception during compilation" + (_e.what() ? ": " + string(_e.what()) : string("."));
 		}
 		catch (...)
 		{
-			serr() << "Unknown exception in assembler." << endl;
-			return false;
+			return "Unknown exception " + _activity + ".";
 		}
+		return nullopt;
+	};
+
+	// The sources are independent of each other and are compiled concurrently,
+	// but their output is printed in the order of the sources, as if compiled one after another.
+	size_t const jobs = m_args[g_argJobs].as<unsigned>();
+	size_t const sourceCount = m_fileReader.sourceCodes().size();
+	util::ThreadPool pool(min(jobs, sourceCount));
+
+	bool successful = true;
+	map<string, SourceAssembly> assemblies;
+	for (auto const& src: m_fileReader.sourceCodes())
+	{
+		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+		if (_yulOptimiserSteps.has_value())
+			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+
+		auto& stack = assemblies[src.first].stack = yul::AssemblyStack(m_evmVersion, _language, settings);
+		stack.setParallelism(max<size_t>(1, jobs / max<size_t>(1, sourceCount)));
 	}
 
-	for (auto const& sourceAndStack: assemblyStacks)
+	pool.forEach(assemblies, [&](auto& _sourceAndAssembly) {
+		string const& sourceName = _sourceAndAssembly.first;
+		SourceAssembly& assembly = _sourceAndAssembly.second;
+		assembly.parsingException = exceptionMessage("in assembler", [&]() {
+			assembly.analysisSuccessful = assembly.stack.parseAndAnalyze(sourceName, m_fileReader.sourceCodes().at(sourceName));
+			if (assembly.analysisSuccessful)
+				assembly.stack.optimize();
+		});
+	});
+
+	for (auto const& [sourceName, assembly]: assemblies)
+		if (assembly.parsingException)
+		{
+			serr() << *assembly.parsingException << endl;
+			return false;
+		}
+
+	for (auto const& sourceAndAssembly: assemblies)
 	{
-		auto const& stack = sourceAndStack.second;
+		auto const& stack = sourceAndAssembly.second.stack;
 		SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
 
 		for (auto const& error: stack.errors())
@@ -1920,79 +2479,64 @@ bool CommandLineInterface::assemble(
 			g_hasOutput = true;
 			formatter.printErrorInformation(*error);
 		}
-		if (!Error::containsOnlyWarnings(stack.errors()))
+		if (!sourceAndAssembly.second.analysisSuccessful || !Error::containsOnlyWarnings(stack.errors()))
 			successful = false;
 	}
 
 	if (!successful)
 		return false;
 
-	for (auto const& src: m_fileReader.sourceCodes())
-	{
-		string machine =
-			_targetMachine == yul::AssemblyStack::Machine::EVM ? "EVM" :
-			"Ewasm";
-		sout() << endl << "======= " << src.first << " (" << machine << ") =======" << endl;
-
-		yul::AssemblyStack& stack = assemblyStacks[src.first];
+	pool.forEach(assemblies, [&](auto& _sourceAndAssembly) {
+		SourceAssembly& assembly = _sourceAndAssembly.second;
+		yul::AssemblyStack& stack = assembly.stack;
 
-		sout() << endl << "Pretty printed source:" << endl;
-		sout() << stack.print() << endl;
+		assembly.prettyPrinted = stack.print();
 
 		if (_language != yul::AssemblyStack::Language::Ewasm && _targetMachine == yul::AssemblyStack::Machine::Ewasm)
 		{
-			try
-			{
+			assembly.translationException = exceptionMessage("in assembler", [&]() {
 				stack.translate(yul::AssemblyStack::Language::Ewasm);
 				stack.optimize();
-			}
-			catch (Exception const& _exception)
-			{
-				serr() << "Exception in assembler: " << boost::diagnostic_information(_exception) << endl;
-				return false;
-			}
-			catch (std::exception const& _e)
-			{
-				serr() <<
-					"Unknown exception during compilation" <<
-					(_e.what() ? ": " + string(_e.what()) : ".") <<
-					endl;
-				return false;
-			}
-			catch (...)
-			{
-				serr() << "Unknown exception in assembler." << endl;
-				return false;
-			}
-
-			sout() << endl << "==========================" << endl;
-			sout() << endl << "Translated source:" << endl;
-			sout() << stack.print() << endl;
+			});
+			if (assembly.translationException)
+				return;
+			assembly.translated = stack.print();
 		}
 
-		yul::MachineAssemblyObject object;
-		try
-		{
-			object = stack.assemble(_targetMachine);
-			object.bytecode->link(m_libraries);
-		}
-		catch (Exception const& _exception)
+		assembly.assemblingException = exceptionMessage("while assembling", [&]() {
+			assembly.object = stack.assemble(_targetMachine);
+			assembly.object.bytecode->link(m_libraries);
+		});
+	});
+
+	for (auto const& [sourceName, assembly]: assemblies)
+	{
+		string machine =
+			_targetMachine == yul::AssemblyStack::Machine::EVM ? "EVM" :
+			"Ewasm";
+		sout() << endl << "======= " << sourceName << " (" << machine << ") =======" << endl;
+
+		sout() << endl << "Pretty printed source:" << endl;
+		sout() << assembly.prettyPrinted << endl;
+
+		if (assembly.translationException)
 		{
-			serr() << "Exception while assembling: " << boost::diagnostic_information(_exception) << endl;
+			serr() << *assembly.translationException << endl;
 			return false;
 		}
-		catch (std::exception const& _e)
+		if (assembly.translated)
 		{
-			serr() << "Unknown exception during compilation" << (
-				_e.what() ? ": " + string(_e.what()) : "."
-			) << endl;
-			return false;
+			sout() << endl << "==========================" << endl;
+			sout() << endl << "Translated source:" << endl;
+			sout() << *assembly.translated << endl;
 		}
-		catch (...)
+
+		if (assembly.assemblingException)
 		{
-			serr() << "Unknown exception while assembling." << endl;
+			serr() << *assembly.assemblingException << endl;
 			return false;
 		}
+		yul::MachineAssemblyObject const& object = assembly.object;
 
 		sout() << endl << "Binary representation:" << endl;
 		if (object.bytecode)
@@ -2022,6 +2566,7 @@ void CommandLineInterface::outputCompilationResults()
 		m_stopAfter == CompilerStack::State::CompilationSuccessful
 	)
 	{
+		writeOutputFiles();
 		serr() << endl << "Compilation halted after AST generation due to errors." << endl;
 		return;
 	}
@@ -2064,8 +2609,16 @@ void CommandLineInterface::outputCompilationResults()
 		handleStorageLayout(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
+
+		if (m_args.count(g_argLowMemory))
+		{
+			m_compiler->releaseContract(contract);
+			writeOutputFiles();
+		}
 	} // end of contracts iteration
 
+	writeOutputFiles();
+
 	if (!g_hasOutput)
 	{
 		if (m_args.count(g_argOutputDir))
@@ -66,6 +66,15 @@ private:
 		std::optional<std::string> _yulOptimiserSteps = std::nullopt
 	);
 
+	/// Creates @a m_compiler and applies the settings given on the commandline.
+	/// @returns false if the settings are invalid.
+	bool createCompiler();
+	/// Compiles the sources in @a m_fileReader and prints the errors.
+	/// @returns false if the compilation failed and no outputs are to be generated.
+	bool compile();
+	/// Compiles and generates the outputs again whenever a source file changes. Does not return.
+	void watch();
+
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
@@ -95,10 +104,14 @@ private:
 	/// or standard-json output
 	std::map<std::string, Json::Value> parseAstFromInput();
 
-	/// Create a file in the given directory
+	/// Create a file in the given directory. The file is written by @a writeOutputFiles.
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary if true, the file is written without newline conversion
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
+	/// Writes the files created since the last call, concurrently if --jobs is greater than one,
+	/// and reports the files that could not be written in the order they were created.
+	void writeOutputFiles();
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -115,6 +128,23 @@ private:
 	bool m_onlyLink = false;
 
 	FileReader m_fileReader;
+	/// A file in the output directory created by @a createFile and not written yet.
+	struct OutputFile
+	{
+		std::string path;
+		std::string data;
+		bool binary = false;
+		/// Hash of @a data, only computed in watch mode.
+		std::optional<util::h256> hash;
+		/// If true, the file is replaced by a later one or did not change since it was last written.
+		bool skip = false;
+		/// True if the file on disk has the contents @a data after writing.
+		bool upToDate = false;
+		std::optional<std::string> error;
+	};
+	std::vector<OutputFile> m_outputFiles;
+	/// Hashes of the contents of the files written to the output directory in watch mode.
+	std::map<std::string, util::h256> m_writtenFiles;
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
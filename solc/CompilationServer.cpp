@@ -0,0 +1,238 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <solc/CompilationServer.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#if !defined(_WIN32)
+#include <boost/asio/local/stream_protocol.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <istream>
+#include <ostream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Number of distinct Yul identifiers kept between requests before they are cleared.
+size_t constexpr c_yulStringRepositoryLimit = 1000000;
+
+// Error codes defined by JSON-RPC 2.0.
+int constexpr c_parseError = -32700;
+int constexpr c_invalidRequest = -32600;
+int constexpr c_methodNotFound = -32601;
+int constexpr c_invalidParams = -32602;
+
+}
+
+CompilationServer::CompilationServer(ReadCallback::Callback _readFile):
+	m_compiler(move(_readFile))
+{
+	m_compiler.setYulStringRepositoryLimit(c_yulStringRepositoryLimit);
+	m_compiler.setIncrementalAnalysis(true);
+}
+
+void CompilationServer::serve(istream& _input, ostream& _output)
+{
+	while (!m_shutdownRequested)
+	{
+		optional<string> message;
+		try
+		{
+			message = readMessage(_input);
+		}
+		catch (InvalidMessageHeader const& _exception)
+		{
+			// Without a valid header the next message cannot be found, so stop here.
+			string const* comment = boost::get_error_info<errinfo_comment>(_exception);
+			writeMessage(_output, jsonCompactPrint(errorResponse(Json::nullValue, c_parseError, comment ? *comment : "")));
+			return;
+		}
+		if (!message)
+			return;
+
+		Json::Value request;
+		string errors;
+		optional<Json::Value> response;
+		if (jsonParseStrict(*message, request, &errors))
+			response = handle(request);
+		else
+			response = errorResponse(Json::nullValue, c_parseError, "Parse error: " + errors);
+		if (response)
+			writeMessage(_output, jsonCompactPrint(*response));
+	}
+}
+
+bool CompilationServer::serveSocket(string const& _path, string& _error)
+{
+#if !defined(_WIN32)
+	namespace local = boost::asio::local;
+	try
+	{
+		boost::asio::io_context context;
+		// Remove a socket left behind by a previous server, but never any other kind of file.
+		struct stat status;
+		if (::stat(_path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+			::unlink(_path.c_str());
+		local::stream_protocol::acceptor acceptor(context, local::stream_protocol::endpoint(_path));
+		while (!m_shutdownRequested)
+		{
+			local::stream_protocol::iostream stream;
+			acceptor.accept(stream.socket());
+			serve(stream, stream);
+		}
+		::unlink(_path.c_str());
+		return true;
+	}
+	catch (boost::system::system_error const& _exception)
+	{
+		_error = _exception.what();
+		return false;
+	}
+#else
+	(void)_path;
+	_error = "Unix domain sockets are not supported on this platform.";
+	return false;
+#endif
+}
+
+void CompilationServer::serveBatch(istream& _input, ostream& _output)
+{
+	string line;
+	while (getline(_input, line))
+	{
+		boost::trim_right_if(line, boost::is_any_of("\r"));
+		if (boost::all(line, boost::is_space()))
+			continue;
+		m_compiler.compile(line, _output);
+		// Flush, so that the output of each input is available as soon as it is compiled.
+		_output << endl;
+	}
+}
+
+optional<Json::Value> CompilationServer::handle(Json::Value const& _request)
+{
+	Json::Value id = _request.isObject() && _request.isMember("id") ? _request["id"] : Json::nullValue;
+	if (
+		!_request.isObject() ||
+		_request["jsonrpc"] != "2.0" ||
+		!_request["method"].isString() ||
+		!(id.isNull() || id.isString() || id.isIntegral())
+	)
+		return errorResponse(id, c_invalidRequest, "Invalid request.");
+
+	bool const isNotification = !_request.isMember("id");
+	string const method = _request["method"].asString();
+	Json::Value const& params = _request["params"];
+	Json::Value result;
+	if (method == "compile")
+	{
+		if (!params.isObject())
+		{
+			if (isNotification)
+				return nullopt;
+			return errorResponse(id, c_invalidParams, "The parameters of \"compile\" have to be a Standard JSON input object.");
+		}
+		result = m_compiler.compile(params);
+	}
+	else if (method == "version")
+	{
+		result["version"] = VersionString;
+		result["versionNumber"] = VersionNumber;
+	}
+	else if (method == "shutdown")
+		m_shutdownRequested = true;
+	else if (!isNotification)
+		return errorResponse(id, c_methodNotFound, "Method not found: " + method);
+
+	// Notifications do not receive a response.
+	if (isNotification)
+		return nullopt;
+
+	Json::Value response;
+	response["jsonrpc"] = "2.0";
+	response["id"] = id;
+	response["result"] = move(result);
+	return response;
+}
+
+optional<string> CompilationServer::readMessage(istream& _input)
+{
+	optional<size_t> contentLength;
+	string line;
+	while (getline(_input, line))
+	{
+		boost::trim_right_if(line, boost::is_any_of("\r"));
+		if (line.empty())
+		{
+			if (!contentLength)
+				// Tolerate empty lines between messages.
+				continue;
+			break;
+		}
+
+		string::size_type colon = line.find(':');
+		if (colon == string::npos)
+			BOOST_THROW_EXCEPTION(InvalidMessageHeader() << errinfo_comment("Invalid header line: " + line));
+		string name = boost::to_lower_copy(boost::trim_copy(line.substr(0, colon)));
+		string value = boost::trim_copy(line.substr(colon + 1));
+		if (name == "content-length")
+		{
+			if (value.empty() || value.find_first_not_of("0123456789") != string::npos)
+				BOOST_THROW_EXCEPTION(InvalidMessageHeader() << errinfo_comment("Invalid Content-Length: " + value));
+			contentLength = stoul(value);
+		}
+	}
+	if (!contentLength)
+	{
+		if (_input.eof())
+			return nullopt;
+		BOOST_THROW_EXCEPTION(InvalidMessageHeader() << errinfo_comment("Missing Content-Length header."));
+	}
+
+	string content(*contentLength, '\0');
+	if (!_input.read(content.data(), static_cast<streamsize>(*contentLength)))
+		BOOST_THROW_EXCEPTION(InvalidMessageHeader() << errinfo_comment("Message shorter than its Content-Length."));
+	return content;
+}
+
+void CompilationServer::writeMessage(ostream& _output, string const& _message)
+{
+	_output << "Content-Length: " << _message.size() << "\r\n\r\n" << _message << flush;
+}
+
+Json::Value CompilationServer::errorResponse(Json::Value const& _id, int _code, string const& _message)
+{
+	Json::Value response;
+	response["jsonrpc"] = "2.0";
+	response["id"] = _id;
+	response["error"]["code"] = _code;
+	response["error"]["message"] = _message;
+	return response;
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Long-running compilation server answering JSON-RPC requests.
+ */
+#pragma once
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libsolutil/Exceptions.h>
+
+#include <json/json.h>
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidMessageHeader);
+
+/**
+ * Compilation server that keeps a single StandardCompiler alive across requests, so that
+ * per-process work (dialects, optimiser rule tables, interned identifiers) is only done once.
+ *
+ * Requests and responses are JSON-RPC 2.0 messages, each preceded by a
+ * "Content-Length: <bytes>" header and an empty line, as in the language server protocol.
+ * Supported methods:
+ *  - "compile": params is a Standard JSON input, result is the Standard JSON output.
+ *  - "version": result is an object with the compiler version.
+ *  - "shutdown": result is null, the server stops after replying.
+ *
+ * Alternatively, it answers Standard JSON inputs without JSON-RPC, one per line.
+ */
+class CompilationServer
+{
+public:
+	explicit CompilationServer(ReadCallback::Callback _readFile);
+
+	/// Answers requests read from @a _input on @a _output until the input ends
+	/// or a shutdown request has been answered.
+	void serve(std::istream& _input, std::ostream& _output);
+	/// Listens on the unix domain socket at @a _path and serves one connection after another
+	/// until a shutdown request has been answered.
+	/// @returns false and sets @a _error if the socket could not be created.
+	bool serveSocket(std::string const& _path, std::string& _error);
+	/// Compiles each non-empty line read from @a _input as a Standard JSON input and writes
+	/// the outputs to @a _output in the same order, one per line, until the input ends.
+	void serveBatch(std::istream& _input, std::ostream& _output);
+
+	/// @returns the response to @a _request or nullopt if @a _request is a notification.
+	std::optional<Json::Value> handle(Json::Value const& _request);
+
+	/// Reads one message from @a _input.
+	/// @returns nullopt at the end of the input.
+	/// @throws InvalidMessageHeader if the header is malformed or the message is truncated.
+	static std::optional<std::string> readMessage(std::istream& _input);
+	static void writeMessage(std::ostream& _output, std::string const& _message);
+
+private:
+	static Json::Value errorResponse(Json::Value const& _id, int _code, std::string const& _message);
+
+	StandardCompiler m_compiler;
+	bool m_shutdownRequested = false;
+};
+
+}
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <solc/FileWatcher.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <range/v3/view/map.hpp>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include <thread>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Interval between two checks of the modification times if inotify is not used.
+chrono::milliseconds const pollingInterval{250};
+
+}
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+	m_notificationDescriptor = inotify_init1(IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+	if (m_notificationDescriptor >= 0)
+		close(m_notificationDescriptor);
+#endif
+}
+
+void FileWatcher::watch(PathSet _files, PathSet _directories)
+{
+	m_files = move(_files);
+	m_directories = move(_directories);
+
+#if defined(__linux__)
+	if (m_notificationDescriptor < 0)
+		return;
+
+	for (int watchDescriptor: m_notificationWatches | ranges::views::keys)
+		inotify_rm_watch(m_notificationDescriptor, watchDescriptor);
+	m_notificationWatches.clear();
+
+	PathSet directories = m_directories;
+	for (fs::path const& file: m_files)
+		directories.insert(file.parent_path());
+	for (fs::path const& directory: directories)
+	{
+		int watchDescriptor = inotify_add_watch(
+			m_notificationDescriptor,
+			directory.c_str(),
+			IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+		);
+		if (watchDescriptor >= 0)
+			m_notificationWatches[watchDescriptor] = directory;
+	}
+#endif
+}
+
+FileWatcher::PathSet FileWatcher::waitForChanges(chrono::milliseconds _settleTime)
+{
+	if (m_notificationDescriptor >= 0)
+		return waitForNotifications(_settleTime);
+	else
+		return pollModificationTimes(_settleTime);
+}
+
+bool FileWatcher::watched(fs::path const& _path) const
+{
+	return m_files.count(_path) || m_directories.count(_path.parent_path());
+}
+
+FileWatcher::PathSet FileWatcher::waitForNotifications([[maybe_unused]] chrono::milliseconds _settleTime)
+{
+	PathSet changes;
+#if defined(__linux__)
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		pollfd descriptor{m_notificationDescriptor, POLLIN, 0};
+		int const ready = poll(&descriptor, 1, changes.empty() ? -1 : static_cast<int>(_settleTime.count()));
+		if (ready == 0)
+			break;
+		ssize_t const length = ready > 0 ? read(m_notificationDescriptor, buffer, sizeof(buffer)) : -1;
+		if (length < 0)
+		{
+			if (errno == EINTR || errno == EAGAIN)
+				continue;
+			// Reading the notifications failed, continue by polling the modification times.
+			close(m_notificationDescriptor);
+			m_notificationDescriptor = -1;
+			m_notificationWatches.clear();
+			return changes.empty() ? pollModificationTimes(_settleTime) : changes;
+		}
+
+		for (char const* position = buffer; position < buffer + length;)
+		{
+			auto const& event = *reinterpret_cast<inotify_event const*>(position);
+			position += sizeof(inotify_event) + event.len;
+			if (event.mask & IN_Q_OVERFLOW)
+				// Some notifications were lost, so any of the files could have changed.
+				changes.insert(m_files.begin(), m_files.end());
+			auto directory = m_notificationWatches.find(event.wd);
+			if (event.len == 0 || directory == m_notificationWatches.end())
+				continue;
+			fs::path path = directory->second / event.name;
+			if (watched(path))
+				changes.insert(move(path));
+		}
+	}
+#endif
+	return changes;
+}
+
+FileWatcher::PathSet FileWatcher::pollModificationTimes(chrono::milliseconds _settleTime)
+{
+	PathSet changes;
+	auto previousTimes = modificationTimes();
+	while (true)
+	{
+		this_thread::sleep_for(changes.empty() ? pollingInterval : _settleTime);
+		auto times = modificationTimes();
+		bool changed = false;
+		for (auto const& [path, time]: times)
+		{
+			auto previous = previousTimes.find(path);
+			if (previous == previousTimes.end() || previous->second != time)
+			{
+				changes.insert(path);
+				changed = true;
+			}
+		}
+		for (fs::path const& path: previousTimes | ranges::views::keys)
+			if (!times.count(path))
+			{
+				changes.insert(path);
+				changed = true;
+			}
+		if (!changed && !changes.empty())
+			return changes;
+		previousTimes = move(times);
+	}
+}
+
+map<fs::path, optional<time_t>> FileWatcher::modificationTimes() const
+{
+	map<fs::path, optional<time_t>> times;
+	boost::system::error_code error;
+	for (fs::path const& file: m_files)
+	{
+		time_t time = fs::last_write_time(file, error);
+		times[file] = error ? nullopt : optional<time_t>(time);
+	}
+	for (fs::path const& directory: m_directories)
+		for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+			if (fs::is_regular_file(it->status()))
+			{
+				time_t time = fs::last_write_time(it->path(), error);
+				times[it->path()] = error ? nullopt : optional<time_t>(time);
+				error.clear();
+			}
+	return times;
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Notification about changes to files, used by the watch mode of the commandline interface.
+ */
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::frontend
+{
+
+/**
+ * Waits for changes to a set of files and to the files directly inside a set of directories.
+ *
+ * On Linux, the directories containing the watched files are watched via inotify, so that
+ * files are still noticed after an editor replaced them by renaming a new file over them.
+ * On other platforms and if inotify is not available, the modification times are polled.
+ */
+class FileWatcher
+{
+public:
+	using PathSet = std::set<boost::filesystem::path>;
+
+	FileWatcher();
+	~FileWatcher();
+	FileWatcher(FileWatcher const&) = delete;
+	FileWatcher& operator=(FileWatcher const&) = delete;
+
+	/// Replaces the watched paths. All paths have to be canonical.
+	void watch(PathSet _files, PathSet _directories);
+
+	/// Blocks until a watched path changed and then until no further change happened for
+	/// @a _settleTime, so that saving several files at once results in a single notification.
+	/// @returns the changed files.
+	PathSet waitForChanges(std::chrono::milliseconds _settleTime = std::chrono::milliseconds(100));
+
+private:
+	/// @returns true if a change of @a _path is to be reported.
+	bool watched(boost::filesystem::path const& _path) const;
+
+	PathSet waitForNotifications(std::chrono::milliseconds _settleTime);
+	PathSet pollModificationTimes(std::chrono::milliseconds _settleTime);
+	/// @returns the modification times of the watched files and of the files in the watched
+	/// directories, nullopt for missing files.
+	std::map<boost::filesystem::path, std::optional<std::time_t>> modificationTimes() const;
+
+	PathSet m_files;
+	PathSet m_directories;
+	/// Inotify file descriptor or -1 if modification times are polled.
+	int m_notificationDescriptor = -1;
+	/// Watch descriptors of the directories watched via inotify.
+	std::map<int, boost::filesystem::path> m_notificationWatches;
+};
+
+}
@@ -30,6 +30,7 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/picosha2.h>
+#include <libsolutil/Visitor.h>
 
 using namespace std;
 using namespace solidity;
@@ -143,6 +144,7 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 void EVMHost::reset()
 {
 	accounts.clear();
+	m_journal.clear();
 	m_currentAddress = {};
 	// Clear self destruct records
 	recorded_selfdestructs.clear();
@@ -168,6 +170,37 @@ void EVMHost::reset()
 	}
 }
 
+void EVMHost::revertToSnapshot(Snapshot _snapshot)
+{
+	assertThrow(_snapshot <= m_journal.size(), Exception, "Invalid snapshot.");
+	while (m_journal.size() > _snapshot)
+	{
+		visit(GenericVisitor{
+			[&](AccountChange& _change) {
+				if (_change.previous)
+					accounts[_change.address] = move(*_change.previous);
+				else
+					accounts.erase(_change.address);
+			},
+			[&](BalanceChange const& _change) { accounts[_change.address].balance = _change.previous; },
+			[&](NonceChange const& _change) { accounts[_change.address].nonce = _change.previous; },
+			[&](CodeChange& _change) {
+				auto& account = accounts[_change.address];
+				account.code = move(_change.previousCode);
+				account.codehash = _change.previousCodehash;
+			},
+			[&](StorageChange const& _change) {
+				auto& storage = accounts[_change.address].storage;
+				if (_change.previous)
+					storage[_change.key] = *_change.previous;
+				else
+					storage.erase(_change.key);
+			}
+		}, m_journal.back());
+		m_journal.pop_back();
+	}
+}
+
 void EVMHost::resetWarmAccess()
 {
 	// Clear EIP-2929 account access indicator
@@ -178,18 +211,60 @@ void EVMHost::resetWarmAccess()
 			value.access_status = EVMC_ACCESS_COLD;
 }
 
-void EVMHost::transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept
+evmc::MockedAccount& EVMHost::account(evmc::address const& _addr)
+{
+	auto [it, inserted] = accounts.try_emplace(_addr);
+	if (inserted)
+		m_journal.emplace_back(AccountChange{_addr, nullptr});
+	return it->second;
+}
+
+void EVMHost::recordStorageChange(evmc::address const& _addr, evmc::bytes32 const& _key)
+{
+	StorageMap const& storage = accounts.at(_addr).storage;
+	auto it = storage.find(_key);
+	m_journal.emplace_back(StorageChange{
+		_addr,
+		_key,
+		it != storage.end() ? make_optional(it->second) : nullopt
+	});
+}
+
+void EVMHost::transfer(evmc::address const& _sender, evmc::address const& _recipient, u256 const& _value) noexcept
+{
+	evmc::MockedAccount& sender = account(_sender);
+	evmc::MockedAccount& recipient = account(_recipient);
+	assertThrow(u256(convertFromEVMC(sender.balance)) >= _value, Exception, "Insufficient balance for transfer");
+	m_journal.emplace_back(BalanceChange{_sender, sender.balance});
+	sender.balance = convertToEVMC(u256(convertFromEVMC(sender.balance)) - _value);
+	m_journal.emplace_back(BalanceChange{_recipient, recipient.balance});
+	recipient.balance = convertToEVMC(u256(convertFromEVMC(recipient.balance)) + _value);
+}
+
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	if (accounts.count(_addr))
+		recordStorageChange(_addr, _key);
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
 {
-	assertThrow(u256(convertFromEVMC(_sender.balance)) >= _value, Exception, "Insufficient balance for transfer");
-	_sender.balance = convertToEVMC(u256(convertFromEVMC(_sender.balance)) - _value);
-	_recipient.balance = convertToEVMC(u256(convertFromEVMC(_recipient.balance)) + _value);
+	account(_addr);
+	recordStorageChange(_addr, _key);
+	return MockedHost::access_storage(_addr, _key);
 }
 
 void EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _beneficiary) noexcept
 {
 	// TODO actual selfdestruct is even more complicated.
 
-	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
+	transfer(_addr, _beneficiary, convertFromEVMC(account(_addr).balance));
+	m_journal.emplace_back(AccountChange{_addr, make_unique<evmc::MockedAccount>(move(accounts.at(_addr)))});
 	accounts.erase(_addr);
 	// Record self destructs
 	recorded_selfdestructs.push_back({_addr, _beneficiary});
@@ -221,10 +296,10 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
-	auto const stateBackup = accounts;
+	Snapshot const stateBackup = snapshot();
 
 	u256 value{convertFromEVMC(_message.value)};
-	auto& sender = accounts[_message.sender];
+	auto& sender = account(_message.sender);
 
 	evmc::bytes code;
 
@@ -238,7 +313,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertToSnapshot(stateBackup);
 			return result;
 		}
 	}
@@ -247,6 +322,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	{
 		// TODO this is not the right formula
 		// TODO is the nonce incremented on failure, too?
+		m_journal.emplace_back(NonceChange{_message.sender, sender.nonce});
 		h160 createAddress(keccak256(
 			bytes(begin(message.sender.bytes), end(message.sender.bytes)) +
 			asBytes(to_string(sender.nonce++))
@@ -270,7 +346,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertToSnapshot(stateBackup);
 			return result;
 		}
 
@@ -278,13 +354,14 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
 	{
-		code = accounts[message.destination].code;
+		code = account(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else
-		code = accounts[message.destination].code;
+		code = account(message.destination).code;
 
-	auto& destination = accounts[message.destination];
+	// Creates the destination account if it does not exist yet.
+	account(message.destination);
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
 	{
@@ -292,10 +369,10 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertToSnapshot(stateBackup);
 			return result;
 		}
-		transfer(sender, destination, value);
+		transfer(message.sender, message.destination, value);
 	}
 
 	// Populate the access access list.
@@ -323,13 +400,16 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		else
 		{
 			result.create_address = message.destination;
-			destination.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
-			destination.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
+			// Looked up again, since undoing the changes of a failed inner call can replace the account.
+			auto& createdAccount = account(message.destination);
+			m_journal.emplace_back(CodeChange{message.destination, move(createdAccount.code), createdAccount.codehash});
+			createdAccount.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
+			createdAccount.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
 		}
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertToSnapshot(stateBackup);
 
 	return result;
 }
@@ -32,6 +32,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include <memory>
+#include <optional>
+#include <variant>
+
 namespace solidity::test
 {
 using Address = util::h160;
@@ -55,7 +59,17 @@ public:
 
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
 
+	/// Position in the journal of changes to the accounts.
+	using Snapshot = size_t;
+
 	void reset();
+	/// @returns a snapshot of the current state of the accounts, which can be restored
+	/// by @a revertToSnapshot.
+	Snapshot snapshot() const { return m_journal.size(); }
+	/// Undoes all changes to the accounts that were made by calls, self-destructs and storage
+	/// accesses since @a _snapshot was taken. Changes made by directly modifying @a accounts
+	/// are not undone. Snapshots taken after @a _snapshot become invalid.
+	void revertToSnapshot(Snapshot _snapshot);
 	/// Clears EIP-2929 account and storage access indicator
 	void resetWarmAccess();
 	void newBlock()
@@ -74,6 +88,13 @@ public:
 		return evmc::MockedHost::account_exists(_addr);
 	}
 
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
+
 	void selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 
 	evmc::result call(evmc_message const& _message) noexcept final;
@@ -92,9 +113,49 @@ public:
 	}
 
 private:
+	/// Creation or removal of an account. @a previous is null if the account did not exist.
+	struct AccountChange
+	{
+		evmc::address address;
+		std::unique_ptr<evmc::MockedAccount> previous;
+	};
+	struct BalanceChange
+	{
+		evmc::address address;
+		evmc::uint256be previous;
+	};
+	struct NonceChange
+	{
+		evmc::address address;
+		int previous;
+	};
+	struct CodeChange
+	{
+		evmc::address address;
+		evmc::bytes previousCode;
+		evmc::bytes32 previousCodehash;
+	};
+	/// Change of a storage slot. @a previous is empty if the slot did not exist.
+	struct StorageChange
+	{
+		evmc::address address;
+		evmc::bytes32 key;
+		std::optional<evmc::storage_value> previous;
+	};
+	using JournalEntry = std::variant<AccountChange, BalanceChange, NonceChange, CodeChange, StorageChange>;
+
 	evmc::address m_currentAddress = {};
+	/// Changes to the accounts in the order in which they were made, so that they can be
+	/// undone when a call fails, instead of copying all accounts before every call.
+	std::vector<JournalEntry> m_journal;
+
+	/// @returns the account at @param _addr, creating it if it does not exist.
+	evmc::MockedAccount& account(evmc::address const& _addr);
+	/// Records the current value of the storage slot @param _key of the existing account
+	/// @param _addr in the journal.
+	void recordStorageChange(evmc::address const& _addr, evmc::bytes32 const& _key);
 
-	void transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept;
+	void transfer(evmc::address const& _sender, evmc::address const& _recipient, u256 const& _value) noexcept;
 
 	/// Records calls made via @param _message.
 	void recordCalls(evmc_message const& _message) noexcept;
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+/// Builds Merkle trees with sorted pairs in memory and verifies proofs for all of their leaves.
+contract MerkleProofs {
+    bytes32 public root;
+
+    function storeRoot(uint256 _leafCount) external {
+        root = computeRoot(leaves(_leafCount));
+    }
+
+    /// @returns the number of leaves of the stored tree whose proof is valid.
+    function verifyAll(uint256 _leafCount) external view returns (uint256 valid) {
+        bytes32[] memory values = leaves(_leafCount);
+        for (uint256 i = 0; i < _leafCount; i++)
+            if (verify(proof(values, i), root, values[i]))
+                valid++;
+    }
+
+    function leaves(uint256 _leafCount) internal pure returns (bytes32[] memory values) {
+        require(_leafCount > 0 && (_leafCount & (_leafCount - 1)) == 0, "Leaf count not a power of two");
+        values = new bytes32[](_leafCount);
+        for (uint256 i = 0; i < _leafCount; i++)
+            values[i] = keccak256(abi.encode(i));
+    }
+
+    function computeRoot(bytes32[] memory _level) internal pure returns (bytes32) {
+        while (_level.length > 1)
+            _level = nextLevel(_level);
+        return _level[0];
+    }
+
+    function proof(bytes32[] memory _level, uint256 _index) internal pure returns (bytes32[] memory result) {
+        uint256 depth = 0;
+        for (uint256 n = _level.length; n > 1; n /= 2)
+            depth++;
+        result = new bytes32[](depth);
+        for (uint256 d = 0; d < depth; d++) {
+            result[d] = _level[_index ^ 1];
+            _level = nextLevel(_level);
+            _index /= 2;
+        }
+    }
+
+    function verify(bytes32[] memory _proof, bytes32 _root, bytes32 _leaf) internal pure returns (bool) {
+        bytes32 hash = _leaf;
+        for (uint256 i = 0; i < _proof.length; i++)
+            hash = hashPair(hash, _proof[i]);
+        return hash == _root;
+    }
+
+    function nextLevel(bytes32[] memory _level) internal pure returns (bytes32[] memory next) {
+        next = new bytes32[](_level.length / 2);
+        for (uint256 i = 0; i < next.length; i++)
+            next[i] = hashPair(_level[2 * i], _level[2 * i + 1]);
+    }
+
+    function hashPair(bytes32 _a, bytes32 _b) internal pure returns (bytes32) {
+        return _a < _b ? keccak256(abi.encodePacked(_a, _b)) : keccak256(abi.encodePacked(_b, _a));
+    }
+}
+// ----
+// storeRoot(uint256): 16 ->
+// verifyAll(uint256): 16 -> 16
+// verifyAll(uint256): 8 -> 0
+// storeRoot(uint256): 6 -> FAILURE, hex"08c379a0", 0x20, 0x1d, "Leaf count not a power of two"
+// storeRoot(uint256): 32 ->
+// verifyAll(uint256): 32 -> 32
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+/// Constant product market maker that keeps the token balances as internal accounting.
+contract Pool {
+    uint256 constant FEE_PER_MILLE = 3;
+
+    uint256 public reserve0;
+    uint256 public reserve1;
+    uint256 public totalShares;
+    mapping(address => uint256) public shares;
+
+    function addLiquidity(uint256 _amount0, uint256 _amount1) external returns (uint256 minted) {
+        if (totalShares == 0)
+            minted = sqrt(_amount0 * _amount1);
+        else
+            minted = min(_amount0 * totalShares / reserve0, _amount1 * totalShares / reserve1);
+        require(minted > 0, "No shares minted");
+        shares[msg.sender] += minted;
+        totalShares += minted;
+        reserve0 += _amount0;
+        reserve1 += _amount1;
+    }
+
+    function removeLiquidity(uint256 _shares) external returns (uint256 amount0, uint256 amount1) {
+        amount0 = _shares * reserve0 / totalShares;
+        amount1 = _shares * reserve1 / totalShares;
+        shares[msg.sender] -= _shares;
+        totalShares -= _shares;
+        reserve0 -= amount0;
+        reserve1 -= amount1;
+    }
+
+    function swap0For1(uint256 _amountIn) external returns (uint256 amountOut) {
+        amountOut = getAmountOut(_amountIn, reserve0, reserve1);
+        reserve0 += _amountIn;
+        reserve1 -= amountOut;
+    }
+
+    function swap1For0(uint256 _amountIn) external returns (uint256 amountOut) {
+        amountOut = getAmountOut(_amountIn, reserve1, reserve0);
+        reserve1 += _amountIn;
+        reserve0 -= amountOut;
+    }
+
+    function getAmountOut(uint256 _amountIn, uint256 _reserveIn, uint256 _reserveOut) public pure returns (uint256) {
+        uint256 amountInWithFee = _amountIn * (1000 - FEE_PER_MILLE);
+        return amountInWithFee * _reserveOut / (_reserveIn * 1000 + amountInWithFee);
+    }
+
+    function min(uint256 _a, uint256 _b) internal pure returns (uint256) {
+        return _a < _b ? _a : _b;
+    }
+
+    function sqrt(uint256 _y) internal pure returns (uint256 z) {
+        if (_y > 3) {
+            z = _y;
+            uint256 x = _y / 2 + 1;
+            while (x < z) {
+                z = x;
+                x = (_y / x + x) / 2;
+            }
+        } else if (_y != 0)
+            z = 1;
+    }
+}
+// ----
+// addLiquidity(uint256,uint256): 1000000, 4000000 -> 2000000
+// swap0For1(uint256): 10000 -> 39486
+// swap1For0(uint256): 20000 -> 5059
+// addLiquidity(uint256,uint256): 100000, 400000 -> 199016
+// removeLiquidity(uint256): 1000000 -> 502470, 1992033
+// removeLiquidity(uint256): 2000000 -> FAILURE, hex"4e487b71", 0x11
+// reserve0() -> 602471
+// reserve1() -> 2388481
+// totalShares() -> 1199016
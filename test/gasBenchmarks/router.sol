@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+contract Vault {
+    mapping(address => uint256) public deposits;
+
+    function deposit(address _owner, uint256 _amount) external {
+        deposits[_owner] += _amount;
+    }
+}
+
+/// Routes amounts through one of several strategies, selected by an internal function pointer,
+/// and deposits the result into a vault contract.
+contract Router {
+    Vault public immutable vault;
+
+    constructor() {
+        vault = new Vault();
+    }
+
+    function route(uint256 _strategy, uint256 _amount) external returns (uint256 result) {
+        result = strategy(_strategy)(_amount);
+        vault.deposit(msg.sender, result);
+    }
+
+    function routeBatch(uint256[] calldata _amounts) external returns (uint256 total) {
+        for (uint256 i = 0; i < _amounts.length; i++)
+            total += strategy(i % 3)(_amounts[i]);
+        vault.deposit(msg.sender, total);
+    }
+
+    function deposited(address _owner) external view returns (uint256) {
+        return vault.deposits(_owner);
+    }
+
+    function strategy(uint256 _id) internal pure returns (function(uint256) internal pure returns (uint256)) {
+        if (_id == 0)
+            return conservative;
+        else if (_id == 1)
+            return balanced;
+        else if (_id == 2)
+            return aggressive;
+        revert("Unknown strategy");
+    }
+
+    function conservative(uint256 _amount) internal pure returns (uint256) {
+        return _amount - _amount / 20;
+    }
+
+    function balanced(uint256 _amount) internal pure returns (uint256) {
+        return _amount + _amount / 10;
+    }
+
+    function aggressive(uint256 _amount) internal pure returns (uint256) {
+        return _amount * 3 / 2;
+    }
+}
+// ----
+// constructor() ->
+// route(uint256,uint256): 0, 1000 -> 950
+// route(uint256,uint256): 1, 1000 -> 1100
+// route(uint256,uint256): 2, 1000 -> 1500
+// route(uint256,uint256): 3, 1000 -> FAILURE, hex"08c379a0", 0x20, 0x10, "Unknown strategy"
+// routeBatch(uint256[]): 0x20, 6, 100, 200, 300, 400, 500, 600 -> 2595
+// deposited(address): 0x1212121212121212121212121212120000000012 -> 6145
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+contract Sorter {
+    uint256[] public data;
+
+    function store(uint256[] calldata _values) external {
+        data = _values;
+    }
+
+    /// Sorts the stored values in place and returns the smallest and the largest one.
+    function sortStored() external returns (uint256, uint256) {
+        uint256[] memory values = data;
+        require(values.length > 0, "No data");
+        quickSort(values, 0, values.length - 1);
+        data = values;
+        return (values[0], values[values.length - 1]);
+    }
+
+    function sort(uint256[] memory _values) public pure returns (uint256[] memory) {
+        for (uint256 i = 1; i < _values.length; i++) {
+            uint256 value = _values[i];
+            uint256 j = i;
+            while (j > 0 && _values[j - 1] > value) {
+                _values[j] = _values[j - 1];
+                j--;
+            }
+            _values[j] = value;
+        }
+        return _values;
+    }
+
+    /// Hoare partition scheme on the values from index _low to _high inclusive.
+    function quickSort(uint256[] memory _values, uint256 _low, uint256 _high) internal pure {
+        if (_low >= _high)
+            return;
+        uint256 pivot = _values[(_low + _high) / 2];
+        uint256 i = _low;
+        uint256 j = _high;
+        while (true) {
+            while (_values[i] < pivot)
+                i++;
+            while (_values[j] > pivot)
+                j--;
+            if (i >= j)
+                break;
+            (_values[i], _values[j]) = (_values[j], _values[i]);
+            i++;
+            j--;
+        }
+        quickSort(_values, _low, j);
+        quickSort(_values, j + 1, _high);
+    }
+}
+// ----
+// sort(uint256[]): 0x20, 8, 5, 3, 8, 1, 9, 2, 7, 4 -> 0x20, 8, 1, 2, 3, 4, 5, 7, 8, 9
+// store(uint256[]): 0x20, 12, 42, 7, 19, 3, 88, 11, 64, 7, 25, 90, 1, 33 ->
+// sortStored() -> 1, 90
+// data(uint256): 0 -> 1
+// data(uint256): 2 -> 7
+// data(uint256): 6 -> 25
+// data(uint256): 11 -> 90
+// sortStored() -> 1, 90
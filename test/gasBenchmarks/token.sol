@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+contract Token {
+    mapping(address => uint256) public balanceOf;
+    mapping(address => mapping(address => uint256)) public allowance;
+    uint256 public totalSupply;
+
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    event Approval(address indexed owner, address indexed spender, uint256 value);
+
+    constructor(uint256 _supply) {
+        balanceOf[msg.sender] = _supply;
+        totalSupply = _supply;
+        emit Transfer(address(0), msg.sender, _supply);
+    }
+
+    function transfer(address _to, uint256 _value) external returns (bool) {
+        _transfer(msg.sender, _to, _value);
+        return true;
+    }
+
+    function approve(address _spender, uint256 _value) external returns (bool) {
+        allowance[msg.sender][_spender] = _value;
+        emit Approval(msg.sender, _spender, _value);
+        return true;
+    }
+
+    function transferFrom(address _from, address _to, uint256 _value) external returns (bool) {
+        uint256 allowed = allowance[_from][msg.sender];
+        if (allowed != type(uint256).max)
+            allowance[_from][msg.sender] = allowed - _value;
+        _transfer(_from, _to, _value);
+        return true;
+    }
+
+    function _transfer(address _from, address _to, uint256 _value) internal {
+        require(balanceOf[_from] >= _value, "Insufficient balance");
+        balanceOf[_from] -= _value;
+        balanceOf[_to] += _value;
+        emit Transfer(_from, _to, _value);
+    }
+}
+// ----
+// constructor(): 1000000 ->
+// balanceOf(address): 0x1212121212121212121212121212120000000012 -> 1000000
+// transfer(address,uint256): 0x1234, 100 -> true
+// transfer(address,uint256): 0x1234, 200 -> true
+// approve(address,uint256): 0x1212121212121212121212121212120000000012, 1000 -> true
+// transferFrom(address,address,uint256): 0x1212121212121212121212121212120000000012, 0x5678, 300 -> true
+// allowance(address,address): 0x1212121212121212121212121212120000000012, 0x1212121212121212121212121212120000000012 -> 700
+// transferFrom(address,address,uint256): 0x1212121212121212121212121212120000000012, 0x5678, 50 -> true
+// balanceOf(address): 0x1234 -> 300
+// balanceOf(address): 0x5678 -> 350
+// balanceOf(address): 0x1212121212121212121212121212120000000012 -> 999350
+// transfer(address,uint256): 0x1234, 1000000 -> FAILURE, hex"08c379a0", 0x20, 0x14, "Insufficient balance"
+// totalSupply() -> 1000000
@@ -165,6 +165,36 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(source_mapping)
+{
+	map<string, unsigned> indices = {
+		{ "root.asm", 0 },
+		{ "sub.asm", 1 }
+	};
+	auto root_asm = make_shared<CharStream>("lorem ipsum", "root.asm");
+	auto sub_asm = make_shared<CharStream>("lorem ipsum", "sub.asm");
+	AssemblyItem jump(Instruction::JUMP, {6, 8, sub_asm});
+	jump.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItems items{
+		{Instruction::ADD, {1, 3, root_asm}},
+		{Instruction::MUL, {1, 3, root_asm}},
+		{Instruction::SUB, {1, 5, root_asm}},
+		{Instruction::DIV, {6, 8, sub_asm}},
+		jump,
+		{Instruction::STOP, {}}
+	};
+
+	SourceMapping entries = AssemblyItem::computeSourceMappingEntries(items, indices);
+	BOOST_REQUIRE_EQUAL(entries.size(), items.size());
+	BOOST_CHECK_EQUAL(entries[2].length, 4);
+	BOOST_CHECK_EQUAL(entries[3].sourceIndex, 1);
+	BOOST_CHECK_EQUAL(entries[4].jump, 'i');
+	BOOST_CHECK_EQUAL(entries[5].sourceIndex, -1);
+	BOOST_CHECK_EQUAL(AssemblyItem::renderSourceMapping(entries), "1:2:0:-:0;;:4;6:2:1;:::i;-1:-1:-1:-");
+	BOOST_CHECK_EQUAL(AssemblyItem::computeSourceMapping(items, indices), AssemblyItem::renderSourceMapping(entries));
+	BOOST_CHECK_EQUAL(AssemblyItem::renderSourceMapping({}), "");
+}
+
 BOOST_AUTO_TEST_CASE(immutable)
 {
 	map<string, unsigned> indices = {
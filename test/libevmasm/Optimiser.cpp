@@ -29,6 +29,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ColdCodeMover.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -881,6 +882,42 @@ BOOST_AUTO_TEST_CASE(block_deduplicator)
 	BOOST_CHECK_EQUAL(pushTags.size(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_long_blocks)
+{
+	// Blocks 1, 2 and 3 share a long prefix, but only 1 and 3 are equal.
+	// Blocks 4 and 5 are loops that jump to themselves.
+	auto block = [](unsigned _tag, u256 const& _last) {
+		AssemblyItems items{AssemblyItem(Tag, _tag)};
+		for (unsigned i = 0; i < 50; ++i)
+			items += AssemblyItems{u256(i), Instruction::POP};
+		items += AssemblyItems{_last, u256(0), Instruction::REVERT};
+		return items;
+	};
+	auto loop = [](unsigned _tag) {
+		return AssemblyItems{AssemblyItem(Tag, _tag), u256(1), AssemblyItem(PushTag, _tag), Instruction::JUMPI, Instruction::STOP};
+	};
+	AssemblyItems blocks = block(1, 7) + block(2, 8) + block(3, 7) + loop(4) + loop(5);
+	AssemblyItems input = AssemblyItems{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 4),
+		AssemblyItem(PushTag, 5),
+	} + blocks;
+	AssemblyItems output = AssemblyItems{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 4),
+		AssemblyItem(PushTag, 4),
+	} + block(1, 7) + block(2, 8) + block(3, 7) + loop(4) + AssemblyItems{
+		AssemblyItem(Tag, 5), u256(1), AssemblyItem(PushTag, 4), Instruction::JUMPI, Instruction::STOP
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), output.begin(), output.end());
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator_assign_immutable_same)
 {
 	AssemblyItems blocks{
@@ -1044,9 +1081,49 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_single_pass)
+{
+	// Every rewrite enables the next one in front of it.
+	AssemblyItems items{u256(0x100)};
+	for (size_t i = 0; i < 1000; i++)
+		items += AssemblyItems{Instruction::DUP1, Instruction::NOT};
+	for (size_t i = 0; i < 1000; i++)
+		items.emplace_back(Instruction::POP);
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK((items == AssemblyItems{u256(0x100)}));
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_swap_pops)
+{
+	for (unsigned n: {1u, 2u, 3u})
+	{
+		AssemblyItems items{AssemblyItem(Tag, 1), swapInstruction(n)};
+		AssemblyItems expectation{AssemblyItem(Tag, 1)};
+		for (unsigned i = 0; i <= n; i++)
+		{
+			items.emplace_back(Instruction::POP);
+			expectation.emplace_back(Instruction::POP);
+		}
+		items.emplace_back(Instruction::STOP);
+		expectation.emplace_back(Instruction::STOP);
+		PeepholeOptimiser peepOpt(items);
+		BOOST_REQUIRE(peepOpt.optimise());
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+	// Not all swapped items are removed.
+	AssemblyItems items{AssemblyItem(Tag, 1), Instruction::SWAP2, Instruction::POP, Instruction::POP, Instruction::STOP};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(!peepOpt.optimise());
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1309,6 +1386,111 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(subassemblies_optimised_concurrently)
+{
+	// Sub-assemblies are optimised concurrently unless they share sub-assemblies,
+	// which must not change the result.
+	auto createSub = [](unsigned _value) {
+		AssemblyPointer sub = make_shared<Assembly>();
+		sub->append(u256(_value));
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t2 = sub->newTag();
+		sub->append(t2); // Identical to t1, will be unified
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		sub->append(u256(0xffff) << 200);
+		sub->append(Instruction::POP);
+		return make_pair(sub, t2);
+	};
+	auto createMain = [&]() {
+		auto main = make_shared<Assembly>();
+		AssemblyPointer shared = createSub(10).first;
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			auto [sub, tag] = createSub(i);
+			// The first and the last sub share a sub-assembly.
+			if (i == 0 || i == 3)
+				sub->appendSubroutine(shared);
+			size_t subId = static_cast<size_t>(main->appendSubroutine(sub).data());
+			main->append(tag.toSubAssemblyTag(subId).pushTag());
+		}
+		return main;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	auto sequential = createMain();
+	sequential->optimise(settings);
+	settings.parallelism = 4;
+	auto parallel = createMain();
+	parallel->optimise(settings);
+
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		parallel->items().begin(), parallel->items().end(),
+		sequential->items().begin(), sequential->items().end()
+	);
+	BOOST_CHECK_EQUAL(util::toHex(parallel->assemble().bytecode), util::toHex(sequential->assemble().bytecode));
+}
+
+BOOST_AUTO_TEST_CASE(cse_extended_blocks)
+{
+	// The knowledge about the value loaded from calldata is kept across the conditional jump,
+	// but not across the tag.
+	auto createAssembly = []() {
+		Assembly assembly;
+		auto tag = assembly.newTag();
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::DUP1);
+		assembly.append(tag.pushTag());
+		assembly.append(Instruction::JUMPI);
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::DUP1);
+		assembly.append(Instruction::MUL);
+		assembly.append(Instruction::STOP);
+		assembly.append(tag);
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::DUP1);
+		assembly.append(Instruction::MUL);
+		assembly.append(Instruction::STOP);
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runCSE = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	Assembly unchanged = createAssembly();
+	unchanged.optimise(settings);
+	AssemblyItems original = createAssembly().items();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		unchanged.items().begin(), unchanged.items().end(),
+		original.begin(), original.end()
+	);
+
+	settings.runExtendedCSE = true;
+	Assembly extended = createAssembly();
+	extended.optimise(settings);
+	AssemblyItems expectation = original;
+	expectation.erase(expectation.begin() + 5, expectation.begin() + 7);
+	expectation.insert(expectation.begin() + 5, AssemblyItem(Instruction::DUP1));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		extended.items().begin(), extended.items().end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1428,7 +1610,7 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 			Instruction::DUP3,
 			Instruction::DUP4
 		});
-	map<int, unsigned> const& stackElements = state.stackElements();
+	map<int, unsigned> stackElements = state.stackElements();
 
 	BOOST_CHECK(state.stackHeight() == 4);
 	// One more than stack height because of the initial unknown element.
@@ -1441,6 +1623,7 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 
 	auto verbatim2i5o = AssemblyItem{bytes{1, 2, 3, 4, 5}, 2, 5};
 	state.feedItem(verbatim2i5o);
+	stackElements = state.stackElements();
 
 	BOOST_CHECK(state.stackHeight() == 7);
 	// Stack elements
@@ -1460,6 +1643,39 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 				BOOST_CHECK(stackElements.at(height1) != stackElements.at(height2));
 }
 
+BOOST_AUTO_TEST_CASE(knownstate_copies_are_independent)
+{
+	KnownState state = createInitialState(AssemblyItems{
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		u256(2),
+		u256(0x20),
+		Instruction::MSTORE,
+		u256(3)
+	});
+	shared_ptr<KnownState> copy = state.copy();
+	BOOST_CHECK(*copy == state);
+
+	copy->feedItem(AssemblyItem(u256(4)), true);
+	copy->feedItem(AssemblyItem(u256(5)), true);
+	copy->feedItem(AssemblyItem(Instruction::SSTORE), true);
+	copy->feedItem(AssemblyItem(Instruction::POP), true);
+	BOOST_CHECK(!(*copy == state));
+	BOOST_CHECK_EQUAL(state.stackHeight(), 1);
+	BOOST_CHECK_EQUAL(state.storageContent().size(), 1);
+	BOOST_CHECK_EQUAL(copy->stackHeight(), 0);
+	BOOST_CHECK_EQUAL(copy->storageContent().size(), 2);
+
+	// The common knowledge is the storage slot zero.
+	KnownState common = state;
+	common.reduceToCommonKnowledge(*copy, true);
+	BOOST_CHECK_EQUAL(common.stackHeight(), 0);
+	BOOST_CHECK_EQUAL(common.storageContent().size(), 1);
+	BOOST_CHECK_EQUAL(state.stackHeight(), 1);
+	BOOST_CHECK_EQUAL(state.stackElements().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(cse_remove_redundant_shift_masking)
 {
 	if (!solidity::test::CommonOptions::get().evmVersion().hasBitwiseShifting())
@@ -1708,6 +1924,42 @@ BOOST_AUTO_TEST_CASE(inliner_no_inline_type)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(inliner_referenced_tags)
+{
+	// The tags referenced after inlining are tracked without scanning the items again.
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+	};
+	Inliner inliner{items, {}, 200, false, {}};
+	inliner.optimise();
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+	};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(inliner.referencedTags() == (set<size_t>{2, 3}));
+	BOOST_CHECK(inliner.referencedTags() == JumpdestRemover::referencedTags(items, numeric_limits<size_t>::max()));
+}
+
 BOOST_AUTO_TEST_CASE(inliner_no_inline)
 {
 	AssemblyItems items{
@@ -1915,6 +2167,186 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cold_code_mover)
+{
+	AssemblyItems items{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0),
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 10),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 10),
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT
+	};
+	size_t nextTag = 10;
+	BOOST_REQUIRE(ColdCodeMover(items, {}, [&]() { return AssemblyItem(Tag, nextTag++); }).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cold_code_mover_reverting_function)
+{
+	// A call to a function that always reverts, as generated for panics.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		u256(0x11),
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::REVERT
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 10),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		u256(0x11),
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::REVERT,
+		AssemblyItem(Tag, 10),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2)
+	};
+	size_t nextTag = 10;
+	BOOST_REQUIRE(ColdCodeMover(items, {}, [&]() { return AssemblyItem(Tag, nextTag++); }).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cold_code_mover_reachable_tag)
+{
+	// Tag 2 is also jumped to from elsewhere, so the moved code has to continue at tag 1.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 2),
+		Instruction::POP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 10),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 10),
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 2),
+		Instruction::POP,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	size_t nextTag = 10;
+	BOOST_REQUIRE(ColdCodeMover(items, {}, [&]() { return AssemblyItem(Tag, nextTag++); }).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cold_code_mover_no_change)
+{
+	size_t nextTag = 10;
+	auto newTag = [&]() { return AssemblyItem(Tag, nextTag++); };
+	for (AssemblyItems items: {
+		// Inverting the condition would cost an ISZERO.
+		AssemblyItems{
+			Instruction::CALLVALUE,
+			AssemblyItem(PushTag, 1),
+			Instruction::JUMPI,
+			u256(0),
+			Instruction::DUP1,
+			Instruction::REVERT,
+			AssemblyItem(Tag, 1)
+		},
+		// The code after the jump does not revert.
+		AssemblyItems{
+			Instruction::CALLVALUE,
+			Instruction::ISZERO,
+			AssemblyItem(PushTag, 1),
+			Instruction::JUMPI,
+			u256(0),
+			Instruction::DUP1,
+			Instruction::RETURN,
+			AssemblyItem(Tag, 1)
+		},
+		// The code after the jump can be entered at tag 2.
+		AssemblyItems{
+			Instruction::CALLVALUE,
+			Instruction::ISZERO,
+			AssemblyItem(PushTag, 1),
+			Instruction::JUMPI,
+			AssemblyItem(Tag, 2),
+			u256(0),
+			Instruction::DUP1,
+			Instruction::REVERT,
+			AssemblyItem(Tag, 1)
+		}
+	})
+	{
+		AssemblyItems expectation = items;
+		BOOST_CHECK(!ColdCodeMover(items, {}, newTag).optimise());
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -48,6 +48,25 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(translate_position_to_line_column)
+{
+	CharStream const source("ab\n\ncd\r\nef", "source");
+	auto check = [&](int _position, int _line, int _column) {
+		BOOST_CHECK(source.translatePositionToLineColumn(_position) == std::make_tuple(_line, _column));
+	};
+	check(0, 0, 0);
+	check(1, 0, 1);
+	check(2, 0, 2);
+	check(3, 1, 0);
+	check(4, 2, 0);
+	check(6, 2, 2);
+	check(8, 3, 0);
+	check(10, 3, 2);
+	// Positions past the end and -1 are treated as the end of the source.
+	check(11, 3, 2);
+	check(-1, 3, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the sharing of SMT expressions.
+ */
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(ExpressionTest)
+
+BOOST_AUTO_TEST_CASE(equal_terms_are_shared)
+{
+	Expression x("x", {}, SortProvider::sintSort);
+	Expression y("y", {}, SortProvider::sintSort);
+
+	Expression a = (x + y) * (x + y);
+	Expression b = (x + y) * (x + y);
+	BOOST_CHECK(a.arguments.id() == b.arguments.id());
+	BOOST_CHECK(a.arguments[0].arguments.id() == a.arguments[1].arguments.id());
+	BOOST_CHECK(a.sameTerm(b));
+
+	BOOST_CHECK((x + y).arguments.id() != (y + x).arguments.id());
+	BOOST_CHECK(!(x + y).sameTerm(x - y));
+	BOOST_CHECK(Expression("x", {}, SortProvider::uintSort).arguments.id() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(sorts_are_part_of_the_term)
+{
+	Expression bv("v", {}, SortProvider::bitVectorSort);
+	Expression signedInt = Expression::bv2int(bv, true);
+	Expression unsignedInt = Expression::bv2int(bv, false);
+	BOOST_CHECK(!signedInt.sameTerm(unsignedInt));
+	BOOST_CHECK((signedInt + 1).arguments.id() != (unsignedInt + 1).arguments.id());
+}
+
+BOOST_AUTO_TEST_CASE(released_terms)
+{
+	Expression x("x", {}, SortProvider::sintSort);
+	void const* id = nullptr;
+	{
+		Expression sum = x + 1;
+		id = sum.arguments.id();
+		Expression copy = sum;
+		BOOST_CHECK(copy.arguments.id() == id);
+	}
+	// Building a term equal to a released one creates a valid node again.
+	Expression sum = x + 1;
+	BOOST_REQUIRE_EQUAL(sum.arguments.size(), 2);
+	BOOST_CHECK_EQUAL(sum.arguments.front().name, "x");
+	BOOST_CHECK_EQUAL(sum.arguments.back().name, "1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the persistent cache of SMT query results.
+ */
+
+#include <libsmtutil/QueryCache.h>
+
+#include <test/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::test;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(QueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(store_and_lookup)
+{
+	TemporaryDirectory directory;
+	QueryCache cache((directory.path() / "cache").string());
+	BOOST_CHECK(!cache.lookup("z3", "(assert x)"));
+
+	vector<string> values{"1", "", "((as const (Array Int Int)) 0)\n(store a 1 2)"};
+	cache.store("z3", "(assert x)", CheckResult::SATISFIABLE, values);
+	cache.store("z3", "(assert false)", CheckResult::UNSATISFIABLE, {});
+
+	auto sat = cache.lookup("z3", "(assert x)");
+	BOOST_REQUIRE(sat);
+	BOOST_CHECK(sat->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(sat->second == values);
+
+	auto unsat = cache.lookup("z3", "(assert false)");
+	BOOST_REQUIRE(unsat);
+	BOOST_CHECK(unsat->first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(unsat->second.empty());
+
+	// A cache with the same directory sees the results of other instances.
+	BOOST_CHECK(QueryCache((directory.path() / "cache").string()).lookup("z3", "(assert x)"));
+}
+
+BOOST_AUTO_TEST_CASE(solver_identity)
+{
+	TemporaryDirectory directory;
+	QueryCache cache(directory.path().string());
+	cache.store("z3 4.8.9", "(assert false)", CheckResult::UNSATISFIABLE, {});
+	BOOST_CHECK(cache.lookup("z3 4.8.9", "(assert false)"));
+	BOOST_CHECK(!cache.lookup("z3 4.8.10", "(assert false)"));
+	BOOST_CHECK(!cache.lookup("cvc4 1.8", "(assert false)"));
+}
+
+BOOST_AUTO_TEST_CASE(time_dependent_results_are_not_stored)
+{
+	TemporaryDirectory directory;
+	QueryCache cache(directory.path().string());
+	cache.store("z3", "(assert x)", CheckResult::UNKNOWN, {});
+	cache.store("z3", "(assert y)", CheckResult::ERROR, {});
+	cache.store("z3", "(assert z)", CheckResult::CONFLICTING, {});
+	BOOST_CHECK(!cache.lookup("z3", "(assert x)"));
+	BOOST_CHECK(!cache.lookup("z3", "(assert y)"));
+	BOOST_CHECK(!cache.lookup("z3", "(assert z)"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
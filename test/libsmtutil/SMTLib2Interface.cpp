@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the SMT-LIB2 interface.
+ */
+
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTLib2InterfaceTest)
+
+BOOST_AUTO_TEST_CASE(batched_queries)
+{
+	vector<string> kinds;
+	SMTLib2Interface solver({}, [&](string const& _kind, string const& _data) -> ReadCallback::Result {
+		kinds.push_back(_kind);
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQueryBatch))
+			return {true, "unknown\n"};
+		Json::Value queries;
+		BOOST_REQUIRE(util::jsonParseStrict(_data, queries));
+		Json::Value responses(Json::arrayValue);
+		for (auto const& query: queries)
+			responses.append(query.asString().find("(assert (> x 0))") != string::npos ? "sat\n" : "unsat\n");
+		return {true, util::jsonCompactPrint(responses)};
+	});
+	Expression x = solver.newVariable("x", SortProvider::sintSort);
+	vector<Expression> conditions{x > 0, x < 0, x < 0};
+
+	solver.prefetch({{conditions[0], {}}, {conditions[1], {}}, {conditions[2], {}}});
+	BOOST_REQUIRE_EQUAL(kinds.size(), 1);
+
+	vector<CheckResult> results;
+	for (auto const& condition: conditions)
+	{
+		solver.push();
+		solver.addAssertion(condition);
+		results.push_back(solver.check({}).first);
+		solver.pop();
+	}
+	BOOST_CHECK(results == (vector<CheckResult>{CheckResult::SATISFIABLE, CheckResult::UNSATISFIABLE, CheckResult::UNSATISFIABLE}));
+	// Every query was answered by the batch.
+	BOOST_CHECK_EQUAL(kinds.size(), 1);
+	BOOST_CHECK(solver.unhandledQueries().empty());
+}
+
+BOOST_AUTO_TEST_CASE(callback_without_batches)
+{
+	size_t queries = 0;
+	SMTLib2Interface solver({}, [&](string const& _kind, string const&) -> ReadCallback::Result {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+			return {false, "Unsupported kind."};
+		++queries;
+		return {true, "unsat\n"};
+	});
+	Expression x = solver.newVariable("x", SortProvider::sintSort);
+	solver.prefetch({{x > 0, {}}, {x < 0, {}}});
+
+	solver.push();
+	solver.addAssertion(x > 0);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	solver.pop();
+	BOOST_CHECK_EQUAL(queries, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,76 @@
+pragma abicoder               v2;
+struct S { uint a; }
+contract C {
+    function f(S memory x) public pure {}
+}
+contract D {
+    function g(S memory y) public pure returns (S memory z) {}
+}
+// ----
+//     :C
+// [
+//   {
+//     "inputs":
+//     [
+//       {
+//         "components":
+//         [
+//           {
+//             "internalType": "uint256",
+//             "name": "a",
+//             "type": "uint256"
+//           }
+//         ],
+//         "internalType": "struct S",
+//         "name": "x",
+//         "type": "tuple"
+//       }
+//     ],
+//     "name": "f",
+//     "outputs": [],
+//     "stateMutability": "pure",
+//     "type": "function"
+//   }
+// ]
+//
+//
+//     :D
+// [
+//   {
+//     "inputs":
+//     [
+//       {
+//         "components":
+//         [
+//           {
+//             "internalType": "uint256",
+//             "name": "a",
+//             "type": "uint256"
+//           }
+//         ],
+//         "internalType": "struct S",
+//         "name": "y",
+//         "type": "tuple"
+//       }
+//     ],
+//     "name": "g",
+//     "outputs":
+//     [
+//       {
+//         "components":
+//         [
+//           {
+//             "internalType": "uint256",
+//             "name": "a",
+//             "type": "uint256"
+//           }
+//         ],
+//         "internalType": "struct S",
+//         "name": "z",
+//         "type": "tuple"
+//       }
+//     ],
+//     "stateMutability": "pure",
+//     "type": "function"
+//   }
+// ]
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary encoding of the JSON AST.
+ */
+
+#include <libsolidity/ast/ASTBinary.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+void checkRoundTrip(Json::Value const& _value)
+{
+	string const encoded = ASTBinary::encode(_value);
+	BOOST_REQUIRE(ASTBinary::isEncoded(encoded));
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(ASTBinary::decode(encoded)), util::jsonCompactPrint(_value));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTBinaryTest)
+
+BOOST_AUTO_TEST_CASE(values)
+{
+	Json::Value value{Json::objectValue};
+	value["null"] = Json::nullValue;
+	value["true"] = true;
+	value["false"] = false;
+	value["zero"] = 0;
+	value["large"] = Json::UInt64(numeric_limits<uint64_t>::max());
+	value["negative"] = -1;
+	value["smallest"] = Json::Int64(numeric_limits<int64_t>::min());
+	value["real"] = 0.25;
+	value["empty"] = "";
+	value["string"] = "string";
+	value["repeated"] = "string";
+	value["emptyArray"] = Json::arrayValue;
+	value["emptyObject"] = Json::objectValue;
+	value["locations"] = Json::arrayValue;
+	for (string location: {"0:0:0", "12:34:-1", "1:2:3:4", "01:2:3", "1:-2:3", "1:2:-3", "1::3", "a:b:c"})
+		value["locations"].append(location);
+	value["nested"]["array"].append(value["locations"]);
+	checkRoundTrip(value);
+	checkRoundTrip(Json::Value{"top-level string"});
+}
+
+BOOST_AUTO_TEST_CASE(source_unit)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"a.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		/// @title Docs
+		contract C {
+			uint[] x;
+			event E(uint indexed a);
+			function f(int a) public returns (int, string memory) {
+				x.push(uint(a));
+				emit E(x.length);
+				return (-a * 0x1234, "abc");
+			}
+		}
+	)"}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compilerStack.parseAndAnalyze());
+
+	Json::Value ast = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(
+		compilerStack.ast("a.sol")
+	);
+	checkRoundTrip(ast);
+	BOOST_CHECK_LT(ASTBinary::encode(ast).size(), util::jsonCompactPrint(ast).size());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_input)
+{
+	string const encoded = ASTBinary::encode(Json::Value{"abc"});
+	BOOST_CHECK(!ASTBinary::isEncoded("{}"));
+	BOOST_CHECK_THROW(ASTBinary::decode("{}"), InvalidAstError);
+	BOOST_CHECK_THROW(ASTBinary::decode(ASTBinary::magic), InvalidAstError);
+	for (size_t length = ASTBinary::magic.size(); length < encoded.size(); ++length)
+		BOOST_CHECK_THROW(ASTBinary::decode(encoded.substr(0, length)), InvalidAstError);
+	BOOST_CHECK_THROW(ASTBinary::decode(encoded + '\0'), InvalidAstError);
+	// Empty string table followed by a reference to a string.
+	BOOST_CHECK_THROW(ASTBinary::decode(ASTBinary::magic + "\x00\x06\x00"s), InvalidAstError);
+	// Invalid tag.
+	BOOST_CHECK_THROW(ASTBinary::decode(ASTBinary::magic + "\x00\x7f"s), InvalidAstError);
+	// Array that claims to be larger than the input.
+	BOOST_CHECK_THROW(ASTBinary::decode(ASTBinary::magic + "\x00\x08\xff\x01"s), InvalidAstError);
+	// Varint that does not fit into 64 bits.
+	BOOST_CHECK_THROW(
+		ASTBinary::decode(ASTBinary::magic + "\x00\x03\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02"s),
+		InvalidAstError
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
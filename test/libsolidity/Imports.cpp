@@ -113,6 +113,26 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(remapping_longest_match)
+{
+	ImportRemapper remapper;
+	remapper.setRemappings({
+		{"", "x", "short"},
+		{"", "x/y", "long"},
+		{"a", "x", "context"},
+		{"a/b", "z", "other"},
+		{"", "x/y", "last"}
+	});
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "last/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/f.sol", "c/main.sol"), "short/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "a/main.sol"), "context/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "a/b/main.sol"), "context/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("z/f.sol", "a/b/main.sol"), "other/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("w/f.sol", "a/b/main.sol"), "w/f.sol");
+	remapper.clear();
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "x/y/f.sol");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,237 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for reusing the analysis of unchanged sources in CompilerStack.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+struct CompilerOutput
+{
+	bool success = false;
+	map<string, string> bytecode;
+	map<string, string> ir;
+	map<string, string> ast;
+	multiset<string> errors;
+};
+
+/// Settings of a compilation that are applied in addition to the defaults.
+using Configuration = function<void(CompilerStack&)>;
+
+CompilerOutput compile(CompilerStack& _compiler, StringMap const& _sources, Configuration const& _configure)
+{
+	_compiler.setSources(_sources);
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	// A new compiler stack and a reset one use different optimiser settings by default.
+	_compiler.setOptimiserSettings(OptimiserSettings::minimal());
+	if (_configure)
+		_configure(_compiler);
+
+	CompilerOutput output;
+	output.success = _compiler.compile();
+	if (output.success)
+	{
+		for (string const& contract: _compiler.contractNames())
+		{
+			output.bytecode[contract] = _compiler.object(contract).toHex();
+			output.ir[contract] = _compiler.yulIR(contract);
+		}
+		for (string const& source: _compiler.sourceNames())
+			output.ast[source] = util::jsonCompactPrint(
+				ASTJsonConverter(_compiler.state(), _compiler.sourceIndices()).toJson(_compiler.ast(source))
+			);
+	}
+	for (auto const& error: _compiler.errors())
+		output.errors.insert(SourceReferenceFormatter::formatErrorInformation(*error));
+	return output;
+}
+
+/// Compiles the given versions of the sources one after the other using incremental
+/// analysis and checks that each output is the same as the one of a fresh compilation.
+/// Each version is compiled with the configuration of the same index in @a _configurations,
+/// if there is one.
+/// @returns for each compilation the names of the sources whose analysis was reused.
+vector<set<string>> compileIncrementally(
+	vector<StringMap> const& _versions,
+	vector<Configuration> const& _configurations = {}
+)
+{
+	auto configuration = [&](size_t _index) {
+		return _index < _configurations.size() ? _configurations[_index] : Configuration{};
+	};
+
+	vector<CompilerOutput> expectations;
+	for (size_t i = 0; i < _versions.size(); ++i)
+	{
+		CompilerStack compiler;
+		expectations.emplace_back(compile(compiler, _versions[i], configuration(i)));
+	}
+
+	vector<set<string>> reusedSources;
+	map<string, SourceUnit const*> previousASTs;
+	CompilerStack compiler;
+	for (size_t i = 0; i < _versions.size(); ++i)
+	{
+		compiler.reset();
+		compiler.setIncrementalAnalysis();
+		CompilerOutput output = compile(compiler, _versions[i], configuration(i));
+		BOOST_CHECK_EQUAL(output.success, expectations[i].success);
+		BOOST_CHECK(output.bytecode == expectations[i].bytecode);
+		BOOST_CHECK(output.ir == expectations[i].ir);
+		BOOST_CHECK(output.ast == expectations[i].ast);
+		BOOST_CHECK(output.errors == expectations[i].errors);
+
+		// The ASTs of the previous compilation are still alive when parsing,
+		// so an AST at the same address is one that was taken over.
+		set<string> reused;
+		map<string, SourceUnit const*> asts;
+		for (string const& source: compiler.sourceNames())
+		{
+			asts[source] = &compiler.ast(source);
+			if (previousASTs.count(source) && previousASTs.at(source) == asts[source])
+				reused.insert(source);
+		}
+		reusedSources.emplace_back(move(reused));
+		previousASTs = move(asts);
+	}
+	return reusedSources;
+}
+
+string const baseSource = R"(
+	pragma solidity >=0.0;
+	contract Base {
+		function f() public pure virtual returns (uint) { return 1; }
+	}
+)";
+
+string const otherSource = R"(
+	pragma solidity >=0.0;
+	contract Other {
+		function g() public { uint x; }
+	}
+)";
+
+string const derivedSource = R"(
+	pragma solidity >=0.0;
+	import "A.sol";
+	contract C is Base {
+		function f() public pure override returns (uint) { return 2; }
+		function h() public returns (uint) { return new Base().f(); }
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysis)
+
+BOOST_AUTO_TEST_CASE(reuses_unchanged_sources)
+{
+	string changedDerivedSource = derivedSource;
+	boost::replace_all(changedDerivedSource, "return 2;", "return 3;");
+
+	vector<set<string>> reused = compileIncrementally({
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}},
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", changedDerivedSource}},
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", changedDerivedSource}}
+	});
+	BOOST_CHECK((reused[1] == set<string>{"A.sol", "B.sol"}));
+	BOOST_CHECK((reused[2] == set<string>{"A.sol", "B.sol", "C.sol"}));
+}
+
+BOOST_AUTO_TEST_CASE(analyses_importing_sources_again)
+{
+	string changedBaseSource = baseSource;
+	boost::replace_all(changedBaseSource, "return 1;", "return 5;");
+
+	vector<set<string>> reused = compileIncrementally({
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}},
+		{{"A.sol", changedBaseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}}
+	});
+	BOOST_CHECK((reused[1] == set<string>{"B.sol"}));
+}
+
+BOOST_AUTO_TEST_CASE(requires_same_node_ids)
+{
+	string changedBaseSource = baseSource;
+	boost::replace_all(changedBaseSource, "return 1;", "return 1 + 1;");
+
+	vector<set<string>> reused = compileIncrementally({
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}},
+		{{"A.sol", changedBaseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}},
+		{{"A.sol", changedBaseSource}, {"B.sol", otherSource}}
+	});
+	BOOST_CHECK(reused[1].empty());
+	BOOST_CHECK((reused[2] == set<string>{"A.sol", "B.sol"}));
+}
+
+BOOST_AUTO_TEST_CASE(failed_compilation)
+{
+	string invalidDerivedSource = derivedSource;
+	boost::replace_all(invalidDerivedSource, "return 2;", "return true;");
+
+	vector<set<string>> reused = compileIncrementally({
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}},
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", invalidDerivedSource}},
+		{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}}
+	});
+	BOOST_CHECK((reused[1] == set<string>{"A.sol", "B.sol"}));
+	BOOST_CHECK((reused[2] == set<string>{"A.sol", "B.sol"}));
+}
+
+BOOST_AUTO_TEST_CASE(code_generation_settings)
+{
+	StringMap const sources{{"A.sol", baseSource}, {"B.sol", otherSource}, {"C.sol", derivedSource}};
+	vector<set<string>> reused = compileIncrementally(
+		{sources, sources, sources, sources},
+		{
+			{},
+			[](CompilerStack& _compiler) { _compiler.enableIRGeneration(); },
+			[](CompilerStack& _compiler) { _compiler.setRevertStringBehaviour(RevertStrings::Strip); },
+			[](CompilerStack& _compiler) { _compiler.setLibraries({{"A.sol:Base", util::h160("0x0000000000000000000000000000000000001234")}}); }
+		}
+	);
+	for (size_t i = 1; i < reused.size(); ++i)
+		BOOST_CHECK((reused[i] == set<string>{"A.sol", "B.sol", "C.sol"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -25,6 +25,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/Version.h>
+#include <libevmasm/LinkerObject.h>
 #include <libsolc/libsolc.h>
 
 using namespace std;
@@ -65,6 +66,17 @@ Json::Value compile(string const& _input, CStyleReadFileCallback _callback = nul
 	return ret;
 }
 
+Json::Value link(string const& _input)
+{
+	char* output_ptr = solidity_link(_input.c_str());
+	string output(output_ptr);
+	solidity_free(output_ptr);
+	solidity_reset();
+	Json::Value ret;
+	BOOST_REQUIRE(util::jsonParseStrict(output, ret));
+	return ret;
+}
+
 char* stringToSolidity(string const& _input)
 {
 	char* ptr = solidity_alloc(_input.length());
@@ -179,6 +191,138 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(compiler_handles)
+{
+	auto input = [](string const& _content) {
+		return R"({
+			"language": "Solidity",
+			"sources": {
+				"a.sol": {"content": "import \"b.sol\"; contract A is B { function f() public pure returns (uint) { return g(); } }"},
+				"b.sol": {"content": ")" + _content + R"("}
+			},
+			"settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}
+		})";
+	};
+	auto compileWith = [](SolidityCompiler* _compiler, string const& _input) {
+		char* output_ptr = solidity_compile_with(_compiler, _input.c_str());
+		string output(output_ptr);
+		solidity_free(output_ptr);
+		return output;
+	};
+	auto compileFresh = [](string const& _input) {
+		char* output_ptr = solidity_compile(_input.c_str(), nullptr, nullptr);
+		string output(output_ptr);
+		solidity_free(output_ptr);
+		return output;
+	};
+	string const inputB1 = input("contract B { function g() internal pure returns (uint) { return 1; } }");
+	string const inputB2 = input("contract B { function g() internal pure returns (uint) { return 2; } }");
+
+	SolidityCompiler* first = solidity_create(nullptr, nullptr);
+	SolidityCompiler* second = solidity_create(nullptr, nullptr);
+	BOOST_REQUIRE(first && second);
+
+	// Reusing the analysis of the previous compilation and switching between compilers
+	// does not change the output.
+	string const expectation1 = compileFresh(inputB1);
+	string const expectation2 = compileFresh(inputB2);
+	BOOST_CHECK(expectation1 != expectation2);
+	BOOST_CHECK_EQUAL(compileWith(first, inputB1), expectation1);
+	BOOST_CHECK_EQUAL(compileWith(first, inputB1), expectation1);
+	BOOST_CHECK_EQUAL(compileWith(first, inputB2), expectation2);
+	BOOST_CHECK_EQUAL(compileWith(second, inputB1), expectation1);
+	BOOST_CHECK_EQUAL(compileWith(first, inputB2), expectation2);
+	BOOST_CHECK_EQUAL(compileFresh(inputB1), expectation1);
+	BOOST_CHECK_EQUAL(compileWith(second, inputB1), expectation1);
+
+	solidity_destroy(first);
+	BOOST_CHECK_EQUAL(compileWith(second, inputB2), expectation2);
+	solidity_destroy(second);
+	solidity_reset();
+}
+
+BOOST_AUTO_TEST_CASE(streaming_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {"content": "contract A { function f() public {} } contract B {}"}
+		},
+		"settings": {"outputSelection": {"*": {"*": ["abi", "evm.bytecode.object"]}}}
+	}
+	)";
+	auto write = [](void* _context, char const* _data, size_t _length) {
+		static_cast<string*>(_context)->append(_data, _length);
+	};
+
+	char* output_ptr = solidity_compile(input, nullptr, nullptr);
+	string const expectation(output_ptr);
+	solidity_free(output_ptr);
+
+	string output;
+	solidity_compile_streaming(input, nullptr, nullptr, write, &output);
+	BOOST_CHECK_EQUAL(output, expectation);
+
+	SolidityCompiler* compiler = solidity_create(nullptr, nullptr);
+	BOOST_REQUIRE(compiler);
+	output.clear();
+	solidity_compile_with_streaming(compiler, input, write, &output);
+	BOOST_CHECK_EQUAL(output, expectation);
+	solidity_destroy(compiler);
+	solidity_reset();
+}
+
+BOOST_AUTO_TEST_CASE(linking)
+{
+	string const placeholderL = "__" + evmasm::LinkerObject::libraryPlaceholder("a.sol:L") + "__";
+	string const placeholderM = "__" + evmasm::LinkerObject::libraryPlaceholder("a.sol:M") + "__";
+	string const input = R"(
+	{
+		"bytecodes": {
+			"A": "6073)" + placeholderL + R"(6000)" + placeholderM + R"(",
+			"B": "6001)" + placeholderL + R"(",
+			"C": "60__00",
+			"D": "6002"
+		},
+		"libraries": {
+			"a.sol:L": "0x1234567890123456789012345678901234567890"
+		},
+		"parallelism": 2
+	}
+	)";
+	Json::Value result = link(input);
+	BOOST_REQUIRE(result.isObject());
+	BOOST_CHECK_EQUAL(
+		result["bytecodes"]["A"].asString(),
+		"60731234567890123456789012345678901234567890" "6000" + placeholderM
+	);
+	BOOST_CHECK_EQUAL(result["bytecodes"]["B"].asString(), "60011234567890123456789012345678901234567890");
+	BOOST_CHECK_EQUAL(result["bytecodes"]["D"].asString(), "6002");
+	BOOST_CHECK(!result["bytecodes"].isMember("C"));
+	BOOST_CHECK_EQUAL(result["unresolvedReferences"]["A"]["48"].asString(), placeholderM);
+	BOOST_CHECK(!result["unresolvedReferences"].isMember("B"));
+	BOOST_CHECK(containsError(result, "LinkerError", "Invalid link reference in \"C\" at position 2."));
+}
+
+BOOST_AUTO_TEST_CASE(linking_invalid_input)
+{
+	Json::Value result = link("{");
+	BOOST_REQUIRE(result["errors"].isArray());
+	BOOST_CHECK_EQUAL(result["errors"][0]["type"].asString(), "JSONError");
+	BOOST_CHECK(containsError(link("{}"), "JSONError", "\"bytecodes\" must be an object."));
+	BOOST_CHECK(containsError(
+		link(R"({"bytecodes": {}, "libraries": {"L": "1234"}})"),
+		"JSONError",
+		"Invalid address for library \"L\"."
+	));
+	BOOST_CHECK(containsError(
+		link(R"({"bytecodes": {}, "parallelism": 0})"),
+		"JSONError",
+		"\"parallelism\" must be a positive integer."
+	));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
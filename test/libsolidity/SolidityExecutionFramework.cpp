@@ -48,6 +48,9 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 		entry.second = addPreamble(entry.second);
 
 	m_compiler.reset();
+	// The same sources are compiled again for every deployed contract and test configuration,
+	// which only differ in the settings of the code generation.
+	m_compiler.setIncrementalAnalysis();
 	m_compiler.enableEwasmGeneration(m_compileToEwasm);
 	m_compiler.setSources(sourcesWithPreamble);
 	m_compiler.setLibraries(_libraryAddresses);
@@ -573,6 +573,26 @@ BOOST_AUTO_TEST_CASE(complex_import)
 	BOOST_CHECK(successParse(text));
 }
 
+BOOST_AUTO_TEST_CASE(identifiers_share_names)
+{
+	ErrorList errors;
+	auto contract = parseText(R"(
+		contract C {
+			uint x;
+			function f() public view returns (uint) { return x; }
+		}
+	)", errors);
+	BOOST_REQUIRE(contract);
+	VariableDeclaration const& stateVariable = *contract->stateVariables().front();
+	FunctionDefinition const& function = *contract->definedFunctions().front();
+	auto const* returnStatement = dynamic_cast<Return const*>(function.body().statements().front().get());
+	BOOST_REQUIRE(returnStatement);
+	auto const* identifier = dynamic_cast<Identifier const*>(returnStatement->expression());
+	BOOST_REQUIRE(identifier);
+	BOOST_CHECK_EQUAL(identifier->name(), "x");
+	BOOST_CHECK(&identifier->name() == &stateVariable.name());
+}
+
 BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 {
 	auto sourceCode = std::string(R"(
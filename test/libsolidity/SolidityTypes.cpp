@@ -127,6 +127,23 @@ BOOST_AUTO_TEST_CASE(storage_layout_arrays)
 	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(32), 9).storageSize() == 9);
 }
 
+BOOST_AUTO_TEST_CASE(unique_types)
+{
+	Type const* uint8 = TypeProvider::uint(8);
+	BOOST_CHECK(TypeProvider::mapping(uint8, uint8) == TypeProvider::mapping(uint8, uint8));
+	BOOST_CHECK(TypeProvider::mapping(uint8, uint8) != TypeProvider::mapping(uint8, TypeProvider::uint256()));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8, 3) == TypeProvider::array(DataLocation::Memory, uint8, 3));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8, 3) != TypeProvider::array(DataLocation::Memory, uint8));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8) != TypeProvider::array(DataLocation::Storage, uint8));
+	BOOST_CHECK(TypeProvider::tuple({uint8, uint8}) == TypeProvider::tuple({uint8, uint8}));
+	BOOST_CHECK(
+		TypeProvider::withLocation(TypeProvider::bytesMemory(), DataLocation::Storage, true) ==
+		TypeProvider::withLocation(TypeProvider::bytesMemory(), DataLocation::Storage, true)
+	);
+	BOOST_CHECK(TypeProvider::typeType(uint8) == TypeProvider::typeType(uint8));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 2)) == TypeProvider::rationalNumber(rational(7, 2)));
+}
+
 BOOST_AUTO_TEST_CASE(type_identifier_escaping)
 {
 	BOOST_CHECK_EQUAL(Type::escapeIdentifier("("), "$_");
@@ -21,19 +21,31 @@
  */
 
 #include <string>
+#include <boost/algorithm/string.hpp>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/YulString.h>
 #include <test/Metadata.h>
+#include <test/TemporaryDirectory.h>
 
 #include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
 #include <set>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 using namespace solidity::evmasm;
+using solidity::test::TemporaryDirectory;
 
 namespace solidity::frontend::test
 {
@@ -269,6 +281,31 @@ BOOST_AUTO_TEST_CASE(smoke_test)
 	BOOST_CHECK(containsAtMostWarnings(result));
 }
 
+BOOST_AUTO_TEST_CASE(escaped_source_content)
+{
+	string const content = "// \"\xc3\xa9\" \xf0\x9f\x98\x80 \\ /\tx\ncontract A {}\n";
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A": {
+				"content": "// \"\u00e9\" \ud83d\ude00 \\ \/\tx\ncontract A {}\n",
+				"keccak256": "0x)" + util::keccak256(content).hex() + R"("
+			},
+			"B": {
+				"content": "contract B {}",
+				"keccak256": "0x)" + util::keccak256(content).hex() + R"("
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "IOError", "Mismatch between content and supplied hash for \"B\""));
+	BOOST_CHECK(!containsError(result, "IOError", "Mismatch between content and supplied hash for \"A\""));
+	BOOST_CHECK(result["sources"].isMember("A"));
+	BOOST_CHECK(!result["sources"].isMember("B"));
+}
+
 BOOST_AUTO_TEST_CASE(error_recovery_field)
 {
 	auto input = R"(
@@ -371,6 +408,32 @@ BOOST_AUTO_TEST_CASE(optimizer_runs_not_an_unsigned_number)
 	BOOST_CHECK(containsError(result, "JSONError", "The \"runs\" setting must be an unsigned number."));
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_execution_profile_not_an_unsigned_number)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": {
+				"enabled": true,
+				"executionProfile": { "fileA": { "A": { "f": -1 } } }
+			}
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.executionProfile.fileA.A.f\" must be an unsigned number"
+	));
+}
+
 BOOST_AUTO_TEST_CASE(basic_compilation)
 {
 	char const* input = R"(
@@ -1237,6 +1300,75 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_execution_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": {
+				"enabled": true,
+				"executionProfile": { "fileA": { "A": { "f": 10000 }, "": { "g": 1 } } }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "function g() {} contract A { function f() public { g(); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["metadata"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == true);
+	BOOST_CHECK(!optimizer.isMember("details"));
+	BOOST_CHECK(optimizer["executionProfile"]["fileA"]["A"]["f"].asUInt() == 10000);
+	BOOST_CHECK(optimizer["executionProfile"]["fileA"][""]["g"].asUInt() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(execution_profile_dispatch_order)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "evm.deployedBytecode.opcodes", "evm.methodIdentifiers" ] }
+			},
+			"optimizer": {
+				"executionProfile": { "fileA": { "A": { "f5": 100000 } } }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f0() public {} function f1() public {} function f2() public {} function f3() public {} function f4() public {} function f5() public {} function f6() public {} function f7() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	string opcodes = contract["evm"]["deployedBytecode"]["opcodes"].asString();
+	// The selector of the profiled function is the first one the dispatcher compares with.
+	size_t firstSelector = opcodes.find("PUSH4 ");
+	BOOST_REQUIRE(firstSelector != string::npos);
+	firstSelector += 6;
+	BOOST_CHECK_EQUAL(
+		u256(opcodes.substr(firstSelector, opcodes.find(' ', firstSelector) - firstSelector)),
+		u256("0x" + contract["evm"]["methodIdentifiers"]["f5()"].asString())
+	);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1769,6 +1901,9 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 			}
 		},
 		"settings": {
+			"optimizer": {
+				"details": { "peephole": false }
+			},
 			"outputSelection": {
 				"A.sol": {
 					"A": ["evm.bytecode.sourceMap"]
@@ -1787,6 +1922,7 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	string sourceMap = result["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["sourceMap"].asString();
 
 	// Check that the bare block's source location is referenced.
+	// The peephole optimiser is disabled, since it removes the whole constructor body.
 	string sourceRef =
 		";" +
 		to_string(string{"contract A { constructor() { uint x = 2; "}.size()) +
@@ -1795,6 +1931,698 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	for (string value: {"0", "-1", "\"4\"", "true"})
+	{
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+			"settings":
+			{
+				"parallelism": )" + value + R"(
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_output)
+{
+	auto input = [](unsigned _parallelism) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract D { uint x = 7; } contract C { function f() public returns (D) { return new D(); } } contract B { function g() public returns (C) { return new C(); } } contract E { uint y; }"
+				},
+				"B.sol": {
+					"content": "import \"A.sol\"; contract F is E { function h() public returns (address) { return address(new D()); } }"
+				}
+			},
+			"settings": {
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"optimizer": { "enabled": true },
+				"outputSelection": { "*": { "*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly"] } }
+			}
+		}
+		)";
+	};
+
+	Json::Value sequential = compile(input(1));
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_REQUIRE(sequential["contracts"]["A.sol"]["B"]["evm"]["bytecode"]["object"].isString());
+	for (unsigned parallelism: {2u, 8u})
+		BOOST_CHECK(util::jsonCompactPrint(compile(input(parallelism))) == util::jsonCompactPrint(sequential));
+}
+
+BOOST_AUTO_TEST_CASE(gas_estimation_upper_bound)
+{
+	auto input = [](string const& _gasEstimation) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "pragma solidity >=0.0; contract C { uint x; function f() public returns (uint) { return g(); } function g() internal returns (uint) { x = 2; return x; } function h() public pure returns (uint) { return 1; } }"
+				}
+			},
+			"settings": {
+				"gasEstimation": ")" + _gasEstimation + R"(",
+				"outputSelection": { "*": { "*": [ "evm.gasEstimates" ] } }
+			}
+		}
+		)";
+	};
+
+	Json::Value perFunction = compile(input("perFunction"));
+	BOOST_REQUIRE(containsAtMostWarnings(perFunction));
+	Json::Value upperBound = compile(input("upperBound"));
+	BOOST_REQUIRE(containsAtMostWarnings(upperBound));
+
+	Json::Value const& estimates = upperBound["contracts"]["A.sol"]["C"]["evm"]["gasEstimates"];
+	BOOST_REQUIRE(estimates.isObject());
+	BOOST_CHECK(estimates["creation"] == perFunction["contracts"]["A.sol"]["C"]["evm"]["gasEstimates"]["creation"]);
+	string const bound = estimates["external"]["f()"].asString();
+	BOOST_CHECK(estimates["external"]["h()"].asString() == bound);
+	BOOST_CHECK(estimates["internal"]["g()"].asString() == bound);
+	BOOST_REQUIRE(bound != "infinite");
+
+	Json::Value const& precise = perFunction["contracts"]["A.sol"]["C"]["evm"]["gasEstimates"];
+	for (string kind: {"external", "internal"})
+		for (string const& function: precise[kind].getMemberNames())
+		{
+			string const estimate = precise[kind][function].asString();
+			BOOST_REQUIRE(estimate != "infinite");
+			BOOST_CHECK(u256(estimate) <= u256(bound));
+		}
+
+	Json::Value result = compile(input("perStatement"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.gasEstimation\" must be \"perFunction\" or \"upperBound\"."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_parsing)
+{
+	// Sources are parsed concurrently and imports are read ahead of time, which must not change
+	// the node IDs, the order of the errors or which files are read. The read callback is
+	// only called from the thread that calls the compiler.
+	map<string, string> const files{
+		{"lib/X.sol", "pragma solidity >=0.0; import \"lib/Y.sol\"; contract X is Y {}"},
+		{"lib/Y.sol", "pragma solidity >=0.0; contract Y { function y() public {} }"},
+		{"lib/Z.sol", "pragma solidity >=0.0; import \"lib/Y.sol\"; import \"lib/missing.sol\"; contract Z {}"}
+	};
+	auto compileWith = [&](unsigned _parallelism, string const& _invalidSource) {
+		mutex readsMutex;
+		multiset<string> reads;
+		thread::id const callingThread = this_thread::get_id();
+		frontend::StandardCompiler compiler([&](string const&, string const& _path) {
+			lock_guard<mutex> lock(readsMutex);
+			BOOST_CHECK(this_thread::get_id() == callingThread);
+			reads.insert(_path);
+			if (files.count(_path))
+				return frontend::ReadCallback::Result{true, files.at(_path)};
+			return frontend::ReadCallback::Result{false, "not found"};
+		});
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] = "pragma solidity >=0.0; import \"lib/X.sol\"; contract A is X {}";
+		input["sources"]["B.sol"]["content"] = "pragma solidity >=0.0; import \"lib/Z.sol\"; import \"lib/X.sol\"; contract B {}";
+		input["sources"]["C.sol"]["content"] = _invalidSource;
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		string output = util::jsonCompactPrint(compiler.compile(input));
+		return make_pair(output, reads);
+	};
+
+	for (string invalidSource: {"contract C {}", "contract C { function }", "import \"D.sol\"; contract C {}"})
+	{
+		auto const sequential = compileWith(1, invalidSource);
+		for (unsigned parallelism: {2u, 8u})
+		{
+			auto const parallel = compileWith(parallelism, invalidSource);
+			BOOST_CHECK_EQUAL(parallel.first, sequential.first);
+			BOOST_CHECK(parallel.second == sequential.second);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_parsing_missing_import)
+{
+	// A file that is not found is read again for every import of it, also if it was read ahead of time.
+	auto compileWith = [&](unsigned _parallelism) {
+		mutex readsMutex;
+		multiset<string> reads;
+		frontend::StandardCompiler compiler([&](string const&, string const& _path) {
+			lock_guard<mutex> lock(readsMutex);
+			reads.insert(_path);
+			return frontend::ReadCallback::Result{false, "not found"};
+		});
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] = "pragma solidity >=0.0; import \"missing.sol\"; contract A {}";
+		input["sources"]["B.sol"]["content"] = "pragma solidity >=0.0; import \"missing.sol\"; contract B {}";
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		Json::Value output = compiler.compile(input);
+		return make_pair(output, reads);
+	};
+
+	for (unsigned parallelism: {1u, 2u, 8u})
+	{
+		auto const [output, reads] = compileWith(parallelism);
+		BOOST_CHECK_EQUAL(reads.count("missing.sol"), 2u);
+		BOOST_REQUIRE(output["errors"].isArray());
+		BOOST_REQUIRE_EQUAL(output["errors"].size(), 2u);
+		for (auto const& error: output["errors"])
+			BOOST_CHECK_EQUAL(error["message"].asString(), "Source \"missing.sol\" not found: not found");
+		BOOST_CHECK_EQUAL(output["errors"][0]["sourceLocation"]["file"].asString(), "A.sol");
+		BOOST_CHECK_EQUAL(output["errors"][1]["sourceLocation"]["file"].asString(), "B.sol");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(output_selection_subsets)
+{
+	// Outputs that are not requested are not generated at all, which must not affect the ones that are.
+	auto input = [](vector<string> const& _outputs) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] =
+			"pragma solidity >=0.0;\n"
+			"contract D { uint immutable x = 7; function g() public view returns (uint) { return x; } }\n"
+			"contract C { function f() public returns (D) { return new D(); } }";
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		for (string const& output: _outputs)
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		return util::jsonCompactPrint(input);
+	};
+
+	vector<string> const outputs{
+		"abi", "ir", "irOptimized", "evm.assembly", "evm.gasEstimates",
+		"evm.bytecode.object", "evm.bytecode.sourceMap", "evm.bytecode.generatedSources",
+		"evm.deployedBytecode.object", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.immutableReferences"
+	};
+	Json::Value full = compile(input(outputs));
+	BOOST_REQUIRE(containsAtMostWarnings(full));
+
+	for (string const& output: outputs)
+	{
+		Json::Value result = compile(input({output}));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		for (string contract: {"C", "D"})
+		{
+			Json::Value const* expectation = &full["contracts"]["A.sol"][contract];
+			Json::Value const* actual = &result["contracts"]["A.sol"][contract];
+			vector<string> path;
+			boost::split(path, output, boost::is_any_of("."));
+			for (string const& key: path)
+			{
+				BOOST_REQUIRE(actual->isMember(key));
+				expectation = &(*expectation)[key];
+				actual = &(*actual)[key];
+			}
+			BOOST_CHECK_MESSAGE(
+				util::jsonCompactPrint(*actual) == util::jsonCompactPrint(*expectation),
+				"Different " + output + " of " + contract
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ast_independent_of_bytecode_output)
+{
+	// Parameters that the code generators keep in calldata have their declared types in the AST.
+	auto input = [](bool _viaIR, vector<string> const& _outputs) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] =
+			"pragma solidity >=0.0;\n"
+			"contract C {\n"
+			"  function f(bytes memory b, uint[] memory a) external pure returns (uint, bytes32) {\n"
+			"    return (b.length + a[0], keccak256(b));\n"
+			"  }\n"
+			"}";
+		input["settings"]["viaIR"] = _viaIR;
+		input["settings"]["optimizer"]["details"]["calldataParameters"] = true;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		for (string const& output: _outputs)
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		return util::jsonCompactPrint(input);
+	};
+
+	for (bool viaIR: {false, true})
+	{
+		Json::Value astOnly = compile(input(viaIR, {}));
+		BOOST_REQUIRE(containsAtMostWarnings(astOnly));
+		Json::Value withBytecode = compile(input(viaIR, {"evm.bytecode"}));
+		BOOST_REQUIRE(containsAtMostWarnings(withBytecode));
+		BOOST_REQUIRE(withBytecode["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].isString());
+
+		string const ast = util::jsonCompactPrint(withBytecode["sources"]["A.sol"]["ast"]);
+		BOOST_CHECK_EQUAL(ast, util::jsonCompactPrint(astOnly["sources"]["A.sol"]["ast"]));
+		BOOST_CHECK(ast.find("calldata") == string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_independent_of_earlier_compilations)
+{
+	// The constant optimisers share representations between compilations,
+	// which must not change the bytecode of later compilations.
+	vector<string> const constants{
+		"0xff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00",
+		"0x00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff0100",
+		"0x0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100",
+		"0xff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff01",
+		"0x00ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff0100ff010000",
+		"0x0100ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00",
+		"0xff00ff0100ff00ff0100ff00ff0100ff00ff0100ff00ff0100ff00ff0100ff00"
+	};
+	auto input = [&](bool _viaIR, size_t _first, size_t _last) {
+		string source = "pragma solidity >=0.0;\ncontract C {\n  mapping(uint => uint) x;\n  function f() external {\n";
+		for (size_t i = _first; i < _last; ++i)
+			source += "    x[" + to_string(i) + "] = " + constants[i] + ";\n";
+		source += "  }\n}";
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] = source;
+		input["settings"]["viaIR"] = _viaIR;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+		return util::jsonCompactPrint(input);
+	};
+	auto bytecode = [](Json::Value const& _result) {
+		BOOST_REQUIRE(containsAtMostWarnings(_result));
+		return _result["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].asString();
+	};
+
+	for (bool viaIR: {false, true})
+	{
+		// Clears the shared representations.
+		yul::YulStringRepository::reset();
+		string const alone = bytecode(compile(input(viaIR, 3, constants.size())));
+		yul::YulStringRepository::reset();
+		compile(input(viaIR, 0, 4));
+		string const afterOther = bytecode(compile(input(viaIR, 3, constants.size())));
+		BOOST_CHECK_EQUAL(afterOther, alone);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(code_size_warning_before_later_code_generation_error)
+{
+	// The contracts are assembled after the code generation of all contracts, but the warning
+	// about the size of A is still reported before the error in the code generation of B.
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["sources"]["A.sol"]["content"] =
+		"pragma solidity >=0.0;\n"
+		"contract A {\n"
+		"  function f() public pure returns (string memory r) {\n"
+		"    r = \"" + string(27000, '.') + "\";\n"
+		"  }\n"
+		"}\n"
+		"contract B {\n"
+		"  function g() public pure {\n"
+		"    ufixed a = uint64(1) + ufixed(2);\n"
+		"    a;\n"
+		"  }\n"
+		"}";
+	input["settings"]["outputSelection"]["*"]["*"][0] = "ir";
+	input["settings"]["outputSelection"]["*"]["*"][1] = "evm.bytecode.object";
+	Json::Value result = compile(util::jsonCompactPrint(input));
+
+	vector<string> errorCodes;
+	for (Json::Value const& error: result["errors"])
+		if (error["errorCode"] == "5574" || error["errorCode"] == "1834")
+			errorCodes.push_back(error["errorCode"].asString());
+	BOOST_CHECK((errorCodes == vector<string>{"5574", "1834"}));
+}
+
+BOOST_AUTO_TEST_CASE(calldata_parameters_near_stack_limit)
+{
+	// A calldata array takes one more stack slot than a memory array, so the parameters of a
+	// function close to the stack limit stay in memory.
+	auto deployedBytecode = [](string const& _function, bool _calldataParameters) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] =
+			"pragma solidity >=0.0;\n"
+			"contract C {\n" + _function + "}";
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["optimizer"]["details"]["calldataParameters"] = _calldataParameters;
+		input["settings"]["metadata"]["bytecodeHash"] = "none";
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.deployedBytecode.object";
+		Json::Value result = compile(util::jsonCompactPrint(input));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["contracts"]["A.sol"]["C"]["evm"]["deployedBytecode"]["object"].isString());
+		return result["contracts"]["A.sol"]["C"]["evm"]["deployedBytecode"]["object"].asString();
+	};
+
+	string const small =
+		"  function f(uint[] memory a) external pure returns (uint) {\n"
+		"    return a[0] + a.length;\n"
+		"  }\n";
+	BOOST_CHECK(deployedBytecode(small, true) != deployedBytecode(small, false));
+
+	string const nearLimit =
+		"  function f(\n"
+		"    uint[] memory a, uint b, uint c, uint d, uint e, uint g, uint h,\n"
+		"    uint i, uint j, uint k, uint l, uint m, uint n\n"
+		"  ) external pure returns (uint r) {\n"
+		"    r = a[0] + a.length + b + c + d + e + g + h + i + j + k + l + m + n;\n"
+		"  }\n";
+	BOOST_CHECK_EQUAL(deployedBytecode(nearLimit, true), deployedBytecode(nearLimit, false));
+}
+
+BOOST_AUTO_TEST_CASE(streaming_output)
+{
+	vector<string> const inputs{
+		"{",
+		R"({"language": "Solidity", "sources": {"A.sol": {"content": "contract C { function f() public { uint x; } }"}}})",
+		R"({
+			"language": "Solidity",
+			"sources": {
+				"B.sol": {"content": "pragma solidity >=0.0; import \"A.sol\"; contract D is C {} contract B { C c; }"},
+				"A.sol": {"content": "pragma solidity >=0.0; contract C { function f() public { uint x; } } contract A {}"},
+				"b:\"c.sol": {"content": "pragma solidity >=0.0; contract E {}"}
+			},
+			"settings": {
+				"outputSelection": {
+					"*": { "*": ["abi", "evm.bytecode.object"], "": ["ast"] },
+					"A.sol": { "C": ["evm.assembly"] },
+					"B.sol": { "D": [] }
+				}
+			}
+		})",
+		R"({
+			"language": "Solidity",
+			"sources": {"A.sol": {"content": "pragma solidity >=0.0; contract C { function f() public { x = 1; } }"}},
+			"settings": { "outputSelection": { "*": { "*": ["*"], "": ["*"] } } }
+		})",
+		R"({
+			"language": "Yul",
+			"sources": {"A.yul": {"content": "{ sstore(0, 1) }"}},
+			"settings": { "outputSelection": { "*": { "*": ["*"] } } }
+		})"
+	};
+
+	for (string const& input: inputs)
+	{
+		frontend::StandardCompiler compiler;
+		string const expectation = compiler.compile(input);
+		stringstream output;
+		compiler.compile(input, output);
+		BOOST_CHECK_EQUAL(output.str(), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_invalid)
+{
+	for (string value: {"\"\"", "1", "true", "{}"})
+	{
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+			"settings":
+			{
+				"cache": )" + value + R"(
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.cache\" must be a non-empty string."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_same_output)
+{
+	TemporaryDirectory cacheDirectory;
+	auto input = [&](bool _useCache) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] =
+			"pragma solidity >=0.0; pragma abicoder v1;\n"
+			"library L { function f() public returns (uint) { return 1; } }\n"
+			"contract D { uint immutable x = 7; function g() public view returns (uint) { return x; } }\n"
+			"contract C { function f() public returns (D, uint) { return (new D(), L.f()); } }";
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		// The generated sources, which are part of "evm.bytecode", cannot be taken from the cache.
+		for (string output: {
+			"abi", "metadata", "ir", "irOptimized",
+			"evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences",
+			"evm.deployedBytecode.object", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.immutableReferences"
+		})
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		if (_useCache)
+			input["settings"]["cache"] = cacheDirectory.path().string();
+		return util::jsonCompactPrint(input);
+	};
+
+	Json::Value expectation = compile(input(false));
+	BOOST_REQUIRE(containsAtMostWarnings(expectation));
+	BOOST_REQUIRE(expectation["errors"].size() > 1);
+	BOOST_REQUIRE(boost::filesystem::is_empty(cacheDirectory.path()));
+
+	// The first compilation fills the cache and the second one is served by it.
+	for (size_t i = 0; i < 2; ++i)
+	{
+		BOOST_CHECK(util::jsonCompactPrint(compile(input(true))) == util::jsonCompactPrint(expectation));
+		BOOST_CHECK(!boost::filesystem::is_empty(cacheDirectory.path()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_is_used)
+{
+	TemporaryDirectory cacheDirectory;
+	auto input = [&](vector<string> const& _outputs) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] = "pragma solidity >=0.0; contract C { function f() public {} }";
+		input["settings"]["cache"] = cacheDirectory.path().string();
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		for (string const& output: _outputs)
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		return util::jsonCompactPrint(input);
+	};
+
+	Json::Value result = compile(input({"irOptimized", "evm.bytecode.object"}));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	string const irOptimized = result["contracts"]["A.sol"]["C"]["irOptimized"].asString();
+	BOOST_REQUIRE(!irOptimized.empty());
+
+	// Modify the cache to be able to tell whether it is used.
+	for (auto const& file: boost::filesystem::directory_iterator(cacheDirectory.path()))
+	{
+		Json::Value entry;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(file.path().string()), entry));
+		entry["irOptimized"] = "/* cached */";
+		ofstream(file.path().string(), ios::trunc) << util::jsonCompactPrint(entry);
+	}
+
+	result = compile(input({"irOptimized", "evm.bytecode.object"}));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["C"]["irOptimized"].asString(), "/* cached */");
+
+	// Assembly outputs are not stored, so the contract has to be compiled again.
+	result = compile(input({"irOptimized", "evm.bytecode.object", "evm.assembly"}));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["C"]["irOptimized"].asString(), irOptimized);
+}
+
+BOOST_AUTO_TEST_CASE(profile_invalid)
+{
+	for (string value: {"1", "\"true\"", "{}"})
+	{
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+			"settings":
+			{
+				"debug": { "profile": )" + value + R"( }
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.debug.profile\" must be a Boolean."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(profile)
+{
+	auto input = [](bool _profile) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "contract D { uint x = 7; } contract C { function f() public returns (D) { return new D(); } }" }
+			},
+			"settings": {
+				"optimizer": { "enabled": true },
+				"debug": { "profile": )" + string(_profile ? "true" : "false") + R"( },
+				"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+			}
+		}
+		)";
+	};
+
+	Json::Value result = compile(input(false));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("profile"));
+	BOOST_CHECK(!result.isMember("performanceCounters"));
+
+	result = compile(input(true));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json::Value const& profile = result["profile"];
+	BOOST_REQUIRE(profile.isObject());
+	BOOST_CHECK_EQUAL(profile.size(), 3);
+	auto phaseNames = [&](string const& _scope) {
+		set<string> names;
+		for (Json::Value const& phase: profile[_scope])
+		{
+			BOOST_CHECK(phase["count"].isUInt64() && phase["count"].asUInt64() > 0);
+			BOOST_CHECK(phase["wallTime"].isNumeric() && phase["wallTime"].asDouble() >= 0);
+			BOOST_CHECK(phase["cpuTime"].isNumeric() && phase["cpuTime"].asDouble() >= 0);
+			BOOST_CHECK(phase["peakMemoryIncrease"].isUInt64());
+			names.insert(phase["name"].asString());
+		}
+		return names;
+	};
+	set<string> const common = phaseNames("");
+	for (string name: {"parsing", "import resolution", "analysis", "analysis/type checker", "analysis/static analyzer"})
+		BOOST_CHECK_MESSAGE(common.count(name), name);
+	for (string contract: {"A.sol:C", "A.sol:D"})
+	{
+		set<string> const names = phaseNames(contract);
+		for (string name: {
+			"code generation",
+			"code generation/EVM assembly optimiser",
+			"code generation/EVM assembly optimiser/peephole optimiser",
+			"assembly"
+		})
+			BOOST_CHECK_MESSAGE(names.count(name), contract + ": " + name);
+	}
+	BOOST_CHECK(result["yulOptimizerSteps"].isObject());
+	BOOST_CHECK(result["performanceCounters"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(profile_yul_optimizer_steps)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract C { function f(uint a) public pure returns (uint) { return a * 2; } }" }
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"viaIR": true,
+			"debug": { "profile": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json::Value const& steps = result["yulOptimizerSteps"]["A.sol:C"];
+	BOOST_REQUIRE(steps.isArray() && !steps.empty());
+	set<string> objects;
+	for (Json::Value const& step: steps)
+	{
+		BOOST_CHECK(yul::OptimiserSuite::allSteps().count(step["name"].asString()));
+		BOOST_CHECK(step["codeSizeBefore"].isUInt64() && step["codeSizeAfter"].isUInt64());
+		BOOST_CHECK(step["codeCostBefore"].isUInt64() && step["codeCostAfter"].isUInt64());
+		BOOST_CHECK(step["wallTime"].isNumeric() && step["wallTime"].asDouble() >= 0);
+		objects.insert(step["object"].asString());
+	}
+	BOOST_CHECK_EQUAL(objects.size(), 2);
+	// The sizes of consecutive steps on the same object match. The objects are optimized again
+	// when generating the bytecode, after their sub-objects, and are modified in between.
+	for (Json::ArrayIndex i = 1; i < steps.size(); ++i)
+		if (steps[i - 1]["object"] == steps[i]["object"])
+			BOOST_CHECK_EQUAL(steps[i - 1]["codeSizeAfter"].asUInt64(), steps[i]["codeSizeBefore"].asUInt64());
+#ifndef SOL_PERF_COUNTERS_DISABLED
+	Json::Value const& counters = result["performanceCounters"]["A.sol:C"];
+	BOOST_REQUIRE(counters.isObject());
+	BOOST_CHECK(counters["yul.SimplificationRules.findFirstMatch.attempts"].asUInt64() > 0);
+	BOOST_CHECK(counters["yul.DataFlowAnalyzer.knowledgeForks"].isUInt64());
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(trace)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract C { function f(uint a) public pure returns (uint) { return a * 2; } }" }
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"viaIR": true,
+			"debug": { "trace": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("profile"));
+	BOOST_CHECK(!result.isMember("yulOptimizerSteps"));
+	BOOST_CHECK_EQUAL(result["trace"]["displayTimeUnit"].asString(), "ms");
+	Json::Value const& events = result["trace"]["traceEvents"];
+	BOOST_REQUIRE(events.isArray() && !events.empty());
+	set<string> scopes;
+	set<string> phases;
+	set<string> objects;
+	for (Json::Value const& event: events)
+	{
+		BOOST_CHECK_EQUAL(event["ph"].asString(), "X");
+		BOOST_CHECK(event["ts"].isNumeric() && event["ts"].asDouble() >= 0);
+		BOOST_CHECK(event["dur"].isNumeric() && event["dur"].asDouble() >= 0);
+		BOOST_CHECK(event["tid"].isUInt64());
+		if (event["cat"].asString() == "scope")
+			scopes.insert(event["name"].asString());
+		else
+		{
+			BOOST_CHECK_EQUAL(event["cat"].asString(), "phase");
+			phases.insert(event["name"].asString());
+		}
+		if (event["args"].isMember("object"))
+			objects.insert(event["args"]["object"].asString());
+	}
+	BOOST_CHECK(scopes == set<string>{"A.sol:C"});
+	for (string name: {"parsing", "analysis", "type checker", "IR generation", "Yul optimiser"})
+		BOOST_CHECK_MESSAGE(phases.count(name), name);
+	BOOST_CHECK_EQUAL(objects.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(trace_invalid)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"debug": { "trace": 1 }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.debug.trace\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
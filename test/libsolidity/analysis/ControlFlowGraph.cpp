@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the control flow graphs stored in the annotations of functions.
+
+#include <libsolidity/analysis/ControlFlowGraph.h>
+
+#include <test/Common.h>
+#include <test/libsolidity/util/SoltestErrors.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+unique_ptr<CompilerStack> parseAndAnalyze(string _sourceCode)
+{
+	auto compilerStack = make_unique<CompilerStack>();
+	compilerStack->setSources({{"", move(_sourceCode)}});
+	bool success = compilerStack->parseAndAnalyze();
+	soltestAssert(success, "");
+	return compilerStack;
+}
+
+FunctionDefinition const& findFunction(CompilerStack const& _compilerStack, string const& _name)
+{
+	FunctionDefinition const* result = nullptr;
+	for (auto const& node: _compilerStack.ast("").nodes())
+	{
+		if (auto const* function = dynamic_cast<FunctionDefinition const*>(node.get()))
+			if (function->name() == _name)
+				result = function;
+		if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			for (FunctionDefinition const* function: contract->definedFunctions())
+				if (function->name() == _name)
+					result = function;
+	}
+	soltestAssert(result, "Function not found.");
+	return *result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ControlFlowGraphTest)
+
+BOOST_AUTO_TEST_CASE(function_flows_in_annotations)
+{
+	unique_ptr<CompilerStack> compilerStack = parseAndAnalyze(R"(
+		function free(uint x) pure returns (uint) { return x; }
+		contract B { function f() public virtual returns (uint) { return 1; } }
+		contract C is B { function g() public pure { revert(); } }
+	)");
+	ContractDefinition const& b = compilerStack->contractDefinition(":B");
+	ContractDefinition const& c = compilerStack->contractDefinition(":C");
+
+	auto const& freeFlows = findFunction(*compilerStack, "free").annotation().controlFlow;
+	BOOST_REQUIRE_EQUAL(freeFlows.size(), 1);
+	BOOST_REQUIRE(freeFlows.count(nullptr));
+	BOOST_CHECK(!freeFlows.at(nullptr)->exit->entries.empty());
+
+	// Inherited functions have a flow for every contract that derives from their contract.
+	auto const& fFlows = findFunction(*compilerStack, "f").annotation().controlFlow;
+	BOOST_CHECK_EQUAL(fFlows.size(), 2);
+	BOOST_CHECK(fFlows.count(&b) && fFlows.count(&c));
+
+	auto const& gFlows = findFunction(*compilerStack, "g").annotation().controlFlow;
+	BOOST_REQUIRE_EQUAL(gFlows.size(), 1);
+	BOOST_REQUIRE(gFlows.count(&c));
+	BOOST_CHECK(!gFlows.at(&c)->revert->entries.empty());
+}
+
+BOOST_AUTO_TEST_CASE(no_function_flows_for_unimplemented_functions)
+{
+	unique_ptr<CompilerStack> compilerStack = parseAndAnalyze(R"(
+		abstract contract A { function f() public virtual; }
+	)");
+	BOOST_CHECK(findFunction(*compilerStack, "f").annotation().controlFlow.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
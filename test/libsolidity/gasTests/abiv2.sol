@@ -14,13 +14,13 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 1259800
-//   executionCost: 1308
-//   totalCost: 1261108
+//   codeDepositCost: 1250000
+//   executionCost: 1302
+//   totalCost: 1251302
 // external:
 //   a(): 2430
-//   b(uint256): infinite
-//   f1(uint256): infinite
+//   b(uint256): 4822
+//   f1(uint256): 490
 //   f2(uint256[],string[],uint16,address): infinite
 //   f3(uint16[],string[],uint16,address): infinite
 //   f4(uint32[],string[12],bytes[2][],address): infinite
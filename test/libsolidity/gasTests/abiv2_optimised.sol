@@ -17,9 +17,9 @@ contract C {
 // optimize-yul: true
 // ----
 // creation:
-//   codeDepositCost: 680600
-//   executionCost: 715
-//   totalCost: 681315
+//   codeDepositCost: 677800
+//   executionCost: 708
+//   totalCost: 678508
 // external:
 //   a(): 2285
 //   b(uint256): 4652
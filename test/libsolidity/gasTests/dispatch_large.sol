@@ -24,29 +24,29 @@ contract Large {
 }
 // ----
 // creation:
-//   codeDepositCost: 640200
-//   executionCost: 676
-//   totalCost: 640876
+//   codeDepositCost: 629400
+//   executionCost: 664
+//   totalCost: 630064
 // external:
 //   a(): 2475
-//   b(uint256): infinite
-//   f0(uint256): infinite
-//   f1(uint256): infinite
-//   f2(uint256): infinite
-//   f3(uint256): infinite
-//   f4(uint256): infinite
-//   f5(uint256): infinite
-//   f6(uint256): infinite
-//   f7(uint256): infinite
-//   f8(uint256): infinite
-//   f9(uint256): infinite
-//   g0(uint256): infinite
-//   g1(uint256): infinite
-//   g2(uint256): infinite
-//   g3(uint256): infinite
-//   g4(uint256): infinite
-//   g5(uint256): infinite
-//   g6(uint256): infinite
-//   g7(uint256): infinite
-//   g8(uint256): infinite
-//   g9(uint256): infinite
+//   b(uint256): 4800
+//   f0(uint256): 581
+//   f1(uint256): 47006
+//   f2(uint256): 24847
+//   f3(uint256): 24935
+//   f4(uint256): 24913
+//   f5(uint256): 24891
+//   f6(uint256): 24914
+//   f7(uint256): 24826
+//   f8(uint256): 24826
+//   f9(uint256): 24848
+//   g0(uint256): 467
+//   g1(uint256): 46961
+//   g2(uint256): 24824
+//   g3(uint256): 24912
+//   g4(uint256): 24890
+//   g5(uint256): 24846
+//   g6(uint256): 24869
+//   g7(uint256): 24868
+//   g8(uint256): 24846
+//   g9(uint256): 24803
@@ -11,16 +11,16 @@ contract Medium {
 }
 // ----
 // creation:
-//   codeDepositCost: 269600
-//   executionCost: 312
-//   totalCost: 269912
+//   codeDepositCost: 258800
+//   executionCost: 300
+//   totalCost: 259100
 // external:
 //   a(): 2452
-//   b(uint256): infinite
-//   f1(uint256): infinite
-//   f2(uint256): infinite
-//   f3(uint256): infinite
-//   g0(uint256): infinite
-//   g7(uint256): infinite
-//   g8(uint256): infinite
-//   g9(uint256): infinite
+//   b(uint256): 4800
+//   f1(uint256): 46917
+//   f2(uint256): 24847
+//   f3(uint256): 24891
+//   g0(uint256): 467
+//   g7(uint256): 24846
+//   g8(uint256): 24824
+//   g9(uint256): 24780
@@ -6,11 +6,11 @@ contract Small {
 }
 // ----
 // creation:
-//   codeDepositCost: 108800
-//   executionCost: 153
-//   totalCost: 108953
+//   codeDepositCost: 98000
+//   executionCost: 147
+//   totalCost: 98147
 // external:
 //   fallback: 129
 //   a(): 2407
-//   b(uint256): infinite
-//   f1(uint256): infinite
+//   b(uint256): 4756
+//   f1(uint256): 46917
@@ -19,11 +19,11 @@ contract C {
 // optimize-yul: false
 // ----
 // creation:
-//   codeDepositCost: 110800
-//   executionCost: 159
-//   totalCost: 110959
+//   codeDepositCost: 100000
+//   executionCost: 147
+//   totalCost: 100147
 // external:
-//   exp_neg_one(uint256): 2259
-//   exp_one(uint256): infinite
-//   exp_two(uint256): infinite
-//   exp_zero(uint256): infinite
+//   exp_neg_one(uint256): 2111
+//   exp_one(uint256): 2067
+//   exp_two(uint256): 2045
+//   exp_zero(uint256): 2089
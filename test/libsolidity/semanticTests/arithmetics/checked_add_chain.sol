@@ -0,0 +1,20 @@
+contract C {
+    uint8 s = 100;
+    function f(uint8 a, uint8 b, uint8 c) public view returns (uint8) {
+        return a + b + c + s + 1;
+    }
+    function g(uint248 a, uint248 b) public pure returns (uint248) {
+        return a + b + 1;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint8,uint8,uint8): 1, 2, 3 -> 107
+// f(uint8,uint8,uint8): 50, 50, 54 -> 255
+// f(uint8,uint8,uint8): 50, 50, 55 -> FAILURE, hex"4e487b71", 0x11
+// f(uint8,uint8,uint8): 255, 255, 255 -> FAILURE, hex"4e487b71", 0x11
+// f(uint8,uint8,uint8): 0, 0, 0 -> 101
+// g(uint248,uint248): 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe, 0 -> 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+// g(uint248,uint248): 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff, 0 -> FAILURE, hex"4e487b71", 0x11
+// g(uint248,uint248): 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff, 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff -> FAILURE, hex"4e487b71", 0x11
@@ -0,0 +1,25 @@
+contract C {
+    function f(bytes memory a, bytes2 b, uint16 c) public returns (bool, bool, bool) {
+        bytes memory concatenated = bytes.concat(a, b, "xyz");
+        bytes memory packed = abi.encodePacked(a, b, c, "xyz");
+        return (
+            keccak256(bytes.concat(a, b, "xyz")) == keccak256(concatenated),
+            keccak256(abi.encodePacked(a, b, c, "xyz")) == keccak256(packed),
+            keccak256(abi.encodePacked("ab", hex"6364")) == keccak256("abcd")
+        );
+    }
+    function g(bytes calldata a) public returns (bytes32, uint) {
+        uint freeMemoryPointer;
+        assembly { freeMemoryPointer := mload(0x40) }
+        bytes32 hash = keccak256(bytes.concat(a, a));
+        uint newFreeMemoryPointer;
+        assembly { newFreeMemoryPointer := mload(0x40) }
+        return (hash ^ keccak256(abi.encodePacked(a, a)), newFreeMemoryPointer - freeMemoryPointer);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(bytes,bytes2,uint16): 0x60, "ab", 7, 3, "abc" -> true, true, true
+// f(bytes,bytes2,uint16): 0x60, "ab", 7, 40, "abcdabcdabcdabcdabcdabcdabcdabcd", "abcdabcd" -> true, true, true
+// g(bytes): 0x20, 5, "hello" -> 0, 0
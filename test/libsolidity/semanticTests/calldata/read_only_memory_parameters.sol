@@ -0,0 +1,23 @@
+contract C {
+    function f(bytes memory b, uint[] memory a) external pure returns (uint, bytes1, uint, bytes32) {
+        return (b.length, b[1], a.length + a[2], keccak256(b));
+    }
+    function g(bytes memory b) external pure returns (uint x, uint y) {
+        (x, y) = abi.decode(b, (uint, uint));
+    }
+    function h(bytes memory b) external pure returns (bytes memory) {
+        b[0] = 0x78;
+        return b;
+    }
+    function i(uint[] memory a, uint j) external pure returns (uint) {
+        return a[j];
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(bytes,uint256[]): 0x40, 0x80, 3, "abc", 3, 1, 2, 3 -> 3, left(0x62), 6, 0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45
+// g(bytes): 0x20, 0x40, 7, 8 -> 7, 8
+// h(bytes): 0x20, 3, "abc" -> 0x20, 3, "xbc"
+// i(uint256[],uint256): 0x40, 1, 2, 5, 6 -> 6
+// i(uint256[],uint256): 0x40, 2, 2, 5, 6 -> FAILURE, hex"4e487b71", 0x32
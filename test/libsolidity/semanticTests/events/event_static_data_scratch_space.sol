@@ -0,0 +1,22 @@
+contract C {
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    event Flags(bool a, uint8 b);
+    event Topic(uint256 indexed x);
+    function f(uint256 v) public returns (uint256 freeBefore, uint256 freeAfter, uint256 first) {
+        assembly { freeBefore := mload(0x40) }
+        emit Transfer(address(0x1234), msg.sender, v);
+        emit Flags(true, uint8(v));
+        emit Topic(v);
+        uint256[] memory a = new uint256[](1);
+        a[0] = v;
+        first = a[0];
+        assembly { freeAfter := mload(0x40) }
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 7 -> 0x80, 0xc0, 7
+// ~ emit Transfer(address,address,uint256): #0x1234, #0x1212121212121212121212121212120000000012, 0x07
+// ~ emit Flags(bool,uint8): true, 0x07
+// ~ emit Topic(uint256): #0x07
@@ -0,0 +1,42 @@
+contract C {
+    function f0(uint256 x) internal pure returns (uint256) { return x * 10 + 0; }
+    function f1(uint256 x) internal pure returns (uint256) { return x * 10 + 1; }
+    function f2(uint256 x) internal pure returns (uint256) { return x * 10 + 2; }
+    function f3(uint256 x) internal pure returns (uint256) { return x * 10 + 3; }
+    function f4(uint256 x) internal pure returns (uint256) { return x * 10 + 4; }
+    function f5(uint256 x) internal pure returns (uint256) { return x * 10 + 5; }
+    function f6(uint256 x) internal pure returns (uint256) { return x * 10 + 6; }
+    function f7(uint256 x) internal pure returns (uint256) { return x * 10 + 7; }
+    function f8(uint256 x) internal pure returns (uint256) { return x * 10 + 8; }
+    function f9(uint256 x) internal pure returns (uint256) { return x * 10 + 9; }
+
+    function g(uint256 i, uint256 x) public pure returns (uint256) {
+        function(uint256) internal pure returns (uint256)[10] memory t;
+        t[0] = f0;
+        t[1] = f1;
+        t[2] = f2;
+        t[3] = f3;
+        t[4] = f4;
+        t[5] = f5;
+        t[6] = f6;
+        t[7] = f7;
+        t[8] = f8;
+        t[9] = f9;
+        return t[i](x);
+    }
+
+    function h() public pure returns (uint256) {
+        function(uint256) internal pure returns (uint256) z;
+        return z(1);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// g(uint256,uint256): 0, 5 -> 50
+// g(uint256,uint256): 1, 5 -> 51
+// g(uint256,uint256): 4, 5 -> 54
+// g(uint256,uint256): 5, 5 -> 55
+// g(uint256,uint256): 6, 5 -> 56
+// g(uint256,uint256): 9, 5 -> 59
+// h() -> FAILURE, hex"4e487b71", 0x51
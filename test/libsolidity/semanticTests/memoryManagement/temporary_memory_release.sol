@@ -0,0 +1,29 @@
+contract C {
+    struct S { uint x; uint y; }
+
+    function memorySize() internal pure returns (uint s) {
+        assembly { s := mload(0x40) }
+    }
+    function temporaries(uint a) public pure returns (uint, bool) {
+        uint memorySizeBefore = memorySize();
+        bytes32 h;
+        for (uint i = 0; i < 10; i++)
+            h = keccak256(abi.encode(h, a, i));
+        uint x = S(a, a + 1).y + [a, 2, 3][0];
+        uint memorySizeAfter = memorySize();
+        return (memorySizeAfter - memorySizeBefore, h != 0 && x == 2 * a + 1);
+    }
+    function escaping(uint a) public pure returns (uint, uint) {
+        uint memorySizeBefore = memorySize();
+        bytes memory b = abi.encode(a);
+        uint memorySizeBetween = memorySize();
+        b = abi.encode(a, a);
+        uint memorySizeAfter = memorySize();
+        return (memorySizeBetween - memorySizeBefore, memorySizeAfter - memorySizeBetween);
+    }
+}
+// ====
+// compileViaYul: true
+// ----
+// temporaries(uint256): 7 -> 0, true
+// escaping(uint256): 7 -> 0x40, 0x60
@@ -0,0 +1,33 @@
+contract C {
+    uint public calls;
+    modifier atLeast(uint x, uint min) {
+        calls++;
+        require(x >= min, "too small");
+        _;
+    }
+    modifier counted() virtual {
+        calls += 10;
+        _;
+    }
+    function f(uint x) public atLeast(x, 3) counted returns (uint) {
+        return x + 1;
+    }
+    function g(uint x) public atLeast(x + 1, 5) atLeast(x, 2) returns (uint r) {
+        r = x * 2;
+    }
+}
+contract D is C {
+    modifier counted() override {
+        calls += 100;
+        _;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 3 -> 4
+// calls() -> 101
+// f(uint256): 2 -> FAILURE, hex"08c379a0", 0x20, 9, "too small"
+// g(uint256): 4 -> 8
+// calls() -> 103
+// g(uint256): 3 -> FAILURE, hex"08c379a0", 0x20, 9, "too small"
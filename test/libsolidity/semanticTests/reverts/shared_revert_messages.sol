@@ -0,0 +1,30 @@
+pragma abicoder v2;
+
+error E(uint a, string b);
+
+contract C {
+    function f(uint x) public pure returns (uint) {
+        require(x > 1, "Value too small.");
+        require(x < 10, "Value too large.");
+        require(x != 5, "Value too small.");
+        return x;
+    }
+    function g(uint x) public pure {
+        if (x == 0)
+            revert("Value too small.");
+        revert E(x, "Value too small.");
+    }
+    function h(string calldata message) public pure {
+        revert(message);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 0 -> FAILURE, hex"08c379a0", 0x20, 0x10, "Value too small."
+// f(uint256): 10 -> FAILURE, hex"08c379a0", 0x20, 0x10, "Value too large."
+// f(uint256): 5 -> FAILURE, hex"08c379a0", 0x20, 0x10, "Value too small."
+// f(uint256): 7 -> 7
+// g(uint256): 0 -> FAILURE, hex"08c379a0", 0x20, 0x10, "Value too small."
+// g(uint256): 3 -> FAILURE, hex"ad4e8673", 3, 0x40, 0x10, "Value too small."
+// h(string): 0x20, 3, "abc" -> FAILURE, hex"08c379a0", 0x20, 3, "abc"
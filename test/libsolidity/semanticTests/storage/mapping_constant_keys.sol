@@ -0,0 +1,32 @@
+contract C {
+    uint256 constant KEY = 7;
+    int8 constant NEGATIVE_KEY = -2;
+    address constant OWNER = 0x1122334455667788990011223344556677889900;
+    uint8 constant SMALL_KEY = uint8(KEY);
+
+    mapping(uint256 => uint256) public a;
+    mapping(int16 => uint256) public b;
+    mapping(address => mapping(uint256 => uint256)) public c;
+
+    function set() public {
+        a[KEY] = 1;
+        a[3] = 2;
+        b[NEGATIVE_KEY] = 3;
+        c[OWNER][SMALL_KEY] = 4;
+        c[address(0x1234)][KEY + 1] += 5;
+    }
+
+    function get() public view returns (uint256, uint256, uint256, uint256, uint256) {
+        return (a[SMALL_KEY], a[3], b[NEGATIVE_KEY], c[OWNER][KEY], c[address(0x1234)][8]);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// set() ->
+// get() -> 1, 2, 3, 4, 5
+// a(uint256): 7 -> 1
+// a(uint256): 3 -> 2
+// b(int16): -2 -> 3
+// c(address,uint256): 0x1122334455667788990011223344556677889900, 7 -> 4
+// c(address,uint256): 0x1234, 8 -> 5
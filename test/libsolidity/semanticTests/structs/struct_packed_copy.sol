@@ -0,0 +1,48 @@
+pragma abicoder               v2;
+
+contract C {
+    struct S {
+        uint8 a;
+        bool b;
+        int16 c;
+        uint256 d;
+        address e;
+        bytes4 f;
+        uint16[] g;
+        uint64 h;
+    }
+
+    S s;
+    S t;
+
+    function set() public {
+        S memory m;
+        m.a = 7;
+        m.b = true;
+        m.c = -3;
+        m.d = 0x1234;
+        m.e = address(0x1122334455667788990011223344556677889900);
+        m.f = 0xaabbccdd;
+        m.g = new uint16[](2);
+        m.g[1] = 9;
+        m.h = 42;
+        s = m;
+    }
+
+    function fromStorage() public view returns (uint8, bool, int16, uint256, address, bytes4, uint16, uint64) {
+        S memory m = s;
+        return (m.a, m.b, m.c, m.d, m.e, m.f, m.g[1], m.h);
+    }
+
+    function copyStorage() public returns (uint8, bool, int16, uint256, address, bytes4, uint16, uint64) {
+        t = s;
+        return (t.a, t.b, t.c, t.d, t.e, t.f, t.g[1], t.h);
+    }
+}
+
+// ====
+// compileViaYul: also
+// ----
+// set() ->
+// fromStorage() -> 7, true, -3, 0x1234, 0x1122334455667788990011223344556677889900, 0xaabbccdd00000000000000000000000000000000000000000000000000000000, 9, 42
+// copyStorage() -> 7, true, -3, 0x1234, 0x1122334455667788990011223344556677889900, 0xaabbccdd00000000000000000000000000000000000000000000000000000000, 9, 42
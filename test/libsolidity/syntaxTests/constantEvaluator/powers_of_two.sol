@@ -0,0 +1,9 @@
+contract C {
+    uint256 constant a = 2**255;
+    uint256 constant b = 4**127 * 2;
+    uint256 constant c = 2**255 + (2**255 - 1);
+    uint[a / 2**252] x;
+    uint[b / 8**84] y;
+    uint[4**2 / 2**3 + c % 2] z;
+}
+// ----
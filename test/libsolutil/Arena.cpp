@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the arena allocator.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment_and_chunks)
+{
+	Arena arena(64);
+	for (size_t size: {1u, 3u, 8u, 13u, 16u, 40u})
+		for (size_t alignment: {size_t(1), size_t(2), size_t(8), alignof(max_align_t)})
+		{
+			void* memory = arena.allocate(size, alignment);
+			BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(memory) % alignment, 0);
+		}
+	BOOST_CHECK(arena.reservedBytes() > 64);
+}
+
+BOOST_AUTO_TEST_CASE(large_requests)
+{
+	Arena arena(64);
+	arena.allocate(8, 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 64);
+	// Requests larger than a chunk do not discard the current chunk.
+	arena.allocate(1000, 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 1064);
+	arena.allocate(8, 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 1064);
+}
+
+BOOST_AUTO_TEST_CASE(shared_pointers_keep_arena_alive)
+{
+	weak_ptr<Arena> observer;
+	shared_ptr<string> text;
+	{
+		auto arena = make_shared<Arena>();
+		observer = arena;
+		text = allocate_shared<string>(ArenaAllocator<string>(arena), 100, 'x');
+		vector<int, ArenaAllocator<int>> numbers{ArenaAllocator<int>(arena)};
+		for (int i = 0; i < 1000; ++i)
+			numbers.push_back(i);
+		BOOST_CHECK_EQUAL(numbers[999], 999);
+	}
+	BOOST_CHECK(!observer.expired());
+	BOOST_CHECK_EQUAL(*text, string(100, 'x'));
+	text.reset();
+	BOOST_CHECK(observer.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -97,6 +97,24 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(tohex_fromhex_all_bytes)
+{
+	bytes allBytes;
+	for (size_t i = 0; i < 256; ++i)
+		allBytes.push_back(static_cast<uint8_t>(i));
+	string const lowerHex = toHex(allBytes);
+	string const upperHex = toHex(allBytes, HexPrefix::Add, HexCase::Upper);
+	BOOST_CHECK_EQUAL(lowerHex.substr(0, 8), "00010203");
+	BOOST_CHECK_EQUAL(lowerHex.substr(lowerHex.size() - 8), "fcfdfeff");
+	BOOST_CHECK_EQUAL(upperHex.substr(upperHex.size() - 8), "FCFDFEFF");
+	BOOST_CHECK(fromHex(lowerHex) == allBytes);
+	BOOST_CHECK(fromHex(upperHex) == allBytes);
+	BOOST_CHECK_EQUAL(fromHex("0x0abc"), (bytes{0x0a, 0xbc}));
+	BOOST_CHECK_EQUAL(fromHex("0xabc"), (bytes{0x0a, 0xbc}));
+	BOOST_CHECK_EQUAL(fromHex("abc\xff"), bytes());
+	BOOST_CHECK_THROW(fromHex("ab0g", WhenError::Throw), BadHexCharacter);
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
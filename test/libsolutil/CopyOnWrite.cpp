@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the values shared between copies until they are modified.
+ */
+
+#include <libsolutil/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(CopyOnWriteTest)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	CopyOnWrite<vector<int>> a;
+	CopyOnWrite<vector<int>> b;
+	BOOST_CHECK(a->empty());
+	BOOST_CHECK(a.sharesValueWith(b));
+	BOOST_CHECK(a == b);
+	a.write().push_back(1);
+	BOOST_CHECK(!a.sharesValueWith(b));
+	BOOST_CHECK(a != b);
+	a.clear();
+	BOOST_CHECK(a->empty());
+	BOOST_CHECK(a == b);
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_until_written)
+{
+	CopyOnWrite<map<int, int>> a(map<int, int>{{1, 10}});
+	CopyOnWrite<map<int, int>> b = a;
+	BOOST_CHECK(a.sharesValueWith(b));
+	BOOST_CHECK(&*a == &*b);
+
+	b.write()[2] = 20;
+	BOOST_CHECK(!a.sharesValueWith(b));
+	BOOST_CHECK((*a == map<int, int>{{1, 10}}));
+	BOOST_CHECK((*b == map<int, int>{{1, 10}, {2, 20}}));
+
+	// Values that are not shared any more are modified in place.
+	map<int, int> const* value = &*b;
+	b.write()[3] = 30;
+	BOOST_CHECK_EQUAL(&*b, value);
+
+	// Equal values are equal even if they are not shared.
+	CopyOnWrite<map<int, int>> c(map<int, int>{{1, 10}});
+	BOOST_CHECK(!a.sharesValueWith(c));
+	BOOST_CHECK(a == c);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
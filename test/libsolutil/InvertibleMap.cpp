@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the invertible map and relation.
+ */
+
+#include <libsolutil/InvertibleMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(InvertibleMapTest)
+
+BOOST_AUTO_TEST_CASE(map_references)
+{
+	InvertibleMap<string, string> map;
+	map.set("a", "x");
+	map.set("b", "x");
+	map.set("c", "y");
+	BOOST_CHECK((map.references == std::map<string, set<string>>{{"x", {"a", "b"}}, {"y", {"c"}}}));
+
+	map.set("b", "y");
+	BOOST_CHECK((map.references == std::map<string, set<string>>{{"x", {"a"}}, {"y", {"b", "c"}}}));
+
+	map.eraseValue("y");
+	BOOST_CHECK((map.values == std::map<string, string>{{"a", "x"}}));
+	BOOST_CHECK((map.references == std::map<string, set<string>>{{"x", {"a"}}}));
+
+	map.eraseKey("a");
+	BOOST_CHECK(map.values.empty());
+	BOOST_CHECK(map.references.empty());
+}
+
+BOOST_AUTO_TEST_CASE(map_join_checkpoint)
+{
+	InvertibleMap<string, string> map;
+	map.set("unchanged", "1");
+	map.set("changed", "1");
+	map.set("restored", "1");
+	map.set("erased", "1");
+
+	map.pushCheckpoint();
+	map.set("changed", "2");
+	map.eraseKey("restored");
+	map.set("restored", "1");
+	map.eraseKey("erased");
+	map.set("new", "1");
+
+	map.pushCheckpoint();
+	map.set("unchanged", "2");
+	map.joinCheckpoint();
+	BOOST_CHECK((map.values == std::map<string, string>{{"changed", "2"}, {"new", "1"}, {"restored", "1"}}));
+
+	map.joinCheckpoint();
+	BOOST_CHECK((map.values == std::map<string, string>{{"restored", "1"}}));
+	BOOST_CHECK((map.references == std::map<string, set<string>>{{"1", {"restored"}}}));
+}
+
+BOOST_AUTO_TEST_CASE(map_clear_in_checkpoint)
+{
+	InvertibleMap<string, string> map;
+	map.set("a", "1");
+	map.pushCheckpoint();
+	map.clear();
+	map.set("a", "1");
+	map.set("b", "1");
+	map.joinCheckpoint();
+	BOOST_CHECK((map.values == std::map<string, string>{{"a", "1"}}));
+}
+
+BOOST_AUTO_TEST_CASE(relation)
+{
+	InvertibleRelation<string> relation;
+	relation.set("a", {"x", "y"});
+	relation.set("b", {"y"});
+	BOOST_CHECK((relation.references == std::map<string, set<string>>{{"x", {"a"}}, {"y", {"a", "b"}}}));
+
+	relation.set("a", {"z"});
+	BOOST_CHECK((relation.references == std::map<string, set<string>>{{"y", {"b"}}, {"z", {"a"}}}));
+
+	relation.eraseKey("b");
+	BOOST_CHECK((relation.values == std::map<string, set<string>>{{"a", {"z"}}}));
+	BOOST_CHECK((relation.references == std::map<string, set<string>>{{"z", {"a"}}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
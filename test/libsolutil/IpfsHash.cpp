@@ -106,6 +106,12 @@ BOOST_AUTO_TEST_CASE(test_multi_level_tree)
 	BOOST_CHECK_EQUAL(ipfsHashBase58(data), "QmaTb1sT9hrSXJLmf8bxJ9NuwndiHuMLsgNLgkS2eXu3Xj");
 }
 
+BOOST_AUTO_TEST_CASE(test_parallel)
+{
+	string data(1310710, 0);
+	BOOST_CHECK_EQUAL(ipfsHashBase58(data, 4), "QmNg7BJo8gEMDK8yGQbHEwPtycesnE6FUULX5iVd5TAL9f");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -69,6 +69,37 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	BOOST_CHECK(keccak256Batch({}).empty());
+
+	// Lengths around the block size of 136 bytes, in an order that mixes the number of blocks.
+	vector<bytes> inputs;
+	for (size_t length: vector<size_t>{0, 500, 1, 135, 136, 137, 32, 271, 272, 273, 4, 5, 1000, 64, 135, 200})
+	{
+		bytes input(length);
+		for (size_t i = 0; i < length; ++i)
+			input[i] = static_cast<uint8_t>(i * 7 + length);
+		inputs.emplace_back(move(input));
+	}
+	for (size_t count = 1; count <= inputs.size(); ++count)
+	{
+		vector<bytesConstRef> refs;
+		for (size_t i = 0; i < count; ++i)
+			refs.emplace_back(&inputs[i]);
+		vector<h256> hashes = keccak256Batch(refs);
+		BOOST_REQUIRE_EQUAL(hashes.size(), count);
+		for (size_t i = 0; i < count; ++i)
+			BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	}
+
+	string const test = "test";
+	BOOST_CHECK_EQUAL(
+		keccak256Batch({bytesConstRef(test), bytesConstRef(test)})[1],
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
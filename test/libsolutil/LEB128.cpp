@@ -96,6 +96,15 @@ BOOST_AUTO_TEST_CASE(encode_signed)
 	BOOST_REQUIRE(negative_larger[5] == 0x7C);
 }
 
+BOOST_AUTO_TEST_CASE(encode_appending)
+{
+	bytes result{0xAA};
+	solidity::util::lebEncodeTo(result, 624485);
+	solidity::util::lebEncodeSignedTo(result, -123456);
+	solidity::util::lebEncodeTo(result, 0);
+	BOOST_REQUIRE(result == (bytes{0xAA, 0xE5, 0x8E, 0x26, 0xC0, 0xBB, 0x78, 0x00}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the bounded least recently used cache.
+ */
+
+#include <libsolutil/LRUCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(LRUCacheTest)
+
+BOOST_AUTO_TEST_CASE(find_and_insert)
+{
+	LRUCache<int, string> cache(4);
+	BOOST_CHECK(!cache.find(1));
+	cache.insert(1, "one");
+	cache.insert(2, "two");
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(*cache.find(1), "one");
+	cache.insert(1, "uno");
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(*cache.find(1), "uno");
+	cache.clear();
+	BOOST_CHECK_EQUAL(cache.size(), 0);
+	BOOST_CHECK(!cache.find(2));
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+	LRUCache<int, int> cache(3);
+	for (int i = 0; i < 3; ++i)
+		cache.insert(i, i * 10);
+	// Accessing 0 makes 1 the least recently used entry.
+	BOOST_CHECK(cache.find(0));
+	cache.insert(3, 30);
+	BOOST_CHECK_EQUAL(cache.size(), cache.capacity());
+	BOOST_CHECK(!cache.find(1));
+	BOOST_CHECK_EQUAL(*cache.find(0), 0);
+	BOOST_CHECK_EQUAL(*cache.find(2), 20);
+	BOOST_CHECK_EQUAL(*cache.find(3), 30);
+	// Replacing a value also counts as a use.
+	cache.insert(0, 5);
+	cache.insert(4, 40);
+	BOOST_CHECK(!cache.find(2));
+	BOOST_CHECK_EQUAL(*cache.find(0), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
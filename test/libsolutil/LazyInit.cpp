@@ -105,6 +105,14 @@ BOOST_AUTO_TEST_CASE(moved_from_is_empty)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(reset_is_empty)
+{
+	LazyInit<int const> lazyInit;
+	lazyInit.init([]{ return 12; });
+	lazyInit.reset();
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 42);
+}
+
 BOOST_AUTO_TEST_CASE(move_constructed_has_same_value_as_original)
 {
 	LazyInit<int> original;
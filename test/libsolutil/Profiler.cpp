@@ -0,0 +1,241 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the profiler.
+ */
+
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+vector<string> phaseNames(Profiler::Phases const& _phases)
+{
+	vector<string> names;
+	for (auto const& phase: _phases)
+		names.push_back(phase.first);
+	return names;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(inactive_without_scope)
+{
+	Profiler profiler;
+	{
+		Profiler::Phase phase("a");
+	}
+	{
+		Profiler::Scope scope(nullptr, "x");
+		Profiler::Phase phase("b");
+	}
+	BOOST_CHECK(profiler.measurements().empty());
+	BOOST_CHECK(!Profiler::attribution().profiler);
+}
+
+BOOST_AUTO_TEST_CASE(nested_phases)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler, "");
+		Profiler::Phase outer("outer");
+		for (int i = 0; i < 3; ++i)
+		{
+			Profiler::Phase inner("inner");
+			Profiler::Phase innermost("innermost");
+		}
+		Profiler::Phase second("second");
+	}
+	auto measurements = profiler.measurements();
+	BOOST_REQUIRE_EQUAL(measurements.size(), 1);
+	Profiler::Phases const& phases = measurements.at("");
+	BOOST_CHECK((phaseNames(phases) == vector<string>{"outer", "outer/inner", "outer/inner/innermost", "outer/second"}));
+	BOOST_CHECK_EQUAL(phases[0].second.count, 1);
+	BOOST_CHECK_EQUAL(phases[1].second.count, 3);
+	BOOST_CHECK_EQUAL(phases[2].second.count, 3);
+	BOOST_CHECK(phases[0].second.wallTimeSeconds >= phases[1].second.wallTimeSeconds);
+	BOOST_CHECK(!Profiler::attribution().profiler);
+}
+
+BOOST_AUTO_TEST_CASE(scopes)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler, "");
+		Profiler::Phase phase("compile");
+		{
+			Profiler::Scope contractScope(&profiler, "C");
+			Profiler::Phase contractPhase("codegen");
+		}
+		Profiler::Phase nested("nested");
+	}
+	auto measurements = profiler.measurements();
+	BOOST_REQUIRE_EQUAL(measurements.size(), 2);
+	BOOST_CHECK((phaseNames(measurements.at("")) == vector<string>{"compile", "compile/nested"}));
+	BOOST_CHECK((phaseNames(measurements.at("C")) == vector<string>{"codegen"}));
+
+	profiler.clear();
+	BOOST_CHECK(profiler.measurements().empty());
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_tasks)
+{
+	for (size_t threads: {1u, 4u})
+	{
+		Profiler profiler;
+		{
+			Profiler::Scope scope(&profiler, "C");
+			Profiler::Phase phase("outer");
+			ThreadPool pool(threads);
+			vector<int> tasks(20);
+			pool.forEach(tasks, [](int) { Profiler::Phase task("task"); });
+		}
+		auto measurements = profiler.measurements();
+		BOOST_REQUIRE_EQUAL(measurements.size(), 1);
+		Profiler::Phases const& phases = measurements.at("C");
+		BOOST_REQUIRE((phaseNames(phases) == vector<string>{"outer", "outer/task"}));
+		BOOST_CHECK_EQUAL(phases[1].second.count, 20);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(transformations)
+{
+	Profiler profiler;
+	Profiler::recordTransformation({"A", "ignored", 1, 1, 1, 1, 0});
+	BOOST_CHECK(!Profiler::active());
+	{
+		Profiler::Scope scope(&profiler, "C");
+		BOOST_CHECK(Profiler::active());
+		Profiler::recordTransformation({"C", "first", 10, 8, 20, 15, 0.5});
+		Profiler::recordTransformation({"C_deployed", "second", 5, 6, 9, 9, 0.25});
+	}
+	auto transformations = profiler.transformations();
+	BOOST_REQUIRE_EQUAL(transformations.size(), 1);
+	vector<Profiler::Transformation> const& scopeTransformations = transformations.at("C");
+	BOOST_REQUIRE_EQUAL(scopeTransformations.size(), 2);
+	BOOST_CHECK_EQUAL(scopeTransformations[0].name, "first");
+	BOOST_CHECK_EQUAL(scopeTransformations[0].codeSizeAfter, 8);
+	BOOST_CHECK_EQUAL(scopeTransformations[1].object, "C_deployed");
+	BOOST_CHECK_EQUAL(scopeTransformations[1].codeCostBefore, 9);
+
+	profiler.clear();
+	BOOST_CHECK(profiler.transformations().empty());
+}
+
+BOOST_AUTO_TEST_CASE(counters)
+{
+	Profiler profiler;
+	SOL_PERF_COUNTER("ignored", 1);
+	{
+		Profiler::Scope scope(&profiler, "");
+		SOL_PERF_COUNTER("a", 1);
+		SOL_PERF_COUNTER("a", 2);
+		{
+			Profiler::Scope contractScope(&profiler, "C");
+			SOL_PERF_COUNTER("b", 5);
+		}
+		SOL_PERF_COUNTER("a", 4);
+		ThreadPool pool(4);
+		vector<int> tasks(20);
+		pool.forEach(tasks, [](int) { SOL_PERF_COUNTER("task", 1); });
+	}
+	SOL_PERF_COUNTER("ignored", 1);
+
+	auto counters = profiler.counters();
+#ifdef SOL_PERF_COUNTERS_DISABLED
+	BOOST_CHECK(counters.empty());
+#else
+	BOOST_REQUIRE_EQUAL(counters.size(), 2);
+	BOOST_CHECK((counters.at("") == Profiler::Counters{{"a", 7}, {"task", 20}}));
+	BOOST_CHECK((counters.at("C") == Profiler::Counters{{"b", 5}}));
+#endif
+
+	profiler.clear();
+	BOOST_CHECK(profiler.counters().empty());
+}
+
+BOOST_AUTO_TEST_CASE(trace)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler, "");
+		Profiler::Phase phase("untraced");
+	}
+	BOOST_CHECK(profiler.traceEvents().empty());
+
+	profiler.enableTracing();
+	{
+		Profiler::Scope scope(&profiler, "");
+		{
+			Profiler::Phase outer("outer");
+			Profiler::Phase inner("inner", "object");
+		}
+		Profiler::Scope contractScope(&profiler, "C");
+		ThreadPool pool(2);
+		vector<int> tasks(8);
+		pool.forEach(tasks, [](int) {
+			Profiler::Phase phase("task");
+			this_thread::sleep_for(chrono::milliseconds(1));
+		});
+	}
+
+	vector<Profiler::TraceEvent> events = profiler.traceEvents();
+	BOOST_REQUIRE_EQUAL(events.size(), 11);
+	// Spans are recorded when they end.
+	BOOST_CHECK_EQUAL(events[0].name, "inner");
+	BOOST_CHECK_EQUAL(events[0].category, "phase");
+	BOOST_CHECK_EQUAL(events[0].object, "object");
+	BOOST_CHECK_EQUAL(events[1].name, "outer");
+	BOOST_CHECK(events[1].object.empty());
+	BOOST_CHECK(events[1].start <= events[0].start);
+	BOOST_CHECK(events[0].start + events[0].duration <= events[1].start + events[1].duration);
+	BOOST_CHECK_EQUAL(events[0].thread, 0);
+
+	set<size_t> taskThreads;
+	for (size_t i = 2; i < 10; ++i)
+	{
+		BOOST_CHECK_EQUAL(events[i].name, "task");
+		BOOST_CHECK_EQUAL(events[i].scope, "C");
+		taskThreads.insert(events[i].thread);
+	}
+	BOOST_CHECK(!taskThreads.empty());
+	BOOST_CHECK(events[10].name == "C" && events[10].category == "scope");
+
+	profiler.clear();
+	BOOST_CHECK(profiler.traceEvents().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
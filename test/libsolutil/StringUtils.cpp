@@ -105,6 +105,23 @@ BOOST_AUTO_TEST_CASE(test_human_readable_join)
 	BOOST_CHECK_EQUAL(joinHumanReadable(vector<string>({"a", "b", "c"}), "; ", " or "), "a; b or c");
 }
 
+BOOST_AUTO_TEST_CASE(test_suffixed_variable_name_list)
+{
+	BOOST_CHECK_EQUAL(suffixedVariableNameList("x", 0, 0), "");
+	BOOST_CHECK_EQUAL(suffixedVariableNameList("x", 2, 3), "x2");
+	BOOST_CHECK_EQUAL(suffixedVariableNameList("x", 0, 3), "x0, x1, x2");
+	BOOST_CHECK_EQUAL(suffixedVariableNameList("x", 3, 0), "x2, x1, x0");
+	BOOST_CHECK_EQUAL(suffixedVariableNameList("x", 11, 9), "x10, x9");
+}
+
+BOOST_AUTO_TEST_CASE(test_concatenate)
+{
+	BOOST_CHECK_EQUAL(concatenate({}), "");
+	BOOST_CHECK_EQUAL(concatenate({"", ""}), "");
+	string const b = "b";
+	BOOST_CHECK_EQUAL(concatenate({"a", b, string("c") + "d", ""}), "abcd");
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number_readable)
 {
 	BOOST_CHECK_EQUAL(formatNumberReadable(u256(0x8000000)), "0x08 * 2**24");
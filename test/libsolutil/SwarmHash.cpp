@@ -103,6 +103,12 @@ BOOST_AUTO_TEST_CASE(bzz_hash_nonzero)
 	BOOST_CHECK_EQUAL(bzzr1HashHex(sequence(4096 * 130)), "59de730bf6c67a941f3b2ffa2f920acfaa1713695ad5deea12b4a121e5f23fa1");
 }
 
+BOOST_AUTO_TEST_CASE(bzz_hash_parallel)
+{
+	for (size_t length: vector<size_t>{4096 * 128 + 31, 4096 * 130})
+		BOOST_CHECK_EQUAL(toHex(bzzr1Hash(sequence(length), 4).asBytes()), bzzr1HashHex(sequence(length)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
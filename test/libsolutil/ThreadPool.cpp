@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(sequential_runs_on_submit)
+{
+	ThreadPool pool(1);
+	BOOST_CHECK_EQUAL(pool.size(), 1);
+	vector<int> order;
+	for (int i = 0; i < 5; ++i)
+		pool.submit([&order, i]() { order.push_back(i); });
+	BOOST_CHECK((order == vector<int>{0, 1, 2, 3, 4}));
+	pool.waitAll();
+}
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	for (size_t threads: {0u, 1u, 4u})
+	{
+		ThreadPool pool(threads);
+		vector<int> results(100, 0);
+		vector<int> indices(100);
+		iota(indices.begin(), indices.end(), 0);
+		pool.forEach(indices, [&](int _i) { results[static_cast<size_t>(_i)] = _i * 2; });
+		for (size_t i = 0; i < results.size(); ++i)
+			BOOST_CHECK_EQUAL(results[i], static_cast<int>(i) * 2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(multiple_batches)
+{
+	ThreadPool pool(3);
+	atomic<int> counter{0};
+	for (int batch = 1; batch <= 3; ++batch)
+	{
+		for (int i = 0; i < 10; ++i)
+			pool.submit([&]() { ++counter; });
+		pool.waitAll();
+		BOOST_CHECK_EQUAL(counter.load(), batch * 10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_earliest_failure)
+{
+	for (size_t threads: {1u, 4u})
+	{
+		ThreadPool pool(threads);
+		for (int i = 0; i < 20; ++i)
+			pool.submit([i]() {
+				if (i >= 7)
+					throw runtime_error(to_string(i));
+			});
+		string message;
+		try
+		{
+			pool.waitAll();
+		}
+		catch (runtime_error const& _error)
+		{
+			message = _error.what();
+		}
+		BOOST_CHECK_EQUAL(message, "7");
+
+		// The pool is usable after a failed batch.
+		bool executed = false;
+		pool.submit([&]() { executed = true; });
+		pool.waitAll();
+		BOOST_CHECK(executed);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -208,6 +208,21 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unterminated_elements_rendered)
+{
+	string templ = "<#l> <?c> <!c> </l </c <?+a>x";
+	Whiskers m(templ);
+	BOOST_CHECK_EQUAL(m.render(), templ);
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<?c><a><!c>-</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "X").render(), "X");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("a", "Y").render(), "-");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "Z").render(), "Z");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
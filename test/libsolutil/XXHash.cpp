@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the xxHash64 implementation.
+ */
+
+#include <libsolutil/XXHash.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(XXHash)
+
+BOOST_AUTO_TEST_CASE(reference_values)
+{
+	BOOST_CHECK_EQUAL(xxhash64(""), 0xEF46DB3751D8E999ull);
+	BOOST_CHECK_EQUAL(xxhash64("a"), 0xD24EC4F1A98C6E5Bull);
+	BOOST_CHECK_EQUAL(xxhash64("abc"), 0x44BC2CF5AD770999ull);
+	BOOST_CHECK_EQUAL(xxhash64("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ull);
+}
+
+BOOST_AUTO_TEST_CASE(all_lengths_distinct)
+{
+	// Exercise the 32 byte stripes and all tail lengths.
+	string input;
+	set<uint64_t> hashes;
+	for (size_t length = 0; length < 100; ++length)
+	{
+		hashes.insert(xxhash64(input));
+		input += static_cast<char>('a' + length % 26);
+	}
+	BOOST_CHECK_EQUAL(hashes.size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(seed)
+{
+	BOOST_CHECK(xxhash64("abc", 1) != xxhash64("abc"));
+	BOOST_CHECK_EQUAL(xxhash64("abc", 1), xxhash64("abc", 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -24,6 +24,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/CompilabilityChecker.h>
+#include <libyul/optimiser/StackCompressor.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -335,6 +336,43 @@ BOOST_AUTO_TEST_CASE(also_in_outer_block_unused_arguments)
 	BOOST_CHECK_EQUAL(out, ": 9 ");
 }
 
+BOOST_AUTO_TEST_CASE(single_function)
+{
+	Object obj;
+	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(R"({
+		{ sstore(0, h(1)) }
+		function f(a, b) -> r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 {
+			r1 := 0
+			sstore(a, b)
+		}
+		function g(x) -> y {
+			y := add(x, 1)
+		}
+		function h(x) -> y {
+			let r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 := f(x, 1)
+			y := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+			sstore(g(y), r18)
+			sstore(r19, r17)
+		}
+	})", false);
+	BOOST_REQUIRE(obj.code);
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+
+	map<YulString, int> deficits = yul::CompilabilityChecker(dialect, obj, true).stackDeficit;
+	BOOST_CHECK(deficits.count(YulString{"f"}) && deficits.count(YulString{"h"}));
+	BOOST_CHECK(!deficits.count(YulString{}) && !deficits.count(YulString{"g"}));
+	for (char const* name: {"", "f", "g", "h"})
+	{
+		map<YulString, int> expectation;
+		if (deficits.count(YulString{name}))
+			expectation[YulString{name}] = deficits.at(YulString{name});
+		BOOST_CHECK(yul::CompilabilityChecker(dialect, obj, true, YulString{name}).stackDeficit == expectation);
+	}
+
+	// The function f replacing the callee of h has a deficit of its own, which must not be reported for h.
+	BOOST_CHECK_NO_THROW(StackCompressor::run(dialect, obj, true, 16, 2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -39,6 +39,7 @@ EVMCodeTransformTest::EVMCodeTransformTest(string const& _filename):
 {
 	m_source = m_reader.source();
 	m_stackOpt = m_reader.boolSetting("stackOptimization", false);
+	m_stackLayout = m_reader.boolSetting("stackLayout", false);
 	m_expectation = m_reader.simpleExpectations();
 }
 
@@ -47,6 +48,7 @@ TestCase::TestResult EVMCodeTransformTest::run(ostream& _stream, string const& _
 	solidity::frontend::OptimiserSettings settings = solidity::frontend::OptimiserSettings::full();
 	settings.runYulOptimiser = false;
 	settings.optimizeStackAllocation = m_stackOpt;
+	settings.optimizeStackLayout = m_stackLayout;
 	AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly, settings);
 	if (!stack.parseAndAnalyze("", m_source))
 	{
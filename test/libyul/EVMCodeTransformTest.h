@@ -34,6 +34,7 @@ public:
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 private:
 	bool m_stackOpt = false;
+	bool m_stackLayout = false;
 };
 
 }
@@ -0,0 +1,220 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the execution of the optimiser suite.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string optimise(
+	string const& _source,
+	size_t _parallelism,
+	shared_ptr<OptimizedObjectCache> _objectCache = nullptr
+)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	stack.setParallelism(_parallelism);
+	stack.setObjectCache(move(_objectCache));
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_change_result)
+{
+	string source = R"(
+		object "a" {
+			code {
+				let x := calldataload(0)
+				sstore(0, f(x, 2))
+				sstore(1, g(x))
+				mstore(0, h(calldataload(32)))
+				return(0, 32)
+				function f(a, b) -> r {
+					for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+						r := add(r, mul(a, sload(i)))
+						sstore(i, r)
+					}
+					r := add(r, add(0, sload(0)))
+				}
+				function g(a) -> r {
+					let y := mload(0x40)
+					mstore(y, a)
+					mstore(add(y, 0x20), f(a, 3))
+					r := keccak256(y, 0x40)
+					if iszero(eq(mload(y), a)) { revert(0, 0) }
+				}
+				function h(a) -> r {
+					switch a
+					case 0 { r := g(1) }
+					case 1 { r := f(a, a) }
+					default { r := mul(sub(a, a), 7) }
+				}
+			}
+			object "a_deployed" {
+				code {
+					let v := calldataload(4)
+					sstore(v, k(v))
+					function k(a) -> r {
+						r := div(exp(2, 224), a)
+						if gt(r, sload(r)) { r := sload(add(r, 0)) }
+					}
+				}
+			}
+		}
+	)";
+	string expectation = optimise(source, 1);
+	for (size_t parallelism: {2u, 8u})
+		BOOST_CHECK_EQUAL(optimise(source, parallelism), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(object_cache_does_not_change_result)
+{
+	string const child = R"(
+		object "C" {
+			code {
+				datacopy(0, dataoffset("C_deployed"), datasize("C_deployed"))
+				return(0, datasize("C_deployed"))
+			}
+			object "C_deployed" {
+				code {
+					sstore(f(calldataload(0)), f(calldataload(32)))
+					function f(a) -> r { r := add(keccak256(a, 32), sload(a)) }
+				}
+			}
+		}
+	)";
+	auto parent = [&](string const& _name, string const& _slot) {
+		return
+			"object \"" + _name + "\" {\n"
+			"code {\n"
+			"	datacopy(0, dataoffset(\"C\"), datasize(\"C\"))\n"
+			"	pop(create(0, 0, datasize(\"C\")))\n"
+			"	datacopy(0, dataoffset(\"" + _name + "_deployed\"), datasize(\"" + _name + "_deployed\"))\n"
+			"	return(0, datasize(\"" + _name + "_deployed\"))\n"
+			"}\n"
+			"object \"" + _name + "_deployed\" {\n"
+			"	code {\n"
+			"		datacopy(0, dataoffset(\"C\"), datasize(\"C\"))\n"
+			"		sstore(" + _slot + ", create(0, 0, datasize(\"C\")))\n"
+			"	}\n" +
+			child +
+			"}\n" +
+			child +
+			"}\n";
+	};
+	vector<string> const sources{parent("A", "1"), parent("B", "2"), parent("A", "1")};
+	auto cache = make_shared<OptimizedObjectCache>();
+	for (string const& source: sources)
+		for (size_t parallelism: {1u, 4u})
+			BOOST_CHECK_EQUAL(optimise(source, parallelism, cache), optimise(source, 1));
+}
+
+BOOST_AUTO_TEST_CASE(function_cache_does_not_change_result)
+{
+	auto source = [](string const& _main, string const& _constant) {
+		return
+			"{\n"
+			"	" + _main + "\n"
+			"	function f(a, b) -> r {\n"
+			"		for { let i := 0 } lt(i, b) { i := add(i, 1) } { r := add(r, mul(a, sload(i))) }\n"
+			"		r := add(r, mload(" + _constant + "))\n"
+			"	}\n"
+			"	function g(x) -> y { y := f(x, 3) mstore(0, y) }\n"
+			"}\n";
+	};
+	// The functions are shared, but not the objects. The second and the third source only differ
+	// in the use of msize, which changes the result of several steps on the functions.
+	vector<string> const sources{
+		source("sstore(0, g(calldataload(0)))", "0"),
+		source("sstore(1, g(calldataload(32)))", "0"),
+		source("sstore(1, g(calldataload(32))) pop(msize())", "0"),
+		source("sstore(0, g(calldataload(0)))", "32"),
+		source("sstore(0, g(calldataload(0)))", "0")
+	};
+	auto cache = make_shared<OptimizedObjectCache>();
+	for (string const& code: sources)
+		for (size_t parallelism: {1u, 4u})
+			BOOST_CHECK_EQUAL(optimise(code, parallelism, cache), optimise(code, 1));
+}
+
+BOOST_AUTO_TEST_CASE(ast_hash_includes_names)
+{
+	auto hash = [](string const& _source) { return ASTHasher::run(*yul::test::parse(_source).first); };
+	string const source = "{ let x := calldataload(0) function f(a) -> r { r := add(a, 1) } sstore(0, f(x)) }";
+	BOOST_CHECK_EQUAL(hash(source), hash(source));
+	BOOST_CHECK_EQUAL(hash(source), hash("{\n\tlet x := calldataload(0)\n\tfunction f(a) -> r { r := add(a, 1) }\n\tsstore(0, f(x))\n}"));
+	BOOST_CHECK(hash(source) != hash("{ let y := calldataload(0) function f(a) -> r { r := add(a, 1) } sstore(0, f(y)) }"));
+	BOOST_CHECK(hash(source) != hash("{ let x := calldataload(0) function g(a) -> r { r := add(a, 1) } sstore(0, g(x)) }"));
+	BOOST_CHECK(hash(source) != hash("{ let x := calldataload(0) function f(a) -> r { r := add(a, 2) } sstore(0, f(x)) }"));
+	BOOST_CHECK(hash(source) != hash("{ let x := calldataload(0) function f(b) -> r { r := add(b, 1) } sstore(0, f(x)) }"));
+}
+
+BOOST_AUTO_TEST_CASE(interprocedural_information_cache)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	vector<string> const sources{
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { r := 1 } function h() { for {} 1 {} { sstore(0, 1) } } }",
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { r := sload(0) } function h() { for {} 1 {} { sstore(0, 1) } } }",
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { h() } function h() { for {} 1 {} { sstore(0, 1) } } }",
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { r := f() } function h() -> r { r := msize() } }",
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { r := 2 } }",
+		"{ pop(g()) function f() -> r { r := g() } function g() -> r { r := 1 } function h() { for {} 1 {} { sstore(0, 1) } } }",
+		"{ sstore(0, f()) function f() -> r { r := g() } function g() -> r { r := 1 } function h() { for {} 1 {} { sstore(0, 1) } } }"
+	};
+	InterproceduralInformationCache cache;
+	for (string const& source: sources)
+	{
+		shared_ptr<Block> ast = yul::test::parse(source, false).first;
+		BOOST_REQUIRE(ast);
+		InterproceduralInformation expectation = InterproceduralInformation::fromAST(dialect, *ast);
+		InterproceduralInformation const& information = cache.information(dialect, *ast);
+		BOOST_CHECK(information.functionSideEffects == expectation.functionSideEffects);
+		BOOST_CHECK_EQUAL(information.containsMSize, expectation.containsMSize);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -22,23 +22,27 @@
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
+#include <libyul/optimiser/CopyCoalescer.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/CommonSubexpressionHoister.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/InterproceduralConstantPropagator.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopStrengthReducer.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -46,6 +50,7 @@
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/optimiser/UnusedStoreEliminator.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
@@ -125,6 +130,12 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			CommonSubexpressionEliminator::run(*m_context, *m_ast);
 		}},
+		{"commonSubexpressionHoister", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			CommonSubexpressionHoister::run(*m_context, *m_ast);
+		}},
 		{"conditionalUnsimplifier", [&]() {
 			disambiguate();
 			ConditionalUnsimplifier::run(*m_context, *m_ast);
@@ -157,6 +168,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_object->code);
 			FunctionSpecializer::run(*m_context, *m_object->code);
 		}},
+		{"interproceduralConstantPropagator", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			InterproceduralConstantPropagator::run(*m_context, *m_ast);
+		}},
 		{"expressionInliner", [&]() {
 			disambiguate();
 			ExpressionInliner::run(*m_context, *m_ast);
@@ -169,6 +185,14 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FullInliner::run(*m_context, *m_ast);
 			ExpressionJoiner::run(*m_context, *m_ast);
 		}},
+		{"budgetedInliner", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			FunctionGrouper::run(*m_context, *m_ast);
+			ExpressionSplitter::run(*m_context, *m_ast);
+			BudgetedInliner::run(*m_context, *m_ast);
+			ExpressionJoiner::run(*m_context, *m_ast);
+		}},
 		{"mainFunction", [&]() {
 			disambiguate();
 			FunctionGrouper::run(*m_context, *m_ast);
@@ -217,6 +241,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			disambiguate();
 			UnusedPruner::run(*m_context, *m_ast);
 		}},
+		{"unusedStoreEliminator", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			UnusedStoreEliminator::run(*m_context, *m_ast);
+		}},
 		{"circularReferencesPruner", [&]() {
 			disambiguate();
 			FunctionHoister::run(*m_context, *m_ast);
@@ -263,11 +292,22 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopStrengthReducer", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			LoopStrengthReducer::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
 			ControlFlowSimplifier::run(*m_context, *m_ast);
 		}},
+		{"copyCoalescer", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			CopyCoalescer::run(*m_context, *m_ast);
+		}},
 		{"structuralSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
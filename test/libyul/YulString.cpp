@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	YulString c{"abd"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK(!a.empty());
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Spans several storage chunks.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 20000; ++i)
+		strings.emplace_back("s_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_REQUIRE_EQUAL(strings[i].str(), "s_" + to_string(i));
+		BOOST_REQUIRE(strings[i] == YulString{"s_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t constexpr tasks = 8;
+	size_t constexpr stringsPerTask = 5000;
+	vector<vector<YulString>> results(tasks);
+	vector<size_t> taskIndices;
+	for (size_t i = 0; i < tasks; ++i)
+		taskIndices.push_back(i);
+
+	util::ThreadPool pool(4);
+	pool.forEach(taskIndices, [&](size_t _task) {
+		// All tasks intern the same strings, but in a different order.
+		for (size_t i = 0; i < stringsPerTask; ++i)
+		{
+			size_t index = (i * (2 * _task + 1)) % stringsPerTask;
+			results[_task].emplace_back("concurrent_" + to_string(index));
+		}
+	});
+
+	for (size_t task = 0; task < tasks; ++task)
+		for (size_t i = 0; i < stringsPerTask; ++i)
+		{
+			size_t index = (i * (2 * task + 1)) % stringsPerTask;
+			YulString const& s = results[task][i];
+			BOOST_REQUIRE_EQUAL(s.str(), "concurrent_" + to_string(index));
+			BOOST_REQUIRE(s == YulString{"concurrent_" + to_string(index)});
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
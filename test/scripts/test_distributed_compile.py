@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+
+import unittest
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from distributed_compile import analysis_input, codegen_contracts, job_input, merge_outputs, split_into_jobs
+# pragma pylint: enable=import-error
+
+
+STANDARD_JSON_INPUT = {
+    'language': 'Solidity',
+    'sources': {
+        'A.sol': {'content': 'contract A {} contract B {}'},
+        'C.sol': {'content': 'import "A.sol"; contract C is A {}'},
+    },
+    'settings': {
+        'outputSelection': {
+            '*': {
+                '': ['ast'],
+                '*': ['evm.bytecode.object', 'metadata'],
+            },
+            'C.sol': {'C': ['irOptimized']},
+        },
+    },
+}
+
+ANALYSIS_OUTPUT = {
+    'contracts': {
+        'A.sol': {'A': {'abi': [], 'metadata': 'mA'}, 'B': {'abi': [], 'metadata': 'mB'}},
+        'C.sol': {'C': {'abi': [], 'metadata': 'mC'}},
+    },
+    'errors': [{'severity': 'warning', 'message': 'W'}],
+    'sources': {'A.sol': {'id': 0}, 'C.sol': {'id': 1}},
+}
+
+
+class TestDistributedCompile(unittest.TestCase):
+    def test_analysis_input(self):
+        selection = analysis_input(STANDARD_JSON_INPUT)['settings']['outputSelection']
+        self.assertEqual(selection, {
+            '*': {'': ['ast'], '*': ['metadata', 'abi']},
+        })
+        # The input itself is not modified.
+        self.assertIn('evm.bytecode.object', STANDARD_JSON_INPUT['settings']['outputSelection']['*']['*'])
+
+    def test_jobs(self):
+        contracts = codegen_contracts(STANDARD_JSON_INPUT, ANALYSIS_OUTPUT)
+        self.assertEqual(contracts, [('A.sol', 'A'), ('A.sol', 'B'), ('C.sol', 'C')])
+
+        jobs = split_into_jobs(contracts, 2)
+        self.assertEqual(jobs, [[('A.sol', 'A'), ('C.sol', 'C')], [('A.sol', 'B')]])
+        self.assertEqual(split_into_jobs(contracts, 5), [[contract] for contract in contracts])
+
+        selection = job_input(STANDARD_JSON_INPUT, jobs[0])['settings']['outputSelection']
+        self.assertEqual(selection, {
+            'A.sol': {'A': ['evm.bytecode.object']},
+            'C.sol': {'C': ['evm.bytecode.object', 'irOptimized']},
+        })
+
+    def test_merge_outputs(self):
+        job_outputs = [
+            {
+                'contracts': {
+                    'A.sol': {'A': {'evm': {'bytecode': {'object': '00'}}}},
+                    'C.sol': {'C': {'evm': {'bytecode': {'object': '02'}}, 'irOptimized': 'ir'}},
+                },
+                'errors': [{'severity': 'warning', 'message': 'W'}],
+            },
+            {
+                'contracts': {'A.sol': {'B': {'evm': {'bytecode': {'object': '01'}}}}},
+                'errors': [{'severity': 'warning', 'message': 'X'}],
+            },
+        ]
+        self.assertEqual(merge_outputs(STANDARD_JSON_INPUT, ANALYSIS_OUTPUT, job_outputs), {
+            'contracts': {
+                'A.sol': {
+                    'A': {'metadata': 'mA', 'evm': {'bytecode': {'object': '00'}}},
+                    'B': {'metadata': 'mB', 'evm': {'bytecode': {'object': '01'}}},
+                },
+                'C.sol': {'C': {'metadata': 'mC', 'evm': {'bytecode': {'object': '02'}}, 'irOptimized': 'ir'}},
+            },
+            'errors': [{'severity': 'warning', 'message': 'W'}, {'severity': 'warning', 'message': 'X'}],
+            'sources': {'A.sol': {'id': 0}, 'C.sol': {'id': 1}},
+        })
+
+
+if __name__ == '__main__':
+    unittest.main()
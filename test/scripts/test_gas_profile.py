@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+
+import unittest
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from gas_profile import LineIndex, SourceMapEntry
+from gas_profile import format_collapsed, format_per_line, instruction_offsets, parse_source_map, profile_trace
+# pragma pylint: enable=import-error
+
+
+SOURCE = "contract C {\n    function f() {\n        g();\n    }\n    function g() {}\n}\n"
+
+
+class TestGasProfile(unittest.TestCase):
+    def test_parse_source_map(self):
+        self.assertEqual(parse_source_map("1:2:0:-;:3;5::1:i;;"), [
+            SourceMapEntry(1, 2, 0, '-'),
+            SourceMapEntry(1, 3, 0, '-'),
+            SourceMapEntry(5, 3, 1, 'i'),
+            SourceMapEntry(5, 3, 1, 'i'),
+            SourceMapEntry(5, 3, 1, 'i'),
+        ])
+
+    def test_instruction_offsets(self):
+        # PUSH1 0x80 PUSH2 0x0102 JUMPDEST STOP
+        self.assertEqual(instruction_offsets(bytes.fromhex('6080610102' + '5b00')), {0: 0, 2: 1, 5: 2, 6: 3})
+
+    def test_profile(self):
+        lines = LineIndex({0: ('C.sol', SOURCE)})
+        call_g = SOURCE.index('g();')
+        function_g = SOURCE.index('function g')
+        function_f = SOURCE.index('function f')
+        # JUMPDEST PUSH1 JUMP JUMPDEST JUMP JUMPDEST CALL STOP
+        bytecode = bytes.fromhex('5b6000565b565bf100')
+        source_map = parse_source_map(
+            f"{function_f}:10:0:-;{call_g}:3:0:-;{call_g}:3:0:i;{function_g}:15:0:-;{function_g}:15:0:o;"
+            f"{call_g}:3:0:-;;-1:-1:-1:-"
+        )
+        steps = [
+            {'pc': 0, 'gasCost': '0x1', 'depth': 1},
+            {'pc': 1, 'gasCost': '0x3', 'depth': 1},
+            {'pc': 3, 'gasCost': '0x8', 'depth': 1},
+            {'pc': 4, 'gasCost': '0x1', 'depth': 1},
+            {'pc': 5, 'gasCost': '0x8', 'depth': 1},
+            {'pc': 6, 'gasCost': '0x1', 'depth': 1},
+            {'pc': 7, 'gasCost': '0x64', 'depth': 1},
+            {'pc': 0, 'gasCost': '0x2', 'depth': 2},
+            {'pc': 8, 'gasCost': '0x0', 'depth': 1},
+        ]
+        profile = profile_trace(steps, bytecode, source_map, lines)
+        self.assertEqual(profile.per_line, {(0, 2): 1, (0, 3): 114, (0, 5): 9})
+        self.assertEqual(profile.unattributed, 0)
+        self.assertEqual(format_collapsed(profile), (
+            "C.sol:2 1\n"
+            "C.sol:3 114\n"
+            "C.sol:5;C.sol:5 9\n"
+        ))
+        self.assertEqual(format_per_line(profile, lines), (
+            "       114  91.94%  C.sol:3  g();\n"
+            "         9   7.26%  C.sol:5  function g() {}\n"
+            "         1   0.81%  C.sol:2  function f() {\n"
+        ))
+
+
+if __name__ == '__main__':
+    unittest.main()
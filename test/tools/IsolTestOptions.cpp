@@ -64,7 +64,13 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates), "Automatically accept expectation updates.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		(
+			"jobs,j",
+			po::value<size_t>(&jobs)->default_value(1),
+			"Number of test cases that are run concurrently in separate processes. "
+			"Failing test cases are run again one by one, so that they can be updated interactively."
+		);
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -92,6 +98,10 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs must be at least one.");
+#if !defined(__unix__) && !defined(__APPLE__)
+	assertThrow(jobs == 1, ConfigException, "Running test cases concurrently is not supported on this platform.");
+#endif
 }
 
 }
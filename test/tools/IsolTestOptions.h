@@ -33,6 +33,8 @@ struct IsolTestOptions: CommonOptions
 	bool noColor = false;
 	bool acceptUpdates = false;
 	std::string testFilter = std::string{};
+	/// Number of test cases that are run concurrently in separate processes.
+	size_t jobs = 1;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
@@ -18,6 +18,7 @@
 
 #include "libsolidity/formal/ModelCheckerSettings.h"
 #include <test/tools/fuzzer_common.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 #include <libsolidity/interface/CompilerStack.h>
 
@@ -90,6 +91,8 @@ void FuzzerUtil::testCompiler(
 	bool _compileViaYul
 )
 {
+	// The compiler stack resets the types, but not the Yul strings of previous inputs.
+	yul::test::yul_fuzzer::resetYulStrings();
 	frontend::CompilerStack compiler;
 	EVMVersion evmVersion = s_evmVersions[_rand % s_evmVersions.size()];
 	frontend::OptimiserSettings optimiserSettings;
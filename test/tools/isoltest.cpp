@@ -29,13 +29,20 @@
 #include <boost/filesystem.hpp>
 
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <queue>
 #include <regex>
 #include <utility>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <csignal>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -113,7 +120,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case if it matches the filter and prints its results to @a _stream.
+	Result process(ostream& _stream = cout);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -148,7 +156,7 @@ private:
 string TestTool::editor;
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 
@@ -156,7 +164,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -173,22 +181,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -197,13 +205,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -211,7 +219,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -270,6 +278,146 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+namespace
+{
+
+/**
+ * Runs test cases in child processes. The child process @a k runs the test cases
+ * @a k, @a k + n, @a k + 2n, ... and reports their results through a pipe in this
+ * order, so that the results can be collected in the order of the test cases.
+ */
+class TestProcesses
+{
+public:
+	using Report = pair<TestTool::Result, string>;
+
+	TestProcesses(size_t _processCount, size_t _testCount, function<Report(size_t)> const& _runTest)
+	{
+		cout.flush();
+		cerr.flush();
+		for (size_t process = 0; process < _processCount; ++process)
+		{
+			int fds[2];
+			if (pipe(fds) != 0)
+				fail("Could not create pipe");
+			pid_t const pid = fork();
+			if (pid < 0)
+			{
+				close(fds[0]);
+				close(fds[1]);
+				fail("Could not start test process");
+			}
+			if (pid == 0)
+			{
+				for (int readEnd: m_readEnds)
+					close(readEnd);
+				close(fds[0]);
+				for (size_t index = process; index < _testCount; index += _processCount)
+				{
+					Report report = _runTest(index);
+					Header header{static_cast<uint8_t>(report.first), report.second.size()};
+					if (
+						!writeAll(fds[1], &header, sizeof(header)) ||
+						!writeAll(fds[1], report.second.data(), report.second.size())
+					)
+						break;
+				}
+				cout.flush();
+				cerr.flush();
+				_exit(0);
+			}
+			close(fds[1]);
+			m_readEnds.push_back(fds[0]);
+			m_pids.push_back(pid);
+		}
+	}
+
+	~TestProcesses() { stop(); }
+
+	TestProcesses(TestProcesses const&) = delete;
+	TestProcesses& operator=(TestProcesses const&) = delete;
+
+	/// @returns the report of the test case @a _index or nullopt if its process terminated
+	/// before reporting it. Has to be called with increasing indices without gaps.
+	optional<Report> report(size_t _index)
+	{
+		int const readEnd = m_readEnds[_index % m_readEnds.size()];
+		Header header;
+		if (!readAll(readEnd, &header, sizeof(header)))
+			return nullopt;
+		string output(header.outputSize, '\0');
+		if (!readAll(readEnd, output.data(), output.size()))
+			return nullopt;
+		return Report{static_cast<TestTool::Result>(header.result), move(output)};
+	}
+
+private:
+	struct Header
+	{
+		uint8_t result;
+		size_t outputSize;
+	};
+
+	static bool writeAll(int _fd, void const* _data, size_t _size)
+	{
+		auto const* data = static_cast<char const*>(_data);
+		while (_size > 0)
+		{
+			ssize_t const written = write(_fd, data, _size);
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+			data += written;
+			_size -= static_cast<size_t>(written);
+		}
+		return true;
+	}
+
+	static bool readAll(int _fd, void* _data, size_t _size)
+	{
+		auto* data = static_cast<char*>(_data);
+		while (_size > 0)
+		{
+			ssize_t const bytesRead = read(_fd, data, _size);
+			if (bytesRead < 0 && errno == EINTR)
+				continue;
+			if (bytesRead <= 0)
+				return false;
+			data += bytesRead;
+			_size -= static_cast<size_t>(bytesRead);
+		}
+		return true;
+	}
+
+	void stop()
+	{
+		for (int readEnd: m_readEnds)
+			close(readEnd);
+		for (pid_t pid: m_pids)
+		{
+			kill(pid, SIGTERM);
+			waitpid(pid, nullptr, 0);
+		}
+		m_readEnds.clear();
+		m_pids.clear();
+	}
+
+	[[noreturn]] void fail(string const& _message)
+	{
+		string const reason = strerror(errno);
+		stop();
+		BOOST_THROW_EXCEPTION(runtime_error(_message + ": " + reason));
+	}
+
+	vector<int> m_readEnds;
+	vector<pid_t> m_pids;
+};
+
+}
+#endif
+
 TestStats TestTool::processPath(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
@@ -279,18 +427,16 @@ TestStats TestTool::processPath(
 {
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
+	vector<fs::path> testPaths;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -298,56 +444,92 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
-		{
-			++testCount;
-			paths.pop();
-		}
 		else
+			testPaths.push_back(currentPath);
+	}
+
+	auto testTool = [&](fs::path const& _testPath) {
+		return TestTool(
+			_testCaseCreator,
+			_options,
+			_basepath / _testPath,
+			_testPath.generic_path().string()
+		);
+	};
+
+#if defined(__unix__) || defined(__APPLE__)
+	unique_ptr<TestProcesses> processes;
+	if (_options.jobs > 1 && testPaths.size() > 1 && !m_exitRequested)
+		processes = make_unique<TestProcesses>(
+			min(_options.jobs, testPaths.size()),
+			testPaths.size(),
+			[&](size_t _index) {
+				ostringstream output;
+				Result result = testTool(testPaths[_index]).process(output);
+				return TestProcesses::Report{result, output.str()};
+			}
+		);
+#endif
+
+	TestStats stats;
+	for (size_t index = 0; index < testPaths.size(); ++index)
+	{
+		++stats.testCount;
+		if (m_exitRequested)
+			continue;
+
+#if defined(__unix__) || defined(__APPLE__)
+		// Failing test cases and those whose process terminated unexpectedly are run again
+		// below, so that they can be updated interactively.
+		if (processes)
+			if (optional<TestProcesses::Report> report = processes->report(index))
+				if (report->first == Result::Success || report->first == Result::Skipped)
+				{
+					(cout << report->second).flush();
+					++(report->first == Result::Success ? stats.successCount : stats.skippedCount);
+					continue;
+				}
+#endif
+
+		TestTool tool = testTool(testPaths[index]);
+		while (true)
 		{
-			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			auto result = tool.process();
 
 			switch(result)
 			{
 			case Result::Failure:
 			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
+				switch(tool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
 					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
+					continue;
 				case Request::Skip:
-					paths.pop();
-					++skippedCount;
+					++stats.skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
-				++successCount;
+				++stats.successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
+				++stats.skippedCount;
 				break;
 			}
+			break;
 		}
-	}
 
-	return { successCount, testCount, skippedCount };
+#if defined(__unix__) || defined(__APPLE__)
+		if (m_exitRequested)
+			processes.reset();
+#endif
+	}
 
+	return stats;
 }
 
 namespace
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <test/tools/ossfuzz/SolidityEvmoneInterface.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 #include <test/tools/ossfuzz/protoToAbiV2.h>
 
@@ -55,6 +56,8 @@ DEFINE_PROTO_FUZZER(Contract const& _contract)
 		auto [encodeStatus, encodedData] = coder.encode(typeString, valueString);
 		solAssert(encodeStatus, "Isabelle abicoder fuzzer: Encoding failed");
 
+		solidity::yul::test::yul_fuzzer::resetYulStrings();
+
 		// We target the default EVM which is the latest
 		langutil::EVMVersion version;
 		EVMHost hostContext(version, evmone);
@@ -17,6 +17,7 @@
 
 #include <test/tools/ossfuzz/yulProto.pb.h>
 #include <test/tools/ossfuzz/protoToYul.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 #include <test/EVMHost.h>
 
@@ -76,7 +77,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	if (yul_source.size() > 1200)
 		return;
 
-	YulStringRepository::reset();
+	resetYulStrings();
 
 	solidity::frontend::OptimiserSettings settings = solidity::frontend::OptimiserSettings::full();
 	settings.runYulOptimiser = false;
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <test/tools/ossfuzz/SolidityEvmoneInterface.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 #include <test/tools/ossfuzz/protoToAbiV2.h>
 
 #include <src/libfuzzer/libfuzzer_macro.h>
@@ -45,6 +46,8 @@ DEFINE_PROTO_FUZZER(Contract const& _input)
 		of << contract_source;
 	}
 
+	solidity::yul::test::yul_fuzzer::resetYulStrings();
+
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
 	EVMHost hostContext(version, evmone);
@@ -18,6 +18,7 @@
 
 #include <test/tools/ossfuzz/protoToSol.h>
 #include <test/tools/ossfuzz/SolidityEvmoneInterface.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 #include <test/tools/ossfuzz/solProto.pb.h>
 
 #include <test/EVMHost.h>
@@ -63,6 +64,8 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 		std::cout << sol_source << std::endl;
 	}
 
+	solidity::yul::test::yul_fuzzer::resetYulStrings();
+
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
 	EVMHost hostContext(version, evmone);
@@ -21,6 +21,7 @@
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
 
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/EVMVersion.h>
@@ -29,6 +30,7 @@
 #include <libsolutil/CommonData.h>
 
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 #include <string>
 #include <memory>
@@ -56,7 +58,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	}))
 		return 0;
 
-	YulStringRepository::reset();
+	resetYulStrings();
 
 	AssemblyStack stack(
 		langutil::EVMVersion(),
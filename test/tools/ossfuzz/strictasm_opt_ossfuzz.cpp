@@ -16,12 +16,15 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
+
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
 
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
+using namespace solidity::yul::test::yul_fuzzer;
 using namespace std;
 
 // Prototype as we can't use the FuzzerInterface.h header.
@@ -32,7 +35,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	if (_size > 600)
 		return 0;
 
-	YulStringRepository::reset();
+	resetYulStrings();
 
 	string input(reinterpret_cast<char const*>(_data), _size);
 	AssemblyStack stack(
@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Reset of the global state between the inputs of fuzzers running in persistent mode.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/YulString.h>
+
+#include <liblangutil/EVMVersion.h>
+
+namespace solidity::yul::test::yul_fuzzer
+{
+
+/// Removes the Yul strings of previous inputs, so that the repository does not keep growing
+/// while a fuzzer processes many inputs in the same process. The EVM dialects of all EVM versions
+/// are created before the first input and kept with their strings, so that they are not created
+/// again for every input. Must be called when no YulStrings of previous inputs are alive.
+inline void resetYulStrings()
+{
+	static size_t const persistentStrings = [] {
+		for (langutil::EVMVersion version: {
+			langutil::EVMVersion::homestead(),
+			langutil::EVMVersion::tangerineWhistle(),
+			langutil::EVMVersion::spuriousDragon(),
+			langutil::EVMVersion::byzantium(),
+			langutil::EVMVersion::constantinople(),
+			langutil::EVMVersion::petersburg(),
+			langutil::EVMVersion::istanbul(),
+			langutil::EVMVersion::berlin()
+		})
+		{
+			EVMDialect::strictAssemblyForEVM(version);
+			EVMDialect::strictAssemblyForEVMObjects(version);
+		}
+		return YulStringRepository::instance().size();
+	}();
+	YulStringRepository::resetTo(persistentStrings);
+}
+
+}
@@ -20,6 +20,7 @@
 
 #include <test/tools/ossfuzz/yulProto.pb.h>
 #include <test/tools/ossfuzz/protoToYul.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 #include <test/tools/fuzzer_common.h>
 
@@ -58,7 +59,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	if (yul_source.size() > 1200)
 		return;
 
-	YulStringRepository::reset();
+	resetYulStrings();
 
 	// AssemblyStack entry point
 	AssemblyStack stack(
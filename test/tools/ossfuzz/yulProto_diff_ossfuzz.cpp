@@ -34,6 +34,7 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
+#include <test/tools/ossfuzz/yulFuzzerReset.h>
 
 using namespace std;
 using namespace solidity;
@@ -71,7 +72,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 		of.write(yul_source.data(), static_cast<streamsize>(yul_source.size()));
 	}
 
-	YulStringRepository::reset();
+	resetYulStrings();
 
 	// AssemblyStack entry point
 	AssemblyStack stack(
@@ -0,0 +1,385 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compiler benchmark. Compiles a corpus of projects with several settings and reports
+ * the time spent in each phase of the compilation and the peak heap usage as JSON,
+ * optionally comparing them to the results of an earlier run.
+ */
+
+#include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Number of bytes currently allocated through the global operator new and the maximum since
+/// the last reset. Every allocation is preceded by a header that stores its size.
+atomic<size_t> g_allocatedBytes{0};
+atomic<size_t> g_peakAllocatedBytes{0};
+size_t constexpr g_allocationHeaderSize = alignof(max_align_t) > sizeof(size_t) ? alignof(max_align_t) : sizeof(size_t);
+
+void resetPeakAllocatedBytes()
+{
+	g_peakAllocatedBytes = g_allocatedBytes.load();
+}
+
+struct Configuration
+{
+	string name;
+	bool optimize = false;
+	bool viaIR = false;
+};
+
+vector<Configuration> const g_configurations{
+	{"legacy", false, false},
+	{"optimized", true, false},
+	{"via-ir", true, true},
+};
+
+/// @returns the contents of all Solidity files in @a _directory and its subdirectories,
+/// keyed by their path relative to @a _directory.
+map<string, string> readProject(fs::path const& _directory)
+{
+	map<string, string> sources;
+	for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+			sources[fs::relative(it->path(), _directory).generic_string()] = readFileAsString(it->path().string());
+	return sources;
+}
+
+Json::Value standardJsonInput(map<string, string> const& _sources, Configuration const& _configuration, unsigned _jobs)
+{
+	Json::Value input(Json::objectValue);
+	input["language"] = "Solidity";
+	for (auto const& [name, content]: _sources)
+		input["sources"][name]["content"] = content;
+	Json::Value& settings = input["settings"];
+	settings["optimizer"]["enabled"] = _configuration.optimize;
+	settings["viaIR"] = _configuration.viaIR;
+	settings["parallelism"] = _jobs;
+	settings["debug"]["profile"] = true;
+	settings["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+	settings["outputSelection"]["*"]["*"].append("evm.deployedBytecode.object");
+	return input;
+}
+
+/// Compiles @a _input once.
+/// @returns the wall time, CPU time and peak heap usage of the compilation and the
+/// phases summed over all contracts, or the first error.
+Json::Value compileOnce(Json::Value const& _input)
+{
+	StandardCompiler compiler;
+	resetPeakAllocatedBytes();
+	size_t const allocatedBefore = g_allocatedBytes;
+	clock_t const cpuStart = clock();
+	auto const wallStart = chrono::steady_clock::now();
+	Json::Value output = compiler.compile(_input);
+	double const wallTime = chrono::duration<double, milli>(chrono::steady_clock::now() - wallStart).count();
+	double const cpuTime = static_cast<double>(clock() - cpuStart) * 1000 / CLOCKS_PER_SEC;
+	size_t const peakAllocated = g_peakAllocatedBytes - allocatedBefore;
+
+	Json::Value result(Json::objectValue);
+	for (Json::Value const& error: output["errors"])
+		if (error["severity"].asString() == "error")
+		{
+			result["error"] = error["formattedMessage"];
+			return result;
+		}
+
+	result["wallTime"] = wallTime;
+	result["cpuTime"] = cpuTime;
+	result["peakAllocatedBytes"] = Json::UInt64(peakAllocated);
+	Json::Value& phases = result["phases"] = Json::objectValue;
+	for (string const& scope: output["profile"].getMemberNames())
+		for (Json::Value const& phase: output["profile"][scope])
+		{
+			Json::Value& total = phases[phase["name"].asString()];
+			total["wallTime"] = total["wallTime"].asDouble() + phase["wallTime"].asDouble();
+			total["cpuTime"] = total["cpuTime"].asDouble() + phase["cpuTime"].asDouble();
+			total["count"] = total["count"].asUInt64() + phase["count"].asUInt64();
+		}
+	return result;
+}
+
+/// Compiles @a _input @a _repetitions times and takes the minimum of each time over all runs
+/// to reduce the noise. The peak heap usage does not depend on the run.
+Json::Value benchmark(Json::Value const& _input, unsigned _repetitions)
+{
+	Json::Value best = compileOnce(_input);
+	for (unsigned i = 1; i < _repetitions && !best.isMember("error"); ++i)
+	{
+		Json::Value result = compileOnce(_input);
+		auto takeMinimum = [](Json::Value& _best, Json::Value const& _other, char const* _key) {
+			if (_other[_key].asDouble() < _best[_key].asDouble())
+				_best[_key] = _other[_key];
+		};
+		takeMinimum(best, result, "wallTime");
+		takeMinimum(best, result, "cpuTime");
+		for (string const& name: best["phases"].getMemberNames())
+			if (result["phases"].isMember(name))
+			{
+				takeMinimum(best["phases"][name], result["phases"][name], "wallTime");
+				takeMinimum(best["phases"][name], result["phases"][name], "cpuTime");
+			}
+	}
+	return best;
+}
+
+/// Reports the total times, the times of the phases that are not nested in other phases
+/// and the peak heap usage that increased by more than @a _threshold percent compared to @a _baseline.
+/// Times below @a _minimumTime milliseconds are ignored, since they are dominated by noise.
+/// @returns the number of regressions.
+size_t compare(Json::Value const& _results, Json::Value const& _baseline, double _threshold, double _minimumTime)
+{
+	size_t regressions = 0;
+	auto check = [&](string const& _what, double _old, double _new, bool _isTime) {
+		if (_isTime && max(_old, _new) < _minimumTime)
+			return;
+		if (_new <= _old * (1 + _threshold / 100))
+			return;
+		++regressions;
+		cerr << "Regression: " << _what << ": " << fixed << setprecision(_isTime ? 1 : 0) << _old << " -> " << _new;
+		cerr << (_isTime ? " ms" : " bytes");
+		if (_old > 0)
+			cerr << " (+" << setprecision(1) << (_new / _old - 1) * 100 << "%)";
+		cerr << endl;
+	};
+
+	for (string const& project: _results.getMemberNames())
+		for (string const& configuration: _results[project].getMemberNames())
+		{
+			Json::Value const& result = _results[project][configuration];
+			Json::Value const& base = _baseline[project][configuration];
+			if (!base.isObject() || base.isMember("error") || result.isMember("error"))
+				continue;
+			string const prefix = project + "/" + configuration;
+			check(prefix + " wall time", base["wallTime"].asDouble(), result["wallTime"].asDouble(), true);
+			check(prefix + " CPU time", base["cpuTime"].asDouble(), result["cpuTime"].asDouble(), true);
+			check(
+				prefix + " peak heap usage",
+				base["peakAllocatedBytes"].asDouble(),
+				result["peakAllocatedBytes"].asDouble(),
+				false
+			);
+			for (string const& phase: result["phases"].getMemberNames())
+				if (phase.find('/') == string::npos && base["phases"].isMember(phase))
+					check(
+						prefix + " phase \"" + phase + "\"",
+						base["phases"][phase]["wallTime"].asDouble(),
+						result["phases"][phase]["wallTime"].asDouble(),
+						true
+					);
+		}
+	return regressions;
+}
+
+}
+
+void* operator new(size_t _size)
+{
+	void* memory = malloc(_size + g_allocationHeaderSize);
+	if (!memory)
+		throw bad_alloc();
+	*static_cast<size_t*>(memory) = _size;
+	size_t const allocated = g_allocatedBytes += _size;
+	size_t peak = g_peakAllocatedBytes;
+	while (allocated > peak && !g_peakAllocatedBytes.compare_exchange_weak(peak, allocated))
+	{
+	}
+	return static_cast<char*>(memory) + g_allocationHeaderSize;
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	if (!_pointer)
+		return;
+	void* memory = static_cast<char*>(_pointer) - g_allocationHeaderSize;
+	g_allocatedBytes -= *static_cast<size_t*>(memory);
+	free(memory);
+}
+
+void* operator new(size_t _size, nothrow_t const&) noexcept
+{
+	try
+	{
+		return operator new(_size);
+	}
+	catch (bad_alloc const&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t _size)
+{
+	return operator new(_size);
+}
+
+void* operator new[](size_t _size, nothrow_t const& _nothrow) noexcept
+{
+	return operator new(_size, _nothrow);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	operator delete(_pointer);
+}
+
+void operator delete(void* _pointer, nothrow_t const&) noexcept
+{
+	operator delete(_pointer);
+}
+
+void operator delete[](void* _pointer) noexcept
+{
+	operator delete(_pointer);
+}
+
+void operator delete[](void* _pointer, size_t) noexcept
+{
+	operator delete(_pointer);
+}
+
+void operator delete[](void* _pointer, nothrow_t const&) noexcept
+{
+	operator delete(_pointer);
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, the compiler benchmark.
+Usage: solbench [Options] <project directory>...
+Compiles all Solidity files of each project with the legacy code generator without and
+with the optimizer and via the IR with the optimizer. Prints the wall time, CPU time,
+peak heap usage and time per compiler phase of each compilation as JSON.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<unsigned>()->default_value(3), "Compile each project this many times and report the minimum times.")
+		("jobs", po::value<unsigned>()->default_value(1), "Number of threads the compiler may use.")
+		("output", po::value<string>(), "Write the results to the given file instead of standard output.")
+		("baseline", po::value<string>(), "Compare the results to those of an earlier run in the given file and exit with code 2 if any regressed.")
+		("threshold", po::value<double>()->default_value(10), "Relative increase, in percent, that is reported as a regression.")
+		("min-time", po::value<double>()->default_value(20), "Times below this many milliseconds are not compared.")
+		("input-dir", po::value<vector<string>>(), "project directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-dir", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-dir"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+	unsigned const repetitions = max(1u, arguments["repetitions"].as<unsigned>());
+	unsigned const jobs = max(1u, arguments["jobs"].as<unsigned>());
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+	{
+		string const path = arguments["baseline"].as<string>();
+		string errors;
+		if (!jsonParseStrict(readFileAsString(path), baseline, &errors))
+		{
+			cerr << "Invalid baseline " << path << ": " << errors << endl;
+			return 1;
+		}
+	}
+
+	Json::Value output(Json::objectValue);
+	output["compilerVersion"] = VersionString;
+	output["repetitions"] = repetitions;
+	output["jobs"] = jobs;
+	Json::Value& results = output["results"];
+	for (string const& directory: arguments["input-dir"].as<vector<string>>())
+	{
+		fs::path const path(directory);
+		if (!fs::is_directory(path))
+		{
+			cerr << "Not a directory: " << directory << endl;
+			return 1;
+		}
+		string const project = fs::canonical(path).filename().string();
+		map<string, string> const sources = readProject(path);
+		for (Configuration const& configuration: g_configurations)
+		{
+			cerr << "Compiling " << project << " (" << configuration.name << ")" << endl;
+			Json::Value result = benchmark(standardJsonInput(sources, configuration, jobs), repetitions);
+			if (result.isMember("error"))
+				cerr << "Compilation failed: " << result["error"].asString() << endl;
+			results[project][configuration.name] = move(result);
+		}
+	}
+
+	if (arguments.count("output"))
+		ofstream(arguments["output"].as<string>()) << jsonPrettyPrint(output) << endl;
+	else
+		cout << jsonPrettyPrint(output) << endl;
+
+	if (baseline.isObject() && compare(
+		results,
+		baseline["results"],
+		arguments["threshold"].as<double>(),
+		arguments["min-time"].as<double>()
+	))
+		return 2;
+	return 0;
+}
@@ -0,0 +1,493 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Runtime gas benchmark. Deploys a corpus of contracts compiled with several settings,
+ * executes a scripted sequence of calls on each of them and reports the gas used by the
+ * deployment and every call as JSON, optionally comparing it to the results of an earlier run.
+ */
+
+#include <test/Common.h>
+#include <test/ExecutionFramework.h>
+#include <test/TestCaseReader.h>
+#include <test/libsolidity/util/SoltestTypes.h>
+#include <test/libsolidity/util/TestFileParser.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libyul/optimiser/Suite.h>
+#include <libyul/Exceptions.h>
+
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+using namespace solidity::frontend::test;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+auto const description = R"(solgasbench, the runtime gas benchmark.
+Usage: solgasbench [Options]
+Compiles each benchmark with the legacy code generator without and with the optimizer and
+via the IR with the optimizer, deploys it and executes its calls. Prints the gas used by the
+deployment and each call as JSON and a comparison of the settings to standard error.
+
+Allowed options)";
+
+struct GasBenchmarkOptions: CommonOptions
+{
+	bool showHelp = false;
+	/// Benchmark files to run. All files in the ``gasBenchmarks`` directory of the test path if empty.
+	vector<string> benchmarks;
+	string yulOptimizations;
+	size_t optimizeRuns = 200;
+	string outputFile;
+	string baselineFile;
+	double threshold = 0;
+
+	GasBenchmarkOptions();
+	bool parse(int _argc, char const* const* _argv) override;
+	void validate() const override;
+};
+
+GasBenchmarkOptions::GasBenchmarkOptions():
+	CommonOptions(description)
+{
+	options.add_options()
+		("help", po::bool_switch(&showHelp), "Show this help screen.")
+		("benchmark", po::value<vector<string>>(&benchmarks), "Benchmark file to run, can be supplied multiple times. Defaults to all files in <testpath>/gasBenchmarks.")
+		("yul-optimizations", po::value<string>(&yulOptimizations), "Additionally compile via the IR with this sequence of Yul optimizer steps.")
+		("optimize-runs", po::value<size_t>(&optimizeRuns)->default_value(200), "The number of runs the optimizer optimizes for.")
+		("output", po::value<string>(&outputFile), "Write the results to the given file instead of standard output.")
+		("baseline", po::value<string>(&baselineFile), "Compare the results to those of an earlier run in the given file and exit with code 2 if any regressed.")
+		("threshold", po::value<double>(&threshold)->default_value(0), "Relative increase of the gas, in percent, that is reported as a regression.");
+}
+
+bool GasBenchmarkOptions::parse(int _argc, char const* const* _argv)
+{
+	bool const res = CommonOptions::parse(_argc, _argv);
+
+	if (showHelp || !res)
+	{
+		cout << options << endl;
+		return false;
+	}
+	return res;
+}
+
+void GasBenchmarkOptions::validate() const
+{
+	CommonOptions::validate();
+	if (!yulOptimizations.empty())
+		try
+		{
+			yul::OptimiserSuite::validateSequence(yulOptimizations);
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			BOOST_THROW_EXCEPTION(ConfigException() << errinfo_comment(
+				"Invalid optimizer step sequence in --yul-optimizations: " + string(_exception.what())
+			));
+		}
+}
+
+struct Configuration
+{
+	string name;
+	OptimiserSettings settings;
+	bool viaIR = false;
+};
+
+vector<Configuration> configurations(GasBenchmarkOptions const& _options)
+{
+	OptimiserSettings optimized = OptimiserSettings::standard();
+	optimized.expectedExecutionsPerDeployment = _options.optimizeRuns;
+
+	vector<Configuration> result{
+		{"legacy", OptimiserSettings::minimal(), false},
+		{"legacy-optimized", optimized, false},
+		{"via-ir", optimized, true},
+	};
+	if (!_options.yulOptimizations.empty())
+	{
+		OptimiserSettings custom = optimized;
+		custom.yulOptimiserSteps = _options.yulOptimizations;
+		result.push_back({"via-ir-custom", custom, true});
+	}
+	return result;
+}
+
+/// A benchmark in the format of the semantic tests: The sources, followed by the calls
+/// and their expected results.
+class GasBenchmark: public ExecutionFramework
+{
+public:
+	explicit GasBenchmark(string const& _filename)
+	{
+		TestCaseReader reader(_filename);
+		m_sources = reader.sources();
+		reader.ensureAllSettingsRead();
+		m_calls = TestFileParser{reader.stream(), m_builtins}.parseFunctionCalls(reader.lineNumber());
+	}
+
+	/// Deploys the contracts compiled with @a _configuration and executes the calls.
+	/// @returns the gas used by the deployment and each call or the first error.
+	Json::Value run(Configuration const& _configuration)
+	{
+		reset();
+		m_configuration = &_configuration;
+
+		Json::Value result(Json::objectValue);
+		auto fail = [&](string const& _error) {
+			Json::Value error(Json::objectValue);
+			error["error"] = _error;
+			return error;
+		};
+
+		map<string, h160> libraries;
+		u256 deploymentGas = 0;
+		bool constructed = false;
+		Json::Value& calls = result["calls"] = Json::arrayValue;
+		u256 total = 0;
+		for (frontend::test::FunctionCall const& call: m_calls)
+		{
+			if (call.kind == frontend::test::FunctionCall::Kind::Library)
+			{
+				if (constructed)
+					return fail("Libraries have to be deployed before any other call.");
+				if (!deploy(call.signature, 0, {}, libraries) || !m_transactionSuccessful)
+					return fail(m_error.empty() ? "Failed to deploy library " + call.signature : m_error);
+				libraries[call.signature] = m_contractAddress;
+				deploymentGas += m_gasUsed;
+				continue;
+			}
+			if (!constructed)
+			{
+				bool const hasConstructorCall = call.kind == frontend::test::FunctionCall::Kind::Constructor;
+				if (!deploy(
+					"",
+					hasConstructorCall ? call.value.value : u256(0),
+					hasConstructorCall ? call.arguments.rawBytes() : bytes(),
+					libraries
+				))
+					return fail(m_error);
+				constructed = true;
+				deploymentGas += m_gasUsed;
+				if (hasConstructorCall)
+				{
+					if (m_transactionSuccessful == call.expectations.failure)
+						return fail("Unexpected result of the constructor call.");
+					continue;
+				}
+				if (!m_transactionSuccessful)
+					return fail("Failed to deploy the contract.");
+			}
+			else if (call.kind == frontend::test::FunctionCall::Kind::Constructor)
+				return fail("The constructor has to be the first call except for library deployments.");
+
+			bytes output;
+			if (call.kind == frontend::test::FunctionCall::Kind::LowLevel)
+				output = callLowLevel(call.arguments.rawBytes(), call.value.value);
+			else if (call.kind == frontend::test::FunctionCall::Kind::Builtin)
+				return fail("Builtin functions are not supported in benchmarks.");
+			else
+				output = callContractFunctionWithValueNoEncoding(call.signature, call.value.value, call.arguments.rawBytes());
+
+			if (m_transactionSuccessful == call.expectations.failure || output != call.expectations.rawBytes())
+				return fail(
+					"Unexpected result of " + call.signature + ": " +
+					(m_transactionSuccessful ? "" : "FAILURE ") + "0x" + toHex(output)
+				);
+
+			Json::Value& entry = calls.append(Json::objectValue);
+			entry["call"] = call.signature;
+			entry["gas"] = Json::UInt64(m_gasUsed.convert_to<uint64_t>());
+			total += m_gasUsed;
+		}
+		result["deployment"] = Json::UInt64(deploymentGas.convert_to<uint64_t>());
+		result["total"] = Json::UInt64(total.convert_to<uint64_t>());
+		return result;
+	}
+
+	bytes const& compileAndRunWithoutCheck(
+		map<string, string> const& _sourceCode,
+		u256 const& _value = 0,
+		string const& _contractName = "",
+		bytes const& _arguments = {},
+		map<string, h160> const& _libraryAddresses = {},
+		optional<string> const& _sourceName = nullopt
+	) override
+	{
+		solAssert(m_configuration, "");
+		m_error.clear();
+		m_output.clear();
+		m_transactionSuccessful = false;
+
+		CompilerStack compiler;
+		compiler.setSources(_sourceCode);
+		compiler.setLibraries(_libraryAddresses);
+		compiler.setEVMVersion(m_evmVersion);
+		compiler.setViaIR(m_configuration->viaIR);
+		compiler.setOptimiserSettings(m_configuration->settings);
+		compiler.setMetadataFormat(CompilerStack::MetadataFormat::NoMetadata);
+		compiler.setMetadataHash(CompilerStack::MetadataHash::None);
+		try
+		{
+			if (!compiler.compile())
+			{
+				ostringstream errors;
+				langutil::SourceReferenceFormatter formatter(errors, true, false);
+				for (auto const& error: compiler.errors())
+					formatter.printErrorInformation(*error);
+				m_error = "Compilation failed:\n" + errors.str();
+				return m_output;
+			}
+			string const contractName = _contractName.empty() ? compiler.lastContractName(_sourceName) : _contractName;
+			sendMessage(compiler.object(contractName).bytecode + _arguments, true, _value);
+		}
+		catch (std::exception const& _exception)
+		{
+			m_error = "Compilation failed: " + string(_exception.what());
+		}
+		return m_output;
+	}
+
+private:
+	/// Deploys the contract @a _contractName, or the last contract of the main source.
+	/// @returns false if it could not be compiled.
+	bool deploy(string const& _contractName, u256 const& _value, bytes const& _arguments, map<string, h160> const& _libraries)
+	{
+		compileAndRunWithoutCheck(m_sources.sources, _value, _contractName, _arguments, _libraries, m_sources.mainSourceFile);
+		return m_error.empty();
+	}
+
+	SourceMap m_sources;
+	map<string, Builtin> m_builtins;
+	vector<frontend::test::FunctionCall> m_calls;
+	Configuration const* m_configuration = nullptr;
+	string m_error;
+};
+
+/// Prints the gas of each configuration side by side and the change relative to the first one.
+void printComparison(string const& _benchmark, Json::Value const& _results, vector<Configuration> const& _configurations)
+{
+	Json::Value const& reference = _results[_configurations.front().name];
+	auto printRow = [&](string const& _label, auto&& _gas) {
+		cerr << "  " << left << setw(40) << _label << right;
+		for (Configuration const& configuration: _configurations)
+		{
+			Json::Value const& result = _results[configuration.name];
+			if (result.isMember("error"))
+			{
+				cerr << setw(22) << "error";
+				continue;
+			}
+			double const gas = _gas(result).asDouble();
+			ostringstream cell;
+			cell << fixed << setprecision(0) << gas;
+			if (&configuration != &_configurations.front() && !reference.isMember("error") && _gas(reference).asDouble() > 0)
+				cell << " (" << showpos << setprecision(1) << (gas / _gas(reference).asDouble() - 1) * 100 << "%)";
+			cerr << setw(22) << cell.str();
+		}
+		cerr << endl;
+	};
+
+	cerr << _benchmark << endl << "  " << left << setw(40) << "" << right;
+	for (Configuration const& configuration: _configurations)
+		cerr << setw(22) << configuration.name;
+	cerr << endl;
+
+	printRow("deployment", [](Json::Value const& _result) { return _result["deployment"]; });
+	size_t callCount = 0;
+	for (Configuration const& configuration: _configurations)
+		callCount = max<size_t>(callCount, _results[configuration.name]["calls"].size());
+	for (Json::ArrayIndex i = 0; i < callCount; ++i)
+	{
+		string label;
+		for (Configuration const& configuration: _configurations)
+			if (_results[configuration.name]["calls"].isValidIndex(i))
+				label = _results[configuration.name]["calls"][i]["call"].asString();
+		printRow(label, [&](Json::Value const& _result) { return _result["calls"][i]["gas"]; });
+	}
+	printRow("total runtime", [](Json::Value const& _result) { return _result["total"]; });
+}
+
+/// Reports the deployment and call gas that increased by more than @a _threshold percent
+/// compared to @a _baseline. Calls are matched by their position and signature.
+/// @returns the number of regressions.
+size_t compare(Json::Value const& _results, Json::Value const& _baseline, double _threshold)
+{
+	size_t regressions = 0;
+	auto check = [&](string const& _what, Json::Value const& _old, Json::Value const& _new) {
+		if (!_old.isNumeric() || !_new.isNumeric())
+			return;
+		double const oldGas = _old.asDouble();
+		double const newGas = _new.asDouble();
+		if (newGas <= oldGas * (1 + _threshold / 100))
+			return;
+		++regressions;
+		cerr << "Regression: " << _what << ": " << fixed << setprecision(0) << oldGas << " -> " << newGas;
+		if (oldGas > 0)
+			cerr << " (+" << setprecision(1) << (newGas / oldGas - 1) * 100 << "%)";
+		cerr << endl;
+	};
+
+	for (string const& benchmark: _results.getMemberNames())
+		for (string const& configuration: _results[benchmark].getMemberNames())
+		{
+			Json::Value const& result = _results[benchmark][configuration];
+			Json::Value const& base = _baseline[benchmark][configuration];
+			if (!base.isObject() || base.isMember("error") || result.isMember("error"))
+				continue;
+			string const prefix = benchmark + "/" + configuration;
+			check(prefix + " deployment", base["deployment"], result["deployment"]);
+			check(prefix + " total runtime", base["total"], result["total"]);
+			for (Json::ArrayIndex i = 0; i < result["calls"].size(); ++i)
+				if (
+					base["calls"].isValidIndex(i) &&
+					base["calls"][i]["call"] == result["calls"][i]["call"]
+				)
+					check(
+						prefix + " call " + to_string(i) + " " + result["calls"][i]["call"].asString(),
+						base["calls"][i]["gas"],
+						result["calls"][i]["gas"]
+					);
+		}
+	return regressions;
+}
+
+vector<string> benchmarkFiles(GasBenchmarkOptions const& _options)
+{
+	if (!_options.benchmarks.empty())
+		return _options.benchmarks;
+
+	vector<string> files;
+	for (fs::directory_iterator it(_options.testPath / "gasBenchmarks"), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+			files.push_back(it->path().string());
+	sort(files.begin(), files.end());
+	return files;
+}
+
+}
+
+int main(int argc, char const* argv[])
+{
+	try
+	{
+		auto options = make_unique<GasBenchmarkOptions>();
+		if (!options->parse(argc, argv))
+			return options->showHelp ? 0 : 1;
+		options->validate();
+		CommonOptions::setSingleton(move(options));
+	}
+	catch (ConfigException const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (std::runtime_error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	auto const& options = dynamic_cast<GasBenchmarkOptions const&>(CommonOptions::get());
+	if (!loadVMs(options))
+		return 1;
+
+	Json::Value baseline;
+	if (!options.baselineFile.empty())
+	{
+		string errors;
+		if (!jsonParseStrict(readFileAsString(options.baselineFile), baseline, &errors))
+		{
+			cerr << "Invalid baseline " << options.baselineFile << ": " << errors << endl;
+			return 1;
+		}
+	}
+
+	vector<Configuration> const allConfigurations = configurations(options);
+	Json::Value output(Json::objectValue);
+	output["compilerVersion"] = VersionString;
+	output["evmVersion"] = options.evmVersion().name();
+	output["optimizeRuns"] = Json::UInt64(options.optimizeRuns);
+	if (!options.yulOptimizations.empty())
+		output["yulOptimizations"] = options.yulOptimizations;
+	Json::Value& results = output["results"] = Json::objectValue;
+	bool failed = false;
+	for (string const& file: benchmarkFiles(options))
+	{
+		string const name = fs::path(file).stem().string();
+		try
+		{
+			GasBenchmark benchmark(file);
+			for (Configuration const& configuration: allConfigurations)
+			{
+				Json::Value result = benchmark.run(configuration);
+				if (result.isMember("error"))
+				{
+					cerr << name << " (" << configuration.name << "): " << result["error"].asString() << endl;
+					failed = true;
+				}
+				results[name][configuration.name] = move(result);
+			}
+		}
+		catch (std::exception const& _exception)
+		{
+			cerr << "Invalid benchmark " << file << ": " << _exception.what() << endl;
+			return 1;
+		}
+		printComparison(name, results[name], allConfigurations);
+	}
+
+	if (!options.outputFile.empty())
+		ofstream(options.outputFile) << jsonPrettyPrint(output) << endl;
+	else
+		cout << jsonPrettyPrint(output) << endl;
+
+	if (failed)
+		return 1;
+	if (baseline.isObject() && compare(results, baseline["results"], options.threshold))
+		return 2;
+	return 0;
+}
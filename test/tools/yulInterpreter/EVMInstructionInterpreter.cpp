@@ -25,6 +25,7 @@
 
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AST.h>
+#include <libyul/Exceptions.h>
 
 #include <libevmasm/Instruction.h>
 
@@ -69,7 +70,7 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
@@ -89,7 +90,7 @@ u256 EVMInstructionInterpreter::eval(
 	using namespace solidity::evmasm;
 	using evmasm::Instruction;
 
-	auto info = instructionInfo(_instruction);
+	auto const& info = instructionInfo(_instruction);
 	yulAssert(static_cast<size_t>(info.args) == _arguments.size(), "");
 
 	auto const& arg = _arguments;
@@ -483,8 +484,7 @@ bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _si
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
 	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
+	m_state.memory.read(_offset, data.data(), data.size());
 	return data;
 }
 
@@ -495,8 +495,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 word(_value);
+	m_state.memory.write(_offset, word.data(), word.size);
 }
 
 
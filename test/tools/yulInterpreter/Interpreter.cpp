@@ -26,6 +26,7 @@
 
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/wasm/WasmDialect.h>
@@ -33,11 +34,12 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/Visitor.h>
 
-#include <boost/algorithm/cxx11/all_of.hpp>
-
-#include <range/v3/view/reverse.hpp>
-
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
 #include <ostream>
 #include <variant>
 
@@ -46,8 +48,76 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::yul::test;
 
+using solidity::util::GenericVisitor;
 using solidity::util::h256;
 
+uint8_t& InterpreterMemory::operator[](u256 const& _offset)
+{
+	return (*page(_offset, true))[static_cast<size_t>(_offset & (PageSize - 1))];
+}
+
+void InterpreterMemory::read(u256 _offset, uint8_t* _data, size_t _size) const
+{
+	while (_size > 0)
+	{
+		size_t pageOffset = static_cast<size_t>(_offset & (PageSize - 1));
+		size_t chunk = min(_size, PageSize - pageOffset);
+		if (Page const* p = page(_offset))
+			memcpy(_data, p->data() + pageOffset, chunk);
+		else
+			memset(_data, 0, chunk);
+		_offset += chunk;
+		_data += chunk;
+		_size -= chunk;
+	}
+}
+
+void InterpreterMemory::write(u256 _offset, uint8_t const* _data, size_t _size)
+{
+	while (_size > 0)
+	{
+		size_t pageOffset = static_cast<size_t>(_offset & (PageSize - 1));
+		size_t chunk = min(_size, PageSize - pageOffset);
+		memcpy(page(_offset, true)->data() + pageOffset, _data, chunk);
+		_offset += chunk;
+		_data += chunk;
+		_size -= chunk;
+	}
+}
+
+InterpreterMemory::Page* InterpreterMemory::page(u256 const& _offset, bool _allocate)
+{
+	unique_ptr<Page>* slot = nullptr;
+	if (_offset < LowPageCount * PageSize)
+	{
+		size_t index = static_cast<size_t>(_offset) / PageSize;
+		if (index >= m_lowPages.size())
+		{
+			if (!_allocate)
+				return nullptr;
+			m_lowPages.resize(index + 1);
+		}
+		slot = &m_lowPages[index];
+	}
+	else if (_allocate)
+		slot = &m_highPages[_offset / PageSize];
+	else
+	{
+		auto it = m_highPages.find(_offset / PageSize);
+		if (it == m_highPages.end())
+			return nullptr;
+		slot = &it->second;
+	}
+	if (!*slot && _allocate)
+		*slot = make_unique<Page>();
+	return slot->get();
+}
+
+InterpreterMemory::Page const* InterpreterMemory::page(u256 const& _offset) const
+{
+	return const_cast<InterpreterMemory*>(this)->page(_offset, false);
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
 	for (auto const& slot: storage)
@@ -61,302 +131,630 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	memory.forEachPage([&](u256 const& _pageOffset, InterpreterMemory::Page const& _page) {
+		for (size_t offset = 0; offset < _page.size(); offset += 0x20)
+		{
+			auto word = _page.begin() + static_cast<ptrdiff_t>(offset);
+			if (any_of(word, word + 0x20, [](uint8_t _byte) { return _byte != 0; }))
+				_out <<
+					"  " << std::uppercase << std::hex << std::setw(4) << u256(_pageOffset + offset) << ": " <<
+					h256(bytesConstRef(&*word, 0x20)).hex() << endl;
+		}
+	});
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
 }
 
-void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
+namespace
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope}(_ast);
-}
 
-void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
+struct CompiledFunction;
+
+/// Expression in which all names are resolved.
+struct CompiledExpression
 {
-	evaluateMulti(_expressionStatement.expression);
-}
+	enum class Kind
+	{
+		Literal,
+		/// Argument of a builtin that is not evaluated, but only inspected by the builtin.
+		LiteralArgument,
+		Variable,
+		EVMBuiltin,
+		WasmBuiltin,
+		Function
+	};
+	Kind kind = Kind::Literal;
+	/// Value of a literal.
+	u256 value;
+	/// Slot of a variable in the frame of its function.
+	size_t slot = 0;
+	/// The call of a builtin or function.
+	FunctionCall const* call = nullptr;
+	BuiltinFunctionForEVM const* evmBuiltin = nullptr;
+	CompiledFunction const* function = nullptr;
+	std::vector<CompiledExpression> arguments;
+};
+
+struct CompiledCase;
+
+/// Statement in which all names are resolved.
+struct CompiledStatement
+{
+	enum class Kind
+	{
+		Expression,
+		Assignment,
+		VariableDeclaration,
+		If,
+		Switch,
+		ForLoop,
+		Break,
+		Continue,
+		Leave,
+		Block,
+		FunctionDefinition
+	};
+	Kind kind = Kind::Block;
+	/// Slots of the assigned or declared variables.
+	std::vector<size_t> slots;
+	/// Expression of an expression statement, an assignment or a switch, value of a
+	/// variable declaration or condition of an if statement or a for loop.
+	std::optional<CompiledExpression> expression;
+	/// Pre block of a for loop, which is not a block of its own.
+	std::vector<CompiledStatement> pre;
+	/// Body of an if statement, a for loop or of a block itself.
+	std::vector<CompiledStatement> body;
+	/// Post block of a for loop.
+	std::vector<CompiledStatement> post;
+	std::vector<CompiledCase> cases;
+};
+
+struct CompiledCase
+{
+	/// Not set for the default case.
+	std::optional<CompiledExpression> value;
+	std::vector<CompiledStatement> body;
+};
+
+struct CompiledFunction
+{
+	size_t parameterCount = 0;
+	size_t returnVariableCount = 0;
+	/// Number of slots of the frame. The parameters come first, followed by
+	/// the return variables and the other variables.
+	size_t slotCount = 0;
+	std::vector<CompiledStatement> body;
+};
 
-void Interpreter::operator()(Assignment const& _assignment)
+/**
+ * Translates the AST into compiled statements and expressions, resolving the names of
+ * variables to slots of the frame of the function they belong to and the names of called
+ * functions to the builtins or compiled functions.
+ */
+class Compiler
 {
-	solAssert(_assignment.value, "");
-	vector<u256> values = evaluateMulti(*_assignment.value);
-	solAssert(values.size() == _assignment.variableNames.size(), "");
-	for (size_t i = 0; i < values.size(); ++i)
+public:
+	explicit Compiler(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// Compiles the top-level block, which executes as the body of a function
+	/// without parameters.
+	CompiledFunction const& compileMain(Block const& _ast)
 	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
+		Scope scope{{}, {}, nullptr, true};
+		m_scope = &scope;
+		m_main.body = compileBlock(_ast);
+		m_main.slotCount = m_slotCount;
+		m_scope = nullptr;
+		return m_main;
 	}
-}
 
-void Interpreter::operator()(VariableDeclaration const& _declaration)
-{
-	vector<u256> values(_declaration.variables.size(), 0);
-	if (_declaration.value)
-		values = evaluateMulti(*_declaration.value);
+private:
+	struct Scope
+	{
+		std::map<YulString, size_t> variables;
+		std::map<YulString, CompiledFunction*> functions;
+		Scope* parent = nullptr;
+		/// If true, the variables of the parent scopes are not visible.
+		bool functionBoundary = false;
+	};
+
+	std::vector<CompiledStatement> compileBlock(Block const& _block)
+	{
+		Scope scope{{}, {}, m_scope, false};
+		m_scope = &scope;
+		std::vector<CompiledStatement> statements = compileStatements(_block);
+		m_scope = scope.parent;
+		return statements;
+	}
 
-	solAssert(values.size() == _declaration.variables.size(), "");
-	for (size_t i = 0; i < values.size(); ++i)
+	/// Compiles the statements of @a _block in the current scope.
+	std::vector<CompiledStatement> compileStatements(Block const& _block)
 	{
-		YulString varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
+		for (auto const& statement: _block.statements)
+			if (holds_alternative<FunctionDefinition>(statement))
+			{
+				FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
+				auto& function = m_functions[&funDef];
+				function = make_unique<CompiledFunction>();
+				m_scope->functions.emplace(funDef.name, function.get());
+			}
+
+		std::vector<CompiledStatement> statements;
+		statements.reserve(_block.statements.size());
+		for (auto const& statement: _block.statements)
+			statements.emplace_back(std::visit([&](auto const& _statement) { return compile(_statement); }, statement));
+		return statements;
 	}
-}
 
-void Interpreter::operator()(If const& _if)
-{
-	solAssert(_if.condition, "");
-	if (evaluate(*_if.condition) != 0)
-		(*this)(_if.body);
-}
+	CompiledStatement compile(ExpressionStatement const& _statement)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Expression;
+		result.expression = compile(_statement.expression);
+		return result;
+	}
 
-void Interpreter::operator()(Switch const& _switch)
-{
-	solAssert(_switch.expression, "");
-	u256 val = evaluate(*_switch.expression);
-	solAssert(!_switch.cases.empty(), "");
-	for (auto const& c: _switch.cases)
-		// Default case has to be last.
-		if (!c.value || evaluate(*c.value) == val)
-		{
-			(*this)(c.body);
-			break;
-		}
-}
+	CompiledStatement compile(Assignment const& _assignment)
+	{
+		solAssert(_assignment.value, "");
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Assignment;
+		for (auto const& variable: _assignment.variableNames)
+			result.slots.emplace_back(slotOf(variable.name));
+		result.expression = compile(*_assignment.value);
+		return result;
+	}
 
-void Interpreter::operator()(FunctionDefinition const&)
-{
-}
+	CompiledStatement compile(VariableDeclaration const& _declaration)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::VariableDeclaration;
+		if (_declaration.value)
+			result.expression = compile(*_declaration.value);
+		for (auto const& variable: _declaration.variables)
+			result.slots.emplace_back(declare(variable.name));
+		return result;
+	}
 
-void Interpreter::operator()(ForLoop const& _forLoop)
-{
-	solAssert(_forLoop.condition, "");
+	CompiledStatement compile(If const& _if)
+	{
+		solAssert(_if.condition, "");
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::If;
+		result.expression = compile(*_if.condition);
+		result.body = compileBlock(_if.body);
+		return result;
+	}
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
+	CompiledStatement compile(Switch const& _switch)
+	{
+		solAssert(_switch.expression, "");
+		solAssert(!_switch.cases.empty(), "");
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Switch;
+		result.expression = compile(*_switch.expression);
+		for (auto const& c: _switch.cases)
+		{
+			CompiledCase compiledCase;
+			if (c.value)
+				compiledCase.value = compile(*c.value);
+			compiledCase.body = compileBlock(c.body);
+			result.cases.emplace_back(move(compiledCase));
+		}
+		return result;
+	}
 
-	for (auto const& statement: _forLoop.pre.statements)
+	CompiledStatement compile(FunctionDefinition const& _funDef)
 	{
-		visit(statement);
-		if (m_state.controlFlowState == ControlFlowState::Leave)
-			return;
+		CompiledFunction& function = *m_functions.at(&_funDef);
+		size_t outerSlotCount = std::exchange(m_slotCount, 0);
+		Scope scope{{}, {}, m_scope, true};
+		m_scope = &scope;
+		for (auto const& parameter: _funDef.parameters)
+			declare(parameter.name);
+		for (auto const& returnVariable: _funDef.returnVariables)
+			declare(returnVariable.name);
+		function.parameterCount = _funDef.parameters.size();
+		function.returnVariableCount = _funDef.returnVariables.size();
+		function.body = compileBlock(_funDef.body);
+		function.slotCount = m_slotCount;
+		m_scope = scope.parent;
+		m_slotCount = outerSlotCount;
+
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::FunctionDefinition;
+		return result;
 	}
-	while (evaluate(*_forLoop.condition) != 0)
+
+	CompiledStatement compile(ForLoop const& _forLoop)
 	{
-		// Increment step for each loop iteration for loops with
-		// an empty body and post blocks to prevent a deadlock.
-		if (_forLoop.body.statements.size() == 0 && _forLoop.post.statements.size() == 0)
-			incrementStep();
+		solAssert(_forLoop.condition, "");
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::ForLoop;
+		Scope scope{{}, {}, m_scope, false};
+		m_scope = &scope;
+		result.pre = compileStatements(_forLoop.pre);
+		result.expression = compile(*_forLoop.condition);
+		result.body = compileBlock(_forLoop.body);
+		result.post = compileBlock(_forLoop.post);
+		m_scope = scope.parent;
+		return result;
+	}
 
-		m_state.controlFlowState = ControlFlowState::Default;
-		(*this)(_forLoop.body);
-		if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
-			break;
+	CompiledStatement compile(Break const&)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Break;
+		return result;
+	}
 
-		m_state.controlFlowState = ControlFlowState::Default;
-		(*this)(_forLoop.post);
-		if (m_state.controlFlowState == ControlFlowState::Leave)
-			break;
+	CompiledStatement compile(Continue const&)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Continue;
+		return result;
 	}
-	if (m_state.controlFlowState != ControlFlowState::Leave)
-		m_state.controlFlowState = ControlFlowState::Default;
-}
 
-void Interpreter::operator()(Break const&)
-{
-	m_state.controlFlowState = ControlFlowState::Break;
-}
+	CompiledStatement compile(Leave const&)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Leave;
+		return result;
+	}
 
-void Interpreter::operator()(Continue const&)
-{
-	m_state.controlFlowState = ControlFlowState::Continue;
-}
+	CompiledStatement compile(Block const& _block)
+	{
+		CompiledStatement result;
+		result.kind = CompiledStatement::Kind::Block;
+		result.body = compileBlock(_block);
+		return result;
+	}
 
-void Interpreter::operator()(Leave const&)
-{
-	m_state.controlFlowState = ControlFlowState::Leave;
-}
+	CompiledExpression compile(Expression const& _expression)
+	{
+		return std::visit(GenericVisitor{
+			[&](Literal const& _literal) { return compile(_literal); },
+			[&](Identifier const& _identifier) {
+				CompiledExpression result;
+				result.kind = CompiledExpression::Kind::Variable;
+				result.slot = slotOf(_identifier.name);
+				return result;
+			},
+			[&](FunctionCall const& _funCall) { return compile(_funCall); }
+		}, _expression);
+	}
 
-void Interpreter::operator()(Block const& _block)
-{
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
+	CompiledExpression compile(Literal const& _literal)
+	{
+		CompiledExpression result;
+		result.kind = CompiledExpression::Kind::Literal;
+		result.value = valueOfLiteral(_literal);
+		return result;
+	}
+
+	CompiledExpression compile(FunctionCall const& _funCall)
+	{
+		CompiledExpression result;
+		result.call = &_funCall;
+
+		vector<optional<LiteralKind>> const* literalArguments = nullptr;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
+			if (!builtin->literalArguments.empty())
+				literalArguments = &builtin->literalArguments;
+		for (size_t i = 0; i < _funCall.arguments.size(); ++i)
+			if (!literalArguments || !literalArguments->at(i))
+				result.arguments.emplace_back(compile(_funCall.arguments[i]));
+			else
+			{
+				CompiledExpression argument;
+				argument.kind = CompiledExpression::Kind::LiteralArgument;
+				result.arguments.emplace_back(move(argument));
+			}
+
+		if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
 		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
+			if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
+			{
+				result.kind = CompiledExpression::Kind::EVMBuiltin;
+				result.evmBuiltin = fun;
+				return result;
+			}
 		}
+		else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
+			if (dialect->builtin(_funCall.functionName.name))
+			{
+				result.kind = CompiledExpression::Kind::WasmBuiltin;
+				return result;
+			}
+
+		CompiledFunction const* function = nullptr;
+		for (Scope const* scope = m_scope; scope && !function; scope = scope->parent)
+			if (auto it = scope->functions.find(_funCall.functionName.name); it != scope->functions.end())
+				function = it->second;
+		yulAssert(function, "Function not found.");
+		result.kind = CompiledExpression::Kind::Function;
+		result.function = function;
+		return result;
+	}
 
-	for (auto const& statement: _block.statements)
+	size_t declare(YulString _name)
 	{
-		incrementStep();
-		visit(statement);
-		if (m_state.controlFlowState != ControlFlowState::Default)
-			break;
+		bool inserted = m_scope->variables.emplace(_name, m_slotCount).second;
+		solAssert(inserted, "");
+		return m_slotCount++;
 	}
 
-	leaveScope();
-}
-
-u256 Interpreter::evaluate(Expression const& _expression)
-{
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
-	ev.visit(_expression);
-	return ev.value();
-}
+	size_t slotOf(YulString _name) const
+	{
+		for (Scope const* scope = m_scope; scope; scope = scope->parent)
+		{
+			if (auto it = scope->variables.find(_name); it != scope->variables.end())
+				return it->second;
+			if (scope->functionBoundary)
+				break;
+		}
+		solAssert(false, "Variable not found.");
+		return 0;
+	}
 
-vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
-{
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
-	ev.visit(_expression);
-	return ev.values();
-}
+	Dialect const& m_dialect;
+	Scope* m_scope = nullptr;
+	/// Number of slots allocated in the function that is compiled.
+	size_t m_slotCount = 0;
+	CompiledFunction m_main;
+	std::map<FunctionDefinition const*, std::unique_ptr<CompiledFunction>> m_functions;
+};
 
-void Interpreter::enterScope(Block const& _block)
+/**
+ * Executes compiled code. The variables of all active function calls are kept in a single
+ * stack of values, in which every call has a frame.
+ */
+class Executor
 {
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
-}
+public:
+	explicit Executor(InterpreterState& _state): m_state(_state) {}
 
-void Interpreter::leaveScope()
-{
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
-}
+	void run(CompiledFunction const& _main)
+	{
+		m_stack.assign(_main.slotCount, 0);
+		m_frameBase = 0;
+		execute(_main.body);
+	}
 
-void Interpreter::incrementStep()
-{
-	m_state.numSteps++;
-	if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+private:
+	void execute(std::vector<CompiledStatement> const& _block)
 	{
-		m_state.trace.emplace_back("Interpreter execution step limit reached.");
-		BOOST_THROW_EXCEPTION(StepLimitReached());
+		for (auto const& statement: _block)
+		{
+			incrementStep();
+			execute(statement);
+			if (m_state.controlFlowState != ControlFlowState::Default)
+				break;
+		}
 	}
-}
 
-void ExpressionEvaluator::operator()(Literal const& _literal)
-{
-	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
+	void execute(CompiledStatement const& _statement)
+	{
+		using Kind = CompiledStatement::Kind;
+		switch (_statement.kind)
+		{
+		case Kind::Expression:
+		{
+			size_t nestingLevel = 0;
+			if (_statement.expression->kind == CompiledExpression::Kind::Function)
+				m_stack.resize(call(*_statement.expression, nestingLevel));
+			else
+				evaluate(*_statement.expression, nestingLevel);
+			break;
+		}
+		case Kind::Assignment:
+		case Kind::VariableDeclaration:
+			if (_statement.expression)
+				assign(_statement.slots, *_statement.expression);
+			else
+				for (size_t slot: _statement.slots)
+					m_stack[m_frameBase + slot] = 0;
+			break;
+		case Kind::If:
+			if (evaluate(*_statement.expression) != 0)
+				execute(_statement.body);
+			break;
+		case Kind::Switch:
+		{
+			u256 value = evaluate(*_statement.expression);
+			for (auto const& c: _statement.cases)
+				// Default case has to be last.
+				if (!c.value || evaluate(*c.value) == value)
+				{
+					execute(c.body);
+					break;
+				}
+			break;
+		}
+		case Kind::ForLoop:
+			executeForLoop(_statement);
+			break;
+		case Kind::Break:
+			m_state.controlFlowState = ControlFlowState::Break;
+			break;
+		case Kind::Continue:
+			m_state.controlFlowState = ControlFlowState::Continue;
+			break;
+		case Kind::Leave:
+			m_state.controlFlowState = ControlFlowState::Leave;
+			break;
+		case Kind::Block:
+			execute(_statement.body);
+			break;
+		case Kind::FunctionDefinition:
+			break;
+		}
+	}
 
-	setValue(valueOfLiteral(_literal));
-}
+	void executeForLoop(CompiledStatement const& _forLoop)
+	{
+		for (auto const& statement: _forLoop.pre)
+		{
+			execute(statement);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				return;
+		}
+		while (evaluate(*_forLoop.expression) != 0)
+		{
+			// Increment step for each loop iteration for loops with
+			// an empty body and post blocks to prevent a deadlock.
+			if (_forLoop.body.empty() && _forLoop.post.empty())
+				incrementStep();
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(_forLoop.body);
+			if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(_forLoop.post);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+		}
+		if (m_state.controlFlowState != ControlFlowState::Leave)
+			m_state.controlFlowState = ControlFlowState::Default;
+	}
 
-void ExpressionEvaluator::operator()(Identifier const& _identifier)
-{
-	solAssert(m_variables.count(_identifier.name), "");
-	incrementStep();
-	setValue(m_variables.at(_identifier.name));
-}
+	/// Evaluates @a _expression and stores its values in the variables at @a _slots.
+	void assign(std::vector<size_t> const& _slots, CompiledExpression const& _expression)
+	{
+		size_t nestingLevel = 0;
+		if (_expression.kind == CompiledExpression::Kind::Function)
+		{
+			size_t frame = call(_expression, nestingLevel);
+			solAssert(_expression.function->returnVariableCount == _slots.size(), "");
+			size_t results = frame + _expression.function->parameterCount;
+			for (size_t i = 0; i < _slots.size(); ++i)
+				m_stack[m_frameBase + _slots[i]] = m_stack[results + i];
+			m_stack.resize(frame);
+		}
+		else
+		{
+			solAssert(_slots.size() == 1, "");
+			u256 value = evaluate(_expression, nestingLevel);
+			m_stack[m_frameBase + _slots.front()] = value;
+		}
+	}
 
-void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
-{
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
+	/// Evaluates an expression on its own and @returns its only value.
+	u256 evaluate(CompiledExpression const& _expression)
+	{
+		size_t nestingLevel = 0;
+		return evaluate(_expression, nestingLevel);
+	}
 
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	/// Evaluates a part of an expression and @returns its only value. @a _nestingLevel is
+	/// increased for every literal, variable and call of the whole expression.
+	u256 evaluate(CompiledExpression const& _expression, size_t& _nestingLevel)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
+		using Kind = CompiledExpression::Kind;
+		switch (_expression.kind)
 		{
-			EVMInstructionInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
-			return;
+		case Kind::Literal:
+			incrementNestingLevel(_nestingLevel);
+			return _expression.value;
+		case Kind::LiteralArgument:
+			return 0;
+		case Kind::Variable:
+			incrementNestingLevel(_nestingLevel);
+			return m_stack[m_frameBase + _expression.slot];
+		case Kind::EVMBuiltin:
+		case Kind::WasmBuiltin:
+		{
+			incrementNestingLevel(_nestingLevel);
+			vector<u256> arguments(_expression.arguments.size());
+			/// Function arguments are evaluated in reverse.
+			for (size_t i = arguments.size(); i > 0; --i)
+				arguments[i - 1] = evaluate(_expression.arguments[i - 1], _nestingLevel);
+			if (_expression.kind == Kind::EVMBuiltin)
+				return EVMInstructionInterpreter(m_state).evalBuiltin(
+					*_expression.evmBuiltin,
+					_expression.call->arguments,
+					arguments
+				);
+			else
+				return EwasmBuiltinInterpreter(m_state).evalBuiltin(
+					_expression.call->functionName.name,
+					_expression.call->arguments,
+					arguments
+				);
 		}
-	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
+		case Kind::Function:
 		{
-			EwasmBuiltinInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
-			return;
+			solAssert(_expression.function->returnVariableCount == 1, "");
+			size_t frame = call(_expression, _nestingLevel);
+			u256 value = m_stack[frame + _expression.function->parameterCount];
+			m_stack.resize(frame);
+			return value;
+		}
 		}
+		solAssert(false, "");
+		return 0;
+	}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
-
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
-	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
-
-	m_state.controlFlowState = ControlFlowState::Default;
-	Interpreter interpreter(m_state, m_dialect, *scope, std::move(variables));
-	interpreter(fun->body);
-	m_state.controlFlowState = ControlFlowState::Default;
-
-	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
-}
+	/// Calls the function of @a _call and @returns the start of its frame, which is left on
+	/// the stack so that the caller can read the return values from it.
+	size_t call(CompiledExpression const& _call, size_t& _nestingLevel)
+	{
+		CompiledFunction const& function = *_call.function;
+		yulAssert(_call.arguments.size() == function.parameterCount, "");
+		incrementNestingLevel(_nestingLevel);
+
+		size_t frame = m_stack.size();
+		m_stack.resize(frame + function.slotCount);
+		/// Function arguments are evaluated in reverse.
+		for (size_t i = function.parameterCount; i > 0; --i)
+		{
+			u256 value = evaluate(_call.arguments[i - 1], _nestingLevel);
+			m_stack[frame + i - 1] = value;
+		}
 
-u256 ExpressionEvaluator::value() const
-{
-	solAssert(m_values.size() == 1, "");
-	return m_values.front();
-}
+		size_t callerFrame = std::exchange(m_frameBase, frame);
+		m_state.controlFlowState = ControlFlowState::Default;
+		execute(function.body);
+		m_state.controlFlowState = ControlFlowState::Default;
+		m_frameBase = callerFrame;
+		return frame;
+	}
 
-void ExpressionEvaluator::setValue(u256 _value)
-{
-	m_values.clear();
-	m_values.emplace_back(std::move(_value));
-}
+	/// Increment interpreter step count, throwing exception if step limit
+	/// is reached.
+	void incrementStep()
+	{
+		m_state.numSteps++;
+		if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+		{
+			m_state.trace.emplace_back("Interpreter execution step limit reached.");
+			BOOST_THROW_EXCEPTION(StepLimitReached());
+		}
+	}
 
-void ExpressionEvaluator::evaluateArgs(
-	vector<Expression> const& _expr,
-	vector<optional<LiteralKind>> const* _literalArguments
-)
-{
-	incrementStep();
-	vector<u256> values;
-	size_t i = 0;
-	/// Function arguments are evaluated in reverse.
-	for (auto const& expr: _expr | ranges::views::reverse)
-	{
-		if (!_literalArguments || !_literalArguments->at(_expr.size() - i - 1))
-			visit(expr);
-		else
-			m_values = {0};
-		values.push_back(value());
-		++i;
+	void incrementNestingLevel(size_t& _nestingLevel)
+	{
+		_nestingLevel++;
+		if (m_state.maxExprNesting > 0 && _nestingLevel > m_state.maxExprNesting)
+		{
+			m_state.trace.emplace_back("Maximum expression nesting level reached.");
+			BOOST_THROW_EXCEPTION(ExpressionNestingLimitReached());
+		}
 	}
-	m_values = std::move(values);
-	std::reverse(m_values.begin(), m_values.end());
+
+	InterpreterState& m_state;
+	/// Values of the variables of all active function calls.
+	std::vector<u256> m_stack;
+	/// Start of the frame of the current function call in @a m_stack.
+	size_t m_frameBase = 0;
+};
+
 }
 
-void ExpressionEvaluator::incrementStep()
+void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
 {
-	m_nestingLevel++;
-	if (m_state.maxExprNesting > 0 && m_nestingLevel > m_state.maxExprNesting)
-	{
-		m_state.trace.emplace_back("Maximum expression nesting level reached.");
-		BOOST_THROW_EXCEPTION(ExpressionNestingLimitReached());
-	}
+	Compiler compiler(_dialect);
+	Executor{_state}.run(compiler.compileMain(_ast));
 }
@@ -22,14 +22,16 @@
 #pragma once
 
 #include <libyul/ASTForward.h>
-#include <libyul/optimiser/ASTWalker.h>
 
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/CommonData.h>
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -67,11 +69,53 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressed memory of the interpreter, where bytes that were never written are zero.
+ * It consists of pages that are allocated when they are first accessed for writing.
+ * The pages at low offsets are found through a table, all others through a map.
+ */
+class InterpreterMemory
+{
+public:
+	static constexpr size_t PageSize = 0x1000;
+	using Page = std::array<uint8_t, PageSize>;
+
+	/// @returns a reference to the byte at @a _offset, allocating its page if needed.
+	uint8_t& operator[](u256 const& _offset);
+	/// Copies @a _size bytes starting at @a _offset to @a _data. The offsets wrap around at 2**256.
+	void read(u256 _offset, uint8_t* _data, size_t _size) const;
+	/// Copies @a _size bytes from @a _data to the memory starting at @a _offset.
+	/// The offsets wrap around at 2**256.
+	void write(u256 _offset, uint8_t const* _data, size_t _size);
+
+	/// Calls @a _visitor with the offset and the contents of every allocated page,
+	/// in the order of the offsets.
+	template <typename Visitor>
+	void forEachPage(Visitor&& _visitor) const
+	{
+		for (size_t index = 0; index < m_lowPages.size(); ++index)
+			if (m_lowPages[index])
+				_visitor(u256(index * PageSize), *m_lowPages[index]);
+		for (auto const& [index, page]: m_highPages)
+			_visitor(index * PageSize, *page);
+	}
+
+private:
+	/// Number of pages at the lowest offsets that are found through the table.
+	static constexpr size_t LowPageCount = 0x1000;
+
+	Page* page(u256 const& _offset, bool _allocate);
+	Page const* page(u256 const& _offset) const;
+
+	std::vector<std::unique_ptr<Page>> m_lowPages;
+	std::map<u256, std::unique_ptr<Page>> m_highPages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	InterpreterMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
@@ -105,126 +149,17 @@ struct InterpreterState
 	void dumpStorage(std::ostream& _out) const;
 };
 
-/**
- * Scope structure built and maintained during execution.
- */
-struct Scope
-{
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
-};
-
 /**
  * Yul interpreter.
+ *
+ * Before execution, the code is translated into a form in which every variable is resolved
+ * to a slot in the frame of its function and every function call to the called builtin or
+ * function, so that no names have to be looked up while it is executed.
  */
-class Interpreter: public ASTWalker
+class Interpreter
 {
 public:
 	static void run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast);
-
-	Interpreter(
-		InterpreterState& _state,
-		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> _variables = {}
-	):
-		m_dialect(_dialect),
-		m_state(_state),
-		m_variables(std::move(_variables)),
-		m_scope(&_scope)
-	{
-	}
-
-	void operator()(ExpressionStatement const& _statement) override;
-	void operator()(Assignment const& _assignment) override;
-	void operator()(VariableDeclaration const& _varDecl) override;
-	void operator()(If const& _if) override;
-	void operator()(Switch const& _switch) override;
-	void operator()(FunctionDefinition const&) override;
-	void operator()(ForLoop const&) override;
-	void operator()(Break const&) override;
-	void operator()(Continue const&) override;
-	void operator()(Leave const&) override;
-	void operator()(Block const& _block) override;
-
-	std::vector<std::string> const& trace() const { return m_state.trace; }
-
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
-
-private:
-	/// Asserts that the expression evaluates to exactly one value and returns it.
-	u256 evaluate(Expression const& _expression);
-	/// Evaluates the expression and returns its value.
-	std::vector<u256> evaluateMulti(Expression const& _expression);
-
-	void enterScope(Block const& _block);
-	void leaveScope();
-
-	/// Increment interpreter step count, throwing exception if step limit
-	/// is reached.
-	void incrementStep();
-
-	Dialect const& m_dialect;
-	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
-};
-
-/**
- * Yul expression evaluator.
- */
-class ExpressionEvaluator: public ASTWalker
-{
-public:
-	ExpressionEvaluator(
-		InterpreterState& _state,
-		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables
-	):
-		m_state(_state),
-		m_dialect(_dialect),
-		m_variables(_variables),
-		m_scope(_scope)
-	{}
-
-	void operator()(Literal const&) override;
-	void operator()(Identifier const&) override;
-	void operator()(FunctionCall const& _funCall) override;
-
-	/// Asserts that the expression has exactly one value and returns it.
-	u256 value() const;
-	/// Returns the list of values of the expression.
-	std::vector<u256> values() const { return m_values; }
-
-private:
-	void setValue(u256 _value);
-
-	/// Evaluates the given expression from right to left and
-	/// stores it in m_value.
-	void evaluateArgs(
-		std::vector<Expression> const& _expr,
-		std::vector<std::optional<LiteralKind>> const* _literalArguments
-	);
-
-	/// Increment evaluation count, throwing exception if the
-	/// nesting level is beyond the upper bound configured in
-	/// the interpreter state.
-	void incrementStep();
-
-	InterpreterState& m_state;
-	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
-	/// Current value of the expression
-	std::vector<u256> m_values;
-	/// Current expression nesting level
-	unsigned m_nestingLevel = 0;
 };
 
 }
-
@@ -27,12 +27,15 @@
 #include <libyul/AsmAnalysisInfo.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libyul/AST.h>
+#include <libyul/AssemblyStack.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/Object.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -40,8 +43,10 @@
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -59,10 +64,15 @@
 #include <range/v3/view/transform.hpp>
 
 #include <cctype>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <map>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <variant>
+#include <vector>
 
 using namespace std;
 using namespace solidity;
@@ -203,7 +213,15 @@ public:
 			if (abbreviationAndName != abbreviationMap.end())
 			{
 				OptimiserStep const& step = *OptimiserSuite::allSteps().at(abbreviationAndName->second);
+				size_t const sizeBefore = CodeSize::codeSizeIncludingFunctions(*m_ast);
+				size_t const costBefore = CodeCost::codeCost(m_dialect, *m_ast);
+				auto const start = chrono::steady_clock::now();
 				step.run(context, *m_ast);
+				double const milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+				cout <<
+					step.name << ": size " << sizeBefore << " -> " << CodeSize::codeSizeIncludingFunctions(*m_ast) <<
+					", cost " << costBefore << " -> " << CodeCost::codeCost(m_dialect, *m_ast) <<
+					", " << fixed << setprecision(3) << milliseconds << defaultfloat << " ms" << endl;
 			}
 			else switch (option)
 			{
@@ -228,7 +246,196 @@ public:
 		}
 	}
 
+	/// @returns an assembly stack that applies the optimizer with the step sequence @a _steps
+	/// and has parsed and analyzed @a _source, or nullptr after printing the errors.
+	static unique_ptr<AssemblyStack> parseWithSequence(string const& _source, string const& _steps)
+	{
+		try
+		{
+			OptimiserSuite::validateSequence(_steps);
+		}
+		catch (OptimizerException const& _exception)
+		{
+			cerr << "Invalid optimizer step sequence: " << _exception.what() << endl;
+			return nullptr;
+		}
+
+		frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+		settings.yulOptimiserSteps = _steps;
+		auto stack = make_unique<AssemblyStack>(EVMVersion{}, AssemblyStack::Language::StrictAssembly, settings);
+		if (!stack->parseAndAnalyze("", _source))
+		{
+			SourceReferenceFormatter formatter(cerr, true, false);
+			for (auto const& error: stack->errors())
+				formatter.printErrorInformation(*error);
+			return nullptr;
+		}
+		return stack;
+	}
+
+	/// Applies the optimizer with the step sequence @a _steps to every object of @a _source
+	/// and prints the size and cost of the code after every step.
+	static bool runSequence(string const& _source, string const& _steps)
+	{
+		unique_ptr<AssemblyStack> stack = parseWithSequence(_source, _steps);
+		if (!stack)
+			return false;
+
+		Profiler profiler;
+		{
+			Profiler::Scope scope(&profiler, "");
+			stack->optimize();
+		}
+
+		vector<Profiler::Transformation> const transformations = profiler.transformations()[""];
+		vector<string> objects;
+		for (auto const& transformation: transformations)
+			if (find(objects.begin(), objects.end(), transformation.object) == objects.end())
+				objects.push_back(transformation.object);
+		for (string const& object: objects)
+		{
+			cout << endl << "Object " << object << ":" << endl;
+			cout << setw(12) << "wall (ms)" << setw(10) << "size" << setw(10) << "cost" << "  step" << endl;
+			bool first = true;
+			for (auto const& transformation: transformations)
+			{
+				if (transformation.object != object)
+					continue;
+				if (first)
+					cout << setw(12) << "" << setw(10) << transformation.codeSizeBefore <<
+						setw(10) << transformation.codeCostBefore << "  (initial)" << endl;
+				first = false;
+				cout << setw(12) << fixed << setprecision(3) << transformation.wallTimeSeconds * 1000 <<
+					setw(10) << transformation.codeSizeAfter << setw(10) << transformation.codeCostAfter <<
+					"  " << transformation.name << endl;
+			}
+		}
+		return true;
+	}
+
+	/// Applies the optimizer with each of the step sequences @a _sequences to @a _source
+	/// @a _repetitions times and prints the mean time spent in every step, summed over all objects,
+	/// as well as the size and the estimated gas costs of the result side by side.
+	static bool benchmark(string const& _source, vector<string> const& _sequences, size_t _repetitions)
+	{
+		yulAssert(_repetitions > 0, "");
+
+		struct Result
+		{
+			/// Names of the steps in the order in which they were applied first.
+			vector<string> steps;
+			/// Wall time by step name, summed over all objects and repetitions.
+			map<string, double> stepSeconds;
+			double totalSeconds = 0;
+			double fastestSeconds = numeric_limits<double>::max();
+			size_t codeSize = 0;
+			size_t codeCost = 0;
+			bigint gas = 0;
+			size_t bytecodeSize = 0;
+		};
+		vector<Result> results;
+		for (string const& sequence: _sequences)
+		{
+			Result& result = results.emplace_back();
+			for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+			{
+				unique_ptr<AssemblyStack> stack = parseWithSequence(_source, sequence);
+				if (!stack)
+					return false;
+
+				Profiler profiler;
+				{
+					Profiler::Scope scope(&profiler, "");
+					stack->optimize();
+				}
+				double seconds = 0;
+				for (auto const& transformation: profiler.transformations()[""])
+				{
+					if (!result.stepSeconds.count(transformation.name))
+						result.steps.emplace_back(transformation.name);
+					result.stepSeconds[transformation.name] += transformation.wallTimeSeconds;
+					seconds += transformation.wallTimeSeconds;
+				}
+				result.totalSeconds += seconds;
+				result.fastestSeconds = min(result.fastestSeconds, seconds);
+
+				if (repetition + 1 == _repetitions)
+				{
+					addMetrics(result.codeSize, result.codeCost, result.gas, *stack->parserResult());
+					result.bytecodeSize = stack->assemble(AssemblyStack::Machine::EVM).bytecode->bytecode.size();
+				}
+			}
+		}
+
+		vector<string> steps;
+		for (Result const& result: results)
+			for (string const& step: result.steps)
+				if (find(steps.begin(), steps.end(), step) == steps.end())
+					steps.emplace_back(step);
+
+		for (size_t i = 0; i < _sequences.size(); ++i)
+			cout << "Sequence " << i + 1 << ": " << _sequences[i] << endl;
+		cout << endl << "Mean wall time per run in ms over " << _repetitions << " runs:" << endl;
+		cout << setw(36) << left << "step" << right;
+		for (size_t i = 0; i < results.size(); ++i)
+			cout << setw(14) << ("sequence " + to_string(i + 1));
+		cout << endl;
+		auto milliseconds = [&](double _seconds) { return _seconds * 1000 / static_cast<double>(_repetitions); };
+		cout << fixed << setprecision(3);
+		for (string const& step: steps)
+		{
+			cout << setw(36) << left << step << right;
+			for (Result const& result: results)
+				if (result.stepSeconds.count(step))
+					cout << setw(14) << milliseconds(result.stepSeconds.at(step));
+				else
+					cout << setw(14) << "-";
+			cout << endl;
+		}
+		auto printRow = [&](string const& _name, auto _value) {
+			cout << setw(36) << left << _name << right;
+			for (Result const& result: results)
+				cout << setw(14) << _value(result);
+			cout << endl;
+		};
+		printRow("total", [&](Result const& _result) { return milliseconds(_result.totalSeconds); });
+		printRow("total (fastest run)", [&](Result const& _result) { return _result.fastestSeconds * 1000; });
+		cout << defaultfloat << endl << "Result:" << endl;
+		printRow("code size", [](Result const& _result) { return _result.codeSize; });
+		printRow("code cost", [](Result const& _result) { return _result.codeCost; });
+		printRow("gas (GasMeter)", [](Result const& _result) { return _result.gas.str(); });
+		printRow("bytecode size", [](Result const& _result) { return _result.bytecodeSize; });
+		return true;
+	}
+
 private:
+	/// Adds the code size, code cost and the costs estimated by GasMeter of the code of
+	/// @a _object and all its sub-objects.
+	static void addMetrics(size_t& _codeSize, size_t& _codeCost, bigint& _gas, Object const& _object)
+	{
+		struct GasCollector: ASTWalker
+		{
+			explicit GasCollector(GasMeter const& _meter): meter(_meter) {}
+			using ASTWalker::operator();
+			// Does not visit sub-expressions, whose costs are included in the costs of the expression.
+			void visit(Expression const& _expression) override { gas += meter.costs(_expression); }
+
+			GasMeter const& meter;
+			bigint gas = 0;
+		};
+
+		EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+		GasMeter meter{dialect, false, frontend::OptimiserSettings::full().expectedExecutionsPerDeployment};
+		GasCollector collector{meter};
+		collector(*_object.code);
+		_codeSize += CodeSize::codeSizeIncludingFunctions(*_object.code);
+		_codeCost += CodeCost::codeCost(dialect, *_object.code);
+		_gas += collector.gas;
+		for (auto const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+				addMetrics(_codeSize, _codeCost, _gas, *subObject);
+	}
+
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
 	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
@@ -243,6 +450,13 @@ int main(int argc, char** argv)
 Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
 interactively read from stdin.
+With --yul-optimizations, instead applies the optimizer with the given
+step sequence to every object of <file> and prints the size and cost
+of the code after every step.
+With --repeat or several --yul-optimizations, applies the optimizer with
+each sequence the given number of times and prints the mean time spent
+in every step as well as the size and gas costs of the result, with one
+column per sequence.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -253,6 +467,17 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"yul-optimizations",
+			po::value<vector<string>>(),
+			"Step sequence to apply non-interactively, using the syntax of solc --yul-optimizations. "
+			"Can be given several times to compare the sequences."
+		)
+		(
+			"repeat",
+			po::value<size_t>(),
+			"Number of times to apply each step sequence when benchmarking."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -283,7 +508,22 @@ Allowed options)",
 		return 1;
 	}
 
-	if (arguments.count("input-file"))
+	if (arguments.count("input-file") && arguments.count("yul-optimizations"))
+	{
+		auto const& sequences = arguments["yul-optimizations"].as<vector<string>>();
+		if (arguments.count("repeat") || sequences.size() > 1)
+		{
+			size_t repetitions = arguments.count("repeat") ? arguments["repeat"].as<size_t>() : 1;
+			if (repetitions == 0)
+			{
+				cerr << "--repeat has to be positive." << endl;
+				return 1;
+			}
+			return YulOpti::benchmark(input, sequences, repetitions) ? 0 : 1;
+		}
+		return YulOpti::runSequence(input, sequences.front()) ? 0 : 1;
+	}
+	else if (arguments.count("input-file"))
 		YulOpti{}.runInteractive(input);
 	else
 		cout << options;
@@ -26,6 +26,7 @@
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
 
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/EVMVersion.h>
@@ -24,6 +24,7 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -154,6 +155,21 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_availabl
 	BOOST_TEST(m_programCache->size() == m_chromosome.length());
 }
 
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_when_evaluating_in_parallel_with_shared_cache, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes;
+	for (size_t i = 0; i < 50; ++i)
+		chromosomes.push_back(Chromosome::makeRandom(i % 10));
+
+	vector<size_t> expectedFitness = ProgramSize(m_program, nullptr, m_weights).evaluateAll(chromosomes);
+
+	ProgramSize parallelMetric(nullopt, m_programCache, m_weights);
+	parallelMetric.setThreadPool(make_shared<ThreadPool>(4));
+
+	BOOST_TEST(parallelMetric.evaluateAll(chromosomes) == expectedFitness);
+	BOOST_TEST(m_programCache->gatherStats().hits > 0);
+}
+
 BOOST_FIXTURE_TEST_CASE(evaluate_should_repeat_the_optimisation_specified_number_of_times, ProgramBasedMetricFixture)
 {
 	Program const& programOptimisedOnce = m_optimisedProgram;
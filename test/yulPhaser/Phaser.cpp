@@ -89,6 +89,7 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* threads = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -277,6 +278,20 @@ BOOST_FIXTURE_TEST_CASE(build_should_pass_program_caches_to_metrics, FitnessMetr
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_create_thread_pool_only_if_more_than_one_thread_requested, FitnessMetricFactoryFixture)
+{
+	m_options.threads = 1;
+	unique_ptr<FitnessMetric> sequentialMetric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(sequentialMetric != nullptr);
+	BOOST_TEST(sequentialMetric->threadPool() == nullptr);
+
+	m_options.threads = 3;
+	unique_ptr<FitnessMetric> parallelMetric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(parallelMetric != nullptr);
+	BOOST_REQUIRE(parallelMetric->threadPool() != nullptr);
+	BOOST_TEST(parallelMetric->threadPool()->size() == 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(PopulationFactoryTest)
 
@@ -387,7 +402,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 0};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -399,9 +414,22 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_size_limit_to_caches, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 100};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+
+	BOOST_TEST(caches.size() == m_programs.size());
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		BOOST_REQUIRE(caches[i] != nullptr);
+		BOOST_TEST(caches[i]->maxTotalCodeSize() == 100);
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* maxTotalCodeSize = */ 0};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
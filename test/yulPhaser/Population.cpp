@@ -31,6 +31,8 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <cmath>
@@ -40,6 +42,7 @@
 
 using namespace std;
 using namespace solidity::langutil;
+using namespace solidity::util;
 using namespace solidity::yul;
 using namespace boost::unit_test::framework;
 
@@ -210,6 +213,27 @@ BOOST_FIXTURE_TEST_CASE(makeRandom_should_compute_fitness, PopulationFixture)
 	BOOST_TEST(population.individuals()[2].fitness == m_fitnessMetric->evaluate(population.individuals()[2].chromosome));
 }
 
+BOOST_FIXTURE_TEST_CASE(mutate_should_give_the_same_result_when_evaluating_fitness_in_parallel, PopulationFixture)
+{
+	shared_ptr<FitnessMetric> parallelMetric = make_shared<ChromosomeLengthMetric>();
+	parallelMetric->setThreadPool(make_shared<ThreadPool>(3));
+
+	vector<Chromosome> chromosomes;
+	for (size_t i = 0; i < 20; ++i)
+		chromosomes.push_back(Chromosome::makeRandom(i));
+	Population sequentialPopulation(m_fitnessMetric, chromosomes);
+	Population parallelPopulation(parallelMetric, chromosomes);
+	BOOST_TEST(sequentialPopulation.individuals() == parallelPopulation.individuals());
+
+	RangeSelection selection(0.0, 1.0);
+	SimulationRNG::reset(1);
+	Population sequentialMutated = sequentialPopulation.mutate(selection, geneRandomisation(0.5));
+	SimulationRNG::reset(1);
+	Population parallelMutated = parallelPopulation.mutate(selection, geneRandomisation(0.5));
+
+	BOOST_TEST(sequentialMutated.individuals() == parallelMutated.individuals());
+}
+
 BOOST_FIXTURE_TEST_CASE(plus_operator_should_add_two_populations, PopulationFixture)
 {
 	BOOST_CHECK_EQUAL(
@@ -59,9 +59,9 @@ protected:
 
 	static set<string> cachedKeys(ProgramCache const& _programCache)
 	{
-		 set<string> keys;
-		for (auto pair = _programCache.entries().begin(); pair != _programCache.entries().end(); ++pair)
-			keys.insert(pair->first);
+		set<string> keys;
+		for (auto const& pair: _programCache.entries())
+			keys.insert(pair.first);
 
 		return keys;
 	}
@@ -252,6 +252,62 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_when_size_limit_is_exceeded, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	size_t sizeLT = optimisedProgram(m_program, "LT").codeSize(CacheStats::StorageWeights);
+	size_t sizef = optimisedProgram(m_program, "f").codeSize(CacheStats::StorageWeights);
+	assert(sizef <= sizeIu && sizef <= sizeLT && "The new entry must not require evicting more than one old entry");
+
+	ProgramCache cache(m_program, sizeI + sizeIu + sizeL + sizeLT);
+
+	cache.optimiseProgram("Iu");
+	cache.optimiseProgram("LT");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu", "L", "LT"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI + sizeIu + sizeL + sizeLT);
+
+	// Looking the sequence up makes it more recently used than "LT".
+	cache.optimiseProgram("Iu");
+	cache.optimiseProgram("f");
+
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "Iu", "L", "f"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI + sizeIu + sizeL + sizef);
+	BOOST_TEST(cache.gatherStats().totalCodeSize <= cache.maxTotalCodeSize());
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_evict_prefixes_of_cached_entries, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	assert(sizeL <= sizeIu);
+
+	ProgramCache cache(m_program, sizeI + sizeIu);
+
+	cache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu"}));
+
+	// "I" was used before "Iu" but cannot be evicted while "Iu" is still there.
+	cache.optimiseProgram("L");
+
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "L"}));
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_cache_programs_larger_than_the_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	assert(sizeI > 1);
+
+	ProgramCache cache(m_program, sizeI - 1);
+	Program cachedProgram = cache.optimiseProgram("Iu");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "Iu")));
+	BOOST_TEST(cache.size() == 0);
+	BOOST_TEST(cache.gatherStats().misses == 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
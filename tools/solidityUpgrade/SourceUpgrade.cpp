@@ -26,6 +26,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 #ifdef _WIN32 // windows
 	#include <io.h>
 	#define isatty _isatty
@@ -278,9 +280,7 @@ void SourceUpgrade::tryCompile() const
 	{
 		if (m_compiler->parse())
 		{
-			if (m_compiler->analyze())
-				m_compiler->compile();
-			else
+			if (!m_compiler->analyze())
 				if (verbose)
 				{
 					error() <<
@@ -322,12 +322,10 @@ void SourceUpgrade::runUpgrade()
 
 	while (recompile && !m_compiler->errors().empty())
 	{
+		recompile = false;
 		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+			if (analyzeAndUpgrade(sourceCode))
+				recompile = true;
 
 		if (recompile)
 		{
@@ -346,37 +344,48 @@ bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 	if (verbose)
 		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
 
+	size_t firstChange = m_suite.changes().size();
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
 		m_suite.analyze(m_compiler->ast(_sourceCode.first));
 
-	if (!m_suite.changes().empty())
+	vector<UpgradeChange const*> changes;
+	for (size_t i = firstChange; i < m_suite.changes().size(); ++i)
 	{
-		auto& change = m_suite.changes().front();
-
-		if (verbose)
-			change.log(true);
-
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
+		UpgradeChange const& change = m_suite.changes()[i];
+		if (change.level() == UpgradeChange::Level::Safe || applyUnsafe)
+			changes.emplace_back(&change);
+	}
+	stable_sort(changes.begin(), changes.end(), [](UpgradeChange const* _a, UpgradeChange const* _b) {
+		return make_pair(_a->location().start, _a->location().end) < make_pair(_b->location().start, _b->location().end);
+	});
+
+	// Changes overlapping with one taken before are applied in a later iteration, after
+	// compiling the source again. The same holds for several changes at the same position.
+	vector<UpgradeChange const*> applicableChanges;
+	for (UpgradeChange const* change: changes)
+		if (
+			applicableChanges.empty() ||
+			(
+				change->location().start >= applicableChanges.back()->location().end &&
+				change->location().start != applicableChanges.back()->location().start
+			)
+		)
 		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
+			if (verbose)
+				change->log(true);
+			applicableChanges.emplace_back(change);
 		}
-	}
 
-	return false;
+	if (applicableChanges.empty())
+		return false;
+
+	applyChanges(_sourceCode, applicableChanges);
+	return true;
 }
 
-void SourceUpgrade::applyChange(
+void SourceUpgrade::applyChanges(
 	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+	vector<UpgradeChange const*> const& _changes
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
@@ -384,15 +393,19 @@ void SourceUpgrade::applyChange(
 
 	if (verbose)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
+		log() << "Applying " << _changes.size() << " changes to " << _sourceCode.first << endl << endl;
+		for (UpgradeChange const* change: _changes)
+			log() << change->patch();
 	}
 
-	_change.apply();
-	m_sourceCodes[_sourceCode.first] = _change.source();
+	// Starting with the last change keeps the locations of the others valid.
+	string source = _sourceCode.second;
+	for (auto change = _changes.rbegin(); change != _changes.rend(); ++change)
+		(*change)->apply(source);
+	m_sourceCodes[_sourceCode.first] = source;
 
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, _change.source());
+		writeInputFile(_sourceCode.first, source);
 }
 
 void SourceUpgrade::printErrors() const
@@ -116,27 +116,29 @@ private:
 		};
 	};
 
-	/// Parses the current sources and runs analyses as well as compilation on
-	/// them if parsing was successful.
+	/// Parses the current sources and runs the analysis on them if parsing was
+	/// successful. Code is not generated, since the upgrades only depend on
+	/// the analysis.
 	void tryCompile() const;
 	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// which is run until no applicable changes are found any more. In each
+	/// iteration, all changes that do not overlap are applied to all sources
+	/// at once and the sources are compiled again afterwards.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
+	/// Runs upgrade analysis on source and applies the applicable changes
+	/// that do not overlap to it.
+	/// Returns `true` if changes were applied, `false` otherwise.
 	bool analyzeAndUpgrade(
 		std::pair<std::string, std::string> const& _sourceCode
 	);
 
-	/// Applies the change given to its source code. If no `--dry-run` was
+	/// Applies the changes given, which must not overlap and have to be sorted
+	/// by their location, to their source code. If no `--dry-run` was
 	/// passed via the commandline, the upgraded source code is written back
 	/// to its file.
-	void applyChange(
+	void applyChanges(
 		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
+		std::vector<UpgradeChange const*> const& _changes
 	);
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
@@ -26,9 +26,9 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::tools;
 
-void UpgradeChange::apply()
+void UpgradeChange::apply(string& _source) const
 {
-	m_source.replace(
+	_source.replace(
 		static_cast<size_t>(m_location.start),
 		static_cast<size_t>(m_location.end - m_location.start), m_patch
 	);
@@ -50,21 +50,19 @@ public:
 	)
 	:
 		m_location(_location),
-		m_source(_location.source->source()),
 		m_patch(std::move(_patch)),
 		m_level(_level) {}
 
 	~UpgradeChange() {}
 
-	langutil::SourceLocation const& location() { return m_location; }
-	std::string source() const { return m_source; }
-	std::string patch() { return m_patch; }
+	langutil::SourceLocation const& location() const { return m_location; }
+	std::string patch() const { return m_patch; }
 	Level level() const { return m_level; }
 
-	/// Does the actual replacement of code under at current source location.
-	/// The change is applied on the upgrade-specific copy of source code.
-	/// The altered code is then requested by the upgrade routine later on.
-	void apply();
+	/// Does the actual replacement of code under the source location in @a _source,
+	/// which has to be the code the location refers to, apart from changes behind
+	/// the location.
+	void apply(std::string& _source) const;
 	/// Does a pretty-print of this upgrade change. It uses a source formatter
 	/// provided by the compiler in order to print affected code. Since the patch
 	/// can contain a lot of code lines, it can be shortened, which is signaled
@@ -72,7 +70,6 @@ public:
 	void log(bool const _shorten = true) const;
 private:
 	langutil::SourceLocation m_location;
-	std::string m_source;
 	std::string m_patch;
 	Level m_level;
 
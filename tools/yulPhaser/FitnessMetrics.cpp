@@ -27,6 +27,23 @@ using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+	if (m_threadPool == nullptr)
+	{
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			values[i] = evaluate(_chromosomes[i]);
+		return values;
+	}
+
+	for (size_t i = 0; i < _chromosomes.size(); ++i)
+		m_threadPool->submit([&, i]() { values[i] = evaluate(_chromosomes[i]); });
+	m_threadPool->waitAll();
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -27,8 +27,12 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +43,9 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() evaluates a batch of chromosomes and, if the metric has been given a thread
+ * pool, does it in parallel. Metrics used that way must allow concurrent calls to @a evaluate().
  */
 class FitnessMetric
 {
@@ -49,6 +56,13 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	std::shared_ptr<util::ThreadPool> const& threadPool() const { return m_threadPool; }
+	void setThreadPool(std::shared_ptr<util::ThreadPool> _threadPool) { m_threadPool = std::move(_threadPool); }
+
+private:
+	std::shared_ptr<util::ThreadPool> m_threadPool;
 };
 
 /**
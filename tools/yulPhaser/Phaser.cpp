@@ -218,6 +218,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["threads"].as<size_t>(),
 	};
 }
 
@@ -262,19 +263,29 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	if (_options.threads > 1)
+		metric->setThreadPool(make_shared<ThreadPool>(_options.threads));
+
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -357,6 +368,7 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments["program-cache-size"].as<size_t>(),
 	};
 }
 
@@ -367,7 +379,7 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program), _options.maxTotalCodeSize) : nullptr);
 
 	return programCaches;
 }
@@ -676,6 +688,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to evaluate the fitness of new chromosomes. "
+			"The results do not depend on the number of threads."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -708,8 +726,15 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended, preferably together with --program-cache-size "
+			"if your computer does not have enough RAM."
+		)
+		(
+			"program-cache-size",
+			po::value<size_t>()->value_name("<SIZE>")->default_value(0),
+			"Maximum total size of the programs stored in the cache of each input program, "
+			"as the number of AST nodes. When the cache grows larger, the least recently used programs "
+			"are evicted. 0 means no limit."
 		)
 	;
 	keywordDescription.add(cacheDescription);
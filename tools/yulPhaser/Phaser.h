@@ -157,6 +157,8 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		/// Number of threads used to evaluate the chromosomes. Values below 2 disable parallel evaluation.
+		size_t threads;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -215,6 +217,8 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		/// Limit on the size of the programs stored in each cache. Zero means no limit.
+		size_t maxTotalCodeSize;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -68,6 +68,7 @@ bool isFitter(Individual const& a, Individual const& b);
  * An individual is a sequence of optimiser steps represented by a @a Chromosome instance.
  * Individuals are always ordered by their fitness (based on @_fitnessMetric and @a isFitter()).
  * The fitness is computed using the metric as soon as an individual is inserted into the population.
+ * All the new individuals of a population are evaluated together, using @a FitnessMetric::evaluateAll().
  *
  * The population is immutable. Selections, mutations and crossover work by producing a new
  * instance and copying the individuals.
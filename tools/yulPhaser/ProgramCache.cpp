@@ -60,32 +60,47 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	shared_ptr<Program const> prefixProgram;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		lock_guard<mutex> lock(m_mutex);
+
+		Node* node = &m_root;
+		for (char step: targetOptimisations)
 		{
-			pair->second.roundNumber = m_currentRound;
+			auto child = node->children.find(step);
+			if (child == node->children.end())
+				break;
+
+			node = child->second.get();
+			node->roundNumber = m_currentRound;
 			++prefixSize;
 			++m_hits;
 		}
-		else
-			break;
+
+		for (Node* prefixNode = node; prefixNode != &m_root; prefixNode = prefixNode->parent)
+			touch(*prefixNode);
+		prefixProgram = node->program;
 	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+	// The copy is made outside of the lock. The shared pointer keeps the program alive even if
+	// another thread evicts the entry in the meantime.
+	Program intermediateProgram = (prefixSize == 0 ? m_program : *prefixProgram);
+	prefixProgram.reset();
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		size_t codeSize = intermediateProgram.codeSize(CacheStats::StorageWeights);
+		shared_ptr<Program const> program;
+		if (m_maxTotalCodeSize == 0 || codeSize <= m_maxTotalCodeSize)
+			program = make_shared<Program const>(intermediateProgram);
+
+		lock_guard<mutex> lock(m_mutex);
 		++m_misses;
+		if (program)
+			insert(targetOptimisations.substr(0, i), move(program), codeSize);
 	}
 
 	return intermediateProgram;
@@ -93,62 +108,221 @@ Program ProgramCache::optimiseProgram(
 
 void ProgramCache::startRound(size_t _roundNumber)
 {
+	lock_guard<mutex> lock(m_mutex);
+
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
-	for (auto pair = m_entries.begin(); pair != m_entries.end();)
-	{
-		assert(pair->second.roundNumber < m_currentRound);
-
-		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
-		else
-			++pair;
-	}
+	purgeOlderThan(m_root, m_currentRound - 1);
 }
 
 void ProgramCache::clear()
 {
-	m_entries.clear();
+	lock_guard<mutex> lock(m_mutex);
+
+	m_root.children.clear();
+	m_leaves.clear();
+	m_entryCount = 0;
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
+size_t ProgramCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entryCount;
+}
+
 Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
 {
-	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
-	if (pair == m_entries.end())
+	lock_guard<mutex> lock(m_mutex);
+
+	Node const* node = findNode(_abbreviatedOptimisationSteps);
+	if (node == nullptr || node == &m_root)
 		return nullptr;
 
-	return &(pair->second.program);
+	return node->program.get();
 }
 
 CacheStats ProgramCache::gatherStats() const
 {
+	lock_guard<mutex> lock(m_mutex);
+
+	map<size_t, size_t> roundEntryCounts;
+	countRoundEntries(m_root, roundEntryCounts);
+
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
-		/* roundEntryCounts = */ countRoundEntries(),
+		/* totalCodeSize = */ m_totalCodeSize,
+		/* roundEntryCounts = */ move(roundEntryCounts),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+map<string, CacheEntry> ProgramCache::entries() const
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	lock_guard<mutex> lock(m_mutex);
+
+	map<string, CacheEntry> entries;
+	string prefix;
+	collectEntries(m_root, prefix, entries);
 
-	return size;
+	return entries;
 }
 
-map<size_t, size_t> ProgramCache::countRoundEntries() const
+size_t ProgramCache::currentRound() const
 {
-	map<size_t, size_t> counts;
-	for (auto& pair: m_entries)
-		if (counts.find(pair.second.roundNumber) != counts.end())
-			++counts.at(pair.second.roundNumber);
+	lock_guard<mutex> lock(m_mutex);
+	return m_currentRound;
+}
+
+ProgramCache::Node const* ProgramCache::findNode(string const& _abbreviatedOptimisationSteps) const
+{
+	Node const* node = &m_root;
+	for (char step: _abbreviatedOptimisationSteps)
+	{
+		auto child = node->children.find(step);
+		if (child == node->children.end())
+			return nullptr;
+
+		node = child->second.get();
+	}
+
+	return node;
+}
+
+void ProgramCache::touch(Node& _node)
+{
+	if (isLeaf(_node))
+	{
+		m_leaves.erase({_node.lastUse, &_node});
+		_node.lastUse = ++m_useCounter;
+		m_leaves.insert({_node.lastUse, &_node});
+	}
+	else
+		_node.lastUse = ++m_useCounter;
+}
+
+void ProgramCache::insert(
+	string const& _abbreviatedOptimisationSteps,
+	shared_ptr<Program const> _program,
+	size_t _codeSize
+)
+{
+	assert(!_abbreviatedOptimisationSteps.empty());
+
+	// The parent may have been evicted while the program was being optimised. It is not worth
+	// storing the program in that case since it would become the least recently used entry.
+	Node* parent = &m_root;
+	for (size_t i = 0; i + 1 < _abbreviatedOptimisationSteps.size(); ++i)
+	{
+		auto child = parent->children.find(_abbreviatedOptimisationSteps[i]);
+		if (child == parent->children.end())
+			return;
+
+		parent = child->second.get();
+	}
+
+	auto [child, inserted] = parent->children.try_emplace(_abbreviatedOptimisationSteps.back());
+	if (!inserted)
+	{
+		// Another thread has just stored the same program.
+		child->second->roundNumber = m_currentRound;
+		touch(*child->second);
+		return;
+	}
+
+	if (parent != &m_root && parent->children.size() == 1)
+		m_leaves.erase({parent->lastUse, parent});
+
+	Node& node = *(child->second = make_unique<Node>());
+	node.parent = parent;
+	node.step = _abbreviatedOptimisationSteps.back();
+	node.program = move(_program);
+	node.codeSize = _codeSize;
+	node.roundNumber = m_currentRound;
+	node.lastUse = ++m_useCounter;
+	m_leaves.insert({node.lastUse, &node});
+
+	++m_entryCount;
+	m_totalCodeSize += _codeSize;
+
+	evictLeastRecentlyUsed();
+}
+
+void ProgramCache::remove(Node& _node)
+{
+	assert(&_node != &m_root);
+
+	for (auto& [step, child]: _node.children)
+		remove(*child);
+	_node.children.clear();
+
+	m_leaves.erase({_node.lastUse, &_node});
+	--m_entryCount;
+	m_totalCodeSize -= _node.codeSize;
+}
+
+void ProgramCache::evictLeastRecentlyUsed()
+{
+	if (m_maxTotalCodeSize == 0)
+		return;
+
+	while (m_totalCodeSize > m_maxTotalCodeSize)
+	{
+		assert(!m_leaves.empty());
+		Node& leaf = *m_leaves.begin()->second;
+		Node& parent = *leaf.parent;
+
+		remove(leaf);
+		parent.children.erase(leaf.step);
+
+		if (isLeaf(parent))
+			m_leaves.insert({parent.lastUse, &parent});
+	}
+}
+
+void ProgramCache::purgeOlderThan(Node& _node, size_t _roundNumber)
+{
+	for (auto child = _node.children.begin(); child != _node.children.end();)
+	{
+		// Looking up an entry moves all its prefixes to the current round too so the extensions
+		// of an entry are never newer than the entry itself and can be removed along with it.
+		if (child->second->roundNumber < _roundNumber)
+		{
+			remove(*child->second);
+			_node.children.erase(child++);
+		}
 		else
-			counts.insert({pair.second.roundNumber, 1});
+			purgeOlderThan(*(child++)->second, _roundNumber);
+	}
+
+	if (isLeaf(_node))
+		m_leaves.insert({_node.lastUse, &_node});
+}
 
-	return counts;
+void ProgramCache::collectEntries(
+	Node const& _node,
+	string& _prefix,
+	map<string, CacheEntry>& _entries
+) const
+{
+	if (&_node != &m_root)
+		_entries.insert({_prefix, {*_node.program, _node.roundNumber}});
+
+	for (auto const& [step, child]: _node.children)
+	{
+		_prefix.push_back(step);
+		collectEntries(*child, _prefix, _entries);
+		_prefix.pop_back();
+	}
+}
+
+void ProgramCache::countRoundEntries(Node const& _node, map<size_t, size_t>& _counts) const
+{
+	for (auto const& [step, child]: _node.children)
+	{
+		++_counts[child->roundNumber];
+		countRoundEntries(*child, _counts);
+	}
 }
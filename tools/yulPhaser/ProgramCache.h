@@ -24,7 +24,11 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
 
 namespace solidity::phaser
 {
@@ -87,27 +91,32 @@ struct CacheStats
  * Class that optimises programs one step at a time which allows it to store and later reuse the
  * results of the intermediate steps.
  *
+ * The programs are stored in a trie of chromosome prefixes. Each node corresponds to a single
+ * optimisation step applied to the program stored in its parent.
+ *
  * The cache keeps track of the current round number and associates newly created entries with it.
  * @a startRound() must be called at the beginning of a round so that entries that are too old
  * can be purged. The current strategy is to store programs corresponding to all possible prefixes
  * encountered in the current and the previous rounds. Entries older than that get removed to
  * conserve memory.
  *
- * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
+ * The total size of the cached programs (measured using @a CacheStats::StorageWeights) can be
+ * limited. When the limit is exceeded, the least recently used entries are evicted. Only entries
+ * without cached extensions are ever evicted so a prefix never disappears before the longer
+ * prefixes it is a part of. A limit of zero means that the size is not limited.
  *
- * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
- * experiments) but there's room for improvement. We could fit more useful programs in
- * the cache by being more picky about which ones we choose.
+ * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * The cache can be used from multiple threads at the same time. The optimisation itself is done
+ * without holding the lock so that threads evaluating different chromosomes do not block each
+ * other. If two threads happen to compute the same entry at the same time, only one copy is kept.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, size_t _maxTotalCodeSize = 0):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -116,29 +125,62 @@ public:
 	void startRound(size_t _nextRoundNumber);
 	void clear();
 
-	size_t size() const { return m_entries.size(); }
+	size_t size() const;
+	/// @returns the program stored for the specified prefix or nullptr if there isn't one.
+	/// The pointer is only valid until the entry gets purged or evicted.
 	Program const* find(std::string const& _abbreviatedOptimisationSteps) const;
 	bool contains(std::string const& _abbreviatedOptimisationSteps) const { return find(_abbreviatedOptimisationSteps) != nullptr; }
 
 	CacheStats gatherStats() const;
 
-	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
+	/// @returns copies of all the cached entries, keyed by the prefix they correspond to.
+	/// Meant for inspecting the cache in tests and is expensive for large caches.
+	std::map<std::string, CacheEntry> entries() const;
 	Program const& program() const { return m_program; }
-	size_t currentRound() const { return m_currentRound; }
+	size_t currentRound() const;
+	size_t maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
-	std::map<size_t, size_t> countRoundEntries() const;
+	struct Node
+	{
+		Node* parent = nullptr;
+		/// Abbreviation of the step that produces the program from the one stored in the parent.
+		char step = '\0';
+		std::shared_ptr<Program const> program;
+		size_t codeSize = 0;
+		size_t roundNumber = 0;
+		/// Value of the use counter the last time the entry was created or looked up.
+		size_t lastUse = 0;
+		std::map<char, std::unique_ptr<Node>> children;
+	};
 
-	// The best matching data structure here would be a trie of chromosome prefixes but since
-	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
-	// A map should be good enough.
-	std::map<std::string, CacheEntry> m_entries;
+	bool isLeaf(Node const& _node) const { return &_node != &m_root && _node.children.empty(); }
+	Node const* findNode(std::string const& _abbreviatedOptimisationSteps) const;
+
+	void touch(Node& _node);
+	void insert(std::string const& _abbreviatedOptimisationSteps, std::shared_ptr<Program const> _program, size_t _codeSize);
+	void remove(Node& _node);
+	void evictLeastRecentlyUsed();
+	void purgeOlderThan(Node& _node, size_t _roundNumber);
+
+	void collectEntries(Node const& _node, std::string& _prefix, std::map<std::string, CacheEntry>& _entries) const;
+	void countRoundEntries(Node const& _node, std::map<size_t, size_t>& _counts) const;
+
+	/// Root of the trie. Corresponds to the empty prefix and does not store any program.
+	Node m_root;
+	/// Entries without any extensions, ordered from the least to the most recently used.
+	std::set<std::pair<size_t, Node*>> m_leaves;
+	size_t m_entryCount = 0;
+	size_t m_totalCodeSize = 0;
+	size_t m_useCounter = 0;
 
 	Program m_program;
+	size_t m_maxTotalCodeSize;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+
+	mutable std::mutex m_mutex;
 };
 
 }